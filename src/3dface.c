@@ -40,6 +40,8 @@
 
 
 #include "3dface.h"
+#include "stats.h"
+#include "util.h"
 
 
 /*!
@@ -72,6 +74,7 @@ dxf_3dface_new ()
         else
         {
                 memset (face, 0, size);
+                dxf_stats_count_allocation (DFACE, size);
         }
 #ifdef DEBUG
         DXF_DEBUG_END
@@ -113,8 +116,8 @@ dxf_3dface_init
                 return (NULL);
         }
         face->id_code = 0;
-        face->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        face->layer = strdup (DXF_DEFAULT_LAYER);
+        face->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        face->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         face->elevation = 0.0;
         face->thickness = 0.0;
         face->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
@@ -123,34 +126,29 @@ dxf_3dface_init
         face->paperspace = DXF_MODELSPACE;
         face->graphics_data_size = 0;
         face->shadow_mode = 0;
-        face->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_new ();
-        face->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_init (face->binary_graphics_data);
-        face->dictionary_owner_soft = strdup ("");
-        face->object_owner_soft = strdup ("");
-        face->material = strdup ("");
-        face->dictionary_owner_hard = strdup ("");
+        face->binary_graphics_data = NULL;
+        face->dictionary_owner_soft = dxf_string_share ("");
+        face->object_owner_soft = dxf_string_share ("");
+        face->material = dxf_string_share ("");
+        face->dictionary_owner_hard = dxf_string_share ("");
         face->lineweight = 0;
-        face->plot_style_name = strdup ("");
+        face->plot_style_name = dxf_string_share ("");
         face->color_value = 0;
-        face->color_name = strdup ("");
+        face->color_name = dxf_string_share ("");
         face->transparency = 0;
         face->p0 = dxf_point_new ();
-        face->p0 = dxf_point_init (face->p0);
         face->p0->x0 = 0.0;
         face->p0->y0 = 0.0;
         face->p0->z0 = 0.0;
         face->p1 = dxf_point_new ();
-        face->p1 = dxf_point_init (face->p1);
         face->p1->x0 = 0.0;
         face->p1->y0 = 0.0;
         face->p1->z0 = 0.0;
         face->p2 = dxf_point_new ();
-        face->p2 = dxf_point_init (face->p2);
         face->p2->x0 = 0.0;
         face->p2->y0 = 0.0;
         face->p2->z0 = 0.0;
         face->p3 = dxf_point_new ();
-        face->p3 = dxf_point_init (face->p3);
         face->p3->x0 = 0.0;
         face->p3->y0 = 0.0;
         face->p3->z0 = 0.0;
@@ -235,14 +233,12 @@ dxf_3dface_read
                 {
                         /* Now follows a string containing a linetype
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", face->linetype);
+                        dxf_read_string (fp, &face->linetype);
                 }
                 else if (strcmp (temp_string, "8") == 0)
                 {
                         /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", face->layer);
+                        dxf_read_string (fp, &face->layer);
                 }
                 else if (strcmp (temp_string, "10") == 0)
                 {
@@ -416,10 +412,7 @@ dxf_3dface_read
                 {
                         /* Now follows a string containing binary
                          * graphics data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", iter310->data_line);
-                        dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) iter310->next);
-                        iter310 = (DxfBinaryGraphicsData *) iter310->next;
+                        iter310 = dxf_binary_graphics_data_read (fp, &face->binary_graphics_data, iter310);
                 }
                 else if (strcmp (temp_string, "330") == 0)
                 {
@@ -427,15 +420,13 @@ dxf_3dface_read
                         {
                                 /* Now follows a string containing a soft-pointer
                                  * ID/handle to owner dictionary. */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%s\n", face->dictionary_owner_soft);
+                                dxf_read_string (fp, &face->dictionary_owner_soft);
                         }
                         if (iter330 == 1)
                         {
                                 /* Now follows a string containing a soft-pointer
                                  * ID/handle to owner object. */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%s\n", face->object_owner_soft);
+                                dxf_read_string (fp, &face->object_owner_soft);
                         }
                         iter330++;
                 }
@@ -443,15 +434,13 @@ dxf_3dface_read
                 {
                         /* Now follows a string containing a
                          * hard-pointer ID/handle to material object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", face->material);
+                        dxf_read_string (fp, &face->material);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", face->dictionary_owner_hard);
+                        dxf_read_string (fp, &face->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "370") == 0)
                 {
@@ -464,8 +453,7 @@ dxf_3dface_read
                 {
                         /* Now follows a string containing a plot style
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", face->plot_style_name);
+                        dxf_read_string (fp, &face->plot_style_name);
                 }
                 else if (strcmp (temp_string, "420") == 0)
                 {
@@ -477,8 +465,7 @@ dxf_3dface_read
                 {
                         /* Now follows a string containing a color
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", face->color_name);
+                        dxf_read_string (fp, &face->color_name);
                 }
                 else if (strcmp (temp_string, "440") == 0)
                 {
@@ -504,11 +491,13 @@ dxf_3dface_read
         /* Handle omitted members and/or illegal values. */
         if (strcmp (face->linetype, "") == 0)
         {
-                face->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (face->linetype);
+                face->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (face->layer, "") == 0)
         {
-                face->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (face->layer);
+                face->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Clean up. */
         free (temp_string);
@@ -566,7 +555,8 @@ dxf_3dface_write
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0")),
                   dxf_entity_name);
-                face->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (face->layer);
+                face->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         if (face->linetype == NULL)
         {
@@ -576,7 +566,8 @@ dxf_3dface_write
                 fprintf (stderr,
                   (_("\t%s linetype is set to %s\n")),
                   dxf_entity_name, DXF_DEFAULT_LINETYPE);
-                face->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (face->linetype);
+                face->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         /* Start writing output. */
         fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
@@ -745,15 +736,18 @@ dxf_3dface_free
                 __FUNCTION__);
               return (face);
         }
-        free (face->linetype);
-        free (face->layer);
-        dxf_binary_graphics_data_free_list (face->binary_graphics_data);
-        free (face->dictionary_owner_soft);
-        free (face->object_owner_soft);
-        free (face->material);
-        free (face->dictionary_owner_hard);
-        free (face->plot_style_name);
-        free (face->color_name);
+        dxf_string_free (face->linetype);
+        dxf_string_free (face->layer);
+        if (face->binary_graphics_data != NULL)
+        {
+                dxf_binary_graphics_data_free_list (face->binary_graphics_data);
+        }
+        dxf_string_free (face->dictionary_owner_soft);
+        dxf_string_free (face->object_owner_soft);
+        dxf_string_free (face->material);
+        dxf_string_free (face->dictionary_owner_hard);
+        dxf_string_free (face->plot_style_name);
+        dxf_string_free (face->color_name);
         dxf_point_free_list (face->p0);
         dxf_point_free_list (face->p1);
         dxf_point_free_list (face->p2);
@@ -937,6 +931,8 @@ dxf_3dface_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (face == NULL)
         {
@@ -952,7 +948,13 @@ dxf_3dface_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        face->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (face->linetype);
+        face->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1018,6 +1020,8 @@ dxf_3dface_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (face == NULL)
         {
@@ -1033,7 +1037,13 @@ dxf_3dface_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        face->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (face->layer);
+        face->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1827,6 +1837,8 @@ dxf_3dface_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (face == NULL)
         {
@@ -1842,7 +1854,13 @@ dxf_3dface_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        face->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (face->dictionary_owner_soft);
+        face->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1907,6 +1925,8 @@ dxf_3dface_set_object_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (face == NULL)
         {
@@ -1922,7 +1942,13 @@ dxf_3dface_set_object_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        face->object_owner_soft = strdup (object_owner_soft);
+        copy = dxf_string_share (object_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (face->object_owner_soft);
+        face->object_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1989,6 +2015,8 @@ dxf_3dface_set_material
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (face == NULL)
         {
@@ -2004,7 +2032,13 @@ dxf_3dface_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        face->material = strdup (material);
+        copy = dxf_string_share (material);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (face->material);
+        face->material = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2072,6 +2106,8 @@ dxf_3dface_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (face == NULL)
         {
@@ -2087,7 +2123,13 @@ dxf_3dface_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        face->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (face->dictionary_owner_hard);
+        face->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2217,6 +2259,8 @@ dxf_3dface_set_plot_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (face == NULL)
         {
@@ -2232,7 +2276,13 @@ dxf_3dface_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        face->plot_style_name = strdup (plot_style_name);
+        copy = dxf_string_share (plot_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (face->plot_style_name);
+        face->plot_style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2362,6 +2412,8 @@ dxf_3dface_set_color_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (face == NULL)
         {
@@ -2377,7 +2429,13 @@ dxf_3dface_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        face->color_name = strdup (color_name);
+        copy = dxf_string_share (color_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (face->color_name);
+        face->color_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
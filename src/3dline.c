@@ -43,6 +43,7 @@
 
 
 #include "3dline.h"
+#include "util.h"
 
 
 /*!
@@ -116,8 +117,8 @@ dxf_3dline_init
               return (NULL);
         }
         line->id_code = 0;
-        line->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        line->layer = strdup (DXF_DEFAULT_LAYER);
+        line->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        line->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         line->elevation = 0.0;
         line->thickness = 0.0;
         line->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
@@ -126,24 +127,21 @@ dxf_3dline_init
         line->paperspace = DXF_MODELSPACE;
         line->graphics_data_size = 0;
         line->shadow_mode = 0;
-        line->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_new ();
-        line->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_init (line->binary_graphics_data);
-        line->dictionary_owner_soft = strdup ("");
-        line->object_owner_soft = strdup ("");
-        line->material = strdup ("");
-        line->dictionary_owner_hard = strdup ("");
+        line->binary_graphics_data = NULL;
+        line->dictionary_owner_soft = dxf_string_share ("");
+        line->object_owner_soft = dxf_string_share ("");
+        line->material = dxf_string_share ("");
+        line->dictionary_owner_hard = dxf_string_share ("");
         line->lineweight = 0;
-        line->plot_style_name = strdup ("");
+        line->plot_style_name = dxf_string_share ("");
         line->color_value = 0;
-        line->color_name = strdup ("");
+        line->color_name = dxf_string_share ("");
         line->transparency = 0;
         line->p0 = dxf_point_new ();
-        line->p0 = dxf_point_init (line->p0);
         line->p0->x0 = 0.0;
         line->p0->y0 = 0.0;
         line->p0->z0 = 0.0;
         line->p1 = dxf_point_new ();
-        line->p1 = dxf_point_init (line->p1);
         line->p1->x0 = 0.0;
         line->p1->y0 = 0.0;
         line->p1->z0 = 0.0;
@@ -230,14 +228,12 @@ dxf_3dline_read
                 {
                         /* Now follows a string containing a linetype
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", line->linetype);
+                        dxf_read_string (fp, &line->linetype);
                 }
                 else if (strcmp (temp_string, "8") == 0)
                 {
                         /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", line->layer);
+                        dxf_read_string (fp, &line->layer);
                 }
                 else if (strcmp (temp_string, "10") == 0)
                 {
@@ -383,10 +379,7 @@ dxf_3dline_read
                 {
                         /* Now follows a string containing binary
                          * graphics data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", iter310->data_line);
-                        dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) iter310->next);
-                        iter310 = (DxfBinaryGraphicsData *) iter310->next;
+                        iter310 = dxf_binary_graphics_data_read (fp, &line->binary_graphics_data, iter310);
                 }
                 else if (strcmp (temp_string, "330") == 0)
                 {
@@ -394,15 +387,13 @@ dxf_3dline_read
                         {
                                 /* Now follows a string containing a soft-pointer
                                  * ID/handle to owner dictionary. */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%s\n", line->dictionary_owner_soft);
+                                dxf_read_string (fp, &line->dictionary_owner_soft);
                         }
                         if (iter330 == 1)
                         {
                                 /* Now follows a string containing a soft-pointer
                                  * ID/handle to owner object. */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%s\n", line->object_owner_soft);
+                                dxf_read_string (fp, &line->object_owner_soft);
                         }
                         iter330++;
                 }
@@ -410,15 +401,13 @@ dxf_3dline_read
                 {
                         /* Now follows a string containing a
                          * hard-pointer ID/handle to material object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", line->material);
+                        dxf_read_string (fp, &line->material);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", line->dictionary_owner_hard);
+                        dxf_read_string (fp, &line->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "370") == 0)
                 {
@@ -431,8 +420,7 @@ dxf_3dline_read
                 {
                         /* Now follows a string containing a plot style
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", line->plot_style_name);
+                        dxf_read_string (fp, &line->plot_style_name);
                 }
                 else if (strcmp (temp_string, "420") == 0)
                 {
@@ -444,8 +432,7 @@ dxf_3dline_read
                 {
                         /* Now follows a string containing a color
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", line->color_name);
+                        dxf_read_string (fp, &line->color_name);
                 }
                 else if (strcmp (temp_string, "440") == 0)
                 {
@@ -471,11 +458,13 @@ dxf_3dline_read
         /* Handle omitted members and/or illegal values. */
         if (strcmp (line->linetype, "") == 0)
         {
-                line->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (line->linetype);
+                line->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (line->layer, "") == 0)
         {
-                line->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (line->layer);
+                line->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Clean up. */
         free (temp_string);
@@ -549,7 +538,8 @@ dxf_3dline_write
                 fprintf (stderr,
                   (_("    %s entity is relocated to layer 0\n")),
                   dxf_entity_name);
-                line->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (line->layer);
+                line->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         if (line->linetype == NULL)
         {
@@ -559,7 +549,8 @@ dxf_3dline_write
                 fprintf (stderr,
                   (_("\t%s linetype is set to %s\n")),
                   dxf_entity_name, DXF_DEFAULT_LINETYPE);
-                line->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (line->linetype);
+                line->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (fp->acad_version_number > AutoCAD_11)
         {
@@ -736,15 +727,18 @@ dxf_3dline_free
                 __FUNCTION__);
               return (EXIT_FAILURE);
         }
-        free (line->linetype);
-        free (line->layer);
-        dxf_binary_graphics_data_free_list (line->binary_graphics_data);
-        free (line->dictionary_owner_soft);
-        free (line->object_owner_soft);
-        free (line->material);
-        free (line->dictionary_owner_hard);
-        free (line->plot_style_name);
-        free (line->color_name);
+        dxf_string_free (line->linetype);
+        dxf_string_free (line->layer);
+        if (line->binary_graphics_data != NULL)
+        {
+                dxf_binary_graphics_data_free_list (line->binary_graphics_data);
+        }
+        dxf_string_free (line->dictionary_owner_soft);
+        dxf_string_free (line->object_owner_soft);
+        dxf_string_free (line->material);
+        dxf_string_free (line->dictionary_owner_hard);
+        dxf_string_free (line->plot_style_name);
+        dxf_string_free (line->color_name);
         dxf_point_free_list (line->p0);
         dxf_point_free_list (line->p1);
         free (line);
@@ -916,6 +910,8 @@ dxf_3dline_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (line == NULL)
         {
@@ -931,7 +927,13 @@ dxf_3dline_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        line->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (line->linetype);
+        line->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -991,6 +993,8 @@ dxf_3dline_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (line == NULL)
         {
@@ -1006,7 +1010,13 @@ dxf_3dline_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        line->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (line->layer);
+        line->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1800,6 +1810,8 @@ dxf_3dline_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (line == NULL)
         {
@@ -1815,7 +1827,13 @@ dxf_3dline_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        line->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (line->dictionary_owner_soft);
+        line->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1880,6 +1898,8 @@ dxf_3dline_set_object_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (line == NULL)
         {
@@ -1895,7 +1915,13 @@ dxf_3dline_set_object_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        line->object_owner_soft = strdup (object_owner_soft);
+        copy = dxf_string_share (object_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (line->object_owner_soft);
+        line->object_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1962,6 +1988,8 @@ dxf_3dline_set_material
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (line == NULL)
         {
@@ -1977,7 +2005,13 @@ dxf_3dline_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        line->material = strdup (material);
+        copy = dxf_string_share (material);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (line->material);
+        line->material = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2042,6 +2076,8 @@ dxf_3dline_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (line == NULL)
         {
@@ -2057,7 +2093,13 @@ dxf_3dline_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        line->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (line->dictionary_owner_hard);
+        line->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2187,6 +2229,8 @@ dxf_3dline_set_plot_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (line == NULL)
         {
@@ -2202,7 +2246,13 @@ dxf_3dline_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        line->plot_style_name = strdup (plot_style_name);
+        copy = dxf_string_share (plot_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (line->plot_style_name);
+        line->plot_style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2332,6 +2382,8 @@ dxf_3dline_set_color_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (line == NULL)
         {
@@ -2347,7 +2399,13 @@ dxf_3dline_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        line->color_name = strdup (color_name);
+        copy = dxf_string_share (color_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (line->color_name);
+        line->color_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -49,6 +49,8 @@
 
 
 #include "3dsolid.h"
+#include "stats.h"
+#include "util.h"
 
 
 /*!
@@ -78,6 +80,7 @@ dxf_3dsolid_new ()
         else
         {
                 memset (solid, 0, size);
+                dxf_stats_count_allocation (DSOLID, size);
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -119,8 +122,8 @@ dxf_3dsolid_init
                 return (NULL);
         }
         solid->id_code = 0;
-        solid->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        solid->layer = strdup (DXF_DEFAULT_LAYER);
+        solid->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        solid->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         solid->elevation = 0.0;
         solid->thickness = 0.0;
         solid->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
@@ -129,21 +132,20 @@ dxf_3dsolid_init
         solid->paperspace = DXF_MODELSPACE;
         solid->graphics_data_size = 0;
         solid->shadow_mode = 0;
-        solid->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_new ();
-        solid->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_init (solid->binary_graphics_data);
-        solid->dictionary_owner_soft = strdup ("");
-        solid->object_owner_soft = strdup ("");
-        solid->material = strdup ("");
-        solid->dictionary_owner_hard = strdup ("");
+        solid->binary_graphics_data = NULL;
+        solid->dictionary_owner_soft = dxf_string_share ("");
+        solid->object_owner_soft = dxf_string_share ("");
+        solid->material = dxf_string_share ("");
+        solid->dictionary_owner_hard = dxf_string_share ("");
         solid->lineweight = 0;
-        solid->plot_style_name = strdup ("");
+        solid->plot_style_name = dxf_string_share ("");
         solid->color_value = 0;
-        solid->color_name = strdup ("");
+        solid->color_name = dxf_string_share ("");
         solid->transparency = 0;
         solid->proprietary_data = (DxfProprietaryData *) dxf_proprietary_data_init (solid->proprietary_data);
         solid->additional_proprietary_data = (DxfProprietaryData *) dxf_proprietary_data_init (solid->additional_proprietary_data);
         solid->modeler_format_version_number = 1;
-        solid->history = strdup ("");
+        solid->history = dxf_string_share ("");
         solid->next = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -257,14 +259,12 @@ dxf_3dsolid_read
                 {
                         /* Now follows a string containing a linetype
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", solid->linetype);
+                        dxf_read_string (fp, &solid->linetype);
                 }
                 else if (strcmp (temp_string, "8") == 0)
                 {
                         /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", solid->layer);
+                        dxf_read_string (fp, &solid->layer);
                 }
                 else if (strcmp (temp_string, "38") == 0)
                 {
@@ -366,10 +366,7 @@ dxf_3dsolid_read
                 {
                         /* Now follows a string containing binary
                          * graphics data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", iter310->data_line);
-                        dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) iter310->next);
-                        iter310 = (DxfBinaryGraphicsData *) iter310->next;
+                        iter310 = dxf_binary_graphics_data_read (fp, &solid->binary_graphics_data, iter310);
                 }
                 else if (strcmp (temp_string, "330") == 0)
                 {
@@ -377,15 +374,13 @@ dxf_3dsolid_read
                         {
                                 /* Now follows a string containing a soft-pointer
                                  * ID/handle to owner dictionary. */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%s\n", solid->dictionary_owner_soft);
+                                dxf_read_string (fp, &solid->dictionary_owner_soft);
                         }
                         if (iter330 == 1)
                         {
                                 /* Now follows a string containing a soft-pointer
                                  * ID/handle to owner object. */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%s\n", solid->object_owner_soft);
+                                dxf_read_string (fp, &solid->object_owner_soft);
                         }
                         iter330++;
                 }
@@ -393,22 +388,19 @@ dxf_3dsolid_read
                 {
                         /* Now follows a string containing a
                          * hard-pointer ID/handle to material object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", solid->material);
+                        dxf_read_string (fp, &solid->material);
                 }
                 else if (strcmp (temp_string, "350") == 0)
                 {
                         /* Now follows a string containing a handle to a
                          * history object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", solid->history);
+                        dxf_read_string (fp, &solid->history);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", solid->dictionary_owner_hard);
+                        dxf_read_string (fp, &solid->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "370") == 0)
                 {
@@ -421,8 +413,7 @@ dxf_3dsolid_read
                 {
                         /* Now follows a string containing a plot style
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", solid->plot_style_name);
+                        dxf_read_string (fp, &solid->plot_style_name);
                 }
                 else if (strcmp (temp_string, "420") == 0)
                 {
@@ -434,8 +425,7 @@ dxf_3dsolid_read
                 {
                         /* Now follows a string containing a color
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", solid->color_name);
+                        dxf_read_string (fp, &solid->color_name);
                 }
                 else if (strcmp (temp_string, "440") == 0)
                 {
@@ -461,11 +451,13 @@ dxf_3dsolid_read
         /* Handle omitted members and/or illegal values. */
         if (strcmp (solid->linetype, "") == 0)
         {
-                solid->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (solid->linetype);
+                solid->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (solid->layer, "") == 0)
         {
-                solid->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (solid->layer);
+                solid->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Clean up. */
         free (temp_string);
@@ -532,7 +524,8 @@ dxf_3dsolid_write
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                solid->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (solid->linetype);
+                solid->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (solid->layer, "") == 0)
         {
@@ -542,7 +535,8 @@ dxf_3dsolid_write
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0")),
                   dxf_entity_name);
-                solid->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (solid->layer);
+                solid->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Start writing output. */
         i = 1;
@@ -737,18 +731,21 @@ dxf_3dsolid_free
                 __FUNCTION__);
               return (EXIT_FAILURE);
         }
-        free (solid->linetype);
-        free (solid->layer);
-        dxf_binary_graphics_data_free_list (solid->binary_graphics_data);
-        free (solid->dictionary_owner_soft);
-        free (solid->object_owner_soft);
-        free (solid->material);
-        free (solid->dictionary_owner_hard);
-        free (solid->plot_style_name);
-        free (solid->color_name);
+        dxf_string_free (solid->linetype);
+        dxf_string_free (solid->layer);
+        if (solid->binary_graphics_data != NULL)
+        {
+                dxf_binary_graphics_data_free_list (solid->binary_graphics_data);
+        }
+        dxf_string_free (solid->dictionary_owner_soft);
+        dxf_string_free (solid->object_owner_soft);
+        dxf_string_free (solid->material);
+        dxf_string_free (solid->dictionary_owner_hard);
+        dxf_string_free (solid->plot_style_name);
+        dxf_string_free (solid->color_name);
         dxf_proprietary_data_free_list (solid->proprietary_data);
         dxf_proprietary_data_free_list (solid->additional_proprietary_data);
-        free (solid->history);
+        dxf_string_free (solid->history);
         free (solid);
         solid = NULL;
 #if DEBUG
@@ -918,6 +915,8 @@ dxf_3dsolid_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (solid == NULL)
         {
@@ -933,7 +932,13 @@ dxf_3dsolid_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        solid->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (solid->linetype);
+        solid->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -993,6 +998,8 @@ dxf_3dsolid_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (solid == NULL)
         {
@@ -1008,7 +1015,13 @@ dxf_3dsolid_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        solid->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (solid->layer);
+        solid->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1785,6 +1798,8 @@ dxf_3dsolid_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (solid == NULL)
         {
@@ -1800,7 +1815,13 @@ dxf_3dsolid_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        solid->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (solid->dictionary_owner_soft);
+        solid->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1865,6 +1886,8 @@ dxf_3dsolid_set_object_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (solid == NULL)
         {
@@ -1880,7 +1903,13 @@ dxf_3dsolid_set_object_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        solid->object_owner_soft = strdup (object_owner_soft);
+        copy = dxf_string_share (object_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (solid->object_owner_soft);
+        solid->object_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1948,6 +1977,8 @@ dxf_3dsolid_set_material
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (solid == NULL)
         {
@@ -1963,7 +1994,13 @@ dxf_3dsolid_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        solid->material = strdup (material);
+        copy = dxf_string_share (material);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (solid->material);
+        solid->material = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2028,6 +2065,8 @@ dxf_3dsolid_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (solid == NULL)
         {
@@ -2043,7 +2082,13 @@ dxf_3dsolid_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        solid->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (solid->dictionary_owner_hard);
+        solid->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2173,6 +2218,8 @@ dxf_3dsolid_set_plot_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (solid == NULL)
         {
@@ -2188,7 +2235,13 @@ dxf_3dsolid_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        solid->plot_style_name = strdup (plot_style_name);
+        copy = dxf_string_share (plot_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (solid->plot_style_name);
+        solid->plot_style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2318,6 +2371,8 @@ dxf_3dsolid_set_color_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (solid == NULL)
         {
@@ -2333,7 +2388,13 @@ dxf_3dsolid_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        solid->color_name = strdup (color_name);
+        copy = dxf_string_share (color_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (solid->color_name);
+        solid->color_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2705,6 +2766,8 @@ dxf_3dsolid_set_history
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (solid == NULL)
         {
@@ -2720,7 +2783,13 @@ dxf_3dsolid_set_history
                   __FUNCTION__);
                 return (NULL);
         }
-        solid->history = strdup (history);
+        copy = dxf_string_share (history);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (solid->history);
+        solid->history = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -53,6 +53,8 @@
 
 
 #include "acad_proxy_entity.h"
+#include "stats.h"
+#include "util.h"
 
 
 /*!
@@ -85,6 +87,7 @@ dxf_acad_proxy_entity_new ()
         else
         {
                 memset (acad_proxy_entity, 0, size);
+                dxf_stats_count_allocation (ACADPROXYENTITY, size);
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -126,8 +129,8 @@ dxf_acad_proxy_entity_init
                 return (NULL);
         }
         acad_proxy_entity->id_code = 0;
-        acad_proxy_entity->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        acad_proxy_entity->layer = strdup (DXF_DEFAULT_LAYER);
+        acad_proxy_entity->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        acad_proxy_entity->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         acad_proxy_entity->elevation = 0.0;
         acad_proxy_entity->thickness = 0.0;
         acad_proxy_entity->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
@@ -135,14 +138,14 @@ dxf_acad_proxy_entity_init
         acad_proxy_entity->color = DXF_COLOR_BYLAYER;
         acad_proxy_entity->paperspace = DXF_PAPERSPACE;
         acad_proxy_entity->shadow_mode = 0;
-        acad_proxy_entity->dictionary_owner_soft = strdup ("");
-        acad_proxy_entity->object_owner_soft = strdup ("");
-        acad_proxy_entity->material = strdup ("");
-        acad_proxy_entity->dictionary_owner_hard = strdup ("");
+        acad_proxy_entity->dictionary_owner_soft = dxf_string_share ("");
+        acad_proxy_entity->object_owner_soft = dxf_string_share ("");
+        acad_proxy_entity->material = dxf_string_share ("");
+        acad_proxy_entity->dictionary_owner_hard = dxf_string_share ("");
         acad_proxy_entity->lineweight = 0;
-        acad_proxy_entity->plot_style_name = strdup ("");
+        acad_proxy_entity->plot_style_name = dxf_string_share ("");
         acad_proxy_entity->color_value = 0;
-        acad_proxy_entity->color_name = strdup ("");
+        acad_proxy_entity->color_name = dxf_string_share ("");
         acad_proxy_entity->transparency = 0;
         acad_proxy_entity->original_custom_object_data_format = 1;
         acad_proxy_entity->proxy_entity_class_id = DXF_DEFAULT_PROXY_ENTITY_ID;
@@ -150,8 +153,7 @@ dxf_acad_proxy_entity_init
         acad_proxy_entity->graphics_data_size = 0;
         acad_proxy_entity->entity_data_size = 0;
         acad_proxy_entity->object_drawing_format = 0;
-        acad_proxy_entity->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_new ();
-        acad_proxy_entity->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_init (acad_proxy_entity->binary_graphics_data);
+        acad_proxy_entity->binary_graphics_data = NULL;
         acad_proxy_entity->binary_entity_data = (DxfBinaryEntityData *) dxf_binary_entity_data_new ();
         acad_proxy_entity->binary_entity_data = (DxfBinaryEntityData *) dxf_binary_entity_data_init (acad_proxy_entity->binary_entity_data);
         acad_proxy_entity->object_id = dxf_object_id_new ();
@@ -249,15 +251,13 @@ dxf_acad_proxy_entity_read
                 {
                         /* Now follows a string containing the linetype
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", acad_proxy_entity->linetype);
+                        dxf_read_string (fp, &acad_proxy_entity->linetype);
                 }
                 else if (strcmp (temp_string, "8") == 0)
                 {
                         /* Now follows a string containing the layer
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", acad_proxy_entity->layer);
+                        dxf_read_string (fp, &acad_proxy_entity->layer);
                 }
                 else if ((fp->acad_version_number <= AutoCAD_11)
                   && DXF_FLATLAND
@@ -386,10 +386,7 @@ dxf_acad_proxy_entity_read
                 {
                         /* Now follows a string containing binary
                          * graphics data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", iter310->data_line);
-                        dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) iter310->next);
-                        iter310 = (DxfBinaryGraphicsData *) iter310->next;
+                        iter310 = dxf_binary_graphics_data_read (fp, &acad_proxy_entity->binary_graphics_data, iter310);
                 }
                 else if (strcmp (temp_string, "330") == 0)
                 {
@@ -397,15 +394,13 @@ dxf_acad_proxy_entity_read
                         {
                                 /* Now follows a string containing a soft-pointer
                                  * ID/handle to owner dictionary. */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%s\n", acad_proxy_entity->dictionary_owner_soft);
+                                dxf_read_string (fp, &acad_proxy_entity->dictionary_owner_soft);
                         }
                         if (iter330 == 1)
                         {
                                 /* Now follows a string containing a soft-pointer
                                  * ID/handle to owner object. */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%s\n", acad_proxy_entity->object_owner_soft);
+                                dxf_read_string (fp, &acad_proxy_entity->object_owner_soft);
                         }
                         iter330++;
                 }
@@ -436,15 +431,13 @@ dxf_acad_proxy_entity_read
                 {
                         /* Now follows a string containing a
                          * hard-pointer ID/handle to material object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", acad_proxy_entity->material);
+                        dxf_read_string (fp, &acad_proxy_entity->material);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", acad_proxy_entity->dictionary_owner_hard);
+                        dxf_read_string (fp, &acad_proxy_entity->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "370") == 0)
                 {
@@ -457,8 +450,7 @@ dxf_acad_proxy_entity_read
                 {
                         /* Now follows a string containing a plot style
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", acad_proxy_entity->plot_style_name);
+                        dxf_read_string (fp, &acad_proxy_entity->plot_style_name);
                 }
                 else if (strcmp (temp_string, "420") == 0)
                 {
@@ -470,8 +462,7 @@ dxf_acad_proxy_entity_read
                 {
                         /* Now follows a string containing a color
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", acad_proxy_entity->color_name);
+                        dxf_read_string (fp, &acad_proxy_entity->color_name);
                 }
                 else if (strcmp (temp_string, "440") == 0)
                 {
@@ -581,7 +572,8 @@ dxf_acad_proxy_entity_write
                 fprintf (stderr,
                   (_("    %s entity is relocated to layer 0\n")),
                   dxf_entity_name);
-                acad_proxy_entity->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (acad_proxy_entity->layer);
+                acad_proxy_entity->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         if (acad_proxy_entity->linetype == NULL)
         {
@@ -591,7 +583,8 @@ dxf_acad_proxy_entity_write
                 fprintf (stderr,
                   (_("\t%s linetype is set to %s\n")),
                   dxf_entity_name, DXF_DEFAULT_LINETYPE);
-                acad_proxy_entity->linetype = strdup(DXF_DEFAULT_LINETYPE);
+                dxf_string_free (acad_proxy_entity->linetype);
+                acad_proxy_entity->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         /* Start writing output. */
         fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
@@ -778,15 +771,18 @@ dxf_acad_proxy_entity_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (acad_proxy_entity->linetype);
-        free (acad_proxy_entity->layer);
-        free (acad_proxy_entity->dictionary_owner_soft);
-        free (acad_proxy_entity->object_owner_soft);
-        free (acad_proxy_entity->material);
-        free (acad_proxy_entity->dictionary_owner_hard);
-        free (acad_proxy_entity->plot_style_name);
-        free (acad_proxy_entity->color_name);
-        dxf_binary_graphics_data_free_list (acad_proxy_entity->binary_graphics_data);
+        dxf_string_free (acad_proxy_entity->linetype);
+        dxf_string_free (acad_proxy_entity->layer);
+        dxf_string_free (acad_proxy_entity->dictionary_owner_soft);
+        dxf_string_free (acad_proxy_entity->object_owner_soft);
+        dxf_string_free (acad_proxy_entity->material);
+        dxf_string_free (acad_proxy_entity->dictionary_owner_hard);
+        dxf_string_free (acad_proxy_entity->plot_style_name);
+        dxf_string_free (acad_proxy_entity->color_name);
+        if (acad_proxy_entity->binary_graphics_data != NULL)
+        {
+                dxf_binary_graphics_data_free_list (acad_proxy_entity->binary_graphics_data);
+        }
         dxf_binary_entity_data_free_list (acad_proxy_entity->binary_entity_data);
         dxf_object_id_free_list (acad_proxy_entity->object_id);
         free (acad_proxy_entity);
@@ -958,6 +954,8 @@ dxf_acad_proxy_entity_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (acad_proxy_entity == NULL)
         {
@@ -973,7 +971,13 @@ dxf_acad_proxy_entity_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        acad_proxy_entity->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (acad_proxy_entity->linetype);
+        acad_proxy_entity->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1033,6 +1037,8 @@ dxf_acad_proxy_entity_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (acad_proxy_entity == NULL)
         {
@@ -1048,7 +1054,13 @@ dxf_acad_proxy_entity_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        acad_proxy_entity->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (acad_proxy_entity->layer);
+        acad_proxy_entity->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1661,6 +1673,8 @@ dxf_acad_proxy_entity_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (acad_proxy_entity == NULL)
         {
@@ -1676,7 +1690,13 @@ dxf_acad_proxy_entity_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        acad_proxy_entity->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (acad_proxy_entity->dictionary_owner_soft);
+        acad_proxy_entity->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1741,6 +1761,8 @@ dxf_acad_proxy_entity_set_object_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (acad_proxy_entity == NULL)
         {
@@ -1756,7 +1778,13 @@ dxf_acad_proxy_entity_set_object_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        acad_proxy_entity->object_owner_soft = strdup (object_owner_soft);
+        copy = dxf_string_share (object_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (acad_proxy_entity->object_owner_soft);
+        acad_proxy_entity->object_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1824,6 +1852,8 @@ dxf_acad_proxy_entity_set_material
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (acad_proxy_entity == NULL)
         {
@@ -1839,7 +1869,13 @@ dxf_acad_proxy_entity_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        acad_proxy_entity->material = strdup (material);
+        copy = dxf_string_share (material);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (acad_proxy_entity->material);
+        acad_proxy_entity->material = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1904,6 +1940,8 @@ dxf_acad_proxy_entity_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (acad_proxy_entity == NULL)
         {
@@ -1919,7 +1957,13 @@ dxf_acad_proxy_entity_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        acad_proxy_entity->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (acad_proxy_entity->dictionary_owner_hard);
+        acad_proxy_entity->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2050,6 +2094,8 @@ dxf_acad_proxy_entity_set_plot_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (acad_proxy_entity == NULL)
         {
@@ -2065,7 +2111,13 @@ dxf_acad_proxy_entity_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        acad_proxy_entity->plot_style_name = strdup (plot_style_name);
+        copy = dxf_string_share (plot_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (acad_proxy_entity->plot_style_name);
+        acad_proxy_entity->plot_style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2195,6 +2247,8 @@ dxf_acad_proxy_entity_set_color_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (acad_proxy_entity == NULL)
         {
@@ -2210,7 +2264,13 @@ dxf_acad_proxy_entity_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        acad_proxy_entity->color_name = strdup (color_name);
+        copy = dxf_string_share (color_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (acad_proxy_entity->color_name);
+        acad_proxy_entity->color_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
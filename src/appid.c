@@ -57,6 +57,7 @@
 
 
 #include "appid.h"
+#include "util.h"
 
 
 /*!
@@ -127,11 +128,11 @@ dxf_appid_init
                 return (NULL);
         }
         appid->id_code = 0;
-        appid->application_name = strdup ("");
+        appid->application_name = dxf_string_share ("");
         appid->flag = 0;
-        appid->dictionary_owner_soft = strdup ("");
-        appid->object_owner_soft = strdup ("");
-        appid->dictionary_owner_hard = strdup ("");
+        appid->dictionary_owner_soft = dxf_string_share ("");
+        appid->object_owner_soft = dxf_string_share ("");
+        appid->dictionary_owner_hard = dxf_string_share ("");
         appid->next = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -211,8 +212,7 @@ dxf_appid_read
                 {
                         /* Now follows a string containing an application
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", appid->application_name);
+                        dxf_read_string (fp, &appid->application_name);
                 }
                 else if (strcmp (temp_string, "70") == 0)
                 {
@@ -227,15 +227,13 @@ dxf_appid_read
                         {
                                 /* Now follows a string containing a soft-pointer
                                  * ID/handle to owner dictionary. */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%s\n", appid->dictionary_owner_soft);
+                                dxf_read_string (fp, &appid->dictionary_owner_soft);
                         }
                         if (iter330 == 1)
                         {
                                 /* Now follows a string containing a soft-pointer
                                  * ID/handle to owner object. */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%s\n", appid->object_owner_soft);
+                                dxf_read_string (fp, &appid->object_owner_soft);
                         }
                         iter330++;
                 }
@@ -243,8 +241,7 @@ dxf_appid_read
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", appid->dictionary_owner_hard);
+                        dxf_read_string (fp, &appid->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "999") == 0)
                 {
@@ -407,10 +404,10 @@ dxf_appid_free
                 __FUNCTION__);
               return (EXIT_FAILURE);
         }
-        free (appid->application_name);
-        free (appid->dictionary_owner_soft);
-        free (appid->object_owner_soft);
-        free (appid->dictionary_owner_hard);
+        dxf_string_free (appid->application_name);
+        dxf_string_free (appid->dictionary_owner_soft);
+        dxf_string_free (appid->object_owner_soft);
+        dxf_string_free (appid->dictionary_owner_hard);
         free (appid);
         appid = NULL;
 #if DEBUG
@@ -591,6 +588,8 @@ dxf_appid_set_application_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (appid == NULL)
         {
@@ -606,7 +605,13 @@ dxf_appid_set_application_name
                   __FUNCTION__);
                 return (NULL);
         }
-        appid->application_name = strdup (name);
+        copy = dxf_string_share (name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (appid->application_name);
+        appid->application_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -885,6 +890,8 @@ dxf_appid_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (appid == NULL)
         {
@@ -900,7 +907,13 @@ dxf_appid_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        appid->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (appid->dictionary_owner_soft);
+        appid->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -965,6 +978,8 @@ dxf_appid_set_object_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (appid == NULL)
         {
@@ -980,7 +995,13 @@ dxf_appid_set_object_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        appid->object_owner_soft = strdup (object_owner_soft);
+        copy = dxf_string_share (object_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (appid->object_owner_soft);
+        appid->object_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1045,6 +1066,8 @@ dxf_appid_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (appid == NULL)
         {
@@ -1060,7 +1083,13 @@ dxf_appid_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        appid->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (appid->dictionary_owner_hard);
+        appid->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
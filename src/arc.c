@@ -40,6 +40,8 @@
 
 
 #include "arc.h"
+#include "stats.h"
+#include "util.h"
 
 
 /*!
@@ -72,6 +74,7 @@ dxf_arc_new ()
         else
         {
                 memset (arc, 0, size);
+                dxf_stats_count_allocation (ARC, size);
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -113,8 +116,8 @@ dxf_arc_init
                 return (NULL);
         }
         arc->id_code = 0;
-        arc->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        arc->layer = strdup (DXF_DEFAULT_LAYER);
+        arc->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        arc->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         arc->elevation = 0.0;
         arc->thickness = 0.0;
         arc->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
@@ -123,19 +126,17 @@ dxf_arc_init
         arc->paperspace = DXF_MODELSPACE;
         arc->graphics_data_size = 0;
         arc->shadow_mode = 0;
-        arc->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_new ();
-        arc->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_init (arc->binary_graphics_data);
-        arc->dictionary_owner_soft = strdup ("");
-        arc->object_owner_soft = strdup ("");
-        arc->material = strdup ("");
-        arc->dictionary_owner_hard = strdup ("");
+        arc->binary_graphics_data = NULL;
+        arc->dictionary_owner_soft = dxf_string_share ("");
+        arc->object_owner_soft = dxf_string_share ("");
+        arc->material = dxf_string_share ("");
+        arc->dictionary_owner_hard = dxf_string_share ("");
         arc->lineweight = 0;
-        arc->plot_style_name = strdup ("");
+        arc->plot_style_name = dxf_string_share ("");
         arc->color_value = 0;
-        arc->color_name = strdup ("");
+        arc->color_name = dxf_string_share ("");
         arc->transparency = 0;
         arc->p0 = dxf_point_new ();
-        arc->p0 = dxf_point_init (arc->p0);
         arc->p0->x0 = 0.0;
         arc->p0->y0 = 0.0;
         arc->p0->z0 = 0.0;
@@ -225,14 +226,12 @@ dxf_arc_read
                 {
                         /* Now follows a string containing a linetype
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", arc->linetype);
+                        dxf_read_string (fp, &arc->linetype);
                 }
                 else if (strcmp (temp_string, "8") == 0)
                 {
                         /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", arc->layer);
+                        dxf_read_string (fp, &arc->layer);
                 }
                 else if (strcmp (temp_string, "10") == 0)
                 {
@@ -380,10 +379,7 @@ dxf_arc_read
                 {
                         /* Now follows a string containing binary
                          * graphics data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", iter310->data_line);
-                        dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) iter310->next);
-                        iter310 = (DxfBinaryGraphicsData *) iter310->next;
+                        iter310 = dxf_binary_graphics_data_read (fp, &arc->binary_graphics_data, iter310);
                 }
                 else if (strcmp (temp_string, "330") == 0)
                 {
@@ -391,15 +387,13 @@ dxf_arc_read
                         {
                                 /* Now follows a string containing a soft-pointer
                                  * ID/handle to owner dictionary. */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%s\n", arc->dictionary_owner_soft);
+                                dxf_read_string (fp, &arc->dictionary_owner_soft);
                         }
                         if (iter330 == 1)
                         {
                                 /* Now follows a string containing a soft-pointer
                                  * ID/handle to owner object. */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%s\n", arc->object_owner_soft);
+                                dxf_read_string (fp, &arc->object_owner_soft);
                         }
                         iter330++;
                 }
@@ -407,15 +401,13 @@ dxf_arc_read
                 {
                         /* Now follows a string containing a
                          * hard-pointer ID/handle to material object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", arc->material);
+                        dxf_read_string (fp, &arc->material);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", arc->dictionary_owner_hard);
+                        dxf_read_string (fp, &arc->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "370") == 0)
                 {
@@ -428,8 +420,7 @@ dxf_arc_read
                 {
                         /* Now follows a string containing a plot style
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", arc->plot_style_name);
+                        dxf_read_string (fp, &arc->plot_style_name);
                 }
                 else if (strcmp (temp_string, "420") == 0)
                 {
@@ -441,8 +432,7 @@ dxf_arc_read
                 {
                         /* Now follows a string containing a color
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", arc->color_name);
+                        dxf_read_string (fp, &arc->color_name);
                 }
                 else if (strcmp (temp_string, "440") == 0)
                 {
@@ -468,11 +458,13 @@ dxf_arc_read
         /* Handle omitted members and/or illegal values. */
         if (strcmp (arc->linetype, "") == 0)
         {
-                arc->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (arc->linetype);
+                arc->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (arc->layer, "") == 0)
         {
-                arc->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (arc->layer);
+                arc->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Clean up. */
         free (temp_string);
@@ -591,7 +583,8 @@ dxf_arc_write
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                arc->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (arc->linetype);
+                arc->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (arc->layer, "") == 0)
         {
@@ -776,14 +769,18 @@ dxf_arc_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (arc->linetype);
-        free (arc->layer);
-        free (arc->dictionary_owner_soft);
-        free (arc->object_owner_soft);
-        free (arc->material);
-        free (arc->dictionary_owner_hard);
-        free (arc->plot_style_name);
-        free (arc->color_name);
+        dxf_string_free (arc->linetype);
+        dxf_string_free (arc->layer);
+        if (arc->binary_graphics_data != NULL)
+        {
+                dxf_binary_graphics_data_free_list (arc->binary_graphics_data);
+        }
+        dxf_string_free (arc->dictionary_owner_soft);
+        dxf_string_free (arc->object_owner_soft);
+        dxf_string_free (arc->material);
+        dxf_string_free (arc->dictionary_owner_hard);
+        dxf_string_free (arc->plot_style_name);
+        dxf_string_free (arc->color_name);
         dxf_point_free (arc->p0);
         free (arc);
         arc = NULL;
@@ -961,6 +958,8 @@ dxf_arc_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (arc == NULL)
         {
@@ -976,7 +975,13 @@ dxf_arc_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        arc->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (arc->linetype);
+        arc->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1040,6 +1045,8 @@ dxf_arc_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (arc == NULL)
         {
@@ -1055,7 +1062,13 @@ dxf_arc_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        arc->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (arc->layer);
+        arc->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1855,6 +1868,8 @@ dxf_arc_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (arc == NULL)
         {
@@ -1870,7 +1885,13 @@ dxf_arc_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        arc->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (arc->dictionary_owner_soft);
+        arc->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1935,6 +1956,8 @@ dxf_arc_set_object_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (arc == NULL)
         {
@@ -1950,7 +1973,13 @@ dxf_arc_set_object_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        arc->object_owner_soft = strdup (object_owner_soft);
+        copy = dxf_string_share (object_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (arc->object_owner_soft);
+        arc->object_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2017,6 +2046,8 @@ dxf_arc_set_material
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (arc == NULL)
         {
@@ -2032,7 +2063,13 @@ dxf_arc_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        arc->material = strdup (material);
+        copy = dxf_string_share (material);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (arc->material);
+        arc->material = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2100,6 +2137,8 @@ dxf_arc_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (arc == NULL)
         {
@@ -2115,7 +2154,13 @@ dxf_arc_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        arc->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (arc->dictionary_owner_hard);
+        arc->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2245,6 +2290,8 @@ dxf_arc_set_plot_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (arc == NULL)
         {
@@ -2260,7 +2307,13 @@ dxf_arc_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        arc->plot_style_name = strdup (plot_style_name);
+        copy = dxf_string_share (plot_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (arc->plot_style_name);
+        arc->plot_style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2390,6 +2443,8 @@ dxf_arc_set_color_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (arc == NULL)
         {
@@ -2405,7 +2460,13 @@ dxf_arc_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        arc->color_name = strdup (color_name);
+        copy = dxf_string_share (color_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (arc->color_name);
+        arc->color_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -40,6 +40,8 @@
 
 
 #include "attdef.h"
+#include "stats.h"
+#include "util.h"
 
 
 /*!
@@ -69,6 +71,7 @@ dxf_attdef_new ()
         else
         {
                 memset (attdef, 0, size);
+                dxf_stats_count_allocation (ATTDEF, size);
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -109,8 +112,8 @@ dxf_attdef_init
               return (NULL);
         }
         attdef->id_code = 0;
-        attdef->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        attdef->layer = strdup (DXF_DEFAULT_LAYER);
+        attdef->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        attdef->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         attdef->elevation = 0.0;
         attdef->thickness = 0.0;
         attdef->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
@@ -119,28 +122,25 @@ dxf_attdef_init
         attdef->paperspace = DXF_MODELSPACE;
         attdef->graphics_data_size = 0;
         attdef->shadow_mode = 0;
-        attdef->binary_graphics_data = dxf_binary_graphics_data_new ();
-        attdef->binary_graphics_data = dxf_binary_graphics_data_new (attdef->binary_graphics_data);
-        attdef->dictionary_owner_soft = strdup ("");
-        attdef->object_owner_soft = strdup ("");
-        attdef->material = strdup ("");
-        attdef->dictionary_owner_hard = strdup ("");
+        attdef->binary_graphics_data = NULL;
+        attdef->dictionary_owner_soft = dxf_string_share ("");
+        attdef->object_owner_soft = dxf_string_share ("");
+        attdef->material = dxf_string_share ("");
+        attdef->dictionary_owner_hard = dxf_string_share ("");
         attdef->lineweight = 0.0;
-        attdef->plot_style_name = strdup ("");
+        attdef->plot_style_name = dxf_string_share ("");
         attdef->color_value = 0;
-        attdef->color_name = strdup ("");
+        attdef->color_name = dxf_string_share ("");
         attdef->transparency = 0;
-        attdef->default_value = strdup ("");
-        attdef->tag_value = strdup ("");
-        attdef->prompt_value = strdup ("");
-        attdef->text_style = strdup (DXF_DEFAULT_TEXTSTYLE);
+        attdef->default_value = dxf_string_share ("");
+        attdef->tag_value = dxf_string_share ("");
+        attdef->prompt_value = dxf_string_share ("");
+        attdef->text_style = dxf_string_share (DXF_DEFAULT_TEXTSTYLE);
         attdef->p0 = dxf_point_new ();
-        attdef->p0 = dxf_point_init (attdef->p0);
         attdef->p0->x0 = 0.0;
         attdef->p0->y0 = 0.0;
         attdef->p0->z0 = 0.0;
         attdef->p1 = dxf_point_new ();
-        attdef->p1 = dxf_point_init (attdef->p1);
         attdef->p1->x0 = 0.0;
         attdef->p1->y0 = 0.0;
         attdef->p1->z0 = 0.0;
@@ -236,21 +236,18 @@ dxf_attdef_read
                 {
                         /* Now follows a string containing the attribute
                          * default value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", attdef->default_value);
+                        dxf_read_string (fp, &attdef->default_value);
                 }
                 else if (strcmp (temp_string, "2") == 0)
                 {
                         /* Now follows a string containing a tag value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", attdef->tag_value);
+                        dxf_read_string (fp, &attdef->tag_value);
                 }
                 else if (strcmp (temp_string, "3") == 0)
                 {
                         /* Now follows a string containing a prompt
                          * value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", attdef->prompt_value);
+                        dxf_read_string (fp, &attdef->prompt_value);
                 }
                 else if (strcmp (temp_string, "5") == 0)
                 {
@@ -263,20 +260,17 @@ dxf_attdef_read
                 {
                         /* Now follows a string containing a linetype
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", attdef->linetype);
+                        dxf_read_string (fp, &attdef->linetype);
                 }
                 else if (strcmp (temp_string, "7") == 0)
                 {
                         /* Now follows a string containing a text style. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", attdef->text_style);
+                        dxf_read_string (fp, &attdef->text_style);
                 }
                 else if (strcmp (temp_string, "8") == 0)
                 {
                         /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", attdef->layer);
+                        dxf_read_string (fp, &attdef->layer);
                 }
                 else if (strcmp (temp_string, "10") == 0)
                 {
@@ -495,10 +489,7 @@ dxf_attdef_read
                 {
                         /* Now follows a string containing binary
                          * graphics data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", iter310->data_line);
-                        dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) iter310->next);
-                        iter310 = (DxfBinaryGraphicsData *) iter310->next;
+                        iter310 = dxf_binary_graphics_data_read (fp, &attdef->binary_graphics_data, iter310);
                 }
                 else if (strcmp (temp_string, "330") == 0)
                 {
@@ -506,15 +497,13 @@ dxf_attdef_read
                         {
                                 /* Now follows a string containing a soft-pointer
                                  * ID/handle to owner dictionary. */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%s\n", attdef->dictionary_owner_soft);
+                                dxf_read_string (fp, &attdef->dictionary_owner_soft);
                         }
                         if (iter330 == 1)
                         {
                                 /* Now follows a string containing a soft-pointer
                                  * ID/handle to owner object. */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%s\n", attdef->object_owner_soft);
+                                dxf_read_string (fp, &attdef->object_owner_soft);
                         }
                         iter330++;
                 }
@@ -522,15 +511,13 @@ dxf_attdef_read
                 {
                         /* Now follows a string containing a
                          * hard-pointer ID/handle to material object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", attdef->material);
+                        dxf_read_string (fp, &attdef->material);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", attdef->dictionary_owner_hard);
+                        dxf_read_string (fp, &attdef->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "370") == 0)
                 {
@@ -543,8 +530,7 @@ dxf_attdef_read
                 {
                         /* Now follows a string containing a plot style
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", attdef->plot_style_name);
+                        dxf_read_string (fp, &attdef->plot_style_name);
                 }
                 else if (strcmp (temp_string, "420") == 0)
                 {
@@ -556,8 +542,7 @@ dxf_attdef_read
                 {
                         /* Now follows a string containing a color
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", attdef->color_name);
+                        dxf_read_string (fp, &attdef->color_name);
                 }
                 else if (strcmp (temp_string, "440") == 0)
                 {
@@ -583,11 +568,13 @@ dxf_attdef_read
         /* Handle omitted members and/or illegal values. */
         if (strcmp (attdef->linetype, "") == 0)
         {
-                attdef->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (attdef->linetype);
+                attdef->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (attdef->layer, "") == 0)
         {
-                attdef->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (attdef->layer);
+                attdef->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Clean up. */
         free (temp_string);
@@ -651,7 +638,8 @@ dxf_attdef_write
                 fprintf (stderr,
                   (_("\tdefault text style STANDARD applied to %s entity.\n")),
                   dxf_entity_name);
-                attdef->text_style = strdup (DXF_DEFAULT_TEXTSTYLE);
+                dxf_string_free (attdef->text_style);
+                attdef->text_style = dxf_string_share (DXF_DEFAULT_TEXTSTYLE);
         }
         if (strcmp (attdef->linetype, "") == 0)
         {
@@ -661,7 +649,8 @@ dxf_attdef_write
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                attdef->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (attdef->linetype);
+                attdef->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (attdef->layer, "") == 0)
         {
@@ -671,7 +660,8 @@ dxf_attdef_write
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0")),
                   dxf_entity_name);
-                attdef->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (attdef->layer);
+                attdef->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         if (attdef->height == 0.0)
         {
@@ -911,19 +901,22 @@ dxf_attdef_free
                 __FUNCTION__);
               return (EXIT_FAILURE);
         }
-        free (attdef->linetype);
-        free (attdef->layer);
-        dxf_binary_graphics_data_free_list (attdef->binary_graphics_data);
-        free (attdef->dictionary_owner_soft);
-        free (attdef->object_owner_soft);
-        free (attdef->material);
-        free (attdef->dictionary_owner_hard);
-        free (attdef->plot_style_name);
-        free (attdef->color_name);
-        free (attdef->default_value);
-        free (attdef->tag_value);
-        free (attdef->prompt_value);
-        free (attdef->text_style);
+        dxf_string_free (attdef->linetype);
+        dxf_string_free (attdef->layer);
+        if (attdef->binary_graphics_data != NULL)
+        {
+                dxf_binary_graphics_data_free_list (attdef->binary_graphics_data);
+        }
+        dxf_string_free (attdef->dictionary_owner_soft);
+        dxf_string_free (attdef->object_owner_soft);
+        dxf_string_free (attdef->material);
+        dxf_string_free (attdef->dictionary_owner_hard);
+        dxf_string_free (attdef->plot_style_name);
+        dxf_string_free (attdef->color_name);
+        dxf_string_free (attdef->default_value);
+        dxf_string_free (attdef->tag_value);
+        dxf_string_free (attdef->prompt_value);
+        dxf_string_free (attdef->text_style);
         dxf_point_free_list (attdef->p0);
         dxf_point_free_list (attdef->p1);
         free (attdef);
@@ -1095,6 +1088,8 @@ dxf_attdef_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (attdef == NULL)
         {
@@ -1110,7 +1105,13 @@ dxf_attdef_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        attdef->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (attdef->linetype);
+        attdef->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1170,6 +1171,8 @@ dxf_attdef_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (attdef == NULL)
         {
@@ -1185,7 +1188,13 @@ dxf_attdef_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        attdef->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (attdef->layer);
+        attdef->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1961,6 +1970,8 @@ dxf_attdef_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (attdef == NULL)
         {
@@ -1976,7 +1987,13 @@ dxf_attdef_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        attdef->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (attdef->dictionary_owner_soft);
+        attdef->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2041,6 +2058,8 @@ dxf_attdef_set_object_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (attdef == NULL)
         {
@@ -2056,7 +2075,13 @@ dxf_attdef_set_object_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        attdef->object_owner_soft = strdup (object_owner_soft);
+        copy = dxf_string_share (object_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (attdef->object_owner_soft);
+        attdef->object_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2123,6 +2148,8 @@ dxf_attdef_set_material
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (attdef == NULL)
         {
@@ -2138,7 +2165,13 @@ dxf_attdef_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        attdef->material = strdup (material);
+        copy = dxf_string_share (material);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (attdef->material);
+        attdef->material = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2203,6 +2236,8 @@ dxf_attdef_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (attdef == NULL)
         {
@@ -2218,7 +2253,13 @@ dxf_attdef_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        attdef->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (attdef->dictionary_owner_hard);
+        attdef->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2348,6 +2389,8 @@ dxf_attdef_set_plot_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (attdef == NULL)
         {
@@ -2363,7 +2406,13 @@ dxf_attdef_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        attdef->plot_style_name = strdup (plot_style_name);
+        copy = dxf_string_share (plot_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (attdef->plot_style_name);
+        attdef->plot_style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2493,6 +2542,8 @@ dxf_attdef_set_color_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (attdef == NULL)
         {
@@ -2508,7 +2559,13 @@ dxf_attdef_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        attdef->color_name = strdup (color_name);
+        copy = dxf_string_share (color_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (attdef->color_name);
+        attdef->color_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2636,6 +2693,8 @@ dxf_attdef_set_default_value
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (attdef == NULL)
         {
@@ -2651,7 +2710,13 @@ dxf_attdef_set_default_value
                   __FUNCTION__);
                 return (NULL);
         }
-        attdef->default_value = strdup (default_value);
+        copy = dxf_string_share (default_value);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (attdef->default_value);
+        attdef->default_value = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2714,6 +2779,8 @@ dxf_attdef_set_tag_value
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (attdef == NULL)
         {
@@ -2729,7 +2796,13 @@ dxf_attdef_set_tag_value
                   __FUNCTION__);
                 return (NULL);
         }
-        attdef->tag_value = strdup (tag_value);
+        copy = dxf_string_share (tag_value);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (attdef->tag_value);
+        attdef->tag_value = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2792,6 +2865,8 @@ dxf_attdef_set_prompt_value
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (attdef == NULL)
         {
@@ -2807,7 +2882,13 @@ dxf_attdef_set_prompt_value
                   __FUNCTION__);
                 return (NULL);
         }
-        attdef->prompt_value = strdup (prompt_value);
+        copy = dxf_string_share (prompt_value);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (attdef->prompt_value);
+        attdef->prompt_value = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2870,6 +2951,8 @@ dxf_attdef_set_text_style
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (attdef == NULL)
         {
@@ -2885,7 +2968,13 @@ dxf_attdef_set_text_style
                   __FUNCTION__);
                 return (NULL);
         }
-        attdef->text_style = strdup (text_style);
+        copy = dxf_string_share (text_style);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (attdef->text_style);
+        attdef->text_style = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
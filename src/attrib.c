@@ -40,6 +40,8 @@
 
 
 #include "attrib.h"
+#include "stats.h"
+#include "util.h"
 
 
 /*!
@@ -69,6 +71,7 @@ dxf_attrib_new ()
         else
         {
                 memset (attrib, 0, size);
+                dxf_stats_count_allocation (ATTRIB, size);
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -110,9 +113,9 @@ dxf_attrib_init
                 return (NULL);
         }
         attrib->id_code = 0;
-        attrib->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        attrib->text_style = strdup (DXF_DEFAULT_TEXTSTYLE);
-        attrib->layer = strdup (DXF_DEFAULT_LAYER);
+        attrib->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        attrib->text_style = dxf_string_share (DXF_DEFAULT_TEXTSTYLE);
+        attrib->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         attrib->elevation = 0.0;
         attrib->thickness = 0.0;
         attrib->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
@@ -121,26 +124,23 @@ dxf_attrib_init
         attrib->paperspace = DXF_MODELSPACE;
         attrib->graphics_data_size = 0;
         attrib->shadow_mode = 0;
-        attrib->binary_graphics_data = dxf_binary_graphics_data_new ();
-        attrib->binary_graphics_data = dxf_binary_graphics_data_new (attrib->binary_graphics_data);
-        attrib->dictionary_owner_soft = strdup("");
-        attrib->object_owner_soft = strdup("");
-        attrib->material = strdup("");
-        attrib->dictionary_owner_hard = strdup("");
+        attrib->binary_graphics_data = NULL;
+        attrib->dictionary_owner_soft = dxf_string_share ("");
+        attrib->object_owner_soft = dxf_string_share ("");
+        attrib->material = dxf_string_share ("");
+        attrib->dictionary_owner_hard = dxf_string_share ("");
         attrib->lineweight = 0;
-        attrib->plot_style_name = strdup ("");
+        attrib->plot_style_name = dxf_string_share ("");
         attrib->color_value = 0;
-        attrib->color_name = strdup ("");
+        attrib->color_name = dxf_string_share ("");
         attrib->transparency = 0;
-        attrib->default_value = strdup ("");
-        attrib->tag_value = strdup ("");
+        attrib->default_value = dxf_string_share ("");
+        attrib->tag_value = dxf_string_share ("");
         attrib->p0 = dxf_point_new ();
-        attrib->p0 = dxf_point_init (attrib->p0);
         attrib->p0->x0 = 0.0;
         attrib->p0->y0 = 0.0;
         attrib->p0->z0 = 0.0;
         attrib->p1 = dxf_point_new ();
-        attrib->p1 = dxf_point_init (attrib->p1);
         attrib->p1->x0 = 0.0;
         attrib->p1->y0 = 0.0;
         attrib->p1->z0 = 0.0;
@@ -236,14 +236,12 @@ dxf_attrib_read
                 {
                         /* Now follows a string containing the attribute
                          * value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", attrib->default_value);
+                        dxf_read_string (fp, &attrib->default_value);
                 }
                 else if (strcmp (temp_string, "2") == 0)
                 {
                         /* Now follows a string containing a tag value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", attrib->tag_value);
+                        dxf_read_string (fp, &attrib->tag_value);
                 }
                 else if (strcmp (temp_string, "5") == 0)
                 {
@@ -256,20 +254,17 @@ dxf_attrib_read
                 {
                         /* Now follows a string containing a linetype
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", attrib->linetype);
+                        dxf_read_string (fp, &attrib->linetype);
                 }
                 else if (strcmp (temp_string, "7") == 0)
                 {
                         /* Now follows a string containing a text style. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", attrib->text_style);
+                        dxf_read_string (fp, &attrib->text_style);
                 }
                 else if (strcmp (temp_string, "8") == 0)
                 {
                         /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", attrib->layer);
+                        dxf_read_string (fp, &attrib->layer);
                 }
                 else if (strcmp (temp_string, "10") == 0)
                 {
@@ -488,10 +483,7 @@ dxf_attrib_read
                 {
                         /* Now follows a string containing binary
                          * graphics data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", iter310->data_line);
-                        dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) iter310->next);
-                        iter310 = (DxfBinaryGraphicsData *) iter310->next;
+                        iter310 = dxf_binary_graphics_data_read (fp, &attrib->binary_graphics_data, iter310);
                 }
                 else if (strcmp (temp_string, "330") == 0)
                 {
@@ -499,15 +491,13 @@ dxf_attrib_read
                         {
                                 /* Now follows a string containing a soft-pointer
                                  * ID/handle to owner dictionary. */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%s\n", attrib->dictionary_owner_soft);
+                                dxf_read_string (fp, &attrib->dictionary_owner_soft);
                         }
                         if (iter330 == 1)
                         {
                                 /* Now follows a string containing a soft-pointer
                                  * ID/handle to owner object. */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%s\n", attrib->object_owner_soft);
+                                dxf_read_string (fp, &attrib->object_owner_soft);
                         }
                         iter330++;
                 }
@@ -515,15 +505,13 @@ dxf_attrib_read
                 {
                         /* Now follows a string containing a
                          * hard-pointer ID/handle to material object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", attrib->material);
+                        dxf_read_string (fp, &attrib->material);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", attrib->dictionary_owner_hard);
+                        dxf_read_string (fp, &attrib->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "370") == 0)
                 {
@@ -536,8 +524,7 @@ dxf_attrib_read
                 {
                         /* Now follows a string containing a plot style
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", attrib->plot_style_name);
+                        dxf_read_string (fp, &attrib->plot_style_name);
                 }
                 else if (strcmp (temp_string, "420") == 0)
                 {
@@ -549,8 +536,7 @@ dxf_attrib_read
                 {
                         /* Now follows a string containing a color
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", attrib->color_name);
+                        dxf_read_string (fp, &attrib->color_name);
                 }
                 else if (strcmp (temp_string, "440") == 0)
                 {
@@ -576,11 +562,13 @@ dxf_attrib_read
         /* Handle omitted members and/or illegal values. */
         if (strcmp (attrib->linetype, "") == 0)
         {
-                attrib->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (attrib->linetype);
+                attrib->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (attrib->layer, "") == 0)
         {
-                attrib->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (attrib->layer);
+                attrib->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Clean up. */
         free (temp_string);
@@ -653,7 +641,8 @@ dxf_attrib_write
                 fprintf (stderr,
                   (_("\tdefault text style STANDARD applied to %s entity.\n")),
                   dxf_entity_name);
-                attrib->text_style = strdup (DXF_DEFAULT_TEXTSTYLE);
+                dxf_string_free (attrib->text_style);
+                attrib->text_style = dxf_string_share (DXF_DEFAULT_TEXTSTYLE);
         }
         if (strcmp (attrib->linetype, "") == 0)
         {
@@ -663,7 +652,8 @@ dxf_attrib_write
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                attrib->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (attrib->linetype);
+                attrib->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (attrib->layer, "") == 0)
         {
@@ -673,7 +663,8 @@ dxf_attrib_write
                 fprintf (stderr,
                   (_("\t%s entity is relocated to the default layer.\n")),
                   dxf_entity_name);
-                attrib->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (attrib->layer);
+                attrib->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         if (attrib->height == 0.0)
         {
@@ -921,18 +912,21 @@ dxf_attrib_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (attrib->linetype);
-        free (attrib->layer);
-        dxf_binary_graphics_data_free_list (attrib->binary_graphics_data);
-        free (attrib->dictionary_owner_soft);
-        free (attrib->object_owner_soft);
-        free (attrib->material);
-        free (attrib->dictionary_owner_hard);
-        free (attrib->plot_style_name);
-        free (attrib->color_name);
-        free (attrib->default_value);
-        free (attrib->tag_value);
-        free (attrib->text_style);
+        dxf_string_free (attrib->linetype);
+        dxf_string_free (attrib->layer);
+        if (attrib->binary_graphics_data != NULL)
+        {
+                dxf_binary_graphics_data_free_list (attrib->binary_graphics_data);
+        }
+        dxf_string_free (attrib->dictionary_owner_soft);
+        dxf_string_free (attrib->object_owner_soft);
+        dxf_string_free (attrib->material);
+        dxf_string_free (attrib->dictionary_owner_hard);
+        dxf_string_free (attrib->plot_style_name);
+        dxf_string_free (attrib->color_name);
+        dxf_string_free (attrib->default_value);
+        dxf_string_free (attrib->tag_value);
+        dxf_string_free (attrib->text_style);
         dxf_point_free (attrib->p0);
         dxf_point_free (attrib->p1);
         free (attrib);
@@ -1104,6 +1098,8 @@ dxf_attrib_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (attrib == NULL)
         {
@@ -1119,7 +1115,13 @@ dxf_attrib_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        attrib->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (attrib->linetype);
+        attrib->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1179,6 +1181,8 @@ dxf_attrib_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (attrib == NULL)
         {
@@ -1194,7 +1198,13 @@ dxf_attrib_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        attrib->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (attrib->layer);
+        attrib->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1972,6 +1982,8 @@ dxf_attrib_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (attrib == NULL)
         {
@@ -1987,7 +1999,13 @@ dxf_attrib_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        attrib->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (attrib->dictionary_owner_soft);
+        attrib->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2052,6 +2070,8 @@ dxf_attrib_set_object_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (attrib == NULL)
         {
@@ -2067,7 +2087,13 @@ dxf_attrib_set_object_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        attrib->object_owner_soft = strdup (object_owner_soft);
+        copy = dxf_string_share (object_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (attrib->object_owner_soft);
+        attrib->object_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2134,6 +2160,8 @@ dxf_attrib_set_material
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (attrib == NULL)
         {
@@ -2149,7 +2177,13 @@ dxf_attrib_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        attrib->material = strdup (material);
+        copy = dxf_string_share (material);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (attrib->material);
+        attrib->material = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2214,6 +2248,8 @@ dxf_attrib_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (attrib == NULL)
         {
@@ -2229,7 +2265,13 @@ dxf_attrib_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        attrib->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (attrib->dictionary_owner_hard);
+        attrib->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2359,6 +2401,8 @@ dxf_attrib_set_plot_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (attrib == NULL)
         {
@@ -2374,7 +2418,13 @@ dxf_attrib_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        attrib->plot_style_name = strdup (plot_style_name);
+        copy = dxf_string_share (plot_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (attrib->plot_style_name);
+        attrib->plot_style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2504,6 +2554,8 @@ dxf_attrib_set_color_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (attrib == NULL)
         {
@@ -2519,7 +2571,13 @@ dxf_attrib_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        attrib->color_name = strdup (color_name);
+        copy = dxf_string_share (color_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (attrib->color_name);
+        attrib->color_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2647,6 +2705,8 @@ dxf_attrib_set_default_value
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (attrib == NULL)
         {
@@ -2662,7 +2722,13 @@ dxf_attrib_set_default_value
                   __FUNCTION__);
                 return (NULL);
         }
-        attrib->default_value = strdup (default_value);
+        copy = dxf_string_share (default_value);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (attrib->default_value);
+        attrib->default_value = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2725,6 +2791,8 @@ dxf_attrib_set_tag_value
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (attrib == NULL)
         {
@@ -2740,7 +2808,13 @@ dxf_attrib_set_tag_value
                   __FUNCTION__);
                 return (NULL);
         }
-        attrib->tag_value = strdup (tag_value);
+        copy = dxf_string_share (tag_value);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (attrib->tag_value);
+        attrib->tag_value = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2803,6 +2877,8 @@ dxf_attrib_set_text_style
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (attrib == NULL)
         {
@@ -2818,7 +2894,13 @@ dxf_attrib_set_text_style
                   __FUNCTION__);
                 return (NULL);
         }
-        attrib->text_style = strdup (text_style);
+        copy = dxf_string_share (text_style);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (attrib->text_style);
+        attrib->text_style = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -0,0 +1,413 @@
+/*!
+ * \file batch.c
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Functions for parallel batch reading of DXF files.
+ *
+ * The files are scheduled largest first (by their \c stat () size) over a
+ * pool of worker threads with work stealing: the files are dealt round
+ * robin over a queue per worker, every worker takes the largest file
+ * from the front of its own queue, and a worker with an empty queue
+ * steals the smallest file from the back of another queue.\n
+ * Every worker reuses its \c DxfFile handle, stdio read buffer and
+ * \c DxfDrawing for all files it reads.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include "batch.h"
+#include "file.h"
+#include <pthread.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+/*!
+ * \brief A file in a batch.
+ */
+typedef struct
+dxf_batch_file_struct
+{
+        char *path;
+                /*!< Name of the file. */
+        off_t size;
+                /*!< Size of the file in bytes, 0 when unknown. */
+        int index;
+                /*!< Position of the file in the list of the caller. */
+        int status;
+                /*!< \c EXIT_SUCCESS when processed, \c EXIT_FAILURE
+                 * when not (yet) processed or when an error occurred. */
+} DxfBatchFile;
+
+
+/*!
+ * \brief The queue of files of a worker.
+ */
+typedef struct
+dxf_batch_queue_struct
+{
+        pthread_mutex_t mutex;
+                /*!< Protects \c head and \c tail. */
+        int *files;
+                /*!< Indices of the files in the sorted file array,
+                 * largest file first. */
+        int head;
+                /*!< First file not yet taken, taken by the owner. */
+        int tail;
+                /*!< One past the last file not yet taken, stolen by
+                 * other workers. */
+} DxfBatchQueue;
+
+
+/*!
+ * \brief A worker of a batch.
+ */
+typedef struct
+dxf_batch_worker_struct
+{
+        int number;
+                /*!< Number of the worker, and of its own queue. */
+        int number_of_workers;
+                /*!< Number of workers (and queues). */
+        DxfBatchQueue *queues;
+                /*!< Queues of all workers. */
+        DxfBatchFile *files;
+                /*!< Files sorted by size, largest first. */
+        DxfBatchCallback callback;
+                /*!< Callback invoked for every file. */
+        void *user_data;
+                /*!< User data passed to the callback. */
+} DxfBatchWorker;
+
+
+static void *dxf_batch_run_worker (void *data);
+static int dxf_batch_next (DxfBatchWorker *worker);
+static int dxf_batch_compare (const void *a, const void *b);
+
+
+/*!
+ * \brief Read a batch of DXF files in parallel and invoke a callback for
+ * every file.
+ *
+ * The files are read with dxf_file_read_stream () by
+ * \c number_of_threads workers (the calling thread being one of them),
+ * largest file first.\n
+ * When \c number_of_threads is smaller than 1 the number of online
+ * processors is used.\n
+ * The callback is invoked once for every file, also for files which
+ * could not be read, from the worker which read the file.
+ *
+ * \note This function is reentrant, the callback has to be reentrant
+ * too.
+ *
+ * \return \c EXIT_SUCCESS when all files were read and processed, or
+ * \c EXIT_FAILURE when an error occurred for one or more files.
+ */
+int
+dxf_batch_process
+(
+        char **paths,
+                /*!< array of names of DXF files. */
+        int number_of_paths,
+                /*!< number of names in \c paths. */
+        int number_of_threads,
+                /*!< number of worker threads. */
+        DxfBatchCallback callback,
+                /*!< callback invoked for every file, may be \c NULL. */
+        void *user_data
+                /*!< user data passed to the callback. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfBatchFile *files = NULL;
+        DxfBatchQueue *queues = NULL;
+        DxfBatchWorker *workers = NULL;
+        pthread_t *threads = NULL;
+        int *started = NULL;
+        int *slots = NULL;
+        struct stat buffer;
+        int status = EXIT_SUCCESS;
+        int offset;
+        int i;
+        int j;
+
+        /* Do some basic checks. */
+        if (paths == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (number_of_paths <= 0)
+        {
+                return (EXIT_SUCCESS);
+        }
+        if (number_of_threads < 1)
+        {
+                number_of_threads = (int) sysconf (_SC_NPROCESSORS_ONLN);
+        }
+        if (number_of_threads < 1)
+        {
+                number_of_threads = 1;
+        }
+        if (number_of_threads > number_of_paths)
+        {
+                number_of_threads = number_of_paths;
+        }
+        files = calloc (number_of_paths, sizeof (DxfBatchFile));
+        slots = calloc (number_of_paths, sizeof (int));
+        queues = calloc (number_of_threads, sizeof (DxfBatchQueue));
+        workers = calloc (number_of_threads, sizeof (DxfBatchWorker));
+        threads = calloc (number_of_threads, sizeof (pthread_t));
+        started = calloc (number_of_threads, sizeof (int));
+        if ((files == NULL) || (slots == NULL) || (queues == NULL)
+          || (workers == NULL) || (threads == NULL) || (started == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                free (files);
+                free (slots);
+                free (queues);
+                free (workers);
+                free (threads);
+                free (started);
+                return (EXIT_FAILURE);
+        }
+        /* Sort the files by size, largest first. */
+        for (i = 0; i < number_of_paths; i++)
+        {
+                files[i].path = paths[i];
+                files[i].size = 0;
+                if ((paths[i] != NULL) && (stat (paths[i], &buffer) == 0))
+                {
+                        files[i].size = buffer.st_size;
+                }
+                files[i].index = i;
+                files[i].status = EXIT_FAILURE;
+        }
+        qsort (files, number_of_paths, sizeof (DxfBatchFile), dxf_batch_compare);
+        /* Deal the files round robin over the queues, every queue holds
+         * its files largest first. */
+        offset = 0;
+        for (i = 0; i < number_of_threads; i++)
+        {
+                pthread_mutex_init (&queues[i].mutex, NULL);
+                queues[i].files = slots + offset;
+                queues[i].head = 0;
+                queues[i].tail = 0;
+                for (j = i; j < number_of_paths; j += number_of_threads)
+                {
+                        queues[i].files[queues[i].tail++] = j;
+                }
+                offset += queues[i].tail;
+                workers[i].number = i;
+                workers[i].number_of_workers = number_of_threads;
+                workers[i].queues = queues;
+                workers[i].files = files;
+                workers[i].callback = callback;
+                workers[i].user_data = user_data;
+        }
+        /* The first worker is run by the calling thread, the queue of a
+         * worker which could not be started is stolen by the others. */
+        for (i = 1; i < number_of_threads; i++)
+        {
+                if (pthread_create (&threads[i], NULL, dxf_batch_run_worker, &workers[i]) == 0)
+                {
+                        started[i] = TRUE;
+                }
+        }
+        dxf_batch_run_worker (&workers[0]);
+        for (i = 1; i < number_of_threads; i++)
+        {
+                if (started[i])
+                {
+                        pthread_join (threads[i], NULL);
+                }
+        }
+        for (i = 0; i < number_of_threads; i++)
+        {
+                pthread_mutex_destroy (&queues[i].mutex);
+        }
+        for (i = 0; i < number_of_paths; i++)
+        {
+                if (files[i].status != EXIT_SUCCESS)
+                {
+                        status = EXIT_FAILURE;
+                }
+        }
+        free (files);
+        free (slots);
+        free (queues);
+        free (workers);
+        free (threads);
+        free (started);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (status);
+}
+
+
+/*!
+ * \brief Read files until all queues are empty, used as thread entry
+ * point.
+ *
+ * The \c DxfFile handle, stdio read buffer and drawing are reused for
+ * all files of the worker.
+ */
+static void *
+dxf_batch_run_worker
+(
+        void *data
+                /*!< a pointer to a \c DxfBatchWorker. */
+)
+{
+        DxfBatchWorker *worker = NULL;
+        DxfBatchFile *file = NULL;
+        DxfDrawing *drawing = NULL;
+        DxfFile fp;
+        char *buffer = NULL;
+        int index;
+
+        worker = (DxfBatchWorker *) data;
+        drawing = dxf_drawing_new ();
+        if (drawing == NULL)
+        {
+                /* Leave the files to the other workers. */
+                return (NULL);
+        }
+        /* Without a buffer of our own stdio allocates one per file. */
+        buffer = malloc (DXF_BATCH_BUFFER_SIZE);
+        while ((index = dxf_batch_next (worker)) >= 0)
+        {
+                file = &worker->files[index];
+                memset (&fp, 0, sizeof (DxfFile));
+                fp.filename = file->path;
+                fp.fp = (file->path != NULL) ? fopen (file->path, "r") : NULL;
+                if (fp.fp == NULL)
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () could not open file: %s for reading.\n")),
+                          __FUNCTION__, (file->path != NULL) ? file->path : "(null)");
+                        file->status = EXIT_FAILURE;
+                }
+                else
+                {
+                        if (buffer != NULL)
+                        {
+                                setvbuf (fp.fp, buffer, _IOFBF, DXF_BATCH_BUFFER_SIZE);
+                        }
+                        file->status = dxf_file_read_stream (&fp, drawing);
+                        fclose (fp.fp);
+                }
+                if ((worker->callback != NULL)
+                  && (worker->callback (file->path, drawing, file->status, worker->user_data) != EXIT_SUCCESS))
+                {
+                        file->status = EXIT_FAILURE;
+                }
+                dxf_drawing_clear (drawing);
+        }
+        free (buffer);
+        dxf_drawing_free (drawing);
+        return (NULL);
+}
+
+
+/*!
+ * \brief Take the next file for a worker.
+ *
+ * The worker takes the largest file left in its own queue, when its own
+ * queue is empty it steals the smallest file left in the queue of
+ * another worker.\n
+ * Files are never added to a queue, so when all queues are empty the
+ * batch is done.
+ *
+ * \return The index of the file in the sorted file array, or -1 when no
+ * files are left.
+ */
+static int
+dxf_batch_next
+(
+        DxfBatchWorker *worker
+                /*!< a pointer to the worker. */
+)
+{
+        DxfBatchQueue *queue = NULL;
+        int index = -1;
+        int i;
+
+        queue = &worker->queues[worker->number];
+        pthread_mutex_lock (&queue->mutex);
+        if (queue->head < queue->tail)
+        {
+                index = queue->files[queue->head++];
+        }
+        pthread_mutex_unlock (&queue->mutex);
+        for (i = 1; (index < 0) && (i < worker->number_of_workers); i++)
+        {
+                queue = &worker->queues[(worker->number + i) % worker->number_of_workers];
+                pthread_mutex_lock (&queue->mutex);
+                if (queue->head < queue->tail)
+                {
+                        index = queue->files[--queue->tail];
+                }
+                pthread_mutex_unlock (&queue->mutex);
+        }
+        return (index);
+}
+
+
+/*!
+ * \brief Compare two files for qsort (), largest file first and in the
+ * order of the caller for files of equal size.
+ */
+static int
+dxf_batch_compare
+(
+        const void *a,
+                /*!< pointer to the first file. */
+        const void *b
+                /*!< pointer to the second file. */
+)
+{
+        const DxfBatchFile *file_a = (const DxfBatchFile *) a;
+        const DxfBatchFile *file_b = (const DxfBatchFile *) b;
+
+        if (file_a->size != file_b->size)
+        {
+                return ((file_a->size > file_b->size) ? -1 : 1);
+        }
+        return (file_a->index - file_b->index);
+}
+
+
+/* EOF */
@@ -0,0 +1,89 @@
+/*!
+ * \file batch.h
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Header file for parallel batch reading of DXF files.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#ifndef LIBDXF_SRC_BATCH_H
+#define LIBDXF_SRC_BATCH_H
+
+
+#include "global.h"
+#include "drawing.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define DXF_BATCH_BUFFER_SIZE 262144
+        /*!< \brief Size of the stdio read buffer of every worker
+         * thread. */
+
+
+/*!
+ * \brief Callback invoked for every file of a batch.
+ *
+ * The callback is invoked from the worker threads, possibly for several
+ * files at the same time, and must be reentrant.\n
+ * The \c drawing is owned by the worker and is cleared after the
+ * callback returns, the callback has to copy what it wants to keep.
+ *
+ * \return \c EXIT_SUCCESS when the file was processed, or
+ * \c EXIT_FAILURE when an error occurred.
+ */
+typedef int (*DxfBatchCallback)
+(
+        const char *path,
+                /*!< name of the file. */
+        DxfDrawing *drawing,
+                /*!< drawing holding the contents of the file. */
+        int status,
+                /*!< \c EXIT_SUCCESS when the file was read,
+                 * \c EXIT_FAILURE when reading failed. */
+        void *user_data
+                /*!< user data passed to dxf_batch_process (). */
+);
+
+
+int dxf_batch_process (char **paths, int number_of_paths, int number_of_threads, DxfBatchCallback callback, void *user_data);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* LIBDXF_SRC_BATCH_H */
+
+
+/* EOF */
@@ -34,6 +34,7 @@
 
 
 #include "binary_graphics_data.h"
+#include "util.h"
 
 
 /*!
@@ -113,6 +114,79 @@ dxf_binary_graphics_data_init
 }
 
 
+/*!
+ * \brief Read a line of binary graphics data from a DXF file and append
+ * it to a single linked list of binary graphics data objects.
+ *
+ * The list is allocated when the first line is appended, an entity
+ * without binary graphics data keeps a \c NULL pointer.
+ *
+ * \return a pointer to the appended binary graphics data object, or
+ * \c NULL when an error occurred.
+ */
+DxfBinaryGraphicsData *
+dxf_binary_graphics_data_read
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an input file (or device). */
+        DxfBinaryGraphicsData **data,
+                /*!< a pointer to the pointer to the first binary
+                 * graphics data object of the list, the pointer may be
+                 * \c NULL. */
+        DxfBinaryGraphicsData *last
+                /*!< a pointer to the last binary graphics data object
+                 * appended to the list, or \c NULL when unknown. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        char line[DXF_MAX_STRING_LENGTH];
+        DxfBinaryGraphicsData *new_data = NULL;
+
+        /* Do some basic checks. */
+        if ((fp == NULL) || (data == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        if (dxf_read_text_line (fp, line, DXF_MAX_STRING_LENGTH) != EXIT_SUCCESS)
+        {
+                return (NULL);
+        }
+        new_data = dxf_binary_graphics_data_new ();
+        if (new_data == NULL)
+        {
+                return (NULL);
+        }
+        new_data->data_line = strdup (line);
+        new_data->length = strlen (line);
+        new_data->next = NULL;
+        if (last == NULL)
+        {
+                last = *data;
+        }
+        if (last == NULL)
+        {
+                *data = new_data;
+        }
+        else
+        {
+                while (last->next != NULL)
+                {
+                        last = (DxfBinaryGraphicsData *) last->next;
+                }
+                last->next = (struct DxfBinaryGraphicsData *) new_data;
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (new_data);
+}
+
+
 /*!
  * \brief Write DXF output to fp for a binary graphics data object.
  *
@@ -216,6 +290,7 @@ dxf_binary_graphics_data_free_list
         while (data != NULL)
         {
                 DxfBinaryGraphicsData *iter = (DxfBinaryGraphicsData *) data->next;
+                data->next = NULL;
                 dxf_binary_graphics_data_free (data);
                 data = (DxfBinaryGraphicsData *) iter;
         }
@@ -70,6 +70,13 @@ dxf_binary_graphics_data_init
 (
         DxfBinaryGraphicsData *data
 );
+DxfBinaryGraphicsData *
+dxf_binary_graphics_data_read
+(
+        DxfFile *fp,
+        DxfBinaryGraphicsData **data,
+        DxfBinaryGraphicsData *last
+);
 int
 dxf_binary_graphics_data_write
 (
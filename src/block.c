@@ -42,6 +42,7 @@
 
 
 #include "block.h"
+#include "util.h"
 
 
 /*!
@@ -112,14 +113,13 @@ dxf_block_init
                   __FUNCTION__);
                 return (NULL);
         }
-        block->xref_name = strdup ("");
+        block->xref_name = dxf_string_share ("");
         block->block_name = strdup ("");
-        block->block_name_additional = strdup ("");
-        block->description = strdup ("");
+        block->block_name_additional = dxf_string_share ("");
+        block->description = dxf_string_share ("");
         block->id_code = 0;
-        block->layer = strdup (DXF_DEFAULT_LAYER);
+        block->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         block->p0 = dxf_point_new ();
-        block->p0 = dxf_point_init (block->p0);
         block->p0->x0 = 0.0;
         block->p0->y0 = 0.0;
         block->p0->z0 = 0.0;
@@ -127,7 +127,7 @@ dxf_block_init
         block->extr_x0 = 0.0;
         block->extr_y0 = 0.0;
         block->extr_z0 = 0.0;
-        block->object_owner_soft = strdup ("");
+        block->object_owner_soft = dxf_string_share ("");
         block->endblk = (struct DxfEndblk *) dxf_endblk_new ();
         block->next = NULL;
 #if DEBUG
@@ -203,7 +203,7 @@ dxf_block_read
                 {
                         /* Now follows a string containing a external
                          * reference name. */
-                        fscanf (fp->fp, "%s\n", block->xref_name);
+                        dxf_read_string (fp, &block->xref_name);
                 }
                 else if (strcmp (temp_string, "2") == 0)
                 {
@@ -213,12 +213,12 @@ dxf_block_read
                 else if (strcmp (temp_string, "3") == 0)
                 {
                         /* Now follows a string containing a block name. */
-                        fscanf (fp->fp, "%s\n", block->block_name_additional);
+                        dxf_read_string (fp, &block->block_name_additional);
                 }
                 else if (strcmp (temp_string, "4") == 0)
                 {
                         /* Now follows a string containing a description. */
-                        fscanf (fp->fp, "%s\n", block->description);
+                        dxf_read_string (fp, &block->description);
                 }
                 else if (strcmp (temp_string, "5") == 0)
                 {
@@ -229,7 +229,7 @@ dxf_block_read
                 else if (strcmp (temp_string, "8") == 0)
                 {
                         /* Now follows a string containing a layer name. */
-                        fscanf (fp->fp, "%s\n", block->layer);
+                        dxf_read_string (fp, &block->layer);
                 }
                 else if (strcmp (temp_string, "10") == 0)
                 {
@@ -302,7 +302,7 @@ dxf_block_read
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to owner object. */
-                        fscanf (fp->fp, "%s\n", block->object_owner_soft);
+                        dxf_read_string (fp, &block->object_owner_soft);
                 }
                 else if (strcmp (temp_string, "999") == 0)
                 {
@@ -328,7 +328,8 @@ dxf_block_read
         }
         if (strcmp (block->layer, "") == 0)
         {
-                block->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (block->layer);
+                block->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         if (block->block_type == 0)
         {
@@ -432,7 +433,8 @@ dxf_block_write
                 fprintf (stderr,
                   (_("Warning in %s () NULL pointer to description string for the %s entity with id-code: %x\n")),
                   __FUNCTION__, dxf_entity_name, block->id_code);
-                block->description = strdup ("");
+                dxf_string_free (block->description);
+                block->description = dxf_string_share ("");
         }
         if (strcmp (block->layer, "") == 0)
         {
@@ -442,14 +444,16 @@ dxf_block_write
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0.\n")),
                   dxf_entity_name);
-                block->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (block->layer);
+                block->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         if (block->object_owner_soft == NULL)
         {
                 fprintf (stderr,
                   (_("Warning in %s () NULL pointer to soft owner object string for the %s entity with id-code: %x\n")),
                   __FUNCTION__, dxf_entity_name, block->id_code);
-                block->object_owner_soft = strdup ("");
+                dxf_string_free (block->object_owner_soft);
+                block->object_owner_soft = dxf_string_share ("");
         }
         /* Start writing output. */
         fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
@@ -579,12 +583,16 @@ dxf_block_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (block->xref_name);
+        dxf_string_free (block->xref_name);
         free (block->block_name);
-        free (block->block_name_additional);
-        free (block->description);
-        free (block->layer);
-        free (block->object_owner_soft);
+        dxf_string_free (block->block_name_additional);
+        dxf_string_free (block->description);
+        dxf_string_free (block->layer);
+        dxf_string_free (block->object_owner_soft);
+        if (block->p0 != NULL)
+        {
+                dxf_point_free (block->p0);
+        }
         free (block);
         block = NULL;
 #if DEBUG
@@ -682,6 +690,8 @@ dxf_block_set_xref_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (block == NULL)
         {
@@ -697,7 +707,13 @@ dxf_block_set_xref_name
                   __FUNCTION__);
                 return (NULL);
         }
-        block->xref_name = strdup (xref_name);
+        copy = dxf_string_share (xref_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (block->xref_name);
+        block->xref_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -838,6 +854,8 @@ dxf_block_set_block_name_additional
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (block == NULL)
         {
@@ -853,7 +871,13 @@ dxf_block_set_block_name_additional
                   __FUNCTION__);
                 return (NULL);
         }
-        block->block_name_additional = strdup (block_name_additional);
+        copy = dxf_string_share (block_name_additional);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (block->block_name_additional);
+        block->block_name_additional = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -916,6 +940,8 @@ dxf_block_set_description
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (block == NULL)
         {
@@ -931,7 +957,13 @@ dxf_block_set_description
                   __FUNCTION__);
                 return (NULL);
         }
-        block->description = strdup (description);
+        copy = dxf_string_share (description);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (block->description);
+        block->description = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1066,6 +1098,8 @@ dxf_block_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (block == NULL)
         {
@@ -1081,7 +1115,13 @@ dxf_block_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        block->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (block->layer);
+        block->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2016,6 +2056,8 @@ dxf_block_set_object_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (block == NULL)
         {
@@ -2031,7 +2073,13 @@ dxf_block_set_object_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        block->object_owner_soft = strdup (object_owner_soft);
+        copy = dxf_string_share (object_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (block->object_owner_soft);
+        block->object_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -43,6 +43,7 @@
 
 
 #include "block_record.h"
+#include "util.h"
 
 
 /*!
@@ -113,18 +114,17 @@ dxf_block_record_init
                 return (NULL);
         }
         block_record->id_code = 0;
-        block_record->block_name = strdup ("");
+        block_record->block_name = dxf_string_share ("");
         block_record->flag = 0;
         block_record->insert_units = 0;
         block_record->explodability = 0;
         block_record->scalability = 0;
-        block_record->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_new ();
-        block_record->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_init (block_record->binary_graphics_data);
-        block_record->dictionary_owner_soft = strdup ("");
-        block_record->object_owner_soft = strdup ("");
-        block_record->dictionary_owner_hard = strdup ("");
-        block_record->xdata_string_data = strdup ("DesignCenter Data");
-        block_record->xdata_application_name = strdup ("ACAD");
+        block_record->binary_graphics_data = NULL;
+        block_record->dictionary_owner_soft = dxf_string_share ("");
+        block_record->object_owner_soft = dxf_string_share ("");
+        block_record->dictionary_owner_hard = dxf_string_share ("");
+        block_record->xdata_string_data = dxf_string_share ("DesignCenter Data");
+        block_record->xdata_application_name = dxf_string_share ("ACAD");
         block_record->design_center_version_number = 0;
         block_record->insert_units = 0;
         block_record->next = NULL;
@@ -208,8 +208,7 @@ dxf_block_record_read
                 {
                         /* Now follows a string containing an application
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", block_record->block_name);
+                        dxf_read_string (fp, &block_record->block_name);
                 }
                 else if (strcmp (temp_string, "70") == 0)
                 {
@@ -236,10 +235,7 @@ dxf_block_record_read
                 {
                         /* Now follows a string containing binary
                          * graphics data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", iter310->data_line);
-                        dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) iter310->next);
-                        iter310 = (DxfBinaryGraphicsData *) iter310->next;
+                        iter310 = dxf_binary_graphics_data_read (fp, &block_record->binary_graphics_data, iter310);
                 }
                 else if (strcmp (temp_string, "330") == 0)
                 {
@@ -247,15 +243,13 @@ dxf_block_record_read
                         {
                                 /* Now follows a string containing a soft-pointer
                                  * ID/handle to owner dictionary. */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%s\n", block_record->dictionary_owner_soft);
+                                dxf_read_string (fp, &block_record->dictionary_owner_soft);
                         }
                         if (iter330 == 1)
                         {
                                 /* Now follows a string containing a soft-pointer
                                  * ID/handle to owner object. */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%s\n", block_record->object_owner_soft);
+                                dxf_read_string (fp, &block_record->object_owner_soft);
                         }
                         iter330++;
                 }
@@ -270,8 +264,7 @@ dxf_block_record_read
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", block_record->dictionary_owner_hard);
+                        dxf_read_string (fp, &block_record->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "999") == 0)
                 {
@@ -284,8 +277,7 @@ dxf_block_record_read
                 {
                         /* Now follows a string containing the Xdata
                          * string data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", block_record->xdata_string_data);
+                        dxf_read_string (fp, &block_record->xdata_string_data);
                         if (strcmp (block_record->xdata_string_data, "DesignCenter Data") != 0)
                         {
                                 fprintf (stderr,
@@ -297,8 +289,7 @@ dxf_block_record_read
                 {
                         /* Now follows a string containing the Xdata
                          * application name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", block_record->xdata_application_name);
+                        dxf_read_string (fp, &block_record->xdata_application_name);
                         if (strcmp (block_record->xdata_application_name, "ACAD") != 0)
                         {
                                 fprintf (stderr,
@@ -497,9 +488,13 @@ dxf_block_record_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (block_record->block_name);
-        free (block_record->dictionary_owner_soft);
-        free (block_record->dictionary_owner_hard);
+        dxf_string_free (block_record->block_name);
+        dxf_string_free (block_record->dictionary_owner_soft);
+        dxf_string_free (block_record->dictionary_owner_hard);
+        if (block_record->binary_graphics_data != NULL)
+        {
+                dxf_binary_graphics_data_free_list (block_record->binary_graphics_data);
+        }
         free (block_record);
         block_record = NULL;
 #if DEBUG
@@ -676,6 +671,8 @@ dxf_block_record_set_block_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (block_record == NULL)
         {
@@ -691,7 +688,13 @@ dxf_block_record_set_block_name
                   __FUNCTION__);
                 return (NULL);
         }
-        block_record->block_name= strdup (block_name);
+        copy = dxf_string_share (block_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (block_record->block_name);
+        block_record->block_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1303,6 +1306,8 @@ dxf_block_record_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (block_record == NULL)
         {
@@ -1318,7 +1323,13 @@ dxf_block_record_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        block_record->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (block_record->dictionary_owner_soft);
+        block_record->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1385,6 +1396,8 @@ dxf_block_record_set_object_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (block_record == NULL)
         {
@@ -1400,7 +1413,13 @@ dxf_block_record_set_object_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        block_record->object_owner_soft = strdup (object_owner_soft);
+        copy = dxf_string_share (object_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (block_record->object_owner_soft);
+        block_record->object_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1508,6 +1527,8 @@ dxf_block_record_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (block_record == NULL)
         {
@@ -1523,7 +1544,13 @@ dxf_block_record_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        block_record->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (block_record->dictionary_owner_hard);
+        block_record->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1590,6 +1617,8 @@ dxf_block_record_set_xdata_string_data
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (block_record == NULL)
         {
@@ -1605,7 +1634,13 @@ dxf_block_record_set_xdata_string_data
                   __FUNCTION__);
                 return (NULL);
         }
-        block_record->xdata_string_data = strdup (xdata_string_data);
+        copy = dxf_string_share (xdata_string_data);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (block_record->xdata_string_data);
+        block_record->xdata_string_data = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1672,6 +1707,8 @@ dxf_block_record_set_xdata_application_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (block_record == NULL)
         {
@@ -1687,7 +1724,13 @@ dxf_block_record_set_xdata_application_name
                   __FUNCTION__);
                 return (NULL);
         }
-        block_record->xdata_application_name = strdup (xdata_application_name);
+        copy = dxf_string_share (xdata_application_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (block_record->xdata_application_name);
+        block_record->xdata_application_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -42,6 +42,8 @@
 
 
 #include "body.h"
+#include "stats.h"
+#include "util.h"
 
 
 /*!
@@ -71,6 +73,7 @@ dxf_body_new ()
         else
         {
                 memset (body, 0, size);
+                dxf_stats_count_allocation (BODY, size);
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -112,8 +115,8 @@ dxf_body_init
                 return (NULL);
         }
         body->id_code = 0;
-        body->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        body->layer = strdup (DXF_DEFAULT_LAYER);
+        body->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        body->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         body->elevation = 0.0;
         body->thickness = 0.0;
         body->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
@@ -122,15 +125,14 @@ dxf_body_init
         body->paperspace = DXF_MODELSPACE;
         body->graphics_data_size = 0;
         body->shadow_mode = 0;
-        body->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_new ();
-        body->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_init (body->binary_graphics_data);
-        body->dictionary_owner_soft = strdup ("");
-        body->object_owner_soft = strdup ("");
-        body->material = strdup ("");
-        body->dictionary_owner_hard = strdup ("");
-        body->plot_style_name = strdup ("");
+        body->binary_graphics_data = NULL;
+        body->dictionary_owner_soft = dxf_string_share ("");
+        body->object_owner_soft = dxf_string_share ("");
+        body->material = dxf_string_share ("");
+        body->dictionary_owner_hard = dxf_string_share ("");
+        body->plot_style_name = dxf_string_share ("");
         body->color_value = 0;
-        body->color_name = strdup ("");
+        body->color_name = dxf_string_share ("");
         body->transparency = 0;
         body->proprietary_data = (DxfProprietaryData *) dxf_proprietary_data_new ();
         body->proprietary_data = (DxfProprietaryData *) dxf_proprietary_data_init (body->proprietary_data);
@@ -245,14 +247,12 @@ dxf_body_read
                 {
                         /* Now follows a string containing a linetype
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", body->linetype);
+                        dxf_read_string (fp, &body->linetype);
                 }
                 else if (strcmp (temp_string, "8") == 0)
                 {
                         /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", body->layer);
+                        dxf_read_string (fp, &body->layer);
                 }
                 else if ((fp->acad_version_number <= AutoCAD_11)
                   && DXF_FLATLAND
@@ -311,15 +311,13 @@ dxf_body_read
                         {
                                 /* Now follows a string containing a soft-pointer
                                  * ID/handle to owner dictionary. */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%s\n", body->dictionary_owner_soft);
+                                dxf_read_string (fp, &body->dictionary_owner_soft);
                         }
                         if (iter330 == 1)
                         {
                                 /* Now follows a string containing a soft-pointer
                                  * ID/handle to owner object. */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%s\n", body->object_owner_soft);
+                                dxf_read_string (fp, &body->object_owner_soft);
                         }
                         iter330++;
                 }
@@ -327,8 +325,7 @@ dxf_body_read
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", body->dictionary_owner_hard);
+                        dxf_read_string (fp, &body->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "999") == 0)
                 {
@@ -347,11 +344,13 @@ dxf_body_read
         /* Handle omitted members and/or illegal values. */
         if (strcmp (body->linetype, "") == 0)
         {
-                body->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (body->linetype);
+                body->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (body->layer, "") == 0)
         {
-                body->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (body->layer);
+                body->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         if (body->modeler_format_version_number == 0)
         {
@@ -427,7 +426,8 @@ dxf_body_write
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                body->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (body->linetype);
+                body->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (body->layer, "") == 0)
         {
@@ -437,7 +437,8 @@ dxf_body_write
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0")),
                   dxf_entity_name);
-                body->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (body->layer);
+                body->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Start writing output. */
         i = 1;
@@ -577,15 +578,18 @@ dxf_body_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (body->linetype);
-        free (body->layer);
-        dxf_binary_graphics_data_free_list (body->binary_graphics_data);
-        free (body->dictionary_owner_soft);
-        free (body->object_owner_soft);
-        free (body->material);
-        free (body->dictionary_owner_hard);
-        free (body->plot_style_name);
-        free (body->color_name);
+        dxf_string_free (body->linetype);
+        dxf_string_free (body->layer);
+        if (body->binary_graphics_data != NULL)
+        {
+                dxf_binary_graphics_data_free_list (body->binary_graphics_data);
+        }
+        dxf_string_free (body->dictionary_owner_soft);
+        dxf_string_free (body->object_owner_soft);
+        dxf_string_free (body->material);
+        dxf_string_free (body->dictionary_owner_hard);
+        dxf_string_free (body->plot_style_name);
+        dxf_string_free (body->color_name);
         dxf_proprietary_data_free_list (body->proprietary_data);
         dxf_proprietary_data_free_list (body->additional_proprietary_data);
         free (body);
@@ -759,6 +763,8 @@ dxf_body_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (body == NULL)
         {
@@ -774,7 +780,13 @@ dxf_body_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        body->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (body->linetype);
+        body->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -834,6 +846,8 @@ dxf_body_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (body == NULL)
         {
@@ -849,7 +863,13 @@ dxf_body_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        body->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (body->layer);
+        body->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1644,6 +1664,8 @@ dxf_body_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (body == NULL)
         {
@@ -1659,7 +1681,13 @@ dxf_body_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        body->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (body->dictionary_owner_soft);
+        body->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1724,6 +1752,8 @@ dxf_body_set_object_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (body == NULL)
         {
@@ -1739,7 +1769,13 @@ dxf_body_set_object_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        body->object_owner_soft = strdup (object_owner_soft);
+        copy = dxf_string_share (object_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (body->object_owner_soft);
+        body->object_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1807,6 +1843,8 @@ dxf_body_set_material
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (body == NULL)
         {
@@ -1822,7 +1860,13 @@ dxf_body_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        body->material = strdup (material);
+        copy = dxf_string_share (material);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (body->material);
+        body->material = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1887,6 +1931,8 @@ dxf_body_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (body == NULL)
         {
@@ -1902,7 +1948,13 @@ dxf_body_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        body->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (body->dictionary_owner_hard);
+        body->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2032,6 +2084,8 @@ dxf_body_set_plot_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (body == NULL)
         {
@@ -2047,7 +2101,13 @@ dxf_body_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        body->plot_style_name = strdup (plot_style_name);
+        copy = dxf_string_share (plot_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (body->plot_style_name);
+        body->plot_style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2177,6 +2237,8 @@ dxf_body_set_color_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (body == NULL)
         {
@@ -2192,7 +2254,13 @@ dxf_body_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        body->color_name = strdup (color_name);
+        copy = dxf_string_share (color_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (body->color_name);
+        body->color_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
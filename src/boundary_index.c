@@ -0,0 +1,844 @@
+/*!
+ * \file boundary_index.c
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Functions for a point-in-polygon query index over flattened
+ * boundary loops (e.g. \c HATCH boundary paths).
+ *
+ * The boundary is flattened only once, the resulting edges are sorted
+ * into horizontal bands.\n
+ * A query for a point only visits the edges of the band containing the
+ * point, and counts the edges crossed by a horizontal ray to the right
+ * of the point (the crossing number).\n
+ * The inner loop over the edges of a band is branch free and operates
+ * on contiguous arrays, thus allowing the compiler to vectorize it.\n
+ * Batches of points can be distributed over a number of threads.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include <pthread.h>
+
+#include "boundary_index.h"
+
+
+/*!
+ * \brief Work item for a thread in a batch query.
+ */
+typedef struct
+dxf_boundary_index_job_struct
+{
+        DxfBoundaryIndex *index;
+                /*!< The index to query. */
+        const double *x;
+                /*!< X-coordinates of the points. */
+        const double *y;
+                /*!< Y-coordinates of the points. */
+        int *result;
+                /*!< Results of the points. */
+        int begin;
+                /*!< First point of this job. */
+        int end;
+                /*!< One past the last point of this job. */
+        int status;
+                /*!< \c EXIT_SUCCESS or \c EXIT_FAILURE. */
+} DxfBoundaryIndexJob;
+
+
+static int dxf_boundary_index_classify (DxfBoundaryIndex *index, double x, double y, unsigned char *parity, int *touched);
+static void *dxf_boundary_index_run_job (void *data);
+
+
+/*!
+ * \brief Allocate memory for a \c DxfBoundaryIndex.
+ *
+ * Fill the memory contents with zeros.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfBoundaryIndex *
+dxf_boundary_index_new ()
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfBoundaryIndex *index = NULL;
+        size_t size;
+
+        size = sizeof (DxfBoundaryIndex);
+        /* avoid malloc of 0 bytes */
+        if (size == 0) size = 1;
+        if ((index = malloc (size)) == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                index = NULL;
+        }
+        else
+        {
+                memset (index, 0, size);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (index);
+}
+
+
+/*!
+ * \brief Allocate memory and initialize data fields in a
+ * \c DxfBoundaryIndex.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfBoundaryIndex *
+dxf_boundary_index_init
+(
+        DxfBoundaryIndex *index
+                /*!< a pointer to the index. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (index == NULL)
+        {
+                fprintf (stderr,
+                  (_("Warning in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                index = dxf_boundary_index_new ();
+        }
+        if (index == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        index->number_of_loops = 0;
+        index->number_of_edges = 0;
+        index->min_x = 0.0;
+        index->min_y = 0.0;
+        index->max_x = 0.0;
+        index->max_y = 0.0;
+        index->style = DXF_BOUNDARY_INDEX_STYLE_NORMAL;
+        index->number_of_bands = 0;
+        index->band_height = 0.0;
+        index->band_start = NULL;
+        index->number_of_band_edges = 0;
+        index->edge_x = NULL;
+        index->edge_y_low = NULL;
+        index->edge_y_high = NULL;
+        index->edge_dxdy = NULL;
+        index->edge_loop = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (index);
+}
+
+
+/*!
+ * \brief Build a \c DxfBoundaryIndex from flattened boundary loops.
+ *
+ * Every path in the \c buffer is taken as a closed loop, a closing edge
+ * is added when the last vertex differs from the first vertex.\n
+ * When the buffer has no path administration all vertices are taken as
+ * a single loop.\n
+ * Horizontal edges never cross a horizontal ray and are left out.\n
+ * Any previous contents of the index are released.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_boundary_index_build
+(
+        DxfBoundaryIndex *index,
+                /*!< a pointer to the index. */
+        DxfFlattenBuffer *buffer,
+                /*!< a pointer to a buffer with flattened loops. */
+        int style
+                /*!< island detection style. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        int *fill = NULL;
+        int number_of_paths;
+        int path;
+        int first;
+        int last;
+        int pass;
+        int i;
+        int b;
+        int b0;
+        int b1;
+        int k;
+        double xa;
+        double ya;
+        double xb;
+        double yb;
+
+        /* Do some basic checks. */
+        if ((index == NULL) || (buffer == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (dxf_flatten_buffer_is_overflowed (buffer))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () an incomplete (overflowed) buffer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if ((style < DXF_BOUNDARY_INDEX_STYLE_NORMAL)
+          || (style > DXF_BOUNDARY_INDEX_STYLE_IGNORE))
+        {
+                fprintf (stderr,
+                  (_("Warning in %s () an unknown style was passed, using the normal style.\n")),
+                  __FUNCTION__);
+                style = DXF_BOUNDARY_INDEX_STYLE_NORMAL;
+        }
+        dxf_boundary_index_clear (index);
+        index->style = style;
+        number_of_paths = (buffer->path_start != NULL) ? buffer->number_of_paths : 1;
+        if (buffer->number_of_vertices == 0)
+        {
+                number_of_paths = 0;
+        }
+        index->number_of_loops = number_of_paths;
+        /* First pass: edge count and bounding box. */
+        for (i = 0; i < buffer->number_of_vertices; i++)
+        {
+                if ((i == 0) || (buffer->x[i] < index->min_x)) index->min_x = buffer->x[i];
+                if ((i == 0) || (buffer->x[i] > index->max_x)) index->max_x = buffer->x[i];
+                if ((i == 0) || (buffer->y[i] < index->min_y)) index->min_y = buffer->y[i];
+                if ((i == 0) || (buffer->y[i] > index->max_y)) index->max_y = buffer->y[i];
+        }
+        for (path = 0; path < number_of_paths; path++)
+        {
+                first = (buffer->path_start != NULL) ? buffer->path_start[path] : 0;
+                last = ((buffer->path_start != NULL) && (path + 1 < number_of_paths))
+                  ? buffer->path_start[path + 1] - 1 : buffer->number_of_vertices - 1;
+                for (i = first; i <= last; i++)
+                {
+                        k = (i == last) ? first : i + 1;
+                        if (buffer->y[i] != buffer->y[k])
+                        {
+                                index->number_of_edges++;
+                        }
+                }
+        }
+        index->number_of_bands = index->number_of_edges / DXF_BOUNDARY_INDEX_EDGES_PER_BAND;
+        if (index->number_of_bands < 1)
+        {
+                index->number_of_bands = 1;
+        }
+        if (index->number_of_bands > DXF_BOUNDARY_INDEX_MAX_BANDS)
+        {
+                index->number_of_bands = DXF_BOUNDARY_INDEX_MAX_BANDS;
+        }
+        index->band_height = (index->max_y - index->min_y) / index->number_of_bands;
+        if (index->band_height <= 0.0)
+        {
+                index->band_height = 1.0;
+        }
+        index->band_start = calloc (index->number_of_bands + 1, sizeof (int));
+        fill = calloc (index->number_of_bands, sizeof (int));
+        if ((index->band_start == NULL) || (fill == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                free (fill);
+                dxf_boundary_index_clear (index);
+                return (EXIT_FAILURE);
+        }
+        /* Second pass counts the edges per band, third pass copies the
+         * edges into their bands. */
+        for (pass = 0; pass < 2; pass++)
+        {
+                for (path = 0; path < number_of_paths; path++)
+                {
+                        first = (buffer->path_start != NULL) ? buffer->path_start[path] : 0;
+                        last = ((buffer->path_start != NULL) && (path + 1 < number_of_paths))
+                          ? buffer->path_start[path + 1] - 1 : buffer->number_of_vertices - 1;
+                        for (i = first; i <= last; i++)
+                        {
+                                k = (i == last) ? first : i + 1;
+                                if (buffer->y[i] == buffer->y[k])
+                                {
+                                        continue;
+                                }
+                                if (buffer->y[i] < buffer->y[k])
+                                {
+                                        xa = buffer->x[i];
+                                        ya = buffer->y[i];
+                                        xb = buffer->x[k];
+                                        yb = buffer->y[k];
+                                }
+                                else
+                                {
+                                        xa = buffer->x[k];
+                                        ya = buffer->y[k];
+                                        xb = buffer->x[i];
+                                        yb = buffer->y[i];
+                                }
+                                b0 = (int) ((ya - index->min_y) / index->band_height);
+                                b1 = (int) ((yb - index->min_y) / index->band_height);
+                                if (b0 >= index->number_of_bands) b0 = index->number_of_bands - 1;
+                                if (b1 >= index->number_of_bands) b1 = index->number_of_bands - 1;
+                                for (b = b0; b <= b1; b++)
+                                {
+                                        if (pass == 0)
+                                        {
+                                                index->band_start[b + 1]++;
+                                                continue;
+                                        }
+                                        k = index->band_start[b] + fill[b];
+                                        fill[b]++;
+                                        index->edge_x[k] = xa;
+                                        index->edge_y_low[k] = ya;
+                                        index->edge_y_high[k] = yb;
+                                        index->edge_dxdy[k] = (xb - xa) / (yb - ya);
+                                        index->edge_loop[k] = path;
+                                }
+                        }
+                }
+                if (pass == 0)
+                {
+                        for (b = 0; b < index->number_of_bands; b++)
+                        {
+                                index->band_start[b + 1] += index->band_start[b];
+                        }
+                        index->number_of_band_edges = index->band_start[index->number_of_bands];
+                        k = (index->number_of_band_edges > 0) ? index->number_of_band_edges : 1;
+                        index->edge_x = malloc (k * sizeof (double));
+                        index->edge_y_low = malloc (k * sizeof (double));
+                        index->edge_y_high = malloc (k * sizeof (double));
+                        index->edge_dxdy = malloc (k * sizeof (double));
+                        index->edge_loop = malloc (k * sizeof (int));
+                        if ((index->edge_x == NULL)
+                          || (index->edge_y_low == NULL)
+                          || (index->edge_y_high == NULL)
+                          || (index->edge_dxdy == NULL)
+                          || (index->edge_loop == NULL))
+                        {
+                                fprintf (stderr,
+                                  (_("Error in %s () could not allocate memory.\n")),
+                                  __FUNCTION__);
+                                free (fill);
+                                dxf_boundary_index_clear (index);
+                                return (EXIT_FAILURE);
+                        }
+                }
+        }
+        free (fill);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Build a \c DxfBoundaryIndex from all boundary paths of a DXF
+ * \c HATCH entity.
+ *
+ * Polyline paths (including bulges) and edge defined paths are
+ * flattened once with the given tolerance, the hatch style of the
+ * \c HATCH entity determines the island detection style.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_boundary_index_build_from_hatch
+(
+        DxfBoundaryIndex *index,
+                /*!< a pointer to the index. */
+        DxfHatch *hatch,
+                /*!< a pointer to a DXF \c HATCH entity. */
+        double tolerance
+                /*!< maximum allowed deviation (sagitta) of flattened
+                 * curves. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfFlattenBuffer *buffer = NULL;
+        int result;
+
+        /* Do some basic checks. */
+        if ((index == NULL) || (hatch == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        buffer = dxf_flatten_buffer_init (dxf_flatten_buffer_new (), 256, 8);
+        if (buffer == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_flatten_hatch (hatch, tolerance, buffer);
+        if (dxf_flatten_buffer_is_overflowed (buffer))
+        {
+                /* Now that the required size is known, try again. */
+                if (dxf_flatten_buffer_reserve (buffer, buffer->number_of_vertices, buffer->number_of_paths) != EXIT_SUCCESS)
+                {
+                        dxf_flatten_buffer_free (buffer);
+                        return (EXIT_FAILURE);
+                }
+                dxf_flatten_buffer_reset (buffer);
+                dxf_flatten_hatch (hatch, tolerance, buffer);
+        }
+        result = dxf_boundary_index_build (index, buffer, hatch->hatch_style);
+        dxf_flatten_buffer_free (buffer);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (result);
+}
+
+
+/*!
+ * \brief Test if a point is inside the area described by a
+ * \c DxfBoundaryIndex.
+ *
+ * \return \c INSIDE if an interior point, \c OUTSIDE if an exterior
+ * point, or \c EXIT_FAILURE if an error occurred.
+ */
+int
+dxf_boundary_index_point_inside
+(
+        DxfBoundaryIndex *index,
+                /*!< a pointer to the index. */
+        double x,
+                /*!< X-coordinate of the point. */
+        double y
+                /*!< Y-coordinate of the point. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        unsigned char *parity = NULL;
+        int *touched = NULL;
+        int result;
+
+        /* Do some basic checks. */
+        if (index == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if ((index->style != DXF_BOUNDARY_INDEX_STYLE_NORMAL)
+          && (index->number_of_loops > 0))
+        {
+                parity = calloc (index->number_of_loops, sizeof (unsigned char));
+                touched = malloc (index->number_of_loops * sizeof (int));
+                if ((parity == NULL) || (touched == NULL))
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () could not allocate memory.\n")),
+                          __FUNCTION__);
+                        free (parity);
+                        free (touched);
+                        return (EXIT_FAILURE);
+                }
+        }
+        result = dxf_boundary_index_classify (index, x, y, parity, touched);
+        free (parity);
+        free (touched);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (result);
+}
+
+
+/*!
+ * \brief Test a batch of points against a \c DxfBoundaryIndex.
+ *
+ * The points are divided in equal chunks over \c number_of_threads
+ * threads, a value of 1 or less performs the queries in the calling
+ * thread.\n
+ * The index is only read, several batches may be run concurrently on
+ * the same index.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.\n
+ * For each point \c INSIDE or \c OUTSIDE is stored in \c result.
+ */
+int
+dxf_boundary_index_points_inside
+(
+        DxfBoundaryIndex *index,
+                /*!< a pointer to the index. */
+        const double *x,
+                /*!< array of X-coordinates of the points. */
+        const double *y,
+                /*!< array of Y-coordinates of the points. */
+        int number_of_points,
+                /*!< number of points. */
+        int *result,
+                /*!< array receiving the result for each point. */
+        int number_of_threads
+                /*!< number of threads to use. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfBoundaryIndexJob *jobs = NULL;
+        pthread_t *threads = NULL;
+        int *started = NULL;
+        int chunk;
+        int status;
+        int i;
+
+        /* Do some basic checks. */
+        if ((index == NULL) || (x == NULL) || (y == NULL) || (result == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (number_of_points <= 0)
+        {
+                return (EXIT_SUCCESS);
+        }
+        if (number_of_threads < 1)
+        {
+                number_of_threads = 1;
+        }
+        if (number_of_threads > number_of_points)
+        {
+                number_of_threads = number_of_points;
+        }
+        jobs = calloc (number_of_threads, sizeof (DxfBoundaryIndexJob));
+        threads = calloc (number_of_threads, sizeof (pthread_t));
+        started = calloc (number_of_threads, sizeof (int));
+        if ((jobs == NULL) || (threads == NULL) || (started == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                free (jobs);
+                free (threads);
+                free (started);
+                return (EXIT_FAILURE);
+        }
+        chunk = (number_of_points + number_of_threads - 1) / number_of_threads;
+        for (i = 0; i < number_of_threads; i++)
+        {
+                jobs[i].index = index;
+                jobs[i].x = x;
+                jobs[i].y = y;
+                jobs[i].result = result;
+                jobs[i].begin = i * chunk;
+                jobs[i].end = ((i + 1) * chunk < number_of_points) ? (i + 1) * chunk : number_of_points;
+                jobs[i].status = EXIT_SUCCESS;
+        }
+        /* The first chunk is done by the calling thread. */
+        for (i = 1; i < number_of_threads; i++)
+        {
+                if (pthread_create (&threads[i], NULL, dxf_boundary_index_run_job, &jobs[i]) == 0)
+                {
+                        started[i] = TRUE;
+                }
+        }
+        dxf_boundary_index_run_job (&jobs[0]);
+        status = jobs[0].status;
+        for (i = 1; i < number_of_threads; i++)
+        {
+                if (started[i])
+                {
+                        pthread_join (threads[i], NULL);
+                }
+                else
+                {
+                        /* The thread could not be started, do the work
+                         * here. */
+                        dxf_boundary_index_run_job (&jobs[i]);
+                }
+                if (jobs[i].status != EXIT_SUCCESS)
+                {
+                        status = EXIT_FAILURE;
+                }
+        }
+        free (jobs);
+        free (threads);
+        free (started);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (status);
+}
+
+
+/*!
+ * \brief Release the contents of a \c DxfBoundaryIndex, the index
+ * itself is kept for reuse.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_boundary_index_clear
+(
+        DxfBoundaryIndex *index
+                /*!< a pointer to the index. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        int style;
+
+        /* Do some basic checks. */
+        if (index == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        free (index->band_start);
+        free (index->edge_x);
+        free (index->edge_y_low);
+        free (index->edge_y_high);
+        free (index->edge_dxdy);
+        free (index->edge_loop);
+        style = index->style;
+        dxf_boundary_index_init (index);
+        index->style = style;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Free the allocated memory for a \c DxfBoundaryIndex and all
+ * its arrays.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_boundary_index_free
+(
+        DxfBoundaryIndex *index
+                /*!< a pointer to the index. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        if (index == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_boundary_index_clear (index);
+        free (index);
+        index = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Classify a single point.
+ *
+ * For the normal style only the parity of all crossings matters.\n
+ * For the outer and ignore styles the number of loops containing the
+ * point (the nesting depth) is determined with a parity per loop,
+ * \c parity must then point to a zeroed array with an entry per loop
+ * and \c touched to an array with room for an entry per loop, both are
+ * left in their initial state on return.
+ *
+ * \return \c INSIDE or \c OUTSIDE.
+ */
+static int
+dxf_boundary_index_classify
+(
+        DxfBoundaryIndex *index,
+                /*!< a pointer to the index. */
+        double x,
+                /*!< X-coordinate of the point. */
+        double y,
+                /*!< Y-coordinate of the point. */
+        unsigned char *parity,
+                /*!< scratch array with a parity per loop. */
+        int *touched
+                /*!< scratch array with the touched loops. */
+)
+{
+        const double *edge_x;
+        const double *edge_y_low;
+        const double *edge_y_high;
+        const double *edge_dxdy;
+        int crossings;
+        int number_of_touched;
+        int depth;
+        int band;
+        int begin;
+        int end;
+        int k;
+
+        if ((index->number_of_band_edges == 0)
+          || (x < index->min_x) || (x > index->max_x)
+          || (y < index->min_y) || (y >= index->max_y))
+        {
+                return (OUTSIDE);
+        }
+        band = (int) ((y - index->min_y) / index->band_height);
+        if (band >= index->number_of_bands)
+        {
+                band = index->number_of_bands - 1;
+        }
+        begin = index->band_start[band];
+        end = index->band_start[band + 1];
+        edge_x = index->edge_x;
+        edge_y_low = index->edge_y_low;
+        edge_y_high = index->edge_y_high;
+        edge_dxdy = index->edge_dxdy;
+        if ((index->style == DXF_BOUNDARY_INDEX_STYLE_NORMAL) || (parity == NULL))
+        {
+                crossings = 0;
+                for (k = begin; k < end; k++)
+                {
+                        /* Half open interval in Y, so that a ray through
+                         * a vertex is counted once. */
+                        crossings += (edge_y_low[k] <= y)
+                          & (y < edge_y_high[k])
+                          & (x < edge_x[k] + ((y - edge_y_low[k]) * edge_dxdy[k]));
+                }
+                return ((crossings & 1) ? INSIDE : OUTSIDE);
+        }
+        number_of_touched = 0;
+        for (k = begin; k < end; k++)
+        {
+                if ((edge_y_low[k] <= y)
+                  && (y < edge_y_high[k])
+                  && (x < edge_x[k] + ((y - edge_y_low[k]) * edge_dxdy[k])))
+                {
+                        if (parity[index->edge_loop[k]] == 0)
+                        {
+                                touched[number_of_touched] = index->edge_loop[k];
+                                number_of_touched++;
+                        }
+                        parity[index->edge_loop[k]] ^= 2;
+                        parity[index->edge_loop[k]] |= 1;
+                }
+        }
+        /* Bit 1 holds the parity, bit 0 marks the loop as touched. */
+        depth = 0;
+        for (k = 0; k < number_of_touched; k++)
+        {
+                if (parity[touched[k]] & 2)
+                {
+                        depth++;
+                }
+                parity[touched[k]] = 0;
+        }
+        if (index->style == DXF_BOUNDARY_INDEX_STYLE_OUTER)
+        {
+                return ((depth == 1) ? INSIDE : OUTSIDE);
+        }
+        return ((depth >= 1) ? INSIDE : OUTSIDE);
+}
+
+
+/*!
+ * \brief Run a batch query job, used as thread entry point.
+ */
+static void *
+dxf_boundary_index_run_job
+(
+        void *data
+                /*!< a pointer to a \c DxfBoundaryIndexJob. */
+)
+{
+        DxfBoundaryIndexJob *job = NULL;
+        unsigned char *parity = NULL;
+        int *touched = NULL;
+        int i;
+
+        job = (DxfBoundaryIndexJob *) data;
+        if ((job->index->style != DXF_BOUNDARY_INDEX_STYLE_NORMAL)
+          && (job->index->number_of_loops > 0))
+        {
+                parity = calloc (job->index->number_of_loops, sizeof (unsigned char));
+                touched = malloc (job->index->number_of_loops * sizeof (int));
+                if ((parity == NULL) || (touched == NULL))
+                {
+                        free (parity);
+                        free (touched);
+                        job->status = EXIT_FAILURE;
+                        return (NULL);
+                }
+        }
+        for (i = job->begin; i < job->end; i++)
+        {
+                job->result[i] = dxf_boundary_index_classify (job->index,
+                  job->x[i], job->y[i], parity, touched);
+        }
+        free (parity);
+        free (touched);
+        job->status = EXIT_SUCCESS;
+        return (NULL);
+}
+
+
+/* EOF */
@@ -0,0 +1,142 @@
+/*!
+ * \file boundary_index.h
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Header file for a point-in-polygon query index over flattened
+ * boundary loops (e.g. \c HATCH boundary paths).
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#ifndef LIBDXF_SRC_BOUNDARY_INDEX_H
+#define LIBDXF_SRC_BOUNDARY_INDEX_H
+
+
+#include "global.h"
+#include "flatten.h"
+#include "hatch.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define DXF_BOUNDARY_INDEX_STYLE_NORMAL 0
+        /*!< \brief Odd parity island detection, nested loops alternate
+         * between inside and outside (hatch style 0). */
+
+#define DXF_BOUNDARY_INDEX_STYLE_OUTER 1
+        /*!< \brief Only the area between the outermost loop and the
+         * first nested loop is inside (hatch style 1). */
+
+#define DXF_BOUNDARY_INDEX_STYLE_IGNORE 2
+        /*!< \brief Everything inside the outermost loop is inside,
+         * islands are ignored (hatch style 2). */
+
+#define DXF_BOUNDARY_INDEX_EDGES_PER_BAND 4
+        /*!< \brief The average number of edges aimed for in a single
+         * horizontal band of the index. */
+
+#define DXF_BOUNDARY_INDEX_MAX_BANDS 65536
+        /*!< \brief The maximum number of horizontal bands in the
+         * index. */
+
+
+/*!
+ * \brief Definition of a point-in-polygon query index over one or more
+ * closed boundary loops.
+ *
+ * The edges of all loops are stored in contiguous arrays.\n
+ * The bounding box is divided into horizontal bands of equal height,
+ * every band holds a copy of the edges that overlap it in its own
+ * contiguous range (structure of arrays), so that a query only scans
+ * the edges in the band of the query point without any indirection.\n
+ * Queries use the crossing number (even-odd) rule.
+ */
+typedef struct
+dxf_boundary_index_struct
+{
+        int number_of_loops;
+                /*!< Number of boundary loops. */
+        int number_of_edges;
+                /*!< Number of edges in all loops. */
+        double min_x;
+                /*!< Lower left X-coordinate of the bounding box. */
+        double min_y;
+                /*!< Lower left Y-coordinate of the bounding box. */
+        double max_x;
+                /*!< Upper right X-coordinate of the bounding box. */
+        double max_y;
+                /*!< Upper right Y-coordinate of the bounding box. */
+        int style;
+                /*!< Island detection style, one of
+                 * \c DXF_BOUNDARY_INDEX_STYLE_NORMAL,
+                 * \c DXF_BOUNDARY_INDEX_STYLE_OUTER or
+                 * \c DXF_BOUNDARY_INDEX_STYLE_IGNORE. */
+        int number_of_bands;
+                /*!< Number of horizontal bands. */
+        double band_height;
+                /*!< Height of a single band. */
+        int *band_start;
+                /*!< Index of the first band edge of each band, with an
+                 * extra entry for the end of the last band. */
+        int number_of_band_edges;
+                /*!< Number of edge copies in all bands. */
+        double *edge_x;
+                /*!< X-coordinate of the lower end of each band edge. */
+        double *edge_y_low;
+                /*!< Y-coordinate of the lower end of each band edge. */
+        double *edge_y_high;
+                /*!< Y-coordinate of the upper end of each band edge. */
+        double *edge_dxdy;
+                /*!< Inverse slope (dx / dy) of each band edge. */
+        int *edge_loop;
+                /*!< Loop number of each band edge. */
+} DxfBoundaryIndex;
+
+
+DxfBoundaryIndex *dxf_boundary_index_new ();
+DxfBoundaryIndex *dxf_boundary_index_init (DxfBoundaryIndex *index);
+int dxf_boundary_index_build (DxfBoundaryIndex *index, DxfFlattenBuffer *buffer, int style);
+int dxf_boundary_index_build_from_hatch (DxfBoundaryIndex *index, DxfHatch *hatch, double tolerance);
+int dxf_boundary_index_point_inside (DxfBoundaryIndex *index, double x, double y);
+int dxf_boundary_index_points_inside (DxfBoundaryIndex *index, const double *x, const double *y, int number_of_points, int *result, int number_of_threads);
+int dxf_boundary_index_clear (DxfBoundaryIndex *index);
+int dxf_boundary_index_free (DxfBoundaryIndex *index);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* LIBDXF_SRC_BOUNDARY_INDEX_H */
+
+
+/* EOF */
@@ -42,6 +42,8 @@
 
 
 #include "circle.h"
+#include "stats.h"
+#include "util.h"
 
 
 /*!
@@ -71,6 +73,7 @@ dxf_circle_new ()
         else
         {
                 memset (circle, 0, size);
+                dxf_stats_count_allocation (CIRCLE, size);
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -112,8 +115,8 @@ dxf_circle_init
               return (NULL);
         }
         circle->id_code = 0;
-        circle->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        circle->layer = strdup (DXF_DEFAULT_LAYER);
+        circle->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        circle->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         circle->elevation = 0.0;
         circle->thickness = 0.0;
         circle->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
@@ -122,19 +125,17 @@ dxf_circle_init
         circle->paperspace = DXF_MODELSPACE;
         circle->graphics_data_size = 0;
         circle->shadow_mode = 0;
-        circle->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_new ();
-        circle->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_init (circle->binary_graphics_data);
-        circle->dictionary_owner_soft = strdup ("");
-        circle->object_owner_soft = strdup ("");
-        circle->material = strdup ("");
-        circle->dictionary_owner_hard = strdup ("");
+        circle->binary_graphics_data = NULL;
+        circle->dictionary_owner_soft = dxf_string_share ("");
+        circle->object_owner_soft = dxf_string_share ("");
+        circle->material = dxf_string_share ("");
+        circle->dictionary_owner_hard = dxf_string_share ("");
         circle->lineweight = 0;
-        circle->plot_style_name = strdup ("");
+        circle->plot_style_name = dxf_string_share ("");
         circle->color_value = 0;
-        circle->color_name = strdup ("");
+        circle->color_name = dxf_string_share ("");
         circle->transparency = 0;
         circle->p0 = dxf_point_new ();
-        circle->p0 = dxf_point_init (circle->p0);
         circle->p0->x0 = 0.0;
         circle->p0->y0 = 0.0;
         circle->p0->z0 = 0.0;
@@ -222,14 +223,12 @@ dxf_circle_read
                 {
                         /* Now follows a string containing a linetype
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", circle->linetype);
+                        dxf_read_string (fp, &circle->linetype);
                 }
                 else if (strcmp (temp_string, "8") == 0)
                 {
                         /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", circle->layer);
+                        dxf_read_string (fp, &circle->layer);
                 }
                 else if (strcmp (temp_string, "10") == 0)
                 {
@@ -364,10 +363,7 @@ dxf_circle_read
                 {
                         /* Now follows a string containing binary
                          * graphics data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", iter310->data_line);
-                        dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) iter310->next);
-                        iter310 = (DxfBinaryGraphicsData *) iter310->next;
+                        iter310 = dxf_binary_graphics_data_read (fp, &circle->binary_graphics_data, iter310);
                 }
                 else if (strcmp (temp_string, "330") == 0)
                 {
@@ -375,15 +371,13 @@ dxf_circle_read
                         {
                                 /* Now follows a string containing a soft-pointer
                                  * ID/handle to owner dictionary. */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%s\n", circle->dictionary_owner_soft);
+                                dxf_read_string (fp, &circle->dictionary_owner_soft);
                         }
                         if (iter330 == 1)
                         {
                                 /* Now follows a string containing a soft-pointer
                                  * ID/handle to owner object. */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%s\n", circle->object_owner_soft);
+                                dxf_read_string (fp, &circle->object_owner_soft);
                         }
                         iter330++;
                 }
@@ -391,15 +385,13 @@ dxf_circle_read
                 {
                         /* Now follows a string containing a
                          * hard-pointer ID/handle to material object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", circle->material);
+                        dxf_read_string (fp, &circle->material);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", circle->dictionary_owner_hard);
+                        dxf_read_string (fp, &circle->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "370") == 0)
                 {
@@ -412,8 +404,7 @@ dxf_circle_read
                 {
                         /* Now follows a string containing a plot style
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", circle->plot_style_name);
+                        dxf_read_string (fp, &circle->plot_style_name);
                 }
                 else if (strcmp (temp_string, "420") == 0)
                 {
@@ -425,8 +416,7 @@ dxf_circle_read
                 {
                         /* Now follows a string containing a color
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", circle->color_name);
+                        dxf_read_string (fp, &circle->color_name);
                 }
                 else if (strcmp (temp_string, "440") == 0)
                 {
@@ -452,11 +442,13 @@ dxf_circle_read
         /* Handle omitted members and/or illegal values. */
         if (strcmp (circle->linetype, "") == 0)
         {
-                circle->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (circle->linetype);
+                circle->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (circle->layer, "") == 0)
         {
-                circle->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (circle->layer);
+                circle->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Clean up. */
         free (temp_string);
@@ -511,7 +503,8 @@ dxf_circle_write
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                circle->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (circle->linetype);
+                circle->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (circle->layer, "") == 0)
         {
@@ -521,7 +514,8 @@ dxf_circle_write
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0")),
                   dxf_entity_name );
-                circle->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (circle->layer);
+                circle->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         if (circle->radius == 0.0)
         {
@@ -695,10 +689,18 @@ dxf_circle_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (circle->linetype);
-        free (circle->layer);
-        free (circle->dictionary_owner_soft);
-        free (circle->dictionary_owner_hard);
+        dxf_string_free (circle->linetype);
+        dxf_string_free (circle->layer);
+        dxf_string_free (circle->dictionary_owner_soft);
+        dxf_string_free (circle->dictionary_owner_hard);
+        if (circle->binary_graphics_data != NULL)
+        {
+                dxf_binary_graphics_data_free_list (circle->binary_graphics_data);
+        }
+        if (circle->p0 != NULL)
+        {
+                dxf_point_free (circle->p0);
+        }
         free (circle);
         circle = NULL;
 #if DEBUG
@@ -868,6 +870,8 @@ dxf_circle_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (circle == NULL)
         {
@@ -883,7 +887,13 @@ dxf_circle_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        circle->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (circle->linetype);
+        circle->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -943,6 +953,8 @@ dxf_circle_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (circle == NULL)
         {
@@ -958,7 +970,13 @@ dxf_circle_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        circle->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (circle->layer);
+        circle->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1738,6 +1756,8 @@ dxf_circle_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (circle == NULL)
         {
@@ -1753,7 +1773,13 @@ dxf_circle_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        circle->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (circle->dictionary_owner_soft);
+        circle->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1818,6 +1844,8 @@ dxf_circle_set_object_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (circle == NULL)
         {
@@ -1833,7 +1861,13 @@ dxf_circle_set_object_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        circle->object_owner_soft = strdup (object_owner_soft);
+        copy = dxf_string_share (object_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (circle->object_owner_soft);
+        circle->object_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1901,6 +1935,8 @@ dxf_circle_set_material
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (circle == NULL)
         {
@@ -1916,7 +1952,13 @@ dxf_circle_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        circle->material = strdup (material);
+        copy = dxf_string_share (material);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (circle->material);
+        circle->material = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1981,6 +2023,8 @@ dxf_circle_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (circle == NULL)
         {
@@ -1996,7 +2040,13 @@ dxf_circle_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        circle->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (circle->dictionary_owner_hard);
+        circle->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2126,6 +2176,8 @@ dxf_circle_set_plot_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (circle == NULL)
         {
@@ -2141,7 +2193,13 @@ dxf_circle_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        circle->plot_style_name = strdup (plot_style_name);
+        copy = dxf_string_share (plot_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (circle->plot_style_name);
+        circle->plot_style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2271,6 +2329,8 @@ dxf_circle_set_color_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (circle == NULL)
         {
@@ -2286,7 +2346,13 @@ dxf_circle_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        circle->color_name = strdup (color_name);
+        copy = dxf_string_share (color_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (circle->color_name);
+        circle->color_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
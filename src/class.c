@@ -44,6 +44,7 @@
 
 
 #include "class.h"
+#include "util.h"
 
 
 /*!
@@ -113,10 +114,10 @@ dxf_class_init
                 __FUNCTION__);
               return (NULL);
         }
-        class->record_type = strdup ("");
-        class->record_name = strdup ("");
-        class->class_name = strdup ("");
-        class->app_name = strdup ("");
+        class->record_type = dxf_string_share ("");
+        class->record_name = dxf_string_share ("");
+        class->class_name = dxf_string_share ("");
+        class->app_name = dxf_string_share ("");
         class->proxy_cap_flag = 0;
         class->was_a_proxy_flag = 0;
         class->is_an_entity_flag = 0;
@@ -194,29 +195,25 @@ dxf_class_read
                          * and other \c class variables  will not be
                          * read. See the while condition above.
                          */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", class->record_type);
+                        dxf_read_string (fp, &class->record_type);
                 }
                 else if (strcmp (temp_string, "1") == 0)
                 {
                         /* Now follows a string containing a record
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", class->record_name);
+                        dxf_read_string (fp, &class->record_name);
                 }
                 else if (strcmp (temp_string, "2") == 0)
                 {
                         /* Now follows a string containing a class name.
                          */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", class->class_name);
+                        dxf_read_string (fp, &class->class_name);
                 }
                 else if (strcmp (temp_string, "3") == 0)
                 {
                         /* Now follows a string containing the
                          * application name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", class->app_name);
+                        dxf_read_string (fp, &class->app_name);
                 }
                 else if (strcmp (temp_string, "90") == 0)
                 {
@@ -352,7 +349,8 @@ dxf_class_write
                 fprintf (stderr,
                   (_("\trecord_name of %s entity is reset to \"\"")),
                   dxf_entity_name );
-                class->record_name = strdup ("");
+                dxf_string_free (class->record_name);
+                class->record_name = dxf_string_share ("");
         }
         if (!class->app_name)
         {
@@ -362,7 +360,8 @@ dxf_class_write
                 fprintf (stderr,
                   (_("\tapp_name of %s entity is reset to \"\"")),
                   dxf_entity_name );
-                class->app_name = strdup ("");
+                dxf_string_free (class->app_name);
+                class->app_name = dxf_string_share ("");
         }
         /* Start writing output. */
         fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
@@ -449,10 +448,10 @@ dxf_class_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (class->record_type);
-        free (class->record_name);
-        free (class->class_name);
-        free (class->app_name);
+        dxf_string_free (class->record_type);
+        dxf_string_free (class->record_name);
+        dxf_string_free (class->class_name);
+        dxf_string_free (class->app_name);
         free (class);
         class = NULL;
 #if DEBUG
@@ -550,6 +549,8 @@ dxf_class_set_record_type
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (class == NULL)
         {
@@ -565,7 +566,13 @@ dxf_class_set_record_type
                   __FUNCTION__);
                 return (NULL);
         }
-        class->record_type = strdup (record_type);
+        copy = dxf_string_share (record_type);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (class->record_type);
+        class->record_type = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -628,6 +635,8 @@ dxf_class_set_record_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (class == NULL)
         {
@@ -643,7 +652,13 @@ dxf_class_set_record_name
                   __FUNCTION__);
                 return (NULL);
         }
-        class->record_name = strdup (record_name);
+        copy = dxf_string_share (record_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (class->record_name);
+        class->record_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -706,6 +721,8 @@ dxf_class_set_class_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (class == NULL)
         {
@@ -721,7 +738,13 @@ dxf_class_set_class_name
                   __FUNCTION__);
                 return (NULL);
         }
-        class->class_name = strdup (class_name);
+        copy = dxf_string_share (class_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (class->class_name);
+        class->class_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -785,6 +808,8 @@ dxf_class_set_app_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (class == NULL)
         {
@@ -800,7 +825,13 @@ dxf_class_set_app_name
                   __FUNCTION__);
                 return (NULL);
         }
-        class->app_name = strdup (app_name);
+        copy = dxf_string_share (app_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (class->app_name);
+        class->app_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -38,9 +38,296 @@
  */
 
 
+#include <pthread.h>
+
 #include "color.h"
 
 
+/*!
+ * \brief The AutoCAD Color Index (ACI) as red value, green value and
+ * blue value for each color number.
+ *
+ * See also http://www.isctex.com/acadcolors.php.
+ */
+static const uint8_t dxf_ACI_RGB[DXF_COLOR_INDEX_MAX_NUMBER_OF_COLORS][3] =
+{
+        {0, 0, 0}, /* 0 */
+        {255, 0, 0}, /* 1 */
+        {255, 255, 0}, /* 2 */
+        {0, 255, 0}, /* 3 */
+        {0, 255, 255}, /* 4 */
+        {0, 0, 255}, /* 5 */
+        {255, 0, 255}, /* 6 */
+        {255, 255, 255}, /* 7 */
+        {128, 128, 128}, /* 8 */
+        {192, 192, 192}, /* 9 */
+        {255, 0, 0}, /* 10 */
+        {255, 127, 127}, /* 11 */
+        {204, 0, 0}, /* 12 */
+        {204, 102, 102}, /* 13 */
+        {153, 0, 0}, /* 14 */
+        {153, 76, 76}, /* 15 */
+        {127, 0, 0}, /* 16 */
+        {127, 63, 63}, /* 17 */
+        {76, 0, 0}, /* 18 */
+        {76, 38, 38}, /* 19 */
+        {255, 63, 0}, /* 20 */
+        {255, 159, 127}, /* 21 */
+        {204, 51, 0}, /* 22 */
+        {204, 127, 102}, /* 23 */
+        {153, 38, 0}, /* 24 */
+        {153, 95, 76}, /* 25 */
+        {127, 31, 0}, /* 26 */
+        {127, 79, 63}, /* 27 */
+        {76, 19, 0}, /* 28 */
+        {76, 47, 38}, /* 29 */
+        {255, 127, 0}, /* 30 */
+        {255, 191, 127}, /* 31 */
+        {204, 102, 0}, /* 32 */
+        {204, 153, 102}, /* 33 */
+        {153, 76, 0}, /* 34 */
+        {153, 114, 76}, /* 35 */
+        {127, 63, 0}, /* 36 */
+        {127, 95, 63}, /* 37 */
+        {76, 38, 0}, /* 38 */
+        {76, 57, 38}, /* 39 */
+        {255, 191, 0}, /* 40 */
+        {255, 223, 127}, /* 41 */
+        {204, 153, 0}, /* 42 */
+        {204, 178, 102}, /* 43 */
+        {153, 114, 0}, /* 44 */
+        {153, 133, 76}, /* 45 */
+        {127, 95, 0}, /* 46 */
+        {127, 111, 63}, /* 47 */
+        {76, 57, 0}, /* 48 */
+        {76, 66, 38}, /* 49 */
+        {255, 255, 0}, /* 50 */
+        {255, 255, 127}, /* 51 */
+        {204, 204, 0}, /* 52 */
+        {204, 204, 102}, /* 53 */
+        {153, 153, 0}, /* 54 */
+        {153, 153, 76}, /* 55 */
+        {127, 127, 0}, /* 56 */
+        {127, 127, 63}, /* 57 */
+        {76, 76, 0}, /* 58 */
+        {76, 76, 38}, /* 59 */
+        {191, 255, 0}, /* 60 */
+        {223, 255, 127}, /* 61 */
+        {153, 204, 0}, /* 62 */
+        {178, 204, 102}, /* 63 */
+        {114, 153, 0}, /* 64 */
+        {133, 153, 76}, /* 65 */
+        {95, 127, 0}, /* 66 */
+        {111, 127, 63}, /* 67 */
+        {57, 76, 0}, /* 68 */
+        {66, 76, 38}, /* 69 */
+        {127, 255, 0}, /* 70 */
+        {191, 255, 127}, /* 71 */
+        {102, 204, 0}, /* 72 */
+        {153, 204, 102}, /* 73 */
+        {76, 153, 0}, /* 74 */
+        {114, 153, 76}, /* 75 */
+        {63, 127, 0}, /* 76 */
+        {95, 127, 63}, /* 77 */
+        {38, 76, 0}, /* 78 */
+        {57, 76, 38}, /* 79 */
+        {63, 255, 0}, /* 80 */
+        {159, 255, 127}, /* 81 */
+        {51, 204, 0}, /* 82 */
+        {127, 204, 102}, /* 83 */
+        {38, 153, 0}, /* 84 */
+        {95, 153, 76}, /* 85 */
+        {31, 127, 0}, /* 86 */
+        {79, 127, 63}, /* 87 */
+        {19, 76, 0}, /* 88 */
+        {47, 76, 38}, /* 89 */
+        {0, 255, 0}, /* 90 */
+        {127, 255, 127}, /* 91 */
+        {0, 204, 0}, /* 92 */
+        {102, 204, 102}, /* 93 */
+        {0, 153, 0}, /* 94 */
+        {76, 153, 76}, /* 95 */
+        {0, 127, 0}, /* 96 */
+        {63, 127, 63}, /* 97 */
+        {0, 76, 0}, /* 98 */
+        {38, 76, 38}, /* 99 */
+        {0, 255, 63}, /* 100 */
+        {127, 255, 159}, /* 101 */
+        {0, 204, 51}, /* 102 */
+        {102, 204, 127}, /* 103 */
+        {0, 153, 38}, /* 104 */
+        {76, 153, 95}, /* 105 */
+        {0, 127, 31}, /* 106 */
+        {63, 127, 79}, /* 107 */
+        {0, 76, 19}, /* 108 */
+        {38, 76, 47}, /* 109 */
+        {0, 255, 127}, /* 110 */
+        {127, 255, 191}, /* 111 */
+        {0, 204, 102}, /* 112 */
+        {102, 204, 153}, /* 113 */
+        {0, 153, 76}, /* 114 */
+        {76, 153, 114}, /* 115 */
+        {0, 127, 63}, /* 116 */
+        {63, 127, 95}, /* 117 */
+        {0, 76, 38}, /* 118 */
+        {38, 76, 57}, /* 119 */
+        {0, 255, 191}, /* 120 */
+        {127, 255, 223}, /* 121 */
+        {0, 204, 153}, /* 122 */
+        {102, 204, 178}, /* 123 */
+        {0, 153, 114}, /* 124 */
+        {76, 153, 133}, /* 125 */
+        {0, 127, 95}, /* 126 */
+        {63, 127, 111}, /* 127 */
+        {0, 76, 57}, /* 128 */
+        {38, 76, 66}, /* 129 */
+        {0, 255, 255}, /* 130 */
+        {127, 255, 255}, /* 131 */
+        {0, 204, 204}, /* 132 */
+        {102, 204, 204}, /* 133 */
+        {0, 153, 153}, /* 134 */
+        {76, 153, 153}, /* 135 */
+        {0, 127, 127}, /* 136 */
+        {63, 127, 127}, /* 137 */
+        {0, 76, 76}, /* 138 */
+        {38, 76, 76}, /* 139 */
+        {0, 191, 255}, /* 140 */
+        {127, 223, 255}, /* 141 */
+        {0, 153, 204}, /* 142 */
+        {102, 178, 204}, /* 143 */
+        {0, 114, 153}, /* 144 */
+        {76, 133, 153}, /* 145 */
+        {0, 95, 127}, /* 146 */
+        {63, 111, 127}, /* 147 */
+        {0, 57, 76}, /* 148 */
+        {38, 66, 76}, /* 149 */
+        {0, 127, 255}, /* 150 */
+        {127, 191, 255}, /* 151 */
+        {0, 102, 204}, /* 152 */
+        {102, 153, 204}, /* 153 */
+        {0, 76, 153}, /* 154 */
+        {76, 114, 153}, /* 155 */
+        {0, 63, 127}, /* 156 */
+        {63, 95, 127}, /* 157 */
+        {0, 38, 76}, /* 158 */
+        {38, 57, 76}, /* 159 */
+        {0, 63, 255}, /* 160 */
+        {127, 159, 255}, /* 161 */
+        {0, 51, 204}, /* 162 */
+        {102, 127, 204}, /* 163 */
+        {0, 38, 153}, /* 164 */
+        {76, 95, 153}, /* 165 */
+        {0, 31, 127}, /* 166 */
+        {63, 79, 127}, /* 167 */
+        {0, 19, 76}, /* 168 */
+        {38, 47, 76}, /* 169 */
+        {0, 0, 255}, /* 170 */
+        {170, 170, 255}, /* 171 */
+        {0, 0, 189}, /* 172 */
+        {126, 126, 189}, /* 173 */
+        {0, 0, 129}, /* 174 */
+        {86, 86, 129}, /* 175 */
+        {0, 0, 104}, /* 176 */
+        {69, 69, 104}, /* 177 */
+        {0, 0, 79}, /* 178 */
+        {53, 53, 79}, /* 179 */
+        {63, 0, 255}, /* 180 */
+        {191, 170, 255}, /* 181 */
+        {46, 0, 189}, /* 182 */
+        {141, 126, 189}, /* 183 */
+        {31, 0, 129}, /* 184 */
+        {96, 86, 129}, /* 185 */
+        {25, 0, 104}, /* 186 */
+        {78, 69, 104}, /* 187 */
+        {19, 0, 79}, /* 188 */
+        {59, 53, 79}, /* 189 */
+        {127, 0, 255}, /* 190 */
+        {212, 170, 255}, /* 191 */
+        {94, 0, 189}, /* 192 */
+        {157, 126, 189}, /* 193 */
+        {64, 0, 129}, /* 194 */
+        {107, 86, 129}, /* 195 */
+        {52, 0, 104}, /* 196 */
+        {86, 69, 104}, /* 197 */
+        {39, 0, 79}, /* 198 */
+        {66, 53, 79}, /* 199 */
+        {191, 0, 255}, /* 200 */
+        {234, 170, 255}, /* 201 */
+        {141, 0, 189}, /* 202 */
+        {173, 126, 189}, /* 203 */
+        {96, 0, 129}, /* 204 */
+        {118, 86, 129}, /* 205 */
+        {78, 0, 104}, /* 206 */
+        {95, 69, 104}, /* 207 */
+        {59, 0, 79}, /* 208 */
+        {73, 53, 79}, /* 209 */
+        {255, 0, 255}, /* 210 */
+        {255, 170, 255}, /* 211 */
+        {189, 0, 189}, /* 212 */
+        {189, 126, 189}, /* 213 */
+        {129, 0, 129}, /* 214 */
+        {129, 86, 129}, /* 215 */
+        {104, 0, 104}, /* 216 */
+        {104, 69, 104}, /* 217 */
+        {79, 0, 79}, /* 218 */
+        {79, 53, 79}, /* 219 */
+        {255, 0, 191}, /* 220 */
+        {255, 170, 234}, /* 221 */
+        {189, 0, 141}, /* 222 */
+        {189, 126, 173}, /* 223 */
+        {129, 0, 96}, /* 224 */
+        {129, 86, 118}, /* 225 */
+        {104, 0, 78}, /* 226 */
+        {104, 69, 95}, /* 227 */
+        {79, 0, 59}, /* 228 */
+        {79, 53, 73}, /* 229 */
+        {255, 0, 127}, /* 230 */
+        {255, 170, 212}, /* 231 */
+        {189, 0, 94}, /* 232 */
+        {189, 126, 157}, /* 233 */
+        {129, 0, 64}, /* 234 */
+        {129, 86, 107}, /* 235 */
+        {104, 0, 52}, /* 236 */
+        {104, 69, 86}, /* 237 */
+        {79, 0, 39}, /* 238 */
+        {79, 53, 66}, /* 239 */
+        {255, 0, 63}, /* 240 */
+        {255, 170, 191}, /* 241 */
+        {189, 0, 46}, /* 242 */
+        {189, 126, 141}, /* 243 */
+        {129, 0, 31}, /* 244 */
+        {129, 86, 96}, /* 245 */
+        {104, 0, 25}, /* 246 */
+        {104, 69, 78}, /* 247 */
+        {79, 0, 19}, /* 248 */
+        {79, 53, 59}, /* 249 */
+        {51, 51, 51}, /* 250 */
+        {80, 80, 80}, /* 251 */
+        {105, 105, 105}, /* 252 */
+        {130, 130, 130}, /* 253 */
+        {190, 190, 190}, /* 254 */
+        {255, 255, 255} /* 255 */
+};
+
+
+#define DXF_ACI_GRID_SHIFT 5
+        /*!< \brief Number of bits of a color component dropped for the
+         * grid cell index of the nearest color lookup. */
+
+#define DXF_ACI_GRID_SIZE 8
+        /*!< \brief Number of grid cells along each color axis. */
+
+
+static int dxf_ACI_grid_start[(DXF_ACI_GRID_SIZE * DXF_ACI_GRID_SIZE * DXF_ACI_GRID_SIZE) + 1];
+        /*!< Index of the first color in each grid cell, with an extra
+         * entry for the end of the last cell. */
+static uint8_t dxf_ACI_grid_colors[DXF_COLOR_INDEX_MAX_NUMBER_OF_COLORS];
+        /*!< Color numbers sorted on grid cell. */
+static pthread_once_t dxf_ACI_grid_once = PTHREAD_ONCE_INIT;
+
+
+static void dxf_ACI_grid_build ();
+static unsigned int dxf_color_table_hash (const char *layer_name);
 /*!
  * \brief Allocate memory for a DXF color.
  *
@@ -157,7 +444,9 @@ dxf_RGB_color_set
  * Index (ACI).
  *
  * These colors are defined by red value, green value, blue value and
- * contain no alpha value (see also http://www.isctex.com/acadcolors.php).
+ * contain no alpha value (see also http://www.isctex.com/acadcolors.php).\n
+ * The values are copied from the static \c dxf_ACI_RGB table, the
+ * caller owns the allocated colors in \c ACI.
  */
 int
 dxf_ACI_init
@@ -168,277 +457,21 @@ dxf_ACI_init
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        size_t size;
+        int i;
 
-        size = sizeof (DxfRGBColor);
-        /* avoid malloc of 0 bytes */
-        if (size == 0) size = 1;
-        if ((ACI = malloc (size * DXF_COLOR_INDEX_MAX_NUMBER_OF_COLORS)) == NULL)
+        /* Do some basic checks. */
+        if (ACI == NULL)
         {
                 fprintf (stderr,
-                  (_("Error in %s () could not allocate memory for a DxfRGBCcolor array.\n")),
+                  (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
-                ACI = NULL;
                 return (EXIT_FAILURE);
         }
-        else
+        for (i = 0; i < DXF_COLOR_INDEX_MAX_NUMBER_OF_COLORS; i++)
         {
-                ACI[0] = dxf_RGB_color_set (0,0,0);
-                ACI[1] = dxf_RGB_color_set (255,0,0);
-                ACI[2] = dxf_RGB_color_set (255,255,0);
-                ACI[3] = dxf_RGB_color_set (0,255,0);
-                ACI[4] = dxf_RGB_color_set (0,255,255);
-                ACI[5] = dxf_RGB_color_set (0,0,255);
-                ACI[6] = dxf_RGB_color_set (255,0,255);
-                ACI[7] = dxf_RGB_color_set (255,255,255);
-                ACI[8] = dxf_RGB_color_set (128,128,128);
-                ACI[9] = dxf_RGB_color_set (192,192,192);
-                ACI[10] = dxf_RGB_color_set (255,0,0);
-                ACI[11] = dxf_RGB_color_set (255,127,127);
-                ACI[12] = dxf_RGB_color_set (204,0,0);
-                ACI[13] = dxf_RGB_color_set (204,102,102);
-                ACI[14] = dxf_RGB_color_set (153,0,0);
-                ACI[15] = dxf_RGB_color_set (153,76,76);
-                ACI[16] = dxf_RGB_color_set (127,0,0);
-                ACI[17] = dxf_RGB_color_set (127,63,63);
-                ACI[18] = dxf_RGB_color_set (76,0,0);
-                ACI[19] = dxf_RGB_color_set (76,38,38);
-                ACI[20] = dxf_RGB_color_set (255,63,0);
-                ACI[21] = dxf_RGB_color_set (255,159,127);
-                ACI[22] = dxf_RGB_color_set (204,51,0);
-                ACI[23] = dxf_RGB_color_set (204,127,102);
-                ACI[24] = dxf_RGB_color_set (153,38,0);
-                ACI[25] = dxf_RGB_color_set (153,95,76);
-                ACI[26] = dxf_RGB_color_set (127,31,0);
-                ACI[27] = dxf_RGB_color_set (127,79,63);
-                ACI[28] = dxf_RGB_color_set (76,19,0);
-                ACI[29] = dxf_RGB_color_set (76,47,38);
-                ACI[30] = dxf_RGB_color_set (255,127,0);
-                ACI[31] = dxf_RGB_color_set (255,191,127);
-                ACI[32] = dxf_RGB_color_set (204,102,0);
-                ACI[33] = dxf_RGB_color_set (204,153,102);
-                ACI[34] = dxf_RGB_color_set (153,76,0);
-                ACI[35] = dxf_RGB_color_set (153,114,76);
-                ACI[36] = dxf_RGB_color_set (127,63,0);
-                ACI[37] = dxf_RGB_color_set (127,95,63);
-                ACI[38] = dxf_RGB_color_set (76,38,0);
-                ACI[39] = dxf_RGB_color_set (76,57,38);
-                ACI[40] = dxf_RGB_color_set (255,191,0);
-                ACI[41] = dxf_RGB_color_set (255,223,127);
-                ACI[42] = dxf_RGB_color_set (204,153,0);
-                ACI[43] = dxf_RGB_color_set (204,178,102);
-                ACI[44] = dxf_RGB_color_set (153,114,0);
-                ACI[45] = dxf_RGB_color_set (153,133,76);
-                ACI[46] = dxf_RGB_color_set (127,95,0);
-                ACI[47] = dxf_RGB_color_set (127,111,63);
-                ACI[48] = dxf_RGB_color_set (76,57,0);
-                ACI[49] = dxf_RGB_color_set (76,66,38);
-                ACI[50] = dxf_RGB_color_set (255,255,0);
-                ACI[51] = dxf_RGB_color_set (255,255,127);
-                ACI[52] = dxf_RGB_color_set (204,204,0);
-                ACI[53] = dxf_RGB_color_set (204,204,102);
-                ACI[54] = dxf_RGB_color_set (153,153,0);
-                ACI[55] = dxf_RGB_color_set (153,153,76);
-                ACI[56] = dxf_RGB_color_set (127,127,0);
-                ACI[57] = dxf_RGB_color_set (127,127,63);
-                ACI[58] = dxf_RGB_color_set (76,76,0);
-                ACI[59] = dxf_RGB_color_set (76,76,38);
-                ACI[60] = dxf_RGB_color_set (191,255,0);
-                ACI[61] = dxf_RGB_color_set (223,255,127);
-                ACI[62] = dxf_RGB_color_set (153,204,0);
-                ACI[63] = dxf_RGB_color_set (178,204,102);
-                ACI[64] = dxf_RGB_color_set (114,153,0);
-                ACI[65] = dxf_RGB_color_set (133,153,76);
-                ACI[66] = dxf_RGB_color_set (95,127,0);
-                ACI[67] = dxf_RGB_color_set (111,127,63);
-                ACI[68] = dxf_RGB_color_set (57,76,0);
-                ACI[69] = dxf_RGB_color_set (66,76,38);
-                ACI[70] = dxf_RGB_color_set (127,255,0);
-                ACI[71] = dxf_RGB_color_set (191,255,127);
-                ACI[72] = dxf_RGB_color_set (102,204,0);
-                ACI[73] = dxf_RGB_color_set (153,204,102);
-                ACI[74] = dxf_RGB_color_set (76,153,0);
-                ACI[75] = dxf_RGB_color_set (114,153,76);
-                ACI[76] = dxf_RGB_color_set (63,127,0);
-                ACI[77] = dxf_RGB_color_set (95,127,63);
-                ACI[78] = dxf_RGB_color_set (38,76,0);
-                ACI[79] = dxf_RGB_color_set (57,76,38);
-                ACI[80] = dxf_RGB_color_set (63,255,0);
-                ACI[81] = dxf_RGB_color_set (159,255,127);
-                ACI[82] = dxf_RGB_color_set (51,204,0);
-                ACI[83] = dxf_RGB_color_set (127,204,102);
-                ACI[84] = dxf_RGB_color_set (38,153,0);
-                ACI[85] = dxf_RGB_color_set (95,153,76);
-                ACI[86] = dxf_RGB_color_set (31,127,0);
-                ACI[87] = dxf_RGB_color_set (79,127,63);
-                ACI[88] = dxf_RGB_color_set (19,76,0);
-                ACI[89] = dxf_RGB_color_set (47,76,38);
-                ACI[90] = dxf_RGB_color_set (0,255,0);
-                ACI[91] = dxf_RGB_color_set (127,255,127);
-                ACI[92] = dxf_RGB_color_set (0,204,0);
-                ACI[93] = dxf_RGB_color_set (102,204,102);
-                ACI[94] = dxf_RGB_color_set (0,153,0);
-                ACI[95] = dxf_RGB_color_set (76,153,76);
-                ACI[96] = dxf_RGB_color_set (0,127,0);
-                ACI[97] = dxf_RGB_color_set (63,127,63);
-                ACI[98] = dxf_RGB_color_set (0,76,0);
-                ACI[99] = dxf_RGB_color_set (38,76,38);
-                ACI[100] = dxf_RGB_color_set (0,255,63);
-                ACI[101] = dxf_RGB_color_set (127,255,159);
-                ACI[102] = dxf_RGB_color_set (0,204,51);
-                ACI[103] = dxf_RGB_color_set (102,204,127);
-                ACI[104] = dxf_RGB_color_set (0,153,38);
-                ACI[105] = dxf_RGB_color_set (76,153,95);
-                ACI[106] = dxf_RGB_color_set (0,127,31);
-                ACI[107] = dxf_RGB_color_set (63,127,79);
-                ACI[108] = dxf_RGB_color_set (0,76,19);
-                ACI[109] = dxf_RGB_color_set (38,76,47);
-                ACI[110] = dxf_RGB_color_set (0,255,127);
-                ACI[111] = dxf_RGB_color_set (127,255,191);
-                ACI[112] = dxf_RGB_color_set (0,204,102);
-                ACI[113] = dxf_RGB_color_set (102,204,153);
-                ACI[114] = dxf_RGB_color_set (0,153,76);
-                ACI[115] = dxf_RGB_color_set (76,153,114);
-                ACI[116] = dxf_RGB_color_set (0,127,63);
-                ACI[117] = dxf_RGB_color_set (63,127,95);
-                ACI[118] = dxf_RGB_color_set (0,76,38);
-                ACI[119] = dxf_RGB_color_set (38,76,57);
-                ACI[120] = dxf_RGB_color_set (0,255,191);
-                ACI[121] = dxf_RGB_color_set (127,255,223);
-                ACI[122] = dxf_RGB_color_set (0,204,153);
-                ACI[123] = dxf_RGB_color_set (102,204,178);
-                ACI[124] = dxf_RGB_color_set (0,153,114);
-                ACI[125] = dxf_RGB_color_set (76,153,133);
-                ACI[126] = dxf_RGB_color_set (0,127,95);
-                ACI[127] = dxf_RGB_color_set (63,127,111);
-                ACI[128] = dxf_RGB_color_set (0,76,57);
-                ACI[129] = dxf_RGB_color_set (38,76,66);
-                ACI[130] = dxf_RGB_color_set (0,255,255);
-                ACI[131] = dxf_RGB_color_set (127,255,255);
-                ACI[132] = dxf_RGB_color_set (0,204,204);
-                ACI[133] = dxf_RGB_color_set (102,204,204);
-                ACI[134] = dxf_RGB_color_set (0,153,153);
-                ACI[135] = dxf_RGB_color_set (76,153,153);
-                ACI[136] = dxf_RGB_color_set (0,127,127);
-                ACI[137] = dxf_RGB_color_set (63,127,127);
-                ACI[138] = dxf_RGB_color_set (0,76,76);
-                ACI[139] = dxf_RGB_color_set (38,76,76);
-                ACI[140] = dxf_RGB_color_set (0,191,255);
-                ACI[141] = dxf_RGB_color_set (127,223,255);
-                ACI[142] = dxf_RGB_color_set (0,153,204);
-                ACI[143] = dxf_RGB_color_set (102,178,204);
-                ACI[144] = dxf_RGB_color_set (0,114,153);
-                ACI[145] = dxf_RGB_color_set (76,133,153);
-                ACI[146] = dxf_RGB_color_set (0,95,127);
-                ACI[147] = dxf_RGB_color_set (63,111,127);
-                ACI[148] = dxf_RGB_color_set (0,57,76);
-                ACI[149] = dxf_RGB_color_set (38,66,76);
-                ACI[150] = dxf_RGB_color_set (0,127,255);
-                ACI[151] = dxf_RGB_color_set (127,191,255);
-                ACI[152] = dxf_RGB_color_set (0,102,204);
-                ACI[153] = dxf_RGB_color_set (102,153,204);
-                ACI[154] = dxf_RGB_color_set (0,76,153);
-                ACI[155] = dxf_RGB_color_set (76,114,153);
-                ACI[156] = dxf_RGB_color_set (0,63,127);
-                ACI[157] = dxf_RGB_color_set (63,95,127);
-                ACI[158] = dxf_RGB_color_set (0,38,76);
-                ACI[159] = dxf_RGB_color_set (38,57,76);
-                ACI[160] = dxf_RGB_color_set (0,63,255);
-                ACI[161] = dxf_RGB_color_set (127,159,255);
-                ACI[162] = dxf_RGB_color_set (0,51,204);
-                ACI[163] = dxf_RGB_color_set (102,127,204);
-                ACI[164] = dxf_RGB_color_set (0,38,153);
-                ACI[165] = dxf_RGB_color_set (76,95,153);
-                ACI[166] = dxf_RGB_color_set (0,31,127);
-                ACI[167] = dxf_RGB_color_set (63,79,127);
-                ACI[168] = dxf_RGB_color_set (0,19,76);
-                ACI[169] = dxf_RGB_color_set (38,47,76);
-                ACI[170] = dxf_RGB_color_set (0,0,255);
-                ACI[171] = dxf_RGB_color_set (170,170,255);
-                ACI[172] = dxf_RGB_color_set (0,0,189);
-                ACI[173] = dxf_RGB_color_set (126,126,189);
-                ACI[174] = dxf_RGB_color_set (0,0,129);
-                ACI[175] = dxf_RGB_color_set (86,86,129);
-                ACI[176] = dxf_RGB_color_set (0,0,104);
-                ACI[177] = dxf_RGB_color_set (69,69,104);
-                ACI[178] = dxf_RGB_color_set (0,0,79);
-                ACI[179] = dxf_RGB_color_set (53,53,79);
-                ACI[180] = dxf_RGB_color_set (63,0,255);
-                ACI[181] = dxf_RGB_color_set (191,170,255);
-                ACI[182] = dxf_RGB_color_set (46,0,189);
-                ACI[183] = dxf_RGB_color_set (141,126,189);
-                ACI[184] = dxf_RGB_color_set (31,0,129);
-                ACI[185] = dxf_RGB_color_set (96,86,129);
-                ACI[186] = dxf_RGB_color_set (25,0,104);
-                ACI[187] = dxf_RGB_color_set (78,69,104);
-                ACI[188] = dxf_RGB_color_set (19,0,79);
-                ACI[189] = dxf_RGB_color_set (59,53,79);
-                ACI[190] = dxf_RGB_color_set (127,0,255);
-                ACI[191] = dxf_RGB_color_set (212,170,255);
-                ACI[192] = dxf_RGB_color_set (94,0,189);
-                ACI[193] = dxf_RGB_color_set (157,126,189);
-                ACI[194] = dxf_RGB_color_set (64,0,129);
-                ACI[195] = dxf_RGB_color_set (107,86,129);
-                ACI[196] = dxf_RGB_color_set (52,0,104);
-                ACI[197] = dxf_RGB_color_set (86,69,104);
-                ACI[198] = dxf_RGB_color_set (39,0,79);
-                ACI[199] = dxf_RGB_color_set (66,53,79);
-                ACI[200] = dxf_RGB_color_set (191,0,255);
-                ACI[201] = dxf_RGB_color_set (234,170,255);
-                ACI[202] = dxf_RGB_color_set (141,0,189);
-                ACI[203] = dxf_RGB_color_set (173,126,189);
-                ACI[204] = dxf_RGB_color_set (96,0,129);
-                ACI[205] = dxf_RGB_color_set (118,86,129);
-                ACI[206] = dxf_RGB_color_set (78,0,104);
-                ACI[207] = dxf_RGB_color_set (95,69,104);
-                ACI[208] = dxf_RGB_color_set (59,0,79);
-                ACI[209] = dxf_RGB_color_set (73,53,79);
-                ACI[210] = dxf_RGB_color_set (255,0,255);
-                ACI[211] = dxf_RGB_color_set (255,170,255);
-                ACI[212] = dxf_RGB_color_set (189,0,189);
-                ACI[213] = dxf_RGB_color_set (189,126,189);
-                ACI[214] = dxf_RGB_color_set (129,0,129);
-                ACI[215] = dxf_RGB_color_set (129,86,129);
-                ACI[216] = dxf_RGB_color_set (104,0,104);
-                ACI[217] = dxf_RGB_color_set (104,69,104);
-                ACI[218] = dxf_RGB_color_set (79,0,79);
-                ACI[219] = dxf_RGB_color_set (79,53,79);
-                ACI[220] = dxf_RGB_color_set (255,0,191);
-                ACI[221] = dxf_RGB_color_set (255,170,234);
-                ACI[222] = dxf_RGB_color_set (189,0,141);
-                ACI[223] = dxf_RGB_color_set (189,126,173);
-                ACI[224] = dxf_RGB_color_set (129,0,96);
-                ACI[225] = dxf_RGB_color_set (129,86,118);
-                ACI[226] = dxf_RGB_color_set (104,0,78);
-                ACI[227] = dxf_RGB_color_set (104,69,95);
-                ACI[228] = dxf_RGB_color_set (79,0,59);
-                ACI[229] = dxf_RGB_color_set (79,53,73);
-                ACI[230] = dxf_RGB_color_set (255,0,127);
-                ACI[231] = dxf_RGB_color_set (255,170,212);
-                ACI[232] = dxf_RGB_color_set (189,0,94);
-                ACI[233] = dxf_RGB_color_set (189,126,157);
-                ACI[234] = dxf_RGB_color_set (129,0,64);
-                ACI[235] = dxf_RGB_color_set (129,86,107);
-                ACI[236] = dxf_RGB_color_set (104,0,52);
-                ACI[237] = dxf_RGB_color_set (104,69,86);
-                ACI[238] = dxf_RGB_color_set (79,0,39);
-                ACI[239] = dxf_RGB_color_set (79,53,66);
-                ACI[240] = dxf_RGB_color_set (255,0,63);
-                ACI[241] = dxf_RGB_color_set (255,170,191);
-                ACI[242] = dxf_RGB_color_set (189,0,46);
-                ACI[243] = dxf_RGB_color_set (189,126,141);
-                ACI[244] = dxf_RGB_color_set (129,0,31);
-                ACI[245] = dxf_RGB_color_set (129,86,96);
-                ACI[246] = dxf_RGB_color_set (104,0,25);
-                ACI[247] = dxf_RGB_color_set (104,69,78);
-                ACI[248] = dxf_RGB_color_set (79,0,19);
-                ACI[249] = dxf_RGB_color_set (79,53,59);
-                ACI[250] = dxf_RGB_color_set (51,51,51);
-                ACI[251] = dxf_RGB_color_set (80,80,80);
-                ACI[252] = dxf_RGB_color_set (105,105,105);
-                ACI[253] = dxf_RGB_color_set (130,130,130);
-                ACI[254] = dxf_RGB_color_set (190,190,190);
-                ACI[255] = dxf_RGB_color_set (255,255,255);
+                ACI[i] = dxf_RGB_color_set (dxf_ACI_RGB[i][0],
+                  dxf_ACI_RGB[i][1],
+                  dxf_ACI_RGB[i][2]);
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -2290,4 +2323,649 @@ dxf_RGB_color_free_list
 }
 
 
+/*!
+ * \brief Get the red value, green value and blue value of an AutoCAD
+ * Color Index (ACI) color number as a hexadecimal triplet.
+ *
+ * A negative color number (layer turned off) is taken as its absolute
+ * value.
+ *
+ * \return the hexadecimal triplet in the order 0xRRGGBB, or
+ * \c DXF_ERROR for \c BYBLOCK, \c BYLAYER and out of range color
+ * numbers.
+ */
+int
+dxf_ACI_get_RGB
+(
+        int color
+                /*!< AutoCAD Color Index color number. */
+)
+{
+        if (color < 0)
+        {
+                color = -color;
+        }
+        if ((color <= DXF_COLOR_BYBLOCK)
+          || (color >= DXF_COLOR_INDEX_MAX_NUMBER_OF_COLORS))
+        {
+                return (DXF_ERROR);
+        }
+        return ((dxf_ACI_RGB[color][0] << 16)
+          | (dxf_ACI_RGB[color][1] << 8)
+          | dxf_ACI_RGB[color][2]);
+}
+
+
+/*!
+ * \brief Get the AutoCAD Color Index (ACI) color number closest to a
+ * hexadecimal triplet.
+ *
+ * The distance is the euclidean distance in RGB space.\n
+ * The ACI colors are sorted into a coarse grid over the RGB cube (built
+ * once, on the first call), the search visits the grid cells in shells
+ * of increasing distance around the cell of the requested color and
+ * stops as soon as no unvisited cell can hold a closer color.\n
+ * Of equally distant colors the lowest color number is returned.
+ *
+ * \return a color number from 1 to 255.
+ */
+int
+dxf_ACI_get_nearest
+(
+        int RGB_color_hex_triplet
+                /*!< the hexadecimal values as in red value, green
+                 * value, blue value in the order 0xRRGGBB. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        int value[3];
+        int cell[3];
+        int low[3];
+        int high[3];
+        int best;
+        int best_distance;
+        int bound;
+        int distance;
+        int shell;
+        int cell_index;
+        int color;
+        int i;
+        int r;
+        int g;
+        int b;
+        int d;
+
+        pthread_once (&dxf_ACI_grid_once, dxf_ACI_grid_build);
+        value[0] = (RGB_color_hex_triplet >> 16) & 0xFF;
+        value[1] = (RGB_color_hex_triplet >> 8) & 0xFF;
+        value[2] = RGB_color_hex_triplet & 0xFF;
+        for (i = 0; i < 3; i++)
+        {
+                cell[i] = value[i] >> DXF_ACI_GRID_SHIFT;
+        }
+        best = DXF_COLOR_WHITE;
+        best_distance = INT_MAX;
+        for (shell = 0; shell < DXF_ACI_GRID_SIZE; shell++)
+        {
+                for (i = 0; i < 3; i++)
+                {
+                        low[i] = (cell[i] - shell < 0) ? 0 : cell[i] - shell;
+                        high[i] = (cell[i] + shell >= DXF_ACI_GRID_SIZE) ? DXF_ACI_GRID_SIZE - 1 : cell[i] + shell;
+                }
+                for (r = low[0]; r <= high[0]; r++)
+                {
+                        for (g = low[1]; g <= high[1]; g++)
+                        {
+                                for (b = low[2]; b <= high[2]; b++)
+                                {
+                                        /* Only the cells on the surface
+                                         * of the shell. */
+                                        if ((abs (r - cell[0]) != shell)
+                                          && (abs (g - cell[1]) != shell)
+                                          && (abs (b - cell[2]) != shell))
+                                        {
+                                                continue;
+                                        }
+                                        cell_index = (((r * DXF_ACI_GRID_SIZE) + g) * DXF_ACI_GRID_SIZE) + b;
+                                        for (i = dxf_ACI_grid_start[cell_index]; i < dxf_ACI_grid_start[cell_index + 1]; i++)
+                                        {
+                                                color = dxf_ACI_grid_colors[i];
+                                                distance = 0;
+                                                for (d = 0; d < 3; d++)
+                                                {
+                                                        distance += (dxf_ACI_RGB[color][d] - value[d])
+                                                          * (dxf_ACI_RGB[color][d] - value[d]);
+                                                }
+                                                if ((distance < best_distance)
+                                                  || ((distance == best_distance) && (color < best)))
+                                                {
+                                                        best_distance = distance;
+                                                        best = color;
+                                                }
+                                        }
+                                }
+                        }
+                }
+                /* The closest possible color outside this shell. */
+                bound = INT_MAX;
+                for (i = 0; i < 3; i++)
+                {
+                        if (cell[i] - shell > 0)
+                        {
+                                d = value[i] - ((cell[i] - shell) << DXF_ACI_GRID_SHIFT) + 1;
+                                bound = (d < bound) ? d : bound;
+                        }
+                        if (cell[i] + shell < DXF_ACI_GRID_SIZE - 1)
+                        {
+                                d = ((cell[i] + shell + 1) << DXF_ACI_GRID_SHIFT) - value[i];
+                                bound = (d < bound) ? d : bound;
+                        }
+                }
+                if ((bound == INT_MAX) || (best_distance < bound * bound))
+                {
+                        break;
+                }
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (best);
+}
+
+
+/*!
+ * \brief Allocate memory for a \c DxfColorTable.
+ *
+ * Fill the memory contents with zeros.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfColorTable *
+dxf_color_table_new ()
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfColorTable *table = NULL;
+        size_t size;
+
+        size = sizeof (DxfColorTable);
+        /* avoid malloc of 0 bytes */
+        if (size == 0) size = 1;
+        if ((table = malloc (size)) == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory for a DxfColorTable struct.\n")),
+                  __FUNCTION__);
+                table = NULL;
+        }
+        else
+        {
+                memset (table, 0, size);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (table);
+}
+
+
+/*!
+ * \brief Allocate memory and initialize data fields in a
+ * \c DxfColorTable.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfColorTable *
+dxf_color_table_init
+(
+        DxfColorTable *table
+                /*!< a pointer to the color table. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (table == NULL)
+        {
+                fprintf (stderr,
+                  (_("Warning in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                table = dxf_color_table_new ();
+        }
+        if (table == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory for a DxfColorTable struct.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        table->number_of_layers = 0;
+        table->number_of_slots = 0;
+        table->layer_name = NULL;
+        table->layer_RGB = NULL;
+        table->default_RGB = dxf_ACI_get_RGB (DXF_COLOR_WHITE);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (table);
+}
+
+
+/*!
+ * \brief Build a \c DxfColorTable from a single linked list of DXF
+ * \c LAYER symbol table entries.
+ *
+ * Any previous contents of the table are cleared.\n
+ * The layer names are copied, the layer list may be freed afterwards.\n
+ * Layers without a valid color (\c BYBLOCK or \c BYLAYER) get the color
+ * \c WHITE, of layers with the same name the first one is used.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_color_table_build
+(
+        DxfColorTable *table,
+                /*!< a pointer to the color table. */
+        DxfLayer *layers
+                /*!< a pointer to a single linked list of DXF \c LAYER
+                 * symbol table entries. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfLayer *iter = NULL;
+        unsigned int slot;
+        int number_of_layers;
+        int RGB;
+
+        /* Do some basic checks. */
+        if (table == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_color_table_clear (table);
+        number_of_layers = 0;
+        for (iter = layers; iter != NULL; iter = (DxfLayer *) iter->next)
+        {
+                number_of_layers++;
+        }
+        /* Keep the load factor at or below one half. */
+        table->number_of_slots = 16;
+        while (table->number_of_slots < 2 * number_of_layers)
+        {
+                table->number_of_slots *= 2;
+        }
+        table->layer_name = calloc (table->number_of_slots, sizeof (char *));
+        table->layer_RGB = calloc (table->number_of_slots, sizeof (int));
+        if ((table->layer_name == NULL) || (table->layer_RGB == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                dxf_color_table_clear (table);
+                return (EXIT_FAILURE);
+        }
+        for (iter = layers; iter != NULL; iter = (DxfLayer *) iter->next)
+        {
+                if (iter->layer_name == NULL)
+                {
+                        continue;
+                }
+                slot = dxf_color_table_hash (iter->layer_name) & (table->number_of_slots - 1);
+                while ((table->layer_name[slot] != NULL)
+                  && (strcasecmp (table->layer_name[slot], iter->layer_name) != 0))
+                {
+                        slot = (slot + 1) & (table->number_of_slots - 1);
+                }
+                if (table->layer_name[slot] != NULL)
+                {
+                        /* A duplicate layer name. */
+                        continue;
+                }
+                table->layer_name[slot] = strdup (iter->layer_name);
+                RGB = dxf_ACI_get_RGB (iter->color);
+                table->layer_RGB[slot] = (RGB == DXF_ERROR) ? dxf_ACI_get_RGB (DXF_COLOR_WHITE) : RGB;
+                table->number_of_layers++;
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Get the color of a layer from a \c DxfColorTable.
+ *
+ * Layer names are compared case insensitive.
+ *
+ * \return the hexadecimal triplet of the layer color, or the default
+ * color of the table for an unknown layer.
+ */
+int
+dxf_color_table_get_layer_RGB
+(
+        DxfColorTable *table,
+                /*!< a pointer to the color table. */
+        const char *layer_name
+                /*!< the name of the layer, \c NULL is taken as layer
+                 * "0". */
+)
+{
+        unsigned int slot;
+
+        /* Do some basic checks. */
+        if (table == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (DXF_ERROR);
+        }
+        if (table->number_of_slots == 0)
+        {
+                return (table->default_RGB);
+        }
+        if (layer_name == NULL)
+        {
+                layer_name = DXF_DEFAULT_LAYER;
+        }
+        slot = dxf_color_table_hash (layer_name) & (table->number_of_slots - 1);
+        while (table->layer_name[slot] != NULL)
+        {
+                if (strcasecmp (table->layer_name[slot], layer_name) == 0)
+                {
+                        return (table->layer_RGB[slot]);
+                }
+                slot = (slot + 1) & (table->number_of_slots - 1);
+        }
+        return (table->default_RGB);
+}
+
+
+/*!
+ * \brief Resolve the effective color of an entity.
+ *
+ * A true color (group code 420) takes precedence over the color number
+ * (group code 62).\n
+ * \c BYLAYER is resolved through the layer colors in \c table,
+ * \c BYBLOCK gets the color \c block_RGB of the inserting block
+ * reference.
+ *
+ * \note A true color of 0x000000 (black) can not be told apart from an
+ * absent true color, since entities are initialised with a
+ * \c color_value of 0.
+ *
+ * \return the hexadecimal triplet of the effective color.
+ */
+int
+dxf_color_table_resolve
+(
+        DxfColorTable *table,
+                /*!< a pointer to the color table. */
+        int color,
+                /*!< the color number of the entity (group code 62). */
+        long color_value,
+                /*!< the true color of the entity (group code 420). */
+        const char *layer_name,
+                /*!< the layer of the entity (group code 8). */
+        int block_RGB
+                /*!< the hexadecimal triplet for \c BYBLOCK colors. */
+)
+{
+        int RGB;
+
+        if (color_value > 0)
+        {
+                return ((int) (color_value & 0xFFFFFF));
+        }
+        if (color == DXF_COLOR_BYLAYER)
+        {
+                return (dxf_color_table_get_layer_RGB (table, layer_name));
+        }
+        if (color == DXF_COLOR_BYBLOCK)
+        {
+                return (block_RGB);
+        }
+        RGB = dxf_ACI_get_RGB (color);
+        if (RGB == DXF_ERROR)
+        {
+                RGB = (table == NULL) ? dxf_ACI_get_RGB (DXF_COLOR_WHITE) : table->default_RGB;
+        }
+        return (RGB);
+}
+
+
+/*!
+ * \brief Resolve the effective colors of a batch of entities.
+ *
+ * The color numbers, true colors and layer names of the entities are
+ * passed as parallel arrays, \c color_value may be \c NULL when no
+ * entity has a true color.\n
+ * Consecutive entities on the same layer (the common case) reuse the
+ * previous layer lookup.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_color_table_resolve_batch
+(
+        DxfColorTable *table,
+                /*!< a pointer to the color table. */
+        const int *color,
+                /*!< array of color numbers (group code 62). */
+        const long *color_value,
+                /*!< array of true colors (group code 420), or \c NULL. */
+        char **layer_name,
+                /*!< array of layer names (group code 8). */
+        int number_of_entities,
+                /*!< number of entities in the arrays. */
+        int block_RGB,
+                /*!< the hexadecimal triplet for \c BYBLOCK colors. */
+        int *RGB
+                /*!< array receiving the hexadecimal triplets. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        const char *previous_layer_name = NULL;
+        int previous_layer_RGB;
+        int i;
+
+        /* Do some basic checks. */
+        if ((table == NULL) || (color == NULL) || (layer_name == NULL) || (RGB == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        previous_layer_RGB = table->default_RGB;
+        for (i = 0; i < number_of_entities; i++)
+        {
+                if ((color_value != NULL) && (color_value[i] > 0))
+                {
+                        RGB[i] = (int) (color_value[i] & 0xFFFFFF);
+                }
+                else if (color[i] == DXF_COLOR_BYLAYER)
+                {
+                        if ((previous_layer_name == NULL)
+                          || (layer_name[i] == NULL)
+                          || ((layer_name[i] != previous_layer_name)
+                            && (strcmp (layer_name[i], previous_layer_name) != 0)))
+                        {
+                                previous_layer_name = layer_name[i];
+                                previous_layer_RGB = dxf_color_table_get_layer_RGB (table, layer_name[i]);
+                        }
+                        RGB[i] = previous_layer_RGB;
+                }
+                else
+                {
+                        RGB[i] = dxf_color_table_resolve (table, color[i], 0, layer_name[i], block_RGB);
+                }
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Clear the contents of a \c DxfColorTable, the table itself is
+ * not freed.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_color_table_clear
+(
+        DxfColorTable *table
+                /*!< a pointer to the color table. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        int i;
+
+        /* Do some basic checks. */
+        if (table == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (table->layer_name != NULL)
+        {
+                for (i = 0; i < table->number_of_slots; i++)
+                {
+                        free (table->layer_name[i]);
+                }
+        }
+        free (table->layer_name);
+        free (table->layer_RGB);
+        table->layer_name = NULL;
+        table->layer_RGB = NULL;
+        table->number_of_layers = 0;
+        table->number_of_slots = 0;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Free the allocated memory for a \c DxfColorTable and all it's
+ * data fields.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_color_table_free
+(
+        DxfColorTable *table
+                /*!< a pointer to the color table. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (table == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_color_table_clear (table);
+        free (table);
+        table = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Sort the AutoCAD Color Index (ACI) colors into the grid for
+ * the nearest color lookup, called once through pthread_once ().
+ *
+ * Color number 0 (\c BYBLOCK) is left out.
+ */
+static void
+dxf_ACI_grid_build ()
+{
+        int count[DXF_ACI_GRID_SIZE * DXF_ACI_GRID_SIZE * DXF_ACI_GRID_SIZE];
+        int cell_index;
+        int color;
+        int i;
+
+        memset (count, 0, sizeof (count));
+        for (color = 1; color < DXF_COLOR_INDEX_MAX_NUMBER_OF_COLORS; color++)
+        {
+                cell_index = (((dxf_ACI_RGB[color][0] >> DXF_ACI_GRID_SHIFT) * DXF_ACI_GRID_SIZE
+                  + (dxf_ACI_RGB[color][1] >> DXF_ACI_GRID_SHIFT)) * DXF_ACI_GRID_SIZE)
+                  + (dxf_ACI_RGB[color][2] >> DXF_ACI_GRID_SHIFT);
+                count[cell_index]++;
+        }
+        dxf_ACI_grid_start[0] = 0;
+        for (i = 0; i < DXF_ACI_GRID_SIZE * DXF_ACI_GRID_SIZE * DXF_ACI_GRID_SIZE; i++)
+        {
+                dxf_ACI_grid_start[i + 1] = dxf_ACI_grid_start[i] + count[i];
+                count[i] = dxf_ACI_grid_start[i];
+        }
+        for (color = 1; color < DXF_COLOR_INDEX_MAX_NUMBER_OF_COLORS; color++)
+        {
+                cell_index = (((dxf_ACI_RGB[color][0] >> DXF_ACI_GRID_SHIFT) * DXF_ACI_GRID_SIZE
+                  + (dxf_ACI_RGB[color][1] >> DXF_ACI_GRID_SHIFT)) * DXF_ACI_GRID_SIZE)
+                  + (dxf_ACI_RGB[color][2] >> DXF_ACI_GRID_SHIFT);
+                dxf_ACI_grid_colors[count[cell_index]] = color;
+                count[cell_index]++;
+        }
+}
+
+
+/*!
+ * \brief Case insensitive FNV-1a hash of a layer name.
+ */
+static unsigned int
+dxf_color_table_hash
+(
+        const char *layer_name
+                /*!< the name of the layer. */
+)
+{
+        unsigned int hash = 2166136261u;
+
+        while (*layer_name != '\0')
+        {
+                hash ^= (unsigned char) toupper ((unsigned char) *layer_name);
+                hash *= 16777619u;
+                layer_name++;
+        }
+        return (hash);
+}
+
+
 /* EOF */
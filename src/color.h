@@ -48,6 +48,7 @@
 
 
 #include "global.h"
+#include "layer.h"
 
 
 #ifdef __cplusplus
@@ -76,6 +77,34 @@ typedef struct
 } DxfRGBColor;
 
 
+/*!
+ * \brief DXF definition of a lookup table for the effective color of
+ * entities.
+ *
+ * The colors of all layers are resolved once to a hexadecimal triplet
+ * and stored in an open addressing hash table on the (case insensitive)
+ * layer name, so resolving a \c BYLAYER color takes a single hash
+ * lookup.
+ */
+typedef struct
+dxf_color_table_struct
+{
+        int number_of_layers;
+                /*!< Number of layers in the table. */
+        int number_of_slots;
+                /*!< Number of slots in the hash table, a power of 2. */
+        char **layer_name;
+                /*!< Layer name in each slot, \c NULL for an empty
+                 * slot. */
+        int *layer_RGB;
+                /*!< Hexadecimal triplet of the color of the layer in
+                 * each slot. */
+        int default_RGB;
+                /*!< Hexadecimal triplet for entities on an unknown
+                 * layer. */
+} DxfColorTable;
+
+
 char *dxf_RGB_color_get_name (int RGB_color_hex_triplet);
 DxfRGBColor *dxf_RGB_color_new ();
 DxfRGBColor *dxf_RGB_color_set (int red, int green, int blue);
@@ -83,6 +112,16 @@ int dxf_ACI_init (DxfRGBColor *ACI[DXF_COLOR_INDEX_MAX_NUMBER_OF_COLORS]);
 int dxf_RGB_to_triplet (int red, int green, int blue);
 int dxf_RGB_color_free (DxfRGBColor *RGB_color);
 void dxf_RGB_color_free_list (DxfRGBColor *colors);
+int dxf_ACI_get_RGB (int color);
+int dxf_ACI_get_nearest (int RGB_color_hex_triplet);
+DxfColorTable *dxf_color_table_new ();
+DxfColorTable *dxf_color_table_init (DxfColorTable *table);
+int dxf_color_table_build (DxfColorTable *table, DxfLayer *layers);
+int dxf_color_table_get_layer_RGB (DxfColorTable *table, const char *layer_name);
+int dxf_color_table_resolve (DxfColorTable *table, int color, long color_value, const char *layer_name, int block_RGB);
+int dxf_color_table_resolve_batch (DxfColorTable *table, const int *color, const long *color_value, char **layer_name, int number_of_entities, int block_RGB, int *RGB);
+int dxf_color_table_clear (DxfColorTable *table);
+int dxf_color_table_free (DxfColorTable *table);
 
 
 #ifdef __cplusplus
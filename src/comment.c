@@ -41,6 +41,7 @@
  */
 
 #include "comment.h"
+#include "util.h"
 
 /*!
  * \brief Allocate memory for a DXF \c COMMENT.
@@ -110,7 +111,7 @@ dxf_comment_init
                 return (NULL);
         }
         dxf_comment_set_id_code (comment, 0);
-        dxf_comment_set_value (comment, strdup (""));
+        comment->value = dxf_string_share ("");
         dxf_comment_set_next (comment, NULL);
 #ifdef DEBUG
         DXF_DEBUG_END
@@ -201,7 +202,7 @@ dxf_comment_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (dxf_comment_get_value (comment));
+        dxf_string_free (comment->value);
         free (comment);
         comment = NULL;
 #ifdef DEBUG
@@ -370,6 +371,8 @@ dxf_comment_set_value
 #ifdef DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         if (comment == NULL)
         {
                 fprintf (stderr,
@@ -384,7 +387,13 @@ dxf_comment_set_value
                 __FUNCTION__);
               return (NULL);
         }
-        comment->value = strdup (value);
+        copy = dxf_string_share (value);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (comment->value);
+        comment->value = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
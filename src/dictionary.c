@@ -42,6 +42,7 @@
 
 
 #include "dictionary.h"
+#include "util.h"
 
 
 /*!
@@ -112,10 +113,10 @@ dxf_dictionary_init
                 return (NULL);
         }
         dxf_dictionary_set_id_code (dictionary, 0);
-        dxf_dictionary_set_dictionary_owner_soft (dictionary,  strdup (""));
-        dxf_dictionary_set_dictionary_owner_hard (dictionary,  strdup (""));
-        dxf_dictionary_set_entry_name (dictionary,  strdup (""));
-        dxf_dictionary_set_entry_object_handle (dictionary,  strdup (""));
+        dictionary->dictionary_owner_soft = dxf_string_share ("");
+        dictionary->dictionary_owner_hard = dxf_string_share ("");
+        dictionary->entry_name = dxf_string_share ("");
+        dictionary->entry_object_handle = dxf_string_share ("");
         dxf_dictionary_set_next (dictionary,  NULL);
 #if DEBUG
         DXF_DEBUG_END
@@ -190,8 +191,7 @@ dxf_dictionary_read
                 {
                         /* Now follows a string containing additional
                          * proprietary data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dictionary->entry_name);
+                        dxf_read_string (fp, &dictionary->entry_name);
                 }
                 if (strcmp (temp_string, "5") == 0)
                 {
@@ -218,22 +218,19 @@ dxf_dictionary_read
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dictionary->dictionary_owner_soft);
+                        dxf_read_string (fp, &dictionary->dictionary_owner_soft);
                 }
                 else if (strcmp (temp_string, "350") == 0)
                 {
                         /* Now follows a string containing a handle to ae
                          * entry object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dictionary->entry_object_handle);
+                        dxf_read_string (fp, &dictionary->entry_object_handle);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dictionary->dictionary_owner_hard);
+                        dxf_read_string (fp, &dictionary->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "999") == 0)
                 {
@@ -390,10 +387,10 @@ dxf_dictionary_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (dxf_dictionary_get_dictionary_owner_soft (dictionary));
-        free (dxf_dictionary_get_dictionary_owner_hard (dictionary));
-        free (dxf_dictionary_get_entry_name (dictionary));
-        free (dxf_dictionary_get_entry_object_handle (dictionary));
+        dxf_string_free (dictionary->dictionary_owner_soft);
+        dxf_string_free (dictionary->dictionary_owner_hard);
+        dxf_string_free (dictionary->entry_name);
+        dxf_string_free (dictionary->entry_object_handle);
         free (dictionary);
         dictionary = NULL;
 #if DEBUG
@@ -570,6 +567,8 @@ dxf_dictionary_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (dictionary == NULL)
         {
@@ -585,7 +584,13 @@ dxf_dictionary_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        dictionary->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (dictionary->dictionary_owner_soft);
+        dictionary->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -650,6 +655,8 @@ dxf_dictionary_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (dictionary == NULL)
         {
@@ -665,7 +672,13 @@ dxf_dictionary_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        dictionary->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (dictionary->dictionary_owner_hard);
+        dictionary->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -725,6 +738,8 @@ dxf_dictionary_set_entry_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (dictionary == NULL)
         {
@@ -740,7 +755,13 @@ dxf_dictionary_set_entry_name
                   __FUNCTION__);
                 return (NULL);
         }
-        dictionary->entry_name = strdup (entry_name);
+        copy = dxf_string_share (entry_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (dictionary->entry_name);
+        dictionary->entry_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -801,6 +822,8 @@ dxf_dictionary_set_entry_object_handle
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (dictionary == NULL)
         {
@@ -816,7 +839,13 @@ dxf_dictionary_set_entry_object_handle
                   __FUNCTION__);
                 return (NULL);
         }
-        dictionary->entry_object_handle = strdup (entry_object_handle);
+        copy = dxf_string_share (entry_object_handle);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (dictionary->entry_object_handle);
+        dictionary->entry_object_handle = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -0,0 +1,659 @@
+/*!
+ * \file dictionary_tree.c
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Functions for a hashed tree of DXF \c DICTIONARY objects
+ * (e.g. the named object dictionary).
+ *
+ * The \c DxfDictionary list is walked once, its entries are grouped per
+ * \c DICTIONARY and every dictionary gets its own hash table on entry
+ * name.\n
+ * Entries referring to another \c DICTIONARY are linked to it while
+ * building, so a path like "ACAD_LAYOUT/Layout1" is resolved with one
+ * hash lookup per path component.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include "dictionary_tree.h"
+
+
+/*!
+ * \brief A \c DxfDictionary in the list, with its position to keep the
+ * sort stable.
+ */
+typedef struct
+dxf_dictionary_tree_record_struct
+{
+        unsigned int handle;
+        int position;
+        DxfDictionary *dictionary;
+} DxfDictionaryTreeRecord;
+
+
+static int dxf_dictionary_tree_compare_records (const void *a, const void *b);
+static unsigned int dxf_dictionary_tree_hash (const char *name, size_t length);
+static DxfDictionaryTreeEntry *dxf_dictionary_tree_find (DxfDictionaryTree *tree, DxfDictionaryTreeNode *node, const char *name, size_t length);
+
+
+/*!
+ * \brief Allocate memory for a \c DxfDictionaryTree.
+ *
+ * Fill the memory contents with zeros.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfDictionaryTree *
+dxf_dictionary_tree_new ()
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfDictionaryTree *tree = NULL;
+        size_t size;
+
+        size = sizeof (DxfDictionaryTree);
+        /* avoid malloc of 0 bytes */
+        if (size == 0) size = 1;
+        if ((tree = malloc (size)) == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                tree = NULL;
+        }
+        else
+        {
+                memset (tree, 0, size);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (tree);
+}
+
+
+/*!
+ * \brief Allocate memory and initialize data fields in a
+ * \c DxfDictionaryTree.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfDictionaryTree *
+dxf_dictionary_tree_init
+(
+        DxfDictionaryTree *tree
+                /*!< a pointer to the tree. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (tree == NULL)
+        {
+                fprintf (stderr,
+                  (_("Warning in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                tree = dxf_dictionary_tree_new ();
+        }
+        if (tree == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        tree->number_of_nodes = 0;
+        tree->nodes = NULL;
+        tree->number_of_entries = 0;
+        tree->entries = NULL;
+        tree->number_of_slots = 0;
+        tree->slots = NULL;
+        tree->root = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (tree);
+}
+
+
+/*!
+ * \brief Build a \c DxfDictionaryTree from a list of \c DxfDictionary.
+ *
+ * All \c DxfDictionary with the same handle (id_code) are taken as the
+ * entries of a single \c DICTIONARY, a \c DxfDictionary without an
+ * entry name only adds the (empty) dictionary.\n
+ * When a dictionary holds an entry name more than once, the last entry
+ * is found.\n
+ * Any previous contents of the tree are cleared.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_dictionary_tree_build
+(
+        DxfDictionaryTree *tree,
+                /*!< a pointer to the tree. */
+        DxfDictionary *dictionaries
+                /*!< a pointer to the first \c DxfDictionary of a list. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfDictionaryTreeRecord *records = NULL;
+        DxfDictionaryTreeNode *node = NULL;
+        DxfDictionaryTreeEntry *entry = NULL;
+        DxfDictionary *iter = NULL;
+        unsigned int slot;
+        int number_of_records;
+        int i;
+        int j;
+
+        /* Do some basic checks. */
+        if (tree == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_dictionary_tree_clear (tree);
+        number_of_records = 0;
+        for (iter = dictionaries; iter != NULL; iter = (DxfDictionary *) iter->next)
+        {
+                number_of_records++;
+        }
+        if (number_of_records == 0)
+        {
+                return (EXIT_SUCCESS);
+        }
+        records = malloc (number_of_records * sizeof (DxfDictionaryTreeRecord));
+        if (records == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        i = 0;
+        for (iter = dictionaries; iter != NULL; iter = (DxfDictionary *) iter->next)
+        {
+                records[i].handle = (unsigned int) iter->id_code;
+                records[i].position = i;
+                records[i].dictionary = iter;
+                i++;
+        }
+        qsort (records, number_of_records, sizeof (DxfDictionaryTreeRecord),
+          dxf_dictionary_tree_compare_records);
+        /* Count the dictionaries and the entries. */
+        for (i = 0; i < number_of_records; i++)
+        {
+                if ((i == 0) || (records[i].handle != records[i - 1].handle))
+                {
+                        tree->number_of_nodes++;
+                }
+                if ((records[i].dictionary->entry_name != NULL)
+                  && (records[i].dictionary->entry_name[0] != '\0'))
+                {
+                        tree->number_of_entries++;
+                }
+        }
+        tree->nodes = malloc (tree->number_of_nodes * sizeof (DxfDictionaryTreeNode));
+        tree->entries = malloc (((tree->number_of_entries > 0) ? tree->number_of_entries : 1) * sizeof (DxfDictionaryTreeEntry));
+        if ((tree->nodes == NULL) || (tree->entries == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                free (records);
+                dxf_dictionary_tree_clear (tree);
+                return (EXIT_FAILURE);
+        }
+        /* Fill the dictionaries and their entries. */
+        node = NULL;
+        tree->number_of_entries = 0;
+        for (i = 0; i < number_of_records; i++)
+        {
+                if ((i == 0) || (records[i].handle != records[i - 1].handle))
+                {
+                        node = (node == NULL) ? tree->nodes : node + 1;
+                        node->handle = records[i].handle;
+                        node->dictionary = records[i].dictionary;
+                        node->parent = NULL;
+                        node->first_entry = tree->number_of_entries;
+                        node->number_of_entries = 0;
+                        node->first_slot = tree->number_of_slots;
+                        node->number_of_slots = 0;
+                }
+                if ((records[i].dictionary->entry_name == NULL)
+                  || (records[i].dictionary->entry_name[0] == '\0'))
+                {
+                        continue;
+                }
+                entry = &tree->entries[tree->number_of_entries];
+                entry->name = records[i].dictionary->entry_name;
+                entry->handle = (records[i].dictionary->entry_object_handle == NULL)
+                  ? 0
+                  : (unsigned int) strtoul (records[i].dictionary->entry_object_handle, NULL, 16);
+                entry->child = NULL;
+                tree->number_of_entries++;
+                node->number_of_entries++;
+        }
+        free (records);
+        /* Size the hash tables for a load factor of at most 0.5. */
+        for (i = 0; i < tree->number_of_nodes; i++)
+        {
+                node = &tree->nodes[i];
+                node->first_slot = tree->number_of_slots;
+                if (node->number_of_entries > 0)
+                {
+                        node->number_of_slots = 1;
+                        while (node->number_of_slots < 2 * node->number_of_entries)
+                        {
+                                node->number_of_slots *= 2;
+                        }
+                }
+                tree->number_of_slots += node->number_of_slots;
+        }
+        tree->slots = malloc (((tree->number_of_slots > 0) ? tree->number_of_slots : 1) * sizeof (int));
+        if (tree->slots == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                dxf_dictionary_tree_clear (tree);
+                return (EXIT_FAILURE);
+        }
+        for (i = 0; i < tree->number_of_slots; i++)
+        {
+                tree->slots[i] = -1;
+        }
+        for (i = 0; i < tree->number_of_nodes; i++)
+        {
+                node = &tree->nodes[i];
+                for (j = 0; j < node->number_of_entries; j++)
+                {
+                        entry = &tree->entries[node->first_entry + j];
+                        slot = dxf_dictionary_tree_hash (entry->name, strlen (entry->name))
+                          & (node->number_of_slots - 1);
+                        while ((tree->slots[node->first_slot + slot] != -1)
+                          && (strcasecmp (tree->entries[node->first_entry + tree->slots[node->first_slot + slot]].name, entry->name) != 0))
+                        {
+                                slot = (slot + 1) & (node->number_of_slots - 1);
+                        }
+                        /* A later entry with the same name replaces the
+                         * earlier one. */
+                        tree->slots[node->first_slot + slot] = j;
+                }
+        }
+        /* Link the entries referring to a dictionary. */
+        for (i = 0; i < tree->number_of_nodes; i++)
+        {
+                node = &tree->nodes[i];
+                for (j = 0; j < node->number_of_entries; j++)
+                {
+                        entry = &tree->entries[node->first_entry + j];
+                        entry->child = dxf_dictionary_tree_get_node (tree, entry->handle);
+                        if (entry->child == node)
+                        {
+                                entry->child = NULL;
+                        }
+                        if ((entry->child != NULL) && (entry->child->parent == NULL))
+                        {
+                                entry->child->parent = node;
+                        }
+                }
+        }
+        for (i = 0; i < tree->number_of_nodes; i++)
+        {
+                if (tree->nodes[i].parent == NULL)
+                {
+                        tree->root = &tree->nodes[i];
+                        break;
+                }
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Get the dictionary with the given handle from a
+ * \c DxfDictionaryTree.
+ *
+ * \return a pointer to the dictionary, or \c NULL when the tree holds
+ * no dictionary with the handle.
+ */
+DxfDictionaryTreeNode *
+dxf_dictionary_tree_get_node
+(
+        DxfDictionaryTree *tree,
+                /*!< a pointer to the tree. */
+        unsigned int handle
+                /*!< the handle of the dictionary. */
+)
+{
+        int low;
+        int high;
+        int middle;
+
+        /* Do some basic checks. */
+        if (tree == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        low = 0;
+        high = tree->number_of_nodes - 1;
+        while (low <= high)
+        {
+                middle = low + ((high - low) / 2);
+                if (tree->nodes[middle].handle == handle)
+                {
+                        return (&tree->nodes[middle]);
+                }
+                if (tree->nodes[middle].handle < handle)
+                {
+                        low = middle + 1;
+                }
+                else
+                {
+                        high = middle - 1;
+                }
+        }
+        return (NULL);
+}
+
+
+/*!
+ * \brief Get an entry of a dictionary in a \c DxfDictionaryTree.
+ *
+ * Entry names are compared case insensitive.
+ *
+ * \return a pointer to the entry, or \c NULL when the dictionary holds
+ * no entry with the name.
+ */
+DxfDictionaryTreeEntry *
+dxf_dictionary_tree_get_entry
+(
+        DxfDictionaryTree *tree,
+                /*!< a pointer to the tree. */
+        DxfDictionaryTreeNode *node,
+                /*!< a pointer to the dictionary, \c NULL for the root
+                 * dictionary. */
+        const char *name
+                /*!< the name of the entry. */
+)
+{
+        /* Do some basic checks. */
+        if ((tree == NULL) || (name == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        return (dxf_dictionary_tree_find (tree,
+          (node == NULL) ? tree->root : node, name, strlen (name)));
+}
+
+
+/*!
+ * \brief Look up an entry by its path from the root dictionary, e.g.
+ * "ACAD_LAYOUT/Layout1".
+ *
+ * The entry names in the path are separated by
+ * \c DXF_DICTIONARY_TREE_PATH_SEPARATOR, empty names are skipped.\n
+ * Every entry but the last must refer to a dictionary.
+ *
+ * \return a pointer to the entry, or \c NULL when the path was not
+ * found.
+ */
+DxfDictionaryTreeEntry *
+dxf_dictionary_tree_lookup_path
+(
+        DxfDictionaryTree *tree,
+                /*!< a pointer to the tree. */
+        const char *path
+                /*!< the path of the entry. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfDictionaryTreeNode *node = NULL;
+        DxfDictionaryTreeEntry *entry = NULL;
+        const char *end = NULL;
+
+        /* Do some basic checks. */
+        if ((tree == NULL) || (path == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        node = tree->root;
+        while (*path != '\0')
+        {
+                if (*path == DXF_DICTIONARY_TREE_PATH_SEPARATOR)
+                {
+                        path++;
+                        continue;
+                }
+                /* The previous entry must be a dictionary. */
+                if (node == NULL)
+                {
+                        return (NULL);
+                }
+                end = strchr (path, DXF_DICTIONARY_TREE_PATH_SEPARATOR);
+                if (end == NULL)
+                {
+                        end = path + strlen (path);
+                }
+                entry = dxf_dictionary_tree_find (tree, node, path, end - path);
+                if (entry == NULL)
+                {
+                        return (NULL);
+                }
+                node = entry->child;
+                path = end;
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (entry);
+}
+
+
+/*!
+ * \brief Clear the contents of a \c DxfDictionaryTree, the tree itself
+ * is not freed.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_dictionary_tree_clear
+(
+        DxfDictionaryTree *tree
+                /*!< a pointer to the tree. */
+)
+{
+        /* Do some basic checks. */
+        if (tree == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        free (tree->nodes);
+        free (tree->entries);
+        free (tree->slots);
+        dxf_dictionary_tree_init (tree);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Free the allocated memory for a \c DxfDictionaryTree and all
+ * it's data fields.
+ *
+ * The \c DxfDictionary list the tree was built from is not freed.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_dictionary_tree_free
+(
+        DxfDictionaryTree *tree
+                /*!< a pointer to the tree. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (tree == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_dictionary_tree_clear (tree);
+        free (tree);
+        tree = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Compare two records on handle, and on position in the list for
+ * equal handles.
+ */
+static int
+dxf_dictionary_tree_compare_records
+(
+        const void *a,
+                /*!< a pointer to the first record. */
+        const void *b
+                /*!< a pointer to the second record. */
+)
+{
+        const DxfDictionaryTreeRecord *record_a = a;
+        const DxfDictionaryTreeRecord *record_b = b;
+
+        if (record_a->handle != record_b->handle)
+        {
+                return ((record_a->handle < record_b->handle) ? -1 : 1);
+        }
+        return (record_a->position - record_b->position);
+}
+
+
+/*!
+ * \brief Case insensitive FNV-1a hash of an entry name.
+ */
+static unsigned int
+dxf_dictionary_tree_hash
+(
+        const char *name,
+                /*!< the name of the entry. */
+        size_t length
+                /*!< the length of the name. */
+)
+{
+        unsigned int hash = 2166136261u;
+        size_t i;
+
+        for (i = 0; i < length; i++)
+        {
+                hash ^= (unsigned char) toupper ((unsigned char) name[i]);
+                hash *= 16777619u;
+        }
+        return (hash);
+}
+
+
+/*!
+ * \brief Find an entry in the hash table of a dictionary.
+ *
+ * \return a pointer to the entry, or \c NULL when not found.
+ */
+static DxfDictionaryTreeEntry *
+dxf_dictionary_tree_find
+(
+        DxfDictionaryTree *tree,
+                /*!< a pointer to the tree. */
+        DxfDictionaryTreeNode *node,
+                /*!< a pointer to the dictionary. */
+        const char *name,
+                /*!< the name of the entry, not necessarily terminated. */
+        size_t length
+                /*!< the length of the name. */
+)
+{
+        DxfDictionaryTreeEntry *entry = NULL;
+        unsigned int slot;
+        int index;
+
+        if ((node == NULL) || (node->number_of_slots == 0))
+        {
+                return (NULL);
+        }
+        slot = dxf_dictionary_tree_hash (name, length) & (node->number_of_slots - 1);
+        while ((index = tree->slots[node->first_slot + slot]) != -1)
+        {
+                entry = &tree->entries[node->first_entry + index];
+                if ((strncasecmp (entry->name, name, length) == 0)
+                  && (entry->name[length] == '\0'))
+                {
+                        return (entry);
+                }
+                slot = (slot + 1) & (node->number_of_slots - 1);
+        }
+        return (NULL);
+}
+
+
+/* EOF */
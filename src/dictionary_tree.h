@@ -0,0 +1,158 @@
+/*!
+ * \file dictionary_tree.h
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Header file for a hashed tree of DXF \c DICTIONARY objects
+ * (e.g. the named object dictionary).
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#ifndef LIBDXF_SRC_DICTIONARY_TREE_H
+#define LIBDXF_SRC_DICTIONARY_TREE_H
+
+
+#include "global.h"
+#include "dictionary.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define DXF_DICTIONARY_TREE_PATH_SEPARATOR '/'
+        /*!< \brief Separator between the entry names in a path. */
+
+
+/*!
+ * \brief Definition of a single entry of a \c DICTIONARY in a
+ * \c DxfDictionaryTree.
+ */
+typedef struct
+dxf_dictionary_tree_entry_struct
+{
+        char *name;
+                /*!< Entry name, borrowed from the \c DxfDictionary
+                 * list.\n
+                 * Group code = 3. */
+        unsigned int handle;
+                /*!< Handle of the entry object.\n
+                 * Group code = 350. */
+        struct dxf_dictionary_tree_node_struct *child;
+                /*!< The dictionary the entry refers to, or \c NULL when
+                 * the entry object is not a \c DICTIONARY. */
+} DxfDictionaryTreeEntry;
+
+
+/*!
+ * \brief Definition of a single \c DICTIONARY in a
+ * \c DxfDictionaryTree.
+ *
+ * The entries are found through an open addressing hash table on the
+ * case insensitive entry name.
+ */
+typedef struct
+dxf_dictionary_tree_node_struct
+{
+        unsigned int handle;
+                /*!< Handle of the dictionary.\n
+                 * Group code = 5. */
+        DxfDictionary *dictionary;
+                /*!< The first \c DxfDictionary of the dictionary in the
+                 * list. */
+        struct dxf_dictionary_tree_node_struct *parent;
+                /*!< The dictionary owning this dictionary, or \c NULL
+                 * for a dictionary without an owner in the tree. */
+        int first_entry;
+                /*!< Index of the first entry of the dictionary in the
+                 * entries of the tree. */
+        int number_of_entries;
+                /*!< Number of entries of the dictionary. */
+        int first_slot;
+                /*!< Index of the first hash slot of the dictionary in
+                 * the slots of the tree. */
+        int number_of_slots;
+                /*!< Number of hash slots, a power of 2 (or 0). */
+} DxfDictionaryTreeNode;
+
+
+/*!
+ * \brief Definition of a tree of DXF \c DICTIONARY objects.
+ *
+ * A \c DxfDictionary holds a single entry, consecutive
+ * \c DxfDictionary with the same handle (id_code) in a list are the
+ * entries of a single \c DICTIONARY.\n
+ * The tree holds one node per \c DICTIONARY, sorted on handle, with
+ * the entries of each node in a contiguous range and the entries
+ * referring to another \c DICTIONARY linked to its node.\n
+ * The tree borrows the strings of the \c DxfDictionary list, which
+ * must not be freed while the tree is in use.
+ */
+typedef struct
+dxf_dictionary_tree_struct
+{
+        int number_of_nodes;
+                /*!< Number of dictionaries. */
+        DxfDictionaryTreeNode *nodes;
+                /*!< The dictionaries, in ascending order of handle. */
+        int number_of_entries;
+                /*!< Number of entries in all dictionaries. */
+        DxfDictionaryTreeEntry *entries;
+                /*!< The entries of all dictionaries. */
+        int number_of_slots;
+                /*!< Number of hash slots of all dictionaries. */
+        int *slots;
+                /*!< Hash slots of all dictionaries, holding an index
+                 * relative to the first entry of the dictionary, or -1
+                 * for an empty slot. */
+        DxfDictionaryTreeNode *root;
+                /*!< The named object dictionary, the first dictionary
+                 * without an owner. */
+} DxfDictionaryTree;
+
+
+DxfDictionaryTree *dxf_dictionary_tree_new ();
+DxfDictionaryTree *dxf_dictionary_tree_init (DxfDictionaryTree *tree);
+int dxf_dictionary_tree_build (DxfDictionaryTree *tree, DxfDictionary *dictionaries);
+DxfDictionaryTreeNode *dxf_dictionary_tree_get_node (DxfDictionaryTree *tree, unsigned int handle);
+DxfDictionaryTreeEntry *dxf_dictionary_tree_get_entry (DxfDictionaryTree *tree, DxfDictionaryTreeNode *node, const char *name);
+DxfDictionaryTreeEntry *dxf_dictionary_tree_lookup_path (DxfDictionaryTree *tree, const char *path);
+int dxf_dictionary_tree_clear (DxfDictionaryTree *tree);
+int dxf_dictionary_tree_free (DxfDictionaryTree *tree);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* LIBDXF_SRC_DICTIONARY_TREE_H */
+
+
+/* EOF */
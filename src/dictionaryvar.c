@@ -42,6 +42,7 @@
 
 
 #include "dictionaryvar.h"
+#include "util.h"
 
 
 /*!
@@ -112,10 +113,10 @@ dxf_dictionaryvar_init
                 return (NULL);
         }
         dxf_dictionaryvar_set_id_code (dictionaryvar, 0);
-        dxf_dictionaryvar_set_value (dictionaryvar, strdup (""));
-        dxf_dictionaryvar_set_object_schema_number (dictionaryvar, strdup (""));
-        dxf_dictionaryvar_set_dictionary_owner_soft (dictionaryvar, strdup (""));
-        dxf_dictionaryvar_set_dictionary_owner_hard (dictionaryvar, strdup (""));
+        dictionaryvar->value = dxf_string_share ("");
+        dictionaryvar->object_schema_number = dxf_string_share ("");
+        dictionaryvar->dictionary_owner_soft = dxf_string_share ("");
+        dictionaryvar->dictionary_owner_hard = dxf_string_share ("");
         dxf_dictionaryvar_set_next (dictionaryvar, NULL);
 #if DEBUG
         DXF_DEBUG_END
@@ -190,8 +191,7 @@ dxf_dictionaryvar_read
                 {
                         /* Now follows a string containing additional
                          * proprietary data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dictionaryvar->value);
+                        dxf_read_string (fp, &dictionaryvar->value);
                 }
                 if (strcmp (temp_string, "5") == 0)
                 {
@@ -218,22 +218,19 @@ dxf_dictionaryvar_read
                 {
                         /* Now follows a string containing a handle to ae
                          * entry object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dictionaryvar->object_schema_number);
+                        dxf_read_string (fp, &dictionaryvar->object_schema_number);
                 }
                 else if (strcmp (temp_string, "330") == 0)
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dictionaryvar->dictionary_owner_soft);
+                        dxf_read_string (fp, &dictionaryvar->dictionary_owner_soft);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dictionaryvar->dictionary_owner_hard);
+                        dxf_read_string (fp, &dictionaryvar->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "999") == 0)
                 {
@@ -393,10 +390,10 @@ dxf_dictionaryvar_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (dxf_dictionaryvar_get_dictionary_owner_soft (dictionaryvar));
-        free (dxf_dictionaryvar_get_dictionary_owner_hard (dictionaryvar));
-        free (dxf_dictionaryvar_get_value (dictionaryvar));
-        free (dxf_dictionaryvar_get_object_schema_number (dictionaryvar));
+        dxf_string_free (dictionaryvar->dictionary_owner_soft);
+        dxf_string_free (dictionaryvar->dictionary_owner_hard);
+        dxf_string_free (dictionaryvar->value);
+        dxf_string_free (dictionaryvar->object_schema_number);
         free (dictionaryvar);
         dictionaryvar = NULL;
 #if DEBUG
@@ -573,6 +570,8 @@ dxf_dictionaryvar_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (dictionaryvar == NULL)
         {
@@ -588,7 +587,13 @@ dxf_dictionaryvar_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        dictionaryvar->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (dictionaryvar->dictionary_owner_soft);
+        dictionaryvar->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -653,6 +658,8 @@ dxf_dictionaryvar_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (dictionaryvar == NULL)
         {
@@ -668,7 +675,13 @@ dxf_dictionaryvar_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        dictionaryvar->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (dictionaryvar->dictionary_owner_hard);
+        dictionaryvar->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -728,6 +741,8 @@ dxf_dictionaryvar_set_value
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (dictionaryvar == NULL)
         {
@@ -743,7 +758,13 @@ dxf_dictionaryvar_set_value
                   __FUNCTION__);
                 return (NULL);
         }
-        dictionaryvar->value = strdup (value);
+        copy = dxf_string_share (value);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (dictionaryvar->value);
+        dictionaryvar->value = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -806,6 +827,8 @@ dxf_dictionaryvar_set_object_schema_number
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (dictionaryvar == NULL)
         {
@@ -821,7 +844,13 @@ dxf_dictionaryvar_set_object_schema_number
                   __FUNCTION__);
                 return (NULL);
         }
-        dictionaryvar->object_schema_number = strdup (object_schema_number);
+        copy = dxf_string_share (object_schema_number);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (dictionaryvar->object_schema_number);
+        dictionaryvar->object_schema_number = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
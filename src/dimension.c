@@ -41,6 +41,8 @@
 
 
 #include "dimension.h"
+#include "stats.h"
+#include "util.h"
 
 
 /*!
@@ -73,6 +75,7 @@ dxf_dimension_new ()
         else
         {
                 memset (dimension, 0, size);
+                dxf_stats_count_allocation (DIMENSION, size);
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -115,8 +118,8 @@ dxf_dimension_init
               return (NULL);
         }
         dimension->id_code = 0;
-        dimension->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        dimension->layer = strdup (DXF_DEFAULT_LAYER);
+        dimension->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        dimension->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         dimension->elevation = 0.0;
         dimension->thickness = 0.0;
         dimension->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
@@ -125,52 +128,44 @@ dxf_dimension_init
         dimension->paperspace = DXF_PAPERSPACE;
         dimension->graphics_data_size = 0;
         dimension->shadow_mode = 0;
-        dimension->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_new ();
-        dimension->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_init (dimension->binary_graphics_data);
-        dimension->dictionary_owner_soft = strdup ("");
-        dimension->object_owner_soft = strdup ("");
-        dimension->material = strdup ("");
-        dimension->dictionary_owner_hard = strdup ("");
+        dimension->binary_graphics_data = NULL;
+        dimension->dictionary_owner_soft = dxf_string_share ("");
+        dimension->object_owner_soft = dxf_string_share ("");
+        dimension->material = dxf_string_share ("");
+        dimension->dictionary_owner_hard = dxf_string_share ("");
         dimension->lineweight = 0;
-        dimension->plot_style_name = strdup ("");
+        dimension->plot_style_name = dxf_string_share ("");
         dimension->color_value = 0;
-        dimension->color_name = strdup ("");
+        dimension->color_name = dxf_string_share ("");
         dimension->transparency = 0;
-        dimension->dim_text = strdup ("");
-        dimension->dimblock_name = strdup ("");
-        dimension->dimstyle_name = strdup ("");
+        dimension->dim_text = dxf_string_share ("");
+        dimension->dimblock_name = dxf_string_share ("");
+        dimension->dimstyle_name = dxf_string_share ("");
         dimension->p0 = dxf_point_new ();
-        dimension->p0 = dxf_point_init (dimension->p0);
         dimension->p0->x0 = 0.0;
         dimension->p0->y0 = 0.0;
         dimension->p0->z0 = 0.0;
         dimension->p1 = dxf_point_new ();
-        dimension->p1 = dxf_point_init (dimension->p1);
         dimension->p1->x0 = 0.0;
         dimension->p1->y0 = 0.0;
         dimension->p1->z0 = 0.0;
         dimension->p2 = dxf_point_new ();
-        dimension->p2 = dxf_point_init (dimension->p2);
         dimension->p2->x0 = 0.0;
         dimension->p2->y0 = 0.0;
         dimension->p2->z0 = 0.0;
         dimension->p3 = dxf_point_new ();
-        dimension->p3 = dxf_point_init (dimension->p3);
         dimension->p3->x0 = 0.0;
         dimension->p3->y0 = 0.0;
         dimension->p3->z0 = 0.0;
         dimension->p4 = dxf_point_new ();
-        dimension->p4 = dxf_point_init (dimension->p4);
         dimension->p4->x0 = 0.0;
         dimension->p4->y0 = 0.0;
         dimension->p4->z0 = 0.0;
         dimension->p5 = dxf_point_new ();
-        dimension->p5 = dxf_point_init (dimension->p6);
         dimension->p5->x0 = 0.0;
         dimension->p5->y0 = 0.0;
         dimension->p5->z0 = 0.0;
         dimension->p6 = dxf_point_new ();
-        dimension->p6 = dxf_point_init (dimension->p6);
         dimension->p6->x0 = 0.0;
         dimension->p6->y0 = 0.0;
         dimension->p6->z0 = 0.0;
@@ -261,22 +256,19 @@ dxf_dimension_read
                 {
                         /* Now follows a string containing a dimension
                          * text string. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dimension->dim_text);
+                        dxf_read_string (fp, &dimension->dim_text);
                 }
                 if (strcmp (temp_string, "2") == 0)
                 {
                         /* Now follows a string containing a dimension
                          * block name string. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dimension->dimblock_name);
+                        dxf_read_string (fp, &dimension->dimblock_name);
                 }
                 if (strcmp (temp_string, "3") == 0)
                 {
                         /* Now follows a string containing a dimension
                          * style name string. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dimension->dimstyle_name);
+                        dxf_read_string (fp, &dimension->dimstyle_name);
                 }
                 if (strcmp (temp_string, "5") == 0)
                 {
@@ -289,14 +281,12 @@ dxf_dimension_read
                 {
                         /* Now follows a string containing a linetype
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dimension->linetype);
+                        dxf_read_string (fp, &dimension->linetype);
                 }
                 else if (strcmp (temp_string, "8") == 0)
                 {
                         /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dimension->layer);
+                        dxf_read_string (fp, &dimension->layer);
                 }
                 else if (strcmp (temp_string, "10") == 0)
                 {
@@ -650,10 +640,7 @@ dxf_dimension_read
                 {
                         /* Now follows a string containing binary
                          * graphics data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", iter310->data_line);
-                        dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) iter310->next);
-                        iter310 = (DxfBinaryGraphicsData *) iter310->next;
+                        iter310 = dxf_binary_graphics_data_read (fp, &dimension->binary_graphics_data, iter310);
                 }
                 else if (strcmp (temp_string, "330") == 0)
                 {
@@ -661,15 +648,13 @@ dxf_dimension_read
                         {
                                 /* Now follows a string containing a soft-pointer
                                  * ID/handle to owner dictionary. */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%s\n", dimension->dictionary_owner_soft);
+                                dxf_read_string (fp, &dimension->dictionary_owner_soft);
                         }
                         if (iter330 == 1)
                         {
                                 /* Now follows a string containing a soft-pointer
                                  * ID/handle to owner object. */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%s\n", dimension->object_owner_soft);
+                                dxf_read_string (fp, &dimension->object_owner_soft);
                         }
                         iter330++;
                 }
@@ -677,15 +662,13 @@ dxf_dimension_read
                 {
                         /* Now follows a string containing a
                          * hard-pointer ID/handle to material object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dimension->material);
+                        dxf_read_string (fp, &dimension->material);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dimension->dictionary_owner_hard);
+                        dxf_read_string (fp, &dimension->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "370") == 0)
                 {
@@ -698,8 +681,7 @@ dxf_dimension_read
                 {
                         /* Now follows a string containing a plot style
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dimension->plot_style_name);
+                        dxf_read_string (fp, &dimension->plot_style_name);
                 }
                 else if (strcmp (temp_string, "420") == 0)
                 {
@@ -711,8 +693,7 @@ dxf_dimension_read
                 {
                         /* Now follows a string containing a color
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dimension->color_name);
+                        dxf_read_string (fp, &dimension->color_name);
                 }
                 else if (strcmp (temp_string, "440") == 0)
                 {
@@ -811,7 +792,8 @@ dxf_dimension_write
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0")),
                   dxf_entity_name);
-                dimension->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (dimension->layer);
+                dimension->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Start writing output. */
         fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
@@ -1106,18 +1088,49 @@ dxf_dimension_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (dimension->linetype);
-        free (dimension->layer);
-        dxf_binary_graphics_data_free_list (dimension->binary_graphics_data);
-        free (dimension->dim_text);
-        free (dimension->dimblock_name);
-        free (dimension->dimstyle_name);
-        free (dimension->dictionary_owner_soft);
-        free (dimension->object_owner_soft);
-        free (dimension->material);
-        free (dimension->dictionary_owner_hard);
-        free (dimension->plot_style_name);
-        free (dimension->color_name);
+        dxf_string_free (dimension->linetype);
+        dxf_string_free (dimension->layer);
+        if (dimension->binary_graphics_data != NULL)
+        {
+                dxf_binary_graphics_data_free_list (dimension->binary_graphics_data);
+        }
+        dxf_string_free (dimension->dim_text);
+        dxf_string_free (dimension->dimblock_name);
+        dxf_string_free (dimension->dimstyle_name);
+        dxf_string_free (dimension->dictionary_owner_soft);
+        dxf_string_free (dimension->object_owner_soft);
+        dxf_string_free (dimension->material);
+        dxf_string_free (dimension->dictionary_owner_hard);
+        dxf_string_free (dimension->plot_style_name);
+        dxf_string_free (dimension->color_name);
+        if (dimension->p0 != NULL)
+        {
+                dxf_point_free (dimension->p0);
+        }
+        if (dimension->p1 != NULL)
+        {
+                dxf_point_free (dimension->p1);
+        }
+        if (dimension->p2 != NULL)
+        {
+                dxf_point_free (dimension->p2);
+        }
+        if (dimension->p3 != NULL)
+        {
+                dxf_point_free (dimension->p3);
+        }
+        if (dimension->p4 != NULL)
+        {
+                dxf_point_free (dimension->p4);
+        }
+        if (dimension->p5 != NULL)
+        {
+                dxf_point_free (dimension->p5);
+        }
+        if (dimension->p6 != NULL)
+        {
+                dxf_point_free (dimension->p6);
+        }
         free (dimension);
         dimension = NULL;
 #if DEBUG
@@ -1296,6 +1309,8 @@ dxf_dimension_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (dimension == NULL)
         {
@@ -1311,7 +1326,13 @@ dxf_dimension_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        dimension->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (dimension->linetype);
+        dimension->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1374,6 +1395,8 @@ dxf_dimension_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (dimension == NULL)
         {
@@ -1389,7 +1412,13 @@ dxf_dimension_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        dimension->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (dimension->layer);
+        dimension->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2193,6 +2222,8 @@ dxf_dimension_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (dimension == NULL)
         {
@@ -2208,7 +2239,13 @@ dxf_dimension_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        dimension->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (dimension->dictionary_owner_soft);
+        dimension->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2273,6 +2310,8 @@ dxf_dimension_set_object_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (dimension == NULL)
         {
@@ -2288,7 +2327,13 @@ dxf_dimension_set_object_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        dimension->object_owner_soft = strdup (object_owner_soft);
+        copy = dxf_string_share (object_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (dimension->object_owner_soft);
+        dimension->object_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2356,6 +2401,8 @@ dxf_dimension_set_material
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (dimension == NULL)
         {
@@ -2371,7 +2418,13 @@ dxf_dimension_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        dimension->material = strdup (material);
+        copy = dxf_string_share (material);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (dimension->material);
+        dimension->material = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2440,6 +2493,8 @@ dxf_dimension_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (dimension == NULL)
         {
@@ -2455,7 +2510,13 @@ dxf_dimension_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        dimension->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (dimension->dictionary_owner_hard);
+        dimension->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2585,6 +2646,8 @@ dxf_dimension_set_plot_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (dimension == NULL)
         {
@@ -2600,7 +2663,13 @@ dxf_dimension_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        dimension->plot_style_name = strdup (plot_style_name);
+        copy = dxf_string_share (plot_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (dimension->plot_style_name);
+        dimension->plot_style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2730,6 +2799,8 @@ dxf_dimension_set_color_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (dimension == NULL)
         {
@@ -2745,7 +2816,13 @@ dxf_dimension_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        dimension->color_name = strdup (color_name);
+        copy = dxf_string_share (color_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (dimension->color_name);
+        dimension->color_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2874,6 +2951,8 @@ dxf_dimension_set_dim_text
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (dimension == NULL)
         {
@@ -2889,7 +2968,13 @@ dxf_dimension_set_dim_text
                   __FUNCTION__);
                 return (NULL);
         }
-        dimension->dim_text = strdup (dim_text);
+        copy = dxf_string_share (dim_text);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (dimension->dim_text);
+        dimension->dim_text = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2953,6 +3038,8 @@ dxf_dimension_set_dimblock_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (dimension == NULL)
         {
@@ -2968,7 +3055,13 @@ dxf_dimension_set_dimblock_name
                   __FUNCTION__);
                 return (NULL);
         }
-        dimension->dimblock_name = strdup (dimblock_name);
+        copy = dxf_string_share (dimblock_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (dimension->dimblock_name);
+        dimension->dimblock_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -3032,6 +3125,8 @@ dxf_dimension_set_dimstyle_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (dimension == NULL)
         {
@@ -3047,7 +3142,13 @@ dxf_dimension_set_dimstyle_name
                   __FUNCTION__);
                 return (NULL);
         }
-        dimension->dimblock_name = strdup (dimstyle_name);
+        copy = dxf_string_share (dimstyle_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (dimension->dimblock_name);
+        dimension->dimblock_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
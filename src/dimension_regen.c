@@ -0,0 +1,1392 @@
+/*!
+ * \file dimension_regen.c
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Functions for the regeneration of the geometry of DXF
+ * dimensions (\c DIMENSION).
+ *
+ * The geometry of a dimension normally lives in an anonymous \c *D
+ * block, which is missing or stale when a dimension was created or
+ * modified by another application.\n
+ * The geometry is regenerated from the definition points and the
+ * resolved dimension style for linear, aligned, angular, radial,
+ * diametric and ordinate dimensions.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include <pthread.h>
+
+#include "dimension_regen.h"
+
+
+/*!
+ * \brief The sizes of a dimension style, scaled by \c DIMSCALE.
+ */
+typedef struct
+dxf_dimension_regen_sizes_struct
+{
+        double asz;
+                /*!< Arrow size. */
+        double exo;
+                /*!< Extension line offset. */
+        double exe;
+                /*!< Extension line extension. */
+        double txt;
+                /*!< Text height. */
+        double gap;
+                /*!< Gap around the text. */
+        double cen;
+                /*!< Size of the center mark. */
+        double tsz;
+                /*!< Tick size, 0.0 for arrows. */
+} DxfDimensionRegenSizes;
+
+
+/*!
+ * \brief Work item for a thread in a batch regeneration.
+ */
+typedef struct
+dxf_dimension_regen_job_struct
+{
+        DxfDimension **dimensions;
+                /*!< Array of pointers to the dimensions. */
+        DxfDimStyle **dimstyles;
+                /*!< Array of pointers to the resolved dimension
+                 * styles. */
+        DxfDimensionGeometry *geometries;
+                /*!< Array receiving the geometries. */
+        int begin;
+                /*!< First dimension of this job. */
+        int end;
+                /*!< One past the last dimension of this job. */
+} DxfDimensionRegenJob;
+
+
+static void dxf_dimension_regen_add_line (DxfDimensionGeometry *geometry, double x0, double y0, double x1, double y1, int color);
+static void dxf_dimension_regen_add_arrow (DxfDimensionGeometry *geometry, DxfDimensionRegenSizes *sizes, double x, double y, double dx, double dy, int color);
+static void dxf_dimension_regen_format (DxfDimension *dimension, DxfDimStyle *dimstyle, double value, DxfDimensionGeometry *geometry);
+static double dxf_dimension_regen_text_width (const char *text, double height);
+static double dxf_dimension_regen_readable_angle (double angle);
+static double dxf_dimension_regen_ccw_angle (double ax, double ay, double bx, double by);
+static double dxf_dimension_regen_text_angle (DxfDimension *dimension, DxfDimStyle *dimstyle, double line_angle);
+static void dxf_dimension_regen_place_text (DxfDimensionGeometry *geometry, DxfDimension *dimension, DxfDimStyle *dimstyle, DxfDimensionRegenSizes *sizes, double ax, double ay, double bx, double by);
+static int dxf_dimension_regen_linear (DxfDimension *dimension, DxfDimStyle *dimstyle, DxfDimensionRegenSizes *sizes, DxfDimensionGeometry *geometry);
+static int dxf_dimension_regen_radial (DxfDimension *dimension, DxfDimStyle *dimstyle, DxfDimensionRegenSizes *sizes, DxfDimensionGeometry *geometry);
+static int dxf_dimension_regen_angular (DxfDimension *dimension, DxfDimStyle *dimstyle, DxfDimensionRegenSizes *sizes, DxfDimensionGeometry *geometry);
+static int dxf_dimension_regen_ordinate (DxfDimension *dimension, DxfDimStyle *dimstyle, DxfDimensionRegenSizes *sizes, DxfDimensionGeometry *geometry);
+static void *dxf_dimension_regen_run_job (void *data);
+
+
+/*!
+ * \brief Regenerate the geometry of a DXF \c DIMENSION entity.
+ *
+ * The actual measurement of the dimension is updated, as is the middle
+ * point of the dimension text unless the text has been positioned at a
+ * user-defined location (bit value 128 of the dimension type).
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred or a definition point required for the dimension type is
+ * missing.
+ */
+int
+dxf_dimension_regen
+(
+        DxfDimension *dimension,
+                /*!< a pointer to a DXF \c DIMENSION entity. */
+        DxfDimStyle *dimstyle,
+                /*!< a pointer to the resolved dimension style. */
+        DxfDimensionGeometry *geometry
+                /*!< a pointer to the geometry receiving the result. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfDimensionRegenSizes sizes;
+        double scale;
+        int status;
+
+        /* Do some basic checks. */
+        if ((dimension == NULL) || (dimstyle == NULL) || (geometry == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        memset (geometry, 0, sizeof (DxfDimensionGeometry));
+        geometry->type = dimension->flag & 7;
+        scale = (dimstyle->dimscale > 0.0) ? dimstyle->dimscale : 1.0;
+        sizes.asz = dimstyle->dimasz * scale;
+        sizes.exo = dimstyle->dimexo * scale;
+        sizes.exe = dimstyle->dimexe * scale;
+        sizes.txt = dimstyle->dimtxt * scale;
+        sizes.gap = fabs (dimstyle->dimgap) * scale;
+        sizes.cen = dimstyle->dimcen * scale;
+        sizes.tsz = dimstyle->dimtsz * scale;
+        geometry->text_height = sizes.txt;
+        geometry->text_color = dimstyle->dimclrt;
+        switch (geometry->type)
+        {
+                case 0:
+                case 1:
+                        status = dxf_dimension_regen_linear (dimension,
+                          dimstyle, &sizes, geometry);
+                        break;
+                case 2:
+                case 5:
+                        status = dxf_dimension_regen_angular (dimension,
+                          dimstyle, &sizes, geometry);
+                        break;
+                case 3:
+                case 4:
+                        status = dxf_dimension_regen_radial (dimension,
+                          dimstyle, &sizes, geometry);
+                        break;
+                case 6:
+                        status = dxf_dimension_regen_ordinate (dimension,
+                          dimstyle, &sizes, geometry);
+                        break;
+                default:
+                        fprintf (stderr,
+                          (_("Error in %s () unknown dimension type %d.\n")),
+                          __FUNCTION__, geometry->type);
+                        status = EXIT_FAILURE;
+                        break;
+        }
+        geometry->status = status;
+        if (status != EXIT_SUCCESS)
+        {
+                return (EXIT_FAILURE);
+        }
+        dimension->actual_measurement = geometry->measurement;
+        if (((dimension->flag & 128) == 0) && (dimension->p1 != NULL))
+        {
+                dimension->p1->x0 = geometry->text_x;
+                dimension->p1->y0 = geometry->text_y;
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Regenerate the geometry of every DXF \c DIMENSION entity in a
+ * single linked list.
+ *
+ * The dimension styles are resolved through \c cache in the calling
+ * thread, then the dimensions are divided in equal chunks over
+ * \c number_of_threads threads, a value of 1 or less does all work in
+ * the calling thread.
+ *
+ * \return the number of dimensions processed (at most
+ * \c max_number_of_geometries), or \c DXF_ERROR when an error occurred.
+ */
+int
+dxf_dimension_regen_list
+(
+        DxfDimension *dimensions,
+                /*!< a pointer to a single linked list of DXF
+                 * \c DIMENSION entities. */
+        DxfDimStyleCache *cache,
+                /*!< a pointer to the dimension style cache. */
+        DxfDimensionGeometry *geometries,
+                /*!< array receiving a geometry per dimension. */
+        int max_number_of_geometries,
+                /*!< number of entries in \c geometries. */
+        int number_of_threads
+                /*!< number of threads to use. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfDimension *iter = NULL;
+        DxfDimension **items = NULL;
+        DxfDimStyle **dimstyles = NULL;
+        DxfDimensionRegenJob *jobs = NULL;
+        pthread_t *threads = NULL;
+        int *started = NULL;
+        size_t size;
+        int chunk;
+        int n;
+        int i;
+
+        /* Do some basic checks. */
+        if ((cache == NULL) || (geometries == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (DXF_ERROR);
+        }
+        size = (max_number_of_geometries > 0) ? max_number_of_geometries : 1;
+        items = malloc (size * sizeof (DxfDimension *));
+        dimstyles = malloc (size * sizeof (DxfDimStyle *));
+        if ((items == NULL) || (dimstyles == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                free (items);
+                free (dimstyles);
+                return (DXF_ERROR);
+        }
+        /* Random access to the dimensions for the threads, the cache
+         * is filled here as it is not safe to be shared. */
+        n = 0;
+        iter = dimensions;
+        while ((iter != NULL) && (n < max_number_of_geometries))
+        {
+                items[n] = iter;
+                dimstyles[n] = dxf_dimstyle_cache_get (cache,
+                  iter->dimstyle_name, NULL, 0);
+                n++;
+                iter = (DxfDimension *) iter->next;
+        }
+        if (n == 0)
+        {
+                free (items);
+                free (dimstyles);
+                return (0);
+        }
+        if (number_of_threads < 1)
+        {
+                number_of_threads = 1;
+        }
+        if (number_of_threads > n)
+        {
+                number_of_threads = n;
+        }
+        jobs = calloc (number_of_threads, sizeof (DxfDimensionRegenJob));
+        threads = calloc (number_of_threads, sizeof (pthread_t));
+        started = calloc (number_of_threads, sizeof (int));
+        if ((jobs == NULL) || (threads == NULL) || (started == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                free (items);
+                free (dimstyles);
+                free (jobs);
+                free (threads);
+                free (started);
+                return (DXF_ERROR);
+        }
+        chunk = (n + number_of_threads - 1) / number_of_threads;
+        for (i = 0; i < number_of_threads; i++)
+        {
+                jobs[i].dimensions = items;
+                jobs[i].dimstyles = dimstyles;
+                jobs[i].geometries = geometries;
+                jobs[i].begin = i * chunk;
+                jobs[i].end = ((i + 1) * chunk < n) ? (i + 1) * chunk : n;
+        }
+        /* The first chunk is done by the calling thread. */
+        for (i = 1; i < number_of_threads; i++)
+        {
+                if (pthread_create (&threads[i], NULL, dxf_dimension_regen_run_job, &jobs[i]) == 0)
+                {
+                        started[i] = TRUE;
+                }
+        }
+        dxf_dimension_regen_run_job (&jobs[0]);
+        for (i = 1; i < number_of_threads; i++)
+        {
+                if (started[i])
+                {
+                        pthread_join (threads[i], NULL);
+                }
+                else
+                {
+                        dxf_dimension_regen_run_job (&jobs[i]);
+                }
+        }
+        free (items);
+        free (dimstyles);
+        free (jobs);
+        free (threads);
+        free (started);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (n);
+}
+
+
+/*!
+ * \brief Add a line to the geometry, lines beyond
+ * \c DXF_DIMENSION_GEOMETRY_MAX_LINES are dropped.
+ */
+static void
+dxf_dimension_regen_add_line
+(
+        DxfDimensionGeometry *geometry,
+                /*!< a pointer to the geometry. */
+        double x0,
+                /*!< X-coordinate of the start point. */
+        double y0,
+                /*!< Y-coordinate of the start point. */
+        double x1,
+                /*!< X-coordinate of the end point. */
+        double y1,
+                /*!< Y-coordinate of the end point. */
+        int color
+                /*!< color of the line. */
+)
+{
+        DxfDimensionGeometryLine *line = NULL;
+
+        if (geometry->number_of_lines >= DXF_DIMENSION_GEOMETRY_MAX_LINES)
+        {
+                return;
+        }
+        line = &geometry->lines[geometry->number_of_lines];
+        line->x0 = x0;
+        line->y0 = y0;
+        line->x1 = x1;
+        line->y1 = y1;
+        line->color = color;
+        geometry->number_of_lines++;
+}
+
+
+/*!
+ * \brief Add an arrow head, or a tick when \c DIMTSZ is set, to the
+ * geometry.
+ */
+static void
+dxf_dimension_regen_add_arrow
+(
+        DxfDimensionGeometry *geometry,
+                /*!< a pointer to the geometry. */
+        DxfDimensionRegenSizes *sizes,
+                /*!< a pointer to the scaled sizes. */
+        double x,
+                /*!< X-coordinate of the tip. */
+        double y,
+                /*!< Y-coordinate of the tip. */
+        double dx,
+                /*!< X-component of the unit direction the arrow
+                 * points to. */
+        double dy,
+                /*!< Y-component of the unit direction the arrow
+                 * points to. */
+        int color
+                /*!< color of the arrow. */
+)
+{
+        DxfDimensionGeometryArrow *arrow = NULL;
+        double half_width;
+        double tx;
+        double ty;
+
+        if (sizes->tsz > 0.0)
+        {
+                /* An oblique stroke at 45 degrees. */
+                tx = (dx - dy) * M_SQRT1_2 * sizes->tsz / 2.0;
+                ty = (dy + dx) * M_SQRT1_2 * sizes->tsz / 2.0;
+                dxf_dimension_regen_add_line (geometry, x - tx, y - ty,
+                  x + tx, y + ty, color);
+                return;
+        }
+        if ((sizes->asz <= 0.0)
+          || (geometry->number_of_arrows >= DXF_DIMENSION_GEOMETRY_MAX_ARROWS))
+        {
+                return;
+        }
+        half_width = sizes->asz / 6.0;
+        arrow = &geometry->arrows[geometry->number_of_arrows];
+        arrow->x[0] = x;
+        arrow->y[0] = y;
+        arrow->x[1] = x - dx * sizes->asz - dy * half_width;
+        arrow->y[1] = y - dy * sizes->asz + dx * half_width;
+        arrow->x[2] = x - dx * sizes->asz + dy * half_width;
+        arrow->y[2] = y - dy * sizes->asz - dx * half_width;
+        arrow->color = color;
+        geometry->number_of_arrows++;
+}
+
+
+/*!
+ * \brief Format the dimension text from the measurement.
+ *
+ * The measurement is scaled by \c DIMLFAC (not for angular
+ * dimensions), rounded to \c DIMRND, written with \c DIMDEC decimals
+ * and zeros are suppressed following \c DIMZIN.\n
+ * The prefix or suffix of the dimension type is added and the result
+ * is substituted for "<>" in \c DIMPOST and the user supplied text.
+ */
+static void
+dxf_dimension_regen_format
+(
+        DxfDimension *dimension,
+                /*!< a pointer to the dimension. */
+        DxfDimStyle *dimstyle,
+                /*!< a pointer to the resolved dimension style. */
+        double value,
+                /*!< the value to show, in degrees for angular
+                 * dimensions. */
+        DxfDimensionGeometry *geometry
+                /*!< a pointer to the geometry receiving the text. */
+)
+{
+        char number[64];
+        char measured[96];
+        char posted[192];
+        const char *prefix = "";
+        const char *suffix = "";
+        const char *marker = NULL;
+        size_t length;
+        int decimals;
+
+        switch (geometry->type)
+        {
+                case 2:
+                case 5:
+                        suffix = "%%d";
+                        break;
+                case 3:
+                        prefix = "%%c";
+                        break;
+                case 4:
+                        prefix = "R";
+                        break;
+                default:
+                        if (dimstyle->dimlfac != 0.0)
+                        {
+                                value *= dimstyle->dimlfac;
+                        }
+                        break;
+        }
+        if (dimstyle->dimrnd > 0.0)
+        {
+                value = floor (value / dimstyle->dimrnd + 0.5) * dimstyle->dimrnd;
+        }
+        decimals = dimstyle->dimdec;
+        if (decimals < 0)
+        {
+                decimals = 0;
+        }
+        if (decimals > 8)
+        {
+                decimals = 8;
+        }
+        snprintf (number, sizeof (number), "%.*f", decimals, value);
+        /* No "-0.00". */
+        if ((number[0] == '-') && (strtod (number, NULL) == 0.0))
+        {
+                memmove (number, number + 1, strlen (number));
+        }
+        if ((dimstyle->dimzin & 8) && (strchr (number, '.') != NULL))
+        {
+                length = strlen (number);
+                while (number[length - 1] == '0')
+                {
+                        number[--length] = '\0';
+                }
+                if (number[length - 1] == '.')
+                {
+                        number[--length] = '\0';
+                }
+        }
+        if (dimstyle->dimzin & 4)
+        {
+                if ((number[0] == '0') && (number[1] == '.'))
+                {
+                        memmove (number, number + 1, strlen (number));
+                }
+                else if ((number[0] == '-') && (number[1] == '0') && (number[2] == '.'))
+                {
+                        memmove (number + 1, number + 2, strlen (number + 1));
+                }
+        }
+        snprintf (measured, sizeof (measured), "%s%s%s", prefix, number, suffix);
+        /* Without "<>" DIMPOST is a suffix. */
+        if ((dimstyle->dimpost != NULL) && (dimstyle->dimpost[0] != '\0'))
+        {
+                marker = strstr (dimstyle->dimpost, "<>");
+                if (marker != NULL)
+                {
+                        snprintf (posted, sizeof (posted), "%.*s%s%s",
+                          (int) (marker - dimstyle->dimpost),
+                          dimstyle->dimpost, measured, marker + 2);
+                }
+                else
+                {
+                        snprintf (posted, sizeof (posted), "%s%s",
+                          measured, dimstyle->dimpost);
+                }
+        }
+        else
+        {
+                snprintf (posted, sizeof (posted), "%s", measured);
+        }
+        if ((dimension->dim_text == NULL)
+          || (dimension->dim_text[0] == '\0'))
+        {
+                snprintf (geometry->text, sizeof (geometry->text), "%s", posted);
+        }
+        else if (strcmp (dimension->dim_text, " ") == 0)
+        {
+                geometry->text[0] = '\0';
+        }
+        else if ((marker = strstr (dimension->dim_text, "<>")) != NULL)
+        {
+                snprintf (geometry->text, sizeof (geometry->text), "%.*s%s%s",
+                  (int) (marker - dimension->dim_text),
+                  dimension->dim_text, posted, marker + 2);
+        }
+        else
+        {
+                snprintf (geometry->text, sizeof (geometry->text), "%s",
+                  dimension->dim_text);
+        }
+}
+
+
+/*!
+ * \brief Estimate the width of the dimension text, a "%%" control
+ * code counts as a single character.
+ *
+ * \return the estimated width.
+ */
+static double
+dxf_dimension_regen_text_width
+(
+        const char *text,
+                /*!< the dimension text. */
+        double height
+                /*!< the text height. */
+)
+{
+        int number_of_characters;
+
+        number_of_characters = 0;
+        while (*text != '\0')
+        {
+                if ((text[0] == '%') && (text[1] == '%') && (text[2] != '\0'))
+                {
+                        text += 3;
+                }
+                else
+                {
+                        /* Skip UTF-8 continuation bytes. */
+                        do
+                        {
+                                text++;
+                        }
+                        while ((*text & 0xc0) == 0x80);
+                }
+                number_of_characters++;
+        }
+        return (number_of_characters * height * DXF_DIMENSION_GEOMETRY_CHARACTER_WIDTH);
+}
+
+
+/*!
+ * \brief Turn a text angle so the text reads from left to right or
+ * from bottom to top.
+ *
+ * \return the angle in degrees in the range (-90, 90].
+ */
+static double
+dxf_dimension_regen_readable_angle
+(
+        double angle
+                /*!< the angle in degrees. */
+)
+{
+        angle = fmod (angle, 360.0);
+        if (angle < 0.0)
+        {
+                angle += 360.0;
+        }
+        if ((angle > 90.0) && (angle <= 270.0))
+        {
+                angle -= 180.0;
+        }
+        else if (angle > 270.0)
+        {
+                angle -= 360.0;
+        }
+        return (angle);
+}
+
+
+/*!
+ * \brief Counterclockwise angle from direction \c a to direction
+ * \c b.
+ *
+ * \return the angle in radians in the range [0, 2 pi).
+ */
+static double
+dxf_dimension_regen_ccw_angle
+(
+        double ax,
+                /*!< X-component of direction \c a. */
+        double ay,
+                /*!< Y-component of direction \c a. */
+        double bx,
+                /*!< X-component of direction \c b. */
+        double by
+                /*!< Y-component of direction \c b. */
+)
+{
+        double angle;
+
+        angle = atan2 (by, bx) - atan2 (ay, ax);
+        if (angle < 0.0)
+        {
+                angle += 2.0 * M_PI;
+        }
+        if (angle >= 2.0 * M_PI)
+        {
+                angle -= 2.0 * M_PI;
+        }
+        return (angle);
+}
+
+
+/*!
+ * \brief Rotation of the dimension text: an explicit text rotation,
+ * horizontal text inside the extension lines (\c DIMTIH without
+ * \c DIMTAD), or aligned with the dimension line.
+ *
+ * \return the angle in degrees.
+ */
+static double
+dxf_dimension_regen_text_angle
+(
+        DxfDimension *dimension,
+                /*!< a pointer to the dimension. */
+        DxfDimStyle *dimstyle,
+                /*!< a pointer to the resolved dimension style. */
+        double line_angle
+                /*!< direction of the dimension line in degrees. */
+)
+{
+        if (dimension->text_angle != 0.0)
+        {
+                return (dimension->text_angle);
+        }
+        if ((dimstyle->dimtad == 0) && (dimstyle->dimtih != 0))
+        {
+                return (0.0);
+        }
+        return (dxf_dimension_regen_readable_angle (line_angle));
+}
+
+
+/*!
+ * \brief Draw the dimension line from \c a to \c b and place the text
+ * at its middle.
+ *
+ * Without \c DIMTAD the line is broken around the text when the text
+ * fits, otherwise the text is placed above the line.
+ */
+static void
+dxf_dimension_regen_place_text
+(
+        DxfDimensionGeometry *geometry,
+                /*!< a pointer to the geometry. */
+        DxfDimension *dimension,
+                /*!< a pointer to the dimension. */
+        DxfDimStyle *dimstyle,
+                /*!< a pointer to the resolved dimension style. */
+        DxfDimensionRegenSizes *sizes,
+                /*!< a pointer to the scaled sizes. */
+        double ax,
+                /*!< X-coordinate of the start of the line. */
+        double ay,
+                /*!< Y-coordinate of the start of the line. */
+        double bx,
+                /*!< X-coordinate of the end of the line. */
+        double by
+                /*!< Y-coordinate of the end of the line. */
+)
+{
+        double length;
+        double ux;
+        double uy;
+        double nx;
+        double ny;
+        double mx;
+        double my;
+        double width;
+        double relative;
+        double along;
+        double across;
+
+        length = hypot (bx - ax, by - ay);
+        if (length > 0.0)
+        {
+                ux = (bx - ax) / length;
+                uy = (by - ay) / length;
+        }
+        else
+        {
+                ux = 1.0;
+                uy = 0.0;
+        }
+        mx = (ax + bx) / 2.0;
+        my = (ay + by) / 2.0;
+        geometry->text_angle = dxf_dimension_regen_text_angle (dimension,
+          dimstyle, atan2 (uy, ux) * 180.0 / M_PI);
+        width = dxf_dimension_regen_text_width (geometry->text, sizes->txt);
+        relative = geometry->text_angle * M_PI / 180.0 - atan2 (uy, ux);
+        /* Half extents of the text box along and across the line. */
+        along = fabs (width / 2.0 * cos (relative)) + fabs (sizes->txt / 2.0 * sin (relative)) + sizes->gap;
+        across = fabs (width / 2.0 * sin (relative)) + fabs (sizes->txt / 2.0 * cos (relative)) + sizes->gap;
+        if ((dimension->flag & 128) && (dimension->p1 != NULL))
+        {
+                geometry->text_x = dimension->p1->x0;
+                geometry->text_y = dimension->p1->y0;
+                dxf_dimension_regen_add_line (geometry, ax, ay, bx, by,
+                  dimstyle->dimclrd);
+                return;
+        }
+        if ((geometry->text[0] != '\0')
+          && (dimstyle->dimtad == 0)
+          && (2.0 * along < length))
+        {
+                geometry->text_x = mx;
+                geometry->text_y = my;
+                dxf_dimension_regen_add_line (geometry, ax, ay,
+                  mx - ux * along, my - uy * along, dimstyle->dimclrd);
+                dxf_dimension_regen_add_line (geometry,
+                  mx + ux * along, my + uy * along, bx, by,
+                  dimstyle->dimclrd);
+                return;
+        }
+        /* Above the line: on the side of the "up" of the text. */
+        nx = -uy;
+        ny = ux;
+        if (nx * -sin (geometry->text_angle * M_PI / 180.0)
+          + ny * cos (geometry->text_angle * M_PI / 180.0) < 0.0)
+        {
+                nx = -nx;
+                ny = -ny;
+        }
+        geometry->text_x = mx + nx * across;
+        geometry->text_y = my + ny * across;
+        dxf_dimension_regen_add_line (geometry, ax, ay, bx, by,
+          dimstyle->dimclrd);
+}
+
+
+/*!
+ * \brief Regenerate a rotated, horizontal, vertical (type 0) or
+ * aligned (type 1) dimension.
+ *
+ * The extension lines start at \c p3 and \c p4, the dimension line
+ * runs through \c p0.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when a
+ * definition point is missing.
+ */
+static int
+dxf_dimension_regen_linear
+(
+        DxfDimension *dimension,
+                /*!< a pointer to the dimension. */
+        DxfDimStyle *dimstyle,
+                /*!< a pointer to the resolved dimension style. */
+        DxfDimensionRegenSizes *sizes,
+                /*!< a pointer to the scaled sizes. */
+        DxfDimensionGeometry *geometry
+                /*!< a pointer to the geometry. */
+)
+{
+        DxfPoint *points[2];
+        double dx[2];
+        double dy[2];
+        double ux;
+        double uy;
+        double vx;
+        double vy;
+        double ex;
+        double ey;
+        double t;
+        double length;
+        int is_outside;
+        int i;
+
+        if ((dimension->p0 == NULL) || (dimension->p3 == NULL)
+          || (dimension->p4 == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a definition point is missing.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        points[0] = dimension->p3;
+        points[1] = dimension->p4;
+        ux = 1.0;
+        uy = 0.0;
+        if (geometry->type == 0)
+        {
+                ux = cos (dimension->angle * M_PI / 180.0);
+                uy = sin (dimension->angle * M_PI / 180.0);
+        }
+        else
+        {
+                length = hypot (points[1]->x0 - points[0]->x0,
+                  points[1]->y0 - points[0]->y0);
+                if (length > 0.0)
+                {
+                        ux = (points[1]->x0 - points[0]->x0) / length;
+                        uy = (points[1]->y0 - points[0]->y0) / length;
+                }
+        }
+        /* Project the definition points on the dimension line. */
+        for (i = 0; i < 2; i++)
+        {
+                t = (points[i]->x0 - dimension->p0->x0) * ux
+                  + (points[i]->y0 - dimension->p0->y0) * uy;
+                dx[i] = dimension->p0->x0 + ux * t;
+                dy[i] = dimension->p0->y0 + uy * t;
+        }
+        geometry->measurement = hypot (dx[1] - dx[0], dy[1] - dy[0]);
+        /* Extension lines. */
+        for (i = 0; i < 2; i++)
+        {
+                if (((i == 0) && dimstyle->dimse1)
+                  || ((i == 1) && dimstyle->dimse2))
+                {
+                        continue;
+                }
+                length = hypot (dx[i] - points[i]->x0, dy[i] - points[i]->y0);
+                if (length > 0.0)
+                {
+                        ex = (dx[i] - points[i]->x0) / length;
+                        ey = (dy[i] - points[i]->y0) / length;
+                }
+                else
+                {
+                        ex = -uy;
+                        ey = ux;
+                }
+                dxf_dimension_regen_add_line (geometry,
+                  points[i]->x0 + ex * sizes->exo,
+                  points[i]->y0 + ey * sizes->exo,
+                  dx[i] + ex * sizes->exe,
+                  dy[i] + ey * sizes->exe,
+                  dimstyle->dimclre);
+        }
+        /* Dimension line and text. */
+        if (geometry->measurement > 0.0)
+        {
+                vx = (dx[1] - dx[0]) / geometry->measurement;
+                vy = (dy[1] - dy[0]) / geometry->measurement;
+        }
+        else
+        {
+                vx = ux;
+                vy = uy;
+        }
+        dxf_dimension_regen_format (dimension, dimstyle,
+          geometry->measurement, geometry);
+        dxf_dimension_regen_place_text (geometry, dimension, dimstyle,
+          sizes, dx[0], dy[0], dx[1], dy[1]);
+        /* Arrows outside the extension lines when they do not fit. */
+        is_outside = (sizes->tsz <= 0.0) && (geometry->measurement < 2.0 * sizes->asz);
+        if (is_outside)
+        {
+                dxf_dimension_regen_add_line (geometry,
+                  dx[0] - vx * 2.0 * sizes->asz, dy[0] - vy * 2.0 * sizes->asz,
+                  dx[0], dy[0], dimstyle->dimclrd);
+                dxf_dimension_regen_add_line (geometry, dx[1], dy[1],
+                  dx[1] + vx * 2.0 * sizes->asz, dy[1] + vy * 2.0 * sizes->asz,
+                  dimstyle->dimclrd);
+                dxf_dimension_regen_add_arrow (geometry, sizes, dx[0], dy[0],
+                  vx, vy, dimstyle->dimclrd);
+                dxf_dimension_regen_add_arrow (geometry, sizes, dx[1], dy[1],
+                  -vx, -vy, dimstyle->dimclrd);
+        }
+        else
+        {
+                dxf_dimension_regen_add_arrow (geometry, sizes, dx[0], dy[0],
+                  -vx, -vy, dimstyle->dimclrd);
+                dxf_dimension_regen_add_arrow (geometry, sizes, dx[1], dy[1],
+                  vx, vy, dimstyle->dimclrd);
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Regenerate a diameter (type 3) or radius (type 4) dimension.
+ *
+ * A radius dimension runs from the center \c p0 to \c p5 on the arc,
+ * a diameter dimension runs from \c p0 to \c p5, both on the circle.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when a
+ * definition point is missing.
+ */
+static int
+dxf_dimension_regen_radial
+(
+        DxfDimension *dimension,
+                /*!< a pointer to the dimension. */
+        DxfDimStyle *dimstyle,
+                /*!< a pointer to the resolved dimension style. */
+        DxfDimensionRegenSizes *sizes,
+                /*!< a pointer to the scaled sizes. */
+        DxfDimensionGeometry *geometry
+                /*!< a pointer to the geometry. */
+)
+{
+        double ax;
+        double ay;
+        double bx;
+        double by;
+        double ux;
+        double uy;
+
+        if ((dimension->p0 == NULL) || (dimension->p5 == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a definition point is missing.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        ax = dimension->p0->x0;
+        ay = dimension->p0->y0;
+        bx = dimension->p5->x0;
+        by = dimension->p5->y0;
+        geometry->measurement = hypot (bx - ax, by - ay);
+        if (geometry->measurement > 0.0)
+        {
+                ux = (bx - ax) / geometry->measurement;
+                uy = (by - ay) / geometry->measurement;
+        }
+        else
+        {
+                ux = 1.0;
+                uy = 0.0;
+        }
+        dxf_dimension_regen_format (dimension, dimstyle,
+          geometry->measurement, geometry);
+        dxf_dimension_regen_place_text (geometry, dimension, dimstyle,
+          sizes, ax, ay, bx, by);
+        dxf_dimension_regen_add_arrow (geometry, sizes, bx, by, ux, uy,
+          dimstyle->dimclrd);
+        if (geometry->type == 3)
+        {
+                dxf_dimension_regen_add_arrow (geometry, sizes, ax, ay,
+                  -ux, -uy, dimstyle->dimclrd);
+        }
+        /* Center mark, a diameter dimension line crosses the center. */
+        if ((geometry->type == 4) && (sizes->cen != 0.0))
+        {
+                dxf_dimension_regen_add_line (geometry,
+                  ax - fabs (sizes->cen), ay, ax + fabs (sizes->cen), ay,
+                  dimstyle->dimclrd);
+                dxf_dimension_regen_add_line (geometry,
+                  ax, ay - fabs (sizes->cen), ax, ay + fabs (sizes->cen),
+                  dimstyle->dimclrd);
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Regenerate an angular (type 2) or angular 3-point (type 5)
+ * dimension.
+ *
+ * An angular dimension measures between the line \c p3 - \c p4 and
+ * the line \c p5 - \c p0, in the sector containing the arc point
+ * \c p6.\n
+ * An angular 3-point dimension measures at vertex \c p5 between the
+ * directions to \c p3 and \c p4, in the sector containing the arc
+ * point \c p0.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when a
+ * definition point is missing or the lines are parallel.
+ */
+static int
+dxf_dimension_regen_angular
+(
+        DxfDimension *dimension,
+                /*!< a pointer to the dimension. */
+        DxfDimStyle *dimstyle,
+                /*!< a pointer to the resolved dimension style. */
+        DxfDimensionRegenSizes *sizes,
+                /*!< a pointer to the scaled sizes. */
+        DxfDimensionGeometry *geometry
+                /*!< a pointer to the geometry. */
+)
+{
+        DxfPoint *arc_point = NULL;
+        DxfPoint *line_points[2][2];
+        double rx[2];
+        double ry[2];
+        double ax;
+        double ay;
+        double bx;
+        double by;
+        double cx;
+        double cy;
+        double radius;
+        double sweep;
+        double start;
+        double middle;
+        double half_gap;
+        double width;
+        double length;
+        double denominator;
+        double s;
+        double t;
+        double t_max;
+        double swap;
+        int is_outside;
+        int i;
+        int j;
+        int k;
+
+        if (geometry->type == 2)
+        {
+                if ((dimension->p0 == NULL) || (dimension->p3 == NULL)
+                  || (dimension->p4 == NULL) || (dimension->p5 == NULL)
+                  || (dimension->p6 == NULL))
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () a definition point is missing.\n")),
+                          __FUNCTION__);
+                        return (EXIT_FAILURE);
+                }
+                line_points[0][0] = dimension->p3;
+                line_points[0][1] = dimension->p4;
+                line_points[1][0] = dimension->p5;
+                line_points[1][1] = dimension->p0;
+                arc_point = dimension->p6;
+                for (i = 0; i < 2; i++)
+                {
+                        rx[i] = line_points[i][1]->x0 - line_points[i][0]->x0;
+                        ry[i] = line_points[i][1]->y0 - line_points[i][0]->y0;
+                        length = hypot (rx[i], ry[i]);
+                        if (length <= 0.0)
+                        {
+                                fprintf (stderr,
+                                  (_("Error in %s () a dimension line has zero length.\n")),
+                                  __FUNCTION__);
+                                return (EXIT_FAILURE);
+                        }
+                        rx[i] /= length;
+                        ry[i] /= length;
+                }
+                denominator = rx[0] * ry[1] - ry[0] * rx[1];
+                if (fabs (denominator) < 1e-12)
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () the dimension lines are parallel.\n")),
+                          __FUNCTION__);
+                        return (EXIT_FAILURE);
+                }
+                /* The vertex is the intersection of both lines. */
+                s = ((line_points[1][0]->x0 - line_points[0][0]->x0) * ry[1]
+                  - (line_points[1][0]->y0 - line_points[0][0]->y0) * rx[1])
+                  / denominator;
+                cx = line_points[0][0]->x0 + rx[0] * s;
+                cy = line_points[0][0]->y0 + ry[0] * s;
+                /* Of the four sectors between the rays take the one
+                 * containing the arc point. */
+                for (k = 0; k < 4; k++)
+                {
+                        ax = (k & 1) ? -rx[0] : rx[0];
+                        ay = (k & 1) ? -ry[0] : ry[0];
+                        bx = (k & 2) ? -rx[1] : rx[1];
+                        by = (k & 2) ? -ry[1] : ry[1];
+                        sweep = dxf_dimension_regen_ccw_angle (ax, ay, bx, by);
+                        if (sweep > M_PI)
+                        {
+                                swap = ax; ax = bx; bx = swap;
+                                swap = ay; ay = by; by = swap;
+                                sweep = 2.0 * M_PI - sweep;
+                        }
+                        if (dxf_dimension_regen_ccw_angle (ax, ay,
+                          arc_point->x0 - cx, arc_point->y0 - cy) <= sweep)
+                        {
+                                rx[0] = ax;
+                                ry[0] = ay;
+                                rx[1] = bx;
+                                ry[1] = by;
+                                break;
+                        }
+                }
+        }
+        else
+        {
+                if ((dimension->p0 == NULL) || (dimension->p3 == NULL)
+                  || (dimension->p4 == NULL) || (dimension->p5 == NULL))
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () a definition point is missing.\n")),
+                          __FUNCTION__);
+                        return (EXIT_FAILURE);
+                }
+                line_points[0][0] = dimension->p3;
+                line_points[0][1] = dimension->p3;
+                line_points[1][0] = dimension->p4;
+                line_points[1][1] = dimension->p4;
+                arc_point = dimension->p0;
+                cx = dimension->p5->x0;
+                cy = dimension->p5->y0;
+                for (i = 0; i < 2; i++)
+                {
+                        rx[i] = line_points[i][0]->x0 - cx;
+                        ry[i] = line_points[i][0]->y0 - cy;
+                        length = hypot (rx[i], ry[i]);
+                        if (length <= 0.0)
+                        {
+                                fprintf (stderr,
+                                  (_("Error in %s () a definition point is at the vertex.\n")),
+                                  __FUNCTION__);
+                                return (EXIT_FAILURE);
+                        }
+                        rx[i] /= length;
+                        ry[i] /= length;
+                }
+                if (dxf_dimension_regen_ccw_angle (rx[0], ry[0],
+                  arc_point->x0 - cx, arc_point->y0 - cy)
+                  > dxf_dimension_regen_ccw_angle (rx[0], ry[0], rx[1], ry[1]))
+                {
+                        swap = rx[0]; rx[0] = rx[1]; rx[1] = swap;
+                        swap = ry[0]; ry[0] = ry[1]; ry[1] = swap;
+                        line_points[0][0] = dimension->p4;
+                        line_points[0][1] = dimension->p4;
+                        line_points[1][0] = dimension->p3;
+                        line_points[1][1] = dimension->p3;
+                }
+        }
+        /* The arc runs counterclockwise from ray 0 to ray 1. */
+        radius = hypot (arc_point->x0 - cx, arc_point->y0 - cy);
+        sweep = dxf_dimension_regen_ccw_angle (rx[0], ry[0], rx[1], ry[1]);
+        start = atan2 (ry[0], rx[0]);
+        middle = start + sweep / 2.0;
+        geometry->measurement = sweep;
+        /* Extension lines from the far end of each line to the arc. */
+        for (i = 0; i < 2; i++)
+        {
+                if (((i == 0) && dimstyle->dimse1)
+                  || ((i == 1) && dimstyle->dimse2))
+                {
+                        continue;
+                }
+                t_max = -HUGE_VAL;
+                for (j = 0; j < 2; j++)
+                {
+                        t = (line_points[i][j]->x0 - cx) * rx[i]
+                          + (line_points[i][j]->y0 - cy) * ry[i];
+                        if (t > t_max)
+                        {
+                                t_max = t;
+                        }
+                }
+                if (t_max + sizes->exo < radius)
+                {
+                        dxf_dimension_regen_add_line (geometry,
+                          cx + rx[i] * (t_max + sizes->exo),
+                          cy + ry[i] * (t_max + sizes->exo),
+                          cx + rx[i] * (radius + sizes->exe),
+                          cy + ry[i] * (radius + sizes->exe),
+                          dimstyle->dimclre);
+                }
+        }
+        dxf_dimension_regen_format (dimension, dimstyle,
+          sweep * 180.0 / M_PI, geometry);
+        geometry->text_angle = dxf_dimension_regen_text_angle (dimension,
+          dimstyle, middle * 180.0 / M_PI + 90.0);
+        width = dxf_dimension_regen_text_width (geometry->text, sizes->txt);
+        half_gap = (radius > 0.0) ? (width / 2.0 + sizes->gap) / radius : 0.0;
+        if ((dimension->flag & 128) && (dimension->p1 != NULL))
+        {
+                geometry->text_x = dimension->p1->x0;
+                geometry->text_y = dimension->p1->y0;
+                half_gap = 0.0;
+        }
+        else if ((geometry->text[0] != '\0')
+          && (dimstyle->dimtad == 0)
+          && (2.0 * half_gap < sweep))
+        {
+                geometry->text_x = cx + radius * cos (middle);
+                geometry->text_y = cy + radius * sin (middle);
+        }
+        else
+        {
+                geometry->text_x = cx + (radius + sizes->txt / 2.0 + sizes->gap) * cos (middle);
+                geometry->text_y = cy + (radius + sizes->txt / 2.0 + sizes->gap) * sin (middle);
+                half_gap = 0.0;
+        }
+        if (half_gap > 0.0)
+        {
+                geometry->arcs[0].start_angle = start;
+                geometry->arcs[0].end_angle = middle - half_gap;
+                geometry->arcs[1].start_angle = middle + half_gap;
+                geometry->arcs[1].end_angle = start + sweep;
+                geometry->number_of_arcs = 2;
+        }
+        else
+        {
+                geometry->arcs[0].start_angle = start;
+                geometry->arcs[0].end_angle = start + sweep;
+                geometry->number_of_arcs = 1;
+        }
+        for (i = 0; i < geometry->number_of_arcs; i++)
+        {
+                geometry->arcs[i].x = cx;
+                geometry->arcs[i].y = cy;
+                geometry->arcs[i].radius = radius;
+                geometry->arcs[i].start_angle *= 180.0 / M_PI;
+                geometry->arcs[i].end_angle *= 180.0 / M_PI;
+                geometry->arcs[i].color = dimstyle->dimclrd;
+        }
+        /* Arrows along the tangents, outside when they do not fit. */
+        is_outside = (sizes->tsz <= 0.0) && (radius * sweep < 2.0 * sizes->asz);
+        for (i = 0; i < 2; i++)
+        {
+                t = start + i * sweep;
+                s = ((i == 0) != is_outside) ? -1.0 : 1.0;
+                dxf_dimension_regen_add_arrow (geometry, sizes,
+                  cx + radius * cos (t), cy + radius * sin (t),
+                  -sin (t) * s, cos (t) * s, dimstyle->dimclrd);
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Regenerate an ordinate dimension (type 6).
+ *
+ * The leader runs from the feature \c p3 to the leader end point
+ * \c p4, the measurement is the X-coordinate (bit value 64 set) or
+ * Y-coordinate of \c p3 relative to the origin \c p0.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when a
+ * definition point is missing.
+ */
+static int
+dxf_dimension_regen_ordinate
+(
+        DxfDimension *dimension,
+                /*!< a pointer to the dimension. */
+        DxfDimStyle *dimstyle,
+                /*!< a pointer to the resolved dimension style. */
+        DxfDimensionRegenSizes *sizes,
+                /*!< a pointer to the scaled sizes. */
+        DxfDimensionGeometry *geometry
+                /*!< a pointer to the geometry. */
+)
+{
+        double ux;
+        double uy;
+        double length;
+        double width;
+
+        if ((dimension->p0 == NULL) || (dimension->p3 == NULL)
+          || (dimension->p4 == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a definition point is missing.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (dimension->flag & 64)
+        {
+                geometry->measurement = dimension->p3->x0 - dimension->p0->x0;
+                ux = 0.0;
+                uy = (dimension->p4->y0 >= dimension->p3->y0) ? 1.0 : -1.0;
+        }
+        else
+        {
+                geometry->measurement = dimension->p3->y0 - dimension->p0->y0;
+                ux = (dimension->p4->x0 >= dimension->p3->x0) ? 1.0 : -1.0;
+                uy = 0.0;
+        }
+        length = hypot (dimension->p4->x0 - dimension->p3->x0,
+          dimension->p4->y0 - dimension->p3->y0);
+        if (length > sizes->exo)
+        {
+                dxf_dimension_regen_add_line (geometry,
+                  dimension->p3->x0 + (dimension->p4->x0 - dimension->p3->x0) / length * sizes->exo,
+                  dimension->p3->y0 + (dimension->p4->y0 - dimension->p3->y0) / length * sizes->exo,
+                  dimension->p4->x0, dimension->p4->y0, dimstyle->dimclre);
+        }
+        dxf_dimension_regen_format (dimension, dimstyle,
+          geometry->measurement, geometry);
+        geometry->text_angle = (dimension->text_angle != 0.0)
+          ? dimension->text_angle : ((ux == 0.0) ? 90.0 : 0.0);
+        width = dxf_dimension_regen_text_width (geometry->text, sizes->txt);
+        if ((dimension->flag & 128) && (dimension->p1 != NULL))
+        {
+                geometry->text_x = dimension->p1->x0;
+                geometry->text_y = dimension->p1->y0;
+        }
+        else
+        {
+                geometry->text_x = dimension->p4->x0 + ux * (width / 2.0 + sizes->gap);
+                geometry->text_y = dimension->p4->y0 + uy * (width / 2.0 + sizes->gap);
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Run a batch regeneration job, used as thread entry point.
+ */
+static void *
+dxf_dimension_regen_run_job
+(
+        void *data
+                /*!< a pointer to a \c DxfDimensionRegenJob. */
+)
+{
+        DxfDimensionRegenJob *job = NULL;
+        int i;
+
+        job = (DxfDimensionRegenJob *) data;
+        for (i = job->begin; i < job->end; i++)
+        {
+                if (job->dimstyles[i] == NULL)
+                {
+                        memset (&job->geometries[i], 0, sizeof (DxfDimensionGeometry));
+                        job->geometries[i].status = EXIT_FAILURE;
+                        continue;
+                }
+                dxf_dimension_regen (job->dimensions[i], job->dimstyles[i],
+                  &job->geometries[i]);
+        }
+        return (NULL);
+}
+
+
+/* EOF */
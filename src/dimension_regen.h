@@ -0,0 +1,187 @@
+/*!
+ * \file dimension_regen.h
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Header file for the regeneration of the geometry of DXF
+ * dimensions (\c DIMENSION).
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#ifndef LIBDXF_SRC_DIMENSION_REGEN_H
+#define LIBDXF_SRC_DIMENSION_REGEN_H
+
+
+#include "global.h"
+#include "dimension.h"
+#include "dimstyle.h"
+#include "dimstyle_cache.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define DXF_DIMENSION_GEOMETRY_MAX_LINES 16
+        /*!< \brief Maximum number of lines in the geometry of a single
+         * dimension. */
+
+#define DXF_DIMENSION_GEOMETRY_MAX_ARCS 2
+        /*!< \brief Maximum number of arcs in the geometry of a single
+         * dimension. */
+
+#define DXF_DIMENSION_GEOMETRY_MAX_ARROWS 2
+        /*!< \brief Maximum number of arrow heads in the geometry of a
+         * single dimension. */
+
+#define DXF_DIMENSION_GEOMETRY_MAX_TEXT_LENGTH 256
+        /*!< \brief Maximum length of the dimension text, including the
+         * terminating \c NUL. */
+
+#define DXF_DIMENSION_GEOMETRY_CHARACTER_WIDTH 0.6
+        /*!< \brief Estimated width of a character of the dimension
+         * text, relative to the text height. */
+
+
+/*!
+ * \brief Definition of a line in the geometry of a dimension.
+ */
+typedef struct
+dxf_dimension_geometry_line_struct
+{
+        double x0;
+                /*!< X-coordinate of the start point. */
+        double y0;
+                /*!< Y-coordinate of the start point. */
+        double x1;
+                /*!< X-coordinate of the end point. */
+        double y1;
+                /*!< Y-coordinate of the end point. */
+        int color;
+                /*!< Color (\c DIMCLRD or \c DIMCLRE). */
+} DxfDimensionGeometryLine;
+
+
+/*!
+ * \brief Definition of an arc in the geometry of a dimension.
+ */
+typedef struct
+dxf_dimension_geometry_arc_struct
+{
+        double x;
+                /*!< X-coordinate of the center point. */
+        double y;
+                /*!< Y-coordinate of the center point. */
+        double radius;
+                /*!< Radius. */
+        double start_angle;
+                /*!< Start angle in degrees, the arc runs
+                 * counterclockwise. */
+        double end_angle;
+                /*!< End angle in degrees. */
+        int color;
+                /*!< Color (\c DIMCLRD). */
+} DxfDimensionGeometryArc;
+
+
+/*!
+ * \brief Definition of an arrow head (a filled triangle, the first
+ * point is the tip) in the geometry of a dimension.
+ */
+typedef struct
+dxf_dimension_geometry_arrow_struct
+{
+        double x[3];
+                /*!< X-coordinates of the corners. */
+        double y[3];
+                /*!< Y-coordinates of the corners. */
+        int color;
+                /*!< Color (\c DIMCLRD). */
+} DxfDimensionGeometryArrow;
+
+
+/*!
+ * \brief Definition of the regenerated geometry of a dimension, the
+ * contents of the anonymous \c *D block.
+ *
+ * All coordinates are in the Object Coordinate System of the
+ * dimension, the sizes are scaled by \c DIMSCALE.
+ */
+typedef struct
+dxf_dimension_geometry_struct
+{
+        int type;
+                /*!< Dimension type (group code 70 without the bit
+                 * values). */
+        DxfDimensionGeometryLine lines[DXF_DIMENSION_GEOMETRY_MAX_LINES];
+                /*!< Dimension lines, extension lines, ticks and center
+                 * marks. */
+        int number_of_lines;
+                /*!< Number of lines. */
+        DxfDimensionGeometryArc arcs[DXF_DIMENSION_GEOMETRY_MAX_ARCS];
+                /*!< Dimension arcs of angular dimensions. */
+        int number_of_arcs;
+                /*!< Number of arcs. */
+        DxfDimensionGeometryArrow arrows[DXF_DIMENSION_GEOMETRY_MAX_ARROWS];
+                /*!< Arrow heads. */
+        int number_of_arrows;
+                /*!< Number of arrow heads. */
+        double text_x;
+                /*!< X-coordinate of the middle point of the text. */
+        double text_y;
+                /*!< Y-coordinate of the middle point of the text. */
+        double text_angle;
+                /*!< Rotation angle of the text in degrees. */
+        double text_height;
+                /*!< Height of the text. */
+        int text_color;
+                /*!< Color of the text (\c DIMCLRT). */
+        char text[DXF_DIMENSION_GEOMETRY_MAX_TEXT_LENGTH];
+                /*!< The dimension text, empty when suppressed. */
+        double measurement;
+                /*!< The measurement, in drawing units or in radians for
+                 * angular dimensions. */
+        int status;
+                /*!< \c EXIT_SUCCESS or \c EXIT_FAILURE. */
+} DxfDimensionGeometry;
+
+
+int dxf_dimension_regen (DxfDimension *dimension, DxfDimStyle *dimstyle, DxfDimensionGeometry *geometry);
+int dxf_dimension_regen_list (DxfDimension *dimensions, DxfDimStyleCache *cache, DxfDimensionGeometry *geometries, int max_number_of_geometries, int number_of_threads);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* LIBDXF_SRC_DIMENSION_REGEN_H */
+
+
+/* EOF */
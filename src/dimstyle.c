@@ -40,6 +40,7 @@
 
 
 #include "dimstyle.h"
+#include "util.h"
 
 
 /*!
@@ -113,12 +114,12 @@ dxf_dimstyle_init
                 __FUNCTION__);
               return (NULL);
         }
-        dimstyle->dimstyle_name = strdup ("");
-        dimstyle->dimpost = strdup ("");
-        dimstyle->dimapost = strdup ("");
-        dimstyle->dimblk = strdup ("");
-        dimstyle->dimblk1 = strdup ("");
-        dimstyle->dimblk2 = strdup ("");
+        dimstyle->dimstyle_name = dxf_string_share ("");
+        dimstyle->dimpost = dxf_string_share ("");
+        dimstyle->dimapost = dxf_string_share ("");
+        dimstyle->dimblk = dxf_string_share ("");
+        dimstyle->dimblk1 = dxf_string_share ("");
+        dimstyle->dimblk2 = dxf_string_share ("");
         dimstyle->dimscale = 0.0;
         dimstyle->dimasz = 0.0;
         dimstyle->dimexo = 0.0;
@@ -154,9 +155,9 @@ dxf_dimstyle_init
         dimstyle->dimclrd = DXF_COLOR_BYLAYER;
         dimstyle->dimclre = DXF_COLOR_BYLAYER;
         dimstyle->dimclrt = DXF_COLOR_BYLAYER;
-        dimstyle->dictionary_owner_soft = strdup ("");
-        dimstyle->object_owner_soft = strdup ("");
-        dimstyle->dictionary_owner_hard = strdup ("");
+        dimstyle->dictionary_owner_soft = dxf_string_share ("");
+        dimstyle->object_owner_soft = dxf_string_share ("");
+        dimstyle->dictionary_owner_hard = dxf_string_share ("");
         dimstyle->next = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -237,23 +238,28 @@ dxf_dimstyle_write
         }
         if (!dimstyle->dimpost)
         {
-                dimstyle->dimpost = strdup ("");
+                dxf_string_free (dimstyle->dimpost);
+                dimstyle->dimpost = dxf_string_share ("");
         }
         if (!dimstyle->dimapost)
         {
-                dimstyle->dimapost = strdup ("");
+                dxf_string_free (dimstyle->dimapost);
+                dimstyle->dimapost = dxf_string_share ("");
         }
         if (!dimstyle->dimblk)
         {
-                dimstyle->dimblk = strdup ("");
+                dxf_string_free (dimstyle->dimblk);
+                dimstyle->dimblk = dxf_string_share ("");
         }
         if (!dimstyle->dimblk1)
         {
-                dimstyle->dimblk1 = strdup ("");
+                dxf_string_free (dimstyle->dimblk1);
+                dimstyle->dimblk1 = dxf_string_share ("");
         }
         if (!dimstyle->dimblk2)
         {
-                dimstyle->dimblk2 = strdup ("");
+                dxf_string_free (dimstyle->dimblk2);
+                dimstyle->dimblk2 = dxf_string_share ("");
         }
         /* Start writing output. */
         fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
@@ -441,38 +447,33 @@ dxf_dimstyle_read
                 {
                         /* Now follows a string containing a dimension
                          * style name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dimstyle->dimstyle_name);
+                        dxf_read_string (fp, &dimstyle->dimstyle_name);
                 }
                 else if (strcmp (temp_string, "3") == 0)
                 {
                         /* Now follows a string containing a general
                          * dimensioning suffix. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dimstyle->dimpost);
+                        dxf_read_string (fp, &dimstyle->dimpost);
                 }
                 else if (strcmp (temp_string, "4") == 0)
                 {
                         /* Now follows a string containing an alternate
                          * dimensioning suffix. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dimstyle->dimapost);
+                        dxf_read_string (fp, &dimstyle->dimapost);
                 }
                 else if ((fp->acad_version_number < AutoCAD_2000)
                         && (strcmp (temp_string, "5") == 0))
                 {
                         /* Now follows a string containing an arrow
                          * block name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dimstyle->dimblk);
+                        dxf_read_string (fp, &dimstyle->dimblk);
                 }
                 else if ((fp->acad_version_number < AutoCAD_2000)
                         && (strcmp (temp_string, "6") == 0))
                 {
                         /* Now follows a string containing a first arrow
                          * block name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dimstyle->dimblk1);
+                        dxf_read_string (fp, &dimstyle->dimblk1);
                 }
 #if 0
 /*!
@@ -493,8 +494,7 @@ dxf_dimstyle_read
                 {
                         /* Now follows a string containing a first arrow
                          * block name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dimstyle->dimblk2);
+                        dxf_read_string (fp, &dimstyle->dimblk2);
                 }
 #if 0
 /*!
@@ -895,15 +895,13 @@ dxf_dimstyle_read
                         {
                                 /* Now follows a string containing a soft-pointer
                                  * ID/handle to owner dictionary. */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%s\n", dimstyle->dictionary_owner_soft);
+                                dxf_read_string (fp, &dimstyle->dictionary_owner_soft);
                         }
                         if (iter330 == 1)
                         {
                                 /* Now follows a string containing a soft-pointer
                                  * ID/handle to owner object. */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%s\n", dimstyle->object_owner_soft);
+                                dxf_read_string (fp, &dimstyle->object_owner_soft);
                         }
                         iter330++;
                 }
@@ -911,15 +909,13 @@ dxf_dimstyle_read
                 {
                         /* Now follows a string containing dimension
                          * text style. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dimstyle->dimtxsty);
+                        dxf_read_string (fp, &dimstyle->dimtxsty);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dimstyle->dictionary_owner_hard);
+                        dxf_read_string (fp, &dimstyle->dictionary_owner_hard);
                 }
         }
         /* Handle omitted members and/or illegal values. */
@@ -974,15 +970,16 @@ dxf_dimstyle_free
                 __FUNCTION__);
               return (EXIT_FAILURE);
         }
-        free (dimstyle->dimstyle_name);
-        free (dimstyle->dimpost);
-        free (dimstyle->dimapost);
-        free (dimstyle->dimblk);
-        free (dimstyle->dimblk1);
-        free (dimstyle->dimblk2);
-        free (dimstyle->dictionary_owner_soft);
-        free (dimstyle->object_owner_soft);
-        free (dimstyle->dictionary_owner_hard);
+        dxf_string_free (dimstyle->dimstyle_name);
+        dxf_string_free (dimstyle->dimpost);
+        dxf_string_free (dimstyle->dimapost);
+        dxf_string_free (dimstyle->dimblk);
+        dxf_string_free (dimstyle->dimblk1);
+        dxf_string_free (dimstyle->dimblk2);
+        dxf_string_free (dimstyle->dictionary_owner_soft);
+        dxf_string_free (dimstyle->object_owner_soft);
+        dxf_string_free (dimstyle->dictionary_owner_hard);
+        dxf_string_free (dimstyle->dimtxsty);
         free (dimstyle);
         dimstyle = NULL;
 #if DEBUG
@@ -1091,6 +1088,8 @@ dxf_dimstyle_set_dimstyle_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (dimstyle == NULL)
         {
@@ -1106,7 +1105,13 @@ dxf_dimstyle_set_dimstyle_name
                   __FUNCTION__);
                 return (NULL);
         }
-        dimstyle->dimstyle_name = strdup (dimstyle_name);
+        copy = dxf_string_share (dimstyle_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (dimstyle->dimstyle_name);
+        dimstyle->dimstyle_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1180,6 +1185,8 @@ dxf_dimstyle_set_dimpost
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (dimstyle == NULL)
         {
@@ -1195,7 +1202,13 @@ dxf_dimstyle_set_dimpost
                   __FUNCTION__);
                 return (NULL);
         }
-        dimstyle->dimpost = strdup (dimpost);
+        copy = dxf_string_share (dimpost);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (dimstyle->dimpost);
+        dimstyle->dimpost = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1269,6 +1282,8 @@ dxf_dimstyle_set_dimapost
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (dimstyle == NULL)
         {
@@ -1284,7 +1299,13 @@ dxf_dimstyle_set_dimapost
                   __FUNCTION__);
                 return (NULL);
         }
-        dimstyle->dimapost = strdup (dimapost);
+        copy = dxf_string_share (dimapost);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (dimstyle->dimapost);
+        dimstyle->dimapost = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1357,6 +1378,8 @@ dxf_dimstyle_set_dimblk
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (dimstyle == NULL)
         {
@@ -1372,7 +1395,13 @@ dxf_dimstyle_set_dimblk
                   __FUNCTION__);
                 return (NULL);
         }
-        dimstyle->dimblk = strdup (dimblk);
+        copy = dxf_string_share (dimblk);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (dimstyle->dimblk);
+        dimstyle->dimblk = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1446,6 +1475,8 @@ dxf_dimstyle_set_dimblk1
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (dimstyle == NULL)
         {
@@ -1461,7 +1492,13 @@ dxf_dimstyle_set_dimblk1
                   __FUNCTION__);
                 return (NULL);
         }
-        dimstyle->dimblk1 = strdup (dimblk1);
+        copy = dxf_string_share (dimblk1);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (dimstyle->dimblk1);
+        dimstyle->dimblk1 = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1535,6 +1572,8 @@ dxf_dimstyle_set_dimblk2
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (dimstyle == NULL)
         {
@@ -1550,7 +1589,13 @@ dxf_dimstyle_set_dimblk2
                   __FUNCTION__);
                 return (NULL);
         }
-        dimstyle->dimblk2 = strdup (dimblk2);
+        copy = dxf_string_share (dimblk2);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (dimstyle->dimblk2);
+        dimstyle->dimblk2 = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -5458,6 +5503,8 @@ dxf_dimstyle_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (dimstyle == NULL)
         {
@@ -5473,7 +5520,13 @@ dxf_dimstyle_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        dimstyle->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (dimstyle->dictionary_owner_soft);
+        dimstyle->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -5541,6 +5594,8 @@ dxf_dimstyle_set_object_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (dimstyle == NULL)
         {
@@ -5556,7 +5611,13 @@ dxf_dimstyle_set_object_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        dimstyle->object_owner_soft = strdup (object_owner_soft);
+        copy = dxf_string_share (object_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (dimstyle->object_owner_soft);
+        dimstyle->object_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -5624,6 +5685,8 @@ dxf_dimstyle_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (dimstyle == NULL)
         {
@@ -5639,7 +5702,13 @@ dxf_dimstyle_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        dimstyle->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (dimstyle->dictionary_owner_hard);
+        dimstyle->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -5707,6 +5776,8 @@ dxf_dimstyle_set_dimtxsty
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (dimstyle == NULL)
         {
@@ -5722,7 +5793,13 @@ dxf_dimstyle_set_dimtxsty
                   __FUNCTION__);
                 return (NULL);
         }
-        dimstyle->dimtxsty = strdup (dimtxsty);
+        copy = dxf_string_share (dimtxsty);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (dimstyle->dimtxsty);
+        dimstyle->dimtxsty = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -0,0 +1,712 @@
+/*!
+ * \file dimstyle_cache.c
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Functions for a cache of resolved DXF dimension styles
+ * (\c DIMSTYLE with per dimension overrides).
+ *
+ * Consumers of dimensions ask for the dimension style of every
+ * dimension, with the overrides of that dimension.\n
+ * Instead of walking the dimension style list and applying the overrides
+ * for every dimension, every distinct (style name, override set) pair is
+ * resolved once and kept in a hash table.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include "dimstyle_cache.h"
+#include <stddef.h>
+
+
+#define DXF_DIMSTYLE_CACHE_INT 0
+        /*!< \brief An \c int dimension variable. */
+
+#define DXF_DIMSTYLE_CACHE_DOUBLE 1
+        /*!< \brief A \c double dimension variable. */
+
+
+/*!
+ * \brief The numeric dimension variables by group code, with their
+ * position in a \c DxfDimStyle.
+ */
+static const struct
+{
+        int group_code;
+        size_t offset;
+        int type;
+}
+dxf_dimstyle_cache_variables[] =
+{
+        {40, offsetof (DxfDimStyle, dimscale), DXF_DIMSTYLE_CACHE_DOUBLE},
+        {41, offsetof (DxfDimStyle, dimasz), DXF_DIMSTYLE_CACHE_DOUBLE},
+        {42, offsetof (DxfDimStyle, dimexo), DXF_DIMSTYLE_CACHE_DOUBLE},
+        {43, offsetof (DxfDimStyle, dimdli), DXF_DIMSTYLE_CACHE_DOUBLE},
+        {44, offsetof (DxfDimStyle, dimexe), DXF_DIMSTYLE_CACHE_DOUBLE},
+        {45, offsetof (DxfDimStyle, dimrnd), DXF_DIMSTYLE_CACHE_DOUBLE},
+        {46, offsetof (DxfDimStyle, dimdle), DXF_DIMSTYLE_CACHE_DOUBLE},
+        {47, offsetof (DxfDimStyle, dimtp), DXF_DIMSTYLE_CACHE_DOUBLE},
+        {48, offsetof (DxfDimStyle, dimtm), DXF_DIMSTYLE_CACHE_DOUBLE},
+        {71, offsetof (DxfDimStyle, dimtol), DXF_DIMSTYLE_CACHE_INT},
+        {72, offsetof (DxfDimStyle, dimlim), DXF_DIMSTYLE_CACHE_INT},
+        {73, offsetof (DxfDimStyle, dimtih), DXF_DIMSTYLE_CACHE_INT},
+        {74, offsetof (DxfDimStyle, dimtoh), DXF_DIMSTYLE_CACHE_INT},
+        {75, offsetof (DxfDimStyle, dimse1), DXF_DIMSTYLE_CACHE_INT},
+        {76, offsetof (DxfDimStyle, dimse2), DXF_DIMSTYLE_CACHE_INT},
+        {77, offsetof (DxfDimStyle, dimtad), DXF_DIMSTYLE_CACHE_INT},
+        {78, offsetof (DxfDimStyle, dimzin), DXF_DIMSTYLE_CACHE_INT},
+        {140, offsetof (DxfDimStyle, dimtxt), DXF_DIMSTYLE_CACHE_DOUBLE},
+        {141, offsetof (DxfDimStyle, dimcen), DXF_DIMSTYLE_CACHE_DOUBLE},
+        {142, offsetof (DxfDimStyle, dimtsz), DXF_DIMSTYLE_CACHE_DOUBLE},
+        {143, offsetof (DxfDimStyle, dimaltf), DXF_DIMSTYLE_CACHE_DOUBLE},
+        {144, offsetof (DxfDimStyle, dimlfac), DXF_DIMSTYLE_CACHE_DOUBLE},
+        {145, offsetof (DxfDimStyle, dimtvp), DXF_DIMSTYLE_CACHE_DOUBLE},
+        {146, offsetof (DxfDimStyle, dimtfac), DXF_DIMSTYLE_CACHE_DOUBLE},
+        {147, offsetof (DxfDimStyle, dimgap), DXF_DIMSTYLE_CACHE_DOUBLE},
+        {170, offsetof (DxfDimStyle, dimalt), DXF_DIMSTYLE_CACHE_INT},
+        {171, offsetof (DxfDimStyle, dimaltd), DXF_DIMSTYLE_CACHE_INT},
+        {172, offsetof (DxfDimStyle, dimtofl), DXF_DIMSTYLE_CACHE_INT},
+        {173, offsetof (DxfDimStyle, dimsah), DXF_DIMSTYLE_CACHE_INT},
+        {174, offsetof (DxfDimStyle, dimtix), DXF_DIMSTYLE_CACHE_INT},
+        {175, offsetof (DxfDimStyle, dimsoxd), DXF_DIMSTYLE_CACHE_INT},
+        {176, offsetof (DxfDimStyle, dimclrd), DXF_DIMSTYLE_CACHE_INT},
+        {177, offsetof (DxfDimStyle, dimclre), DXF_DIMSTYLE_CACHE_INT},
+        {178, offsetof (DxfDimStyle, dimclrt), DXF_DIMSTYLE_CACHE_INT},
+        {270, offsetof (DxfDimStyle, dimunit), DXF_DIMSTYLE_CACHE_INT},
+        {271, offsetof (DxfDimStyle, dimdec), DXF_DIMSTYLE_CACHE_INT},
+        {272, offsetof (DxfDimStyle, dimtdec), DXF_DIMSTYLE_CACHE_INT},
+        {273, offsetof (DxfDimStyle, dimaltu), DXF_DIMSTYLE_CACHE_INT},
+        {274, offsetof (DxfDimStyle, dimalttd), DXF_DIMSTYLE_CACHE_INT},
+        {275, offsetof (DxfDimStyle, dimaunit), DXF_DIMSTYLE_CACHE_INT},
+        {280, offsetof (DxfDimStyle, dimjust), DXF_DIMSTYLE_CACHE_INT},
+        {281, offsetof (DxfDimStyle, dimsd1), DXF_DIMSTYLE_CACHE_INT},
+        {282, offsetof (DxfDimStyle, dimsd2), DXF_DIMSTYLE_CACHE_INT},
+        {283, offsetof (DxfDimStyle, dimtolj), DXF_DIMSTYLE_CACHE_INT},
+        {284, offsetof (DxfDimStyle, dimtzin), DXF_DIMSTYLE_CACHE_INT},
+        {285, offsetof (DxfDimStyle, dimaltz), DXF_DIMSTYLE_CACHE_INT},
+        {286, offsetof (DxfDimStyle, dimalttz), DXF_DIMSTYLE_CACHE_INT},
+        {287, offsetof (DxfDimStyle, dimfit), DXF_DIMSTYLE_CACHE_INT},
+        {288, offsetof (DxfDimStyle, dimupt), DXF_DIMSTYLE_CACHE_INT}
+};
+
+
+static DxfDimStyle *dxf_dimstyle_cache_find_dimstyle (DxfDimStyleCache *cache, const char *dimstyle_name);
+static void dxf_dimstyle_cache_set_defaults (DxfDimStyle *dimstyle);
+static unsigned int dxf_dimstyle_cache_hash (const char *dimstyle_name, const DxfDimStyleOverride *overrides, int number_of_overrides);
+static int dxf_dimstyle_cache_is_equal (DxfDimStyleCacheEntry *entry, const char *dimstyle_name, const DxfDimStyleOverride *overrides, int number_of_overrides);
+static int dxf_dimstyle_cache_grow (DxfDimStyleCache *cache);
+static void dxf_dimstyle_cache_free_entry (DxfDimStyleCacheEntry *entry);
+
+
+/*!
+ * \brief Allocate memory for a \c DxfDimStyleCache.
+ *
+ * Fill the memory contents with zeros.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfDimStyleCache *
+dxf_dimstyle_cache_new ()
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfDimStyleCache *cache = NULL;
+        size_t size;
+
+        size = sizeof (DxfDimStyleCache);
+        /* avoid malloc of 0 bytes */
+        if (size == 0) size = 1;
+        if ((cache = malloc (size)) == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                cache = NULL;
+        }
+        else
+        {
+                memset (cache, 0, size);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (cache);
+}
+
+
+/*!
+ * \brief Allocate memory and initialize data fields in a
+ * \c DxfDimStyleCache.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfDimStyleCache *
+dxf_dimstyle_cache_init
+(
+        DxfDimStyleCache *cache,
+                /*!< a pointer to the cache. */
+        DxfDimStyle *dimstyles
+                /*!< a pointer to the first dimension style of a list,
+                 * the list must stay valid while the cache is in use. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (cache == NULL)
+        {
+                fprintf (stderr,
+                  (_("Warning in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                cache = dxf_dimstyle_cache_new ();
+        }
+        if (cache == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        cache->dimstyles = dimstyles;
+        cache->number_of_entries = 0;
+        cache->number_of_slots = 0;
+        cache->slots = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (cache);
+}
+
+
+/*!
+ * \brief Get a resolved dimension style from a \c DxfDimStyleCache.
+ *
+ * When the dimension style is not found in the list the
+ * \c DXF_DIMSTYLE_CACHE_DEFAULT_NAME dimension style is used, and when
+ * that one is not found either the AutoCAD defaults are used.\n
+ * The overrides are applied in order of group code, of overrides with
+ * the same group code the last one wins.
+ *
+ * \return a pointer to the resolved dimension style, or \c NULL when an
+ * error occurred.
+ */
+DxfDimStyle *
+dxf_dimstyle_cache_get
+(
+        DxfDimStyleCache *cache,
+                /*!< a pointer to the cache. */
+        const char *dimstyle_name,
+                /*!< the dimension style name, \c NULL for the default
+                 * dimension style. */
+        const DxfDimStyleOverride *overrides,
+                /*!< array of overrides, may be \c NULL when there are
+                 * no overrides. */
+        int number_of_overrides
+                /*!< number of overrides. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfDimStyleCacheEntry *entry = NULL;
+        DxfDimStyleOverride *sorted = NULL;
+        DxfDimStyleOverride override;
+        DxfDimStyle *dimstyle = NULL;
+        unsigned int hash;
+        unsigned int slot;
+        int number_of_sorted;
+        int i;
+        int j;
+
+        /* Do some basic checks. */
+        if (cache == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        if ((overrides == NULL) || (number_of_overrides < 0))
+        {
+                number_of_overrides = 0;
+        }
+        if (dimstyle_name == NULL)
+        {
+                dimstyle_name = DXF_DIMSTYLE_CACHE_DEFAULT_NAME;
+        }
+        /* Bring the overrides in a canonical order: sorted on group
+         * code (stable), keeping the last of equal group codes. */
+        sorted = malloc (((number_of_overrides > 0) ? number_of_overrides : 1) * sizeof (DxfDimStyleOverride));
+        if (sorted == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        number_of_sorted = 0;
+        for (i = 0; i < number_of_overrides; i++)
+        {
+                override = overrides[i];
+                for (j = number_of_sorted; (j > 0) && (sorted[j - 1].group_code > override.group_code); j--)
+                {
+                        sorted[j] = sorted[j - 1];
+                }
+                if ((j > 0) && (sorted[j - 1].group_code == override.group_code))
+                {
+                        /* Undo the shift, replace the earlier one. */
+                        memmove (&sorted[j], &sorted[j + 1], (number_of_sorted - j) * sizeof (DxfDimStyleOverride));
+                        sorted[j - 1] = override;
+                        continue;
+                }
+                sorted[j] = override;
+                number_of_sorted++;
+        }
+        hash = dxf_dimstyle_cache_hash (dimstyle_name, sorted, number_of_sorted);
+        if (cache->number_of_slots > 0)
+        {
+                slot = hash & (cache->number_of_slots - 1);
+                while (cache->slots[slot] != NULL)
+                {
+                        if ((cache->slots[slot]->hash == hash)
+                          && dxf_dimstyle_cache_is_equal (cache->slots[slot],
+                          dimstyle_name, sorted, number_of_sorted))
+                        {
+                                free (sorted);
+                                return (&cache->slots[slot]->dimstyle);
+                        }
+                        slot = (slot + 1) & (cache->number_of_slots - 1);
+                }
+        }
+        /* Not resolved before. */
+        if (2 * (cache->number_of_entries + 1) > cache->number_of_slots)
+        {
+                if (dxf_dimstyle_cache_grow (cache) != EXIT_SUCCESS)
+                {
+                        free (sorted);
+                        return (NULL);
+                }
+        }
+        entry = malloc (sizeof (DxfDimStyleCacheEntry));
+        if (entry == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                free (sorted);
+                return (NULL);
+        }
+        entry->hash = hash;
+        entry->dimstyle_name = strdup (dimstyle_name);
+        entry->number_of_overrides = number_of_sorted;
+        entry->overrides = sorted;
+        dimstyle = dxf_dimstyle_cache_find_dimstyle (cache, dimstyle_name);
+        if (dimstyle == NULL)
+        {
+                dimstyle = dxf_dimstyle_cache_find_dimstyle (cache, DXF_DIMSTYLE_CACHE_DEFAULT_NAME);
+        }
+        if (dimstyle == NULL)
+        {
+                dxf_dimstyle_cache_set_defaults (&entry->dimstyle);
+        }
+        else
+        {
+                entry->dimstyle = *dimstyle;
+                entry->dimstyle.next = NULL;
+        }
+        for (i = 0; i < number_of_sorted; i++)
+        {
+                dxf_dimstyle_cache_apply_override (&entry->dimstyle,
+                  sorted[i].group_code, sorted[i].value);
+        }
+        slot = hash & (cache->number_of_slots - 1);
+        while (cache->slots[slot] != NULL)
+        {
+                slot = (slot + 1) & (cache->number_of_slots - 1);
+        }
+        cache->slots[slot] = entry;
+        cache->number_of_entries++;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (&entry->dimstyle);
+}
+
+
+/*!
+ * \brief Apply the override of a single numeric dimension variable to a
+ * dimension style.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when the group
+ * code is not a numeric dimension variable or an error occurred.
+ */
+int
+dxf_dimstyle_cache_apply_override
+(
+        DxfDimStyle *dimstyle,
+                /*!< a pointer to the dimension style. */
+        int group_code,
+                /*!< the group code of the dimension variable. */
+        double value
+                /*!< the value. */
+)
+{
+        char *field = NULL;
+        size_t i;
+
+        /* Do some basic checks. */
+        if (dimstyle == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        for (i = 0; i < sizeof (dxf_dimstyle_cache_variables) / sizeof (dxf_dimstyle_cache_variables[0]); i++)
+        {
+                if (dxf_dimstyle_cache_variables[i].group_code != group_code)
+                {
+                        continue;
+                }
+                field = (char *) dimstyle + dxf_dimstyle_cache_variables[i].offset;
+                if (dxf_dimstyle_cache_variables[i].type == DXF_DIMSTYLE_CACHE_DOUBLE)
+                {
+                        *((double *) field) = value;
+                }
+                else
+                {
+                        *((int *) field) = (int) value;
+                }
+                return (EXIT_SUCCESS);
+        }
+        fprintf (stderr,
+          (_("Warning in %s () unknown dimension variable group code %d.\n")),
+          __FUNCTION__, group_code);
+        return (EXIT_FAILURE);
+}
+
+
+/*!
+ * \brief Clear the contents of a \c DxfDimStyleCache, the cache itself
+ * is not freed and keeps its dimension style list.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_dimstyle_cache_clear
+(
+        DxfDimStyleCache *cache
+                /*!< a pointer to the cache. */
+)
+{
+        int i;
+
+        /* Do some basic checks. */
+        if (cache == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        for (i = 0; i < cache->number_of_slots; i++)
+        {
+                if (cache->slots[i] != NULL)
+                {
+                        dxf_dimstyle_cache_free_entry (cache->slots[i]);
+                }
+        }
+        free (cache->slots);
+        dxf_dimstyle_cache_init (cache, cache->dimstyles);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Free the allocated memory for a \c DxfDimStyleCache and all
+ * it's data fields.
+ *
+ * The dimension style list is not freed.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_dimstyle_cache_free
+(
+        DxfDimStyleCache *cache
+                /*!< a pointer to the cache. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (cache == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_dimstyle_cache_clear (cache);
+        free (cache);
+        cache = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Find a dimension style by name (case insensitive) in the
+ * list of a \c DxfDimStyleCache.
+ *
+ * \return a pointer to the dimension style, or \c NULL when not found.
+ */
+static DxfDimStyle *
+dxf_dimstyle_cache_find_dimstyle
+(
+        DxfDimStyleCache *cache,
+                /*!< a pointer to the cache. */
+        const char *dimstyle_name
+                /*!< the dimension style name. */
+)
+{
+        DxfDimStyle *iter = NULL;
+
+        for (iter = cache->dimstyles; iter != NULL; iter = (DxfDimStyle *) iter->next)
+        {
+                if ((iter->dimstyle_name != NULL)
+                  && (strcasecmp (iter->dimstyle_name, dimstyle_name) == 0))
+                {
+                        return (iter);
+                }
+        }
+        return (NULL);
+}
+
+
+/*!
+ * \brief Set the AutoCAD (imperial) defaults of the \c STANDARD
+ * dimension style.
+ */
+static void
+dxf_dimstyle_cache_set_defaults
+(
+        DxfDimStyle *dimstyle
+                /*!< a pointer to the dimension style. */
+)
+{
+        memset (dimstyle, 0, sizeof (DxfDimStyle));
+        dimstyle->dimstyle_name = DXF_DIMSTYLE_CACHE_DEFAULT_NAME;
+        dimstyle->dimpost = "";
+        dimstyle->dimapost = "";
+        dimstyle->dimblk = "";
+        dimstyle->dimblk1 = "";
+        dimstyle->dimblk2 = "";
+        dimstyle->dimscale = 1.0;
+        dimstyle->dimasz = 0.18;
+        dimstyle->dimexo = 0.0625;
+        dimstyle->dimdli = 0.38;
+        dimstyle->dimexe = 0.18;
+        dimstyle->dimtih = 1;
+        dimstyle->dimtoh = 1;
+        dimstyle->dimtxt = 0.18;
+        dimstyle->dimcen = 0.09;
+        dimstyle->dimaltf = 25.4;
+        dimstyle->dimlfac = 1.0;
+        dimstyle->dimtfac = 1.0;
+        dimstyle->dimgap = 0.09;
+        dimstyle->dimaltd = 2;
+        dimstyle->dimclrd = DXF_COLOR_BYBLOCK;
+        dimstyle->dimclre = DXF_COLOR_BYBLOCK;
+        dimstyle->dimclrt = DXF_COLOR_BYBLOCK;
+        dimstyle->dimunit = 2;
+        dimstyle->dimdec = 4;
+        dimstyle->dimtdec = 4;
+        dimstyle->dimaltu = 2;
+        dimstyle->dimalttd = 2;
+        dimstyle->dimtolj = 1;
+        dimstyle->dimfit = 3;
+        dimstyle->dictionary_owner_soft = "";
+        dimstyle->object_owner_soft = "";
+        dimstyle->dimtxsty = "";
+        dimstyle->dictionary_owner_hard = "";
+}
+
+
+/*!
+ * \brief Case insensitive FNV-1a hash of a dimension style name and a
+ * canonical override set.
+ */
+static unsigned int
+dxf_dimstyle_cache_hash
+(
+        const char *dimstyle_name,
+                /*!< the dimension style name. */
+        const DxfDimStyleOverride *overrides,
+                /*!< the sorted overrides. */
+        int number_of_overrides
+                /*!< number of overrides. */
+)
+{
+        const unsigned char *bytes = NULL;
+        unsigned int hash = 2166136261u;
+        size_t j;
+        int i;
+
+        while (*dimstyle_name != '\0')
+        {
+                hash ^= (unsigned char) toupper ((unsigned char) *dimstyle_name);
+                hash *= 16777619u;
+                dimstyle_name++;
+        }
+        for (i = 0; i < number_of_overrides; i++)
+        {
+                hash ^= (unsigned int) overrides[i].group_code;
+                hash *= 16777619u;
+                bytes = (const unsigned char *) &overrides[i].value;
+                for (j = 0; j < sizeof (double); j++)
+                {
+                        hash ^= bytes[j];
+                        hash *= 16777619u;
+                }
+        }
+        return (hash);
+}
+
+
+/*!
+ * \brief Compare the key of a cache entry with a dimension style name
+ * and a canonical override set.
+ *
+ * \return \c TRUE when equal, \c FALSE otherwise.
+ */
+static int
+dxf_dimstyle_cache_is_equal
+(
+        DxfDimStyleCacheEntry *entry,
+                /*!< a pointer to the cache entry. */
+        const char *dimstyle_name,
+                /*!< the dimension style name. */
+        const DxfDimStyleOverride *overrides,
+                /*!< the sorted overrides. */
+        int number_of_overrides
+                /*!< number of overrides. */
+)
+{
+        int i;
+
+        if ((entry->number_of_overrides != number_of_overrides)
+          || (strcasecmp (entry->dimstyle_name, dimstyle_name) != 0))
+        {
+                return (FALSE);
+        }
+        for (i = 0; i < number_of_overrides; i++)
+        {
+                if ((entry->overrides[i].group_code != overrides[i].group_code)
+                  || (memcmp (&entry->overrides[i].value, &overrides[i].value, sizeof (double)) != 0))
+                {
+                        return (FALSE);
+                }
+        }
+        return (TRUE);
+}
+
+
+/*!
+ * \brief Double the number of hash slots of a \c DxfDimStyleCache.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_dimstyle_cache_grow
+(
+        DxfDimStyleCache *cache
+                /*!< a pointer to the cache. */
+)
+{
+        DxfDimStyleCacheEntry **slots = NULL;
+        unsigned int slot;
+        int number_of_slots;
+        int i;
+
+        number_of_slots = (cache->number_of_slots == 0) ? 16 : 2 * cache->number_of_slots;
+        slots = calloc (number_of_slots, sizeof (DxfDimStyleCacheEntry *));
+        if (slots == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        for (i = 0; i < cache->number_of_slots; i++)
+        {
+                if (cache->slots[i] == NULL)
+                {
+                        continue;
+                }
+                slot = cache->slots[i]->hash & (number_of_slots - 1);
+                while (slots[slot] != NULL)
+                {
+                        slot = (slot + 1) & (number_of_slots - 1);
+                }
+                slots[slot] = cache->slots[i];
+        }
+        free (cache->slots);
+        cache->slots = slots;
+        cache->number_of_slots = number_of_slots;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Free a cache entry, the borrowed strings of its dimension
+ * style are not freed.
+ */
+static void
+dxf_dimstyle_cache_free_entry
+(
+        DxfDimStyleCacheEntry *entry
+                /*!< a pointer to the cache entry. */
+)
+{
+        free (entry->dimstyle_name);
+        free (entry->overrides);
+        free (entry);
+}
+
+
+/* EOF */
@@ -0,0 +1,134 @@
+/*!
+ * \file dimstyle_cache.h
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Header file for a cache of resolved DXF dimension styles
+ * (\c DIMSTYLE with per dimension overrides).
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#ifndef LIBDXF_SRC_DIMSTYLE_CACHE_H
+#define LIBDXF_SRC_DIMSTYLE_CACHE_H
+
+
+#include "global.h"
+#include "dimstyle.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define DXF_DIMSTYLE_CACHE_DEFAULT_NAME "STANDARD"
+        /*!< \brief Name of the dimension style used when a dimension
+         * style is not found. */
+
+
+/*!
+ * \brief Definition of an override of a single numeric dimension
+ * variable, as found in the \c ACAD \c DSTYLE extended data of a
+ * dimension.
+ */
+typedef struct
+dxf_dimstyle_override_struct
+{
+        int group_code;
+                /*!< Group code of the dimension variable in a
+                 * \c DIMSTYLE table entry (e.g. 41 for \c DIMASZ). */
+        double value;
+                /*!< The value, integer variables are truncated. */
+} DxfDimStyleOverride;
+
+
+/*!
+ * \brief Definition of a resolved dimension style in a
+ * \c DxfDimStyleCache.
+ */
+typedef struct
+dxf_dimstyle_cache_entry_struct
+{
+        unsigned int hash;
+                /*!< Hash of the dimension style name and the
+                 * overrides. */
+        char *dimstyle_name;
+                /*!< The requested dimension style name. */
+        int number_of_overrides;
+                /*!< Number of overrides. */
+        DxfDimStyleOverride *overrides;
+                /*!< The overrides, sorted on group code. */
+        DxfDimStyle dimstyle;
+                /*!< The dimension style with the overrides applied,
+                 * the strings are borrowed from the dimension style
+                 * list. */
+} DxfDimStyleCacheEntry;
+
+
+/*!
+ * \brief Definition of a cache of resolved dimension styles, keyed by
+ * dimension style name (case insensitive) and override set.
+ *
+ * A dimension style is resolved once per key, later requests for the
+ * same key return the same \c DxfDimStyle.\n
+ * The returned \c DxfDimStyle and its strings belong to the cache and
+ * the dimension style list, they must not be modified or freed.\n
+ * A cache is not safe to be shared between threads while it is
+ * filled.
+ */
+typedef struct
+dxf_dimstyle_cache_struct
+{
+        DxfDimStyle *dimstyles;
+                /*!< The dimension style list (\c DIMSTYLE table). */
+        int number_of_entries;
+                /*!< Number of resolved dimension styles. */
+        int number_of_slots;
+                /*!< Number of hash slots, a power of 2. */
+        DxfDimStyleCacheEntry **slots;
+                /*!< Hash slots, \c NULL for an empty slot. */
+} DxfDimStyleCache;
+
+
+DxfDimStyleCache *dxf_dimstyle_cache_new ();
+DxfDimStyleCache *dxf_dimstyle_cache_init (DxfDimStyleCache *cache, DxfDimStyle *dimstyles);
+DxfDimStyle *dxf_dimstyle_cache_get (DxfDimStyleCache *cache, const char *dimstyle_name, const DxfDimStyleOverride *overrides, int number_of_overrides);
+int dxf_dimstyle_cache_apply_override (DxfDimStyle *dimstyle, int group_code, double value);
+int dxf_dimstyle_cache_clear (DxfDimStyleCache *cache);
+int dxf_dimstyle_cache_free (DxfDimStyleCache *cache);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* LIBDXF_SRC_DIMSTYLE_CACHE_H */
+
+
+/* EOF */
@@ -46,6 +46,7 @@
 
 
 #include "donut.h"
+#include "util.h"
 
 
 /*!
@@ -120,8 +121,8 @@ dxf_donut_init
         }
         /* Members common for all DXF drawable entities. */
         dxf_donut_set_id_code (donut, 0);
-        dxf_donut_set_linetype (donut, strdup (DXF_DEFAULT_LINETYPE));
-        dxf_donut_set_layer (donut, strdup (DXF_DEFAULT_LAYER));
+        donut->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        donut->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         dxf_donut_set_elevation (donut, 0.0);
         dxf_donut_set_thickness (donut, 0.0);
         dxf_donut_set_linetype_scale (donut, DXF_DEFAULT_LINETYPE_SCALE);
@@ -130,14 +131,14 @@ dxf_donut_init
         dxf_donut_set_paperspace (donut, DXF_MODELSPACE);
         dxf_donut_set_graphics_data_size (donut, 0);
         dxf_donut_set_shadow_mode (donut, 0);
-        dxf_donut_set_binary_graphics_data (donut, (DxfBinaryGraphicsData *) dxf_binary_graphics_data_new ());
-        dxf_donut_set_dictionary_owner_soft (donut, strdup (""));
-        dxf_donut_set_material (donut, strdup (""));
-        dxf_donut_set_dictionary_owner_hard (donut, strdup (""));
+        donut->binary_graphics_data = NULL;
+        donut->dictionary_owner_soft = dxf_string_share ("");
+        donut->material = dxf_string_share ("");
+        donut->dictionary_owner_hard = dxf_string_share ("");
         dxf_donut_set_lineweight (donut, 0);
-        dxf_donut_set_plot_style_name (donut, strdup (""));
+        donut->plot_style_name = dxf_string_share ("");
         dxf_donut_set_color_value (donut, 0);
-        dxf_donut_set_color_name (donut, strdup (""));
+        donut->color_name = dxf_string_share ("");
         dxf_donut_set_transparency (donut, 0);
         /* Specific members for a libDXF donut. */
         dxf_donut_set_x0 (donut, 0.0);
@@ -352,10 +353,16 @@ dxf_donut_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (donut->linetype);
-        free (donut->layer);
-        free (donut->dictionary_owner_soft);
-        free (donut->dictionary_owner_hard);
+        dxf_string_free (donut->linetype);
+        dxf_string_free (donut->layer);
+        dxf_string_free (donut->dictionary_owner_soft);
+        dxf_string_free (donut->material);
+        dxf_string_free (donut->dictionary_owner_hard);
+        dxf_string_free (donut->plot_style_name);
+        if (donut->binary_graphics_data != NULL)
+        {
+                dxf_binary_graphics_data_free_list (donut->binary_graphics_data);
+        }
         free (donut);
         donut = NULL;
 #if DEBUG
@@ -535,6 +542,8 @@ dxf_donut_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (donut == NULL)
         {
@@ -550,7 +559,13 @@ dxf_donut_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        donut->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (donut->linetype);
+        donut->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -616,6 +631,8 @@ dxf_donut_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (donut == NULL)
         {
@@ -631,7 +648,13 @@ dxf_donut_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        donut->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (donut->layer);
+        donut->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1438,6 +1461,8 @@ dxf_donut_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (donut == NULL)
         {
@@ -1453,7 +1478,13 @@ dxf_donut_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        donut->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (donut->dictionary_owner_soft);
+        donut->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1522,6 +1553,8 @@ dxf_donut_set_material
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (donut == NULL)
         {
@@ -1537,7 +1570,13 @@ dxf_donut_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        donut->material = strdup (material);
+        copy = dxf_string_share (material);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (donut->material);
+        donut->material = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1605,6 +1644,8 @@ dxf_donut_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (donut == NULL)
         {
@@ -1620,7 +1661,13 @@ dxf_donut_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        donut->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (donut->dictionary_owner_hard);
+        donut->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1750,6 +1797,8 @@ dxf_donut_set_plot_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (donut == NULL)
         {
@@ -1765,7 +1814,13 @@ dxf_donut_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        donut->plot_style_name = strdup (plot_style_name);
+        copy = dxf_string_share (plot_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (donut->plot_style_name);
+        donut->plot_style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1895,6 +1950,8 @@ dxf_donut_set_color_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (donut == NULL)
         {
@@ -1910,7 +1967,13 @@ dxf_donut_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        donut->color_name = strdup (color_name);
+        copy = dxf_string_share (color_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (donut->color_name);
+        donut->color_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -0,0 +1,971 @@
+/*!
+ * \file draw_order.c
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Functions for the draw order of entities according to a DXF
+ * \c SORTENTSTABLE object.
+ *
+ * The (entity handle, sort key) pairs of a \c SORTENTSTABLE are copied
+ * once from the linked lists into contiguous arrays and sorted on
+ * handle, so the sort key of an entity is found with a binary search.\n
+ * The entities of a block record are sorted on sort key once with a
+ * stable least significant digit radix sort, after which single
+ * entities can be added, removed or given a new sort key without
+ * sorting again.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include "draw_order.h"
+
+
+static int dxf_draw_order_radix_sort (unsigned int *keys, int *index, int number_of_items);
+static int dxf_draw_order_find_key (DxfDrawOrder *order, unsigned int handle);
+static int dxf_draw_order_reserve_keys (DxfDrawOrder *order, int max_number_of_keys);
+static int dxf_draw_order_reserve_entities (DxfDrawOrder *order, int max_number_of_entities);
+static int dxf_draw_order_sort_entities (DxfDrawOrder *order);
+
+
+/*!
+ * \brief Allocate memory for a \c DxfDrawOrder.
+ *
+ * Fill the memory contents with zeros.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfDrawOrder *
+dxf_draw_order_new ()
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfDrawOrder *order = NULL;
+        size_t size;
+
+        size = sizeof (DxfDrawOrder);
+        /* avoid malloc of 0 bytes */
+        if (size == 0) size = 1;
+        if ((order = malloc (size)) == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                order = NULL;
+        }
+        else
+        {
+                memset (order, 0, size);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (order);
+}
+
+
+/*!
+ * \brief Allocate memory and initialize data fields in a
+ * \c DxfDrawOrder.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfDrawOrder *
+dxf_draw_order_init
+(
+        DxfDrawOrder *order
+                /*!< a pointer to the draw order. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (order == NULL)
+        {
+                fprintf (stderr,
+                  (_("Warning in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                order = dxf_draw_order_new ();
+        }
+        if (order == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        order->number_of_keys = 0;
+        order->max_number_of_keys = 0;
+        order->key_handle = NULL;
+        order->key_value = NULL;
+        order->number_of_entities = 0;
+        order->max_number_of_entities = 0;
+        order->entities = NULL;
+        order->entity_handle = NULL;
+        order->entity_key = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (order);
+}
+
+
+/*!
+ * \brief Find the \c SORTENTSTABLE object of a block record in a single
+ * linked list.
+ *
+ * \return a pointer to the \c SORTENTSTABLE object, or \c NULL when not
+ * found.
+ */
+DxfSortentsTable *
+dxf_draw_order_find_table
+(
+        DxfSortentsTable *sortentstables,
+                /*!< a pointer to a single linked list of DXF
+                 * \c SORTENTSTABLE objects. */
+        const char *block_owner
+                /*!< the handle of the block record. */
+)
+{
+        DxfSortentsTable *iter = NULL;
+
+        /* Do some basic checks. */
+        if (block_owner == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        for (iter = sortentstables; iter != NULL; iter = (DxfSortentsTable *) iter->next)
+        {
+                if ((iter->block_owner != NULL)
+                  && (strcasecmp (iter->block_owner, block_owner) == 0))
+                {
+                        return (iter);
+                }
+        }
+        return (NULL);
+}
+
+
+/*!
+ * \brief Copy the sort keys of a DXF \c SORTENTSTABLE object into a
+ * \c DxfDrawOrder.
+ *
+ * The entity handles (group code 331) and sort handles (group code 5)
+ * are paired in the order of the lists.\n
+ * When an entity handle occurs more than once, the last sort key is
+ * used.\n
+ * Entities already added are sorted again.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_draw_order_build
+(
+        DxfDrawOrder *order,
+                /*!< a pointer to the draw order. */
+        DxfSortentsTable *sortentstable
+                /*!< a pointer to a DXF \c SORTENTSTABLE object. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfChar *entity_owner = NULL;
+        DxfInt *sort_handle = NULL;
+        unsigned int *keys = NULL;
+        int *index = NULL;
+        int number_of_keys;
+        int i;
+        int j;
+
+        /* Do some basic checks. */
+        if ((order == NULL) || (sortentstable == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        number_of_keys = 0;
+        entity_owner = sortentstable->entity_owner;
+        sort_handle = sortentstable->sort_handle;
+        while ((entity_owner != NULL) && (sort_handle != NULL)
+          && (entity_owner->value != NULL) && (entity_owner->value[0] != '\0'))
+        {
+                number_of_keys++;
+                entity_owner = (DxfChar *) entity_owner->next;
+                sort_handle = (DxfInt *) sort_handle->next;
+        }
+        order->number_of_keys = 0;
+        if (dxf_draw_order_reserve_keys (order, number_of_keys) != EXIT_SUCCESS)
+        {
+                return (EXIT_FAILURE);
+        }
+        keys = malloc (((number_of_keys > 0) ? number_of_keys : 1) * sizeof (unsigned int));
+        index = malloc (((number_of_keys > 0) ? number_of_keys : 1) * sizeof (int));
+        if ((keys == NULL) || (index == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                free (keys);
+                free (index);
+                return (EXIT_FAILURE);
+        }
+        entity_owner = sortentstable->entity_owner;
+        sort_handle = sortentstable->sort_handle;
+        for (i = 0; i < number_of_keys; i++)
+        {
+                keys[i] = (unsigned int) strtoul (entity_owner->value, NULL, 16);
+                index[i] = i;
+                order->key_value[i] = (unsigned int) sort_handle->value;
+                entity_owner = (DxfChar *) entity_owner->next;
+                sort_handle = (DxfInt *) sort_handle->next;
+        }
+        if (dxf_draw_order_radix_sort (keys, index, number_of_keys) != EXIT_SUCCESS)
+        {
+                free (keys);
+                free (index);
+                return (EXIT_FAILURE);
+        }
+        /* Gather the sort keys in handle order, the radix sort is
+         * stable, so of duplicate handles the last one wins. */
+        j = 0;
+        for (i = 0; i < number_of_keys; i++)
+        {
+                if ((j > 0) && (order->key_handle[j - 1] == keys[i]))
+                {
+                        j--;
+                }
+                order->key_handle[j] = keys[i];
+                /* keys[j] with j <= i is no longer needed. */
+                keys[j] = order->key_value[index[i]];
+                j++;
+        }
+        memcpy (order->key_value, keys, j * sizeof (unsigned int));
+        order->number_of_keys = j;
+        free (keys);
+        free (index);
+        for (i = 0; i < order->number_of_entities; i++)
+        {
+                order->entity_key[i] = dxf_draw_order_get_sort_key (order, order->entity_handle[i]);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (dxf_draw_order_sort_entities (order));
+}
+
+
+/*!
+ * \brief Get the sort key of an entity.
+ *
+ * \return the sort key from the \c SORTENTSTABLE, or the handle of the
+ * entity when it has no entry.
+ */
+unsigned int
+dxf_draw_order_get_sort_key
+(
+        DxfDrawOrder *order,
+                /*!< a pointer to the draw order. */
+        unsigned int handle
+                /*!< the handle of the entity. */
+)
+{
+        int i;
+
+        /* Do some basic checks. */
+        if (order == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (handle);
+        }
+        i = dxf_draw_order_find_key (order, handle);
+        if ((i < order->number_of_keys) && (order->key_handle[i] == handle))
+        {
+                return (order->key_value[i]);
+        }
+        return (handle);
+}
+
+
+/*!
+ * \brief Set the sort key of an entity, e.g. for a "bring to front" or
+ * "send to back" operation.
+ *
+ * When the entity was added, it is moved to its new place in the draw
+ * order.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_draw_order_set_sort_key
+(
+        DxfDrawOrder *order,
+                /*!< a pointer to the draw order. */
+        unsigned int handle,
+                /*!< the handle of the entity. */
+        unsigned int sort_key
+                /*!< the new sort key of the entity. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        void *entity = NULL;
+        int i;
+
+        /* Do some basic checks. */
+        if (order == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        i = dxf_draw_order_find_key (order, handle);
+        if ((i == order->number_of_keys) || (order->key_handle[i] != handle))
+        {
+                if (dxf_draw_order_reserve_keys (order, order->number_of_keys + 1) != EXIT_SUCCESS)
+                {
+                        return (EXIT_FAILURE);
+                }
+                memmove (&order->key_handle[i + 1], &order->key_handle[i],
+                  (order->number_of_keys - i) * sizeof (unsigned int));
+                memmove (&order->key_value[i + 1], &order->key_value[i],
+                  (order->number_of_keys - i) * sizeof (unsigned int));
+                order->key_handle[i] = handle;
+                order->number_of_keys++;
+        }
+        order->key_value[i] = sort_key;
+        for (i = 0; i < order->number_of_entities; i++)
+        {
+                if (order->entity_handle[i] == handle)
+                {
+                        entity = order->entities[i];
+                        dxf_draw_order_remove_entity (order, handle);
+                        dxf_draw_order_add_entity (order, entity, handle);
+                        break;
+                }
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Add a batch of entities to a \c DxfDrawOrder, e.g. all
+ * entities of a block record in the order they appear in the file.
+ *
+ * All entities are sorted once, with a radix sort on their sort keys.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_draw_order_add_entities
+(
+        DxfDrawOrder *order,
+                /*!< a pointer to the draw order. */
+        void **entities,
+                /*!< array of pointers to the entities. */
+        const unsigned int *handles,
+                /*!< array of handles of the entities. */
+        int number_of_entities
+                /*!< number of entities in the arrays. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        int n;
+        int i;
+
+        /* Do some basic checks. */
+        if ((order == NULL) || (entities == NULL) || (handles == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (dxf_draw_order_reserve_entities (order, order->number_of_entities + number_of_entities) != EXIT_SUCCESS)
+        {
+                return (EXIT_FAILURE);
+        }
+        n = order->number_of_entities;
+        for (i = 0; i < number_of_entities; i++)
+        {
+                order->entities[n + i] = entities[i];
+                order->entity_handle[n + i] = handles[i];
+                order->entity_key[n + i] = dxf_draw_order_get_sort_key (order, handles[i]);
+        }
+        order->number_of_entities += number_of_entities;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (dxf_draw_order_sort_entities (order));
+}
+
+
+/*!
+ * \brief Add a single entity to a \c DxfDrawOrder.
+ *
+ * The entity is inserted at its place in the draw order, after any
+ * entities with the same sort key.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_draw_order_add_entity
+(
+        DxfDrawOrder *order,
+                /*!< a pointer to the draw order. */
+        void *entity,
+                /*!< a pointer to the entity. */
+        unsigned int handle
+                /*!< the handle of the entity. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        unsigned int key;
+        int low;
+        int high;
+        int middle;
+        int n;
+
+        /* Do some basic checks. */
+        if (order == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (dxf_draw_order_reserve_entities (order, order->number_of_entities + 1) != EXIT_SUCCESS)
+        {
+                return (EXIT_FAILURE);
+        }
+        key = dxf_draw_order_get_sort_key (order, handle);
+        /* First entity with a larger sort key. */
+        low = 0;
+        high = order->number_of_entities;
+        while (low < high)
+        {
+                middle = (low + high) / 2;
+                if (order->entity_key[middle] > key)
+                {
+                        high = middle;
+                }
+                else
+                {
+                        low = middle + 1;
+                }
+        }
+        n = order->number_of_entities - low;
+        memmove (&order->entities[low + 1], &order->entities[low], n * sizeof (void *));
+        memmove (&order->entity_handle[low + 1], &order->entity_handle[low], n * sizeof (unsigned int));
+        memmove (&order->entity_key[low + 1], &order->entity_key[low], n * sizeof (unsigned int));
+        order->entities[low] = entity;
+        order->entity_handle[low] = handle;
+        order->entity_key[low] = key;
+        order->number_of_entities++;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Remove an entity from a \c DxfDrawOrder.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred or the entity was not found.
+ */
+int
+dxf_draw_order_remove_entity
+(
+        DxfDrawOrder *order,
+                /*!< a pointer to the draw order. */
+        unsigned int handle
+                /*!< the handle of the entity. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        int n;
+        int i;
+
+        /* Do some basic checks. */
+        if (order == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        for (i = 0; i < order->number_of_entities; i++)
+        {
+                if (order->entity_handle[i] == handle)
+                {
+                        break;
+                }
+        }
+        if (i == order->number_of_entities)
+        {
+                return (EXIT_FAILURE);
+        }
+        n = order->number_of_entities - i - 1;
+        memmove (&order->entities[i], &order->entities[i + 1], n * sizeof (void *));
+        memmove (&order->entity_handle[i], &order->entity_handle[i + 1], n * sizeof (unsigned int));
+        memmove (&order->entity_key[i], &order->entity_key[i + 1], n * sizeof (unsigned int));
+        order->number_of_entities--;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Iterate over the entities of a \c DxfDrawOrder in draw order.
+ *
+ * Start with \c cursor set to 0.
+ *
+ * \return a pointer to the next entity, or \c NULL after the last
+ * entity.
+ */
+void *
+dxf_draw_order_get_next_entity
+(
+        DxfDrawOrder *order,
+                /*!< a pointer to the draw order. */
+        int *cursor
+                /*!< position of the iteration, advanced by one. */
+)
+{
+        /* Do some basic checks. */
+        if ((order == NULL) || (cursor == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        if ((*cursor < 0) || (*cursor >= order->number_of_entities))
+        {
+                return (NULL);
+        }
+        (*cursor)++;
+        return (order->entities[*cursor - 1]);
+}
+
+
+/*!
+ * \brief Clear the contents of a \c DxfDrawOrder, the draw order itself
+ * is not freed.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_draw_order_clear
+(
+        DxfDrawOrder *order
+                /*!< a pointer to the draw order. */
+)
+{
+        /* Do some basic checks. */
+        if (order == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        free (order->key_handle);
+        free (order->key_value);
+        free (order->entities);
+        free (order->entity_handle);
+        free (order->entity_key);
+        dxf_draw_order_init (order);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Free the allocated memory for a \c DxfDrawOrder and its
+ * arrays.
+ *
+ * The entities themselves are not freed.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_draw_order_free
+(
+        DxfDrawOrder *order
+                /*!< a pointer to the draw order. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (order == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_draw_order_clear (order);
+        free (order);
+        order = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Stable least significant digit radix sort of unsigned keys,
+ * carrying an index along.
+ *
+ * Byte positions in which all keys are equal are skipped.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_draw_order_radix_sort
+(
+        unsigned int *keys,
+                /*!< array of keys, sorted on return. */
+        int *index,
+                /*!< array of indices, permuted along with the keys. */
+        int number_of_items
+                /*!< number of items in the arrays. */
+)
+{
+        unsigned int *scratch_keys = NULL;
+        int *scratch_index = NULL;
+        unsigned int *source_keys = NULL;
+        int *source_index = NULL;
+        unsigned int *target_keys = NULL;
+        int *target_index = NULL;
+        unsigned int *swap_keys = NULL;
+        int *swap_index = NULL;
+        int count[256];
+        int offset;
+        int digit;
+        int shift;
+        int i;
+
+        if (number_of_items < 2)
+        {
+                return (EXIT_SUCCESS);
+        }
+        scratch_keys = malloc (number_of_items * sizeof (unsigned int));
+        scratch_index = malloc (number_of_items * sizeof (int));
+        if ((scratch_keys == NULL) || (scratch_index == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                free (scratch_keys);
+                free (scratch_index);
+                return (EXIT_FAILURE);
+        }
+        source_keys = keys;
+        source_index = index;
+        target_keys = scratch_keys;
+        target_index = scratch_index;
+        for (shift = 0; shift < 32; shift += 8)
+        {
+                memset (count, 0, sizeof (count));
+                for (i = 0; i < number_of_items; i++)
+                {
+                        count[(source_keys[i] >> shift) & 0xFF]++;
+                }
+                if (count[(source_keys[0] >> shift) & 0xFF] == number_of_items)
+                {
+                        continue;
+                }
+                offset = 0;
+                for (digit = 0; digit < 256; digit++)
+                {
+                        i = count[digit];
+                        count[digit] = offset;
+                        offset += i;
+                }
+                for (i = 0; i < number_of_items; i++)
+                {
+                        digit = (source_keys[i] >> shift) & 0xFF;
+                        target_keys[count[digit]] = source_keys[i];
+                        target_index[count[digit]] = source_index[i];
+                        count[digit]++;
+                }
+                swap_keys = source_keys;
+                source_keys = target_keys;
+                target_keys = swap_keys;
+                swap_index = source_index;
+                source_index = target_index;
+                target_index = swap_index;
+        }
+        if (source_keys != keys)
+        {
+                memcpy (keys, source_keys, number_of_items * sizeof (unsigned int));
+                memcpy (index, source_index, number_of_items * sizeof (int));
+        }
+        free (scratch_keys);
+        free (scratch_index);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Find an entity handle in the sort keys of a \c DxfDrawOrder.
+ *
+ * \return the position of the first entry with a handle not less than
+ * \c handle.
+ */
+static int
+dxf_draw_order_find_key
+(
+        DxfDrawOrder *order,
+                /*!< a pointer to the draw order. */
+        unsigned int handle
+                /*!< the handle of the entity. */
+)
+{
+        int low;
+        int high;
+        int middle;
+
+        low = 0;
+        high = order->number_of_keys;
+        while (low < high)
+        {
+                middle = (low + high) / 2;
+                if (order->key_handle[middle] < handle)
+                {
+                        low = middle + 1;
+                }
+                else
+                {
+                        high = middle;
+                }
+        }
+        return (low);
+}
+
+
+/*!
+ * \brief Grow the sort key arrays of a \c DxfDrawOrder.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_draw_order_reserve_keys
+(
+        DxfDrawOrder *order,
+                /*!< a pointer to the draw order. */
+        int max_number_of_keys
+                /*!< the number of entries to allocate room for. */
+)
+{
+        unsigned int *key_handle = NULL;
+        unsigned int *key_value = NULL;
+
+        if (max_number_of_keys <= order->max_number_of_keys)
+        {
+                return (EXIT_SUCCESS);
+        }
+        if (max_number_of_keys < 2 * order->max_number_of_keys)
+        {
+                max_number_of_keys = 2 * order->max_number_of_keys;
+        }
+        key_handle = realloc (order->key_handle, max_number_of_keys * sizeof (unsigned int));
+        if (key_handle != NULL)
+        {
+                order->key_handle = key_handle;
+        }
+        key_value = realloc (order->key_value, max_number_of_keys * sizeof (unsigned int));
+        if (key_value != NULL)
+        {
+                order->key_value = key_value;
+        }
+        if ((key_handle == NULL) || (key_value == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        order->max_number_of_keys = max_number_of_keys;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Grow the entity arrays of a \c DxfDrawOrder.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_draw_order_reserve_entities
+(
+        DxfDrawOrder *order,
+                /*!< a pointer to the draw order. */
+        int max_number_of_entities
+                /*!< the number of entities to allocate room for. */
+)
+{
+        void **entities = NULL;
+        unsigned int *entity_handle = NULL;
+        unsigned int *entity_key = NULL;
+
+        if (max_number_of_entities <= order->max_number_of_entities)
+        {
+                return (EXIT_SUCCESS);
+        }
+        if (max_number_of_entities < 2 * order->max_number_of_entities)
+        {
+                max_number_of_entities = 2 * order->max_number_of_entities;
+        }
+        entities = realloc (order->entities, max_number_of_entities * sizeof (void *));
+        if (entities != NULL)
+        {
+                order->entities = entities;
+        }
+        entity_handle = realloc (order->entity_handle, max_number_of_entities * sizeof (unsigned int));
+        if (entity_handle != NULL)
+        {
+                order->entity_handle = entity_handle;
+        }
+        entity_key = realloc (order->entity_key, max_number_of_entities * sizeof (unsigned int));
+        if (entity_key != NULL)
+        {
+                order->entity_key = entity_key;
+        }
+        if ((entities == NULL) || (entity_handle == NULL) || (entity_key == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        order->max_number_of_entities = max_number_of_entities;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Sort the entities of a \c DxfDrawOrder on their sort keys.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_draw_order_sort_entities
+(
+        DxfDrawOrder *order
+                /*!< a pointer to the draw order. */
+)
+{
+        void **entities = NULL;
+        unsigned int *handles = NULL;
+        int *index = NULL;
+        int n;
+        int i;
+
+        n = order->number_of_entities;
+        if (n < 2)
+        {
+                return (EXIT_SUCCESS);
+        }
+        entities = malloc (n * sizeof (void *));
+        handles = malloc (n * sizeof (unsigned int));
+        index = malloc (n * sizeof (int));
+        if ((entities == NULL) || (handles == NULL) || (index == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                free (entities);
+                free (handles);
+                free (index);
+                return (EXIT_FAILURE);
+        }
+        for (i = 0; i < n; i++)
+        {
+                index[i] = i;
+        }
+        if (dxf_draw_order_radix_sort (order->entity_key, index, n) != EXIT_SUCCESS)
+        {
+                free (entities);
+                free (handles);
+                free (index);
+                return (EXIT_FAILURE);
+        }
+        memcpy (entities, order->entities, n * sizeof (void *));
+        memcpy (handles, order->entity_handle, n * sizeof (unsigned int));
+        for (i = 0; i < n; i++)
+        {
+                order->entities[i] = entities[index[i]];
+                order->entity_handle[i] = handles[index[i]];
+        }
+        free (entities);
+        free (handles);
+        free (index);
+        return (EXIT_SUCCESS);
+}
+
+
+/* EOF */
@@ -0,0 +1,107 @@
+/*!
+ * \file draw_order.h
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Header file for the draw order of entities according to a DXF
+ * \c SORTENTSTABLE object.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#ifndef LIBDXF_SRC_DRAW_ORDER_H
+#define LIBDXF_SRC_DRAW_ORDER_H
+
+
+#include "global.h"
+#include "sortentstable.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*!
+ * \brief Definition of the draw order of the entities in a single block
+ * record (e.g. *MODEL_SPACE or *PAPER_SPACE).
+ *
+ * The sort keys of a \c SORTENTSTABLE object are held in contiguous
+ * arrays sorted on entity handle.\n
+ * The entities are held in draw order, that is sorted on their sort
+ * key, where an entity without an entry in the \c SORTENTSTABLE has
+ * its own handle as sort key.\n
+ * Entities with equal sort keys are drawn in the order they were
+ * added.
+ */
+typedef struct
+dxf_draw_order_struct
+{
+        int number_of_keys;
+                /*!< Number of entries from the \c SORTENTSTABLE. */
+        int max_number_of_keys;
+                /*!< Number of entries that fit in the key arrays. */
+        unsigned int *key_handle;
+                /*!< Entity handle of each entry, in ascending order. */
+        unsigned int *key_value;
+                /*!< Sort key of each entry. */
+        int number_of_entities;
+                /*!< Number of entities. */
+        int max_number_of_entities;
+                /*!< Number of entities that fit in the entity arrays. */
+        void **entities;
+                /*!< Pointers to the entities, in draw order. */
+        unsigned int *entity_handle;
+                /*!< Handle of each entity, in draw order. */
+        unsigned int *entity_key;
+                /*!< Sort key of each entity, in ascending order. */
+} DxfDrawOrder;
+
+
+DxfDrawOrder *dxf_draw_order_new ();
+DxfDrawOrder *dxf_draw_order_init (DxfDrawOrder *order);
+DxfSortentsTable *dxf_draw_order_find_table (DxfSortentsTable *sortentstables, const char *block_owner);
+int dxf_draw_order_build (DxfDrawOrder *order, DxfSortentsTable *sortentstable);
+unsigned int dxf_draw_order_get_sort_key (DxfDrawOrder *order, unsigned int handle);
+int dxf_draw_order_set_sort_key (DxfDrawOrder *order, unsigned int handle, unsigned int sort_key);
+int dxf_draw_order_add_entities (DxfDrawOrder *order, void **entities, const unsigned int *handles, int number_of_entities);
+int dxf_draw_order_add_entity (DxfDrawOrder *order, void *entity, unsigned int handle);
+int dxf_draw_order_remove_entity (DxfDrawOrder *order, unsigned int handle);
+void *dxf_draw_order_get_next_entity (DxfDrawOrder *order, int *cursor);
+int dxf_draw_order_clear (DxfDrawOrder *order);
+int dxf_draw_order_free (DxfDrawOrder *order);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* LIBDXF_SRC_DRAW_ORDER_H */
+
+
+/* EOF */
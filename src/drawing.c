@@ -35,6 +35,9 @@
 #include "drawing.h"
 
 
+static void dxf_drawing_sync_block_list (DxfDrawing *drawing);
+
+
 /*!
  * \brief Allocate memory for a libDXF \c drawing.
  *
@@ -153,12 +156,7 @@ dxf_drawing_free
                 __FUNCTION__);
               return (EXIT_FAILURE);
         }
-        dxf_header_free ((DxfHeader *) drawing->header);
-        dxf_class_free_list ((DxfClass *) drawing->class_list);
-        dxf_block_free_list ((DxfBlock *) drawing->block_list);
-        //dxf_entities_free_list ((DxfEntities *) drawing->entities_list);
-        dxf_object_free_list ((DxfObject *) drawing->object_list);
-        dxf_thumbnail_free ((DxfThumbnail *) drawing->thumbnail);
+        dxf_drawing_clear (drawing);
         free (drawing);
         drawing = NULL;
 #if DEBUG
@@ -168,6 +166,78 @@ dxf_drawing_free
 }
 
 
+/*!
+ * \brief Free the data fields of a libDXF drawing, but keep the drawing
+ * itself for reuse.
+ *
+ * All section pointers are \c NULL afterwards, the drawing can be
+ * passed to a reader again.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_drawing_clear
+(
+        DxfDrawing *drawing
+                /*!< a pointer to the libDXF drawing. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (drawing == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        /* A drawing filled by a reader only holds the sections which
+         * were present in the file. */
+        if (drawing->header != NULL)
+        {
+                dxf_header_free ((DxfHeader *) drawing->header);
+        }
+        if (drawing->class_list != NULL)
+        {
+                dxf_class_free_list ((DxfClass *) drawing->class_list);
+        }
+        if (drawing->tables_list != NULL)
+        {
+                dxf_tables_free ((DxfTables *) drawing->tables_list);
+        }
+        if (drawing->block_list != NULL)
+        {
+                dxf_block_free_list ((DxfBlock *) drawing->block_list);
+        }
+        dxf_list_clear (&drawing->blocks);
+        //dxf_entities_free_list ((DxfEntities *) drawing->entities_list);
+        if (drawing->object_list != NULL)
+        {
+                dxf_object_free_list ((DxfObject *) drawing->object_list);
+        }
+        if (drawing->thumbnail != NULL)
+        {
+                dxf_thumbnail_free ((DxfThumbnail *) drawing->thumbnail);
+        }
+        drawing->header = NULL;
+        drawing->class_list = NULL;
+        drawing->tables_list = NULL;
+        drawing->block_list = NULL;
+        drawing->entities_list = NULL;
+        drawing->object_list = NULL;
+        drawing->thumbnail = NULL;
+        dxf_handle_allocator_init (&drawing->handles);
+        memset (&drawing->stats, 0, sizeof (DxfStats));
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
 /*!
  * \brief Get the header from a libDXF drawing.
  *
@@ -496,6 +566,122 @@ dxf_drawing_set_block_list
 }
 
 
+/*!
+ * \brief Append a block to the Blocks list of a libDXF drawing.
+ *
+ * The block is linked after the last block without walking the list,
+ * the \c next member of the block is set to \c NULL.
+ *
+ * \return a pointer to the libDXF drawing when OK, \c NULL when an
+ * error occurred.
+ */
+DxfDrawing *
+dxf_drawing_append_block
+(
+        DxfDrawing *drawing,
+                /*!< a pointer to a libDXF drawing. */
+        DxfBlock *block
+                /*!< a pointer to the block. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (drawing == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        if (block == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        dxf_drawing_sync_block_list (drawing);
+        if (dxf_list_append (&drawing->blocks, block) != EXIT_SUCCESS)
+        {
+                return (NULL);
+        }
+        drawing->block_list = (struct DxfBlock *) dxf_list_get_head (&drawing->blocks);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (drawing);
+}
+
+
+/*!
+ * \brief Get the number of blocks in the Blocks list of a libDXF
+ * drawing.
+ *
+ * \return the number of blocks, or -1 when an error occurred.
+ */
+int
+dxf_drawing_get_number_of_blocks
+(
+        DxfDrawing *drawing
+                /*!< a pointer to a libDXF drawing. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (drawing == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (-1);
+        }
+        dxf_drawing_sync_block_list (drawing);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (dxf_list_get_number_of_items (&drawing->blocks));
+}
+
+
+/*!
+ * \brief Get the block at a position in the Blocks list of a libDXF
+ * drawing.
+ *
+ * \return a pointer to the block, \c NULL when the position is out of
+ * range or an error occurred.
+ */
+DxfBlock *
+dxf_drawing_get_block
+(
+        DxfDrawing *drawing,
+                /*!< a pointer to a libDXF drawing. */
+        int position
+                /*!< position of the block, starting at 0. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (drawing == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        dxf_drawing_sync_block_list (drawing);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return ((DxfBlock *) dxf_list_get_item (&drawing->blocks, position));
+}
+
+
 /*!
  * \brief Get the first entry to the Entities list from a libDXF drawing.
  *
@@ -870,4 +1056,157 @@ dxf_drawing_get_last
 }
 
 
+/*!
+ * \brief Get the handle allocator of a libDXF drawing.
+ *
+ * The allocator is seeded from the \c $HANDSEED header variable when
+ * the drawing is read, and can be shared by threads writing entities
+ * of the drawing in parallel.
+ *
+ * \return a pointer to the handle allocator, or \c NULL when an error
+ * occurred.
+ */
+DxfHandleAllocator *
+dxf_drawing_get_handle_allocator
+(
+        DxfDrawing *drawing
+                /*!< a pointer to a libDXF drawing. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (drawing == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (&drawing->handles);
+}
+
+
+/*!
+ * \brief Copy the handle seed of the handle allocator of a libDXF
+ * drawing into the \c $HANDSEED header variable.
+ *
+ * Call this function before the header of the drawing is written, so
+ * that the written handle seed exceeds every handle handed out.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_drawing_update_handle_seed
+(
+        DxfDrawing *drawing
+                /*!< a pointer to a libDXF drawing. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfHeader *header = NULL;
+        char seed[DXF_HANDLE_HEX_SIZE];
+        char *copy = NULL;
+
+        /* Do some basic checks. */
+        if (drawing == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        header = (DxfHeader *) drawing->header;
+        if (header == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was found in the header member.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_handle_allocator_get_seed_hex (&drawing->handles, seed);
+        copy = strdup (seed);
+        if (copy == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        free (header->HandSeed);
+        header->HandSeed = copy;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Get the statistics of the files read into a libDXF drawing.
+ *
+ * The counts of every file read with dxf_file_read_stream () are added
+ * to the drawing, dxf_drawing_clear () resets them.\n
+ * Under dxf_batch_process () the callback gets the statistics of a
+ * single file, the totals of all threads remain available with
+ * dxf_stats_get ().
+ *
+ * \return a pointer to the statistics, or \c NULL when an error
+ * occurred.
+ */
+DxfStats *
+dxf_drawing_get_stats
+(
+        DxfDrawing *drawing
+                /*!< a pointer to a libDXF drawing. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (drawing == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (&drawing->stats);
+}
+
+
+/*!
+ * \brief Let the list container of a libDXF drawing take over the
+ * Blocks list when it was linked by other means, e.g. with
+ * dxf_drawing_set_block_list ().
+ */
+static void
+dxf_drawing_sync_block_list
+(
+        DxfDrawing *drawing
+                /*!< a pointer to a libDXF drawing. */
+)
+{
+        if (drawing->blocks.next_offset == 0)
+        {
+                dxf_list_init (&drawing->blocks, offsetof (DxfBlock, next));
+        }
+        if ((void *) drawing->block_list != dxf_list_get_head (&drawing->blocks))
+        {
+                dxf_list_set_head (&drawing->blocks, drawing->block_list);
+        }
+}
+
+
 /* EOF*/
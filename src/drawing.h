@@ -44,7 +44,10 @@
 #include "block.h"
 #include "global.h"
 #include "entities.h"
+#include "handle.h"
+#include "list.h"
 #include "object.h"
+#include "stats.h"
 #include "thumbnail.h"
 
 
@@ -67,12 +70,21 @@ dxf_drawing_struct
         /*!< Tables section data (single linked list).*/
     struct DxfBlock *block_list;
         /*!< Blocks section data (single linked list).*/
+    DxfList blocks;
+        /*!< List container for the Blocks section data, for O(1)
+         * appends and random access.*/
     struct DxfEntities *entities_list;
         /*!< Entities section data (single linked list).*/
     struct DxfObject *object_list;
         /*!< Objects section data (single linked list).*/
     struct DxfThumbnail *thumbnail;
         /*!< Thumbnail data.*/
+    DxfHandleAllocator handles;
+        /*!< Handle allocator, the next handle is the handle seed
+         * (\c $HANDSEED).*/
+    DxfStats stats;
+        /*!< Statistics of the files read into the drawing, see
+         * dxf_stats_enable ().*/
     struct DxfDrawing *next;
                 /*!< Pointer to the next DxfDrawing.\n
                  * \c NULL in the last DxfDrawing. */
@@ -82,6 +94,7 @@ dxf_drawing_struct
 DxfDrawing *dxf_drawing_new ();
 DxfDrawing *dxf_drawing_init (DxfDrawing *drawing, int acad_version_number);
 int dxf_drawing_free (DxfDrawing *drawing);
+int dxf_drawing_clear (DxfDrawing *drawing);
 DxfHeader *dxf_drawing_get_header (DxfDrawing *drawing);
 DxfDrawing *dxf_drawing_set_header (DxfDrawing *drawing, DxfHeader *header);
 DxfClass *dxf_drawing_get_class_list (DxfDrawing *drawing);
@@ -90,6 +103,9 @@ DxfTables *dxf_drawing_get_tables_list (DxfDrawing *drawing);
 DxfDrawing *dxf_drawing_set_tables_list (DxfDrawing *drawing, DxfTables *tables_list);
 DxfBlock *dxf_drawing_get_block_list (DxfDrawing *drawing);
 DxfDrawing *dxf_drawing_set_block_list (DxfDrawing *drawing, DxfBlock *block_list);
+DxfDrawing *dxf_drawing_append_block (DxfDrawing *drawing, DxfBlock *block);
+int dxf_drawing_get_number_of_blocks (DxfDrawing *drawing);
+DxfBlock *dxf_drawing_get_block (DxfDrawing *drawing, int position);
 DxfEntities *dxf_drawing_get_entities_list (DxfDrawing *drawing);
 DxfDrawing *dxf_drawing_set_entities_list (DxfDrawing *drawing, DxfEntities *entities_list);
 DxfObject *dxf_drawing_get_object_list (DxfDrawing *drawing);
@@ -99,6 +115,9 @@ DxfDrawing *dxf_drawing_set_thumbnail (DxfDrawing *drawing, DxfThumbnail *thumbn
 DxfDrawing *dxf_drawing_get_next (DxfDrawing *drawing);
 DxfDrawing *dxf_drawing_set_next (DxfDrawing *drawing, DxfDrawing *next);
 DxfDrawing *dxf_drawing_get_last (DxfDrawing *drawing);
+DxfHandleAllocator *dxf_drawing_get_handle_allocator (DxfDrawing *drawing);
+int dxf_drawing_update_handle_seed (DxfDrawing *drawing);
+DxfStats *dxf_drawing_get_stats (DxfDrawing *drawing);
 
 
 #ifdef __cplusplus
@@ -45,20 +45,27 @@
 #include "arc.h"
 #include "attdef.h"
 #include "attrib.h"
+#include "batch.h"
 #include "binary_entity_data.h"
 #include "binary_graphics_data.h"
 #include "block.h"
 #include "block_record.h"
 #include "body.h"
+#include "boundary_index.h"
 #include "circle.h"
 #include "class.h"
 #include "color.h"
 #include "comment.h"
 #include "dictionary.h"
+#include "dictionary_tree.h"
 #include "dictionaryvar.h"
 #include "dimension.h"
+#include "dimension_regen.h"
 #include "dimstyle.h"
+#include "dimstyle_cache.h"
 #include "donut.h"
+#include "draw_order.h"
+#include "drawing.h"
 #include "ellipse.h"
 #include "endblk.h"
 #include "endsec.h"
@@ -66,42 +73,58 @@
 #include "entities.h"
 #include "entity.h"
 #include "file.h"
+#include "fill_triangulation.h"
+#include "flatten.h"
 #include "global.h"
 #include "group.h"
+#include "handle.h"
 #include "hatch.h"
+#include "hatch_fill.h"
 #include "header.h"
 #include "helix.h"
 #include "idbuffer.h"
 #include "image.h"
 #include "imagedef.h"
 #include "imagedef_reactor.h"
+#include "indexed_mesh.h"
 #include "insert.h"
 #include "layer.h"
 #include "layer_index.h"
 #include "leader.h"
 #include "line.h"
+#include "list.h"
 #include "ltype.h"
+#include "ltype_pattern.h"
 #include "lwpolyline.h"
+#include "mesh_subdivision.h"
+#include "mleader.h"
 #include "mline.h"
 #include "mlinestyle.h"
 #include "mtext.h"
+#include "mtext_layout.h"
 #include "object.h"
 #include "object_ptr.h"
 #include "oleframe.h"
 #include "ole2frame.h"
+#include "passthrough.h"
 #include "param.h"
 #include "point.h"
 #include "polyline.h"
+#include "polyline_geometry.h"
 #include "rastervariables.h"
 #include "ray.h"
 #include "region.h"
+#include "schema.h"
 #include "section.h"
 #include "seqend.h"
 #include "shape.h"
 #include "solid.h"
 #include "sortentstable.h"
 #include "spatial_filter.h"
+#include "spatial_filter_clip.h"
 #include "spatial_index.h"
+#include "stats.h"
+#include "stream_writer.h"
 #include "style.h"
 #include "table.h"
 #include "tables.h"
@@ -42,6 +42,8 @@
 
 
 #include "ellipse.h"
+#include "stats.h"
+#include "util.h"
 
 
 /*!
@@ -74,6 +76,7 @@ dxf_ellipse_new ()
         else
         {
                 memset (ellipse, 0, size);
+                dxf_stats_count_allocation (ELLIPSE, size);
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -115,8 +118,8 @@ dxf_ellipse_init
               return (NULL);
         }
         ellipse->id_code = 0;
-        ellipse->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        ellipse->layer = strdup (DXF_DEFAULT_LAYER);
+        ellipse->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        ellipse->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         ellipse->elevation = 0.0;
         ellipse->thickness = 0.0;
         ellipse->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
@@ -125,24 +128,21 @@ dxf_ellipse_init
         ellipse->paperspace = DXF_MODELSPACE;
         ellipse->graphics_data_size = 0;
         ellipse->shadow_mode = 0;
-        ellipse->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_new ();
-        ellipse->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_init (ellipse->binary_graphics_data);
-        ellipse->dictionary_owner_soft = strdup ("");
-        ellipse->object_owner_soft = strdup ("");
-        ellipse->material = strdup ("");
-        ellipse->dictionary_owner_hard = strdup ("");
+        ellipse->binary_graphics_data = NULL;
+        ellipse->dictionary_owner_soft = dxf_string_share ("");
+        ellipse->object_owner_soft = dxf_string_share ("");
+        ellipse->material = dxf_string_share ("");
+        ellipse->dictionary_owner_hard = dxf_string_share ("");
         ellipse->lineweight = 0;
-        ellipse->plot_style_name = strdup ("");
+        ellipse->plot_style_name = dxf_string_share ("");
         ellipse->color_value = 0;
-        ellipse->color_name = strdup ("");
+        ellipse->color_name = dxf_string_share ("");
         ellipse->transparency = 0;
         ellipse->p0 = dxf_point_new ();
-        ellipse->p0 = dxf_point_init (ellipse->p0);
         ellipse->p0->x0 = 0.0;
         ellipse->p0->y0 = 0.0;
         ellipse->p0->z0 = 0.0;
         ellipse->p1 = dxf_point_new ();
-        ellipse->p1 = dxf_point_init (ellipse->p1);
         ellipse->p0->x0 = 0.0;
         ellipse->p0->y0 = 0.0;
         ellipse->p0->z0 = 0.0;
@@ -232,14 +232,12 @@ dxf_ellipse_read
                 {
                         /* Now follows a string containing a linetype
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ellipse->linetype);
+                        dxf_read_string (fp, &ellipse->linetype);
                 }
                 else if (strcmp (temp_string, "8") == 0)
                 {
                         /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ellipse->layer);
+                        dxf_read_string (fp, &ellipse->layer);
                 }
                 else if (strcmp (temp_string, "10") == 0)
                 {
@@ -415,10 +413,7 @@ dxf_ellipse_read
                 {
                         /* Now follows a string containing binary
                          * graphics data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", iter310->data_line);
-                        dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) iter310->next);
-                        iter310 = (DxfBinaryGraphicsData *) iter310->next;
+                        iter310 = dxf_binary_graphics_data_read (fp, &ellipse->binary_graphics_data, iter310);
                 }
                 else if (strcmp (temp_string, "330") == 0)
                 {
@@ -426,15 +421,13 @@ dxf_ellipse_read
                         {
                                 /* Now follows a string containing a soft-pointer
                                  * ID/handle to owner dictionary. */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%s\n", ellipse->dictionary_owner_soft);
+                                dxf_read_string (fp, &ellipse->dictionary_owner_soft);
                         }
                         if (iter330 == 1)
                         {
                                 /* Now follows a string containing a soft-pointer
                                  * ID/handle to owner object. */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%s\n", ellipse->object_owner_soft);
+                                dxf_read_string (fp, &ellipse->object_owner_soft);
                         }
                         iter330++;
                 }
@@ -442,15 +435,13 @@ dxf_ellipse_read
                 {
                         /* Now follows a string containing a
                          * hard-pointer ID/handle to material object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ellipse->material);
+                        dxf_read_string (fp, &ellipse->material);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ellipse->dictionary_owner_hard);
+                        dxf_read_string (fp, &ellipse->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "370") == 0)
                 {
@@ -463,8 +454,7 @@ dxf_ellipse_read
                 {
                         /* Now follows a string containing a plot style
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ellipse->plot_style_name);
+                        dxf_read_string (fp, &ellipse->plot_style_name);
                 }
                 else if (strcmp (temp_string, "420") == 0)
                 {
@@ -476,8 +466,7 @@ dxf_ellipse_read
                 {
                         /* Now follows a string containing a color
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ellipse->color_name);
+                        dxf_read_string (fp, &ellipse->color_name);
                 }
                 else if (strcmp (temp_string, "440") == 0)
                 {
@@ -503,11 +492,13 @@ dxf_ellipse_read
         /* Handle omitted members and/or illegal values. */
         if (strcmp (ellipse->linetype, "") == 0)
         {
-                ellipse->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (ellipse->linetype);
+                ellipse->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (ellipse->layer, "") == 0)
         {
-                ellipse->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (ellipse->layer);
+                ellipse->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Clean up. */
         free (temp_string);
@@ -595,7 +586,8 @@ dxf_ellipse_write
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                ellipse->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (ellipse->linetype);
+                ellipse->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (ellipse->layer, "") == 0)
         {
@@ -605,7 +597,8 @@ dxf_ellipse_write
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0")),
                   dxf_entity_name);
-                ellipse->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (ellipse->layer);
+                ellipse->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         if (ellipse->ratio == 0.0)
         {
@@ -771,15 +764,18 @@ dxf_ellipse_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (ellipse->linetype);
-        free (ellipse->layer);
-        dxf_binary_graphics_data_free_list (ellipse->binary_graphics_data);
-        free (ellipse->dictionary_owner_soft);
-        free (ellipse->object_owner_soft);
-        free (ellipse->material);
-        free (ellipse->dictionary_owner_hard);
-        free (ellipse->plot_style_name);
-        free (ellipse->color_name);
+        dxf_string_free (ellipse->linetype);
+        dxf_string_free (ellipse->layer);
+        if (ellipse->binary_graphics_data != NULL)
+        {
+                dxf_binary_graphics_data_free_list (ellipse->binary_graphics_data);
+        }
+        dxf_string_free (ellipse->dictionary_owner_soft);
+        dxf_string_free (ellipse->object_owner_soft);
+        dxf_string_free (ellipse->material);
+        dxf_string_free (ellipse->dictionary_owner_hard);
+        dxf_string_free (ellipse->plot_style_name);
+        dxf_string_free (ellipse->color_name);
         dxf_point_free_list (ellipse->p0);
         dxf_point_free_list (ellipse->p1);
         free (ellipse);
@@ -951,6 +947,8 @@ dxf_ellipse_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (ellipse == NULL)
         {
@@ -966,7 +964,13 @@ dxf_ellipse_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        ellipse->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (ellipse->linetype);
+        ellipse->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1026,6 +1030,8 @@ dxf_ellipse_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (ellipse == NULL)
         {
@@ -1041,7 +1047,13 @@ dxf_ellipse_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        ellipse->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (ellipse->layer);
+        ellipse->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1820,6 +1832,8 @@ dxf_ellipse_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (ellipse == NULL)
         {
@@ -1835,7 +1849,13 @@ dxf_ellipse_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        ellipse->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (ellipse->dictionary_owner_soft);
+        ellipse->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1900,6 +1920,8 @@ dxf_ellipse_set_object_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (ellipse == NULL)
         {
@@ -1915,7 +1937,13 @@ dxf_ellipse_set_object_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        ellipse->object_owner_soft = strdup (object_owner_soft);
+        copy = dxf_string_share (object_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (ellipse->object_owner_soft);
+        ellipse->object_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1982,6 +2010,8 @@ dxf_ellipse_set_material
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (ellipse == NULL)
         {
@@ -1997,7 +2027,13 @@ dxf_ellipse_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        ellipse->material = strdup (material);
+        copy = dxf_string_share (material);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (ellipse->material);
+        ellipse->material = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2062,6 +2098,8 @@ dxf_ellipse_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (ellipse == NULL)
         {
@@ -2077,7 +2115,13 @@ dxf_ellipse_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        ellipse->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (ellipse->dictionary_owner_hard);
+        ellipse->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2207,6 +2251,8 @@ dxf_ellipse_set_plot_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (ellipse == NULL)
         {
@@ -2222,7 +2268,13 @@ dxf_ellipse_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        ellipse->plot_style_name = strdup (plot_style_name);
+        copy = dxf_string_share (plot_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (ellipse->plot_style_name);
+        ellipse->plot_style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2352,6 +2404,8 @@ dxf_ellipse_set_color_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (ellipse == NULL)
         {
@@ -2367,7 +2421,13 @@ dxf_ellipse_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        ellipse->color_name = strdup (color_name);
+        copy = dxf_string_share (color_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (ellipse->color_name);
+        ellipse->color_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
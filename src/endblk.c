@@ -40,6 +40,7 @@
 
 
 #include "endblk.h"
+#include "util.h"
 
 
 /*!
@@ -112,8 +113,8 @@ dxf_endblk_init
                 return (NULL);
         }
         endblk->id_code = 0;
-        endblk->layer = strdup (DXF_DEFAULT_LAYER);
-        endblk->object_owner_soft = strdup ("");
+        endblk->layer = dxf_string_share (DXF_DEFAULT_LAYER);
+        endblk->object_owner_soft = dxf_string_share ("");
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -191,13 +192,13 @@ dxf_endblk_read
                 else if (strcmp (temp_string, "8") == 0)
                 {
                         /* Now follows a string containing a layer name. */
-                        fscanf (fp->fp, "%s\n", endblk->layer);
+                        dxf_read_string (fp, &endblk->layer);
                 }
                 else if (strcmp (temp_string, "330") == 0)
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to owner object. */
-                        fscanf (fp->fp, "%s\n", endblk->object_owner_soft);
+                        dxf_read_string (fp, &endblk->object_owner_soft);
                 }
                 else if (strcmp (temp_string, "999") == 0)
                 {
@@ -215,7 +216,8 @@ dxf_endblk_read
         /* Handle ommitted members and/or illegal values. */
         if (strcmp (endblk->layer, "") == 0)
         {
-                endblk->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (endblk->layer);
+                endblk->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Clean up. */
         free (temp_string);
@@ -318,8 +320,8 @@ dxf_endblk_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (endblk->layer);
-        free (endblk->object_owner_soft);
+        dxf_string_free (endblk->layer);
+        dxf_string_free (endblk->object_owner_soft);
         free (endblk);
         endblk = NULL;
 #if DEBUG
@@ -462,6 +464,8 @@ dxf_endblk_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (endblk == NULL)
         {
@@ -477,7 +481,13 @@ dxf_endblk_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        endblk->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (endblk->layer);
+        endblk->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -545,6 +555,8 @@ dxf_endblk_set_object_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (endblk == NULL)
         {
@@ -560,7 +572,13 @@ dxf_endblk_set_object_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        endblk->object_owner_soft = strdup (object_owner_soft);
+        copy = dxf_string_share (object_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (endblk->object_owner_soft);
+        endblk->object_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
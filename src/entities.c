@@ -55,6 +55,9 @@
 #include "entities.h"
 
 
+static void **dxf_entities_get_list_member (DxfEntities *entities, DxfEntityType type, size_t *next_offset);
+
+
 /*!
  * \brief Allocate memory for a DXF \c ENTITIES section.
  *
@@ -107,6 +110,9 @@ dxf_entities_init
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        size_t next_offset;
+        int i;
+
         /* Do some basic checks. */
         if (entities == NULL)
         {
@@ -166,6 +172,11 @@ dxf_entities_init
         entities->viewport_list = NULL;
         //entities->wipeout_list = NULL;
         //entities->xline_list = NULL;
+        for (i = 0; i < DXF_ENTITIES_NUMBER_OF_TYPES; i++)
+        {
+                dxf_entities_get_list_member (entities, (DxfEntityType) i, &next_offset);
+                dxf_list_init (&entities->lists[i], next_offset);
+        }
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -243,6 +254,8 @@ dxf_entities_free
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        int i;
+
         if (entities == NULL)
         {
                 fprintf (stderr,
@@ -294,6 +307,10 @@ dxf_entities_free
         dxf_viewport_free_list ((DxfViewport *) entities->viewport_list);
         //dxf_wipeout_free_list (DxfWipeout *) entities->wipeout_list);
         //dxf_xline_free_list (DxfXLine *) entities->xline_list);
+        for (i = 0; i < DXF_ENTITIES_NUMBER_OF_TYPES; i++)
+        {
+                dxf_list_clear (&entities->lists[i]);
+        }
         free (entities);
         entities = NULL;
 #if DEBUG
@@ -303,4 +320,273 @@ dxf_entities_free
 }
 
 
+/*!
+ * \brief Append an entity to its list in a DXF \c ENTITIES section.
+ *
+ * The entity is linked after the last entity of the same type without
+ * walking the list, the \c next member of the entity is set to
+ * \c NULL.\n
+ * A list that was linked by other means is walked once on the next
+ * append.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_entities_append
+(
+        DxfEntities *entities,
+                /*!< DXF entities section. */
+        void *entity,
+                /*!< a pointer to the entity. */
+        DxfEntityType type
+                /*!< type of the entity. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        void **list_member = NULL;
+        size_t next_offset;
+
+        /* Do some basic checks. */
+        if ((entities == NULL) || (entity == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        list_member = dxf_entities_get_list_member (entities, type, &next_offset);
+        if (list_member == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () entity type %d has no list in the ENTITIES section.\n")),
+                  __FUNCTION__, (int) type);
+                return (EXIT_FAILURE);
+        }
+        /* Take over a list that was linked by other means. */
+        if (*list_member != dxf_list_get_head (&entities->lists[type]))
+        {
+                dxf_list_set_head (&entities->lists[type], *list_member);
+        }
+        if (dxf_list_append (&entities->lists[type], entity) != EXIT_SUCCESS)
+        {
+                return (EXIT_FAILURE);
+        }
+        *list_member = dxf_list_get_head (&entities->lists[type]);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Get the number of entities of a type in a DXF \c ENTITIES
+ * section.
+ *
+ * \return the number of entities, or -1 when an error occurred.
+ */
+int
+dxf_entities_get_number_of_entities
+(
+        DxfEntities *entities,
+                /*!< DXF entities section. */
+        DxfEntityType type
+                /*!< type of the entities. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (entities == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (-1);
+        }
+        if (((int) type < 0) || ((int) type >= DXF_ENTITIES_NUMBER_OF_TYPES))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () an invalid entity type was passed.\n")),
+                  __FUNCTION__);
+                return (-1);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (dxf_list_get_number_of_items (&entities->lists[type]));
+}
+
+
+/*!
+ * \brief Get the entity at a position in the list of a type in a DXF
+ * \c ENTITIES section.
+ *
+ * \return a pointer to the entity, \c NULL when the position is out of
+ * range or an error occurred.
+ */
+void *
+dxf_entities_get_entity
+(
+        DxfEntities *entities,
+                /*!< DXF entities section. */
+        DxfEntityType type,
+                /*!< type of the entity. */
+        int position
+                /*!< position of the entity in its list, starting at 0. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (entities == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        if (((int) type < 0) || ((int) type >= DXF_ENTITIES_NUMBER_OF_TYPES))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () an invalid entity type was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (dxf_list_get_item (&entities->lists[type], position));
+}
+
+
+/*!
+ * \brief Get the address of the list member for an entity type in a
+ * DXF \c ENTITIES section.
+ *
+ * \return the address of the member, \c NULL when the section has no
+ * list for the entity type.
+ */
+static void **
+dxf_entities_get_list_member
+(
+        DxfEntities *entities,
+                /*!< DXF entities section. */
+        DxfEntityType type,
+                /*!< type of the entity. */
+        size_t *next_offset
+                /*!< offset of the \c next member in the entity
+                 * struct, 0 when the section has no list. */
+)
+{
+        switch (type)
+        {
+                case DFACE:
+                        *next_offset = offsetof (Dxf3dface, next);
+                        return ((void **) &entities->dface_list);
+                case DSOLID:
+                        *next_offset = offsetof (Dxf3dsolid, next);
+                        return ((void **) &entities->dsolid_list);
+                case ACADPROXYENTITY:
+                        *next_offset = offsetof (DxfAcadProxyEntity, next);
+                        return ((void **) &entities->acad_proxy_entity_list);
+                case ARC:
+                        *next_offset = offsetof (DxfArc, next);
+                        return ((void **) &entities->arc_list);
+                case ATTDEF:
+                        *next_offset = offsetof (DxfAttdef, next);
+                        return ((void **) &entities->attdef_list);
+                case ATTRIB:
+                        *next_offset = offsetof (DxfAttrib, next);
+                        return ((void **) &entities->attrib_list);
+                case BODY:
+                        *next_offset = offsetof (DxfBody, next);
+                        return ((void **) &entities->body_list);
+                case CIRCLE:
+                        *next_offset = offsetof (DxfCircle, next);
+                        return ((void **) &entities->circle_list);
+                case DIMENSION:
+                        *next_offset = offsetof (DxfDimension, next);
+                        return ((void **) &entities->dimension_list);
+                case ELLIPSE:
+                        *next_offset = offsetof (DxfEllipse, next);
+                        return ((void **) &entities->ellipse_list);
+                case HATCH:
+                        *next_offset = offsetof (DxfHatch, next);
+                        return ((void **) &entities->hatch_list);
+                case IMAGE:
+                        *next_offset = offsetof (DxfImage, next);
+                        return ((void **) &entities->image_list);
+                case INSERT:
+                        *next_offset = offsetof (DxfInsert, next);
+                        return ((void **) &entities->insert_list);
+                case LEADER:
+                        *next_offset = offsetof (DxfLeader, next);
+                        return ((void **) &entities->leader_list);
+                case LIGHT:
+                        *next_offset = offsetof (DxfLight, next);
+                        return ((void **) &entities->light_list);
+                case LINE:
+                        *next_offset = offsetof (DxfLine, next);
+                        return ((void **) &entities->line_list);
+                case LWPOLYLINE:
+                        *next_offset = offsetof (DxfLWPolyline, next);
+                        return ((void **) &entities->lw_polyline_list);
+                case MTEXT:
+                        *next_offset = offsetof (DxfMtext, next);
+                        return ((void **) &entities->mtext_list);
+                case OLEFRAME:
+                        *next_offset = offsetof (DxfOleFrame, next);
+                        return ((void **) &entities->oleframe_list);
+                case OLE2FRAME:
+                        *next_offset = offsetof (DxfOle2Frame, next);
+                        return ((void **) &entities->ole2frame_list);
+                case POINT:
+                        *next_offset = offsetof (DxfPoint, next);
+                        return ((void **) &entities->point_list);
+                case POLYLINE:
+                        *next_offset = offsetof (DxfPolyline, next);
+                        return ((void **) &entities->polyline_list);
+                case RAY:
+                        *next_offset = offsetof (DxfRay, next);
+                        return ((void **) &entities->ray_list);
+                case REGION:
+                        *next_offset = offsetof (DxfRegion, next);
+                        return ((void **) &entities->region_list);
+                case SHAPE:
+                        *next_offset = offsetof (DxfShape, next);
+                        return ((void **) &entities->shape_list);
+                case SOLID:
+                        *next_offset = offsetof (DxfSolid, next);
+                        return ((void **) &entities->solid_list);
+                case TABLE:
+                        *next_offset = offsetof (DxfTable, next);
+                        return ((void **) &entities->table_list);
+                case TEXT:
+                        *next_offset = offsetof (DxfText, next);
+                        return ((void **) &entities->text_list);
+                case TOLERANCE:
+                        *next_offset = offsetof (DxfTolerance, next);
+                        return ((void **) &entities->tolerance_list);
+                case TRACE:
+                        *next_offset = offsetof (DxfTrace, next);
+                        return ((void **) &entities->trace_list);
+                case VERTEX:
+                        *next_offset = offsetof (DxfVertex, next);
+                        return ((void **) &entities->vertex_list);
+                case VIEWPORT:
+                        *next_offset = offsetof (DxfViewport, next);
+                        return ((void **) &entities->viewport_list);
+                default:
+                        *next_offset = 0;
+                        return (NULL);
+        }
+}
+
+
 /* EOF */
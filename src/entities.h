@@ -75,6 +75,7 @@
 #include "leader.h"
 #include "light.h"
 #include "line.h"
+#include "list.h"
 #include "lwpolyline.h"
 //#include "mesh.h"
 #include "mline.h"
@@ -107,6 +108,10 @@ extern "C" {
 #endif
 
 
+#define DXF_ENTITIES_NUMBER_OF_TYPES (XLINE + 1)
+        /*!< \brief The number of entity types in \c DxfEntityType. */
+
+
 /*!
  * \brief Definition of a DXF entity container.
  */
@@ -157,6 +162,9 @@ dxf_entities_struct
     struct DxfViewport *viewport_list;
     //struct DxfWipeout *wipeout_list;
     //struct DxfXLine *xline_list;
+    DxfList lists[DXF_ENTITIES_NUMBER_OF_TYPES];
+        /*!< List containers for the entity lists above, indexed by
+         * entity type, for O(1) appends and random access. */
 } DxfEntities;
 
 
@@ -165,6 +173,9 @@ DxfEntities *dxf_entities_init (DxfEntities *entities);
 int dxf_entities_read_table (char *filename, FILE *fp, int line_number, char *dxf_entities_list, int acad_version_number);
 int dxf_entities_write_table (char *dxf_entities_list, int acad_version_number);
 int dxf_entities_free (DxfEntities *entities);
+int dxf_entities_append (DxfEntities *entities, void *entity, DxfEntityType type);
+int dxf_entities_get_number_of_entities (DxfEntities *entities, DxfEntityType type);
+void *dxf_entities_get_entity (DxfEntities *entities, DxfEntityType type, int position);
 
 
 #ifdef __cplusplus
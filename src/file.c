@@ -38,22 +38,18 @@
 
 
 #include "file.h"
-
-
-char *dxf_entities_list;
-char *dxf_objects_list;
-char *dxf_blocks_list;
-DxfThumbnail *dxf_thumbnail;
+#include "drawing.h"
 
 
 /*!
  * \brief Function opens and reads a DXF file.
- * 
- * After opening the DXF file with the name \c filename the file is read
- * line by line until a line containing the \c SECTION keyword is
- * encountered.\n
- * At this point a function which reads the \c SECTION until the
- * \c ENDSEC keyword is encountered and the invoked fuction returns here.
+ *
+ * The contents of the DXF file are parsed into a temporary drawing which
+ * is discarded afterwards, use dxf_file_read_drawing () to keep the
+ * parsed data.
+ *
+ * \note This function is reentrant, all parse state lives in the
+ * temporary drawing and the \c DxfFile handle of this call.
  */
 int
 dxf_file_read
@@ -62,11 +58,65 @@ dxf_file_read
                 /*!< filename of input file (or device). */
 )
 {
-        char temp_string[DXF_MAX_STRING_LENGTH];
-        DxfFile *fp;
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        DxfDrawing *drawing = NULL;
+        int result;
+
+        drawing = dxf_drawing_new ();
+        if (drawing == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory for a DxfDrawing struct.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        result = dxf_file_read_drawing (filename, drawing);
+        dxf_drawing_free (drawing);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (result);
+}
+
+
+/*!
+ * \brief Function opens and reads a DXF file into a drawing.
+ *
+ * The file is opened with dxf_read_init () and parsed with
+ * dxf_file_read_stream ().
+ *
+ * \note This function is reentrant, all parse state lives in the
+ * \c drawing supplied by the caller and in the \c DxfFile handle which
+ * is opened and closed by this call.\n
+ * Different threads may read different files at the same time as long as
+ * every thread passes its own \c drawing.
+ */
+int
+dxf_file_read_drawing
+(
+        char *filename,
+                /*!< filename of input file (or device). */
+        DxfDrawing *drawing
+                /*!< a pointer to the drawing receiving the parsed
+                 * data. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfFile *fp;
+        int result;
+
+        /* Do some basic checks. */
+        if (drawing == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
         /* open the file */
         fp = dxf_read_init (filename);
         if (fp == NULL)
@@ -76,11 +126,81 @@ dxf_file_read
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        while (fp)
+        result = dxf_file_read_stream (fp, drawing);
+        dxf_read_close (fp);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (result);
+}
+
+
+/*!
+ * \brief Function reads a DXF file from an opened file handle into a
+ * drawing.
+ * 
+ * The file is read line by line until a line containing the \c SECTION
+ * keyword is encountered.\n
+ * At this point a function which reads the \c SECTION until the
+ * \c ENDSEC keyword is encountered and the invoked fuction returns here.\n
+ * Reading stops at the \c EOF marker or at the end of the file.\n
+ * The file handle is left open, this allows a caller to reuse its own
+ * handle and stdio buffer for many files (see dxf_batch_process ()).
+ * The statistics of the file are added to the statistics of
+ * \c drawing, see dxf_drawing_get_stats ().
+ *
+ * \note This function is reentrant, all parse state lives in \c fp
+ * and \c drawing.
+ */
+int
+dxf_file_read_stream
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        DxfDrawing *drawing
+                /*!< a pointer to the drawing receiving the parsed
+                 * data. */
+)
+{
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        char *group_code;
+        DxfStats stats;
+        DxfStats *file_stats = NULL;
+        int result = EXIT_SUCCESS;
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (fp == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL file pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (drawing == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        /* Count this file on its own, the counts are folded into the
+         * drawing (and the statistics of fp, if any) afterwards. */
+        memset (&stats, 0, sizeof (DxfStats));
+        file_stats = fp->stats;
+        fp->stats = &stats;
+        while (!feof (fp->fp) && !ferror (fp->fp))
         {
                 memset(temp_string, 0, sizeof(temp_string));
-                dxf_read_line (temp_string, fp);
-                if (strcmp (temp_string, "999") == 0)
+                if (dxf_read_line (temp_string, fp) <= 0)
+                {
+                        /* Nothing left to read. */
+                        break;
+                }
+                /* Group codes may be padded with leading spaces. */
+                group_code = temp_string + strspn (temp_string, " ");
+                if (strcmp (group_code, "999") == 0)
                 {
                         /* Flush dxf comments to stdout as some apps put meta
                          * data regarding the correct loading of libraries in
@@ -89,26 +209,29 @@ dxf_file_read
                         dxf_read_line (temp_string, fp);
                         fprintf (stdout, "DXF comment: %s\n", temp_string);
                 }
-                else if (strcmp (temp_string, "0") == 0)
+                else if (strcmp (group_code, "0") == 0)
                 {
-                /* Now follows some meaningfull dxf data. */
-                        while (!feof (fp->fp))
+                        /* Now follows some meaningfull dxf data. */
+                        memset(temp_string, 0, sizeof(temp_string));
+                        dxf_read_line (temp_string, fp);
+                        if (strcmp (temp_string, "SECTION") == 0)
+                        {
+                                /* We have found the beginning of a
+                                 * SECTION. */
+                                dxf_section_read (fp, drawing);
+                        }
+                        else if (strcmp (temp_string, "EOF") == 0)
+                        {
+                                /* We have found the end of the file. */
+                                break;
+                        }
+                        else
                         {
-                                dxf_read_line (temp_string, fp);
-                                if (strcmp (temp_string, "SECTION") == 0)
-                                {
-                                         /* We have found the beginning of a
-                                          * SECTION. */
-                                        dxf_section_read (fp);
-                                }
-                                else
-                                {
-                                         /* We were expecting a dxf SECTION and
-                                          * got something else. */
-                                        fprintf (stderr,
-                                          (_("Warning: in line %d \"SECTION\" was expected, \"%s\" was found.\n")),
-                                          fp->line_number, temp_string);
-                                }
+                                /* We were expecting a dxf SECTION and
+                                 * got something else. */
+                                fprintf (stderr,
+                                  (_("Warning: in line %d \"SECTION\" was expected, \"%s\" was found.\n")),
+                                  fp->line_number, temp_string);
                         }
                 }
                 else
@@ -116,14 +239,20 @@ dxf_file_read
                         fprintf (stderr,
                           (_("Warning: unexpected string encountered while reading line %d from: %s.\n")),
                           fp->line_number , fp->filename);
-                        return (EXIT_FAILURE);
+                        result = EXIT_FAILURE;
+                        break;
                 }
         }
-        dxf_read_close (fp);
+        fp->stats = file_stats;
+        dxf_stats_merge (&drawing->stats, &stats);
+        if (file_stats != NULL)
+        {
+                dxf_stats_merge (file_stats, &stats);
+        }
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (EXIT_SUCCESS);
+        return (result);
 }
 
 
@@ -146,11 +275,6 @@ dxf_file_write
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        extern char *dxf_entities_list;
-        extern char *dxf_objects_list;
-//        DxfBlock *dxf_blocks_list;
-        extern DxfThumbnail *dxf_thumbnail;
-
         /* Do some basic checks. */
         if (fp == NULL)
         {
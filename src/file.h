@@ -57,7 +57,14 @@ extern "C" {
 #endif
 
 
+struct dxf_drawing_struct;
+        /* Declared in drawing.h, which can not be included here
+         * without creating an include cycle. */
+
+
 int dxf_file_read (char *filename);
+int dxf_file_read_drawing (char *filename, struct dxf_drawing_struct *drawing);
+int dxf_file_read_stream (DxfFile *fp, struct dxf_drawing_struct *drawing);
 int dxf_file_write (DxfFile *fp, DxfHeader dxf_header, DxfClass dxf_classes_list, DxfTable dxf_tables_list);
 int dxf_file_write_eof (DxfFile *fp);
 
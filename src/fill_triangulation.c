@@ -0,0 +1,1706 @@
+/*!
+ * \file fill_triangulation.c
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * Functions for triangulating the filled area of DXF
+ * entities (\c HATCH, \c SOLID, \c TRACE and \c DONUT).
+ *
+ * The boundary loops of a hatch are flattened, the nesting of the loops
+ * decides with the island detection style which loops are filled areas
+ * and which are holes.\n
+ * Every hole is joined to the loop around it by a bridge (a pair of
+ * coinciding edges) from its rightmost vertex to a vertex of the outer
+ * loop that is visible from it, and the resulting single polygon is
+ * triangulated by ear clipping.\n
+ * Solids and traces are split into one or two triangles directly, a
+ * donut into a ring (or a fan when the inside diameter is zero).
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include <pthread.h>
+
+#include "fill_triangulation.h"
+
+
+/*!
+ * \brief A flattened boundary loop.
+ */
+typedef struct
+dxf_fill_loop_struct
+{
+        int first;
+                /*!< Index of the first vertex of the loop. */
+        int number_of_vertices;
+                /*!< Number of vertices of the loop. */
+        double area;
+                /*!< Signed area, positive when counterclockwise. */
+        int depth;
+                /*!< Number of loops around this loop. */
+        int parent;
+                /*!< The smallest loop around this loop, -1 when none. */
+        int rightmost;
+                /*!< Index of the vertex with the largest X-coordinate. */
+        double max_x;
+                /*!< The largest X-coordinate. */
+} DxfFillLoop;
+
+
+/*!
+ * \brief A polygon as a double linked ring of nodes.
+ *
+ * Several nodes may refer to the same vertex, the ends of a bridge to
+ * a hole appear twice in the ring.
+ */
+typedef struct
+dxf_fill_ring_struct
+{
+        const double *x;
+                /*!< Array of X-coordinates of the vertices. */
+        const double *y;
+                /*!< Array of Y-coordinates of the vertices. */
+        int *vertex;
+                /*!< Vertex index of each node. */
+        int *next;
+                /*!< Next node of each node. */
+        int *prev;
+                /*!< Previous node of each node. */
+        int number_of_nodes;
+                /*!< Number of nodes in use. */
+} DxfFillRing;
+
+
+/*!
+ * \brief Work item for a thread triangulating a range of entities.
+ */
+typedef struct
+dxf_fill_job_struct
+{
+        void **entities;
+                /*!< Array of all entities. */
+        DxfEntityType *entity_types;
+                /*!< Array of all entity types. */
+        double tolerance;
+                /*!< Flattening tolerance. */
+        DxfFillTriangles *results;
+                /*!< Array of triangle buffers, one per entity. */
+        int begin;
+                /*!< First entity of this job. */
+        int end;
+                /*!< One past the last entity of this job. */
+        int status;
+                /*!< \c EXIT_SUCCESS or \c EXIT_FAILURE. */
+} DxfFillJob;
+
+
+static int dxf_fill_triangles_add_vertex (DxfFillTriangles *triangles, double x, double y);
+static int dxf_fill_triangles_add_triangle (DxfFillTriangles *triangles, int a, int b, int c);
+static int dxf_fill_triangulate_quad (DxfFillTriangles *triangles, DxfPoint *p0, DxfPoint *p1, DxfPoint *p2, DxfPoint *p3);
+static int dxf_fill_triangulate_polygon (DxfFillTriangles *triangles, DxfFillLoop *loops, int number_of_loops, int outer, int *holes);
+static int dxf_fill_loop_contains (DxfFillTriangles *triangles, DxfFillLoop *loop, double x, double y);
+static int dxf_fill_ring_add_loop (DxfFillRing *ring, DxfFillLoop *loop, int reverse);
+static int dxf_fill_ring_bridge (DxfFillRing *ring, int outer, int hole);
+static void dxf_fill_ring_split (DxfFillRing *ring, int a, int b);
+static int dxf_fill_ring_filter (DxfFillRing *ring, int start, int *number_of_nodes);
+static int dxf_fill_ring_is_ear (DxfFillRing *ring, int ear);
+static int dxf_fill_ring_locally_inside (DxfFillRing *ring, int a, int b);
+static int dxf_fill_point_in_triangle (double ax, double ay, double bx, double by, double cx, double cy, double px, double py);
+static double dxf_fill_cross (const double *x, const double *y, int a, int b, int c);
+static void *dxf_fill_run_job (void *data);
+
+
+/*!
+ * \brief Allocate memory for a \c DxfFillTriangles.
+ *
+ * Fill the memory contents with zeros.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfFillTriangles *
+dxf_fill_triangles_new ()
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfFillTriangles *triangles = NULL;
+        size_t size;
+
+        size = sizeof (DxfFillTriangles);
+        /* avoid malloc of 0 bytes */
+        if (size == 0) size = 1;
+        if ((triangles = malloc (size)) == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                triangles = NULL;
+        }
+        else
+        {
+                memset (triangles, 0, size);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (triangles);
+}
+
+
+/*!
+ * \brief Allocate memory and initialize data fields in a
+ * \c DxfFillTriangles.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfFillTriangles *
+dxf_fill_triangles_init
+(
+        DxfFillTriangles *triangles
+                /*!< a pointer to the triangle buffer. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (triangles == NULL)
+        {
+                fprintf (stderr,
+                  (_("Warning in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                triangles = dxf_fill_triangles_new ();
+        }
+        if (triangles == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        triangles->x = NULL;
+        triangles->y = NULL;
+        triangles->number_of_vertices = 0;
+        triangles->max_number_of_vertices = 0;
+        triangles->indices = NULL;
+        triangles->number_of_triangles = 0;
+        triangles->max_number_of_triangles = 0;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (triangles);
+}
+
+
+/*!
+ * \brief Make room for at least \c max_number_of_vertices vertices and
+ * \c max_number_of_triangles triangles in a \c DxfFillTriangles.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_fill_triangles_reserve
+(
+        DxfFillTriangles *triangles,
+                /*!< a pointer to the triangle buffer. */
+        int max_number_of_vertices,
+                /*!< number of vertices that should fit. */
+        int max_number_of_triangles
+                /*!< number of triangles that should fit. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        double *x = NULL;
+        double *y = NULL;
+        int *indices = NULL;
+
+        /* Do some basic checks. */
+        if (triangles == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (max_number_of_vertices > triangles->max_number_of_vertices)
+        {
+                x = realloc (triangles->x, max_number_of_vertices * sizeof (double));
+                if (x != NULL)
+                {
+                        triangles->x = x;
+                }
+                y = realloc (triangles->y, max_number_of_vertices * sizeof (double));
+                if (y != NULL)
+                {
+                        triangles->y = y;
+                }
+                if ((x == NULL) || (y == NULL))
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () could not allocate memory.\n")),
+                          __FUNCTION__);
+                        return (EXIT_FAILURE);
+                }
+                triangles->max_number_of_vertices = max_number_of_vertices;
+        }
+        if (max_number_of_triangles > triangles->max_number_of_triangles)
+        {
+                indices = realloc (triangles->indices, 3 * max_number_of_triangles * sizeof (int));
+                if (indices == NULL)
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () could not allocate memory.\n")),
+                          __FUNCTION__);
+                        return (EXIT_FAILURE);
+                }
+                triangles->indices = indices;
+                triangles->max_number_of_triangles = max_number_of_triangles;
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Clear the contents of a \c DxfFillTriangles, the triangle
+ * buffer itself is not freed.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_fill_triangles_clear
+(
+        DxfFillTriangles *triangles
+                /*!< a pointer to the triangle buffer. */
+)
+{
+        /* Do some basic checks. */
+        if (triangles == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        free (triangles->x);
+        free (triangles->y);
+        free (triangles->indices);
+        dxf_fill_triangles_init (triangles);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Free the allocated memory for a \c DxfFillTriangles and all
+ * it's data fields.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_fill_triangles_free
+(
+        DxfFillTriangles *triangles
+                /*!< a pointer to the triangle buffer. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (triangles == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_fill_triangles_clear (triangles);
+        free (triangles);
+        triangles = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Triangulate the area inside flattened boundary loops.
+ *
+ * Every path in the \c boundary is taken as a closed loop, repeated
+ * vertices are dropped.\n
+ * With the normal style loops nested an even number of times are
+ * filled and the loops directly inside them are holes, with the outer
+ * style only the outermost loops are filled with the loops directly
+ * inside them as holes, with the ignore style the outermost loops are
+ * filled without holes.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_fill_triangulate_loops
+(
+        DxfFlattenBuffer *boundary,
+                /*!< a pointer to a buffer with flattened loops. */
+        int style,
+                /*!< island detection style, one of
+                 * \c DXF_BOUNDARY_INDEX_STYLE_NORMAL,
+                 * \c DXF_BOUNDARY_INDEX_STYLE_OUTER or
+                 * \c DXF_BOUNDARY_INDEX_STYLE_IGNORE. */
+        DxfFillTriangles *triangles
+                /*!< a pointer to the triangle buffer receiving the
+                 * result. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfFillLoop *loops = NULL;
+        DxfFillLoop *loop = NULL;
+        int *holes = NULL;
+        int number_of_paths;
+        int number_of_loops;
+        int number_of_holes;
+        int first_vertex;
+        int status;
+        int path;
+        int first;
+        int last;
+        int i;
+        int j;
+        int k;
+
+        /* Do some basic checks. */
+        if ((boundary == NULL) || (triangles == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (dxf_flatten_buffer_is_overflowed (boundary))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () an incomplete (overflowed) buffer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if ((style < DXF_BOUNDARY_INDEX_STYLE_NORMAL)
+          || (style > DXF_BOUNDARY_INDEX_STYLE_IGNORE))
+        {
+                fprintf (stderr,
+                  (_("Warning in %s () an unknown style was passed, using the normal style.\n")),
+                  __FUNCTION__);
+                style = DXF_BOUNDARY_INDEX_STYLE_NORMAL;
+        }
+        number_of_paths = (boundary->path_start != NULL) ? boundary->number_of_paths : 1;
+        if (boundary->number_of_vertices == 0)
+        {
+                return (EXIT_SUCCESS);
+        }
+        first_vertex = triangles->number_of_vertices;
+        if (dxf_fill_triangles_reserve (triangles,
+          triangles->number_of_vertices + boundary->number_of_vertices, 0) != EXIT_SUCCESS)
+        {
+                return (EXIT_FAILURE);
+        }
+        loops = calloc (number_of_paths, sizeof (DxfFillLoop));
+        holes = malloc ((number_of_paths + 1) * sizeof (int));
+        if ((loops == NULL) || (holes == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                free (loops);
+                free (holes);
+                return (EXIT_FAILURE);
+        }
+        /* Copy the loops without repeated vertices, drop loops without
+         * area. */
+        number_of_loops = 0;
+        for (path = 0; path < number_of_paths; path++)
+        {
+                first = (boundary->path_start != NULL) ? boundary->path_start[path] : 0;
+                last = ((boundary->path_start != NULL) && (path + 1 < number_of_paths))
+                  ? boundary->path_start[path + 1] - 1 : boundary->number_of_vertices - 1;
+                loop = &loops[number_of_loops];
+                loop->first = triangles->number_of_vertices;
+                for (i = first; i <= last; i++)
+                {
+                        k = triangles->number_of_vertices;
+                        if ((k > loop->first)
+                          && (boundary->x[i] == triangles->x[k - 1])
+                          && (boundary->y[i] == triangles->y[k - 1]))
+                        {
+                                continue;
+                        }
+                        triangles->x[k] = boundary->x[i];
+                        triangles->y[k] = boundary->y[i];
+                        triangles->number_of_vertices++;
+                }
+                k = triangles->number_of_vertices;
+                if ((k - loop->first > 1)
+                  && (triangles->x[k - 1] == triangles->x[loop->first])
+                  && (triangles->y[k - 1] == triangles->y[loop->first]))
+                {
+                        triangles->number_of_vertices--;
+                }
+                loop->number_of_vertices = triangles->number_of_vertices - loop->first;
+                loop->area = 0.0;
+                loop->rightmost = loop->first;
+                for (i = 0; i < loop->number_of_vertices; i++)
+                {
+                        j = loop->first + i;
+                        k = loop->first + (i + 1) % loop->number_of_vertices;
+                        loop->area += (triangles->x[j] * triangles->y[k] - triangles->x[k] * triangles->y[j]) / 2.0;
+                        if (triangles->x[j] > triangles->x[loop->rightmost])
+                        {
+                                loop->rightmost = j;
+                        }
+                }
+                loop->max_x = triangles->x[loop->rightmost];
+                if ((loop->number_of_vertices < 3) || (loop->area == 0.0))
+                {
+                        triangles->number_of_vertices = loop->first;
+                        continue;
+                }
+                number_of_loops++;
+        }
+        /* The nesting depth and the smallest loop around every loop. */
+        for (i = 0; i < number_of_loops; i++)
+        {
+                loops[i].depth = 0;
+                loops[i].parent = -1;
+                for (j = 0; j < number_of_loops; j++)
+                {
+                        if ((j == i)
+                          || (!dxf_fill_loop_contains (triangles, &loops[j],
+                          triangles->x[loops[i].first], triangles->y[loops[i].first])))
+                        {
+                                continue;
+                        }
+                        loops[i].depth++;
+                        if ((loops[i].parent < 0)
+                          || (fabs (loops[j].area) < fabs (loops[loops[i].parent].area)))
+                        {
+                                loops[i].parent = j;
+                        }
+                }
+        }
+        status = EXIT_SUCCESS;
+        for (i = 0; (i < number_of_loops) && (status == EXIT_SUCCESS); i++)
+        {
+                if (((style == DXF_BOUNDARY_INDEX_STYLE_NORMAL) && (loops[i].depth % 2 != 0))
+                  || ((style != DXF_BOUNDARY_INDEX_STYLE_NORMAL) && (loops[i].depth != 0)))
+                {
+                        continue;
+                }
+                number_of_holes = 0;
+                for (j = 0; (j < number_of_loops) && (style != DXF_BOUNDARY_INDEX_STYLE_IGNORE); j++)
+                {
+                        if (loops[j].parent == i)
+                        {
+                                holes[number_of_holes] = j;
+                                number_of_holes++;
+                        }
+                }
+                holes[number_of_holes] = -1;
+                status = dxf_fill_triangulate_polygon (triangles, loops,
+                  number_of_holes, i, holes);
+        }
+        if (status != EXIT_SUCCESS)
+        {
+                triangles->number_of_vertices = first_vertex;
+        }
+        free (loops);
+        free (holes);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (status);
+}
+
+
+/*!
+ * \brief Triangulate the area of a DXF \c HATCH entity.
+ *
+ * The boundary paths are flattened once with the given tolerance, the
+ * hatch style of the \c HATCH entity determines the island detection
+ * style.\n
+ * The area is triangulated regardless of the pattern of the hatch.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_fill_triangulate_hatch
+(
+        DxfHatch *hatch,
+                /*!< a pointer to a DXF \c HATCH entity. */
+        double tolerance,
+                /*!< maximum allowed deviation (sagitta) of flattened
+                 * boundary curves. */
+        DxfFillTriangles *triangles
+                /*!< a pointer to the triangle buffer receiving the
+                 * result. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfFlattenBuffer *boundary = NULL;
+        int result;
+
+        /* Do some basic checks. */
+        if ((hatch == NULL) || (triangles == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        boundary = dxf_flatten_buffer_init (dxf_flatten_buffer_new (), 256, 8);
+        if (boundary == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_flatten_hatch (hatch, tolerance, boundary);
+        if (dxf_flatten_buffer_is_overflowed (boundary))
+        {
+                /* Now that the required size is known, try again. */
+                if (dxf_flatten_buffer_reserve (boundary, boundary->number_of_vertices, boundary->number_of_paths) != EXIT_SUCCESS)
+                {
+                        dxf_flatten_buffer_free (boundary);
+                        return (EXIT_FAILURE);
+                }
+                dxf_flatten_buffer_reset (boundary);
+                dxf_flatten_hatch (hatch, tolerance, boundary);
+        }
+        result = dxf_fill_triangulate_loops (boundary, hatch->hatch_style, triangles);
+        dxf_flatten_buffer_free (boundary);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (result);
+}
+
+
+/*!
+ * \brief Triangulate the area of a DXF \c SOLID entity.
+ *
+ * The corners of a \c SOLID run in the order first, second, fourth and
+ * third around the area, a \c SOLID with coinciding third and fourth
+ * corners is a single triangle.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_fill_triangulate_solid
+(
+        DxfSolid *solid,
+                /*!< a pointer to a DXF \c SOLID entity. */
+        DxfFillTriangles *triangles
+                /*!< a pointer to the triangle buffer receiving the
+                 * result. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        int result;
+
+        /* Do some basic checks. */
+        if ((solid == NULL) || (triangles == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        result = dxf_fill_triangulate_quad (triangles, solid->p0,
+          solid->p1, solid->p2, solid->p3);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (result);
+}
+
+
+/*!
+ * \brief Triangulate the area of a DXF \c TRACE entity.
+ *
+ * The corners of a \c TRACE run in the same order as those of a
+ * \c SOLID.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_fill_triangulate_trace
+(
+        DxfTrace *trace,
+                /*!< a pointer to a DXF \c TRACE entity. */
+        DxfFillTriangles *triangles
+                /*!< a pointer to the triangle buffer receiving the
+                 * result. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        int result;
+
+        /* Do some basic checks. */
+        if ((trace == NULL) || (triangles == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        result = dxf_fill_triangulate_quad (triangles, trace->p0,
+          trace->p1, trace->p2, trace->p3);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (result);
+}
+
+
+/*!
+ * \brief Triangulate the area of a DXF \c DONUT entity.
+ *
+ * The number of segments of the rings follows from the outside
+ * diameter and the tolerance, a donut with an inside diameter of zero
+ * is a filled disc.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_fill_triangulate_donut
+(
+        DxfDonut *donut,
+                /*!< a pointer to a DXF \c DONUT entity. */
+        double tolerance,
+                /*!< maximum allowed deviation (sagitta) of the
+                 * rings. */
+        DxfFillTriangles *triangles
+                /*!< a pointer to the triangle buffer receiving the
+                 * result. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        double outside_radius;
+        double inside_radius;
+        double angle;
+        int number_of_segments;
+        int first;
+        int i;
+        int k;
+
+        /* Do some basic checks. */
+        if ((donut == NULL) || (donut->p0 == NULL) || (triangles == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        outside_radius = fabs (donut->outside_diameter) / 2.0;
+        inside_radius = fabs (donut->inside_diameter) / 2.0;
+        if (inside_radius > outside_radius)
+        {
+                angle = inside_radius;
+                inside_radius = outside_radius;
+                outside_radius = angle;
+        }
+        if (outside_radius == inside_radius)
+        {
+                return (EXIT_SUCCESS);
+        }
+        number_of_segments = dxf_flatten_get_number_of_segments (outside_radius,
+          2.0 * M_PI, tolerance);
+        if (dxf_fill_triangles_reserve (triangles,
+          triangles->number_of_vertices + 2 * number_of_segments + 1,
+          triangles->number_of_triangles + 2 * number_of_segments) != EXIT_SUCCESS)
+        {
+                return (EXIT_FAILURE);
+        }
+        /* The outside ring first, then the inside ring or the
+         * center. */
+        first = triangles->number_of_vertices;
+        for (i = 0; i < number_of_segments; i++)
+        {
+                angle = 2.0 * M_PI * i / number_of_segments;
+                dxf_fill_triangles_add_vertex (triangles,
+                  donut->p0->x0 + outside_radius * cos (angle),
+                  donut->p0->y0 + outside_radius * sin (angle));
+        }
+        if (inside_radius == 0.0)
+        {
+                dxf_fill_triangles_add_vertex (triangles, donut->p0->x0, donut->p0->y0);
+                for (i = 0; i < number_of_segments; i++)
+                {
+                        k = (i + 1) % number_of_segments;
+                        dxf_fill_triangles_add_triangle (triangles,
+                          first + number_of_segments, first + i, first + k);
+                }
+        }
+        else
+        {
+                for (i = 0; i < number_of_segments; i++)
+                {
+                        angle = 2.0 * M_PI * i / number_of_segments;
+                        dxf_fill_triangles_add_vertex (triangles,
+                          donut->p0->x0 + inside_radius * cos (angle),
+                          donut->p0->y0 + inside_radius * sin (angle));
+                }
+                for (i = 0; i < number_of_segments; i++)
+                {
+                        k = (i + 1) % number_of_segments;
+                        dxf_fill_triangles_add_triangle (triangles,
+                          first + i, first + k, first + number_of_segments + k);
+                        dxf_fill_triangles_add_triangle (triangles,
+                          first + i, first + number_of_segments + k,
+                          first + number_of_segments + i);
+                }
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Triangulate the filled area of a DXF entity.
+ *
+ * Supported are the \c HATCH, \c SOLID and \c TRACE entities, a
+ * \c DONUT has no entity type of its own and is triangulated with
+ * dxf_fill_triangulate_donut().
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred or the entity type is not supported.
+ */
+int
+dxf_entity_triangulate
+(
+        void *entity,
+                /*!< a pointer to a DXF entity. */
+        DxfEntityType entity_type,
+                /*!< the type of the entity. */
+        double tolerance,
+                /*!< maximum allowed deviation (sagitta) of curves. */
+        DxfFillTriangles *triangles
+                /*!< a pointer to the triangle buffer receiving the
+                 * result. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        int result;
+
+        /* Do some basic checks. */
+        if ((entity == NULL) || (triangles == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        switch (entity_type)
+        {
+                case HATCH:
+                        result = dxf_fill_triangulate_hatch ((DxfHatch *) entity, tolerance, triangles);
+                        break;
+                case SOLID:
+                        result = dxf_fill_triangulate_solid ((DxfSolid *) entity, triangles);
+                        break;
+                case TRACE:
+                        result = dxf_fill_triangulate_trace ((DxfTrace *) entity, triangles);
+                        break;
+                default:
+                        fprintf (stderr,
+                          (_("Error in %s () an unsupported entity type was passed.\n")),
+                          __FUNCTION__);
+                        result = EXIT_FAILURE;
+                        break;
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (result);
+}
+
+
+/*!
+ * \brief Triangulate the filled area of an array of DXF entities.
+ *
+ * The entities are divided over a number of threads, the triangles of
+ * the n-th entity are appended to the n-th triangle buffer, the
+ * buffers must have been initialized.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred for any of the entities.
+ */
+int
+dxf_entity_triangulate_list
+(
+        void **entities,
+                /*!< array of pointers to DXF entities. */
+        DxfEntityType *entity_types,
+                /*!< array of entity types, one per entity. */
+        int number_of_entities,
+                /*!< number of entities. */
+        double tolerance,
+                /*!< maximum allowed deviation (sagitta) of curves. */
+        DxfFillTriangles *results,
+                /*!< array of triangle buffers, one per entity. */
+        int number_of_threads
+                /*!< number of threads to use. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfFillJob *jobs = NULL;
+        pthread_t *threads = NULL;
+        int *started = NULL;
+        int status;
+        int chunk;
+        int i;
+
+        /* Do some basic checks. */
+        if ((entities == NULL) || (entity_types == NULL) || (results == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (number_of_entities <= 0)
+        {
+                return (EXIT_SUCCESS);
+        }
+        if (number_of_threads < 1)
+        {
+                number_of_threads = 1;
+        }
+        if (number_of_threads > number_of_entities)
+        {
+                number_of_threads = number_of_entities;
+        }
+        jobs = calloc (number_of_threads, sizeof (DxfFillJob));
+        threads = calloc (number_of_threads, sizeof (pthread_t));
+        started = calloc (number_of_threads, sizeof (int));
+        if ((jobs == NULL) || (threads == NULL) || (started == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                free (jobs);
+                free (threads);
+                free (started);
+                return (EXIT_FAILURE);
+        }
+        chunk = (number_of_entities + number_of_threads - 1) / number_of_threads;
+        for (i = 0; i < number_of_threads; i++)
+        {
+                jobs[i].entities = entities;
+                jobs[i].entity_types = entity_types;
+                jobs[i].tolerance = tolerance;
+                jobs[i].results = results;
+                jobs[i].begin = i * chunk;
+                jobs[i].end = ((i + 1) * chunk < number_of_entities) ? (i + 1) * chunk : number_of_entities;
+        }
+        /* The first chunk is done by the calling thread. */
+        for (i = 1; i < number_of_threads; i++)
+        {
+                if (pthread_create (&threads[i], NULL, dxf_fill_run_job, &jobs[i]) == 0)
+                {
+                        started[i] = TRUE;
+                }
+        }
+        dxf_fill_run_job (&jobs[0]);
+        status = jobs[0].status;
+        for (i = 1; i < number_of_threads; i++)
+        {
+                if (started[i])
+                {
+                        pthread_join (threads[i], NULL);
+                }
+                else
+                {
+                        dxf_fill_run_job (&jobs[i]);
+                }
+                if (jobs[i].status != EXIT_SUCCESS)
+                {
+                        status = EXIT_FAILURE;
+                }
+        }
+        free (jobs);
+        free (threads);
+        free (started);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (status);
+}
+
+
+/*!
+ * \brief Append a vertex to a \c DxfFillTriangles, room for the vertex
+ * must have been reserved.
+ *
+ * \return the index of the vertex.
+ */
+static int
+dxf_fill_triangles_add_vertex
+(
+        DxfFillTriangles *triangles,
+                /*!< a pointer to the triangle buffer. */
+        double x,
+                /*!< X-coordinate of the vertex. */
+        double y
+                /*!< Y-coordinate of the vertex. */
+)
+{
+        triangles->x[triangles->number_of_vertices] = x;
+        triangles->y[triangles->number_of_vertices] = y;
+        triangles->number_of_vertices++;
+        return (triangles->number_of_vertices - 1);
+}
+
+
+/*!
+ * \brief Append a triangle to a \c DxfFillTriangles in
+ * counterclockwise order, room for the triangle must have been
+ * reserved.
+ *
+ * A triangle without area is skipped.
+ *
+ * \return \c TRUE when the triangle was added, \c FALSE when it was
+ * skipped.
+ */
+static int
+dxf_fill_triangles_add_triangle
+(
+        DxfFillTriangles *triangles,
+                /*!< a pointer to the triangle buffer. */
+        int a,
+                /*!< index of the first vertex. */
+        int b,
+                /*!< index of the second vertex. */
+        int c
+                /*!< index of the third vertex. */
+)
+{
+        double cross;
+        int n;
+
+        cross = dxf_fill_cross (triangles->x, triangles->y, a, b, c);
+        if (cross == 0.0)
+        {
+                return (FALSE);
+        }
+        n = triangles->number_of_triangles;
+        triangles->indices[3 * n] = a;
+        triangles->indices[3 * n + 1] = (cross > 0.0) ? b : c;
+        triangles->indices[3 * n + 2] = (cross > 0.0) ? c : b;
+        triangles->number_of_triangles++;
+        return (TRUE);
+}
+
+
+/*!
+ * \brief Triangulate a quadrilateral with the corner order of a
+ * \c SOLID (first, second, fourth, third).
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_fill_triangulate_quad
+(
+        DxfFillTriangles *triangles,
+                /*!< a pointer to the triangle buffer. */
+        DxfPoint *p0,
+                /*!< first corner. */
+        DxfPoint *p1,
+                /*!< second corner. */
+        DxfPoint *p2,
+                /*!< third corner. */
+        DxfPoint *p3
+                /*!< fourth corner, \c NULL when equal to the third
+                 * corner. */
+)
+{
+        int first;
+
+        if ((p0 == NULL) || (p1 == NULL) || (p2 == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a corner is missing.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (dxf_fill_triangles_reserve (triangles,
+          triangles->number_of_vertices + 4,
+          triangles->number_of_triangles + 2) != EXIT_SUCCESS)
+        {
+                return (EXIT_FAILURE);
+        }
+        first = triangles->number_of_vertices;
+        dxf_fill_triangles_add_vertex (triangles, p0->x0, p0->y0);
+        dxf_fill_triangles_add_vertex (triangles, p1->x0, p1->y0);
+        dxf_fill_triangles_add_vertex (triangles, p2->x0, p2->y0);
+        dxf_fill_triangles_add_triangle (triangles, first, first + 1, first + 2);
+        if ((p3 != NULL) && ((p3->x0 != p2->x0) || (p3->y0 != p2->y0)))
+        {
+                dxf_fill_triangles_add_vertex (triangles, p3->x0, p3->y0);
+                dxf_fill_triangles_add_triangle (triangles, first + 1, first + 3, first + 2);
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Triangulate a loop with its holes by ear clipping.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_fill_triangulate_polygon
+(
+        DxfFillTriangles *triangles,
+                /*!< a pointer to the triangle buffer. */
+        DxfFillLoop *loops,
+                /*!< array of all loops. */
+        int number_of_holes,
+                /*!< number of holes. */
+        int outer,
+                /*!< the loop around the area. */
+        int *holes
+                /*!< array of the holes in the area. */
+)
+{
+        DxfFillRing ring;
+        int number_of_nodes;
+        int remaining;
+        int stage;
+        int start;
+        int stop;
+        int ear;
+        int next;
+        int hole;
+        int i;
+        int k;
+
+        number_of_nodes = loops[outer].number_of_vertices;
+        for (i = 0; i < number_of_holes; i++)
+        {
+                number_of_nodes += loops[holes[i]].number_of_vertices + 2;
+        }
+        if (dxf_fill_triangles_reserve (triangles, triangles->number_of_vertices,
+          triangles->number_of_triangles + number_of_nodes) != EXIT_SUCCESS)
+        {
+                return (EXIT_FAILURE);
+        }
+        memset (&ring, 0, sizeof (DxfFillRing));
+        ring.x = triangles->x;
+        ring.y = triangles->y;
+        ring.vertex = malloc (number_of_nodes * sizeof (int));
+        ring.next = malloc (number_of_nodes * sizeof (int));
+        ring.prev = malloc (number_of_nodes * sizeof (int));
+        if ((ring.vertex == NULL) || (ring.next == NULL) || (ring.prev == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                free (ring.vertex);
+                free (ring.next);
+                free (ring.prev);
+                return (EXIT_FAILURE);
+        }
+        /* The area runs counterclockwise, the holes clockwise, holes
+         * further to the right are bridged first. */
+        start = dxf_fill_ring_add_loop (&ring, &loops[outer], loops[outer].area < 0.0);
+        for (i = 1; i < number_of_holes; i++)
+        {
+                hole = holes[i];
+                for (k = i; (k > 0) && (loops[holes[k - 1]].max_x < loops[hole].max_x); k--)
+                {
+                        holes[k] = holes[k - 1];
+                }
+                holes[k] = hole;
+        }
+        for (i = 0; i < number_of_holes; i++)
+        {
+                dxf_fill_ring_bridge (&ring, start,
+                  dxf_fill_ring_add_loop (&ring, &loops[holes[i]], loops[holes[i]].area > 0.0));
+        }
+        remaining = ring.number_of_nodes;
+        ear = dxf_fill_ring_filter (&ring, start, &remaining);
+        stop = ear;
+        stage = 0;
+        while (remaining > 3)
+        {
+                next = ring.next[ear];
+                if (dxf_fill_ring_is_ear (&ring, ear))
+                {
+                        dxf_fill_triangles_add_triangle (triangles,
+                          ring.vertex[ring.prev[ear]], ring.vertex[ear], ring.vertex[next]);
+                        ring.next[ring.prev[ear]] = next;
+                        ring.prev[next] = ring.prev[ear];
+                        remaining--;
+                        ear = next;
+                        stop = next;
+                        stage = 0;
+                        continue;
+                }
+                ear = next;
+                if (ear != stop)
+                {
+                        continue;
+                }
+                /* A full turn without an ear: first drop collinear
+                 * vertices, then clip a convex vertex regardless. */
+                if (stage == 0)
+                {
+                        ear = dxf_fill_ring_filter (&ring, ear, &remaining);
+                        stage = 1;
+                }
+                else
+                {
+                        for (i = 0; (i < remaining)
+                          && (dxf_fill_cross (ring.x, ring.y, ring.vertex[ring.prev[ear]],
+                          ring.vertex[ear], ring.vertex[ring.next[ear]]) <= 0.0); i++)
+                        {
+                                ear = ring.next[ear];
+                        }
+                        next = ring.next[ear];
+                        dxf_fill_triangles_add_triangle (triangles,
+                          ring.vertex[ring.prev[ear]], ring.vertex[ear], ring.vertex[next]);
+                        ring.next[ring.prev[ear]] = next;
+                        ring.prev[next] = ring.prev[ear];
+                        remaining--;
+                        ear = next;
+                        stage = 0;
+                }
+                stop = ear;
+        }
+        if (remaining == 3)
+        {
+                dxf_fill_triangles_add_triangle (triangles,
+                  ring.vertex[ring.prev[ear]], ring.vertex[ear], ring.vertex[ring.next[ear]]);
+        }
+        free (ring.vertex);
+        free (ring.next);
+        free (ring.prev);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Test if a point is inside a loop (crossing number rule).
+ *
+ * \return \c TRUE when inside, \c FALSE when outside.
+ */
+static int
+dxf_fill_loop_contains
+(
+        DxfFillTriangles *triangles,
+                /*!< a pointer to the triangle buffer holding the
+                 * vertices. */
+        DxfFillLoop *loop,
+                /*!< a pointer to the loop. */
+        double x,
+                /*!< X-coordinate of the point. */
+        double y
+                /*!< Y-coordinate of the point. */
+)
+{
+        double xa;
+        double ya;
+        double xb;
+        double yb;
+        int inside;
+        int i;
+
+        inside = FALSE;
+        for (i = 0; i < loop->number_of_vertices; i++)
+        {
+                xa = triangles->x[loop->first + i];
+                ya = triangles->y[loop->first + i];
+                xb = triangles->x[loop->first + (i + 1) % loop->number_of_vertices];
+                yb = triangles->y[loop->first + (i + 1) % loop->number_of_vertices];
+                if (((ya > y) != (yb > y))
+                  && (x < xa + (y - ya) * (xb - xa) / (yb - ya)))
+                {
+                        inside = !inside;
+                }
+        }
+        return (inside);
+}
+
+
+/*!
+ * \brief Add the vertices of a loop to a ring as a separate closed
+ * ring of nodes.
+ *
+ * \return the node of the rightmost vertex of the loop.
+ */
+static int
+dxf_fill_ring_add_loop
+(
+        DxfFillRing *ring,
+                /*!< a pointer to the ring. */
+        DxfFillLoop *loop,
+                /*!< a pointer to the loop. */
+        int reverse
+                /*!< \c TRUE to add the vertices in reverse order. */
+)
+{
+        int first;
+        int rightmost;
+        int node;
+        int i;
+
+        first = ring->number_of_nodes;
+        rightmost = first;
+        for (i = 0; i < loop->number_of_vertices; i++)
+        {
+                node = first + i;
+                ring->vertex[node] = loop->first
+                  + ((reverse) ? loop->number_of_vertices - 1 - i : i);
+                ring->next[node] = first + (i + 1) % loop->number_of_vertices;
+                ring->prev[node] = first + (i + loop->number_of_vertices - 1) % loop->number_of_vertices;
+                if (ring->vertex[node] == loop->rightmost)
+                {
+                        rightmost = node;
+                }
+        }
+        ring->number_of_nodes += loop->number_of_vertices;
+        return (rightmost);
+}
+
+
+/*!
+ * \brief Join a hole to the ring around it with a bridge.
+ *
+ * A horizontal ray from the rightmost vertex of the hole to the right
+ * hits an edge of the ring, the end of that edge furthest to the right
+ * is visible from the hole unless other vertices lie inside the
+ * triangle formed by the hole vertex, the hit point and that end, in
+ * which case the vertex with the smallest angle to the ray is taken.
+ *
+ * \return \c TRUE when the hole was joined, \c FALSE when no edge of
+ * the ring was hit.
+ */
+static int
+dxf_fill_ring_bridge
+(
+        DxfFillRing *ring,
+                /*!< a pointer to the ring. */
+        int outer,
+                /*!< a node of the ring around the hole. */
+        int hole
+                /*!< the node of the rightmost vertex of the hole. */
+)
+{
+        double hx;
+        double hy;
+        double ix;
+        double ya;
+        double yb;
+        double x;
+        double tangent;
+        double best_tangent;
+        int bridge;
+        int p;
+        int q;
+
+        hx = ring->x[ring->vertex[hole]];
+        hy = ring->y[ring->vertex[hole]];
+        ix = HUGE_VAL;
+        bridge = -1;
+        p = outer;
+        do
+        {
+                q = ring->next[p];
+                ya = ring->y[ring->vertex[p]];
+                yb = ring->y[ring->vertex[q]];
+                if ((ya != yb)
+                  && (((ya <= hy) && (hy <= yb)) || ((yb <= hy) && (hy <= ya))))
+                {
+                        x = ring->x[ring->vertex[p]] + (hy - ya)
+                          * (ring->x[ring->vertex[q]] - ring->x[ring->vertex[p]]) / (yb - ya);
+                        if ((x >= hx) && (x < ix))
+                        {
+                                ix = x;
+                                if (hy == ya)
+                                {
+                                        bridge = p;
+                                }
+                                else if (hy == yb)
+                                {
+                                        bridge = q;
+                                }
+                                else
+                                {
+                                        bridge = (ring->x[ring->vertex[p]] > ring->x[ring->vertex[q]]) ? p : q;
+                                }
+                        }
+                }
+                p = q;
+        }
+        while (p != outer);
+        if (bridge < 0)
+        {
+                return (FALSE);
+        }
+        if (ring->y[ring->vertex[bridge]] != hy)
+        {
+                q = bridge;
+                best_tangent = HUGE_VAL;
+                p = outer;
+                do
+                {
+                        x = ring->x[ring->vertex[p]];
+                        if ((p != q) && (x > hx)
+                          && dxf_fill_point_in_triangle (hx, hy, ix, hy,
+                          ring->x[ring->vertex[q]], ring->y[ring->vertex[q]],
+                          x, ring->y[ring->vertex[p]]))
+                        {
+                                tangent = fabs (ring->y[ring->vertex[p]] - hy) / (x - hx);
+                                if (dxf_fill_ring_locally_inside (ring, p, hole)
+                                  && ((tangent < best_tangent)
+                                  || ((tangent == best_tangent) && (x > ring->x[ring->vertex[bridge]]))))
+                                {
+                                        bridge = p;
+                                        best_tangent = tangent;
+                                }
+                        }
+                        p = ring->next[p];
+                }
+                while (p != outer);
+        }
+        dxf_fill_ring_split (ring, bridge, hole);
+        return (TRUE);
+}
+
+
+/*!
+ * \brief Connect two nodes of a ring with a pair of coinciding edges,
+ * duplicating both nodes.
+ *
+ * The ring runs from \c a to \c b, on along the ring of \c b back to
+ * (a copy of) \c b, to (a copy of) \c a and on along the ring of
+ * \c a.
+ */
+static void
+dxf_fill_ring_split
+(
+        DxfFillRing *ring,
+                /*!< a pointer to the ring. */
+        int a,
+                /*!< the first node. */
+        int b
+                /*!< the second node. */
+)
+{
+        int a2;
+        int b2;
+        int an;
+        int bp;
+
+        a2 = ring->number_of_nodes;
+        b2 = ring->number_of_nodes + 1;
+        ring->number_of_nodes += 2;
+        ring->vertex[a2] = ring->vertex[a];
+        ring->vertex[b2] = ring->vertex[b];
+        an = ring->next[a];
+        bp = ring->prev[b];
+        ring->next[a] = b;
+        ring->prev[b] = a;
+        ring->next[a2] = an;
+        ring->prev[an] = a2;
+        ring->next[b2] = a2;
+        ring->prev[a2] = b2;
+        ring->next[bp] = b2;
+        ring->prev[b2] = bp;
+}
+
+
+/*!
+ * \brief Remove coinciding and collinear nodes from a ring.
+ *
+ * \return a node still in the ring.
+ */
+static int
+dxf_fill_ring_filter
+(
+        DxfFillRing *ring,
+                /*!< a pointer to the ring. */
+        int start,
+                /*!< a node of the ring. */
+        int *number_of_nodes
+                /*!< number of nodes in the ring, updated. */
+)
+{
+        int again;
+        int end;
+        int p;
+        int n;
+
+        p = start;
+        end = start;
+        do
+        {
+                again = FALSE;
+                n = ring->next[p];
+                if (((ring->x[ring->vertex[p]] == ring->x[ring->vertex[n]])
+                  && (ring->y[ring->vertex[p]] == ring->y[ring->vertex[n]]))
+                  || (dxf_fill_cross (ring->x, ring->y, ring->vertex[ring->prev[p]],
+                  ring->vertex[p], ring->vertex[n]) == 0.0))
+                {
+                        ring->next[ring->prev[p]] = n;
+                        ring->prev[n] = ring->prev[p];
+                        (*number_of_nodes)--;
+                        p = ring->prev[p];
+                        end = p;
+                        if (*number_of_nodes < 3)
+                        {
+                                break;
+                        }
+                        again = TRUE;
+                }
+                else
+                {
+                        p = n;
+                }
+        }
+        while (again || (p != end));
+        return (p);
+}
+
+
+/*!
+ * \brief Test if a node of a ring is an ear: a convex corner with no
+ * reflex vertex of the ring inside the triangle it forms with its
+ * neighbours.
+ *
+ * \return \c TRUE when the node is an ear, \c FALSE when not.
+ */
+static int
+dxf_fill_ring_is_ear
+(
+        DxfFillRing *ring,
+                /*!< a pointer to the ring. */
+        int ear
+                /*!< the node. */
+)
+{
+        int a;
+        int b;
+        int c;
+        int v;
+        int p;
+
+        a = ring->vertex[ring->prev[ear]];
+        b = ring->vertex[ear];
+        c = ring->vertex[ring->next[ear]];
+        if (dxf_fill_cross (ring->x, ring->y, a, b, c) <= 0.0)
+        {
+                return (FALSE);
+        }
+        for (p = ring->next[ring->next[ear]]; p != ring->prev[ear]; p = ring->next[p])
+        {
+                v = ring->vertex[p];
+                if ((v != a) && (v != b) && (v != c)
+                  && dxf_fill_point_in_triangle (ring->x[a], ring->y[a],
+                  ring->x[b], ring->y[b], ring->x[c], ring->y[c],
+                  ring->x[v], ring->y[v])
+                  && (dxf_fill_cross (ring->x, ring->y, ring->vertex[ring->prev[p]],
+                  v, ring->vertex[ring->next[p]]) <= 0.0))
+                {
+                        return (FALSE);
+                }
+        }
+        return (TRUE);
+}
+
+
+/*!
+ * \brief Test if the diagonal from node \c a to node \c b starts into
+ * the inside of the ring at \c a.
+ *
+ * \return \c TRUE when inside, \c FALSE when not.
+ */
+static int
+dxf_fill_ring_locally_inside
+(
+        DxfFillRing *ring,
+                /*!< a pointer to the ring. */
+        int a,
+                /*!< the first node. */
+        int b
+                /*!< the second node. */
+)
+{
+        int pa;
+        int va;
+        int na;
+        int vb;
+
+        pa = ring->vertex[ring->prev[a]];
+        va = ring->vertex[a];
+        na = ring->vertex[ring->next[a]];
+        vb = ring->vertex[b];
+        if (dxf_fill_cross (ring->x, ring->y, pa, va, na) >= 0.0)
+        {
+                return ((dxf_fill_cross (ring->x, ring->y, va, na, vb) >= 0.0)
+                  && (dxf_fill_cross (ring->x, ring->y, va, pa, vb) <= 0.0));
+        }
+        return ((dxf_fill_cross (ring->x, ring->y, va, na, vb) > 0.0)
+          || (dxf_fill_cross (ring->x, ring->y, va, pa, vb) < 0.0));
+}
+
+
+/*!
+ * \brief Test if a point lies inside or on a triangle of either
+ * orientation.
+ *
+ * \return \c TRUE when inside or on the triangle, \c FALSE when
+ * outside.
+ */
+static int
+dxf_fill_point_in_triangle
+(
+        double ax,
+                /*!< X-coordinate of the first corner. */
+        double ay,
+                /*!< Y-coordinate of the first corner. */
+        double bx,
+                /*!< X-coordinate of the second corner. */
+        double by,
+                /*!< Y-coordinate of the second corner. */
+        double cx,
+                /*!< X-coordinate of the third corner. */
+        double cy,
+                /*!< Y-coordinate of the third corner. */
+        double px,
+                /*!< X-coordinate of the point. */
+        double py
+                /*!< Y-coordinate of the point. */
+)
+{
+        double d1;
+        double d2;
+        double d3;
+
+        d1 = (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+        d2 = (cx - bx) * (py - by) - (cy - by) * (px - bx);
+        d3 = (ax - cx) * (py - cy) - (ay - cy) * (px - cx);
+        return (!(((d1 < 0.0) || (d2 < 0.0) || (d3 < 0.0))
+          && ((d1 > 0.0) || (d2 > 0.0) || (d3 > 0.0))));
+}
+
+
+/*!
+ * \brief Compute the cross product of the vectors from vertex \c a to
+ * \c b and from \c a to \c c.
+ *
+ * \return twice the signed area of the triangle, positive when
+ * counterclockwise.
+ */
+static double
+dxf_fill_cross
+(
+        const double *x,
+                /*!< array of X-coordinates. */
+        const double *y,
+                /*!< array of Y-coordinates. */
+        int a,
+                /*!< index of the first vertex. */
+        int b,
+                /*!< index of the second vertex. */
+        int c
+                /*!< index of the third vertex. */
+)
+{
+        return ((x[b] - x[a]) * (y[c] - y[a]) - (y[b] - y[a]) * (x[c] - x[a]));
+}
+
+
+/*!
+ * \brief Triangulate a range of entities, used as thread entry point.
+ */
+static void *
+dxf_fill_run_job
+(
+        void *data
+                /*!< a pointer to a \c DxfFillJob. */
+)
+{
+        DxfFillJob *job = NULL;
+        int i;
+
+        job = (DxfFillJob *) data;
+        job->status = EXIT_SUCCESS;
+        for (i = job->begin; i < job->end; i++)
+        {
+                if (dxf_entity_triangulate (job->entities[i], job->entity_types[i],
+                  job->tolerance, &job->results[i]) != EXIT_SUCCESS)
+                {
+                        job->status = EXIT_FAILURE;
+                }
+        }
+        return (NULL);
+}
+
+
+/* EOF */
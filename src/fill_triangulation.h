@@ -0,0 +1,107 @@
+/*!
+ * \file fill_triangulation.h
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * Header file for triangulating the filled area of DXF
+ * entities (\c HATCH, \c SOLID, \c TRACE and \c DONUT).
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#ifndef LIBDXF_SRC_FILL_TRIANGULATION_H
+#define LIBDXF_SRC_FILL_TRIANGULATION_H
+
+
+#include "global.h"
+#include "boundary_index.h"
+#include "donut.h"
+#include "flatten.h"
+#include "hatch.h"
+#include "solid.h"
+#include "trace.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*!
+ * \brief Definition of a contiguous buffer of filled triangles.
+ *
+ * The vertices are stored as separate X and Y arrays, every triangle
+ * as three vertex indices in counterclockwise order.\n
+ * The buffer grows as vertices and triangles are added, the
+ * triangulation functions append to the buffer, so that the fill of
+ * several entities can be collected in a single buffer.\n
+ * Coordinates are in the Object Coordinate System (OCS) of the
+ * triangulated entity.
+ */
+typedef struct
+dxf_fill_triangles_struct
+{
+        double *x;
+                /*!< Array of X-coordinates of the vertices. */
+        double *y;
+                /*!< Array of Y-coordinates of the vertices. */
+        int number_of_vertices;
+                /*!< Number of vertices. */
+        int max_number_of_vertices;
+                /*!< Number of vertices that fit in the arrays. */
+        int *indices;
+                /*!< Array of three vertex indices per triangle. */
+        int number_of_triangles;
+                /*!< Number of triangles. */
+        int max_number_of_triangles;
+                /*!< Number of triangles that fit in the array. */
+} DxfFillTriangles;
+
+
+DxfFillTriangles *dxf_fill_triangles_new ();
+DxfFillTriangles *dxf_fill_triangles_init (DxfFillTriangles *triangles);
+int dxf_fill_triangles_reserve (DxfFillTriangles *triangles, int max_number_of_vertices, int max_number_of_triangles);
+int dxf_fill_triangles_clear (DxfFillTriangles *triangles);
+int dxf_fill_triangles_free (DxfFillTriangles *triangles);
+int dxf_fill_triangulate_loops (DxfFlattenBuffer *boundary, int style, DxfFillTriangles *triangles);
+int dxf_fill_triangulate_hatch (DxfHatch *hatch, double tolerance, DxfFillTriangles *triangles);
+int dxf_fill_triangulate_solid (DxfSolid *solid, DxfFillTriangles *triangles);
+int dxf_fill_triangulate_trace (DxfTrace *trace, DxfFillTriangles *triangles);
+int dxf_fill_triangulate_donut (DxfDonut *donut, double tolerance, DxfFillTriangles *triangles);
+int dxf_entity_triangulate (void *entity, DxfEntityType entity_type, double tolerance, DxfFillTriangles *triangles);
+int dxf_entity_triangulate_list (void **entities, DxfEntityType *entity_types, int number_of_entities, double tolerance, DxfFillTriangles *results, int number_of_threads);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* LIBDXF_SRC_FILL_TRIANGULATION_H */
+
+
+/* EOF */
@@ -0,0 +1,1753 @@
+/*!
+ * \file flatten.c
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Functions for flattening curved DXF entities into polylines.
+ *
+ * Curves are approximated by chords, the number of chords is derived
+ * from the maximum allowed sagitta (chord height), that is the
+ * tolerance passed by the caller.\n
+ * For a circular arc with radius \c r the maximum angle spanned by a
+ * single chord is <tt>2 * acos (1 - tolerance / r)</tt>.\n
+ * The vertices are written into a contiguous \c DxfFlattenBuffer.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include "flatten.h"
+
+
+static void dxf_flatten_buffer_append_unique (DxfFlattenBuffer *buffer, double x, double y);
+static void dxf_flatten_buffer_close_path (DxfFlattenBuffer *buffer);
+static void dxf_flatten_generate (DxfFlattenBuffer *buffer, double cx, double cy, double ux, double uy, double vx, double vy, double start, double sweep, int number_of_segments, int include_first);
+
+
+/*!
+ * \brief Allocate memory for a \c DxfFlattenBuffer.
+ *
+ * Fill the memory contents with zeros.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfFlattenBuffer *
+dxf_flatten_buffer_new ()
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfFlattenBuffer *buffer = NULL;
+        size_t size;
+
+        size = sizeof (DxfFlattenBuffer);
+        /* avoid malloc of 0 bytes */
+        if (size == 0) size = 1;
+        if ((buffer = malloc (size)) == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                buffer = NULL;
+        }
+        else
+        {
+                memset (buffer, 0, size);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (buffer);
+}
+
+
+/*!
+ * \brief Allocate memory and initialize data fields in a
+ * \c DxfFlattenBuffer.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfFlattenBuffer *
+dxf_flatten_buffer_init
+(
+        DxfFlattenBuffer *buffer,
+                /*!< a pointer to the buffer. */
+        int max_number_of_vertices,
+                /*!< the number of vertices to allocate room for. */
+        int max_number_of_paths
+                /*!< the number of paths to allocate room for. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (buffer == NULL)
+        {
+                fprintf (stderr,
+                  (_("Warning in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                buffer = dxf_flatten_buffer_new ();
+        }
+        if (buffer == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        buffer->x = NULL;
+        buffer->y = NULL;
+        buffer->max_number_of_vertices = 0;
+        buffer->path_start = NULL;
+        buffer->max_number_of_paths = 0;
+        dxf_flatten_buffer_reset (buffer);
+        if (dxf_flatten_buffer_reserve (buffer, max_number_of_vertices, max_number_of_paths) != EXIT_SUCCESS)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                dxf_flatten_buffer_free (buffer);
+                return (NULL);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (buffer);
+}
+
+
+/*!
+ * \brief Reset a \c DxfFlattenBuffer to hold no vertices and no paths.
+ *
+ * The allocated memory is kept for reuse.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_flatten_buffer_reset
+(
+        DxfFlattenBuffer *buffer
+                /*!< a pointer to the buffer. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (buffer == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        buffer->number_of_vertices = 0;
+        buffer->number_of_paths = 0;
+        buffer->path_first_vertex = 0;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Grow the arrays of a \c DxfFlattenBuffer.
+ *
+ * The arrays are never shrunk, the contents are preserved.\n
+ * Typically used after a flatten function failed due to a too small
+ * buffer, with the counts found in the buffer.
+ *
+ * \warning Only use this on arrays allocated by the library (with
+ * malloc), not on caller provided storage.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_flatten_buffer_reserve
+(
+        DxfFlattenBuffer *buffer,
+                /*!< a pointer to the buffer. */
+        int max_number_of_vertices,
+                /*!< the number of vertices to allocate room for. */
+        int max_number_of_paths
+                /*!< the number of paths to allocate room for. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        double *x = NULL;
+        double *y = NULL;
+        int *path_start = NULL;
+
+        /* Do some basic checks. */
+        if (buffer == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if ((max_number_of_vertices < 0) || (max_number_of_paths < 0))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a negative value was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (max_number_of_vertices > buffer->max_number_of_vertices)
+        {
+                x = realloc (buffer->x, max_number_of_vertices * sizeof (double));
+                if (x == NULL)
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () could not allocate memory.\n")),
+                          __FUNCTION__);
+                        return (EXIT_FAILURE);
+                }
+                buffer->x = x;
+                y = realloc (buffer->y, max_number_of_vertices * sizeof (double));
+                if (y == NULL)
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () could not allocate memory.\n")),
+                          __FUNCTION__);
+                        return (EXIT_FAILURE);
+                }
+                buffer->y = y;
+                buffer->max_number_of_vertices = max_number_of_vertices;
+        }
+        if (max_number_of_paths > buffer->max_number_of_paths)
+        {
+                path_start = realloc (buffer->path_start, max_number_of_paths * sizeof (int));
+                if (path_start == NULL)
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () could not allocate memory.\n")),
+                          __FUNCTION__);
+                        return (EXIT_FAILURE);
+                }
+                buffer->path_start = path_start;
+                buffer->max_number_of_paths = max_number_of_paths;
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Test if a \c DxfFlattenBuffer was too small for the data
+ * that was flattened into it.
+ *
+ * \return \c TRUE when the buffer overflowed, \c FALSE when all data
+ * fitted.
+ */
+int
+dxf_flatten_buffer_is_overflowed
+(
+        DxfFlattenBuffer *buffer
+                /*!< a pointer to the buffer. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        int result;
+
+        /* Do some basic checks. */
+        if (buffer == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (TRUE);
+        }
+        result = FALSE;
+        if (buffer->number_of_vertices > buffer->max_number_of_vertices)
+        {
+                result = TRUE;
+        }
+        if ((buffer->path_start != NULL)
+          && (buffer->number_of_paths > buffer->max_number_of_paths))
+        {
+                result = TRUE;
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (result);
+}
+
+
+/*!
+ * \brief Get the number of vertices of a path in a
+ * \c DxfFlattenBuffer.
+ *
+ * \return the number of vertices, or \c DXF_ERROR when an error
+ * occurred.
+ */
+int
+dxf_flatten_buffer_get_path_size
+(
+        DxfFlattenBuffer *buffer,
+                /*!< a pointer to the buffer. */
+        int path
+                /*!< index of the path. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        int end;
+
+        /* Do some basic checks. */
+        if ((buffer == NULL) || (buffer->path_start == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (DXF_ERROR);
+        }
+        if ((path < 0)
+          || (path >= buffer->number_of_paths)
+          || (path >= buffer->max_number_of_paths))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () an out of range value was passed.\n")),
+                  __FUNCTION__);
+                return (DXF_ERROR);
+        }
+        if ((path + 1 < buffer->number_of_paths)
+          && (path + 1 < buffer->max_number_of_paths))
+        {
+                end = buffer->path_start[path + 1];
+        }
+        else
+        {
+                end = buffer->number_of_vertices;
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (end - buffer->path_start[path]);
+}
+
+
+/*!
+ * \brief Free the allocated memory for a \c DxfFlattenBuffer and its
+ * arrays.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_flatten_buffer_free
+(
+        DxfFlattenBuffer *buffer
+                /*!< a pointer to the buffer. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        if (buffer == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        free (buffer->x);
+        free (buffer->y);
+        free (buffer->path_start);
+        free (buffer);
+        buffer = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Get the number of chord segments needed to approximate a
+ * circular arc within a given tolerance.
+ *
+ * The segment count follows from the sagitta: a chord spanning an
+ * angle \c a deviates <tt>r * (1 - cos (a / 2))</tt> from the arc.
+ *
+ * \return the number of segments (at least 1).
+ */
+int
+dxf_flatten_get_number_of_segments
+(
+        double radius,
+                /*!< radius of the arc. */
+        double sweep_angle,
+                /*!< the included angle of the arc in radians. */
+        double tolerance
+                /*!< maximum allowed deviation (sagitta). */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        double step;
+        double sweep;
+        double n;
+        double min;
+
+        radius = fabs (radius);
+        sweep = fabs (sweep_angle);
+        if (tolerance <= 0.0)
+        {
+                tolerance = DXF_FLATTEN_DEFAULT_TOLERANCE;
+        }
+        if (tolerance < radius)
+        {
+                step = 2.0 * acos (1.0 - (tolerance / radius));
+        }
+        else
+        {
+                step = M_PI;
+        }
+        n = ceil (sweep / step);
+        min = ceil (sweep * DXF_FLATTEN_MIN_SEGMENTS_FULL_CIRCLE / (2.0 * M_PI));
+        if (n < min)
+        {
+                n = min;
+        }
+        if (n < 1.0)
+        {
+                n = 1.0;
+        }
+        if (n > DXF_FLATTEN_MAX_SEGMENTS)
+        {
+                n = DXF_FLATTEN_MAX_SEGMENTS;
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return ((int) n);
+}
+
+
+/*!
+ * \brief Flatten a DXF \c ARC entity.
+ *
+ * The arc is traversed counterclockwise from the start angle to the end
+ * angle and added as a new open path.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred or the buffer was too small.
+ */
+int
+dxf_flatten_arc
+(
+        DxfArc *arc,
+                /*!< a pointer to a DXF \c ARC entity. */
+        double tolerance,
+                /*!< maximum allowed deviation (sagitta). */
+        DxfFlattenBuffer *buffer
+                /*!< a pointer to the output buffer. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        double sweep;
+        int n;
+
+        /* Do some basic checks. */
+        if ((arc == NULL) || (arc->p0 == NULL) || (buffer == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        sweep = fmod (arc->end_angle - arc->start_angle, 360.0);
+        if (sweep <= 0.0)
+        {
+                sweep += 360.0;
+        }
+        sweep = sweep * M_PI / 180.0;
+        n = dxf_flatten_get_number_of_segments (arc->radius, sweep, tolerance);
+        dxf_flatten_buffer_begin_path (buffer);
+        dxf_flatten_generate (buffer,
+          arc->p0->x0, arc->p0->y0,
+          arc->radius, 0.0,
+          0.0, arc->radius,
+          arc->start_angle * M_PI / 180.0, sweep, n, TRUE);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (dxf_flatten_buffer_is_overflowed (buffer) ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Flatten a DXF \c CIRCLE entity.
+ *
+ * The circle is added as a new closed path, starting at angle 0.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred or the buffer was too small.
+ */
+int
+dxf_flatten_circle
+(
+        DxfCircle *circle,
+                /*!< a pointer to a DXF \c CIRCLE entity. */
+        double tolerance,
+                /*!< maximum allowed deviation (sagitta). */
+        DxfFlattenBuffer *buffer
+                /*!< a pointer to the output buffer. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        int n;
+
+        /* Do some basic checks. */
+        if ((circle == NULL) || (circle->p0 == NULL) || (buffer == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        n = dxf_flatten_get_number_of_segments (circle->radius, 2.0 * M_PI, tolerance);
+        dxf_flatten_buffer_begin_path (buffer);
+        dxf_flatten_generate (buffer,
+          circle->p0->x0, circle->p0->y0,
+          circle->radius, 0.0,
+          0.0, circle->radius,
+          0.0, 2.0 * M_PI * (n - 1) / n, n - 1, TRUE);
+        dxf_flatten_buffer_close_path (buffer);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (dxf_flatten_buffer_is_overflowed (buffer) ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Flatten a DXF \c ELLIPSE entity.
+ *
+ * The ellipse (or elliptical arc) is traversed counterclockwise from
+ * the start parameter to the end parameter and added as a new path,
+ * which is closed for a full ellipse.
+ *
+ * \warning The extrusion direction is not applied, the ellipse is
+ * flattened in the XY plane of its center point.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred or the buffer was too small.
+ */
+int
+dxf_flatten_ellipse
+(
+        DxfEllipse *ellipse,
+                /*!< a pointer to a DXF \c ELLIPSE entity. */
+        double tolerance,
+                /*!< maximum allowed deviation (sagitta). */
+        DxfFlattenBuffer *buffer
+                /*!< a pointer to the output buffer. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        double ux;
+        double uy;
+        double sweep;
+        int is_full;
+        int n;
+
+        /* Do some basic checks. */
+        if ((ellipse == NULL)
+          || (ellipse->p0 == NULL)
+          || (ellipse->p1 == NULL)
+          || (buffer == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        ux = ellipse->p1->x0;
+        uy = ellipse->p1->y0;
+        sweep = fmod (ellipse->end_angle - ellipse->start_angle, 2.0 * M_PI);
+        if (sweep <= 0.0)
+        {
+                sweep += 2.0 * M_PI;
+        }
+        is_full = (fabs (sweep - (2.0 * M_PI)) < 1.0e-12) ? TRUE : FALSE;
+        /* The major radius gives the largest sagitta. */
+        n = dxf_flatten_get_number_of_segments (hypot (ux, uy), sweep, tolerance);
+        dxf_flatten_buffer_begin_path (buffer);
+        dxf_flatten_generate (buffer,
+          ellipse->p0->x0, ellipse->p0->y0,
+          ux, uy,
+          -uy * ellipse->ratio, ux * ellipse->ratio,
+          ellipse->start_angle,
+          is_full ? sweep * (n - 1) / n : sweep,
+          is_full ? n - 1 : n, TRUE);
+        if (is_full)
+        {
+                dxf_flatten_buffer_close_path (buffer);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (dxf_flatten_buffer_is_overflowed (buffer) ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Flatten a DXF \c LINE entity.
+ *
+ * The line is added as a new path of two vertices, the tolerance is
+ * not used.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred or the buffer was too small.
+ */
+int
+dxf_flatten_line
+(
+        DxfLine *line,
+                /*!< a pointer to a DXF \c LINE entity. */
+        double tolerance,
+                /*!< maximum allowed deviation (not used). */
+        DxfFlattenBuffer *buffer
+                /*!< a pointer to the output buffer. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        (void) tolerance;
+        /* Do some basic checks. */
+        if ((line == NULL)
+          || (line->p0 == NULL)
+          || (line->p1 == NULL)
+          || (buffer == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_flatten_buffer_begin_path (buffer);
+        dxf_flatten_buffer_append (buffer, line->p0->x0, line->p0->y0);
+        dxf_flatten_buffer_append (buffer, line->p1->x0, line->p1->y0);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (dxf_flatten_buffer_is_overflowed (buffer) ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Flatten a single bulged polyline segment.
+ *
+ * The bulge is the tangent of one fourth of the included angle of the
+ * arc segment, a positive bulge means counterclockwise.\n
+ * The start point is only appended when it differs from the last
+ * vertex of the current path, the end point is always appended, so that
+ * consecutive segments chain without duplicate vertices.\n
+ * No new path is started.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred or the buffer was too small.
+ */
+int
+dxf_flatten_bulge
+(
+        double x0,
+                /*!< X-coordinate of the start point. */
+        double y0,
+                /*!< Y-coordinate of the start point. */
+        double x1,
+                /*!< X-coordinate of the end point. */
+        double y1,
+                /*!< Y-coordinate of the end point. */
+        double bulge,
+                /*!< bulge of the segment. */
+        double tolerance,
+                /*!< maximum allowed deviation (sagitta). */
+        DxfFlattenBuffer *buffer
+                /*!< a pointer to the output buffer. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        double dx;
+        double dy;
+        double chord;
+        double sweep;
+        double radius;
+        double offset;
+        double cx;
+        double cy;
+        int n;
+
+        /* Do some basic checks. */
+        if (buffer == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_flatten_buffer_append_unique (buffer, x0, y0);
+        dx = x1 - x0;
+        dy = y1 - y0;
+        chord = hypot (dx, dy);
+        if ((fabs (bulge) < 1.0e-12) || (chord == 0.0))
+        {
+                /* A straight segment. */
+                dxf_flatten_buffer_append (buffer, x1, y1);
+                return (dxf_flatten_buffer_is_overflowed (buffer) ? EXIT_FAILURE : EXIT_SUCCESS);
+        }
+        sweep = 4.0 * atan (bulge);
+        radius = chord * (1.0 + (bulge * bulge)) / (4.0 * fabs (bulge));
+        /* The center lies on the perpendicular bisector of the chord. */
+        offset = (1.0 - (bulge * bulge)) / (4.0 * bulge);
+        cx = ((x0 + x1) / 2.0) - (offset * dy);
+        cy = ((y0 + y1) / 2.0) + (offset * dx);
+        n = dxf_flatten_get_number_of_segments (radius, sweep, tolerance);
+        dxf_flatten_generate (buffer,
+          cx, cy,
+          radius, 0.0,
+          0.0, radius,
+          atan2 (y0 - cy, x0 - cx), sweep * (n - 1) / n, n - 1, FALSE);
+        /* Land exactly on the end point. */
+        dxf_flatten_buffer_append (buffer, x1, y1);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (dxf_flatten_buffer_is_overflowed (buffer) ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Flatten a DXF \c LWPOLYLINE entity, including bulged
+ * segments.
+ *
+ * The lwpolyline is added as a new path, which is closed when bit 1 of
+ * the polyline flag is set.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred or the buffer was too small.
+ */
+int
+dxf_flatten_lwpolyline
+(
+        DxfLWPolyline *lwpolyline,
+                /*!< a pointer to a DXF \c LWPOLYLINE entity. */
+        double tolerance,
+                /*!< maximum allowed deviation (sagitta). */
+        DxfFlattenBuffer *buffer
+                /*!< a pointer to the output buffer. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfVertex *first = NULL;
+        DxfVertex *iter = NULL;
+        DxfVertex *next = NULL;
+        int i;
+
+        /* Do some basic checks. */
+        if ((lwpolyline == NULL) || (buffer == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        first = (DxfVertex *) lwpolyline->vertices;
+        if ((first == NULL) || (first->p0 == NULL))
+        {
+                fprintf (stderr,
+                  (_("Warning in %s () no vertices were found.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_flatten_buffer_begin_path (buffer);
+        iter = first;
+        i = 1;
+        while (iter != NULL)
+        {
+                next = (DxfVertex *) iter->next;
+                /* The number of vertices, when known, takes precedence
+                 * over a trailing empty vertex in the list. */
+                if ((lwpolyline->number_vertices > 0)
+                  && (i >= lwpolyline->number_vertices))
+                {
+                        next = NULL;
+                }
+                if ((next == NULL) || (next->p0 == NULL))
+                {
+                        if (DXF_CHECK_BIT (lwpolyline->flag, 0))
+                        {
+                                dxf_flatten_bulge (iter->p0->x0, iter->p0->y0,
+                                  first->p0->x0, first->p0->y0,
+                                  iter->bulge, tolerance, buffer);
+                        }
+                        else
+                        {
+                                dxf_flatten_buffer_append_unique (buffer,
+                                  iter->p0->x0, iter->p0->y0);
+                        }
+                        break;
+                }
+                dxf_flatten_bulge (iter->p0->x0, iter->p0->y0,
+                  next->p0->x0, next->p0->y0,
+                  iter->bulge, tolerance, buffer);
+                iter = next;
+                i++;
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (dxf_flatten_buffer_is_overflowed (buffer) ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Flatten a 2D DXF \c POLYLINE entity, including bulged
+ * segments.
+ *
+ * The polyline is added as a new path, which is closed when bit 1 of
+ * the polyline flag is set.\n
+ * Spline frame control points (vertex flag bit 16) are skipped.
+ *
+ * \warning Polygon meshes and polyface meshes can not be flattened.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred or the buffer was too small.
+ */
+int
+dxf_flatten_polyline
+(
+        DxfPolyline *polyline,
+                /*!< a pointer to a DXF \c POLYLINE entity. */
+        double tolerance,
+                /*!< maximum allowed deviation (sagitta). */
+        DxfFlattenBuffer *buffer
+                /*!< a pointer to the output buffer. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfVertex *first = NULL;
+        DxfVertex *iter = NULL;
+        DxfVertex *next = NULL;
+
+        /* Do some basic checks. */
+        if ((polyline == NULL) || (buffer == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (DXF_CHECK_BIT (polyline->flag, 4)
+          || DXF_CHECK_BIT (polyline->flag, 6))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a polygon mesh or polyface mesh was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        first = polyline->vertices;
+        while ((first != NULL)
+          && ((first->p0 == NULL) || DXF_CHECK_BIT (first->flag, 4)))
+        {
+                first = (DxfVertex *) first->next;
+        }
+        if (first == NULL)
+        {
+                fprintf (stderr,
+                  (_("Warning in %s () no vertices were found.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_flatten_buffer_begin_path (buffer);
+        iter = first;
+        while (iter != NULL)
+        {
+                next = (DxfVertex *) iter->next;
+                while ((next != NULL)
+                  && ((next->p0 == NULL) || DXF_CHECK_BIT (next->flag, 4)))
+                {
+                        next = (DxfVertex *) next->next;
+                }
+                if (next == NULL)
+                {
+                        if (DXF_CHECK_BIT (polyline->flag, 0))
+                        {
+                                dxf_flatten_bulge (iter->p0->x0, iter->p0->y0,
+                                  first->p0->x0, first->p0->y0,
+                                  iter->bulge, tolerance, buffer);
+                        }
+                        else
+                        {
+                                dxf_flatten_buffer_append_unique (buffer,
+                                  iter->p0->x0, iter->p0->y0);
+                        }
+                        break;
+                }
+                dxf_flatten_bulge (iter->p0->x0, iter->p0->y0,
+                  next->p0->x0, next->p0->y0,
+                  iter->bulge, tolerance, buffer);
+                iter = next;
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (dxf_flatten_buffer_is_overflowed (buffer) ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Flatten a DXF \c HATCH boundary path polyline, including
+ * bulged segments.
+ *
+ * The polyline is added as a new path.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred or the buffer was too small.
+ */
+int
+dxf_flatten_hatch_boundary_path_polyline
+(
+        DxfHatchBoundaryPathPolyline *polyline,
+                /*!< a pointer to a DXF \c HATCH boundary path
+                 * polyline. */
+        double tolerance,
+                /*!< maximum allowed deviation (sagitta). */
+        DxfFlattenBuffer *buffer
+                /*!< a pointer to the output buffer. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfHatchBoundaryPathPolylineVertex *first = NULL;
+        DxfHatchBoundaryPathPolylineVertex *iter = NULL;
+        DxfHatchBoundaryPathPolylineVertex *next = NULL;
+        double bulge;
+
+        /* Do some basic checks. */
+        if ((polyline == NULL) || (buffer == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        first = (DxfHatchBoundaryPathPolylineVertex *) polyline->vertices;
+        if (first == NULL)
+        {
+                fprintf (stderr,
+                  (_("Warning in %s () no vertices were found.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_flatten_buffer_begin_path (buffer);
+        iter = first;
+        while (iter != NULL)
+        {
+                next = (DxfHatchBoundaryPathPolylineVertex *) iter->next;
+                bulge = iter->has_bulge ? iter->bulge : 0.0;
+                if (next == NULL)
+                {
+                        if (polyline->is_closed)
+                        {
+                                dxf_flatten_bulge (iter->x0, iter->y0,
+                                  first->x0, first->y0,
+                                  bulge, tolerance, buffer);
+                        }
+                        else
+                        {
+                                dxf_flatten_buffer_append_unique (buffer,
+                                  iter->x0, iter->y0);
+                        }
+                        break;
+                }
+                dxf_flatten_bulge (iter->x0, iter->y0,
+                  next->x0, next->y0,
+                  bulge, tolerance, buffer);
+                iter = next;
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (dxf_flatten_buffer_is_overflowed (buffer) ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Flatten a DXF \c HATCH boundary path edge arc.
+ *
+ * The vertices are appended to the current path.\n
+ * The angles of a clockwise edge arc are stored mirrored, the arc then
+ * runs clockwise from the negated start angle to the negated end
+ * angle.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred or the buffer was too small.
+ */
+int
+dxf_flatten_hatch_boundary_path_edge_arc
+(
+        DxfHatchBoundaryPathEdgeArc *arc,
+                /*!< a pointer to a DXF \c HATCH boundary path edge
+                 * arc. */
+        double tolerance,
+                /*!< maximum allowed deviation (sagitta). */
+        DxfFlattenBuffer *buffer
+                /*!< a pointer to the output buffer. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        double start;
+        double sweep;
+        int n;
+
+        /* Do some basic checks. */
+        if ((arc == NULL) || (buffer == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        sweep = fmod (arc->end_angle - arc->start_angle, 360.0);
+        if (sweep <= 0.0)
+        {
+                sweep += 360.0;
+        }
+        sweep = sweep * M_PI / 180.0;
+        start = arc->start_angle * M_PI / 180.0;
+        if (!arc->is_ccw)
+        {
+                start = -start;
+                sweep = -sweep;
+        }
+        n = dxf_flatten_get_number_of_segments (arc->radius, sweep, tolerance);
+        dxf_flatten_buffer_append_unique (buffer,
+          arc->x0 + (arc->radius * cos (start)),
+          arc->y0 + (arc->radius * sin (start)));
+        dxf_flatten_generate (buffer,
+          arc->x0, arc->y0,
+          arc->radius, 0.0,
+          0.0, arc->radius,
+          start, sweep, n, FALSE);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (dxf_flatten_buffer_is_overflowed (buffer) ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Flatten a DXF \c HATCH boundary path edge ellipse.
+ *
+ * The vertices are appended to the current path.\n
+ * The start and end angles are parametric angles in degrees, mirrored
+ * for clockwise edges (see dxf_flatten_hatch_boundary_path_edge_arc()).
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred or the buffer was too small.
+ */
+int
+dxf_flatten_hatch_boundary_path_edge_ellipse
+(
+        DxfHatchBoundaryPathEdgeEllipse *ellipse,
+                /*!< a pointer to a DXF \c HATCH boundary path edge
+                 * ellipse. */
+        double tolerance,
+                /*!< maximum allowed deviation (sagitta). */
+        DxfFlattenBuffer *buffer
+                /*!< a pointer to the output buffer. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        double start;
+        double sweep;
+        double vx;
+        double vy;
+        int n;
+
+        /* Do some basic checks. */
+        if ((ellipse == NULL) || (buffer == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        sweep = fmod (ellipse->end_angle - ellipse->start_angle, 360.0);
+        if (sweep <= 0.0)
+        {
+                sweep += 360.0;
+        }
+        sweep = sweep * M_PI / 180.0;
+        start = ellipse->start_angle * M_PI / 180.0;
+        if (!ellipse->is_ccw)
+        {
+                start = -start;
+                sweep = -sweep;
+        }
+        vx = -ellipse->y1 * ellipse->ratio;
+        vy = ellipse->x1 * ellipse->ratio;
+        n = dxf_flatten_get_number_of_segments (hypot (ellipse->x1, ellipse->y1), sweep, tolerance);
+        dxf_flatten_buffer_append_unique (buffer,
+          ellipse->x0 + (cos (start) * ellipse->x1) + (sin (start) * vx),
+          ellipse->y0 + (cos (start) * ellipse->y1) + (sin (start) * vy));
+        dxf_flatten_generate (buffer,
+          ellipse->x0, ellipse->y0,
+          ellipse->x1, ellipse->y1,
+          vx, vy,
+          start, sweep, n, FALSE);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (dxf_flatten_buffer_is_overflowed (buffer) ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Flatten a DXF \c HATCH boundary path edge spline.
+ *
+ * The (rational) B-spline is evaluated with the de Boor algorithm at
+ * evenly spaced parameter values, the number of samples is estimated
+ * from the length of the control polygon.\n
+ * The vertices are appended to the current path.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred or the buffer was too small.
+ */
+int
+dxf_flatten_hatch_boundary_path_edge_spline
+(
+        DxfHatchBoundaryPathEdgeSpline *spline,
+                /*!< a pointer to a DXF \c HATCH boundary path edge
+                 * spline. */
+        double tolerance,
+                /*!< maximum allowed deviation (sagitta). */
+        DxfFlattenBuffer *buffer
+                /*!< a pointer to the output buffer. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfHatchBoundaryPathEdgeSplineCp *iter = NULL;
+        double *cp = NULL;
+        double dx[DXF_FLATTEN_SPLINE_MAX_DEGREE + 1];
+        double dy[DXF_FLATTEN_SPLINE_MAX_DEGREE + 1];
+        double dw[DXF_FLATTEN_SPLINE_MAX_DEGREE + 1];
+        double length;
+        double u;
+        double u_min;
+        double u_max;
+        double alpha;
+        int number_of_cp;
+        int degree;
+        int number_of_samples;
+        int span;
+        int i;
+        int j;
+        int r;
+
+        /* Do some basic checks. */
+        if ((spline == NULL) || (buffer == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        degree = spline->degree;
+        number_of_cp = 0;
+        iter = (DxfHatchBoundaryPathEdgeSplineCp *) spline->control_points;
+        while (iter != NULL)
+        {
+                number_of_cp++;
+                iter = (DxfHatchBoundaryPathEdgeSplineCp *) iter->next;
+        }
+        if ((degree < 1)
+          || (degree > DXF_FLATTEN_SPLINE_MAX_DEGREE)
+          || (number_of_cp < degree + 1)
+          || (spline->number_of_knots != number_of_cp + degree + 1)
+          || (spline->number_of_knots > DXF_MAX_HATCH_BOUNDARY_PATH_EDGE_SPLINE_KNOTS))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () an inconsistent spline definition was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        /* Copy the control points in homogeneous coordinates into a
+         * contiguous array. */
+        cp = malloc (3 * number_of_cp * sizeof (double));
+        if (cp == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        length = 0.0;
+        iter = (DxfHatchBoundaryPathEdgeSplineCp *) spline->control_points;
+        for (i = 0; i < number_of_cp; i++)
+        {
+                double w;
+
+                w = (spline->rational && (iter->weight > 0.0)) ? iter->weight : 1.0;
+                cp[(3 * i)] = iter->x0 * w;
+                cp[(3 * i) + 1] = iter->y0 * w;
+                cp[(3 * i) + 2] = w;
+                if (i > 0)
+                {
+                        length += hypot ((cp[(3 * i)] / w) - (cp[(3 * (i - 1))] / cp[(3 * (i - 1)) + 2]),
+                          (cp[(3 * i) + 1] / w) - (cp[(3 * (i - 1)) + 1] / cp[(3 * (i - 1)) + 2]));
+                }
+                iter = (DxfHatchBoundaryPathEdgeSplineCp *) iter->next;
+        }
+        if (tolerance <= 0.0)
+        {
+                tolerance = DXF_FLATTEN_DEFAULT_TOLERANCE;
+        }
+        number_of_samples = (int) ceil (sqrt (length / tolerance));
+        if (number_of_samples < 2 * number_of_cp)
+        {
+                number_of_samples = 2 * number_of_cp;
+        }
+        if (number_of_samples > DXF_FLATTEN_MAX_SEGMENTS)
+        {
+                number_of_samples = DXF_FLATTEN_MAX_SEGMENTS;
+        }
+        u_min = spline->knots[degree];
+        u_max = spline->knots[number_of_cp];
+        span = degree;
+        for (i = 0; i <= number_of_samples; i++)
+        {
+                u = u_min + ((u_max - u_min) * i / number_of_samples);
+                if (i == number_of_samples)
+                {
+                        u = u_max;
+                }
+                /* Find the knot span, the parameter only increases. */
+                while ((span < number_of_cp - 1) && (u >= spline->knots[span + 1]))
+                {
+                        span++;
+                }
+                for (j = 0; j <= degree; j++)
+                {
+                        dx[j] = cp[3 * (span - degree + j)];
+                        dy[j] = cp[(3 * (span - degree + j)) + 1];
+                        dw[j] = cp[(3 * (span - degree + j)) + 2];
+                }
+                for (r = 1; r <= degree; r++)
+                {
+                        for (j = degree; j >= r; j--)
+                        {
+                                double denominator;
+
+                                denominator = spline->knots[span + 1 + j - r]
+                                  - spline->knots[span - degree + j];
+                                alpha = (denominator == 0.0) ? 0.0
+                                  : (u - spline->knots[span - degree + j]) / denominator;
+                                dx[j] = ((1.0 - alpha) * dx[j - 1]) + (alpha * dx[j]);
+                                dy[j] = ((1.0 - alpha) * dy[j - 1]) + (alpha * dy[j]);
+                                dw[j] = ((1.0 - alpha) * dw[j - 1]) + (alpha * dw[j]);
+                        }
+                }
+                dxf_flatten_buffer_append_unique (buffer,
+                  dx[degree] / dw[degree], dy[degree] / dw[degree]);
+        }
+        free (cp);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (dxf_flatten_buffer_is_overflowed (buffer) ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Flatten a DXF \c HATCH boundary path.
+ *
+ * A polyline boundary path is added as a new path, an edge defined
+ * boundary path is added as a single new closed path with its line,
+ * arc, ellipse and spline edges in the order found in the edge list.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred or the buffer was too small.
+ */
+int
+dxf_flatten_hatch_boundary_path
+(
+        DxfHatchBoundaryPath *path,
+                /*!< a pointer to a DXF \c HATCH boundary path. */
+        double tolerance,
+                /*!< maximum allowed deviation (sagitta). */
+        DxfFlattenBuffer *buffer
+                /*!< a pointer to the output buffer. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfHatchBoundaryPathPolyline *polyline = NULL;
+        DxfHatchBoundaryPathEdge *edge = NULL;
+        DxfHatchBoundaryPathEdgeArc *arc = NULL;
+        DxfHatchBoundaryPathEdgeEllipse *ellipse = NULL;
+        DxfHatchBoundaryPathEdgeLine *line = NULL;
+        DxfHatchBoundaryPathEdgeSpline *spline = NULL;
+
+        /* Do some basic checks. */
+        if ((path == NULL) || (buffer == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        polyline = (DxfHatchBoundaryPathPolyline *) path->polylines;
+        while (polyline != NULL)
+        {
+                dxf_flatten_hatch_boundary_path_polyline (polyline, tolerance, buffer);
+                polyline = (DxfHatchBoundaryPathPolyline *) polyline->next;
+        }
+        edge = (DxfHatchBoundaryPathEdge *) path->edges;
+        if (edge != NULL)
+        {
+                dxf_flatten_buffer_begin_path (buffer);
+        }
+        while (edge != NULL)
+        {
+                line = (DxfHatchBoundaryPathEdgeLine *) edge->lines;
+                while (line != NULL)
+                {
+                        dxf_flatten_buffer_append_unique (buffer, line->x0, line->y0);
+                        dxf_flatten_buffer_append_unique (buffer, line->x1, line->y1);
+                        line = (DxfHatchBoundaryPathEdgeLine *) line->next;
+                }
+                arc = (DxfHatchBoundaryPathEdgeArc *) edge->arcs;
+                while (arc != NULL)
+                {
+                        dxf_flatten_hatch_boundary_path_edge_arc (arc, tolerance, buffer);
+                        arc = (DxfHatchBoundaryPathEdgeArc *) arc->next;
+                }
+                ellipse = (DxfHatchBoundaryPathEdgeEllipse *) edge->ellipses;
+                while (ellipse != NULL)
+                {
+                        dxf_flatten_hatch_boundary_path_edge_ellipse (ellipse, tolerance, buffer);
+                        ellipse = (DxfHatchBoundaryPathEdgeEllipse *) ellipse->next;
+                }
+                spline = (DxfHatchBoundaryPathEdgeSpline *) edge->splines;
+                while (spline != NULL)
+                {
+                        dxf_flatten_hatch_boundary_path_edge_spline (spline, tolerance, buffer);
+                        spline = (DxfHatchBoundaryPathEdgeSpline *) spline->next;
+                }
+                edge = (DxfHatchBoundaryPathEdge *) edge->next;
+                if (edge == NULL)
+                {
+                        dxf_flatten_buffer_close_path (buffer);
+                }
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (dxf_flatten_buffer_is_overflowed (buffer) ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Flatten all boundary paths of a DXF \c HATCH entity.
+ *
+ * Every boundary path is added as a separate path.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred or the buffer was too small.
+ */
+int
+dxf_flatten_hatch
+(
+        DxfHatch *hatch,
+                /*!< a pointer to a DXF \c HATCH entity. */
+        double tolerance,
+                /*!< maximum allowed deviation (sagitta). */
+        DxfFlattenBuffer *buffer
+                /*!< a pointer to the output buffer. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfHatchBoundaryPath *path = NULL;
+        int result;
+
+        /* Do some basic checks. */
+        if ((hatch == NULL) || (buffer == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        result = EXIT_SUCCESS;
+        path = (DxfHatchBoundaryPath *) hatch->paths;
+        while (path != NULL)
+        {
+                if (dxf_flatten_hatch_boundary_path (path, tolerance, buffer) != EXIT_SUCCESS)
+                {
+                        result = EXIT_FAILURE;
+                }
+                path = (DxfHatchBoundaryPath *) path->next;
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (result);
+}
+
+
+/*!
+ * \brief Flatten a DXF entity into polylines.
+ *
+ * Supported are the \c ARC, \c CIRCLE, \c ELLIPSE, \c HATCH, \c LINE,
+ * \c LWPOLYLINE and (2D) \c POLYLINE entities.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred, the entity type is not supported or the buffer was too
+ * small (see dxf_flatten_buffer_is_overflowed()).
+ */
+int
+dxf_entity_flatten
+(
+        void *entity,
+                /*!< a pointer to a DXF entity. */
+        DxfEntityType entity_type,
+                /*!< the type of the entity. */
+        double tolerance,
+                /*!< maximum allowed deviation (sagitta). */
+        DxfFlattenBuffer *buffer
+                /*!< a pointer to the output buffer. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        int result;
+
+        /* Do some basic checks. */
+        if ((entity == NULL) || (buffer == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        switch (entity_type)
+        {
+                case ARC:
+                        result = dxf_flatten_arc ((DxfArc *) entity, tolerance, buffer);
+                        break;
+                case CIRCLE:
+                        result = dxf_flatten_circle ((DxfCircle *) entity, tolerance, buffer);
+                        break;
+                case ELLIPSE:
+                        result = dxf_flatten_ellipse ((DxfEllipse *) entity, tolerance, buffer);
+                        break;
+                case HATCH:
+                        result = dxf_flatten_hatch ((DxfHatch *) entity, tolerance, buffer);
+                        break;
+                case LINE:
+                        result = dxf_flatten_line ((DxfLine *) entity, tolerance, buffer);
+                        break;
+                case LWPOLYLINE:
+                        result = dxf_flatten_lwpolyline ((DxfLWPolyline *) entity, tolerance, buffer);
+                        break;
+                case POLYLINE:
+                        result = dxf_flatten_polyline ((DxfPolyline *) entity, tolerance, buffer);
+                        break;
+                default:
+                        fprintf (stderr,
+                          (_("Error in %s () an unsupported entity type was passed.\n")),
+                          __FUNCTION__);
+                        result = EXIT_FAILURE;
+                        break;
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (result);
+}
+
+
+/*!
+ * \brief Start a new path in a \c DxfFlattenBuffer.
+ *
+ * No checks are done, this function is meant for producers of paths in
+ * inner loops.
+ */
+void
+dxf_flatten_buffer_begin_path
+(
+        DxfFlattenBuffer *buffer
+                /*!< a pointer to the buffer. */
+)
+{
+        if ((buffer->path_start != NULL)
+          && (buffer->number_of_paths < buffer->max_number_of_paths))
+        {
+                buffer->path_start[buffer->number_of_paths] = buffer->number_of_vertices;
+        }
+        buffer->number_of_paths++;
+        buffer->path_first_vertex = buffer->number_of_vertices;
+}
+
+
+/*!
+ * \brief Append a vertex to a \c DxfFlattenBuffer.
+ *
+ * No checks are done, this function is meant for producers of paths in
+ * inner loops.
+ */
+void
+dxf_flatten_buffer_append
+(
+        DxfFlattenBuffer *buffer,
+                /*!< a pointer to the buffer. */
+        double x,
+                /*!< X-coordinate of the vertex. */
+        double y
+                /*!< Y-coordinate of the vertex. */
+)
+{
+        if (buffer->number_of_vertices < buffer->max_number_of_vertices)
+        {
+                buffer->x[buffer->number_of_vertices] = x;
+                buffer->y[buffer->number_of_vertices] = y;
+        }
+        buffer->number_of_vertices++;
+}
+
+
+/*!
+ * \brief Append a vertex to a \c DxfFlattenBuffer, unless it equals the
+ * last vertex of the current path.
+ *
+ * When the buffer has overflowed the comparison is not possible and the
+ * vertex is counted, thus the required size is an upper bound.
+ */
+static void
+dxf_flatten_buffer_append_unique
+(
+        DxfFlattenBuffer *buffer,
+                /*!< a pointer to the buffer. */
+        double x,
+                /*!< X-coordinate of the vertex. */
+        double y
+                /*!< Y-coordinate of the vertex. */
+)
+{
+        int last;
+
+        last = buffer->number_of_vertices - 1;
+        if ((last >= buffer->path_first_vertex)
+          && (last < buffer->max_number_of_vertices)
+          && (buffer->x[last] == x)
+          && (buffer->y[last] == y))
+        {
+                return;
+        }
+        dxf_flatten_buffer_append (buffer, x, y);
+}
+
+
+/*!
+ * \brief Close the current path in a \c DxfFlattenBuffer by repeating
+ * its first vertex.
+ */
+static void
+dxf_flatten_buffer_close_path
+(
+        DxfFlattenBuffer *buffer
+                /*!< a pointer to the buffer. */
+)
+{
+        int first;
+
+        first = buffer->path_first_vertex;
+        if (first >= buffer->number_of_vertices)
+        {
+                return;
+        }
+        if (first < buffer->max_number_of_vertices)
+        {
+                dxf_flatten_buffer_append_unique (buffer,
+                  buffer->x[first], buffer->y[first]);
+        }
+        else
+        {
+                buffer->number_of_vertices++;
+        }
+}
+
+
+/*!
+ * \brief Generate vertices on an elliptical (or circular) arc.
+ *
+ * The vertices are <tt>C + cos (a) * U + sin (a) * V</tt> with
+ * <tt>a = start + i * sweep / number_of_segments</tt>.\n
+ * The sine and cosine are evaluated exactly once per block of
+ * \c DXF_FLATTEN_BLOCK_SIZE vertices, within a block the angle is
+ * advanced with a table of precomputed increments.\n
+ * The inner loop has no loop carried dependencies, and writes straight
+ * into the buffer arrays.
+ */
+static void
+dxf_flatten_generate
+(
+        DxfFlattenBuffer *buffer,
+                /*!< a pointer to the buffer. */
+        double cx,
+                /*!< X-coordinate of the center. */
+        double cy,
+                /*!< Y-coordinate of the center. */
+        double ux,
+                /*!< X-component of the first axis. */
+        double uy,
+                /*!< Y-component of the first axis. */
+        double vx,
+                /*!< X-component of the second axis. */
+        double vy,
+                /*!< Y-component of the second axis. */
+        double start,
+                /*!< start angle in radians. */
+        double sweep,
+                /*!< included angle in radians, negative for
+                 * clockwise. */
+        int number_of_segments,
+                /*!< number of segments. */
+        int include_first
+                /*!< also generate the vertex at the start angle. */
+)
+{
+        double cos_table[DXF_FLATTEN_BLOCK_SIZE];
+        double sin_table[DXF_FLATTEN_BLOCK_SIZE];
+        double step;
+        double c0;
+        double s0;
+        double c;
+        double s;
+        double *restrict px;
+        double *restrict py;
+        int table_size;
+        int count;
+        int base;
+        int i;
+        int j;
+
+        if (number_of_segments < 1)
+        {
+                return;
+        }
+        step = sweep / number_of_segments;
+        table_size = (number_of_segments + 1 < DXF_FLATTEN_BLOCK_SIZE)
+          ? number_of_segments + 1 : DXF_FLATTEN_BLOCK_SIZE;
+        for (j = 0; j < table_size; j++)
+        {
+                cos_table[j] = cos (j * step);
+                sin_table[j] = sin (j * step);
+        }
+        i = include_first ? 0 : 1;
+        while (i <= number_of_segments)
+        {
+                count = number_of_segments - i + 1;
+                if (count > table_size)
+                {
+                        count = table_size;
+                }
+                c0 = cos (start + (i * step));
+                s0 = sin (start + (i * step));
+                base = buffer->number_of_vertices;
+                if (base + count <= buffer->max_number_of_vertices)
+                {
+                        px = buffer->x + base;
+                        py = buffer->y + base;
+                        for (j = 0; j < count; j++)
+                        {
+                                c = (c0 * cos_table[j]) - (s0 * sin_table[j]);
+                                s = (s0 * cos_table[j]) + (c0 * sin_table[j]);
+                                px[j] = cx + (c * ux) + (s * vx);
+                                py[j] = cy + (c * uy) + (s * vy);
+                        }
+                        buffer->number_of_vertices += count;
+                }
+                else
+                {
+                        for (j = 0; j < count; j++)
+                        {
+                                c = (c0 * cos_table[j]) - (s0 * sin_table[j]);
+                                s = (s0 * cos_table[j]) + (c0 * sin_table[j]);
+                                dxf_flatten_buffer_append (buffer,
+                                  cx + (c * ux) + (s * vx),
+                                  cy + (c * uy) + (s * vy));
+                        }
+                }
+                i += count;
+        }
+}
+
+
+/* EOF */
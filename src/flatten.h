@@ -0,0 +1,156 @@
+/*!
+ * \file flatten.h
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Header file for flattening curved DXF entities into polylines.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#ifndef LIBDXF_SRC_FLATTEN_H
+#define LIBDXF_SRC_FLATTEN_H
+
+
+#include "global.h"
+#include "arc.h"
+#include "circle.h"
+#include "ellipse.h"
+#include "hatch.h"
+#include "line.h"
+#include "lwpolyline.h"
+#include "polyline.h"
+#include "vertex.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define DXF_FLATTEN_DEFAULT_TOLERANCE 0.01
+        /*!< \brief The default chord tolerance (maximum sagitta) used
+         * when a tolerance of zero or less is passed. */
+
+#define DXF_FLATTEN_MIN_SEGMENTS_FULL_CIRCLE 8
+        /*!< \brief The minimum number of segments for a full circle or
+         * a full ellipse. */
+
+#define DXF_FLATTEN_MAX_SEGMENTS 65536
+        /*!< \brief The maximum number of segments generated for a
+         * single curve. */
+
+#define DXF_FLATTEN_BLOCK_SIZE 32
+        /*!< \brief The number of vertices generated from a single
+         * exact sine/cosine evaluation.
+         *
+         * Within a block the vertices are obtained by rotating the
+         * block start over a precomputed table of angle increments,
+         * which keeps the inner loop free of loop carried dependencies
+         * and thus vectorizable, without the drift of a plain
+         * rotation recurrence. */
+
+#define DXF_FLATTEN_SPLINE_MAX_DEGREE 16
+        /*!< \brief The maximum spline degree supported by the
+         * flattening of hatch boundary spline edges. */
+
+
+/*!
+ * \brief Definition of a contiguous vertex buffer for flattened
+ * geometry.
+ *
+ * The buffer holds the vertices of one or more polylines (paths) as
+ * separate X and Y arrays.\n
+ * The arrays may be allocated with dxf_flatten_buffer_init(), or may be
+ * provided by the caller by filling in the pointers and the maximum
+ * counts.\n
+ * Closed paths are stored with the first vertex repeated as the last
+ * vertex.\n
+ * Coordinates are in the Object Coordinate System (OCS) of the
+ * flattened entity.\n
+ * When the buffer is too small, no data is written beyond the maximum
+ * counts, but the counts keep incrementing, so that after a failed call
+ * \c number_of_vertices and \c number_of_paths hold the required sizes.
+ */
+typedef struct
+dxf_flatten_buffer_struct
+{
+        double *x;
+                /*!< Array of X-coordinates. */
+        double *y;
+                /*!< Array of Y-coordinates. */
+        int number_of_vertices;
+                /*!< Number of vertices stored (or required). */
+        int max_number_of_vertices;
+                /*!< Number of vertices that fit in \c x and \c y. */
+        int *path_start;
+                /*!< Array with the index of the first vertex of each
+                 * path (optional, may be \c NULL). */
+        int number_of_paths;
+                /*!< Number of paths stored (or required). */
+        int max_number_of_paths;
+                /*!< Number of entries that fit in \c path_start. */
+        int path_first_vertex;
+                /*!< Index of the first vertex of the current path. */
+} DxfFlattenBuffer;
+
+
+DxfFlattenBuffer *dxf_flatten_buffer_new ();
+DxfFlattenBuffer *dxf_flatten_buffer_init (DxfFlattenBuffer *buffer, int max_number_of_vertices, int max_number_of_paths);
+int dxf_flatten_buffer_reset (DxfFlattenBuffer *buffer);
+int dxf_flatten_buffer_reserve (DxfFlattenBuffer *buffer, int max_number_of_vertices, int max_number_of_paths);
+void dxf_flatten_buffer_begin_path (DxfFlattenBuffer *buffer);
+void dxf_flatten_buffer_append (DxfFlattenBuffer *buffer, double x, double y);
+int dxf_flatten_buffer_is_overflowed (DxfFlattenBuffer *buffer);
+int dxf_flatten_buffer_get_path_size (DxfFlattenBuffer *buffer, int path);
+int dxf_flatten_buffer_free (DxfFlattenBuffer *buffer);
+int dxf_flatten_get_number_of_segments (double radius, double sweep_angle, double tolerance);
+int dxf_flatten_arc (DxfArc *arc, double tolerance, DxfFlattenBuffer *buffer);
+int dxf_flatten_circle (DxfCircle *circle, double tolerance, DxfFlattenBuffer *buffer);
+int dxf_flatten_ellipse (DxfEllipse *ellipse, double tolerance, DxfFlattenBuffer *buffer);
+int dxf_flatten_line (DxfLine *line, double tolerance, DxfFlattenBuffer *buffer);
+int dxf_flatten_bulge (double x0, double y0, double x1, double y1, double bulge, double tolerance, DxfFlattenBuffer *buffer);
+int dxf_flatten_lwpolyline (DxfLWPolyline *lwpolyline, double tolerance, DxfFlattenBuffer *buffer);
+int dxf_flatten_polyline (DxfPolyline *polyline, double tolerance, DxfFlattenBuffer *buffer);
+int dxf_flatten_hatch_boundary_path_polyline (DxfHatchBoundaryPathPolyline *polyline, double tolerance, DxfFlattenBuffer *buffer);
+int dxf_flatten_hatch_boundary_path_edge_arc (DxfHatchBoundaryPathEdgeArc *arc, double tolerance, DxfFlattenBuffer *buffer);
+int dxf_flatten_hatch_boundary_path_edge_ellipse (DxfHatchBoundaryPathEdgeEllipse *ellipse, double tolerance, DxfFlattenBuffer *buffer);
+int dxf_flatten_hatch_boundary_path_edge_spline (DxfHatchBoundaryPathEdgeSpline *spline, double tolerance, DxfFlattenBuffer *buffer);
+int dxf_flatten_hatch_boundary_path (DxfHatchBoundaryPath *path, double tolerance, DxfFlattenBuffer *buffer);
+int dxf_flatten_hatch (DxfHatch *hatch, double tolerance, DxfFlattenBuffer *buffer);
+int dxf_entity_flatten (void *entity, DxfEntityType entity_type, double tolerance, DxfFlattenBuffer *buffer);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* LIBDXF_SRC_FLATTEN_H */
+
+
+/* EOF */
@@ -206,6 +206,9 @@ dxf_file_struct
         /*!< AutoCAD version number. */
     int follow_strict_version_rules;
         /*!< follow strict rules when writing to file. */
+    struct dxf_stats_struct *stats;
+        /*!< Statistics counted for this file in addition to the
+         * totals, \c NULL when not counted per file. */
 } DxfFile;
 
 
@@ -341,6 +344,8 @@ dxf_int32_struct
         /*!< \brief AutoCAD 2012. */
 #define AutoCAD_2013 1027
         /*!< \brief AutoCAD 2013. */
+#define AutoCAD_2018 1032
+        /*!< \brief AutoCAD 2018. */
 #define AutoCAD_LT2 1009
         /*!< \brief AutoCAD 11 & AutoCAD 12 == AutoCAD LT2. */
 #define AutoCAD_LT95 1012
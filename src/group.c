@@ -42,6 +42,7 @@
 
 
 #include "group.h"
+#include "util.h"
 
 
 /*!
@@ -112,12 +113,12 @@ dxf_group_init
                 return (NULL);
         }
         group->id_code = 0;
-        group->description = strdup ("");
-        group->handle_entity_in_group = strdup ("");
+        group->description = dxf_string_share ("");
+        group->handle_entity_in_group = dxf_string_share ("");
         group->unnamed_flag = 0;
         group->selectability_flag = 0;
-        group->dictionary_owner_soft = strdup ("");
-        group->dictionary_owner_hard = strdup ("");
+        group->dictionary_owner_soft = dxf_string_share ("");
+        group->dictionary_owner_hard = dxf_string_share ("");
         group->next = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -226,29 +227,25 @@ dxf_group_read
                 else if (strcmp (temp_string, "300") == 0)
                 {
                         /* Now follows a string containing a description. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", group->description);
+                        dxf_read_string (fp, &group->description);
                 }
                 else if (strcmp (temp_string, "330") == 0)
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", group->dictionary_owner_soft);
+                        dxf_read_string (fp, &group->dictionary_owner_soft);
                 }
                 else if (strcmp (temp_string, "340") == 0)
                 {
                         /* Now follows a string containing a handle to an
                          * entry in group object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", group->handle_entity_in_group);
+                        dxf_read_string (fp, &group->handle_entity_in_group);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", group->dictionary_owner_hard);
+                        dxf_read_string (fp, &group->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "999") == 0)
                 {
@@ -416,10 +413,11 @@ dxf_group_free
                 __FUNCTION__);
               return (EXIT_FAILURE);
         }
-        free (group->dictionary_owner_soft);
-        free (group->dictionary_owner_hard);
-        free (group->description);
-        free (group->handle_entity_in_group);
+        dxf_string_free (group->dictionary_owner_soft);
+        dxf_string_free (group->dictionary_owner_hard);
+        dxf_string_free (group->description);
+        dxf_string_free (group->handle_entity_in_group);
+        dxf_string_free (group->object_owner_soft);
         free (group);
         group = NULL;
 #if DEBUG
@@ -594,6 +592,8 @@ dxf_group_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (group == NULL)
         {
@@ -609,7 +609,13 @@ dxf_group_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        group->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (group->dictionary_owner_soft);
+        group->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -674,6 +680,8 @@ dxf_group_set_object_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (group == NULL)
         {
@@ -689,7 +697,13 @@ dxf_group_set_object_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        group->object_owner_soft = strdup (object_owner_soft);
+        copy = dxf_string_share (object_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (group->object_owner_soft);
+        group->object_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -754,6 +768,8 @@ dxf_group_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (group == NULL)
         {
@@ -769,7 +785,13 @@ dxf_group_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        group->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (group->dictionary_owner_hard);
+        group->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -993,6 +1015,8 @@ dxf_group_set_description
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (group == NULL)
         {
@@ -1008,7 +1032,13 @@ dxf_group_set_description
                   __FUNCTION__);
                 return (NULL);
         }
-        group->description = strdup (description);
+        copy = dxf_string_share (description);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (group->description);
+        group->description = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1070,6 +1100,8 @@ dxf_group_set_handle_entity_in_group
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (group == NULL)
         {
@@ -1085,7 +1117,13 @@ dxf_group_set_handle_entity_in_group
                   __FUNCTION__);
                 return (NULL);
         }
-        group->handle_entity_in_group = strdup (handle_entity_in_group);
+        copy = dxf_string_share (handle_entity_in_group);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (group->handle_entity_in_group);
+        group->handle_entity_in_group = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -0,0 +1,1053 @@
+/*!
+ * \file handle.c
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Functions for allocating, renumbering and encoding DXF handles.
+ *
+ * Handles are written as hexadecimal strings with group codes 5, 105,
+ * 320 to 369 and 390 to 399.\n
+ * A \c DxfHandleAllocator hands out the handles of a drawing and keeps
+ * track of the handle seed (\c $HANDSEED), writers running in parallel
+ * reserve a \c DxfHandleBlock each and take their handles from it without
+ * touching the shared allocator.\n
+ * When drawings are merged, dxf_handle_renumber () gives every object of
+ * the merged drawing a new handle and records the old handle in a
+ * \c DxfHandleMap, after which the references to those objects are
+ * updated with dxf_handle_remap () and dxf_handle_remap_hex ().
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include "handle.h"
+#include "util.h"
+
+
+/*!
+ * \brief Hexadecimal digits of dxf_handle_to_hex ().
+ */
+static const char dxf_handle_hex_digits[] = "0123456789ABCDEF";
+
+
+/*!
+ * \brief Values of the hexadecimal digits plus one, 0 for any other
+ * character.
+ */
+static const unsigned char dxf_handle_hex_values[256] =
+{
+        ['0'] = 1, ['1'] = 2, ['2'] = 3, ['3'] = 4, ['4'] = 5,
+        ['5'] = 6, ['6'] = 7, ['7'] = 8, ['8'] = 9, ['9'] = 10,
+        ['A'] = 11, ['B'] = 12, ['C'] = 13, ['D'] = 14, ['E'] = 15,
+        ['F'] = 16,
+        ['a'] = 11, ['b'] = 12, ['c'] = 13, ['d'] = 14, ['e'] = 15,
+        ['f'] = 16
+};
+
+
+static int dxf_handle_map_grow (DxfHandleMap *map);
+static int dxf_handle_map_find (DxfHandleMap *map, int old_handle);
+
+
+/*!
+ * \brief Encode a handle as an upper case hexadecimal string without
+ * leading zeros.
+ *
+ * The \c buffer has to hold at least \c DXF_HANDLE_HEX_SIZE
+ * characters.
+ *
+ * \return the length of the string, or 0 when an error occurred.
+ */
+int
+dxf_handle_to_hex
+(
+        int handle,
+                /*!< the handle. */
+        char *buffer
+                /*!< a buffer receiving the string. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        unsigned int value;
+        unsigned int rest;
+        int length;
+        int i;
+
+        /* Do some basic checks. */
+        if (buffer == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (0);
+        }
+        value = (unsigned int) handle;
+        length = 1;
+        for (rest = value >> 4; rest != 0; rest >>= 4)
+        {
+                length++;
+        }
+        buffer[length] = '\0';
+        for (i = length - 1; i >= 0; i--)
+        {
+                buffer[i] = dxf_handle_hex_digits[value & 0xF];
+                value >>= 4;
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (length);
+}
+
+
+/*!
+ * \brief Decode a hexadecimal handle string.
+ *
+ * Leading spaces and trailing white space are skipped, upper and lower
+ * case digits are accepted.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when the
+ * string is not a handle or does not fit an \c int, \c handle is not
+ * changed in that case.
+ */
+int
+dxf_handle_from_hex
+(
+        const char *string,
+                /*!< the string to decode. */
+        int *handle
+                /*!< the decoded handle. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        const unsigned char *iter = NULL;
+        unsigned int value = 0;
+        unsigned int digit;
+        int number_of_digits = 0;
+
+        /* Do some basic checks. */
+        if ((string == NULL) || (handle == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        iter = (const unsigned char *) string;
+        while ((*iter == ' ') || (*iter == '\t'))
+        {
+                iter++;
+        }
+        while ((digit = dxf_handle_hex_values[*iter]) != 0)
+        {
+                if (value > (UINT_MAX >> 4))
+                {
+                        return (EXIT_FAILURE);
+                }
+                value = (value << 4) | (digit - 1);
+                number_of_digits++;
+                iter++;
+        }
+        while ((*iter == ' ') || (*iter == '\t')
+          || (*iter == '\r') || (*iter == '\n'))
+        {
+                iter++;
+        }
+        if ((number_of_digits == 0) || (*iter != '\0'))
+        {
+                return (EXIT_FAILURE);
+        }
+        *handle = (int) value;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Allocate memory for a \c DxfHandleAllocator.
+ *
+ * Fill the memory contents with zeros.
+ */
+DxfHandleAllocator *
+dxf_handle_allocator_new ()
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfHandleAllocator *allocator = NULL;
+        size_t size;
+
+        size = sizeof (DxfHandleAllocator);
+        /* avoid malloc of 0 bytes */
+        if (size == 0) size = 1;
+        if ((allocator = malloc (size)) == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory for a DxfHandleAllocator struct.\n")),
+                  __FUNCTION__);
+                allocator = NULL;
+        }
+        else
+        {
+                memset (allocator, 0, size);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (allocator);
+}
+
+
+/*!
+ * \brief Allocate memory and initialize data fields in a
+ * \c DxfHandleAllocator.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfHandleAllocator *
+dxf_handle_allocator_init
+(
+        DxfHandleAllocator *allocator
+                /*!< a pointer to the handle allocator. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (allocator == NULL)
+        {
+                fprintf (stderr,
+                  (_("Warning in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                allocator = dxf_handle_allocator_new ();
+        }
+        if (allocator == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory for a DxfHandleAllocator struct.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        allocator->last = 0;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (allocator);
+}
+
+
+/*!
+ * \brief Free the allocated memory for a \c DxfHandleAllocator.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_handle_allocator_free
+(
+        DxfHandleAllocator *allocator
+                /*!< a pointer to the handle allocator. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (allocator == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        free (allocator);
+        allocator = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Hand out the next free handle.
+ *
+ * \return the handle, or 0 when an error occurred.
+ */
+int
+dxf_handle_allocator_next
+(
+        DxfHandleAllocator *allocator
+                /*!< a pointer to the handle allocator. */
+)
+{
+        /* Do some basic checks. */
+        if (allocator == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (0);
+        }
+        return (__atomic_add_fetch (&allocator->last, 1, __ATOMIC_RELAXED));
+}
+
+
+/*!
+ * \brief Reserve a block of consecutive handles for one writer.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_handle_allocator_reserve
+(
+        DxfHandleAllocator *allocator,
+                /*!< a pointer to the handle allocator. */
+        int number_of_handles,
+                /*!< number of handles to reserve. */
+        DxfHandleBlock *block
+                /*!< a pointer to the block receiving the handles. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        int first;
+
+        /* Do some basic checks. */
+        if ((allocator == NULL) || (block == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (number_of_handles <= 0)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () an invalid number of handles was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        first = __atomic_fetch_add (&allocator->last, number_of_handles, __ATOMIC_RELAXED) + 1;
+        block->next = first;
+        block->end = first + number_of_handles;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Tell the allocator that a handle is in use.
+ *
+ * Handles which were not handed out by the allocator, for example
+ * handles read from a file, move the handle seed past them.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_handle_allocator_use
+(
+        DxfHandleAllocator *allocator,
+                /*!< a pointer to the handle allocator. */
+        int handle
+                /*!< the handle in use. */
+)
+{
+        int last;
+
+        /* Do some basic checks. */
+        if (allocator == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        last = __atomic_load_n (&allocator->last, __ATOMIC_RELAXED);
+        while ((handle > last)
+          && (!__atomic_compare_exchange_n (&allocator->last, &last, handle,
+          FALSE, __ATOMIC_RELAXED, __ATOMIC_RELAXED)))
+        {
+                /* last was reloaded, try again. */
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Get the handle seed, the handle following every handle handed
+ * out so far.
+ *
+ * \return the handle seed, or 0 when an error occurred.
+ */
+int
+dxf_handle_allocator_get_seed
+(
+        DxfHandleAllocator *allocator
+                /*!< a pointer to the handle allocator. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (allocator == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (0);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (__atomic_load_n (&allocator->last, __ATOMIC_RELAXED) + 1);
+}
+
+
+/*!
+ * \brief Set the handle seed, the next handle to hand out.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_handle_allocator_set_seed
+(
+        DxfHandleAllocator *allocator,
+                /*!< a pointer to the handle allocator. */
+        int seed
+                /*!< the handle seed. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (allocator == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (seed < 1)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () an invalid handle seed was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        __atomic_store_n (&allocator->last, seed - 1, __ATOMIC_RELAXED);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Get the handle seed as a hexadecimal string, as written for
+ * the \c $HANDSEED header variable.
+ *
+ * \return the length of the string, or 0 when an error occurred.
+ */
+int
+dxf_handle_allocator_get_seed_hex
+(
+        DxfHandleAllocator *allocator,
+                /*!< a pointer to the handle allocator. */
+        char *buffer
+                /*!< a buffer of at least \c DXF_HANDLE_HEX_SIZE
+                 * characters. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if ((allocator == NULL) || (buffer == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (0);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (dxf_handle_to_hex (dxf_handle_allocator_get_seed (allocator), buffer));
+}
+
+
+/*!
+ * \brief Set the handle seed from a hexadecimal string, as read from
+ * the \c $HANDSEED header variable.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_handle_allocator_set_seed_hex
+(
+        DxfHandleAllocator *allocator,
+                /*!< a pointer to the handle allocator. */
+        const char *seed
+                /*!< the handle seed. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        int value;
+
+        /* Do some basic checks. */
+        if ((allocator == NULL) || (seed == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (dxf_handle_from_hex (seed, &value) != EXIT_SUCCESS)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () invalid handle seed: %s.\n")),
+                  __FUNCTION__, seed);
+                return (EXIT_FAILURE);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (dxf_handle_allocator_set_seed (allocator, value));
+}
+
+
+/*!
+ * \brief Take the next handle from a reserved block.
+ *
+ * \return the handle, or 0 when the block is used up.
+ */
+int
+dxf_handle_block_next
+(
+        DxfHandleBlock *block
+                /*!< a pointer to the block of handles. */
+)
+{
+        /* Do some basic checks. */
+        if (block == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (0);
+        }
+        if (block->next >= block->end)
+        {
+                return (0);
+        }
+        return (block->next++);
+}
+
+
+/*!
+ * \brief Allocate memory for a \c DxfHandleMap.
+ *
+ * Fill the memory contents with zeros.
+ */
+DxfHandleMap *
+dxf_handle_map_new ()
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfHandleMap *map = NULL;
+        size_t size;
+
+        size = sizeof (DxfHandleMap);
+        /* avoid malloc of 0 bytes */
+        if (size == 0) size = 1;
+        if ((map = malloc (size)) == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory for a DxfHandleMap struct.\n")),
+                  __FUNCTION__);
+                map = NULL;
+        }
+        else
+        {
+                memset (map, 0, size);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (map);
+}
+
+
+/*!
+ * \brief Allocate memory and initialize data fields in a
+ * \c DxfHandleMap.
+ *
+ * The table members are assigned, not released, so a map on the stack
+ * need not be zeroed first.  The table of a map that is in use has to be
+ * released before the map is initialized again.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfHandleMap *
+dxf_handle_map_init
+(
+        DxfHandleMap *map
+                /*!< a pointer to the handle map. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (map == NULL)
+        {
+                fprintf (stderr,
+                  (_("Warning in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                map = dxf_handle_map_new ();
+        }
+        if (map == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory for a DxfHandleMap struct.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        map->old_handles = calloc (DXF_HANDLE_MAP_INITIAL_SIZE, sizeof (int));
+        map->new_handles = calloc (DXF_HANDLE_MAP_INITIAL_SIZE, sizeof (int));
+        map->number_of_entries = 0;
+        map->size = DXF_HANDLE_MAP_INITIAL_SIZE;
+        if ((map->old_handles == NULL) || (map->new_handles == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory for the handle table.\n")),
+                  __FUNCTION__);
+                free (map->old_handles);
+                free (map->new_handles);
+                map->old_handles = NULL;
+                map->new_handles = NULL;
+                map->size = 0;
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (map);
+}
+
+
+/*!
+ * \brief Free the allocated memory for a \c DxfHandleMap and its
+ * table.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_handle_map_free
+(
+        DxfHandleMap *map
+                /*!< a pointer to the handle map. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (map == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        free (map->old_handles);
+        free (map->new_handles);
+        free (map);
+        map = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Map an old handle to a new handle.
+ *
+ * An old handle which is already in the map gets the new handle.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_handle_map_insert
+(
+        DxfHandleMap *map,
+                /*!< a pointer to the handle map. */
+        int old_handle,
+                /*!< the old handle. */
+        int new_handle
+                /*!< the new handle. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        int slot;
+
+        /* Do some basic checks. */
+        if (map == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (old_handle <= 0)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () an invalid handle was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        /* Keep the table at most half full. */
+        if ((2 * (map->number_of_entries + 1) > map->size)
+          && (dxf_handle_map_grow (map) != EXIT_SUCCESS))
+        {
+                return (EXIT_FAILURE);
+        }
+        slot = dxf_handle_map_find (map, old_handle);
+        if (map->old_handles[slot] == 0)
+        {
+                map->old_handles[slot] = old_handle;
+                map->number_of_entries++;
+        }
+        map->new_handles[slot] = new_handle;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Look up the new handle of an old handle.
+ *
+ * \return the new handle, or 0 when the old handle is not in the map.
+ */
+int
+dxf_handle_map_lookup
+(
+        DxfHandleMap *map,
+                /*!< a pointer to the handle map. */
+        int old_handle
+                /*!< the old handle. */
+)
+{
+        int slot;
+
+        /* Do some basic checks. */
+        if (map == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (0);
+        }
+        if ((old_handle <= 0) || (map->size == 0))
+        {
+                return (0);
+        }
+        slot = dxf_handle_map_find (map, old_handle);
+        return (map->new_handles[slot]);
+}
+
+
+/*!
+ * \brief Give an object a new handle and record the old handle in a
+ * map.
+ *
+ * This is the first pass of renumbering a drawing which is merged into
+ * another drawing: every object of the merged drawing is renumbered
+ * with the allocator of the receiving drawing, before any reference is
+ * remapped with dxf_handle_remap () or dxf_handle_remap_hex () in the
+ * second pass.\n
+ * An object without a handle (0 or less) gets a new handle, but is not
+ * recorded in the map.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_handle_renumber
+(
+        DxfHandleAllocator *allocator,
+                /*!< a pointer to the handle allocator of the receiving
+                 * drawing. */
+        DxfHandleMap *map,
+                /*!< a pointer to the handle map. */
+        int *handle
+                /*!< a pointer to the handle of the object. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        int new_handle;
+
+        /* Do some basic checks. */
+        if ((allocator == NULL) || (map == NULL) || (handle == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        new_handle = dxf_handle_allocator_next (allocator);
+        if ((*handle > 0)
+          && (dxf_handle_map_insert (map, *handle, new_handle) != EXIT_SUCCESS))
+        {
+                return (EXIT_FAILURE);
+        }
+        *handle = new_handle;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Replace a reference to a renumbered object.
+ *
+ * References to objects which are not in the map, for example objects
+ * shared with the receiving drawing, are left alone.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_handle_remap
+(
+        DxfHandleMap *map,
+                /*!< a pointer to the handle map. */
+        int *handle
+                /*!< a pointer to the reference. */
+)
+{
+        int new_handle;
+
+        /* Do some basic checks. */
+        if ((map == NULL) || (handle == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        new_handle = dxf_handle_map_lookup (map, *handle);
+        if (new_handle != 0)
+        {
+                *handle = new_handle;
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Replace a hexadecimal reference (group codes 330 to 369) to a
+ * renumbered object.
+ *
+ * The old string is released with dxf_string_free () and replaced by a
+ * newly allocated string.\n
+ * \c NULL references and references to objects which are not in the
+ * map are left alone.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when the
+ * reference is not a handle or an error occurred.
+ */
+int
+dxf_handle_remap_hex
+(
+        DxfHandleMap *map,
+                /*!< a pointer to the handle map. */
+        char **reference
+                /*!< a pointer to the reference string. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        char buffer[DXF_HANDLE_HEX_SIZE];
+        char *copy = NULL;
+        int old_handle;
+        int new_handle;
+
+        /* Do some basic checks. */
+        if ((map == NULL) || (reference == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (*reference == NULL)
+        {
+                return (EXIT_SUCCESS);
+        }
+        if (dxf_handle_from_hex (*reference, &old_handle) != EXIT_SUCCESS)
+        {
+                return (EXIT_FAILURE);
+        }
+        new_handle = dxf_handle_map_lookup (map, old_handle);
+        if (new_handle == 0)
+        {
+                return (EXIT_SUCCESS);
+        }
+        dxf_handle_to_hex (new_handle, buffer);
+        copy = strdup (buffer);
+        if (copy == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_string_free (*reference);
+        *reference = copy;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Double the size of the table of a handle map.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when no memory
+ * could be allocated.
+ */
+static int
+dxf_handle_map_grow
+(
+        DxfHandleMap *map
+                /*!< a pointer to the handle map. */
+)
+{
+        int *old_handles = NULL;
+        int *new_handles = NULL;
+        int size;
+        int slot;
+        int i;
+
+        old_handles = map->old_handles;
+        new_handles = map->new_handles;
+        size = map->size;
+        map->size = (size == 0) ? DXF_HANDLE_MAP_INITIAL_SIZE : 2 * size;
+        map->old_handles = calloc (map->size, sizeof (int));
+        map->new_handles = calloc (map->size, sizeof (int));
+        if ((map->old_handles == NULL) || (map->new_handles == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory for the handle table.\n")),
+                  __FUNCTION__);
+                free (map->old_handles);
+                free (map->new_handles);
+                map->old_handles = old_handles;
+                map->new_handles = new_handles;
+                map->size = size;
+                return (EXIT_FAILURE);
+        }
+        for (i = 0; i < size; i++)
+        {
+                if (old_handles[i] != 0)
+                {
+                        slot = dxf_handle_map_find (map, old_handles[i]);
+                        map->old_handles[slot] = old_handles[i];
+                        map->new_handles[slot] = new_handles[i];
+                }
+        }
+        free (old_handles);
+        free (new_handles);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Find the slot of an old handle, or the empty slot where it
+ * belongs.
+ *
+ * \return the slot.
+ */
+static int
+dxf_handle_map_find
+(
+        DxfHandleMap *map,
+                /*!< a pointer to the handle map. */
+        int old_handle
+                /*!< the old handle. */
+)
+{
+        unsigned int mask;
+        unsigned int slot;
+
+        mask = (unsigned int) map->size - 1;
+        /* Fibonacci hashing spreads the consecutive handles of a
+         * drawing over the table. */
+        slot = ((unsigned int) old_handle * 2654435761U) & mask;
+        while ((map->old_handles[slot] != 0)
+          && (map->old_handles[slot] != old_handle))
+        {
+                slot = (slot + 1) & mask;
+        }
+        return ((int) slot);
+}
+
+
+/* EOF */
@@ -0,0 +1,141 @@
+/*!
+ * \file handle.h
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Header file for allocating, renumbering and encoding DXF
+ * handles.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#ifndef LIBDXF_SRC_HANDLE_H
+#define LIBDXF_SRC_HANDLE_H
+
+
+#include "global.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define DXF_HANDLE_HEX_SIZE 17
+        /*!< \brief Size of a buffer receiving a hexadecimal handle,
+         * including the terminating \c NUL character. */
+
+#define DXF_HANDLE_MAP_INITIAL_SIZE 1024
+        /*!< \brief Initial number of slots of a \c DxfHandleMap, must
+         * be a power of two. */
+
+
+/*!
+ * \brief Definition of a handle allocator.
+ *
+ * Handles are handed out in increasing order, starting at 1 for a
+ * zero filled allocator.\n
+ * The allocator is updated with atomic operations, so a single
+ * allocator can be shared by several threads without a lock.
+ */
+typedef struct
+dxf_handle_allocator_struct
+{
+        int last;
+                /*!< Last handle handed out (or used), the handle seed
+                 * is \c last + 1. */
+} DxfHandleAllocator;
+
+
+/*!
+ * \brief Definition of a block of handles reserved for one writer.
+ *
+ * A block is owned by a single thread and is used without atomic
+ * operations, handles left in a block when the writer is done are not
+ * handed out again.
+ */
+typedef struct
+dxf_handle_block_struct
+{
+        int next;
+                /*!< Next handle in the block. */
+        int end;
+                /*!< First handle past the block. */
+} DxfHandleBlock;
+
+
+/*!
+ * \brief Definition of a map of old handles to new handles, as built
+ * while renumbering a drawing.
+ */
+typedef struct
+dxf_handle_map_struct
+{
+        int *old_handles;
+                /*!< Open addressing table of old handles, 0 marks an
+                 * empty slot. */
+        int *new_handles;
+                /*!< New handles, at the slots of the old handles. */
+        int number_of_entries;
+                /*!< Number of entries in the map. */
+        int size;
+                /*!< Number of slots in the table (a power of two). */
+} DxfHandleMap;
+
+
+int dxf_handle_to_hex (int handle, char *buffer);
+int dxf_handle_from_hex (const char *string, int *handle);
+DxfHandleAllocator *dxf_handle_allocator_new ();
+DxfHandleAllocator *dxf_handle_allocator_init (DxfHandleAllocator *allocator);
+int dxf_handle_allocator_free (DxfHandleAllocator *allocator);
+int dxf_handle_allocator_next (DxfHandleAllocator *allocator);
+int dxf_handle_allocator_reserve (DxfHandleAllocator *allocator, int number_of_handles, DxfHandleBlock *block);
+int dxf_handle_allocator_use (DxfHandleAllocator *allocator, int handle);
+int dxf_handle_allocator_get_seed (DxfHandleAllocator *allocator);
+int dxf_handle_allocator_set_seed (DxfHandleAllocator *allocator, int seed);
+int dxf_handle_allocator_get_seed_hex (DxfHandleAllocator *allocator, char *buffer);
+int dxf_handle_allocator_set_seed_hex (DxfHandleAllocator *allocator, const char *seed);
+int dxf_handle_block_next (DxfHandleBlock *block);
+DxfHandleMap *dxf_handle_map_new ();
+DxfHandleMap *dxf_handle_map_init (DxfHandleMap *map);
+int dxf_handle_map_free (DxfHandleMap *map);
+int dxf_handle_map_insert (DxfHandleMap *map, int old_handle, int new_handle);
+int dxf_handle_map_lookup (DxfHandleMap *map, int old_handle);
+int dxf_handle_renumber (DxfHandleAllocator *allocator, DxfHandleMap *map, int *handle);
+int dxf_handle_remap (DxfHandleMap *map, int *handle);
+int dxf_handle_remap_hex (DxfHandleMap *map, char **reference);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* LIBDXF_SRC_HANDLE_H */
+
+
+/* EOF */
@@ -40,6 +40,9 @@
 
 
 #include "hatch.h"
+#include "flatten.h"
+#include "stats.h"
+#include "util.h"
 
 
 /* dxf_hatch functions. */
@@ -71,6 +74,7 @@ dxf_hatch_new ()
         else
         {
                 memset (hatch, 0, size);
+                dxf_stats_count_allocation (HATCH, size);
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -112,8 +116,8 @@ dxf_hatch_init
                 return (NULL);
         }
         hatch->id_code = 0;
-        hatch->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        hatch->layer = strdup (DXF_DEFAULT_LAYER);
+        hatch->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        hatch->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         hatch->elevation = 0.0;
         hatch->thickness = 0.0;
         hatch->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
@@ -122,20 +126,18 @@ dxf_hatch_init
         hatch->paperspace = DXF_MODELSPACE;
         hatch->graphics_data_size = 0;
         hatch->shadow_mode = 0;
-        hatch->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_new ();
-        hatch->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_init (hatch->binary_graphics_data);
-        hatch->dictionary_owner_soft = strdup ("");
-        hatch->object_owner_soft = strdup ("");
-        hatch->material = strdup ("");
-        hatch->dictionary_owner_hard = strdup ("");
+        hatch->binary_graphics_data = NULL;
+        hatch->dictionary_owner_soft = dxf_string_share ("");
+        hatch->object_owner_soft = dxf_string_share ("");
+        hatch->material = dxf_string_share ("");
+        hatch->dictionary_owner_hard = dxf_string_share ("");
         hatch->lineweight = 0;
-        hatch->plot_style_name = strdup ("");
+        hatch->plot_style_name = dxf_string_share ("");
         hatch->color_value = 0;
-        hatch->color_name = strdup ("");
+        hatch->color_name = dxf_string_share ("");
         hatch->transparency = 0;
-        hatch->pattern_name = strdup ("");
+        hatch->pattern_name = dxf_string_share ("");
         hatch->p0 = dxf_point_new ();
-        hatch->p0 = dxf_point_init (hatch->p0);
         hatch->p0->x0 = 0.0;
         hatch->p0->y0 = 0.0;
         hatch->p0->z0 = 0.0;
@@ -229,7 +231,8 @@ dxf_hatch_write
                 fprintf (stderr,
                   (_("    %s entity is relocated to layer 0")),
                         dxf_entity_name);
-                hatch->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (hatch->layer);
+                hatch->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         if (strcmp (hatch->linetype, "") == 0)
         {
@@ -239,7 +242,8 @@ dxf_hatch_write
                 fprintf (stderr,
                   (_("    %s entity is reset to default linetype")),
                         dxf_entity_name);
-                hatch->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (hatch->linetype);
+                hatch->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         /* Start writing output. */
         fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
@@ -428,15 +432,18 @@ dxf_hatch_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (hatch->linetype);
-        free (hatch->layer);
-        dxf_binary_graphics_data_free_list ((DxfBinaryGraphicsData *) hatch->binary_graphics_data);
-        free (hatch->dictionary_owner_soft);
-        free (hatch->material);
-        free (hatch->dictionary_owner_hard);
-        free (hatch->plot_style_name);
-        free (hatch->color_name);
-        free (hatch->pattern_name);
+        dxf_string_free (hatch->linetype);
+        dxf_string_free (hatch->layer);
+        if (hatch->binary_graphics_data != NULL)
+        {
+                dxf_binary_graphics_data_free_list (hatch->binary_graphics_data);
+        }
+        dxf_string_free (hatch->dictionary_owner_soft);
+        dxf_string_free (hatch->material);
+        dxf_string_free (hatch->dictionary_owner_hard);
+        dxf_string_free (hatch->plot_style_name);
+        dxf_string_free (hatch->color_name);
+        dxf_string_free (hatch->pattern_name);
         dxf_point_free ((DxfPoint *) hatch->p0);
         dxf_hatch_boundary_path_free_list ((DxfHatchBoundaryPath *) hatch->paths);
         dxf_hatch_pattern_free_list ((DxfHatchPattern *) hatch->patterns);
@@ -620,6 +627,8 @@ dxf_hatch_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (hatch == NULL)
         {
@@ -635,7 +644,13 @@ dxf_hatch_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        hatch->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (hatch->linetype);
+        hatch->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -698,6 +713,8 @@ dxf_hatch_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (hatch == NULL)
         {
@@ -713,7 +730,13 @@ dxf_hatch_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        hatch->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (hatch->layer);
+        hatch->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1433,6 +1456,8 @@ dxf_hatch_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (hatch == NULL)
         {
@@ -1448,7 +1473,13 @@ dxf_hatch_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        hatch->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (hatch->dictionary_owner_soft);
+        hatch->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1513,6 +1544,8 @@ dxf_hatch_set_object_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (hatch == NULL)
         {
@@ -1528,7 +1561,13 @@ dxf_hatch_set_object_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        hatch->object_owner_soft = strdup (object_owner_soft);
+        copy = dxf_string_share (object_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (hatch->object_owner_soft);
+        hatch->object_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1595,6 +1634,8 @@ dxf_hatch_set_material
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (hatch == NULL)
         {
@@ -1610,7 +1651,13 @@ dxf_hatch_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        hatch->material = strdup (material);
+        copy = dxf_string_share (material);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (hatch->material);
+        hatch->material = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1678,6 +1725,8 @@ dxf_hatch_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (hatch == NULL)
         {
@@ -1693,7 +1742,13 @@ dxf_hatch_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        hatch->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (hatch->dictionary_owner_hard);
+        hatch->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1823,6 +1878,8 @@ dxf_hatch_set_plot_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (hatch == NULL)
         {
@@ -1838,7 +1895,13 @@ dxf_hatch_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        hatch->plot_style_name = strdup (plot_style_name);
+        copy = dxf_string_share (plot_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (hatch->plot_style_name);
+        hatch->plot_style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1968,6 +2031,8 @@ dxf_hatch_set_color_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (hatch == NULL)
         {
@@ -1983,7 +2048,13 @@ dxf_hatch_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        hatch->color_name = strdup (color_name);
+        copy = dxf_string_share (color_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (hatch->color_name);
+        hatch->color_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2111,6 +2182,8 @@ dxf_hatch_set_pattern_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (hatch == NULL)
         {
@@ -2126,7 +2199,13 @@ dxf_hatch_set_pattern_name
                   __FUNCTION__);
                 return (NULL);
         }
-        hatch->pattern_name = strdup (pattern_name);
+        copy = dxf_string_share (pattern_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (hatch->pattern_name);
+        hatch->pattern_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -7323,14 +7402,16 @@ dxf_hatch_boundary_path_polyline_close_polyline
  * \author Paul Bourke <http://www.paulbourke.net/geometry/insidepoly/>\n
  * Adapted for libDXF by Bert Timmerman <bert.timmerman@xs4all.nl>
  *
- * A solution by Philippe Reverdy is to compute the sum of the angles
- * made between the test point and each pair of points making up the
- * polygon.\n
- * If this sum is (\f$ 2\pi \f$) then the point is an interior point,
- * if 0 then the point is an exterior point.\n
- * This also works for polygons with holes given the polygon is defined
- * with a path made up of coincident edges into and out of the hole as
- * is common practice in many CAD packages.\n
+ * The polyline is flattened (bulged segments are approximated with
+ * \c DXF_FLATTEN_DEFAULT_TOLERANCE) and the number of edges crossed by
+ * a horizontal ray from the test point to the right is counted.\n
+ * If this crossing number is odd then the point is an interior point,
+ * if even then the point is an exterior point.\n
+ * Edges are treated as half open in the Y-direction, so that a ray
+ * through a vertex is counted only once.\n
+ *
+ * \note For testing many points, or boundaries with multiple loops
+ * and islands, use a \c DxfBoundaryIndex.
  *
  * \note For most of the "point-in-polygon" algorithms there is a
  * pathological case if the point being queries lies exactly on a
@@ -7339,9 +7420,6 @@ dxf_hatch_boundary_path_polyline_close_polyline
  * process and make your own decision as to whether you want to consider
  * them inside or outside.
  *
- * \note It is assumed that the polygon is simple (does not intersect
- * itself).
- *
  * \return \c INSIDE if an interior point, \c OUTSIDE if an exterior
  * point, or \c EXIT_FAILURE if an error occurred.
  */
@@ -7357,6 +7435,12 @@ dxf_hatch_boundary_path_polyline_point_inside_polyline
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        DxfFlattenBuffer buffer;
+        double vertices[2 * 64];
+        int crossings;
+        int i;
+        int j;
+
         /* Do some basic checks. */
         if (polyline == NULL)
         {
@@ -7379,45 +7463,50 @@ dxf_hatch_boundary_path_polyline_point_inside_polyline
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        DxfHatchBoundaryPathPolylineVertex *p0;
-        DxfHatchBoundaryPathPolylineVertex *p1;
-        DxfHatchBoundaryPathPolylineVertex *iter;
-        DxfHatchBoundaryPathPolylineVertex *next;
-        double angle;
-        p0 = dxf_hatch_boundary_path_polyline_vertex_new ();
-        p1 = dxf_hatch_boundary_path_polyline_vertex_new ();
-        iter = dxf_hatch_boundary_path_polyline_vertex_new ();
-        next = dxf_hatch_boundary_path_polyline_vertex_new ();
-        iter = (DxfHatchBoundaryPathPolylineVertex *) polyline->vertices;
-        next = (DxfHatchBoundaryPathPolylineVertex *) iter->next;
-        angle = 0;
-        for (;;)
+        /* Small polylines fit in storage on the stack. */
+        memset (&buffer, 0, sizeof (DxfFlattenBuffer));
+        buffer.x = vertices;
+        buffer.y = vertices + 64;
+        buffer.max_number_of_vertices = 64;
+        if (dxf_flatten_hatch_boundary_path_polyline (polyline, DXF_FLATTEN_DEFAULT_TOLERANCE, &buffer) != EXIT_SUCCESS)
         {
-                if (next == NULL)
+                if (!dxf_flatten_buffer_is_overflowed (&buffer))
                 {
-                        /* iter is the last vertex, no use to continue. */
-                        break;
+                        return (EXIT_FAILURE);
+                }
+                i = buffer.number_of_vertices;
+                buffer.x = NULL;
+                buffer.y = NULL;
+                buffer.max_number_of_vertices = 0;
+                if (dxf_flatten_buffer_reserve (&buffer, i, 0) != EXIT_SUCCESS)
+                {
+                        return (EXIT_FAILURE);
                 }
-                next = (DxfHatchBoundaryPathPolylineVertex *) iter->next;
-                p0->x0 = iter->x0 - point->x0;
-                p0->y0 = iter->y0 - point->y0;
-                p1->x0 = next->x0 - point->x0;
-                p1->y0 = next->y0 - point->y0;
-                angle += dxf_hatch_boundary_path_polyline_vertex_angle (iter, next);
-                iter = next;
+                dxf_flatten_buffer_reset (&buffer);
+                dxf_flatten_hatch_boundary_path_polyline (polyline, DXF_FLATTEN_DEFAULT_TOLERANCE, &buffer);
+        }
+        crossings = 0;
+        for (i = 0, j = buffer.number_of_vertices - 1; i < buffer.number_of_vertices; j = i++)
+        {
+                if (((buffer.y[i] <= point->y0) && (point->y0 < buffer.y[j]))
+                  || ((buffer.y[j] <= point->y0) && (point->y0 < buffer.y[i])))
+                {
+                        if (point->x0 < buffer.x[i] + ((point->y0 - buffer.y[i])
+                          * (buffer.x[j] - buffer.x[i]) / (buffer.y[j] - buffer.y[i])))
+                        {
+                                crossings++;
+                        }
+                }
+        }
+        if (buffer.x != vertices)
+        {
+                free (buffer.x);
+                free (buffer.y);
         }
-        /* clean up. */
-        dxf_hatch_boundary_path_polyline_vertex_free (p0);
-        dxf_hatch_boundary_path_polyline_vertex_free (p1);
-        if (abs (angle) < M_PI)
-                return (OUTSIDE);
-        else
-                return (INSIDE);
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        /*! \todo This is a dead code path. */
-        return (EXIT_FAILURE);
+        return ((crossings & 1) ? INSIDE : OUTSIDE);
 }
 
 
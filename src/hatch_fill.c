@@ -0,0 +1,1315 @@
+/*!
+ * \file hatch_fill.c
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * Functions for generating the pattern fill of DXF hatches
+ * (\c HATCH).
+ *
+ * Every pattern definition line describes a family of parallel lines,
+ * the boundary is flattened once and its edges are transformed into
+ * the frame of each family, with the family lines running horizontally.\n
+ * The transformed edges are sorted on their lowest coordinate, the lines
+ * of a family are visited from bottom to top while maintaining a list of
+ * active edges (a sorted edge table scanline), the crossings of a line
+ * with the active edges are sorted along the line and give the intervals
+ * inside the boundary, following the island detection style of the
+ * hatch.\n
+ * The dash pattern of the family is applied to every inside interval and
+ * the resulting segments are written to a contiguous buffer.\n
+ * The lines of all families are divided over a number of threads, and a
+ * list of hatches can be divided over a number of threads as well.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include <pthread.h>
+
+#include "hatch_fill.h"
+
+
+/*!
+ * \brief A boundary edge transformed into the frame of a pattern line
+ * family.
+ */
+typedef struct
+dxf_hatch_fill_edge_struct
+{
+        double v_low;
+                /*!< Lowest V-coordinate of the edge. */
+        double v_high;
+                /*!< Highest V-coordinate of the edge. */
+        double u_low;
+                /*!< U-coordinate at the lowest end of the edge. */
+        double dudv;
+                /*!< Inverse slope (du / dv) of the edge. */
+        int loop;
+                /*!< Loop number of the edge. */
+} DxfHatchFillEdge;
+
+
+/*!
+ * \brief A crossing of a pattern line with a boundary edge.
+ */
+typedef struct
+dxf_hatch_fill_crossing_struct
+{
+        double u;
+                /*!< U-coordinate of the crossing. */
+        int loop;
+                /*!< Loop number of the crossed edge. */
+} DxfHatchFillCrossing;
+
+
+/*!
+ * \brief A family of parallel pattern lines with the boundary edges in
+ * its frame.
+ *
+ * The U-axis runs along the lines, the V-axis perpendicular to them.
+ */
+typedef struct
+dxf_hatch_fill_family_struct
+{
+        double cos_angle;
+                /*!< Cosine of the line angle. */
+        double sin_angle;
+                /*!< Sine of the line angle. */
+        double base_u;
+                /*!< U-coordinate of the base point. */
+        double base_v;
+                /*!< V-coordinate of the base point. */
+        double spacing;
+                /*!< Distance between successive lines. */
+        double shift;
+                /*!< Shift of the dash pattern between successive
+                 * lines. */
+        int first_line;
+                /*!< Number of the lowest line crossing the boundary. */
+        int number_of_lines;
+                /*!< Number of lines crossing the boundary. */
+        int number_of_dashes;
+                /*!< Number of dash items. */
+        double dashes[DXF_MAX_HATCH_PATTERN_DEF_LINE_DASH_ITEMS];
+                /*!< Dash items, a positive length is a dash, a
+                 * negative length a gap and zero a dot. */
+        double pattern_length;
+                /*!< Length of a single dash pattern repetition. */
+        int number_of_edges;
+                /*!< Number of edges. */
+        DxfHatchFillEdge *edges;
+                /*!< Edges, sorted on \c v_low. */
+} DxfHatchFillFamily;
+
+
+/*!
+ * \brief Work item for a thread filling a range of lines of a family.
+ */
+typedef struct
+dxf_hatch_fill_job_struct
+{
+        DxfHatchFillFamily *family;
+                /*!< The family. */
+        int style;
+                /*!< Island detection style. */
+        int number_of_loops;
+                /*!< Number of boundary loops. */
+        int begin;
+                /*!< First line of this job, relative to the first line
+                 * of the family. */
+        int end;
+                /*!< One past the last line of this job. */
+        DxfHatchFillBuffer buffer;
+                /*!< Segments of this job. */
+        int status;
+                /*!< \c EXIT_SUCCESS or \c EXIT_FAILURE. */
+} DxfHatchFillJob;
+
+
+/*!
+ * \brief Work item for a thread filling a range of hatches.
+ */
+typedef struct
+dxf_hatch_fill_list_job_struct
+{
+        DxfHatch **hatches;
+                /*!< Array of all hatches. */
+        double tolerance;
+                /*!< Flattening tolerance. */
+        DxfHatchFillBuffer *buffers;
+                /*!< Array of buffers, one per hatch. */
+        int begin;
+                /*!< First hatch of this job. */
+        int end;
+                /*!< One past the last hatch of this job. */
+        int status;
+                /*!< \c EXIT_SUCCESS or \c EXIT_FAILURE. */
+} DxfHatchFillListJob;
+
+
+static int dxf_hatch_fill_build_family (DxfHatchFillFamily *family, DxfHatchPatternDefLine *def_line, DxfFlattenBuffer *boundary);
+static int dxf_hatch_fill_compare_edges (const void *a, const void *b);
+static int dxf_hatch_fill_compare_crossings (const void *a, const void *b);
+static void *dxf_hatch_fill_run_job (void *data);
+static void *dxf_hatch_fill_run_list_job (void *data);
+static int dxf_hatch_fill_add_interval (DxfHatchFillBuffer *buffer, DxfHatchFillFamily *family, double v, double origin, double ua, double ub);
+static int dxf_hatch_fill_add_segment (DxfHatchFillBuffer *buffer, DxfHatchFillFamily *family, double v, double ua, double ub);
+
+
+/*!
+ * \brief Allocate memory for a \c DxfHatchFillBuffer.
+ *
+ * Fill the memory contents with zeros.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfHatchFillBuffer *
+dxf_hatch_fill_buffer_new ()
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfHatchFillBuffer *buffer = NULL;
+        size_t size;
+
+        size = sizeof (DxfHatchFillBuffer);
+        /* avoid malloc of 0 bytes */
+        if (size == 0) size = 1;
+        if ((buffer = malloc (size)) == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                buffer = NULL;
+        }
+        else
+        {
+                memset (buffer, 0, size);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (buffer);
+}
+
+
+/*!
+ * \brief Allocate memory and initialize data fields in a
+ * \c DxfHatchFillBuffer.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfHatchFillBuffer *
+dxf_hatch_fill_buffer_init
+(
+        DxfHatchFillBuffer *buffer,
+                /*!< a pointer to the segment buffer. */
+        int max_number_of_segments
+                /*!< initial number of segments that fit in the
+                 * arrays. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (buffer == NULL)
+        {
+                fprintf (stderr,
+                  (_("Warning in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                buffer = dxf_hatch_fill_buffer_new ();
+        }
+        if (buffer == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        buffer->x0 = NULL;
+        buffer->y0 = NULL;
+        buffer->x1 = NULL;
+        buffer->y1 = NULL;
+        buffer->number_of_segments = 0;
+        buffer->max_number_of_segments = 0;
+        if ((max_number_of_segments > 0)
+          && (dxf_hatch_fill_buffer_reserve (buffer, max_number_of_segments) != EXIT_SUCCESS))
+        {
+                dxf_hatch_fill_buffer_free (buffer);
+                return (NULL);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (buffer);
+}
+
+
+/*!
+ * \brief Make room for at least \c max_number_of_segments segments in
+ * a \c DxfHatchFillBuffer.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_hatch_fill_buffer_reserve
+(
+        DxfHatchFillBuffer *buffer,
+                /*!< a pointer to the segment buffer. */
+        int max_number_of_segments
+                /*!< number of segments that should fit. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        double *x0 = NULL;
+        double *y0 = NULL;
+        double *x1 = NULL;
+        double *y1 = NULL;
+
+        /* Do some basic checks. */
+        if (buffer == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (max_number_of_segments <= buffer->max_number_of_segments)
+        {
+                return (EXIT_SUCCESS);
+        }
+        x0 = realloc (buffer->x0, max_number_of_segments * sizeof (double));
+        if (x0 != NULL)
+        {
+                buffer->x0 = x0;
+        }
+        y0 = realloc (buffer->y0, max_number_of_segments * sizeof (double));
+        if (y0 != NULL)
+        {
+                buffer->y0 = y0;
+        }
+        x1 = realloc (buffer->x1, max_number_of_segments * sizeof (double));
+        if (x1 != NULL)
+        {
+                buffer->x1 = x1;
+        }
+        y1 = realloc (buffer->y1, max_number_of_segments * sizeof (double));
+        if (y1 != NULL)
+        {
+                buffer->y1 = y1;
+        }
+        if ((x0 == NULL) || (y0 == NULL) || (x1 == NULL) || (y1 == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        buffer->max_number_of_segments = max_number_of_segments;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Clear the contents of a \c DxfHatchFillBuffer, the segment
+ * buffer itself is not freed.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_hatch_fill_buffer_clear
+(
+        DxfHatchFillBuffer *buffer
+                /*!< a pointer to the segment buffer. */
+)
+{
+        /* Do some basic checks. */
+        if (buffer == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        free (buffer->x0);
+        free (buffer->y0);
+        free (buffer->x1);
+        free (buffer->y1);
+        dxf_hatch_fill_buffer_init (buffer, 0);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Free the allocated memory for a \c DxfHatchFillBuffer and all
+ * it's data fields.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_hatch_fill_buffer_free
+(
+        DxfHatchFillBuffer *buffer
+                /*!< a pointer to the segment buffer. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (buffer == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_hatch_fill_buffer_clear (buffer);
+        free (buffer);
+        buffer = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Generate the pattern fill of flattened boundary loops.
+ *
+ * Every path in the \c boundary is taken as a closed loop, a closing
+ * edge is added when the last vertex differs from the first vertex.\n
+ * The pattern definition lines are in drawing units, with the pattern
+ * scale and angle of the hatch already applied (as stored in a DXF
+ * file).\n
+ * Any previous segments in \c buffer are discarded, the segments are
+ * written in the order of the pattern definition lines and the lines
+ * within a family, independent of the number of threads.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_hatch_fill_boundary
+(
+        DxfFlattenBuffer *boundary,
+                /*!< a pointer to a buffer with flattened loops. */
+        int style,
+                /*!< island detection style, one of
+                 * \c DXF_BOUNDARY_INDEX_STYLE_NORMAL,
+                 * \c DXF_BOUNDARY_INDEX_STYLE_OUTER or
+                 * \c DXF_BOUNDARY_INDEX_STYLE_IGNORE. */
+        DxfHatchPatternDefLine *def_lines,
+                /*!< a pointer to a single linked list of pattern
+                 * definition lines. */
+        DxfHatchFillBuffer *buffer,
+                /*!< a pointer to the segment buffer receiving the
+                 * result. */
+        int number_of_threads
+                /*!< number of threads to use. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfHatchPatternDefLine *iter = NULL;
+        DxfHatchFillFamily *families = NULL;
+        DxfHatchFillJob *jobs = NULL;
+        pthread_t *threads = NULL;
+        int *started = NULL;
+        int number_of_families;
+        int number_of_loops;
+        int number_of_lines;
+        int number_of_jobs;
+        int number_of_segments;
+        int status;
+        int chunk;
+        int line;
+        int f;
+        int i;
+
+        /* Do some basic checks. */
+        if ((boundary == NULL) || (buffer == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (dxf_flatten_buffer_is_overflowed (boundary))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () an incomplete (overflowed) buffer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if ((style < DXF_BOUNDARY_INDEX_STYLE_NORMAL)
+          || (style > DXF_BOUNDARY_INDEX_STYLE_IGNORE))
+        {
+                fprintf (stderr,
+                  (_("Warning in %s () an unknown style was passed, using the normal style.\n")),
+                  __FUNCTION__);
+                style = DXF_BOUNDARY_INDEX_STYLE_NORMAL;
+        }
+        buffer->number_of_segments = 0;
+        number_of_families = 0;
+        for (iter = def_lines; iter != NULL; iter = (DxfHatchPatternDefLine *) iter->next)
+        {
+                number_of_families++;
+        }
+        if ((number_of_families == 0) || (boundary->number_of_vertices == 0))
+        {
+                return (EXIT_SUCCESS);
+        }
+        number_of_loops = (boundary->path_start != NULL) ? boundary->number_of_paths : 1;
+        if ((families = calloc (number_of_families, sizeof (DxfHatchFillFamily))) == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        status = EXIT_SUCCESS;
+        number_of_lines = 0;
+        f = 0;
+        for (iter = def_lines; iter != NULL; iter = (DxfHatchPatternDefLine *) iter->next)
+        {
+                if (dxf_hatch_fill_build_family (&families[f], iter, boundary) != EXIT_SUCCESS)
+                {
+                        status = EXIT_FAILURE;
+                        break;
+                }
+                number_of_lines += families[f].number_of_lines;
+                f++;
+        }
+        /* Split the lines of all families into about one chunk per
+         * thread, a chunk never spans two families. */
+        if (number_of_threads < 1)
+        {
+                number_of_threads = 1;
+        }
+        chunk = (number_of_lines + number_of_threads - 1) / number_of_threads;
+        if (chunk < 1)
+        {
+                chunk = 1;
+        }
+        number_of_jobs = 0;
+        if (status == EXIT_SUCCESS)
+        {
+                for (f = 0; f < number_of_families; f++)
+                {
+                        number_of_jobs += (families[f].number_of_lines + chunk - 1) / chunk;
+                }
+        }
+        if (number_of_jobs > 0)
+        {
+                jobs = calloc (number_of_jobs, sizeof (DxfHatchFillJob));
+                threads = calloc (number_of_jobs, sizeof (pthread_t));
+                started = calloc (number_of_jobs, sizeof (int));
+                if ((jobs == NULL) || (threads == NULL) || (started == NULL))
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () could not allocate memory.\n")),
+                          __FUNCTION__);
+                        status = EXIT_FAILURE;
+                        number_of_jobs = 0;
+                }
+        }
+        i = 0;
+        for (f = 0; (f < number_of_families) && (number_of_jobs > 0); f++)
+        {
+                for (line = 0; line < families[f].number_of_lines; line += chunk)
+                {
+                        jobs[i].family = &families[f];
+                        jobs[i].style = style;
+                        jobs[i].number_of_loops = number_of_loops;
+                        jobs[i].begin = line;
+                        jobs[i].end = (line + chunk < families[f].number_of_lines)
+                          ? line + chunk : families[f].number_of_lines;
+                        i++;
+                }
+        }
+        /* The first job is done by the calling thread. */
+        for (i = 1; i < number_of_jobs; i++)
+        {
+                if (pthread_create (&threads[i], NULL, dxf_hatch_fill_run_job, &jobs[i]) == 0)
+                {
+                        started[i] = TRUE;
+                }
+        }
+        if (number_of_jobs > 0)
+        {
+                dxf_hatch_fill_run_job (&jobs[0]);
+        }
+        for (i = 1; i < number_of_jobs; i++)
+        {
+                if (started[i])
+                {
+                        pthread_join (threads[i], NULL);
+                }
+                else
+                {
+                        dxf_hatch_fill_run_job (&jobs[i]);
+                }
+        }
+        /* Gather the segments of all jobs in order. */
+        number_of_segments = 0;
+        for (i = 0; i < number_of_jobs; i++)
+        {
+                if (jobs[i].status != EXIT_SUCCESS)
+                {
+                        status = EXIT_FAILURE;
+                }
+                number_of_segments += jobs[i].buffer.number_of_segments;
+        }
+        if ((status == EXIT_SUCCESS)
+          && (dxf_hatch_fill_buffer_reserve (buffer, number_of_segments) != EXIT_SUCCESS))
+        {
+                status = EXIT_FAILURE;
+        }
+        for (i = 0; i < number_of_jobs; i++)
+        {
+                if ((status == EXIT_SUCCESS) && (jobs[i].buffer.number_of_segments > 0))
+                {
+                        memcpy (buffer->x0 + buffer->number_of_segments, jobs[i].buffer.x0,
+                          jobs[i].buffer.number_of_segments * sizeof (double));
+                        memcpy (buffer->y0 + buffer->number_of_segments, jobs[i].buffer.y0,
+                          jobs[i].buffer.number_of_segments * sizeof (double));
+                        memcpy (buffer->x1 + buffer->number_of_segments, jobs[i].buffer.x1,
+                          jobs[i].buffer.number_of_segments * sizeof (double));
+                        memcpy (buffer->y1 + buffer->number_of_segments, jobs[i].buffer.y1,
+                          jobs[i].buffer.number_of_segments * sizeof (double));
+                        buffer->number_of_segments += jobs[i].buffer.number_of_segments;
+                }
+                free (jobs[i].buffer.x0);
+                free (jobs[i].buffer.y0);
+                free (jobs[i].buffer.x1);
+                free (jobs[i].buffer.y1);
+        }
+        for (f = 0; f < number_of_families; f++)
+        {
+                free (families[f].edges);
+        }
+        free (families);
+        free (jobs);
+        free (threads);
+        free (started);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (status);
+}
+
+
+/*!
+ * \brief Generate the pattern fill of a DXF \c HATCH entity.
+ *
+ * The boundary paths are flattened once with the given tolerance, the
+ * hatch style of the \c HATCH entity determines the island detection
+ * style.\n
+ * The pattern definition lines of the hatch are used, or else those of
+ * its first pattern.\n
+ * A solid fill has no pattern lines and results in an empty buffer.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_hatch_fill_generate
+(
+        DxfHatch *hatch,
+                /*!< a pointer to a DXF \c HATCH entity. */
+        double tolerance,
+                /*!< maximum allowed deviation (sagitta) of flattened
+                 * boundary curves. */
+        DxfHatchFillBuffer *buffer,
+                /*!< a pointer to the segment buffer receiving the
+                 * result. */
+        int number_of_threads
+                /*!< number of threads to use. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfFlattenBuffer *boundary = NULL;
+        DxfHatchPatternDefLine *def_lines = NULL;
+        int result;
+
+        /* Do some basic checks. */
+        if ((hatch == NULL) || (buffer == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        buffer->number_of_segments = 0;
+        def_lines = (DxfHatchPatternDefLine *) hatch->def_lines;
+        if ((def_lines == NULL) && (hatch->patterns != NULL))
+        {
+                def_lines = (DxfHatchPatternDefLine *) ((DxfHatchPattern *) hatch->patterns)->def_lines;
+        }
+        if ((hatch->solid_fill) || (def_lines == NULL))
+        {
+                return (EXIT_SUCCESS);
+        }
+        boundary = dxf_flatten_buffer_init (dxf_flatten_buffer_new (), 256, 8);
+        if (boundary == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_flatten_hatch (hatch, tolerance, boundary);
+        if (dxf_flatten_buffer_is_overflowed (boundary))
+        {
+                /* Now that the required size is known, try again. */
+                if (dxf_flatten_buffer_reserve (boundary, boundary->number_of_vertices, boundary->number_of_paths) != EXIT_SUCCESS)
+                {
+                        dxf_flatten_buffer_free (boundary);
+                        return (EXIT_FAILURE);
+                }
+                dxf_flatten_buffer_reset (boundary);
+                dxf_flatten_hatch (hatch, tolerance, boundary);
+        }
+        result = dxf_hatch_fill_boundary (boundary, hatch->hatch_style,
+          def_lines, buffer, number_of_threads);
+        dxf_flatten_buffer_free (boundary);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (result);
+}
+
+
+/*!
+ * \brief Generate the pattern fill of every DXF \c HATCH entity in a
+ * single linked list.
+ *
+ * The hatches are divided over a number of threads, every hatch is
+ * filled by a single thread.\n
+ * The buffers must have been initialized, the fill of the n-th hatch
+ * is written to the n-th buffer.
+ *
+ * \return the number of hatches filled, or \c DXF_ERROR when an error
+ * occurred.
+ */
+int
+dxf_hatch_fill_generate_list
+(
+        DxfHatch *hatches,
+                /*!< a pointer to a single linked list of DXF \c HATCH
+                 * entities. */
+        double tolerance,
+                /*!< maximum allowed deviation (sagitta) of flattened
+                 * boundary curves. */
+        DxfHatchFillBuffer *buffers,
+                /*!< array of segment buffers, one per hatch. */
+        int max_number_of_buffers,
+                /*!< number of entries in \c buffers. */
+        int number_of_threads
+                /*!< number of threads to use. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfHatch *iter = NULL;
+        DxfHatch **entities = NULL;
+        DxfHatchFillListJob *jobs = NULL;
+        pthread_t *threads = NULL;
+        int *started = NULL;
+        int status;
+        int chunk;
+        int n;
+        int i;
+
+        /* Do some basic checks. */
+        if (buffers == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (DXF_ERROR);
+        }
+        entities = malloc (((max_number_of_buffers > 0) ? max_number_of_buffers : 1) * sizeof (DxfHatch *));
+        if (entities == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (DXF_ERROR);
+        }
+        /* Random access to the entities for the threads. */
+        n = 0;
+        iter = hatches;
+        while ((iter != NULL) && (n < max_number_of_buffers))
+        {
+                entities[n] = iter;
+                n++;
+                iter = (DxfHatch *) iter->next;
+        }
+        if (n == 0)
+        {
+                free (entities);
+                return (0);
+        }
+        if (number_of_threads < 1)
+        {
+                number_of_threads = 1;
+        }
+        if (number_of_threads > n)
+        {
+                number_of_threads = n;
+        }
+        jobs = calloc (number_of_threads, sizeof (DxfHatchFillListJob));
+        threads = calloc (number_of_threads, sizeof (pthread_t));
+        started = calloc (number_of_threads, sizeof (int));
+        if ((jobs == NULL) || (threads == NULL) || (started == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                free (entities);
+                free (jobs);
+                free (threads);
+                free (started);
+                return (DXF_ERROR);
+        }
+        chunk = (n + number_of_threads - 1) / number_of_threads;
+        for (i = 0; i < number_of_threads; i++)
+        {
+                jobs[i].hatches = entities;
+                jobs[i].tolerance = tolerance;
+                jobs[i].buffers = buffers;
+                jobs[i].begin = i * chunk;
+                jobs[i].end = ((i + 1) * chunk < n) ? (i + 1) * chunk : n;
+        }
+        /* The first chunk is done by the calling thread. */
+        for (i = 1; i < number_of_threads; i++)
+        {
+                if (pthread_create (&threads[i], NULL, dxf_hatch_fill_run_list_job, &jobs[i]) == 0)
+                {
+                        started[i] = TRUE;
+                }
+        }
+        dxf_hatch_fill_run_list_job (&jobs[0]);
+        status = EXIT_SUCCESS;
+        for (i = 0; i < number_of_threads; i++)
+        {
+                if ((i > 0) && started[i])
+                {
+                        pthread_join (threads[i], NULL);
+                }
+                else if (i > 0)
+                {
+                        dxf_hatch_fill_run_list_job (&jobs[i]);
+                }
+                if (jobs[i].status != EXIT_SUCCESS)
+                {
+                        status = EXIT_FAILURE;
+                }
+        }
+        free (entities);
+        free (jobs);
+        free (threads);
+        free (started);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return ((status == EXIT_SUCCESS) ? n : DXF_ERROR);
+}
+
+
+/*!
+ * \brief Set up a pattern line family and transform the boundary edges
+ * into its frame.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred, a family that can not be filled gets no lines.
+ */
+static int
+dxf_hatch_fill_build_family
+(
+        DxfHatchFillFamily *family,
+                /*!< a pointer to the family. */
+        DxfHatchPatternDefLine *def_line,
+                /*!< a pointer to the pattern definition line. */
+        DxfFlattenBuffer *boundary
+                /*!< a pointer to a buffer with flattened loops. */
+)
+{
+        DxfHatchPatternDefLineDash *dash = NULL;
+        DxfHatchFillEdge *edge = NULL;
+        double angle;
+        double ua;
+        double va;
+        double ub;
+        double vb;
+        double v_min;
+        double v_max;
+        double first;
+        double last;
+        int number_of_paths;
+        int path;
+        int begin;
+        int end;
+        int i;
+        int k;
+
+        angle = def_line->angle * M_PI / 180.0;
+        family->cos_angle = cos (angle);
+        family->sin_angle = sin (angle);
+        family->base_u = def_line->x0 * family->cos_angle + def_line->y0 * family->sin_angle;
+        family->base_v = -def_line->x0 * family->sin_angle + def_line->y0 * family->cos_angle;
+        family->shift = def_line->x1 * family->cos_angle + def_line->y1 * family->sin_angle;
+        family->spacing = -def_line->x1 * family->sin_angle + def_line->y1 * family->cos_angle;
+        if (family->spacing < 0.0)
+        {
+                family->spacing = -family->spacing;
+                family->shift = -family->shift;
+        }
+        family->pattern_length = 0.0;
+        family->number_of_dashes = 0;
+        for (dash = (DxfHatchPatternDefLineDash *) def_line->dashes; dash != NULL; dash = (DxfHatchPatternDefLineDash *) dash->next)
+        {
+                if (family->number_of_dashes == DXF_MAX_HATCH_PATTERN_DEF_LINE_DASH_ITEMS)
+                {
+                        fprintf (stderr,
+                          (_("Warning in %s () more than %d dash items, the remaining items are ignored.\n")),
+                          __FUNCTION__, DXF_MAX_HATCH_PATTERN_DEF_LINE_DASH_ITEMS);
+                        break;
+                }
+                family->dashes[family->number_of_dashes] = dash->length;
+                family->pattern_length += fabs (dash->length);
+                family->number_of_dashes++;
+        }
+        /* Transform the edges, horizontal edges never cross a line. */
+        number_of_paths = (boundary->path_start != NULL) ? boundary->number_of_paths : 1;
+        family->edges = malloc ((boundary->number_of_vertices + 1) * sizeof (DxfHatchFillEdge));
+        if (family->edges == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        v_min = 0.0;
+        v_max = 0.0;
+        family->number_of_edges = 0;
+        for (path = 0; path < number_of_paths; path++)
+        {
+                begin = (boundary->path_start != NULL) ? boundary->path_start[path] : 0;
+                end = ((boundary->path_start != NULL) && (path + 1 < number_of_paths))
+                  ? boundary->path_start[path + 1] - 1 : boundary->number_of_vertices - 1;
+                for (i = begin; i <= end; i++)
+                {
+                        k = (i == end) ? begin : i + 1;
+                        ua = boundary->x[i] * family->cos_angle + boundary->y[i] * family->sin_angle;
+                        va = -boundary->x[i] * family->sin_angle + boundary->y[i] * family->cos_angle;
+                        ub = boundary->x[k] * family->cos_angle + boundary->y[k] * family->sin_angle;
+                        vb = -boundary->x[k] * family->sin_angle + boundary->y[k] * family->cos_angle;
+                        if (va == vb)
+                        {
+                                continue;
+                        }
+                        edge = &family->edges[family->number_of_edges];
+                        if (va < vb)
+                        {
+                                edge->v_low = va;
+                                edge->v_high = vb;
+                                edge->u_low = ua;
+                        }
+                        else
+                        {
+                                edge->v_low = vb;
+                                edge->v_high = va;
+                                edge->u_low = ub;
+                        }
+                        edge->dudv = (ub - ua) / (vb - va);
+                        edge->loop = path;
+                        if ((family->number_of_edges == 0) || (edge->v_low < v_min)) v_min = edge->v_low;
+                        if ((family->number_of_edges == 0) || (edge->v_high > v_max)) v_max = edge->v_high;
+                        family->number_of_edges++;
+                }
+        }
+        qsort (family->edges, family->number_of_edges, sizeof (DxfHatchFillEdge),
+          dxf_hatch_fill_compare_edges);
+        family->first_line = 0;
+        family->number_of_lines = 0;
+        if (family->number_of_edges == 0)
+        {
+                return (EXIT_SUCCESS);
+        }
+        if (family->spacing <= (v_max - v_min) / DXF_HATCH_FILL_MAX_LINES)
+        {
+                fprintf (stderr,
+                  (_("Warning in %s () pattern line spacing too small, the pattern line is skipped.\n")),
+                  __FUNCTION__);
+                return (EXIT_SUCCESS);
+        }
+        first = ceil ((v_min - family->base_v) / family->spacing);
+        last = floor ((v_max - family->base_v) / family->spacing);
+        if ((last < first) || (fabs (first) > INT_MAX / 2) || (fabs (last) > INT_MAX / 2))
+        {
+                return (EXIT_SUCCESS);
+        }
+        family->first_line = (int) first;
+        family->number_of_lines = (int) (last - first) + 1;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Compare two edges on their lowest V-coordinate.
+ *
+ * \return a negative value, zero or a positive value.
+ */
+static int
+dxf_hatch_fill_compare_edges
+(
+        const void *a,
+                /*!< a pointer to the first edge. */
+        const void *b
+                /*!< a pointer to the second edge. */
+)
+{
+        const DxfHatchFillEdge *ea = a;
+        const DxfHatchFillEdge *eb = b;
+
+        if (ea->v_low != eb->v_low)
+        {
+                return ((ea->v_low < eb->v_low) ? -1 : 1);
+        }
+        return (0);
+}
+
+
+/*!
+ * \brief Compare two crossings on their U-coordinate.
+ *
+ * \return a negative value, zero or a positive value.
+ */
+static int
+dxf_hatch_fill_compare_crossings
+(
+        const void *a,
+                /*!< a pointer to the first crossing. */
+        const void *b
+                /*!< a pointer to the second crossing. */
+)
+{
+        const DxfHatchFillCrossing *ca = a;
+        const DxfHatchFillCrossing *cb = b;
+
+        if (ca->u != cb->u)
+        {
+                return ((ca->u < cb->u) ? -1 : 1);
+        }
+        return (ca->loop - cb->loop);
+}
+
+
+/*!
+ * \brief Fill a range of lines of a family, used as thread entry
+ * point.
+ *
+ * An edge is active for a line when the line lies in the half open
+ * range [\c v_low, \c v_high) of the edge, so that a line through a
+ * vertex crosses exactly one of the edges meeting there, or both when
+ * the vertex is a local extreme.
+ */
+static void *
+dxf_hatch_fill_run_job
+(
+        void *data
+                /*!< a pointer to a \c DxfHatchFillJob. */
+)
+{
+        DxfHatchFillJob *job = NULL;
+        DxfHatchFillFamily *family = NULL;
+        DxfHatchFillEdge *edge = NULL;
+        DxfHatchFillCrossing *crossings = NULL;
+        unsigned char *parity = NULL;
+        int *active = NULL;
+        int number_of_active;
+        int number_of_crossings;
+        int next_edge;
+        int inside;
+        int depth;
+        int line;
+        int i;
+        int j;
+        double origin;
+        double v;
+
+        job = (DxfHatchFillJob *) data;
+        family = job->family;
+        job->status = EXIT_SUCCESS;
+        active = malloc ((family->number_of_edges + 1) * sizeof (int));
+        crossings = malloc ((family->number_of_edges + 1) * sizeof (DxfHatchFillCrossing));
+        parity = calloc (job->number_of_loops + 1, sizeof (unsigned char));
+        if ((active == NULL) || (crossings == NULL) || (parity == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                job->status = EXIT_FAILURE;
+                free (active);
+                free (crossings);
+                free (parity);
+                return (NULL);
+        }
+        number_of_active = 0;
+        next_edge = 0;
+        for (line = job->begin; (line < job->end) && (job->status == EXIT_SUCCESS); line++)
+        {
+                v = family->base_v + (family->first_line + line) * family->spacing;
+                origin = family->base_u + (family->first_line + line) * family->shift;
+                /* Retire the edges below the line, activate the edges
+                 * starting at or below the line. */
+                j = 0;
+                for (i = 0; i < number_of_active; i++)
+                {
+                        if (family->edges[active[i]].v_high > v)
+                        {
+                                active[j] = active[i];
+                                j++;
+                        }
+                }
+                number_of_active = j;
+                while ((next_edge < family->number_of_edges)
+                  && (family->edges[next_edge].v_low <= v))
+                {
+                        if (family->edges[next_edge].v_high > v)
+                        {
+                                active[number_of_active] = next_edge;
+                                number_of_active++;
+                        }
+                        next_edge++;
+                }
+                number_of_crossings = 0;
+                for (i = 0; i < number_of_active; i++)
+                {
+                        edge = &family->edges[active[i]];
+                        crossings[number_of_crossings].u = edge->u_low + (v - edge->v_low) * edge->dudv;
+                        crossings[number_of_crossings].loop = edge->loop;
+                        number_of_crossings++;
+                }
+                qsort (crossings, number_of_crossings, sizeof (DxfHatchFillCrossing),
+                  dxf_hatch_fill_compare_crossings);
+                /* Walk along the line, the nesting depth is the number
+                 * of loops crossed an odd number of times. */
+                depth = 0;
+                for (i = 0; i < number_of_crossings - 1; i++)
+                {
+                        parity[crossings[i].loop] ^= 1;
+                        depth += (parity[crossings[i].loop]) ? 1 : -1;
+                        if (job->style == DXF_BOUNDARY_INDEX_STYLE_OUTER)
+                        {
+                                inside = (depth == 1);
+                        }
+                        else if (job->style == DXF_BOUNDARY_INDEX_STYLE_IGNORE)
+                        {
+                                inside = (depth >= 1);
+                        }
+                        else
+                        {
+                                inside = ((i & 1) == 0);
+                        }
+                        if ((inside)
+                          && (crossings[i + 1].u > crossings[i].u)
+                          && (dxf_hatch_fill_add_interval (&job->buffer, family, v,
+                          origin, crossings[i].u, crossings[i + 1].u) != EXIT_SUCCESS))
+                        {
+                                job->status = EXIT_FAILURE;
+                                break;
+                        }
+                }
+                for (i = 0; i < number_of_crossings; i++)
+                {
+                        parity[crossings[i].loop] = 0;
+                }
+        }
+        free (active);
+        free (crossings);
+        free (parity);
+        return (NULL);
+}
+
+
+/*!
+ * \brief Fill a range of hatches, used as thread entry point.
+ */
+static void *
+dxf_hatch_fill_run_list_job
+(
+        void *data
+                /*!< a pointer to a \c DxfHatchFillListJob. */
+)
+{
+        DxfHatchFillListJob *job = NULL;
+        int i;
+
+        job = (DxfHatchFillListJob *) data;
+        job->status = EXIT_SUCCESS;
+        for (i = job->begin; i < job->end; i++)
+        {
+                if (dxf_hatch_fill_generate (job->hatches[i], job->tolerance,
+                  &job->buffers[i], 1) != EXIT_SUCCESS)
+                {
+                        job->status = EXIT_FAILURE;
+                }
+        }
+        return (NULL);
+}
+
+
+/*!
+ * \brief Apply the dash pattern of a family to an inside interval of a
+ * line.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_hatch_fill_add_interval
+(
+        DxfHatchFillBuffer *buffer,
+                /*!< a pointer to the segment buffer. */
+        DxfHatchFillFamily *family,
+                /*!< a pointer to the family. */
+        double v,
+                /*!< V-coordinate of the line. */
+        double origin,
+                /*!< U-coordinate where the dash pattern of the line
+                 * starts. */
+        double ua,
+                /*!< U-coordinate of the start of the interval. */
+        double ub
+                /*!< U-coordinate of the end of the interval. */
+)
+{
+        double start;
+        double end;
+        double p;
+        int i;
+
+        if ((family->number_of_dashes == 0)
+          || (family->pattern_length <= 0.0)
+          || ((ub - ua) / family->pattern_length > DXF_HATCH_FILL_MAX_DASH_PERIODS))
+        {
+                return (dxf_hatch_fill_add_segment (buffer, family, v, ua, ub));
+        }
+        /* Start at the repetition of the pattern containing ua. */
+        p = ua - fmod (ua - origin, family->pattern_length);
+        if (p > ua)
+        {
+                p -= family->pattern_length;
+        }
+        while (p < ub)
+        {
+                for (i = 0; (i < family->number_of_dashes) && (p < ub); i++)
+                {
+                        start = p;
+                        p += fabs (family->dashes[i]);
+                        if (family->dashes[i] < 0.0)
+                        {
+                                continue;
+                        }
+                        end = (p < ub) ? p : ub;
+                        if (start < ua)
+                        {
+                                if ((family->dashes[i] == 0.0) || (end <= ua))
+                                {
+                                        continue;
+                                }
+                                start = ua;
+                        }
+                        if (dxf_hatch_fill_add_segment (buffer, family, v, start, end) != EXIT_SUCCESS)
+                        {
+                                return (EXIT_FAILURE);
+                        }
+                }
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Add a segment of a line to a segment buffer, transformed back
+ * from the frame of the family.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_hatch_fill_add_segment
+(
+        DxfHatchFillBuffer *buffer,
+                /*!< a pointer to the segment buffer. */
+        DxfHatchFillFamily *family,
+                /*!< a pointer to the family. */
+        double v,
+                /*!< V-coordinate of the line. */
+        double ua,
+                /*!< U-coordinate of the start of the segment. */
+        double ub
+                /*!< U-coordinate of the end of the segment. */
+)
+{
+        int n;
+
+        n = buffer->number_of_segments;
+        if ((n == buffer->max_number_of_segments)
+          && (dxf_hatch_fill_buffer_reserve (buffer,
+          (n > 0) ? 2 * n : 64) != EXIT_SUCCESS))
+        {
+                return (EXIT_FAILURE);
+        }
+        buffer->x0[n] = ua * family->cos_angle - v * family->sin_angle;
+        buffer->y0[n] = ua * family->sin_angle + v * family->cos_angle;
+        buffer->x1[n] = ub * family->cos_angle - v * family->sin_angle;
+        buffer->y1[n] = ub * family->sin_angle + v * family->cos_angle;
+        buffer->number_of_segments++;
+        return (EXIT_SUCCESS);
+}
+
+
+/* EOF */
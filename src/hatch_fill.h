@@ -0,0 +1,108 @@
+/*!
+ * \file hatch_fill.h
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * Header file for generating the pattern fill of DXF hatches
+ * (\c HATCH).
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#ifndef LIBDXF_SRC_HATCH_FILL_H
+#define LIBDXF_SRC_HATCH_FILL_H
+
+
+#include "global.h"
+#include "boundary_index.h"
+#include "flatten.h"
+#include "hatch.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define DXF_HATCH_FILL_MAX_LINES 1048576
+        /*!< \brief The maximum number of pattern lines generated for a
+         * single pattern definition line, a denser pattern is skipped. */
+
+#define DXF_HATCH_FILL_MAX_DASH_PERIODS 65536
+        /*!< \brief The maximum number of dash pattern repetitions on a
+         * single inside interval, a longer interval is filled with a
+         * continuous line. */
+
+
+/*!
+ * \brief Definition of a contiguous buffer of hatch fill line
+ * segments.
+ *
+ * The start and end points of the segments are stored in separate
+ * arrays, the buffer grows as segments are added.\n
+ * Coordinates are in the Object Coordinate System (OCS) of the
+ * \c HATCH entity.\n
+ * A dot in a dash pattern is a segment with coinciding start and end
+ * points.
+ */
+typedef struct
+dxf_hatch_fill_buffer_struct
+{
+        double *x0;
+                /*!< Array of X-coordinates of the start points. */
+        double *y0;
+                /*!< Array of Y-coordinates of the start points. */
+        double *x1;
+                /*!< Array of X-coordinates of the end points. */
+        double *y1;
+                /*!< Array of Y-coordinates of the end points. */
+        int number_of_segments;
+                /*!< Number of segments. */
+        int max_number_of_segments;
+                /*!< Number of segments that fit in the arrays. */
+} DxfHatchFillBuffer;
+
+
+DxfHatchFillBuffer *dxf_hatch_fill_buffer_new ();
+DxfHatchFillBuffer *dxf_hatch_fill_buffer_init (DxfHatchFillBuffer *buffer, int max_number_of_segments);
+int dxf_hatch_fill_buffer_reserve (DxfHatchFillBuffer *buffer, int max_number_of_segments);
+int dxf_hatch_fill_buffer_clear (DxfHatchFillBuffer *buffer);
+int dxf_hatch_fill_buffer_free (DxfHatchFillBuffer *buffer);
+int dxf_hatch_fill_boundary (DxfFlattenBuffer *boundary, int style, DxfHatchPatternDefLine *def_lines, DxfHatchFillBuffer *buffer, int number_of_threads);
+int dxf_hatch_fill_generate (DxfHatch *hatch, double tolerance, DxfHatchFillBuffer *buffer, int number_of_threads);
+int dxf_hatch_fill_generate_list (DxfHatch *hatches, double tolerance, DxfHatchFillBuffer *buffers, int max_number_of_buffers, int number_of_threads);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* LIBDXF_SRC_HATCH_FILL_H */
+
+
+/* EOF */
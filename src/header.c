@@ -840,7 +840,8 @@ dxf_header_write_metric_new
         time_t now;
         if (time(&now) != (time_t)(-1))
         {
-            struct tm *current_time = localtime(&now);
+            struct tm current_tm;
+            struct tm *current_time = localtime_r(&now, &current_tm);
 
             JD=current_time->tm_mday-32075+1461*(current_time->tm_year+6700+(current_time->tm_mon-13)/12)/4+367*(current_time->tm_mon-1-(current_time->tm_mon-13)/12*12)/12-3*((current_time->tm_year+6800+(current_time->tm_mon-13)/12)/100)/4;
             /* Transforms the current local gregorian date in a julian date.*/
@@ -1904,12 +1905,21 @@ dxf_header_read
                 /* Skip to variable name */
                 while((ch = fgetc(fp->fp)) != '$')
                 {
+                    if(ch == EOF)
+                    {
+                        break;
+                    }
                     if(ch == '\n')
                     {
                         fp->line_number++;
                     }
                     continue;
                 }
+                if(ch == EOF)
+                {
+                    /* End of file without a variable name */
+                    break;
+                }
                 ungetc(ch, fp->fp);
                 fgets(line_in, sizeof(line_in), fp->fp);
                 fp->line_number++;
@@ -3197,41 +3207,24 @@ dxf_header_get_string_variable
                 }
         }
 
-        while((ch = fgetc(fp->fp))!= EOF)
+        /* The value is the whole line following the group code, it
+         * may be empty or start with a digit (e.g. a \c $HANDSEED). */
+        char line_in[DXF_MAX_STRING_LENGTH] = {};
+        if (fgets(line_in, sizeof(line_in), fp->fp) != NULL)
         {
-                /* Skip whitespace */
-                if(ch == '\n')
-                {
-                        fp->line_number++;
-                }
-                else if(isspace(ch))
-                {
-                        continue;
-                }
-                else if(isalpha(ch))
-                {
-                        /* Store the variable value in the result */
-                        ungetc(ch, fp->fp);
-                        char line_in[64] = {};
-                        char temp_string[64] = {};
-                        fgets(line_in, sizeof(line_in), fp->fp);
-                        sscanf(line_in, "%s", temp_string);
-                        /* Swap out the default string for the new one */
-                        free(*res);
-                        *res = strdup(temp_string);
-                        break;
-                }
-                else
+                size_t length = strlen(line_in);
+                size_t skip = strspn(line_in, " \t");
+                fp->line_number++;
+                while((length > skip)
+                  && ((line_in[length - 1] == '\n') || (line_in[length - 1] == '\r')
+                    || (line_in[length - 1] == ' ')))
                 {
-                        ungetc(ch, fp->fp);
-                        char line_in[64] = {};
-                        fgets(line_in, sizeof(line_in), fp->fp);
-                        fprintf(stderr, (_("Warning in %s () unknown input: %s"
-                                           "File: %s\n"
-                                           "Line: %d\n")),
-                                __FUNCTION__, line_in, fp->filename, fp->line_number);
-                        fp->line_number++;
+                        length--;
                 }
+                line_in[length] = '\0';
+                /* Swap out the default string for the new one */
+                free(*res);
+                *res = strdup(line_in + skip);
         }
 }
 
@@ -3248,7 +3241,41 @@ dxf_header_get_dxf_point_variable
         /*!< DXF file handle of input file (or device)  */
         )
 {
-        dxf_point_read(fp, res);
+        char line_in[256];
+        int group_code;
+        long position;
+
+        /* Read coordinate pairs until the next group code which is not
+         * a coordinate, which is left in place for the caller. */
+        while(TRUE)
+        {
+                position = ftell(fp->fp);
+                if((fgets(line_in, sizeof(line_in), fp->fp) == NULL)
+                  || (sscanf(line_in, "%d", &group_code) != 1)
+                  || ((group_code != 10) && (group_code != 20) && (group_code != 30)))
+                {
+                        fseek(fp->fp, position, SEEK_SET);
+                        break;
+                }
+                fp->line_number++;
+                if(fgets(line_in, sizeof(line_in), fp->fp) == NULL)
+                {
+                        break;
+                }
+                fp->line_number++;
+                if(group_code == 10)
+                {
+                        sscanf(line_in, "%lf", &res->x0);
+                }
+                else if(group_code == 20)
+                {
+                        sscanf(line_in, "%lf", &res->y0);
+                }
+                else
+                {
+                        sscanf(line_in, "%lf", &res->z0);
+                }
+        }
 }
 
 /* EOF */
@@ -38,6 +38,8 @@
 
 
 #include "helix.h"
+#include "stats.h"
+#include "util.h"
 
 
 /*!
@@ -70,6 +72,7 @@ dxf_helix_new ()
         else
         {
                 memset (helix, 0, size);
+                dxf_stats_count_allocation (HELIX, size);
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -111,8 +114,8 @@ dxf_helix_init
               return (NULL);
         }
         helix->id_code = 0;
-        helix->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        helix->layer = strdup (DXF_DEFAULT_LAYER);
+        helix->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        helix->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         helix->p0 = dxf_point_init (helix->p0);
         helix->p1 = dxf_point_init (helix->p1);
         helix->p2 = dxf_point_init (helix->p2);
@@ -130,14 +133,14 @@ dxf_helix_init
         helix->constraint_type = 0;
         helix->shadow_mode = 0;
         helix->handedness = 0;
-        helix->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_init (helix->binary_graphics_data);
-        helix->dictionary_owner_hard = strdup ("");
-        helix->material = strdup ("");
-        helix->dictionary_owner_soft = strdup ("");
+        helix->binary_graphics_data = NULL;
+        helix->dictionary_owner_hard = dxf_string_share ("");
+        helix->material = dxf_string_share ("");
+        helix->dictionary_owner_soft = dxf_string_share ("");
         helix->lineweight = 0;
-        helix->plot_style_name = strdup ("");
+        helix->plot_style_name = dxf_string_share ("");
         helix->color_value = 0;
-        helix->color_name = strdup ("");
+        helix->color_name = dxf_string_share ("");
         helix->transparency = 0;
         helix->spline = (DxfSpline *) dxf_spline_init (helix->spline);
         helix->next = NULL;
@@ -219,14 +222,12 @@ dxf_helix_read
                 {
                         /* Now follows a string containing a linetype
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", helix->linetype);
+                        dxf_read_string (fp, &helix->linetype);
                 }
                 else if (strcmp (temp_string, "8") == 0)
                 {
                         /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", helix->layer);
+                        dxf_read_string (fp, &helix->layer);
                 }
                 else if (strcmp (temp_string, "10") == 0)
                 {
@@ -418,31 +419,25 @@ dxf_helix_read
                 {
                         /* Now follows a string containing binary
                          * graphics data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", helix->binary_graphics_data->data_line);
-                        dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) helix->binary_graphics_data->next);
-                        helix->binary_graphics_data = (DxfBinaryGraphicsData *) helix->binary_graphics_data->next;
+                        dxf_binary_graphics_data_read (fp, &helix->binary_graphics_data, NULL);
                 }
                 else if (strcmp (temp_string, "330") == 0)
                 {
                         /* Now follows a string containing a
                          * soft-pointer ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", helix->dictionary_owner_soft);
+                        dxf_read_string (fp, &helix->dictionary_owner_soft);
                 }
                 else if (strcmp (temp_string, "347") == 0)
                 {
                         /* Now follows a string containing a
                          * hard-pointer ID/handle to material object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", helix->material);
+                        dxf_read_string (fp, &helix->material);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing a
                          * hard-pointer ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", helix->dictionary_owner_hard);
+                        dxf_read_string (fp, &helix->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "370") == 0)
                 {
@@ -455,8 +450,7 @@ dxf_helix_read
                 {
                         /* Now follows a string containing a plot style
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", helix->plot_style_name);
+                        dxf_read_string (fp, &helix->plot_style_name);
                 }
                 else if (strcmp (temp_string, "420") == 0)
                 {
@@ -468,8 +462,7 @@ dxf_helix_read
                 {
                         /* Now follows a string containing a color
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", helix->color_name);
+                        dxf_read_string (fp, &helix->color_name);
                 }
                 else if (strcmp (temp_string, "440") == 0)
                 {
@@ -495,11 +488,13 @@ dxf_helix_read
         /* Handle omitted members and/or illegal values. */
         if (strcmp (helix->linetype, "") == 0)
         {
-                helix->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (helix->linetype);
+                helix->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (helix->layer, "") == 0)
         {
-                helix->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (helix->layer);
+                helix->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Clean up. */
         free (temp_string);
@@ -586,7 +581,8 @@ dxf_helix_write
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                helix->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (helix->linetype);
+                helix->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (helix->layer, "") == 0)
         {
@@ -758,17 +754,21 @@ dxf_helix_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (helix->linetype);
-        free (helix->layer);
-        dxf_binary_graphics_data_free_list ((DxfBinaryGraphicsData *) helix->binary_graphics_data);
-        free (helix->dictionary_owner_hard);
-        free (helix->material);
-        free (helix->dictionary_owner_soft);
-        free (helix->plot_style_name);
-        free (helix->color_name);
+        dxf_string_free (helix->linetype);
+        dxf_string_free (helix->layer);
+        if (helix->binary_graphics_data != NULL)
+        {
+                dxf_binary_graphics_data_free_list (helix->binary_graphics_data);
+        }
+        dxf_string_free (helix->dictionary_owner_hard);
+        dxf_string_free (helix->material);
+        dxf_string_free (helix->dictionary_owner_soft);
+        dxf_string_free (helix->plot_style_name);
+        dxf_string_free (helix->color_name);
         dxf_point_free (helix->p0);
         dxf_point_free (helix->p1);
         dxf_point_free (helix->p2);
+        dxf_string_free (helix->object_owner_soft);
         free (helix);
         helix = NULL;
 #if DEBUG
@@ -945,6 +945,8 @@ dxf_helix_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (helix == NULL)
         {
@@ -960,7 +962,13 @@ dxf_helix_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        helix->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (helix->linetype);
+        helix->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1023,6 +1031,8 @@ dxf_helix_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (helix == NULL)
         {
@@ -1038,7 +1048,13 @@ dxf_helix_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        helix->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (helix->layer);
+        helix->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1781,6 +1797,8 @@ dxf_helix_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (helix == NULL)
         {
@@ -1796,7 +1814,13 @@ dxf_helix_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        helix->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (helix->dictionary_owner_soft);
+        helix->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1861,6 +1885,8 @@ dxf_helix_set_object_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (helix == NULL)
         {
@@ -1876,7 +1902,13 @@ dxf_helix_set_object_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        helix->object_owner_soft = strdup (object_owner_soft);
+        copy = dxf_string_share (object_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (helix->object_owner_soft);
+        helix->object_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1943,6 +1975,8 @@ dxf_helix_set_material
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (helix == NULL)
         {
@@ -1958,7 +1992,13 @@ dxf_helix_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        helix->material = strdup (material);
+        copy = dxf_string_share (material);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (helix->material);
+        helix->material = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2027,6 +2067,8 @@ dxf_helix_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (helix == NULL)
         {
@@ -2042,7 +2084,13 @@ dxf_helix_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        helix->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (helix->dictionary_owner_hard);
+        helix->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2172,6 +2220,8 @@ dxf_helix_set_plot_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (helix == NULL)
         {
@@ -2187,7 +2237,13 @@ dxf_helix_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        helix->plot_style_name = strdup (plot_style_name);
+        copy = dxf_string_share (plot_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (helix->plot_style_name);
+        helix->plot_style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2317,6 +2373,8 @@ dxf_helix_set_color_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (helix == NULL)
         {
@@ -2332,7 +2390,13 @@ dxf_helix_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        helix->color_name = strdup (color_name);
+        copy = dxf_string_share (color_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (helix->color_name);
+        helix->color_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
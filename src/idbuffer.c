@@ -45,6 +45,7 @@
 
 
 #include "idbuffer.h"
+#include "util.h"
 
 
 /*!
@@ -115,9 +116,9 @@ dxf_idbuffer_init
                 return (NULL);
         }
         idbuffer->id_code = 0;
-        idbuffer->dictionary_owner_soft = strdup ("");
-        idbuffer->object_owner_soft = strdup ("");
-        idbuffer->dictionary_owner_hard = strdup ("");
+        idbuffer->dictionary_owner_soft = dxf_string_share ("");
+        idbuffer->object_owner_soft = dxf_string_share ("");
+        idbuffer->dictionary_owner_hard = dxf_string_share ("");
         idbuffer->entity_pointer = (DxfIdbufferEntityPointer *) dxf_idbuffer_entity_pointer_init (idbuffer->entity_pointer);
         idbuffer->next = NULL;
 #if DEBUG
@@ -223,16 +224,14 @@ dxf_idbuffer_read
                         {
                                 /* Now follows a string containing a soft-pointer
                                  * ID/handle to owner dictionary. */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%s\n", idbuffer->dictionary_owner_soft);
+                                dxf_read_string (fp, &idbuffer->dictionary_owner_soft);
                                 i++;
                         }
                         if (iter330 == 1)
                         {
                                 /* Now follows a string containing a soft-pointer
                                  * ID/handle to owner object. */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%s\n", idbuffer->object_owner_soft);
+                                dxf_read_string (fp, &idbuffer->object_owner_soft);
                         }
                         iter330++;
                 }
@@ -241,8 +240,7 @@ dxf_idbuffer_read
                 {
                         /* Now follows a string containing a Soft
                          * pointer reference to entity. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", entity_pointer->soft_pointer);
+                        dxf_read_string (fp, &entity_pointer->soft_pointer);
                         dxf_idbuffer_entity_pointer_init ((DxfIdbufferEntityPointer *) entity_pointer->next);
                         entity_pointer = (DxfIdbufferEntityPointer *) entity_pointer->next;
                 }
@@ -250,8 +248,7 @@ dxf_idbuffer_read
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", idbuffer->dictionary_owner_hard);
+                        dxf_read_string (fp, &idbuffer->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "999") == 0)
                 {
@@ -409,9 +406,9 @@ dxf_idbuffer_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (idbuffer->dictionary_owner_soft);
-        free (idbuffer->object_owner_soft);
-        free (idbuffer->dictionary_owner_hard);
+        dxf_string_free (idbuffer->dictionary_owner_soft);
+        dxf_string_free (idbuffer->object_owner_soft);
+        dxf_string_free (idbuffer->dictionary_owner_hard);
         dxf_idbuffer_entity_pointer_free_list ((DxfIdbufferEntityPointer *) idbuffer->entity_pointer);
         free (idbuffer);
         idbuffer = NULL;
@@ -595,6 +592,8 @@ dxf_idbuffer_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (idbuffer == NULL)
         {
@@ -610,7 +609,13 @@ dxf_idbuffer_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        idbuffer->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (idbuffer->dictionary_owner_soft);
+        idbuffer->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -675,6 +680,8 @@ dxf_idbuffer_set_object_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (idbuffer == NULL)
         {
@@ -690,7 +697,13 @@ dxf_idbuffer_set_object_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        idbuffer->object_owner_soft = strdup (object_owner_soft);
+        copy = dxf_string_share (object_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (idbuffer->object_owner_soft);
+        idbuffer->object_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -759,6 +772,8 @@ dxf_idbuffer_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (idbuffer == NULL)
         {
@@ -774,7 +789,13 @@ dxf_idbuffer_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        idbuffer->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (idbuffer->dictionary_owner_hard);
+        idbuffer->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1059,7 +1080,7 @@ dxf_idbuffer_entity_pointer_init
                   __FUNCTION__);
                 return (NULL);
         }
-        entity_pointer->soft_pointer = strdup ("");
+        entity_pointer->soft_pointer = dxf_string_share ("");
         entity_pointer->next = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -1101,7 +1122,7 @@ dxf_idbuffer_entity_pointer_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (entity_pointer->soft_pointer);
+        dxf_string_free (entity_pointer->soft_pointer);
         free (entity_pointer);
         entity_pointer = NULL;
 #if DEBUG
@@ -1205,6 +1226,8 @@ dxf_idbuffer_entity_pointer_set_soft_pointer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (entity_pointer == NULL)
         {
@@ -1220,7 +1243,13 @@ dxf_idbuffer_entity_pointer_set_soft_pointer
                   __FUNCTION__);
                 return (NULL);
         }
-        entity_pointer->soft_pointer = strdup (soft_pointer);
+        copy = dxf_string_share (soft_pointer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (entity_pointer->soft_pointer);
+        entity_pointer->soft_pointer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
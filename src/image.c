@@ -46,6 +46,8 @@
 
 
 #include "image.h"
+#include "stats.h"
+#include "util.h"
 
 
 /*!
@@ -78,6 +80,7 @@ dxf_image_new ()
         else
         {
                 memset (image, 0, size);
+                dxf_stats_count_allocation (IMAGE, size);
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -119,8 +122,8 @@ dxf_image_init
               return (NULL);
         }
         dxf_image_set_id_code (image, 0);
-        dxf_image_set_linetype (image, strdup (DXF_DEFAULT_LINETYPE));
-        dxf_image_set_layer (image, strdup (DXF_DEFAULT_LAYER));
+        image->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        image->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         dxf_image_set_elevation (image, 0.0);
         dxf_image_set_thickness (image, 0.0);
         dxf_image_set_linetype_scale (image, DXF_DEFAULT_LINETYPE_SCALE);
@@ -129,15 +132,14 @@ dxf_image_init
         dxf_image_set_paperspace (image, DXF_MODELSPACE);
         dxf_image_set_graphics_data_size (image, 0);
         dxf_image_set_shadow_mode (image, 0);
-        dxf_image_set_binary_graphics_data (image, (DxfBinaryGraphicsData *) dxf_binary_graphics_data_new ());
-        dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) dxf_image_get_binary_graphics_data (image));
-        dxf_image_set_dictionary_owner_soft (image, strdup (""));
-        dxf_image_set_material (image, strdup (""));
-        dxf_image_set_dictionary_owner_hard (image, strdup (""));
+        image->binary_graphics_data = NULL;
+        image->dictionary_owner_soft = dxf_string_share ("");
+        image->material = dxf_string_share ("");
+        image->dictionary_owner_hard = dxf_string_share ("");
         dxf_image_set_lineweight (image, 0);
-        dxf_image_set_plot_style_name (image, strdup (""));
+        image->plot_style_name = dxf_string_share ("");
         dxf_image_set_color_value (image, 0);
-        dxf_image_set_color_name (image, strdup (""));
+        image->color_name = dxf_string_share ("");
         dxf_image_set_transparency (image, 0);
         dxf_image_set_p0 (image, (DxfPoint *) dxf_point_new ());
         dxf_point_init ((DxfPoint *) dxf_image_get_p0 (image));
@@ -157,8 +159,8 @@ dxf_image_init
         dxf_image_set_brightness (image, 50);
         dxf_image_set_contrast (image, 50);
         dxf_image_set_fade (image, 50);
-        dxf_image_set_imagedef_object (image, strdup (""));
-        dxf_image_set_imagedef_reactor_object (image, strdup (""));
+        image->imagedef_object = dxf_string_share ("");
+        image->imagedef_reactor_object = dxf_string_share ("");
         dxf_image_set_next (image, NULL);
 #if DEBUG
         DXF_DEBUG_END
@@ -239,14 +241,12 @@ dxf_image_read
                 {
                         /* Now follows a string containing a linetype
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", image->linetype);
+                        dxf_read_string (fp, &image->linetype);
                 }
                 else if (strcmp (temp_string, "8") == 0)
                 {
                         /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", image->layer);
+                        dxf_read_string (fp, &image->layer);
                 }
                 else if (strcmp (temp_string, "10") == 0)
                 {
@@ -466,22 +466,19 @@ dxf_image_read
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", image->dictionary_owner_soft);
+                        dxf_read_string (fp, &image->dictionary_owner_soft);
                 }
                 else if (strcmp (temp_string, "340") == 0)
                 {
                         /* Now follows a string containing a hard
                          * reference to imagedef object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", image->imagedef_object);
+                        dxf_read_string (fp, &image->imagedef_object);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing a hard
                          * reference to imagedef_reactor object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", image->imagedef_reactor_object);
+                        dxf_read_string (fp, &image->imagedef_reactor_object);
                 }
                 else if (strcmp (temp_string, "999") == 0)
                 {
@@ -500,11 +497,13 @@ dxf_image_read
         /* Handle omitted members and/or illegal values. */
         if (strcmp (image->linetype, "") == 0)
         {
-                image->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (image->linetype);
+                image->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (image->layer, "") == 0)
         {
-                image->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (image->layer);
+                image->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Clean up. */
         free (temp_string);
@@ -723,21 +722,24 @@ dxf_image_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (dxf_image_get_linetype (image));
-        free (dxf_image_get_layer (image));
-        dxf_binary_graphics_data_free_list (dxf_image_get_binary_graphics_data (image));
-        free (dxf_image_get_dictionary_owner_soft (image));
-        free (dxf_image_get_material (image));
-        free (dxf_image_get_dictionary_owner_hard (image));
-        free (dxf_image_get_plot_style_name (image));
-        free (dxf_image_get_color_name (image));
+        dxf_string_free (image->linetype);
+        dxf_string_free (image->layer);
+        if (image->binary_graphics_data != NULL)
+        {
+                dxf_binary_graphics_data_free_list (image->binary_graphics_data);
+        }
+        dxf_string_free (image->dictionary_owner_soft);
+        dxf_string_free (image->material);
+        dxf_string_free (image->dictionary_owner_hard);
+        dxf_string_free (image->plot_style_name);
+        dxf_string_free (image->color_name);
         dxf_point_free (dxf_image_get_p0 (image));
         dxf_point_free (dxf_image_get_p1 (image));
         dxf_point_free (dxf_image_get_p2 (image));
         dxf_point_free (dxf_image_get_p3 (image));
         dxf_point_free_list (dxf_image_get_p4 (image));
-        free (dxf_image_get_imagedef_object (image));
-        free (dxf_image_get_imagedef_reactor_object (image));
+        dxf_string_free (image->imagedef_object);
+        dxf_string_free (image->imagedef_reactor_object);
         free (image);
         image = NULL;
 #if DEBUG
@@ -916,6 +918,8 @@ dxf_image_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (image == NULL)
         {
@@ -931,7 +935,13 @@ dxf_image_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        image->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (image->linetype);
+        image->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -994,6 +1004,8 @@ dxf_image_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (image == NULL)
         {
@@ -1009,7 +1021,13 @@ dxf_image_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        image->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (image->layer);
+        image->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1833,6 +1851,8 @@ dxf_image_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (image == NULL)
         {
@@ -1848,7 +1868,13 @@ dxf_image_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        image->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (image->dictionary_owner_soft);
+        image->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1915,6 +1941,8 @@ dxf_image_set_material
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (image == NULL)
         {
@@ -1930,7 +1958,13 @@ dxf_image_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        image->material = strdup (material);
+        copy = dxf_string_share (material);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (image->material);
+        image->material = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1999,6 +2033,8 @@ dxf_image_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (image == NULL)
         {
@@ -2014,7 +2050,13 @@ dxf_image_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        image->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (image->dictionary_owner_hard);
+        image->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2144,6 +2186,8 @@ dxf_image_set_plot_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (image == NULL)
         {
@@ -2159,7 +2203,13 @@ dxf_image_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        image->plot_style_name = strdup (plot_style_name);
+        copy = dxf_string_share (plot_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (image->plot_style_name);
+        image->plot_style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2289,6 +2339,8 @@ dxf_image_set_color_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (image == NULL)
         {
@@ -2304,7 +2356,13 @@ dxf_image_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        image->color_name = strdup (color_name);
+        copy = dxf_string_share (color_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (image->color_name);
+        image->color_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -4584,6 +4642,8 @@ dxf_image_set_imagedef_object
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (image == NULL)
         {
@@ -4599,7 +4659,13 @@ dxf_image_set_imagedef_object
                   __FUNCTION__);
                 return (NULL);
         }
-        image->imagedef_object = strdup (imagedef_object);
+        copy = dxf_string_share (imagedef_object);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (image->imagedef_object);
+        image->imagedef_object = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -4664,6 +4730,8 @@ dxf_image_set_imagedef_reactor_object
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (image == NULL)
         {
@@ -4679,7 +4747,13 @@ dxf_image_set_imagedef_reactor_object
                   __FUNCTION__);
                 return (NULL);
         }
-        image->imagedef_reactor_object = strdup (imagedef_reactor_object);
+        copy = dxf_string_share (imagedef_reactor_object);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (image->imagedef_reactor_object);
+        image->imagedef_reactor_object = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -44,6 +44,7 @@
 
 
 #include "imagedef.h"
+#include "util.h"
 
 
 /*!
@@ -114,9 +115,9 @@ dxf_imagedef_init
                 return (NULL);
         }
         dxf_imagedef_set_id_code (imagedef, 0);
-        dxf_imagedef_set_dictionary_owner_soft (imagedef, strdup (""));
-        dxf_imagedef_set_dictionary_owner_hard (imagedef, strdup (""));
-        dxf_imagedef_set_file_name (imagedef, strdup (""));
+        imagedef->dictionary_owner_soft = dxf_string_share ("");
+        imagedef->dictionary_owner_hard = dxf_string_share ("");
+        imagedef->file_name = dxf_string_share ("");
         dxf_imagedef_set_x0 (imagedef, 0.0);
         dxf_imagedef_set_y0 (imagedef, 0.0);
         dxf_imagedef_set_x0 (imagedef, 0.0);
@@ -124,7 +125,7 @@ dxf_imagedef_init
         dxf_imagedef_set_class_version (imagedef, 0);
         dxf_imagedef_set_image_is_loaded_flag (imagedef, 0);
         dxf_imagedef_set_resolution_units (imagedef, 0);
-        dxf_imagedef_set_acad_image_dict_soft (imagedef, strdup (""));
+        imagedef->acad_image_dict_soft = dxf_string_share ("");
         dxf_imagedef_set_imagedef_reactor (imagedef, dxf_imagedef_reactor_new ());
         dxf_imagedef_reactor_init ((DxfImagedefReactor *) dxf_imagedef_get_imagedef_reactor (imagedef)); 
         dxf_imagedef_set_next (imagedef, NULL);
@@ -203,8 +204,7 @@ dxf_imagedef_read
                 else if (strcmp (temp_string, "1") == 0)
                 {
                         /* Now follows a string containing a file name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", imagedef->file_name);
+                        dxf_read_string (fp, &imagedef->file_name);
                 }
                 if (strcmp (temp_string, "5") == 0)
                 {
@@ -283,8 +283,7 @@ dxf_imagedef_read
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", imagedef->dictionary_owner_soft);
+                        dxf_read_string (fp, &imagedef->dictionary_owner_soft);
                         i++;
                 }
                 else if ((strcmp (temp_string, "330") == 0)
@@ -292,8 +291,7 @@ dxf_imagedef_read
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", imagedef->acad_image_dict_soft);
+                        dxf_read_string (fp, &imagedef->acad_image_dict_soft);
                         i++;
                         /*! \todo Check for overrun of array index. */
                 }
@@ -310,8 +308,7 @@ dxf_imagedef_read
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", imagedef->dictionary_owner_hard);
+                        dxf_read_string (fp, &imagedef->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "999") == 0)
                 {
@@ -478,10 +475,10 @@ dxf_imagedef_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (imagedef->dictionary_owner_soft);
-        free (imagedef->dictionary_owner_hard);
-        free (imagedef->file_name);
-        free (imagedef->acad_image_dict_soft);
+        dxf_string_free (imagedef->dictionary_owner_soft);
+        dxf_string_free (imagedef->dictionary_owner_hard);
+        dxf_string_free (imagedef->file_name);
+        dxf_string_free (imagedef->acad_image_dict_soft);
         for (i = 0; i < DXF_MAX_PARAM; i++)
         {
                 free (imagedef->imagedef_reactor_soft[i]);
@@ -670,6 +667,8 @@ dxf_imagedef_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (imagedef == NULL)
         {
@@ -685,7 +684,13 @@ dxf_imagedef_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        imagedef->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (imagedef->dictionary_owner_soft);
+        imagedef->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -754,6 +759,8 @@ dxf_imagedef_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (imagedef == NULL)
         {
@@ -769,7 +776,13 @@ dxf_imagedef_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        imagedef->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (imagedef->dictionary_owner_hard);
+        imagedef->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -833,6 +846,8 @@ dxf_imagedef_set_file_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (imagedef == NULL)
         {
@@ -848,7 +863,13 @@ dxf_imagedef_set_file_name
                   __FUNCTION__);
                 return (NULL);
         }
-        imagedef->file_name = strdup (file_name);
+        copy = dxf_string_share (file_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (imagedef->file_name);
+        imagedef->file_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1680,6 +1701,8 @@ dxf_imagedef_set_acad_image_dict_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (imagedef == NULL)
         {
@@ -1695,7 +1718,13 @@ dxf_imagedef_set_acad_image_dict_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        imagedef->acad_image_dict_soft = strdup (acad_image_dict_soft);
+        copy = dxf_string_share (acad_image_dict_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (imagedef->acad_image_dict_soft);
+        imagedef->acad_image_dict_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -45,6 +45,7 @@
 
 
 #include "imagedef_reactor.h"
+#include "util.h"
 
 
 /*!
@@ -115,10 +116,10 @@ dxf_imagedef_reactor_init
                 return (NULL);
         }
         dxf_imagedef_reactor_set_id_code (imagedef_reactor, 0);
-        dxf_imagedef_reactor_set_dictionary_owner_soft (imagedef_reactor, strdup (""));
-        dxf_imagedef_reactor_set_dictionary_owner_hard (imagedef_reactor, strdup (""));
+        imagedef_reactor->dictionary_owner_soft = dxf_string_share ("");
+        imagedef_reactor->dictionary_owner_hard = dxf_string_share ("");
         dxf_imagedef_reactor_set_class_version (imagedef_reactor, 2);
-        dxf_imagedef_reactor_set_associated_image_object (imagedef_reactor, strdup (""));
+        imagedef_reactor->associated_image_object = dxf_string_share ("");
         dxf_imagedef_reactor_set_associated_image_object_length (imagedef_reactor, 0);
         dxf_imagedef_reactor_set_next (imagedef_reactor, NULL);
 #if DEBUG
@@ -227,8 +228,7 @@ dxf_imagedef_reactor_read
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", imagedef_reactor->dictionary_owner_soft);
+                        dxf_read_string (fp, &imagedef_reactor->dictionary_owner_soft);
                         i++;
                 }
                 else if ((strcmp (temp_string, "330") == 0)
@@ -236,16 +236,14 @@ dxf_imagedef_reactor_read
                 {
                         /* Now follows a string containing object ID for
                          * associated image object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", imagedef_reactor->associated_image_object);
+                        dxf_read_string (fp, &imagedef_reactor->associated_image_object);
                         i++;
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", imagedef_reactor->dictionary_owner_hard);
+                        dxf_read_string (fp, &imagedef_reactor->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "999") == 0)
                 {
@@ -398,9 +396,9 @@ dxf_imagedef_reactor_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (imagedef_reactor->dictionary_owner_soft);
-        free (imagedef_reactor->dictionary_owner_hard);
-        free (imagedef_reactor->associated_image_object);
+        dxf_string_free (imagedef_reactor->dictionary_owner_soft);
+        dxf_string_free (imagedef_reactor->dictionary_owner_hard);
+        dxf_string_free (imagedef_reactor->associated_image_object);
         free (imagedef_reactor);
         imagedef_reactor = NULL;
 #if DEBUG
@@ -585,6 +583,8 @@ dxf_imagedef_reactor_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (imagedef_reactor == NULL)
         {
@@ -600,7 +600,13 @@ dxf_imagedef_reactor_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        imagedef_reactor->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (imagedef_reactor->dictionary_owner_soft);
+        imagedef_reactor->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -669,6 +675,8 @@ dxf_imagedef_reactor_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (imagedef_reactor == NULL)
         {
@@ -684,7 +692,13 @@ dxf_imagedef_reactor_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        imagedef_reactor->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (imagedef_reactor->dictionary_owner_hard);
+        imagedef_reactor->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -846,6 +860,8 @@ dxf_imagedef_reactor_set_associated_image_object
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (imagedef_reactor == NULL)
         {
@@ -861,7 +877,13 @@ dxf_imagedef_reactor_set_associated_image_object
                   __FUNCTION__);
                 return (NULL);
         }
-        imagedef_reactor->associated_image_object = strdup (associated_image_object);
+        copy = dxf_string_share (associated_image_object);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (imagedef_reactor->associated_image_object);
+        imagedef_reactor->associated_image_object = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
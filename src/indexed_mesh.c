@@ -0,0 +1,985 @@
+/*!
+ * \file indexed_mesh.c
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * Functions for building an indexed triangle mesh with
+ * welded vertices from DXF \c 3DFACE entities and polyface meshes.
+ *
+ * Every \c 3DFACE entity and every face record of a polyface mesh is a
+ * separate linked list node with its own corner points, the builder
+ * collects them into contiguous vertex and index arrays, so that the
+ * result can be handed to a renderer without any further conversion.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include "indexed_mesh.h"
+
+
+#define DXF_INDEXED_MESH_INITIAL_SLOTS 64
+        /*!< \brief Initial number of slots in the spatial hash. */
+
+
+static int dxf_indexed_mesh_reserve_vertices (DxfIndexedMesh *mesh, int max_number_of_vertices);
+static int dxf_indexed_mesh_reserve_triangles (DxfIndexedMesh *mesh, int max_number_of_triangles);
+static int dxf_indexed_mesh_rehash (DxfIndexedMesh *mesh, int number_of_slots);
+static void dxf_indexed_mesh_get_cell (DxfIndexedMesh *mesh, double x, double y, double z, int64_t *cell);
+static int dxf_indexed_mesh_hash_cell (DxfIndexedMesh *mesh, const int64_t *cell);
+static int dxf_indexed_mesh_get_layer (DxfIndexedMesh *mesh, char *layer);
+
+
+/*!
+ * \brief Allocate memory for a \c DxfIndexedMesh.
+ *
+ * Fill the memory contents with zeros.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfIndexedMesh *
+dxf_indexed_mesh_new ()
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfIndexedMesh *mesh = NULL;
+        size_t size;
+
+        size = sizeof (DxfIndexedMesh);
+        /* avoid malloc of 0 bytes */
+        if (size == 0) size = 1;
+        if ((mesh = malloc (size)) == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                mesh = NULL;
+        }
+        else
+        {
+                memset (mesh, 0, size);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (mesh);
+}
+
+
+/*!
+ * \brief Allocate memory and initialize data fields in a
+ * \c DxfIndexedMesh.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfIndexedMesh *
+dxf_indexed_mesh_init
+(
+        DxfIndexedMesh *mesh,
+                /*!< a pointer to the indexed mesh. */
+        double tolerance
+                /*!< weld tolerance. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (mesh == NULL)
+        {
+                fprintf (stderr,
+                  (_("Warning in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                mesh = dxf_indexed_mesh_new ();
+        }
+        if (mesh == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        mesh->tolerance = (tolerance > 0.0) ? tolerance : 0.0;
+        mesh->number_of_vertices = 0;
+        mesh->max_number_of_vertices = 0;
+        mesh->x = NULL;
+        mesh->y = NULL;
+        mesh->z = NULL;
+        mesh->number_of_triangles = 0;
+        mesh->max_number_of_triangles = 0;
+        mesh->indices = NULL;
+        mesh->edge_flags = NULL;
+        mesh->layer = NULL;
+        mesh->color = NULL;
+        mesh->number_of_layers = 0;
+        mesh->max_number_of_layers = 0;
+        mesh->layers = NULL;
+        mesh->number_of_slots = 0;
+        mesh->slots = NULL;
+        mesh->vertex_next = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (mesh);
+}
+
+
+/*!
+ * \brief Add a vertex to a \c DxfIndexedMesh, or find the vertex it
+ * welds to.
+ *
+ * \return the index of the vertex, or -1 when an error occurred.
+ */
+int
+dxf_indexed_mesh_add_vertex
+(
+        DxfIndexedMesh *mesh,
+                /*!< a pointer to the indexed mesh. */
+        double x,
+                /*!< X-coordinate of the vertex. */
+        double y,
+                /*!< Y-coordinate of the vertex. */
+        double z
+                /*!< Z-coordinate of the vertex. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        int64_t cell[3];
+        int64_t neighbour[3];
+        double tolerance2;
+        double dx;
+        double dy;
+        double dz;
+        int range;
+        int slot;
+        int i;
+        int j;
+        int k;
+        int v;
+
+        /* Do some basic checks. */
+        if (mesh == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (-1);
+        }
+        if ((mesh->slots == NULL)
+          && (dxf_indexed_mesh_rehash (mesh, DXF_INDEXED_MESH_INITIAL_SLOTS) != EXIT_SUCCESS))
+        {
+                return (-1);
+        }
+        /* A vertex within the tolerance can lie in any of the
+         * neighbouring cells, identical vertices share a cell. */
+        tolerance2 = mesh->tolerance * mesh->tolerance;
+        range = (mesh->tolerance > 0.0) ? 1 : 0;
+        dxf_indexed_mesh_get_cell (mesh, x, y, z, cell);
+        for (i = -range; i <= range; i++)
+        {
+                for (j = -range; j <= range; j++)
+                {
+                        for (k = -range; k <= range; k++)
+                        {
+                                neighbour[0] = cell[0] + i;
+                                neighbour[1] = cell[1] + j;
+                                neighbour[2] = cell[2] + k;
+                                slot = dxf_indexed_mesh_hash_cell (mesh, neighbour);
+                                for (v = mesh->slots[slot]; v >= 0; v = mesh->vertex_next[v])
+                                {
+                                        dx = mesh->x[v] - x;
+                                        dy = mesh->y[v] - y;
+                                        dz = mesh->z[v] - z;
+                                        if ((dx * dx + dy * dy + dz * dz) <= tolerance2)
+                                        {
+                                                return (v);
+                                        }
+                                }
+                        }
+                }
+        }
+        if ((mesh->number_of_vertices == mesh->max_number_of_vertices)
+          && (dxf_indexed_mesh_reserve_vertices (mesh,
+          (mesh->max_number_of_vertices > 0) ? 2 * mesh->max_number_of_vertices : 16) != EXIT_SUCCESS))
+        {
+                return (-1);
+        }
+        v = mesh->number_of_vertices;
+        mesh->x[v] = x;
+        mesh->y[v] = y;
+        mesh->z[v] = z;
+        slot = dxf_indexed_mesh_hash_cell (mesh, cell);
+        mesh->vertex_next[v] = mesh->slots[slot];
+        mesh->slots[slot] = v;
+        mesh->number_of_vertices++;
+        if (mesh->number_of_vertices > mesh->number_of_slots)
+        {
+                dxf_indexed_mesh_rehash (mesh, 2 * mesh->number_of_slots);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (v);
+}
+
+
+/*!
+ * \brief Add a face to a \c DxfIndexedMesh.
+ *
+ * Corners that coincide with the next corner are dropped, a face that
+ * is left with less than three corners is skipped.\n
+ * The remaining corners are split into a fan of triangles, the edges
+ * inside the fan are flagged invisible.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_indexed_mesh_add_face
+(
+        DxfIndexedMesh *mesh,
+                /*!< a pointer to the indexed mesh. */
+        const int *vertices,
+                /*!< array of vertex indices of the corners. */
+        int number_of_vertices,
+                /*!< number of corners, at most
+                 * \c DXF_INDEXED_MESH_MAX_FACE_VERTICES. */
+        int invisible_edges,
+                /*!< bit \c i set when the edge from corner \c i to the
+                 * next corner is invisible. */
+        char *layer,
+                /*!< layer name of the face, \c NULL for layer "0". */
+        int color
+                /*!< color of the face. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        int corners[DXF_INDEXED_MESH_MAX_FACE_VERTICES];
+        int flags;
+        int number_of_corners;
+        int layer_index;
+        int t;
+        int i;
+
+        /* Do some basic checks. */
+        if ((mesh == NULL) || (vertices == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (number_of_vertices > DXF_INDEXED_MESH_MAX_FACE_VERTICES)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () too many vertices in a face.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        flags = 0;
+        number_of_corners = 0;
+        for (i = 0; i < number_of_vertices; i++)
+        {
+                if ((vertices[i] < 0) || (vertices[i] >= mesh->number_of_vertices))
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () vertex index %d out of range.\n")),
+                          __FUNCTION__, vertices[i]);
+                        return (EXIT_FAILURE);
+                }
+                if (vertices[i] == vertices[(i + 1) % number_of_vertices])
+                {
+                        continue;
+                }
+                if (DXF_CHECK_BIT (invisible_edges, i))
+                {
+                        flags |= 1 << number_of_corners;
+                }
+                corners[number_of_corners] = vertices[i];
+                number_of_corners++;
+        }
+        if (number_of_corners < 3)
+        {
+                return (EXIT_SUCCESS);
+        }
+        if (dxf_indexed_mesh_reserve_triangles (mesh,
+          mesh->number_of_triangles + number_of_corners - 2) != EXIT_SUCCESS)
+        {
+                return (EXIT_FAILURE);
+        }
+        if ((layer_index = dxf_indexed_mesh_get_layer (mesh, layer)) < 0)
+        {
+                return (EXIT_FAILURE);
+        }
+        for (i = 1; i < number_of_corners - 1; i++)
+        {
+                t = mesh->number_of_triangles;
+                mesh->indices[3 * t] = corners[0];
+                mesh->indices[3 * t + 1] = corners[i];
+                mesh->indices[3 * t + 2] = corners[i + 1];
+                mesh->edge_flags[t] = 0;
+                if ((i > 1) || DXF_CHECK_BIT (flags, 0))
+                {
+                        mesh->edge_flags[t] |= DXF_INDEXED_MESH_FIRST_EDGE_INVISIBLE;
+                }
+                if (DXF_CHECK_BIT (flags, i))
+                {
+                        mesh->edge_flags[t] |= DXF_INDEXED_MESH_SECOND_EDGE_INVISIBLE;
+                }
+                if ((i < number_of_corners - 2) || DXF_CHECK_BIT (flags, (number_of_corners - 1)))
+                {
+                        mesh->edge_flags[t] |= DXF_INDEXED_MESH_THIRD_EDGE_INVISIBLE;
+                }
+                mesh->layer[t] = layer_index;
+                mesh->color[t] = color;
+                mesh->number_of_triangles++;
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Add a DXF \c 3DFACE entity to a \c DxfIndexedMesh.
+ *
+ * A \c 3DFACE with coinciding third and fourth corners is a triangle.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_indexed_mesh_add_3dface
+(
+        DxfIndexedMesh *mesh,
+                /*!< a pointer to the indexed mesh. */
+        Dxf3dface *face
+                /*!< a pointer to a DXF \c 3DFACE entity. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfPoint *points[4];
+        int vertices[4];
+        int status;
+        int i;
+
+        /* Do some basic checks. */
+        if ((mesh == NULL) || (face == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        points[0] = face->p0;
+        points[1] = face->p1;
+        points[2] = face->p2;
+        points[3] = (face->p3 != NULL) ? face->p3 : face->p2;
+        for (i = 0; i < 4; i++)
+        {
+                if (points[i] == NULL)
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () a corner of the 3DFACE is missing.\n")),
+                          __FUNCTION__);
+                        return (EXIT_FAILURE);
+                }
+                vertices[i] = dxf_indexed_mesh_add_vertex (mesh,
+                  points[i]->x0, points[i]->y0, points[i]->z0);
+                if (vertices[i] < 0)
+                {
+                        return (EXIT_FAILURE);
+                }
+        }
+        /* The invisible edge flags of a 3DFACE match the edge bits of
+         * a face. */
+        status = dxf_indexed_mesh_add_face (mesh, vertices, 4,
+          face->flag & 15, face->layer, face->color);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (status);
+}
+
+
+/*!
+ * \brief Add a single linked list of DXF \c 3DFACE entities to a
+ * \c DxfIndexedMesh.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_indexed_mesh_add_3dface_list
+(
+        DxfIndexedMesh *mesh,
+                /*!< a pointer to the indexed mesh. */
+        Dxf3dface *faces
+                /*!< a pointer to a single linked list of DXF
+                 * \c 3DFACE entities. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        Dxf3dface *iter = NULL;
+
+        /* Do some basic checks. */
+        if ((mesh == NULL) || (faces == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        for (iter = faces; iter != NULL; iter = (Dxf3dface *) iter->next)
+        {
+                if (dxf_indexed_mesh_add_3dface (mesh, iter) != EXIT_SUCCESS)
+                {
+                        return (EXIT_FAILURE);
+                }
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Add the faces of a polyface mesh (a DXF \c POLYLINE entity
+ * with the 64 bit set in its flags) to a \c DxfIndexedMesh.
+ *
+ * The vertices of the mesh have both the 64 and the 128 bit set in
+ * their flags, the face records only the 128 bit.\n
+ * A face record refers to the vertices by number, starting at 1, a
+ * negative number makes the edge starting at that vertex invisible.\n
+ * A face record without a layer name takes the layer of the polyline.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_indexed_mesh_add_polyface
+(
+        DxfIndexedMesh *mesh,
+                /*!< a pointer to the indexed mesh. */
+        DxfPolyline *polyline
+                /*!< a pointer to a DXF \c POLYLINE entity. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfVertex *iter = NULL;
+        int *map = NULL;
+        int numbers[DXF_INDEXED_MESH_MAX_FACE_VERTICES];
+        int vertices[DXF_INDEXED_MESH_MAX_FACE_VERTICES];
+        int number_of_mesh_vertices;
+        int number_of_vertices;
+        int invisible_edges;
+        int status;
+        int i;
+
+        /* Do some basic checks. */
+        if ((mesh == NULL) || (polyline == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (!DXF_CHECK_BIT (polyline->flag, 6))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () the POLYLINE is not a polyface mesh.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        number_of_mesh_vertices = 0;
+        for (iter = polyline->vertices; iter != NULL; iter = (DxfVertex *) iter->next)
+        {
+                if (DXF_CHECK_BIT (iter->flag, 6))
+                {
+                        number_of_mesh_vertices++;
+                }
+        }
+        if ((map = malloc ((number_of_mesh_vertices + 1) * sizeof (int))) == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        number_of_mesh_vertices = 0;
+        for (iter = polyline->vertices; iter != NULL; iter = (DxfVertex *) iter->next)
+        {
+                if (!DXF_CHECK_BIT (iter->flag, 6) || (iter->p0 == NULL))
+                {
+                        continue;
+                }
+                map[number_of_mesh_vertices] = dxf_indexed_mesh_add_vertex (mesh,
+                  iter->p0->x0, iter->p0->y0, iter->p0->z0);
+                if (map[number_of_mesh_vertices] < 0)
+                {
+                        free (map);
+                        return (EXIT_FAILURE);
+                }
+                number_of_mesh_vertices++;
+        }
+        status = EXIT_SUCCESS;
+        for (iter = polyline->vertices; iter != NULL; iter = (DxfVertex *) iter->next)
+        {
+                if (DXF_CHECK_BIT (iter->flag, 6) || !DXF_CHECK_BIT (iter->flag, 7))
+                {
+                        continue;
+                }
+                numbers[0] = iter->polyface_mesh_vertex_index_1;
+                numbers[1] = iter->polyface_mesh_vertex_index_2;
+                numbers[2] = iter->polyface_mesh_vertex_index_3;
+                numbers[3] = iter->polyface_mesh_vertex_index_4;
+                number_of_vertices = 0;
+                invisible_edges = 0;
+                for (i = 0; (i < DXF_INDEXED_MESH_MAX_FACE_VERTICES) && (numbers[i] != 0); i++)
+                {
+                        if (abs (numbers[i]) > number_of_mesh_vertices)
+                        {
+                                fprintf (stderr,
+                                  (_("Error in %s () vertex number %d out of range.\n")),
+                                  __FUNCTION__, numbers[i]);
+                                status = EXIT_FAILURE;
+                                break;
+                        }
+                        if (numbers[i] < 0)
+                        {
+                                invisible_edges |= 1 << i;
+                        }
+                        vertices[i] = map[abs (numbers[i]) - 1];
+                        number_of_vertices++;
+                }
+                if (status != EXIT_SUCCESS)
+                {
+                        break;
+                }
+                status = dxf_indexed_mesh_add_face (mesh, vertices,
+                  number_of_vertices, invisible_edges,
+                  ((iter->layer != NULL) && (iter->layer[0] != '\0'))
+                  ? iter->layer : polyline->layer, iter->color);
+                if (status != EXIT_SUCCESS)
+                {
+                        break;
+                }
+        }
+        free (map);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (status);
+}
+
+
+/*!
+ * \brief Clear the contents of a \c DxfIndexedMesh, the indexed mesh
+ * itself is not freed.
+ *
+ * The weld tolerance is kept.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_indexed_mesh_clear
+(
+        DxfIndexedMesh *mesh
+                /*!< a pointer to the indexed mesh. */
+)
+{
+        int i;
+
+        /* Do some basic checks. */
+        if (mesh == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        free (mesh->x);
+        free (mesh->y);
+        free (mesh->z);
+        free (mesh->indices);
+        free (mesh->edge_flags);
+        free (mesh->layer);
+        free (mesh->color);
+        for (i = 0; i < mesh->number_of_layers; i++)
+        {
+                free (mesh->layers[i]);
+        }
+        free (mesh->layers);
+        free (mesh->slots);
+        free (mesh->vertex_next);
+        dxf_indexed_mesh_init (mesh, mesh->tolerance);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Free the allocated memory for a \c DxfIndexedMesh and all
+ * it's data fields.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_indexed_mesh_free
+(
+        DxfIndexedMesh *mesh
+                /*!< a pointer to the indexed mesh. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (mesh == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_indexed_mesh_clear (mesh);
+        free (mesh);
+        mesh = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Grow the vertex arrays of a \c DxfIndexedMesh.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_indexed_mesh_reserve_vertices
+(
+        DxfIndexedMesh *mesh,
+                /*!< a pointer to the indexed mesh. */
+        int max_number_of_vertices
+                /*!< number of vertices that should fit. */
+)
+{
+        double *x = NULL;
+        double *y = NULL;
+        double *z = NULL;
+        int *vertex_next = NULL;
+
+        if (max_number_of_vertices <= mesh->max_number_of_vertices)
+        {
+                return (EXIT_SUCCESS);
+        }
+        x = realloc (mesh->x, max_number_of_vertices * sizeof (double));
+        if (x != NULL)
+        {
+                mesh->x = x;
+        }
+        y = realloc (mesh->y, max_number_of_vertices * sizeof (double));
+        if (y != NULL)
+        {
+                mesh->y = y;
+        }
+        z = realloc (mesh->z, max_number_of_vertices * sizeof (double));
+        if (z != NULL)
+        {
+                mesh->z = z;
+        }
+        vertex_next = realloc (mesh->vertex_next, max_number_of_vertices * sizeof (int));
+        if (vertex_next != NULL)
+        {
+                mesh->vertex_next = vertex_next;
+        }
+        if ((x == NULL) || (y == NULL) || (z == NULL) || (vertex_next == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        mesh->max_number_of_vertices = max_number_of_vertices;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Grow the triangle arrays of a \c DxfIndexedMesh.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_indexed_mesh_reserve_triangles
+(
+        DxfIndexedMesh *mesh,
+                /*!< a pointer to the indexed mesh. */
+        int max_number_of_triangles
+                /*!< number of triangles that should fit. */
+)
+{
+        int *indices = NULL;
+        int *edge_flags = NULL;
+        int *layer = NULL;
+        int *color = NULL;
+        int size;
+
+        if (max_number_of_triangles <= mesh->max_number_of_triangles)
+        {
+                return (EXIT_SUCCESS);
+        }
+        size = (mesh->max_number_of_triangles > 0) ? mesh->max_number_of_triangles : 16;
+        while (size < max_number_of_triangles)
+        {
+                size *= 2;
+        }
+        indices = realloc (mesh->indices, 3 * size * sizeof (int));
+        if (indices != NULL)
+        {
+                mesh->indices = indices;
+        }
+        edge_flags = realloc (mesh->edge_flags, size * sizeof (int));
+        if (edge_flags != NULL)
+        {
+                mesh->edge_flags = edge_flags;
+        }
+        layer = realloc (mesh->layer, size * sizeof (int));
+        if (layer != NULL)
+        {
+                mesh->layer = layer;
+        }
+        color = realloc (mesh->color, size * sizeof (int));
+        if (color != NULL)
+        {
+                mesh->color = color;
+        }
+        if ((indices == NULL) || (edge_flags == NULL) || (layer == NULL) || (color == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        mesh->max_number_of_triangles = size;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Resize the spatial hash of a \c DxfIndexedMesh and insert all
+ * vertices again.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_indexed_mesh_rehash
+(
+        DxfIndexedMesh *mesh,
+                /*!< a pointer to the indexed mesh. */
+        int number_of_slots
+                /*!< new number of slots, a power of two. */
+)
+{
+        int64_t cell[3];
+        int *slots = NULL;
+        int slot;
+        int i;
+
+        if ((slots = malloc (number_of_slots * sizeof (int))) == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        for (i = 0; i < number_of_slots; i++)
+        {
+                slots[i] = -1;
+        }
+        free (mesh->slots);
+        mesh->slots = slots;
+        mesh->number_of_slots = number_of_slots;
+        for (i = 0; i < mesh->number_of_vertices; i++)
+        {
+                dxf_indexed_mesh_get_cell (mesh, mesh->x[i], mesh->y[i], mesh->z[i], cell);
+                slot = dxf_indexed_mesh_hash_cell (mesh, cell);
+                mesh->vertex_next[i] = mesh->slots[slot];
+                mesh->slots[slot] = i;
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Compute the spatial hash cell of a vertex.
+ *
+ * Without a weld tolerance the cell is the bit pattern of the
+ * coordinates, so that only identical vertices share a cell.
+ */
+static void
+dxf_indexed_mesh_get_cell
+(
+        DxfIndexedMesh *mesh,
+                /*!< a pointer to the indexed mesh. */
+        double x,
+                /*!< X-coordinate of the vertex. */
+        double y,
+                /*!< Y-coordinate of the vertex. */
+        double z,
+                /*!< Z-coordinate of the vertex. */
+        int64_t *cell
+                /*!< array of three cell coordinates receiving the
+                 * result. */
+)
+{
+        if (mesh->tolerance > 0.0)
+        {
+                cell[0] = (int64_t) floor (x / mesh->tolerance);
+                cell[1] = (int64_t) floor (y / mesh->tolerance);
+                cell[2] = (int64_t) floor (z / mesh->tolerance);
+        }
+        else
+        {
+                /* Adding 0.0 turns -0.0 into 0.0. */
+                x += 0.0;
+                y += 0.0;
+                z += 0.0;
+                memcpy (&cell[0], &x, sizeof (int64_t));
+                memcpy (&cell[1], &y, sizeof (int64_t));
+                memcpy (&cell[2], &z, sizeof (int64_t));
+        }
+}
+
+
+/*!
+ * \brief Compute the slot of a spatial hash cell.
+ *
+ * \return the slot number.
+ */
+static int
+dxf_indexed_mesh_hash_cell
+(
+        DxfIndexedMesh *mesh,
+                /*!< a pointer to the indexed mesh. */
+        const int64_t *cell
+                /*!< array of three cell coordinates. */
+)
+{
+        uint64_t hash;
+
+        hash = ((uint64_t) cell[0] * 73856093u)
+          ^ ((uint64_t) cell[1] * 19349663u)
+          ^ ((uint64_t) cell[2] * 83492791u);
+        hash ^= hash >> 29;
+        return ((int) (hash & (uint64_t) (mesh->number_of_slots - 1)));
+}
+
+
+/*!
+ * \brief Find or add a layer name in a \c DxfIndexedMesh.
+ *
+ * Faces usually arrive grouped by layer, so the last layer is tried
+ * first.
+ *
+ * \return the index of the layer name, or -1 when an error occurred.
+ */
+static int
+dxf_indexed_mesh_get_layer
+(
+        DxfIndexedMesh *mesh,
+                /*!< a pointer to the indexed mesh. */
+        char *layer
+                /*!< layer name, \c NULL for layer "0". */
+)
+{
+        char **layers = NULL;
+        int size;
+        int i;
+
+        if ((layer == NULL) || (layer[0] == '\0'))
+        {
+                layer = DXF_DEFAULT_LAYER;
+        }
+        if ((mesh->number_of_triangles > 0)
+          && (strcasecmp (mesh->layers[mesh->layer[mesh->number_of_triangles - 1]], layer) == 0))
+        {
+                return (mesh->layer[mesh->number_of_triangles - 1]);
+        }
+        for (i = 0; i < mesh->number_of_layers; i++)
+        {
+                if (strcasecmp (mesh->layers[i], layer) == 0)
+                {
+                        return (i);
+                }
+        }
+        if (mesh->number_of_layers == mesh->max_number_of_layers)
+        {
+                size = (mesh->max_number_of_layers > 0) ? 2 * mesh->max_number_of_layers : 4;
+                if ((layers = realloc (mesh->layers, size * sizeof (char *))) == NULL)
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () could not allocate memory.\n")),
+                          __FUNCTION__);
+                        return (-1);
+                }
+                mesh->layers = layers;
+                mesh->max_number_of_layers = size;
+        }
+        if ((mesh->layers[mesh->number_of_layers] = strdup (layer)) == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (-1);
+        }
+        mesh->number_of_layers++;
+        return (mesh->number_of_layers - 1);
+}
+
+
+/* EOF */
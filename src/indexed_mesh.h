@@ -0,0 +1,143 @@
+/*!
+ * \file indexed_mesh.h
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * Header file for building an indexed triangle mesh with
+ * welded vertices from DXF \c 3DFACE entities and polyface meshes.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#ifndef LIBDXF_SRC_INDEXED_MESH_H
+#define LIBDXF_SRC_INDEXED_MESH_H
+
+
+#include "global.h"
+#include "3dface.h"
+#include "polyline.h"
+#include "vertex.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define DXF_INDEXED_MESH_FIRST_EDGE_INVISIBLE 1
+        /*!< \brief The edge from the first to the second corner of a
+         * triangle is invisible. */
+
+#define DXF_INDEXED_MESH_SECOND_EDGE_INVISIBLE 2
+        /*!< \brief The edge from the second to the third corner of a
+         * triangle is invisible. */
+
+#define DXF_INDEXED_MESH_THIRD_EDGE_INVISIBLE 4
+        /*!< \brief The edge from the third to the first corner of a
+         * triangle is invisible. */
+
+#define DXF_INDEXED_MESH_MAX_FACE_VERTICES 4
+        /*!< \brief The maximum number of vertices of a face. */
+
+
+/*!
+ * \brief Definition of an indexed triangle mesh.
+ *
+ * The vertices and the triangles are stored in contiguous arrays.\n
+ * Vertices closer than the weld tolerance are merged into a single
+ * vertex, found through a spatial hash with a cell size equal to the
+ * tolerance.\n
+ * Faces with four corners are split into two triangles, the edge
+ * along the split is flagged invisible.
+ */
+typedef struct
+dxf_indexed_mesh_struct
+{
+        double tolerance;
+                /*!< Weld tolerance, vertices closer than this distance
+                 * are merged, \c 0.0 merges identical vertices only. */
+        int number_of_vertices;
+                /*!< Number of vertices. */
+        int max_number_of_vertices;
+                /*!< Number of vertices that fit in the arrays. */
+        double *x;
+                /*!< Array of X-coordinates of the vertices. */
+        double *y;
+                /*!< Array of Y-coordinates of the vertices. */
+        double *z;
+                /*!< Array of Z-coordinates of the vertices. */
+        int number_of_triangles;
+                /*!< Number of triangles. */
+        int max_number_of_triangles;
+                /*!< Number of triangles that fit in the arrays. */
+        int *indices;
+                /*!< Array of three vertex indices per triangle. */
+        int *edge_flags;
+                /*!< Array of invisible edge flags per triangle, a
+                 * combination of \c DXF_INDEXED_MESH_*_EDGE_INVISIBLE. */
+        int *layer;
+                /*!< Array of indices in \c layers per triangle. */
+        int *color;
+                /*!< Array of colors per triangle. */
+        int number_of_layers;
+                /*!< Number of distinct layer names. */
+        int max_number_of_layers;
+                /*!< Number of layer names that fit in the array. */
+        char **layers;
+                /*!< Array of distinct layer names. */
+        int number_of_slots;
+                /*!< Number of slots in the spatial hash, a power of
+                 * two. */
+        int *slots;
+                /*!< First vertex in each slot of the spatial hash, -1
+                 * when empty. */
+        int *vertex_next;
+                /*!< Next vertex in the same slot of the spatial hash, -1
+                 * when last. */
+} DxfIndexedMesh;
+
+
+DxfIndexedMesh *dxf_indexed_mesh_new ();
+DxfIndexedMesh *dxf_indexed_mesh_init (DxfIndexedMesh *mesh, double tolerance);
+int dxf_indexed_mesh_add_vertex (DxfIndexedMesh *mesh, double x, double y, double z);
+int dxf_indexed_mesh_add_face (DxfIndexedMesh *mesh, const int *vertices, int number_of_vertices, int invisible_edges, char *layer, int color);
+int dxf_indexed_mesh_add_3dface (DxfIndexedMesh *mesh, Dxf3dface *face);
+int dxf_indexed_mesh_add_3dface_list (DxfIndexedMesh *mesh, Dxf3dface *faces);
+int dxf_indexed_mesh_add_polyface (DxfIndexedMesh *mesh, DxfPolyline *polyline);
+int dxf_indexed_mesh_clear (DxfIndexedMesh *mesh);
+int dxf_indexed_mesh_free (DxfIndexedMesh *mesh);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* LIBDXF_SRC_INDEXED_MESH_H */
+
+
+/* EOF */
@@ -45,6 +45,8 @@
 
 
 #include "insert.h"
+#include "stats.h"
+#include "util.h"
 
 
 /*!
@@ -74,6 +76,7 @@ dxf_insert_new ()
         else
         {
                 memset (insert, 0, size);
+                dxf_stats_count_allocation (INSERT, size);
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -114,8 +117,8 @@ dxf_insert_init
               return (NULL);
         }
         dxf_insert_set_id_code (insert, 0);
-        dxf_insert_set_linetype (insert, strdup (DXF_DEFAULT_LINETYPE));
-        dxf_insert_set_layer (insert, strdup (DXF_DEFAULT_LAYER));
+        insert->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        insert->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         dxf_insert_set_elevation (insert, 0.0);
         dxf_insert_set_thickness (insert, 0.0);
         dxf_insert_set_linetype_scale (insert, DXF_DEFAULT_LINETYPE_SCALE);
@@ -124,17 +127,16 @@ dxf_insert_init
         dxf_insert_set_paperspace (insert, DXF_MODELSPACE);
         dxf_insert_set_graphics_data_size (insert, 0);
         dxf_insert_set_shadow_mode (insert, 0);
-        dxf_insert_set_binary_graphics_data (insert, (DxfBinaryGraphicsData *) dxf_binary_graphics_data_new ());
-        dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) dxf_insert_get_binary_graphics_data (insert));
-        dxf_insert_set_dictionary_owner_soft (insert, strdup (""));
-        dxf_insert_set_material (insert, strdup (""));
-        dxf_insert_set_dictionary_owner_hard (insert, strdup (""));
+        insert->binary_graphics_data = NULL;
+        insert->dictionary_owner_soft = dxf_string_share ("");
+        insert->material = dxf_string_share ("");
+        insert->dictionary_owner_hard = dxf_string_share ("");
         dxf_insert_set_lineweight (insert, 0.0);
-        dxf_insert_set_plot_style_name (insert, strdup (""));
+        insert->plot_style_name = dxf_string_share ("");
         dxf_insert_set_color_value (insert, 0);
-        dxf_insert_set_color_name (insert, strdup (""));
+        insert->color_name = dxf_string_share ("");
         dxf_insert_set_transparency (insert, 0);
-        dxf_insert_set_block_name (insert, strdup (""));
+        insert->block_name = dxf_string_share ("");
         dxf_insert_set_p0 (insert, dxf_point_new ());
         dxf_point_init ((DxfPoint *) dxf_insert_get_p0 (insert));
         dxf_insert_set_x0 (insert, 0.0);
@@ -221,8 +223,7 @@ dxf_insert_read
                 {
                         /* Now follows a string containing a block name
                          * value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", insert->block_name);
+                        dxf_read_string (fp, &insert->block_name);
                 }
                 else if (strcmp (temp_string, "5") == 0)
                 {
@@ -235,14 +236,12 @@ dxf_insert_read
                 {
                         /* Now follows a string containing a linetype
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", insert->linetype);
+                        dxf_read_string (fp, &insert->linetype);
                 }
                 else if (strcmp (temp_string, "8") == 0)
                 {
                         /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", insert->layer);
+                        dxf_read_string (fp, &insert->layer);
                 }
                 else if (strcmp (temp_string, "10") == 0)
                 {
@@ -417,15 +416,13 @@ dxf_insert_read
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", insert->dictionary_owner_soft);
+                        dxf_read_string (fp, &insert->dictionary_owner_soft);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", insert->dictionary_owner_hard);
+                        dxf_read_string (fp, &insert->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "999") == 0)
                 {
@@ -734,15 +731,22 @@ dxf_insert_free
                 __FUNCTION__);
               return (EXIT_FAILURE);
         }
-        free (dxf_insert_get_linetype (insert));
-        free (dxf_insert_get_layer (insert));
-        dxf_binary_graphics_data_free_list (dxf_insert_get_binary_graphics_data (insert));
-        free (dxf_insert_get_dictionary_owner_soft (insert));
-        free (dxf_insert_get_material (insert));
-        free (dxf_insert_get_dictionary_owner_hard (insert));
-        free (dxf_insert_get_plot_style_name (insert));
-        free (dxf_insert_get_color_name (insert));
-        free (dxf_insert_get_block_name (insert));
+        dxf_string_free (insert->linetype);
+        dxf_string_free (insert->layer);
+        if (insert->binary_graphics_data != NULL)
+        {
+                dxf_binary_graphics_data_free_list (insert->binary_graphics_data);
+        }
+        dxf_string_free (insert->dictionary_owner_soft);
+        dxf_string_free (insert->material);
+        dxf_string_free (insert->dictionary_owner_hard);
+        dxf_string_free (insert->plot_style_name);
+        dxf_string_free (insert->color_name);
+        dxf_string_free (insert->block_name);
+        if (insert->p0 != NULL)
+        {
+                dxf_point_free (insert->p0);
+        }
         free (insert);
         insert = NULL;
 #if DEBUG
@@ -914,6 +918,8 @@ dxf_insert_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (insert == NULL)
         {
@@ -929,7 +935,13 @@ dxf_insert_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        insert->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (insert->linetype);
+        insert->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -989,6 +1001,8 @@ dxf_insert_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (insert == NULL)
         {
@@ -1004,7 +1018,13 @@ dxf_insert_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        insert->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (insert->layer);
+        insert->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1797,6 +1817,8 @@ dxf_insert_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (insert == NULL)
         {
@@ -1812,7 +1834,13 @@ dxf_insert_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        insert->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (insert->dictionary_owner_soft);
+        insert->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1879,6 +1907,8 @@ dxf_insert_set_material
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (insert == NULL)
         {
@@ -1894,7 +1924,13 @@ dxf_insert_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        insert->material = strdup (material);
+        copy = dxf_string_share (material);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (insert->material);
+        insert->material = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1959,6 +1995,8 @@ dxf_insert_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (insert == NULL)
         {
@@ -1974,7 +2012,13 @@ dxf_insert_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        insert->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (insert->dictionary_owner_hard);
+        insert->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2104,6 +2148,8 @@ dxf_insert_set_plot_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (insert == NULL)
         {
@@ -2119,7 +2165,13 @@ dxf_insert_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        insert->plot_style_name = strdup (plot_style_name);
+        copy = dxf_string_share (plot_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (insert->plot_style_name);
+        insert->plot_style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2249,6 +2301,8 @@ dxf_insert_set_color_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (insert == NULL)
         {
@@ -2264,7 +2318,13 @@ dxf_insert_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        insert->color_name = strdup (color_name);
+        copy = dxf_string_share (color_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (insert->color_name);
+        insert->color_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2394,6 +2454,8 @@ dxf_insert_set_block_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (insert == NULL)
         {
@@ -2409,7 +2471,13 @@ dxf_insert_set_block_name
                   __FUNCTION__);
                 return (NULL);
         }
-        insert->block_name = strdup (block_name);
+        copy = dxf_string_share (block_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (insert->block_name);
+        insert->block_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -44,6 +44,7 @@
 
 
 #include "layer.h"
+#include "util.h"
 
 
 /*!
@@ -117,16 +118,16 @@ dxf_layer_init
               return (NULL);
         }
         dxf_layer_set_id_code (layer, 0);
-        dxf_layer_set_layer_name (layer, strdup (""));
-        dxf_layer_set_linetype (layer, strdup (DXF_DEFAULT_LINETYPE));
+        layer->layer_name = dxf_string_share ("");
+        layer->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         dxf_layer_set_color (layer, DXF_COLOR_BYLAYER);
         dxf_layer_set_flag (layer, 0);
         dxf_layer_set_plotting_flag (layer, 0);
-        dxf_layer_set_dictionary_owner_soft (layer, strdup (""));
-        dxf_layer_set_material (layer, strdup (""));
-        dxf_layer_set_dictionary_owner_hard (layer, strdup (""));
+        layer->dictionary_owner_soft = dxf_string_share ("");
+        layer->material = dxf_string_share ("");
+        layer->dictionary_owner_hard = dxf_string_share ("");
         dxf_layer_set_lineweight (layer, 0);
-        dxf_layer_set_plot_style_name (layer, strdup (""));
+        layer->plot_style_name = dxf_string_share ("");
         dxf_layer_set_next (layer, NULL);
 #if DEBUG
         DXF_DEBUG_END
@@ -196,15 +197,13 @@ dxf_layer_read
                 {
                         /* Now follows a string containing the layer
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", layer->layer_name);
+                        dxf_read_string (fp, &layer->layer_name);
                 }
                 else if (strcmp (temp_string, "6") == 0)
                 {
                         /* Now follows a string containing the linetype
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", layer->linetype);
+                        dxf_read_string (fp, &layer->linetype);
                 }
                 else if (strcmp (temp_string, "62") == 0)
                 {
@@ -246,21 +245,18 @@ dxf_layer_read
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", layer->dictionary_owner_soft);
+                        dxf_read_string (fp, &layer->dictionary_owner_soft);
                 }
                 else if (strcmp (temp_string, "347") == 0)
                 {
                         /* Now follows a string containing the material. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", layer->material);
+                        dxf_read_string (fp, &layer->material);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", layer->dictionary_owner_hard);
+                        dxf_read_string (fp, &layer->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "370") == 0)
                 {
@@ -273,8 +269,7 @@ dxf_layer_read
                 {
                         /* Now follows a string containing the plot style
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", layer->plot_style_name);
+                        dxf_read_string (fp, &layer->plot_style_name);
                 }
                 else if (strcmp (temp_string, "999") == 0)
                 {
@@ -302,7 +297,8 @@ dxf_layer_read
         }
         if (strcmp (layer->linetype, "") == 0)
         {
-                layer->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (layer->linetype);
+                layer->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         /* Clean up. */
         free (temp_string);
@@ -458,12 +454,12 @@ dxf_layer_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (dxf_layer_get_layer_name (layer));
-        free (dxf_layer_get_linetype (layer));
-        free (dxf_layer_get_dictionary_owner_soft (layer));
-        free (dxf_layer_get_material (layer));
-        free (dxf_layer_get_dictionary_owner_hard (layer));
-        free (dxf_layer_get_plot_style_name (layer));
+        dxf_string_free (layer->layer_name);
+        dxf_string_free (layer->linetype);
+        dxf_string_free (layer->dictionary_owner_soft);
+        dxf_string_free (layer->material);
+        dxf_string_free (layer->dictionary_owner_hard);
+        dxf_string_free (layer->plot_style_name);
         free (layer);
         layer = NULL;
 #if DEBUG
@@ -636,6 +632,8 @@ dxf_layer_set_layer_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (layer == NULL)
         {
@@ -651,7 +649,13 @@ dxf_layer_set_layer_name
                   __FUNCTION__);
                 return (NULL);
         }
-        layer->layer_name = strdup (layer_name);
+        copy = dxf_string_share (layer_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (layer->layer_name);
+        layer->layer_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -711,6 +715,8 @@ dxf_layer_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (layer == NULL)
         {
@@ -726,7 +732,13 @@ dxf_layer_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        layer->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (layer->linetype);
+        layer->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1225,6 +1237,8 @@ dxf_layer_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (layer == NULL)
         {
@@ -1240,7 +1254,13 @@ dxf_layer_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        layer->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (layer->dictionary_owner_soft);
+        layer->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1307,6 +1327,8 @@ dxf_layer_set_material
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (layer == NULL)
         {
@@ -1322,7 +1344,13 @@ dxf_layer_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        layer->material = strdup (material);
+        copy = dxf_string_share (material);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (layer->material);
+        layer->material = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1387,6 +1415,8 @@ dxf_layer_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (layer == NULL)
         {
@@ -1402,7 +1432,13 @@ dxf_layer_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        layer->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (layer->dictionary_owner_hard);
+        layer->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1532,6 +1568,8 @@ dxf_layer_set_plot_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (layer == NULL)
         {
@@ -1547,7 +1585,13 @@ dxf_layer_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        layer->plot_style_name = strdup (plot_style_name);
+        copy = dxf_string_share (plot_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (layer->plot_style_name);
+        layer->plot_style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
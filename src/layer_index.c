@@ -61,6 +61,7 @@
 
 
 #include "layer_index.h"
+#include "util.h"
 
 
 /*!
@@ -133,8 +134,8 @@ dxf_layer_index_init
                 return (NULL);
         }
         layer_index->id_code = 0;
-        layer_index->dictionary_owner_soft = strdup ("");
-        layer_index->dictionary_owner_hard = strdup ("");
+        layer_index->dictionary_owner_soft = dxf_string_share ("");
+        layer_index->dictionary_owner_hard = dxf_string_share ("");
         layer_index->time_stamp = 0;
         layer_index->layer_name = (DxfLayerName *) dxf_layer_name_new ();
         layer_index->layer_name = (DxfLayerName *) dxf_layer_name_init (layer_index->layer_name);
@@ -277,16 +278,14 @@ dxf_layer_index_read
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", layer_index->dictionary_owner_soft);
+                        dxf_read_string (fp, &layer_index->dictionary_owner_soft);
                 }
                 else if ((strcmp (temp_string, "360") == 0)
                   && (k == 0))
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", layer_index->dictionary_owner_hard);
+                        dxf_read_string (fp, &layer_index->dictionary_owner_hard);
                         k++;
                 }
                 else if ((strcmp (temp_string, "360") == 0)
@@ -465,8 +464,8 @@ dxf_layer_index_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (layer_index->dictionary_owner_soft);
-        free (layer_index->dictionary_owner_hard);
+        dxf_string_free (layer_index->dictionary_owner_soft);
+        dxf_string_free (layer_index->dictionary_owner_hard);
         dxf_layer_name_free_list (layer_index->layer_name);
         for (i = 0; i < DXF_MAX_PARAM; i++)
         {
@@ -648,6 +647,8 @@ dxf_layer_index_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (layer_index == NULL)
         {
@@ -663,7 +664,13 @@ dxf_layer_index_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        layer_index->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (layer_index->dictionary_owner_soft);
+        layer_index->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -728,6 +735,8 @@ dxf_layer_index_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (layer_index == NULL)
         {
@@ -743,7 +752,13 @@ dxf_layer_index_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        layer_index->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (layer_index->dictionary_owner_hard);
+        layer_index->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
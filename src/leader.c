@@ -42,6 +42,8 @@
 
 
 #include "leader.h"
+#include "stats.h"
+#include "util.h"
 
 
 /*!
@@ -74,6 +76,7 @@ dxf_leader_new ()
         else
         {
                 memset (leader, 0, size);
+                dxf_stats_count_allocation (LEADER, size);
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -115,17 +118,17 @@ dxf_leader_init
                 return (NULL);
         }
         leader->id_code = 0;
-        leader->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        leader->layer = strdup (DXF_DEFAULT_LAYER);
+        leader->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        leader->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         leader->elevation = 0.0;
         leader->thickness = 0.0;
         leader->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
         leader->visibility = DXF_DEFAULT_VISIBILITY;
         leader->color = DXF_COLOR_BYLAYER;
         leader->paperspace = DXF_MODELSPACE;
-        leader->dictionary_owner_soft = strdup ("");
-        leader->dictionary_owner_hard = strdup ("");
-        leader->dimension_style_name = strdup ("");
+        leader->dictionary_owner_soft = dxf_string_share ("");
+        leader->dictionary_owner_hard = dxf_string_share ("");
+        leader->dimension_style_name = dxf_string_share ("");
         leader->p0 = dxf_point_new ();
         leader->p0->x0 = 0.0;
         leader->p0->y0 = 0.0;
@@ -154,7 +157,7 @@ dxf_leader_init
         leader->p3->x0 = 0.0;
         leader->p3->y0 = 0.0;
         leader->p3->z0 = 0.0;
-        leader->annotation_reference_hard = strdup ("");
+        leader->annotation_reference_hard = dxf_string_share ("");
         leader->next = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -234,8 +237,7 @@ dxf_leader_read
                 {
                         /* Now follows a string containing additional
                          * proprietary data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", leader->dimension_style_name);
+                        dxf_read_string (fp, &leader->dimension_style_name);
                 }
                 if (strcmp (temp_string, "5") == 0)
                 {
@@ -248,14 +250,12 @@ dxf_leader_read
                 {
                         /* Now follows a string containing a linetype
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", leader->linetype);
+                        dxf_read_string (fp, &leader->linetype);
                 }
                 else if (strcmp (temp_string, "8") == 0)
                 {
                         /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", leader->layer);
+                        dxf_read_string (fp, &leader->layer);
                 }
                 else if ((strcmp (temp_string, "10") == 0)
                   || (strcmp (temp_string, "20") == 0)
@@ -509,23 +509,20 @@ dxf_leader_read
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", leader->dictionary_owner_soft);
+                        dxf_read_string (fp, &leader->dictionary_owner_soft);
                 }
                 else if (strcmp (temp_string, "340") == 0)
                 {
                         /* Now follows a string containing Hard
                          * reference to associated annotation (mtext,
                          * tolerance, or insert entity). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", leader->annotation_reference_hard);
+                        dxf_read_string (fp, &leader->annotation_reference_hard);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", leader->dictionary_owner_hard);
+                        dxf_read_string (fp, &leader->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "999") == 0)
                 {
@@ -550,11 +547,13 @@ dxf_leader_read
         /* Handle omitted members and/or illegal values. */
         if (strcmp (leader->linetype, "") == 0)
         {
-                leader->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (leader->linetype);
+                leader->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (leader->layer, "") == 0)
         {
-                leader->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (leader->layer);
+                leader->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Clean up. */
         free (temp_string);
@@ -629,7 +628,8 @@ dxf_leader_write
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                leader->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (leader->linetype);
+                leader->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (leader->layer, "") == 0)
         {
@@ -639,7 +639,8 @@ dxf_leader_write
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0")),
                   dxf_entity_name);
-                leader->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (leader->layer);
+                leader->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Start writing output. */
         fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
@@ -794,12 +795,28 @@ dxf_leader_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (leader->linetype);
-        free (leader->layer);
-        free (leader->dictionary_owner_soft);
-        free (leader->dictionary_owner_hard);
-        free (leader->dimension_style_name);
-        free (leader->annotation_reference_hard);
+        dxf_string_free (leader->linetype);
+        dxf_string_free (leader->layer);
+        dxf_string_free (leader->dictionary_owner_soft);
+        dxf_string_free (leader->dictionary_owner_hard);
+        dxf_string_free (leader->dimension_style_name);
+        dxf_string_free (leader->annotation_reference_hard);
+        if (leader->p0 != NULL)
+        {
+                dxf_point_free_list (leader->p0);
+        }
+        if (leader->p1 != NULL)
+        {
+                dxf_point_free (leader->p1);
+        }
+        if (leader->p2 != NULL)
+        {
+                dxf_point_free (leader->p2);
+        }
+        if (leader->p3 != NULL)
+        {
+                dxf_point_free (leader->p3);
+        }
         free (leader);
         leader = NULL;
 #if DEBUG
@@ -971,6 +988,8 @@ dxf_leader_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (leader == NULL)
         {
@@ -986,7 +1005,13 @@ dxf_leader_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        leader->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (leader->linetype);
+        leader->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1046,6 +1071,8 @@ dxf_leader_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (leader == NULL)
         {
@@ -1061,7 +1088,13 @@ dxf_leader_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        leader->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (leader->layer);
+        leader->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1586,6 +1619,8 @@ dxf_leader_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (leader == NULL)
         {
@@ -1601,7 +1636,13 @@ dxf_leader_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        leader->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (leader->dictionary_owner_soft);
+        leader->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1666,6 +1707,8 @@ dxf_leader_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (leader == NULL)
         {
@@ -1681,7 +1724,13 @@ dxf_leader_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        leader->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (leader->dictionary_owner_hard);
+        leader->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1743,6 +1792,8 @@ dxf_leader_set_dimension_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (leader == NULL)
         {
@@ -1758,7 +1809,13 @@ dxf_leader_set_dimension_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        leader->layer = strdup (dimension_style_name);
+        copy = dxf_string_share (dimension_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (leader->layer);
+        leader->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -4086,6 +4143,8 @@ dxf_leader_set_annotation_reference_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (leader == NULL)
         {
@@ -4101,7 +4160,13 @@ dxf_leader_set_annotation_reference_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        leader->annotation_reference_hard = strdup (annotation_reference_hard);
+        copy = dxf_string_share (annotation_reference_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (leader->annotation_reference_hard);
+        leader->annotation_reference_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
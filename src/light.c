@@ -35,6 +35,8 @@
 
 
 #include "light.h"
+#include "stats.h"
+#include "util.h"
 
 
 /*!
@@ -67,6 +69,7 @@ dxf_light_new ()
         else
         {
                 memset (light, 0, size);
+                dxf_stats_count_allocation (LIGHT, size);
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -108,8 +111,8 @@ dxf_light_init
               return (NULL);
         }
         light->id_code = 0;
-        light->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        light->layer = strdup (DXF_DEFAULT_LAYER);
+        light->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        light->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         light->thickness = 0.0;
         light->linetype_scale = 0.0;
         light->visibility = 0;
@@ -117,16 +120,16 @@ dxf_light_init
         light->paperspace = DXF_MODELSPACE;
         light->graphics_data_size = 0;
         light->shadow_mode = 0;
-        light->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_init (light->binary_graphics_data);
-        light->dictionary_owner_hard = strdup ("");
-        light->material = strdup ("");
-        light->dictionary_owner_soft = strdup ("");
+        light->binary_graphics_data = NULL;
+        light->dictionary_owner_hard = dxf_string_share ("");
+        light->material = dxf_string_share ("");
+        light->dictionary_owner_soft = dxf_string_share ("");
         light->lineweight = 0;
-        light->plot_style_name = strdup ("");
+        light->plot_style_name = dxf_string_share ("");
         light->color_value = 0;
-        light->color_name = strdup ("");
+        light->color_name = dxf_string_share ("");
         light->transparency = 0;
-        light->light_name = strdup ("");
+        light->light_name = dxf_string_share ("");
         light->p0 = dxf_point_init (light->p0);
         light->p1 = dxf_point_init (light->p1);
         light->intensity = 0.0;
@@ -223,14 +226,12 @@ dxf_light_read
                 {
                         /* Now follows a string containing a linetype
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", light->linetype);
+                        dxf_read_string (fp, &light->linetype);
                 }
                 else if (strcmp (temp_string, "8") == 0)
                 {
                         /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", light->layer);
+                        dxf_read_string (fp, &light->layer);
                 }
                 else if (strcmp (temp_string, "10") == 0)
                 {
@@ -430,31 +431,25 @@ dxf_light_read
                 {
                         /* Now follows a string containing binary
                          * graphics data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", light->binary_graphics_data->data_line);
-                        dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) light->binary_graphics_data->next);
-                        light->binary_graphics_data = (DxfBinaryGraphicsData *) light->binary_graphics_data->next;
+                        dxf_binary_graphics_data_read (fp, &light->binary_graphics_data, NULL);
                 }
                 else if (strcmp (temp_string, "330") == 0)
                 {
                         /* Now follows a string containing a
                          * soft-pointer ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", light->dictionary_owner_soft);
+                        dxf_read_string (fp, &light->dictionary_owner_soft);
                 }
                 else if (strcmp (temp_string, "347") == 0)
                 {
                         /* Now follows a string containing a
                          * hard-pointer ID/handle to material object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", light->material);
+                        dxf_read_string (fp, &light->material);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing a
                          * hard-pointer ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", light->dictionary_owner_hard);
+                        dxf_read_string (fp, &light->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "370") == 0)
                 {
@@ -467,8 +462,7 @@ dxf_light_read
                 {
                         /* Now follows a string containing a plot style
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", light->plot_style_name);
+                        dxf_read_string (fp, &light->plot_style_name);
                 }
                 else if (strcmp (temp_string, "420") == 0)
                 {
@@ -480,8 +474,7 @@ dxf_light_read
                 {
                         /* Now follows a string containing a color
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", light->color_name);
+                        dxf_read_string (fp, &light->color_name);
                 }
                 else if (strcmp (temp_string, "440") == 0)
                 {
@@ -507,11 +500,13 @@ dxf_light_read
         /* Handle omitted members and/or illegal values. */
         if (strcmp (light->linetype, "") == 0)
         {
-                light->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (light->linetype);
+                light->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (light->layer, "") == 0)
         {
-                light->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (light->layer);
+                light->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Clean up. */
         free (temp_string);
@@ -576,7 +571,8 @@ dxf_light_write
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                light->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (light->linetype);
+                light->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (light->layer, "") == 0)
         {
@@ -707,17 +703,21 @@ dxf_light_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (light->linetype);
-        free (light->layer);
-        dxf_binary_graphics_data_free_list ((DxfBinaryGraphicsData *) light->binary_graphics_data);
-        free (light->dictionary_owner_hard);
-        free (light->material);
-        free (light->dictionary_owner_soft);
-        free (light->plot_style_name);
-        free (light->color_name);
-        free (light->light_name);
+        dxf_string_free (light->linetype);
+        dxf_string_free (light->layer);
+        if (light->binary_graphics_data != NULL)
+        {
+                dxf_binary_graphics_data_free_list (light->binary_graphics_data);
+        }
+        dxf_string_free (light->dictionary_owner_hard);
+        dxf_string_free (light->material);
+        dxf_string_free (light->dictionary_owner_soft);
+        dxf_string_free (light->plot_style_name);
+        dxf_string_free (light->color_name);
+        dxf_string_free (light->light_name);
         dxf_point_free (light->p0);
         dxf_point_free (light->p1);
+        dxf_string_free (light->object_owner_soft);
         free (light);
         light = NULL;
 #if DEBUG
@@ -894,6 +894,8 @@ dxf_light_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (light == NULL)
         {
@@ -909,7 +911,13 @@ dxf_light_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        light->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (light->linetype);
+        light->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -972,6 +980,8 @@ dxf_light_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (light == NULL)
         {
@@ -987,7 +997,13 @@ dxf_light_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        light->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (light->layer);
+        light->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1730,6 +1746,8 @@ dxf_light_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (light == NULL)
         {
@@ -1745,7 +1763,13 @@ dxf_light_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        light->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (light->dictionary_owner_soft);
+        light->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1810,6 +1834,8 @@ dxf_light_set_object_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (light == NULL)
         {
@@ -1825,7 +1851,13 @@ dxf_light_set_object_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        light->object_owner_soft = strdup (object_owner_soft);
+        copy = dxf_string_share (object_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (light->object_owner_soft);
+        light->object_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1892,6 +1924,8 @@ dxf_light_set_material
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (light == NULL)
         {
@@ -1907,7 +1941,13 @@ dxf_light_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        light->material = strdup (material);
+        copy = dxf_string_share (material);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (light->material);
+        light->material = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1976,6 +2016,8 @@ dxf_light_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (light == NULL)
         {
@@ -1991,7 +2033,13 @@ dxf_light_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        light->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (light->dictionary_owner_hard);
+        light->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2121,6 +2169,8 @@ dxf_light_set_plot_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (light == NULL)
         {
@@ -2136,7 +2186,13 @@ dxf_light_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        light->plot_style_name = strdup (plot_style_name);
+        copy = dxf_string_share (plot_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (light->plot_style_name);
+        light->plot_style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2266,6 +2322,8 @@ dxf_light_set_color_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (light == NULL)
         {
@@ -2281,7 +2339,13 @@ dxf_light_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        light->color_name = strdup (color_name);
+        copy = dxf_string_share (color_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (light->color_name);
+        light->color_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
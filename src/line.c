@@ -40,6 +40,62 @@
 
 
 #include "line.h"
+#include "schema.h"
+#include "stats.h"
+#include "util.h"
+
+
+/*!
+ * \brief Group code schema of a DXF \c LINE entity.
+ *
+ * The fields are listed in the order they are written.
+ */
+static const DxfSchemaField dxf_line_schema_fields[] =
+{
+        {.group_code = 5, .type = DXF_SCHEMA_HEX, .offset = offsetof (DxfLine, id_code), .flags = DXF_SCHEMA_SKIP_DEFAULT, .default_int = -1},
+        {.group_code = 330, .type = DXF_SCHEMA_STRING, .offset = offsetof (DxfLine, dictionary_owner_soft), .min_version = AutoCAD_14, .flags = DXF_SCHEMA_SKIP_DEFAULT, .default_string = "", .group_name = "{ACAD_REACTORS"},
+        {.group_code = 360, .type = DXF_SCHEMA_STRING, .offset = offsetof (DxfLine, dictionary_owner_hard), .min_version = AutoCAD_14, .flags = DXF_SCHEMA_SKIP_DEFAULT, .default_string = "", .group_name = "{ACAD_XDICTIONARY"},
+        {.group_code = 100, .type = DXF_SCHEMA_SUBCLASS, .min_version = AutoCAD_13, .default_string = "AcDbEntity"},
+        {.group_code = 67, .type = DXF_SCHEMA_INT, .offset = offsetof (DxfLine, paperspace), .flags = DXF_SCHEMA_SKIP_DEFAULT, .default_int = DXF_MODELSPACE},
+        {.group_code = 8, .type = DXF_SCHEMA_STRING, .offset = offsetof (DxfLine, layer)},
+        {.group_code = 6, .type = DXF_SCHEMA_STRING, .offset = offsetof (DxfLine, linetype), .flags = DXF_SCHEMA_SKIP_DEFAULT, .default_string = DXF_DEFAULT_LINETYPE},
+        {.group_code = 347, .type = DXF_SCHEMA_STRING, .offset = offsetof (DxfLine, material), .min_version = AutoCAD_2008, .flags = DXF_SCHEMA_SKIP_DEFAULT, .default_string = ""},
+        {.group_code = 62, .type = DXF_SCHEMA_INT, .offset = offsetof (DxfLine, color), .flags = DXF_SCHEMA_SKIP_DEFAULT, .default_int = DXF_COLOR_BYLAYER},
+        {.group_code = 370, .type = DXF_SCHEMA_INT16, .offset = offsetof (DxfLine, lineweight), .min_version = AutoCAD_2000},
+        {.group_code = 38, .type = DXF_SCHEMA_DOUBLE, .offset = offsetof (DxfLine, elevation), .max_version = AutoCAD_11, .flags = DXF_SCHEMA_FLATLAND | DXF_SCHEMA_SKIP_DEFAULT},
+        {.group_code = 39, .type = DXF_SCHEMA_DOUBLE, .offset = offsetof (DxfLine, thickness), .flags = DXF_SCHEMA_SKIP_DEFAULT},
+        {.group_code = 48, .type = DXF_SCHEMA_DOUBLE, .offset = offsetof (DxfLine, linetype_scale), .flags = DXF_SCHEMA_SKIP_DEFAULT, .default_double = {1.0}},
+        {.group_code = 60, .type = DXF_SCHEMA_INT16, .offset = offsetof (DxfLine, visibility), .flags = DXF_SCHEMA_SKIP_DEFAULT},
+#ifdef BUILD_64
+        {.group_code = 160, .type = DXF_SCHEMA_INT, .offset = offsetof (DxfLine, graphics_data_size), .min_version = AutoCAD_2000, .flags = DXF_SCHEMA_SKIP_DEFAULT},
+        {.group_code = 92, .type = DXF_SCHEMA_INT, .offset = offsetof (DxfLine, graphics_data_size), .flags = DXF_SCHEMA_READ_ONLY},
+#else
+        {.group_code = 92, .type = DXF_SCHEMA_INT, .offset = offsetof (DxfLine, graphics_data_size), .min_version = AutoCAD_2000, .flags = DXF_SCHEMA_SKIP_DEFAULT},
+        {.group_code = 160, .type = DXF_SCHEMA_INT, .offset = offsetof (DxfLine, graphics_data_size), .flags = DXF_SCHEMA_READ_ONLY},
+#endif
+        {.group_code = 310, .type = DXF_SCHEMA_BINARY_LIST, .offset = offsetof (DxfLine, binary_graphics_data), .min_version = AutoCAD_2000, .flags = DXF_SCHEMA_SKIP_DEFAULT},
+        {.group_code = 420, .type = DXF_SCHEMA_LONG, .offset = offsetof (DxfLine, color_value), .min_version = AutoCAD_2004},
+        {.group_code = 430, .type = DXF_SCHEMA_STRING, .offset = offsetof (DxfLine, color_name), .min_version = AutoCAD_2004},
+        {.group_code = 440, .type = DXF_SCHEMA_LONG, .offset = offsetof (DxfLine, transparency), .min_version = AutoCAD_2004},
+        {.group_code = 390, .type = DXF_SCHEMA_STRING, .offset = offsetof (DxfLine, plot_style_name), .min_version = AutoCAD_2009},
+        {.group_code = 284, .type = DXF_SCHEMA_INT16, .offset = offsetof (DxfLine, shadow_mode), .min_version = AutoCAD_2009},
+        {.group_code = 100, .type = DXF_SCHEMA_SUBCLASS, .min_version = AutoCAD_13, .default_string = "AcDbLine"},
+        {.group_code = 10, .type = DXF_SCHEMA_POINT, .offset = offsetof (DxfLine, p0), .indirect_offset = offsetof (DxfPoint, x0), .flags = DXF_SCHEMA_INDIRECT},
+        {.group_code = 11, .type = DXF_SCHEMA_POINT, .offset = offsetof (DxfLine, p1), .indirect_offset = offsetof (DxfPoint, x0), .flags = DXF_SCHEMA_INDIRECT},
+        {.group_code = 210, .type = DXF_SCHEMA_POINT, .offset = offsetof (DxfLine, extr_x0), .min_version = AutoCAD_12, .flags = DXF_SCHEMA_SKIP_DEFAULT, .default_double = {0.0, 0.0, 1.0}}
+};
+
+
+/*!
+ * \brief Schema of a DXF \c LINE entity.
+ */
+static const DxfSchema dxf_line_schema =
+{
+        "LINE",
+        LINE,
+        dxf_line_schema_fields,
+        sizeof (dxf_line_schema_fields) / sizeof (dxf_line_schema_fields[0])
+};
 
 
 /*!
@@ -72,6 +128,7 @@ dxf_line_new ()
         else
         {
                 memset (line, 0, size);
+                dxf_stats_count_allocation (LINE, size);
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -113,8 +170,10 @@ dxf_line_init
               return (NULL);
         }
         dxf_line_set_id_code (line, 0);
-        dxf_line_set_linetype (line, strdup (DXF_DEFAULT_LINETYPE));
-        dxf_line_set_layer (line, strdup (DXF_DEFAULT_LAYER));
+        /* Default strings are shared, they are not copied until a
+         * different value is set. */
+        line->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        line->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         dxf_line_set_elevation (line, 0.0);
         dxf_line_set_thickness (line, 0.0);
         dxf_line_set_linetype_scale (line, DXF_DEFAULT_LINETYPE_SCALE);
@@ -123,28 +182,36 @@ dxf_line_init
         dxf_line_set_paperspace (line, DXF_MODELSPACE);
         dxf_line_set_graphics_data_size (line, 0);
         dxf_line_set_shadow_mode (line, 0);
-        dxf_line_set_binary_graphics_data (line, (DxfBinaryGraphicsData *) dxf_binary_graphics_data_new());
-        dxf_line_set_dictionary_owner_soft (line, strdup (""));
-        dxf_line_set_material (line, strdup (""));
-        dxf_line_set_dictionary_owner_hard (line, strdup (""));
+        /* Binary graphics data is optional, it is allocated when it
+         * is read or set. */
+        line->binary_graphics_data = NULL;
+        line->dictionary_owner_soft = dxf_string_share ("");
+        line->material = dxf_string_share ("");
+        line->dictionary_owner_hard = dxf_string_share ("");
         dxf_line_set_lineweight (line, 0);
-        dxf_line_set_plot_style_name (line, strdup (""));
+        line->plot_style_name = dxf_string_share ("");
         dxf_line_set_color_value (line, 0);
-        dxf_line_set_color_name (line, strdup (""));
+        line->color_name = dxf_string_share ("");
         dxf_line_set_transparency (line, 0);
-        dxf_line_set_p0 (line, (DxfPoint *) dxf_point_new());
-        dxf_point_init ((DxfPoint *) dxf_line_get_p0 (line));
+        /* The start point and end point only hold coordinates, the
+         * other members of the DxfPoint structs are not used. */
+        if (line->p0 == NULL)
+        {
+                line->p0 = (DxfPoint *) dxf_point_new ();
+        }
         dxf_line_set_x0 (line, 0.0);
         dxf_line_set_y0 (line, 0.0);
         dxf_line_set_z0 (line, 0.0);
-        dxf_line_set_p1 (line, (DxfPoint *) dxf_point_new());
-        dxf_point_init ((DxfPoint *) dxf_line_get_p0 (line));
+        if (line->p1 == NULL)
+        {
+                line->p1 = (DxfPoint *) dxf_point_new ();
+        }
         dxf_line_set_x1 (line, 0.0);
         dxf_line_set_y1 (line, 0.0);
         dxf_line_set_z1 (line, 0.0);
         dxf_line_set_extr_x0 (line, 0.0);
         dxf_line_set_extr_y0 (line, 0.0);
-        dxf_line_set_extr_z0 (line, 0.0);
+        dxf_line_set_extr_z0 (line, 1.0);
         dxf_line_set_next (line, NULL);
 #if DEBUG
         DXF_DEBUG_END
@@ -176,16 +243,12 @@ dxf_line_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
-
         /* Do some basic checks. */
         if (fp == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (line == NULL)
@@ -196,269 +259,20 @@ dxf_line_read
                 line = dxf_line_new ();
                 line = dxf_line_init (line);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        if (dxf_schema_read (fp, &dxf_line_schema, line) != EXIT_SUCCESS)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &line->id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", line->linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", line->layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the start point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &line->p0->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the start point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &line->p0->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the start point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &line->p0->z0);
-                }
-                else if (strcmp (temp_string, "11") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the end point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &line->p1->x0);
-                }
-                else if (strcmp (temp_string, "21") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the end point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &line->p1->y0);
-                }
-                else if (strcmp (temp_string, "31") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the end point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &line->p1->z0);
-                }
-                else if (strcmp (temp_string, "38") == 0)
-                {
-                        /* Now follows a string containing the
-                         * elevation. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &line->elevation);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &line->thickness);
-                }
-                else if (strcmp (temp_string, "48") == 0)
-                {
-                        /* Now follows a string containing the linetype
-                         * scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &line->linetype_scale);
-                }
-                else if (strcmp (temp_string, "60") == 0)
-                {
-                        /* Now follows a string containing the
-                         * visibility value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &line->visibility);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &line->color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &line->paperspace);
-                }
-                else if (strcmp (temp_string, "92") == 0)
-                {
-                        /* Now follows a string containing the
-                         * graphics data size value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &line->graphics_data_size);
-                }
-                else if (strcmp (temp_string, "100") == 0)
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if ((strcmp (temp_string, "AcDbEntity") != 0)
-                        && ((strcmp (temp_string, "AcDbLine") != 0)))
-                        {
-                                fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "160") == 0)
-                {
-                        /* Now follows a string containing the
-                         * graphics data size value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &line->graphics_data_size);
-                }
-                else if (strcmp (temp_string, "210") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &line->extr_x0);
-                }
-                else if (strcmp (temp_string, "220") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &line->extr_y0);
-                }
-                else if (strcmp (temp_string, "230") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &line->extr_z0);
-                }
-                else if (strcmp (temp_string, "284") == 0)
-                {
-                        /* Now follows a string containing the shadow
-                         * mode value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &line->shadow_mode);
-                }
-                else if (strcmp (temp_string, "310") == 0)
-                {
-                        /* Now follows a string containing binary
-                         * graphics data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", line->binary_graphics_data->data_line);
-                        dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) line->binary_graphics_data->next);
-                        line->binary_graphics_data = (DxfBinaryGraphicsData *) line->binary_graphics_data->next;
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", line->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "347") == 0)
-                {
-                        /* Now follows a string containing a
-                         * hard-pointer ID/handle to material object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", line->material);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", line->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "370") == 0)
-                {
-                        /* Now follows a string containing the lineweight
-                         * value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &line->lineweight);
-                }
-                else if (strcmp (temp_string, "390") == 0)
-                {
-                        /* Now follows a string containing a plot style
-                         * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", line->plot_style_name);
-                }
-                else if (strcmp (temp_string, "420") == 0)
-                {
-                        /* Now follows a string containing a color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%ld\n", &line->color_value);
-                }
-                else if (strcmp (temp_string, "430") == 0)
-                {
-                        /* Now follows a string containing a color
-                         * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", line->color_name);
-                }
-                else if (strcmp (temp_string, "440") == 0)
-                {
-                        /* Now follows a string containing a transparency
-                         * value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%ld\n", &line->transparency);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                }
+                fclose (fp->fp);
+                return (NULL);
         }
         /* Handle omitted members and/or illegal values. */
-        if (strcmp (dxf_line_get_linetype (line), "") == 0)
+        if ((line->linetype == NULL) || (strcmp (line->linetype, "") == 0))
         {
-                dxf_line_set_linetype (line, strdup (DXF_DEFAULT_LINETYPE));
+                dxf_line_set_linetype (line, DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (dxf_line_get_layer (line), "") == 0)
+        if ((line->layer == NULL) || (strcmp (line->layer, "") == 0))
         {
-                dxf_line_set_layer (line, strdup (DXF_DEFAULT_LAYER));
+                dxf_line_set_layer (line, DXF_DEFAULT_LAYER);
         }
-        /* Clean up. */
-        free (temp_string);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -517,7 +331,7 @@ dxf_line_write
                 free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
-        if (strcmp (dxf_line_get_linetype (line), "") == 0)
+        if ((line->linetype == NULL) || (strcmp (line->linetype, "") == 0))
         {
                 fprintf (stderr,
                   (_("Warning in %s () empty linetype string for the %s entity with id-code: %x\n")),
@@ -525,9 +339,9 @@ dxf_line_write
                 fprintf (stderr,
                   (_("    %s entity is relocated to layer 0\n")),
                   dxf_entity_name);
-                dxf_line_set_linetype (line, strdup (DXF_DEFAULT_LINETYPE));
+                dxf_line_set_linetype (line, DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (dxf_line_get_layer (line), "") == 0)
+        if ((line->layer == NULL) || (strcmp (line->layer, "") == 0))
         {
                 fprintf (stderr,
                   (_("Warning in %s () empty layer string for the %s entity with id-code: %x\n")),
@@ -535,130 +349,14 @@ dxf_line_write
                 fprintf (stderr,
                   (_("    %s entity is relocated to layer 0\n")),
                   dxf_entity_name);
-                dxf_line_set_layer (line, strdup (DXF_DEFAULT_LAYER));
+                dxf_line_set_layer (line, DXF_DEFAULT_LAYER);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
-        if (dxf_line_get_id_code (line) != -1)
+        if (dxf_schema_write (fp, &dxf_line_schema, line) != EXIT_SUCCESS)
         {
-                fprintf (fp->fp, "  5\n%x\n", dxf_line_get_id_code (line));
-        }
-        /*!
-         * \todo for version R14.\n
-         * Implementing the start of application-defined group
-         * "{application_name", with Group code 102.\n
-         * For example: "{ACAD_REACTORS" indicates the start of the
-         * AutoCAD persistent reactors group.\n\n
-         * application-defined codes: Group codes and values within the
-         * 102 groups are application defined (optional).\n\n
-         * End of group, "}" (optional), with Group code 102.
-         */
-        if ((strcmp (dxf_line_get_dictionary_owner_soft (line), "") != 0)
-          && (fp->acad_version_number >= AutoCAD_14))
-        {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", dxf_line_get_dictionary_owner_soft (line));
-                fprintf (fp->fp, "102\n}\n");
-        }
-        if ((strcmp (dxf_line_get_dictionary_owner_hard (line), "") != 0)
-          && (fp->acad_version_number >= AutoCAD_14))
-        {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", dxf_line_get_dictionary_owner_hard (line));
-                fprintf (fp->fp, "102\n}\n");
-        }
-        if (fp->acad_version_number >= AutoCAD_13)
-        {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
-        }
-        if (dxf_line_get_paperspace (line) == DXF_PAPERSPACE)
-        {
-                fprintf (fp->fp, " 67\n%d\n", DXF_PAPERSPACE);
-        }
-        fprintf (fp->fp, "  8\n%s\n", dxf_line_get_layer (line));
-        if (strcmp (dxf_line_get_linetype (line), DXF_DEFAULT_LINETYPE) != 0)
-        {
-                fprintf (fp->fp, "  6\n%s\n", dxf_line_get_linetype (line));
-        }
-        if ((fp->acad_version_number >= AutoCAD_2008)
-          && (strcmp (dxf_line_get_material (line), "") != 0))
-        {
-                fprintf (fp->fp, "347\n%s\n", dxf_line_get_material (line));
-        }
-        if (dxf_line_get_color (line) != DXF_COLOR_BYLAYER)
-        {
-                fprintf (fp->fp, " 62\n%d\n", dxf_line_get_color (line));
-        }
-        if (fp->acad_version_number >= AutoCAD_2002)
-        {
-                fprintf (fp->fp, "370\n%d\n", dxf_line_get_lineweight (line));
-        }
-        if ((fp->acad_version_number <= AutoCAD_11)
-          && DXF_FLATLAND
-          && (dxf_line_get_elevation (line) != 0.0))
-        {
-                fprintf (fp->fp, " 38\n%f\n", dxf_line_get_elevation (line));
-        }
-        if (dxf_line_get_thickness (line) != 0.0)
-        {
-                fprintf (fp->fp, " 39\n%f\n", dxf_line_get_thickness (line));
-        }
-        if (dxf_line_get_linetype_scale (line) != 1.0)
-        {
-                fprintf (fp->fp, " 48\n%f\n", dxf_line_get_linetype_scale (line));
-        }
-        if (dxf_line_get_visibility (line) != 0)
-        {
-                fprintf (fp->fp, " 60\n%d\n", dxf_line_get_visibility (line));
-        }
-        if ((fp->acad_version_number >= AutoCAD_2000)
-          && (dxf_line_get_graphics_data_size (line) > 0))
-        {
-#ifdef BUILD_64
-                fprintf (fp->fp, "160\n%d\n", dxf_line_get_graphics_data_size (line));
-#else
-                fprintf (fp->fp, " 92\n%d\n", dxf_line_get_graphics_data_size (line));
-#endif
-                if (dxf_line_get_binary_graphics_data (line) != NULL)
-                {
-                        DxfBinaryGraphicsData *iter;
-                        iter = dxf_line_get_binary_graphics_data (line);
-                        while (iter != NULL)
-                        {
-                                fprintf (fp->fp, "310\n%s\n", dxf_binary_graphics_data_get_data_line (iter));
-                                iter = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_get_next (iter);
-                        }
-                }
-        }
-        if (fp->acad_version_number >= AutoCAD_2004)
-        {
-                fprintf (fp->fp, "420\n%ld\n", dxf_line_get_color_value (line));
-                fprintf (fp->fp, "430\n%s\n", dxf_line_get_color_name (line));
-                fprintf (fp->fp, "440\n%ld\n", dxf_line_get_transparency (line));
-        }
-        if (fp->acad_version_number >= AutoCAD_2009)
-        {
-                fprintf (fp->fp, "390\n%s\n", dxf_line_get_plot_style_name (line));
-                fprintf (fp->fp, "284\n%d\n", dxf_line_get_shadow_mode (line));
-        }
-        if (fp->acad_version_number >= AutoCAD_13)
-        {
-                fprintf (fp->fp, "100\nAcDbLine\n");
-        }
-        fprintf (fp->fp, " 10\n%f\n", dxf_line_get_x0 (line));
-        fprintf (fp->fp, " 20\n%f\n", dxf_line_get_y0 (line));
-        fprintf (fp->fp, " 30\n%f\n", dxf_line_get_z0 (line));
-        fprintf (fp->fp, " 11\n%f\n", dxf_line_get_x1 (line));
-        fprintf (fp->fp, " 21\n%f\n", dxf_line_get_y1 (line));
-        fprintf (fp->fp, " 31\n%f\n", dxf_line_get_z1 (line));
-        if ((fp->acad_version_number >= AutoCAD_12)
-                && (dxf_line_get_extr_x0 (line) != 0.0)
-                && (dxf_line_get_extr_y0 (line) != 0.0)
-                && (dxf_line_get_extr_z0 (line) != 1.0))
-        {
-                fprintf (fp->fp, "210\n%f\n", dxf_line_get_extr_x0 (line));
-                fprintf (fp->fp, "220\n%f\n", dxf_line_get_extr_y0 (line));
-                fprintf (fp->fp, "230\n%f\n", dxf_line_get_extr_z0 (line));
+                /* Clean up. */
+                free (dxf_entity_name);
+                return (EXIT_FAILURE);
         }
         /* Clean up. */
         free (dxf_entity_name);
@@ -702,16 +400,25 @@ dxf_line_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (dxf_line_get_linetype (line));
-        free (dxf_line_get_layer (line));
-        dxf_binary_graphics_data_free_list (dxf_line_get_binary_graphics_data (line));
-        free (dxf_line_get_dictionary_owner_soft (line));
-        free (dxf_line_get_material (line));
-        free (dxf_line_get_dictionary_owner_hard (line));
-        free (dxf_line_get_plot_style_name (line));
-        free (dxf_line_get_color_name (line));
-        dxf_point_free (dxf_line_get_p0 (line));
-        dxf_point_free (dxf_line_get_p1 (line));
+        dxf_string_free (line->linetype);
+        dxf_string_free (line->layer);
+        if (line->binary_graphics_data != NULL)
+        {
+                dxf_binary_graphics_data_free_list (line->binary_graphics_data);
+        }
+        dxf_string_free (line->dictionary_owner_soft);
+        dxf_string_free (line->material);
+        dxf_string_free (line->dictionary_owner_hard);
+        dxf_string_free (line->plot_style_name);
+        dxf_string_free (line->color_name);
+        if (line->p0 != NULL)
+        {
+                dxf_point_free (line->p0);
+        }
+        if (line->p1 != NULL)
+        {
+                dxf_point_free (line->p1);
+        }
         free (line);
         line = NULL;
 #if DEBUG
@@ -883,6 +590,8 @@ dxf_line_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (line == NULL)
         {
@@ -898,7 +607,13 @@ dxf_line_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        line->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (line->linetype);
+        line->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -958,6 +673,8 @@ dxf_line_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (line == NULL)
         {
@@ -973,7 +690,13 @@ dxf_line_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        line->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (line->layer);
+        line->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1655,13 +1378,6 @@ dxf_line_get_binary_graphics_data
                   __FUNCTION__);
                 return (NULL);
         }
-        if (line->binary_graphics_data ==  NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found in the binary_graphics_data member.\n")),
-                  __FUNCTION__);
-                return (NULL);
-        }
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1766,6 +1482,8 @@ dxf_line_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (line == NULL)
         {
@@ -1781,7 +1499,13 @@ dxf_line_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        line->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (line->dictionary_owner_soft);
+        line->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1850,6 +1574,8 @@ dxf_line_set_material
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (line == NULL)
         {
@@ -1865,7 +1591,13 @@ dxf_line_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        line->material = strdup (material);
+        copy = dxf_string_share (material);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (line->material);
+        line->material = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1930,6 +1662,8 @@ dxf_line_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (line == NULL)
         {
@@ -1945,7 +1679,13 @@ dxf_line_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        line->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (line->dictionary_owner_hard);
+        line->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2075,6 +1815,8 @@ dxf_line_set_plot_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (line == NULL)
         {
@@ -2090,7 +1832,13 @@ dxf_line_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        line->plot_style_name = strdup (plot_style_name);
+        copy = dxf_string_share (plot_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (line->plot_style_name);
+        line->plot_style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2220,6 +1968,8 @@ dxf_line_set_color_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (line == NULL)
         {
@@ -2235,7 +1985,13 @@ dxf_line_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        line->color_name = strdup (color_name);
+        copy = dxf_string_share (color_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (line->color_name);
+        line->color_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -3615,11 +3371,11 @@ dxf_line_create_from_points
                 case 1:
                         if (p1->linetype != NULL)
                         {
-                                line->linetype = p1->linetype;
+                                dxf_line_set_linetype (line, p1->linetype);
                         }
                         if (p1->layer != NULL)
                         {
-                                line->layer = p1->layer;
+                                dxf_line_set_layer (line, p1->layer);
                         }
                         line->thickness = p1->thickness;
                         line->linetype_scale = p1->linetype_scale;
@@ -3632,36 +3388,36 @@ dxf_line_create_from_points
                         line->binary_graphics_data = p1->binary_graphics_data;
                         if (p1->dictionary_owner_soft != NULL)
                         {
-                                line->dictionary_owner_soft = strdup (p1->dictionary_owner_soft);
+                                dxf_line_set_dictionary_owner_soft (line, p1->dictionary_owner_soft);
                         }
                         if (p1->material != NULL)
                         {
-                                line->material = strdup (p1->material);
+                                dxf_line_set_material (line, p1->material);
                         }
                         if (p1->dictionary_owner_hard != NULL)
                         {
-                                line->dictionary_owner_hard = strdup (p1->dictionary_owner_hard);
+                                dxf_line_set_dictionary_owner_hard (line, p1->dictionary_owner_hard);
                         }
                         line->lineweight = p1->lineweight;
                         if (p1->plot_style_name != NULL)
                         {
-                                line->plot_style_name = strdup (p1->plot_style_name);
+                                dxf_line_set_plot_style_name (line, p1->plot_style_name);
                         }
                         line->color_value = p1->color_value;
                         if (p1->color_name != NULL)
                         {
-                                line->color_name = strdup (p1->color_name);
+                                dxf_line_set_color_name (line, p1->color_name);
                         }
                         line->transparency = p1->transparency;
                         break;
                 case 2:
                         if (p2->linetype != NULL)
                         {
-                                line->linetype = p2->linetype;
+                                dxf_line_set_linetype (line, p2->linetype);
                         }
                         if (p2->layer != NULL)
                         {
-                                line->layer = p2->layer;
+                                dxf_line_set_layer (line, p2->layer);
                         }
                         line->thickness = p2->thickness;
                         line->linetype_scale = p2->linetype_scale;
@@ -3674,25 +3430,25 @@ dxf_line_create_from_points
                         line->binary_graphics_data = p2->binary_graphics_data;
                         if (p2->dictionary_owner_soft != NULL)
                         {
-                                line->dictionary_owner_soft = strdup (p2->dictionary_owner_soft);
+                                dxf_line_set_dictionary_owner_soft (line, p2->dictionary_owner_soft);
                         }
                         if (p2->material != NULL)
                         {
-                                line->material = strdup (p2->material);
+                                dxf_line_set_material (line, p2->material);
                         }
                         if (p2->dictionary_owner_hard != NULL)
                         {
-                                line->dictionary_owner_hard = strdup (p2->dictionary_owner_hard);
+                                dxf_line_set_dictionary_owner_hard (line, p2->dictionary_owner_hard);
                         }
                         line->lineweight = p2->lineweight;
                         if (p2->plot_style_name != NULL)
                         {
-                                line->plot_style_name = strdup (p2->plot_style_name);
+                                dxf_line_set_plot_style_name (line, p2->plot_style_name);
                         }
                         line->color_value = p2->color_value;
                         if (p2->color_name != NULL)
                         {
-                                line->color_name = strdup (p2->color_name);
+                                dxf_line_set_color_name (line, p2->color_name);
                         }
                         line->transparency = p2->transparency;
                         break;
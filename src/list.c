@@ -0,0 +1,549 @@
+/*!
+ * \file list.c
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Functions for a generic list container with O(1) appends.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include "list.h"
+
+
+static void **dxf_list_get_next_member (DxfList *list, void *item);
+static int dxf_list_reserve_index (DxfList *list, int max_number_of_index_items);
+static void dxf_list_check_tail (DxfList *list);
+
+
+/*!
+ * \brief Allocate memory for a \c DxfList.
+ *
+ * Fill the memory contents with zeros.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfList *
+dxf_list_new ()
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfList *list = NULL;
+        size_t size;
+
+        size = sizeof (DxfList);
+        /* avoid malloc of 0 bytes */
+        if (size == 0) size = 1;
+        if ((list = malloc (size)) == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                list = NULL;
+        }
+        else
+        {
+                memset (list, 0, size);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (list);
+}
+
+
+/*!
+ * \brief Allocate memory and initialize data fields in a \c DxfList.
+ *
+ * The list is empty after initialization.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfList *
+dxf_list_init
+(
+        DxfList *list,
+                /*!< a pointer to the list. */
+        size_t next_offset
+                /*!< offset of the \c next member in the item struct,
+                 * e.g. \c offsetof \c (DxfLine, \c next). */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (list == NULL)
+        {
+                fprintf (stderr,
+                  (_("Warning in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                list = dxf_list_new ();
+        }
+        if (list == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        list->head = NULL;
+        list->tail = NULL;
+        list->number_of_items = 0;
+        list->next_offset = next_offset;
+        list->index = NULL;
+        list->max_number_of_index_items = 0;
+        list->index_is_valid = FALSE;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (list);
+}
+
+
+/*!
+ * \brief Let a \c DxfList take over an existing single linked list.
+ *
+ * The list is walked once to find the last item and to count the
+ * items, the index is invalidated.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_list_set_head
+(
+        DxfList *list,
+                /*!< a pointer to the list. */
+        void *head
+                /*!< a pointer to the first item of the single linked
+                 * list, \c NULL for an empty list. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        void *iter = NULL;
+
+        /* Do some basic checks. */
+        if (list == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        list->head = head;
+        list->tail = NULL;
+        list->number_of_items = 0;
+        list->index_is_valid = FALSE;
+        for (iter = head; iter != NULL; iter = *dxf_list_get_next_member (list, iter))
+        {
+                list->tail = iter;
+                list->number_of_items++;
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Append an item to a \c DxfList.
+ *
+ * The \c next member of the item is set to \c NULL, the item becomes
+ * the last item of the list.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_list_append
+(
+        DxfList *list,
+                /*!< a pointer to the list. */
+        void *item
+                /*!< a pointer to the item. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if ((list == NULL) || (item == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_list_check_tail (list);
+        if (list->index_is_valid)
+        {
+                if ((list->number_of_items == list->max_number_of_index_items)
+                  && (dxf_list_reserve_index (list, 2 * list->max_number_of_index_items) != EXIT_SUCCESS))
+                {
+                        list->index_is_valid = FALSE;
+                }
+                else
+                {
+                        list->index[list->number_of_items] = item;
+                }
+        }
+        *dxf_list_get_next_member (list, item) = NULL;
+        if (list->tail == NULL)
+        {
+                list->head = item;
+        }
+        else
+        {
+                *dxf_list_get_next_member (list, list->tail) = item;
+        }
+        list->tail = item;
+        list->number_of_items++;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Get the first item of a \c DxfList.
+ *
+ * \return a pointer to the first item, \c NULL when the list is empty
+ * or an error occurred.
+ */
+void *
+dxf_list_get_head
+(
+        DxfList *list
+                /*!< a pointer to the list. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (list == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (list->head);
+}
+
+
+/*!
+ * \brief Get the last item of a \c DxfList.
+ *
+ * \return a pointer to the last item, \c NULL when the list is empty
+ * or an error occurred.
+ */
+void *
+dxf_list_get_tail
+(
+        DxfList *list
+                /*!< a pointer to the list. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (list == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        dxf_list_check_tail (list);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (list->tail);
+}
+
+
+/*!
+ * \brief Get the number of items in a \c DxfList.
+ *
+ * \return the number of items, or -1 when an error occurred.
+ */
+int
+dxf_list_get_number_of_items
+(
+        DxfList *list
+                /*!< a pointer to the list. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (list == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (-1);
+        }
+        dxf_list_check_tail (list);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (list->number_of_items);
+}
+
+
+/*!
+ * \brief Get the item at a position in a \c DxfList.
+ *
+ * The first call builds the index in a single walk of the list, after
+ * that every lookup is a single array access.\n
+ * Items linked behind the last item without dxf_list_append () are
+ * counted and indexed again, see dxf_list_check_tail ().
+ *
+ * \return a pointer to the item, \c NULL when the position is out of
+ * range or an error occurred.
+ */
+void *
+dxf_list_get_item
+(
+        DxfList *list,
+                /*!< a pointer to the list. */
+        int position
+                /*!< position of the item, starting at 0 for the first
+                 * item. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        void *iter = NULL;
+        int i;
+
+        /* Do some basic checks. */
+        if (list == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        dxf_list_check_tail (list);
+        if (!list->index_is_valid)
+        {
+                if ((list->number_of_items > list->max_number_of_index_items)
+                  && (dxf_list_reserve_index (list, list->number_of_items) != EXIT_SUCCESS))
+                {
+                        return (NULL);
+                }
+                i = 0;
+                for (iter = list->head;
+                  (iter != NULL) && (i < list->number_of_items);
+                  iter = *dxf_list_get_next_member (list, iter))
+                {
+                        list->index[i] = iter;
+                        i++;
+                }
+                list->index_is_valid = TRUE;
+        }
+        if ((position < 0) || (position >= list->number_of_items))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () position %d is out of range.\n")),
+                  __FUNCTION__, position);
+                return (NULL);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (list->index[position]);
+}
+
+
+/*!
+ * \brief Clear a \c DxfList.
+ *
+ * Free the index and empty the list, the items themselves are not
+ * freed.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_list_clear
+(
+        DxfList *list
+                /*!< a pointer to the list. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (list == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        free (list->index);
+        dxf_list_init (list, list->next_offset);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Free the allocated memory for a \c DxfList.
+ *
+ * The items themselves are not freed.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_list_free
+(
+        DxfList *list
+                /*!< a pointer to the list. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (list == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_list_clear (list);
+        free (list);
+        list = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Get the address of the \c next member of an item.
+ */
+static void **
+dxf_list_get_next_member
+(
+        DxfList *list,
+                /*!< a pointer to the list. */
+        void *item
+                /*!< a pointer to the item. */
+)
+{
+        return ((void **) ((char *) item + list->next_offset));
+}
+
+
+/*!
+ * \brief Grow the index of a \c DxfList.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_list_reserve_index
+(
+        DxfList *list,
+                /*!< a pointer to the list. */
+        int max_number_of_index_items
+                /*!< requested number of pointers in the index. */
+)
+{
+        void **index = NULL;
+
+        if (max_number_of_index_items < DXF_LIST_MIN_INDEX_SIZE)
+        {
+                max_number_of_index_items = DXF_LIST_MIN_INDEX_SIZE;
+        }
+        if (max_number_of_index_items <= list->max_number_of_index_items)
+        {
+                return (EXIT_SUCCESS);
+        }
+        index = realloc (list->index, max_number_of_index_items * sizeof (void *));
+        if (index == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        list->index = index;
+        list->max_number_of_index_items = max_number_of_index_items;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Find items linked behind the last item of a \c DxfList.
+ *
+ * Entities are also linked with their dxf_*_set_next () functions,
+ * when the last item got a next item the list is counted again with
+ * dxf_list_set_head (), which invalidates the index.
+ */
+static void
+dxf_list_check_tail
+(
+        DxfList *list
+                /*!< a pointer to the list. */
+)
+{
+        if ((list->tail != NULL)
+          && (*dxf_list_get_next_member (list, list->tail) != NULL))
+        {
+                dxf_list_set_head (list, list->head);
+        }
+}
+
+
+/* EOF */
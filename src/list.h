@@ -0,0 +1,111 @@
+/*!
+ * \file list.h
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Header file for a generic list container with O(1) appends.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#ifndef LIBDXF_SRC_LIST_H
+#define LIBDXF_SRC_LIST_H
+
+
+#include "global.h"
+#include <stddef.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define DXF_LIST_MIN_INDEX_SIZE 16
+        /*!< \brief The initial number of slots in the index of a
+         * list. */
+
+
+/*!
+ * \brief Definition of a list container.
+ *
+ * The container keeps track of the first and the last item and the
+ * number of items of a single linked list of libDXF structs (e.g. a
+ * list of \c DxfLine entities), so that appending an item does not
+ * have to walk the list.\n
+ * The items remain linked through their own \c next member, whose
+ * offset in the struct is stored in \c next_offset, so existing code
+ * that walks the \c next pointers keeps working.\n
+ * A pointer index for random access by position is only built on the
+ * first call to dxf_list_get_item () and is kept up to date by
+ * subsequent appends.\n
+ * The container does not own the items, freeing the items is left to
+ * the \c dxf_*_free_list () function of the item type.
+ */
+typedef struct
+dxf_list_struct
+{
+        void *head;
+                /*!< Pointer to the first item, \c NULL when the list
+                 * is empty. */
+        void *tail;
+                /*!< Pointer to the last item, \c NULL when the list
+                 * is empty. */
+        int number_of_items;
+                /*!< Number of items in the list. */
+        size_t next_offset;
+                /*!< Offset of the \c next member in the item struct. */
+        void **index;
+                /*!< Array of pointers to the items in list order. */
+        int max_number_of_index_items;
+                /*!< Number of pointers that fit in the index. */
+        int index_is_valid;
+                /*!< \c TRUE when the index holds all items. */
+} DxfList;
+
+
+DxfList *dxf_list_new ();
+DxfList *dxf_list_init (DxfList *list, size_t next_offset);
+int dxf_list_set_head (DxfList *list, void *head);
+int dxf_list_append (DxfList *list, void *item);
+void *dxf_list_get_head (DxfList *list);
+void *dxf_list_get_tail (DxfList *list);
+int dxf_list_get_number_of_items (DxfList *list);
+void *dxf_list_get_item (DxfList *list, int position);
+int dxf_list_clear (DxfList *list);
+int dxf_list_free (DxfList *list);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* LIBDXF_SRC_LIST_H */
+
+
+/* EOF */
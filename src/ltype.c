@@ -40,6 +40,7 @@
 
 
 #include "ltype.h"
+#include "util.h"
 
 
 /*!
@@ -112,8 +113,8 @@ dxf_ltype_init
               return (NULL);
         }
         dxf_ltype_set_id_code (ltype, 0);
-        dxf_ltype_set_linetype_name (ltype, strdup (""));
-        dxf_ltype_set_description (ltype, strdup (""));
+        ltype->linetype_name = dxf_string_share ("");
+        ltype->description = dxf_string_share ("");
         dxf_ltype_set_total_pattern_length (ltype, 0.0);
         dxf_ltype_set_number_of_linetype_elements (ltype, 0);
         for ((i = 0); (i <= DXF_MAX_NUMBER_OF_DASH_LENGTH_ITEMS); i++)
@@ -130,8 +131,8 @@ dxf_ltype_init
         }
         dxf_ltype_set_flag (ltype, 0);
         dxf_ltype_set_alignment (ltype, 65);
-        dxf_ltype_set_dictionary_owner_soft (ltype, strdup (""));
-        dxf_ltype_set_dictionary_owner_hard (ltype, strdup (""));
+        ltype->dictionary_owner_soft = dxf_string_share ("");
+        ltype->dictionary_owner_hard = dxf_string_share ("");
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -209,14 +210,12 @@ dxf_ltype_read
                 {
                         /* Now follows a string containing a linetype
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ltype->linetype_name);
+                        dxf_read_string (fp, &ltype->linetype_name);
                 }
                 else if (strcmp (temp_string, "3") == 0)
                 {
                         /* Now follows a string containing a description. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ltype->description);
+                        dxf_read_string (fp, &ltype->description);
                 }
                 else if (strcmp (temp_string, "9") == 0)
                 {
@@ -314,8 +313,7 @@ dxf_ltype_read
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ltype->dictionary_owner_soft);
+                        dxf_read_string (fp, &ltype->dictionary_owner_soft);
                 }
                 else if (strcmp (temp_string, "340") == 0)
                 {
@@ -328,8 +326,7 @@ dxf_ltype_read
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ltype->dictionary_owner_hard);
+                        dxf_read_string (fp, &ltype->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "999") == 0)
                 {
@@ -590,15 +587,15 @@ dxf_ltype_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (dxf_ltype_get_linetype_name (ltype));
-        free (dxf_ltype_get_description (ltype));
+        dxf_string_free (ltype->linetype_name);
+        dxf_string_free (ltype->description);
         for ((i = 0); (i <= DXF_MAX_NUMBER_OF_DASH_LENGTH_ITEMS); i++)
         {
                 free (dxf_ltype_get_complex_text_string (ltype, i));
                 free (dxf_ltype_get_complex_style_pointer (ltype, i));
         }
-        free (dxf_ltype_get_dictionary_owner_soft (ltype));
-        free (dxf_ltype_get_dictionary_owner_hard (ltype));
+        dxf_string_free (ltype->dictionary_owner_soft);
+        dxf_string_free (ltype->dictionary_owner_hard);
         free (ltype);
         ltype = NULL;
 #if DEBUG
@@ -772,6 +769,8 @@ dxf_ltype_set_linetype_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (ltype == NULL)
         {
@@ -787,7 +786,13 @@ dxf_ltype_set_linetype_name
                   __FUNCTION__);
                 return (NULL);
         }
-        ltype->linetype_name = strdup (linetype_name);
+        copy = dxf_string_share (linetype_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (ltype->linetype_name);
+        ltype->linetype_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -849,6 +854,8 @@ dxf_ltype_set_description
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (ltype == NULL)
         {
@@ -864,7 +871,13 @@ dxf_ltype_set_description
                   __FUNCTION__);
                 return (NULL);
         }
-        ltype->description = strdup (description);
+        copy = dxf_string_share (description);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (ltype->description);
+        ltype->description = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2097,6 +2110,8 @@ dxf_ltype_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (ltype == NULL)
         {
@@ -2112,7 +2127,13 @@ dxf_ltype_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        ltype->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (ltype->dictionary_owner_soft);
+        ltype->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2288,6 +2309,8 @@ dxf_ltype_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (ltype == NULL)
         {
@@ -2303,7 +2326,13 @@ dxf_ltype_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        ltype->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (ltype->dictionary_owner_hard);
+        ltype->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
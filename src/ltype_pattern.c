@@ -0,0 +1,1059 @@
+/*!
+ * \file ltype_pattern.c
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Functions for applying DXF linetype (\c LTYPE) dash patterns
+ * to flattened geometry.
+ *
+ * A linetype is compiled once into a pattern with the cumulative length
+ * at the end of each element.\n
+ * Applying a pattern walks the segments of a path while carrying the
+ * position in the pattern (the phase) over from segment to segment, so
+ * that dashes continue around vertices.\n
+ * The dashes are written as separate paths into a \c DxfFlattenBuffer,
+ * dots as paths of a single vertex.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include "ltype_pattern.h"
+
+
+static unsigned int dxf_ltype_pattern_table_hash (const char *name);
+static int dxf_ltype_pattern_table_slot (char **names, int number_of_slots, const char *name);
+
+
+/*!
+ * \brief Allocate memory for a \c DxfLTypePattern.
+ *
+ * Fill the memory contents with zeros.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfLTypePattern *
+dxf_ltype_pattern_new ()
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfLTypePattern *pattern = NULL;
+        size_t size;
+
+        size = sizeof (DxfLTypePattern);
+        /* avoid malloc of 0 bytes */
+        if (size == 0) size = 1;
+        if ((pattern = malloc (size)) == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                pattern = NULL;
+        }
+        else
+        {
+                memset (pattern, 0, size);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (pattern);
+}
+
+
+/*!
+ * \brief Allocate memory and initialize data fields in a
+ * \c DxfLTypePattern.
+ *
+ * The pattern is initialized as a continuous line.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfLTypePattern *
+dxf_ltype_pattern_init
+(
+        DxfLTypePattern *pattern
+                /*!< a pointer to the linetype pattern. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (pattern == NULL)
+        {
+                fprintf (stderr,
+                  (_("Warning in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                pattern = dxf_ltype_pattern_new ();
+        }
+        if (pattern == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        pattern->number_of_elements = 0;
+        pattern->max_number_of_elements = 0;
+        pattern->dash_length = NULL;
+        pattern->cumulative_length = NULL;
+        pattern->pattern_length = 0.0;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (pattern);
+}
+
+
+/*!
+ * \brief Compile a dash pattern of any length into a
+ * \c DxfLTypePattern.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_ltype_pattern_set
+(
+        DxfLTypePattern *pattern,
+                /*!< a pointer to the linetype pattern. */
+        const double *dash_length,
+                /*!< array of element lengths, positive for a dash,
+                 * zero for a dot and negative for a space. */
+        int number_of_elements
+                /*!< number of elements, 0 for a continuous line. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        double *lengths = NULL;
+        double *cumulative = NULL;
+        double total;
+        int i;
+
+        /* Do some basic checks. */
+        if ((pattern == NULL)
+          || ((dash_length == NULL) && (number_of_elements > 0)))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (number_of_elements > pattern->max_number_of_elements)
+        {
+                lengths = realloc (pattern->dash_length, number_of_elements * sizeof (double));
+                if (lengths != NULL)
+                {
+                        pattern->dash_length = lengths;
+                }
+                cumulative = realloc (pattern->cumulative_length, number_of_elements * sizeof (double));
+                if (cumulative != NULL)
+                {
+                        pattern->cumulative_length = cumulative;
+                }
+                if ((lengths == NULL) || (cumulative == NULL))
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () could not allocate memory.\n")),
+                          __FUNCTION__);
+                        return (EXIT_FAILURE);
+                }
+                pattern->max_number_of_elements = number_of_elements;
+        }
+        total = 0.0;
+        for (i = 0; i < number_of_elements; i++)
+        {
+                pattern->dash_length[i] = dash_length[i];
+                total += fabs (dash_length[i]);
+                pattern->cumulative_length[i] = total;
+        }
+        pattern->number_of_elements = number_of_elements;
+        pattern->pattern_length = total;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Compile the dash pattern of a DXF \c LTYPE symbol table entry
+ * into a \c DxfLTypePattern.
+ *
+ * Embedded shapes and text strings of complex linetypes are not
+ * drawn, their elements only contribute their dash length.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_ltype_pattern_set_from_ltype
+(
+        DxfLTypePattern *pattern,
+                /*!< a pointer to the linetype pattern. */
+        DxfLType *ltype
+                /*!< a pointer to a DXF \c LTYPE symbol table entry. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        int number_of_elements;
+
+        /* Do some basic checks. */
+        if ((pattern == NULL) || (ltype == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        number_of_elements = ltype->number_of_linetype_elements;
+        if (number_of_elements > DXF_MAX_NUMBER_OF_DASH_LENGTH_ITEMS)
+        {
+                fprintf (stderr,
+                  (_("Warning in %s () only the first %d elements of linetype %s are used.\n")),
+                  __FUNCTION__, DXF_MAX_NUMBER_OF_DASH_LENGTH_ITEMS, ltype->linetype_name);
+                number_of_elements = DXF_MAX_NUMBER_OF_DASH_LENGTH_ITEMS;
+        }
+        if (number_of_elements < 0)
+        {
+                number_of_elements = 0;
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (dxf_ltype_pattern_set (pattern, ltype->dash_length, number_of_elements));
+}
+
+
+/*!
+ * \brief Get the element of a \c DxfLTypePattern at a given phase.
+ *
+ * \return the index of the first element ending beyond \c phase.
+ */
+int
+dxf_ltype_pattern_get_element
+(
+        DxfLTypePattern *pattern,
+                /*!< a pointer to the linetype pattern. */
+        double phase
+                /*!< position in the pattern, from 0.0 up to the
+                 * pattern length. */
+)
+{
+        int low;
+        int high;
+        int middle;
+
+        /* Do some basic checks. */
+        if ((pattern == NULL) || (pattern->number_of_elements < 1))
+        {
+                return (0);
+        }
+        low = 0;
+        high = pattern->number_of_elements - 1;
+        while (low < high)
+        {
+                middle = (low + high) / 2;
+                if (pattern->cumulative_length[middle] > phase)
+                {
+                        high = middle;
+                }
+                else
+                {
+                        low = middle + 1;
+                }
+        }
+        return (low);
+}
+
+
+/*!
+ * \brief Apply a \c DxfLTypePattern to a single path.
+ *
+ * The phase is carried over from segment to segment, so dashes
+ * continue around the vertices of the path.\n
+ * A \c NULL pattern, a continuous pattern, or a pattern that would
+ * repeat more than \c DXF_LTYPE_PATTERN_MAX_REPEATS times along the
+ * path results in a copy of the path.\n
+ * The pattern is not adjusted to start and end the path with a dash.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred or \c dashes overflowed.
+ */
+int
+dxf_ltype_pattern_apply_path
+(
+        DxfLTypePattern *pattern,
+                /*!< a pointer to the linetype pattern, or \c NULL
+                 * for a continuous line. */
+        const double *x,
+                /*!< array of X-coordinates of the path. */
+        const double *y,
+                /*!< array of Y-coordinates of the path. */
+        int number_of_vertices,
+                /*!< number of vertices of the path. */
+        double scale,
+                /*!< linetype scale of the entity (group code 48)
+                 * times the global linetype scale. */
+        double *phase,
+                /*!< position in the pattern (at scale 1.0) at the
+                 * start of the path, receives the position at the end
+                 * of the path, or \c NULL to start at the beginning of
+                 * the pattern. */
+        DxfFlattenBuffer *dashes
+                /*!< buffer receiving a path for each dash. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        double length;
+        double segment_length;
+        double remaining;
+        double position;
+        double distance;
+        double dx;
+        double dy;
+        int in_dash;
+        int element;
+        int i;
+
+        /* Do some basic checks. */
+        if ((x == NULL) || (y == NULL) || (dashes == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (number_of_vertices < 1)
+        {
+                return (EXIT_SUCCESS);
+        }
+        scale = fabs (scale);
+        if (scale == 0.0)
+        {
+                scale = 1.0;
+        }
+        length = 0.0;
+        if ((pattern != NULL) && (pattern->pattern_length > 0.0))
+        {
+                for (i = 0; i + 1 < number_of_vertices; i++)
+                {
+                        length += hypot (x[i + 1] - x[i], y[i + 1] - y[i]);
+                }
+        }
+        if ((pattern == NULL)
+          || (pattern->pattern_length <= 0.0)
+          || (length / (pattern->pattern_length * scale) > DXF_LTYPE_PATTERN_MAX_REPEATS))
+        {
+                dxf_flatten_buffer_begin_path (dashes);
+                for (i = 0; i < number_of_vertices; i++)
+                {
+                        dxf_flatten_buffer_append (dashes, x[i], y[i]);
+                }
+                return (dxf_flatten_buffer_is_overflowed (dashes) ? EXIT_FAILURE : EXIT_SUCCESS);
+        }
+        /* Work in pattern units (at scale 1.0). */
+        position = (phase != NULL) ? fmod (*phase, pattern->pattern_length) : 0.0;
+        if (position < 0.0)
+        {
+                position += pattern->pattern_length;
+        }
+        element = dxf_ltype_pattern_get_element (pattern, position);
+        in_dash = FALSE;
+        for (i = 0; i + 1 < number_of_vertices; i++)
+        {
+                dx = x[i + 1] - x[i];
+                dy = y[i + 1] - y[i];
+                segment_length = hypot (dx, dy) / scale;
+                if (segment_length == 0.0)
+                {
+                        continue;
+                }
+                distance = 0.0;
+                while (distance < segment_length)
+                {
+                        if (pattern->dash_length[element] == 0.0)
+                        {
+                                /* A dot. */
+                                dxf_flatten_buffer_begin_path (dashes);
+                                dxf_flatten_buffer_append (dashes,
+                                  x[i] + (dx * distance / segment_length),
+                                  y[i] + (dy * distance / segment_length));
+                        }
+                        else
+                        {
+                                if ((pattern->dash_length[element] > 0.0) && !in_dash)
+                                {
+                                        dxf_flatten_buffer_begin_path (dashes);
+                                        dxf_flatten_buffer_append (dashes,
+                                          x[i] + (dx * distance / segment_length),
+                                          y[i] + (dy * distance / segment_length));
+                                        in_dash = TRUE;
+                                }
+                                remaining = pattern->cumulative_length[element] - position;
+                                if (remaining < 0.0)
+                                {
+                                        remaining = 0.0;
+                                }
+                                if (remaining > segment_length - distance)
+                                {
+                                        /* The element continues on the
+                                         * next segment. */
+                                        position += segment_length - distance;
+                                        break;
+                                }
+                                distance += remaining;
+                                if (in_dash)
+                                {
+                                        dxf_flatten_buffer_append (dashes,
+                                          x[i] + (dx * distance / segment_length),
+                                          y[i] + (dy * distance / segment_length));
+                                        in_dash = FALSE;
+                                }
+                        }
+                        /* Next element. */
+                        element++;
+                        if (element == pattern->number_of_elements)
+                        {
+                                element = 0;
+                                position = 0.0;
+                        }
+                        else
+                        {
+                                position = pattern->cumulative_length[element - 1];
+                        }
+                }
+                if (in_dash)
+                {
+                        dxf_flatten_buffer_append (dashes, x[i + 1], y[i + 1]);
+                }
+        }
+        if (phase != NULL)
+        {
+                *phase = position;
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (dxf_flatten_buffer_is_overflowed (dashes) ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Apply a \c DxfLTypePattern to all paths in a
+ * \c DxfFlattenBuffer, e.g. a flattened entity.
+ *
+ * Each path starts at the beginning of the pattern.\n
+ * When \c dashes overflowed, its counts hold the required sizes and
+ * the call can be repeated after dxf_flatten_buffer_reserve ().
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred or \c dashes overflowed.
+ */
+int
+dxf_ltype_pattern_apply
+(
+        DxfLTypePattern *pattern,
+                /*!< a pointer to the linetype pattern, or \c NULL
+                 * for a continuous line. */
+        DxfFlattenBuffer *path,
+                /*!< buffer holding the flattened paths, with path
+                 * starts. */
+        double scale,
+                /*!< linetype scale of the entity (group code 48)
+                 * times the global linetype scale. */
+        DxfFlattenBuffer *dashes
+                /*!< buffer receiving a path for each dash. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        int first;
+        int number_of_vertices;
+        int i;
+
+        /* Do some basic checks. */
+        if ((path == NULL) || (dashes == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (dxf_flatten_buffer_is_overflowed (path))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () an overflowed buffer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (path->path_start == NULL)
+        {
+                /* A single path. */
+                dxf_ltype_pattern_apply_path (pattern, path->x, path->y,
+                  path->number_of_vertices, scale, NULL, dashes);
+        }
+        else
+        {
+                for (i = 0; i < path->number_of_paths; i++)
+                {
+                        first = path->path_start[i];
+                        number_of_vertices = dxf_flatten_buffer_get_path_size (path, i);
+                        dxf_ltype_pattern_apply_path (pattern,
+                          path->x + first, path->y + first,
+                          number_of_vertices, scale, NULL, dashes);
+                }
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (dxf_flatten_buffer_is_overflowed (dashes) ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Clear the contents of a \c DxfLTypePattern, the pattern itself
+ * is not freed.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_ltype_pattern_clear
+(
+        DxfLTypePattern *pattern
+                /*!< a pointer to the linetype pattern. */
+)
+{
+        /* Do some basic checks. */
+        if (pattern == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        free (pattern->dash_length);
+        free (pattern->cumulative_length);
+        pattern->dash_length = NULL;
+        pattern->cumulative_length = NULL;
+        pattern->number_of_elements = 0;
+        pattern->max_number_of_elements = 0;
+        pattern->pattern_length = 0.0;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Free the allocated memory for a \c DxfLTypePattern and its
+ * arrays.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_ltype_pattern_free
+(
+        DxfLTypePattern *pattern
+                /*!< a pointer to the linetype pattern. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (pattern == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_ltype_pattern_clear (pattern);
+        free (pattern);
+        pattern = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Allocate memory for a \c DxfLTypePatternTable.
+ *
+ * Fill the memory contents with zeros.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfLTypePatternTable *
+dxf_ltype_pattern_table_new ()
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfLTypePatternTable *table = NULL;
+        size_t size;
+
+        size = sizeof (DxfLTypePatternTable);
+        /* avoid malloc of 0 bytes */
+        if (size == 0) size = 1;
+        if ((table = malloc (size)) == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                table = NULL;
+        }
+        else
+        {
+                memset (table, 0, size);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (table);
+}
+
+
+/*!
+ * \brief Allocate memory and initialize data fields in a
+ * \c DxfLTypePatternTable.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfLTypePatternTable *
+dxf_ltype_pattern_table_init
+(
+        DxfLTypePatternTable *table
+                /*!< a pointer to the linetype pattern table. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (table == NULL)
+        {
+                fprintf (stderr,
+                  (_("Warning in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                table = dxf_ltype_pattern_table_new ();
+        }
+        if (table == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        table->number_of_patterns = 0;
+        table->patterns = NULL;
+        table->number_of_slots = 0;
+        table->linetype_name = NULL;
+        table->linetype_pattern = NULL;
+        table->layer_name = NULL;
+        table->layer_pattern = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (table);
+}
+
+
+/*!
+ * \brief Build a \c DxfLTypePatternTable from single linked lists of
+ * DXF \c LTYPE and \c LAYER symbol table entries.
+ *
+ * Every linetype is compiled once, and the linetype of every layer is
+ * looked up once, so resolving the linetype of an entity takes a
+ * single hash lookup.\n
+ * Any previous contents of the table are cleared, the names are
+ * copied.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_ltype_pattern_table_build
+(
+        DxfLTypePatternTable *table,
+                /*!< a pointer to the linetype pattern table. */
+        DxfLType *ltypes,
+                /*!< a pointer to a single linked list of DXF \c LTYPE
+                 * symbol table entries. */
+        DxfLayer *layers
+                /*!< a pointer to a single linked list of DXF \c LAYER
+                 * symbol table entries. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfLType *ltype = NULL;
+        DxfLayer *layer = NULL;
+        int number_of_ltypes;
+        int number_of_layers;
+        int slot;
+        int linetype_slot;
+
+        /* Do some basic checks. */
+        if (table == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_ltype_pattern_table_clear (table);
+        number_of_ltypes = 0;
+        for (ltype = ltypes; ltype != NULL; ltype = (DxfLType *) ltype->next)
+        {
+                number_of_ltypes++;
+        }
+        number_of_layers = 0;
+        for (layer = layers; layer != NULL; layer = (DxfLayer *) layer->next)
+        {
+                number_of_layers++;
+        }
+        /* Keep the load factor at or below one half. */
+        table->number_of_slots = 16;
+        while ((table->number_of_slots < 2 * number_of_ltypes)
+          || (table->number_of_slots < 2 * number_of_layers))
+        {
+                table->number_of_slots *= 2;
+        }
+        table->patterns = calloc ((number_of_ltypes > 0) ? number_of_ltypes : 1, sizeof (DxfLTypePattern));
+        table->linetype_name = calloc (table->number_of_slots, sizeof (char *));
+        table->linetype_pattern = calloc (table->number_of_slots, sizeof (int));
+        table->layer_name = calloc (table->number_of_slots, sizeof (char *));
+        table->layer_pattern = calloc (table->number_of_slots, sizeof (int));
+        if ((table->patterns == NULL)
+          || (table->linetype_name == NULL)
+          || (table->linetype_pattern == NULL)
+          || (table->layer_name == NULL)
+          || (table->layer_pattern == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                dxf_ltype_pattern_table_clear (table);
+                return (EXIT_FAILURE);
+        }
+        for (ltype = ltypes; ltype != NULL; ltype = (DxfLType *) ltype->next)
+        {
+                if (ltype->linetype_name == NULL)
+                {
+                        continue;
+                }
+                slot = dxf_ltype_pattern_table_slot (table->linetype_name,
+                  table->number_of_slots, ltype->linetype_name);
+                if (table->linetype_name[slot] != NULL)
+                {
+                        /* A duplicate linetype name. */
+                        continue;
+                }
+                if (dxf_ltype_pattern_set_from_ltype (&table->patterns[table->number_of_patterns], ltype) != EXIT_SUCCESS)
+                {
+                        dxf_ltype_pattern_table_clear (table);
+                        return (EXIT_FAILURE);
+                }
+                table->linetype_name[slot] = strdup (ltype->linetype_name);
+                table->linetype_pattern[slot] = table->number_of_patterns;
+                table->number_of_patterns++;
+        }
+        for (layer = layers; layer != NULL; layer = (DxfLayer *) layer->next)
+        {
+                if (layer->layer_name == NULL)
+                {
+                        continue;
+                }
+                slot = dxf_ltype_pattern_table_slot (table->layer_name,
+                  table->number_of_slots, layer->layer_name);
+                if (table->layer_name[slot] != NULL)
+                {
+                        /* A duplicate layer name. */
+                        continue;
+                }
+                table->layer_name[slot] = strdup (layer->layer_name);
+                table->layer_pattern[slot] = -1;
+                if (layer->linetype != NULL)
+                {
+                        linetype_slot = dxf_ltype_pattern_table_slot (table->linetype_name,
+                          table->number_of_slots, layer->linetype);
+                        if (table->linetype_name[linetype_slot] != NULL)
+                        {
+                                table->layer_pattern[slot] = table->linetype_pattern[linetype_slot];
+                        }
+                }
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Resolve the effective linetype pattern of an entity.
+ *
+ * A linetype \c BYLAYER (or no linetype) is resolved through the layer
+ * of the entity, \c BYBLOCK gets the pattern of the inserting block
+ * reference.\n
+ * Names are compared case insensitive.
+ *
+ * \return a pointer to the pattern, or \c NULL for a continuous line
+ * (including unknown linetypes and layers).
+ */
+DxfLTypePattern *
+dxf_ltype_pattern_table_resolve
+(
+        DxfLTypePatternTable *table,
+                /*!< a pointer to the linetype pattern table. */
+        const char *linetype,
+                /*!< the linetype of the entity (group code 6). */
+        const char *layer_name,
+                /*!< the layer of the entity (group code 8). */
+        DxfLTypePattern *block_pattern
+                /*!< the pattern for \c BYBLOCK linetypes. */
+)
+{
+        DxfLTypePattern *pattern = NULL;
+        int slot;
+
+        /* Do some basic checks. */
+        if (table == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        if (table->number_of_slots == 0)
+        {
+                return (NULL);
+        }
+        if ((linetype != NULL) && (strcasecmp (linetype, "BYBLOCK") == 0))
+        {
+                return (block_pattern);
+        }
+        if ((linetype == NULL)
+          || (linetype[0] == '\0')
+          || (strcasecmp (linetype, "BYLAYER") == 0))
+        {
+                if (layer_name == NULL)
+                {
+                        layer_name = DXF_DEFAULT_LAYER;
+                }
+                slot = dxf_ltype_pattern_table_slot (table->layer_name,
+                  table->number_of_slots, layer_name);
+                if ((table->layer_name[slot] != NULL)
+                  && (table->layer_pattern[slot] >= 0))
+                {
+                        pattern = &table->patterns[table->layer_pattern[slot]];
+                }
+        }
+        else
+        {
+                slot = dxf_ltype_pattern_table_slot (table->linetype_name,
+                  table->number_of_slots, linetype);
+                if (table->linetype_name[slot] != NULL)
+                {
+                        pattern = &table->patterns[table->linetype_pattern[slot]];
+                }
+        }
+        if ((pattern != NULL) && (pattern->pattern_length <= 0.0))
+        {
+                pattern = NULL;
+        }
+        return (pattern);
+}
+
+
+/*!
+ * \brief Clear the contents of a \c DxfLTypePatternTable, the table
+ * itself is not freed.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_ltype_pattern_table_clear
+(
+        DxfLTypePatternTable *table
+                /*!< a pointer to the linetype pattern table. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        int i;
+
+        /* Do some basic checks. */
+        if (table == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (table->patterns != NULL)
+        {
+                for (i = 0; i < table->number_of_patterns; i++)
+                {
+                        dxf_ltype_pattern_clear (&table->patterns[i]);
+                }
+        }
+        for (i = 0; i < table->number_of_slots; i++)
+        {
+                if (table->linetype_name != NULL)
+                {
+                        free (table->linetype_name[i]);
+                }
+                if (table->layer_name != NULL)
+                {
+                        free (table->layer_name[i]);
+                }
+        }
+        free (table->patterns);
+        free (table->linetype_name);
+        free (table->linetype_pattern);
+        free (table->layer_name);
+        free (table->layer_pattern);
+        table->number_of_patterns = 0;
+        table->patterns = NULL;
+        table->number_of_slots = 0;
+        table->linetype_name = NULL;
+        table->linetype_pattern = NULL;
+        table->layer_name = NULL;
+        table->layer_pattern = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Free the allocated memory for a \c DxfLTypePatternTable and
+ * all it's data fields.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_ltype_pattern_table_free
+(
+        DxfLTypePatternTable *table
+                /*!< a pointer to the linetype pattern table. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (table == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_ltype_pattern_table_clear (table);
+        free (table);
+        table = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Case insensitive FNV-1a hash of a linetype or layer name.
+ */
+static unsigned int
+dxf_ltype_pattern_table_hash
+(
+        const char *name
+                /*!< the name to hash. */
+)
+{
+        unsigned int hash = 2166136261u;
+
+        while (*name != '\0')
+        {
+                hash ^= (unsigned char) toupper ((unsigned char) *name);
+                hash *= 16777619u;
+                name++;
+        }
+        return (hash);
+}
+
+
+/*!
+ * \brief Find the slot of a name in an open addressing hash table.
+ *
+ * \return the slot holding \c name, or the empty slot where \c name
+ * would be inserted.
+ */
+static int
+dxf_ltype_pattern_table_slot
+(
+        char **names,
+                /*!< the names in the slots of the hash table. */
+        int number_of_slots,
+                /*!< number of slots, a power of 2. */
+        const char *name
+                /*!< the name to find. */
+)
+{
+        unsigned int slot;
+
+        slot = dxf_ltype_pattern_table_hash (name) & (number_of_slots - 1);
+        while ((names[slot] != NULL)
+          && (strcasecmp (names[slot], name) != 0))
+        {
+                slot = (slot + 1) & (number_of_slots - 1);
+        }
+        return ((int) slot);
+}
+
+
+/* EOF */
@@ -0,0 +1,135 @@
+/*!
+ * \file ltype_pattern.h
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Header file for applying DXF linetype (\c LTYPE) dash
+ * patterns to flattened geometry.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#ifndef LIBDXF_SRC_LTYPE_PATTERN_H
+#define LIBDXF_SRC_LTYPE_PATTERN_H
+
+
+#include "global.h"
+#include "flatten.h"
+#include "layer.h"
+#include "ltype.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define DXF_LTYPE_PATTERN_MAX_REPEATS 100000
+        /*!< \brief The maximum number of pattern repeats along a single
+         * path, a path needing more repeats is drawn continuous. */
+
+
+/*!
+ * \brief Definition of a compiled linetype dash pattern.
+ *
+ * The elements are stored in arrays of arbitrary length together with
+ * the cumulative pattern length at the end of each element, so that
+ * the element at any phase in the pattern is found with a binary
+ * search.
+ */
+typedef struct
+dxf_ltype_pattern_struct
+{
+        int number_of_elements;
+                /*!< Number of dash, dot and space elements. */
+        int max_number_of_elements;
+                /*!< Number of elements that fit in the arrays. */
+        double *dash_length;
+                /*!< Length of each element in drawing units (at scale
+                 * 1.0), positive for a dash, zero for a dot and
+                 * negative for a space. */
+        double *cumulative_length;
+                /*!< Pattern length at the end of each element. */
+        double pattern_length;
+                /*!< Total length of the pattern, zero for a continuous
+                 * line. */
+} DxfLTypePattern;
+
+
+/*!
+ * \brief Definition of a lookup table of compiled linetype patterns by
+ * linetype name and by layer name.
+ */
+typedef struct
+dxf_ltype_pattern_table_struct
+{
+        int number_of_patterns;
+                /*!< Number of compiled patterns. */
+        DxfLTypePattern *patterns;
+                /*!< Array of compiled patterns. */
+        int number_of_slots;
+                /*!< Number of slots in both hash tables, a power of 2. */
+        char **linetype_name;
+                /*!< Linetype name in each slot, \c NULL for an empty
+                 * slot. */
+        int *linetype_pattern;
+                /*!< Pattern index for the linetype in each slot. */
+        char **layer_name;
+                /*!< Layer name in each slot, \c NULL for an empty
+                 * slot. */
+        int *layer_pattern;
+                /*!< Pattern index for the layer in each slot, -1 for a
+                 * continuous linetype. */
+} DxfLTypePatternTable;
+
+
+DxfLTypePattern *dxf_ltype_pattern_new ();
+DxfLTypePattern *dxf_ltype_pattern_init (DxfLTypePattern *pattern);
+int dxf_ltype_pattern_set (DxfLTypePattern *pattern, const double *dash_length, int number_of_elements);
+int dxf_ltype_pattern_set_from_ltype (DxfLTypePattern *pattern, DxfLType *ltype);
+int dxf_ltype_pattern_get_element (DxfLTypePattern *pattern, double phase);
+int dxf_ltype_pattern_apply_path (DxfLTypePattern *pattern, const double *x, const double *y, int number_of_vertices, double scale, double *phase, DxfFlattenBuffer *dashes);
+int dxf_ltype_pattern_apply (DxfLTypePattern *pattern, DxfFlattenBuffer *path, double scale, DxfFlattenBuffer *dashes);
+int dxf_ltype_pattern_clear (DxfLTypePattern *pattern);
+int dxf_ltype_pattern_free (DxfLTypePattern *pattern);
+DxfLTypePatternTable *dxf_ltype_pattern_table_new ();
+DxfLTypePatternTable *dxf_ltype_pattern_table_init (DxfLTypePatternTable *table);
+int dxf_ltype_pattern_table_build (DxfLTypePatternTable *table, DxfLType *ltypes, DxfLayer *layers);
+DxfLTypePattern *dxf_ltype_pattern_table_resolve (DxfLTypePatternTable *table, const char *linetype, const char *layer_name, DxfLTypePattern *block_pattern);
+int dxf_ltype_pattern_table_clear (DxfLTypePatternTable *table);
+int dxf_ltype_pattern_table_free (DxfLTypePatternTable *table);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* LIBDXF_SRC_LTYPE_PATTERN_H */
+
+
+/* EOF */
@@ -44,6 +44,8 @@
 
 
 #include "lwpolyline.h"
+#include "stats.h"
+#include "util.h"
 
 
 /*!
@@ -75,6 +77,7 @@ dxf_lwpolyline_new ()
         else
         {
                 memset (lwpolyline, 0, size);
+                dxf_stats_count_allocation (LWPOLYLINE, size);
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -116,8 +119,8 @@ dxf_lwpolyline_init
               return (NULL);
         }
         lwpolyline->id_code = 0;
-        lwpolyline->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        lwpolyline->layer = strdup (DXF_DEFAULT_LAYER);
+        lwpolyline->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        lwpolyline->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         lwpolyline->elevation = 0.0;
         lwpolyline->thickness = 0.0;
         lwpolyline->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
@@ -130,8 +133,8 @@ dxf_lwpolyline_init
         lwpolyline->extr_x0 = 0.0;
         lwpolyline->extr_y0 = 0.0;
         lwpolyline->extr_z0 = 0.0;
-        lwpolyline->dictionary_owner_soft = strdup ("");
-        lwpolyline->dictionary_owner_hard = strdup ("");
+        lwpolyline->dictionary_owner_soft = dxf_string_share ("");
+        lwpolyline->dictionary_owner_hard = dxf_string_share ("");
         lwpolyline->vertices = (struct DxfVertex *) dxf_vertex_new ();
         lwpolyline->next = NULL;
 #if DEBUG
@@ -209,14 +212,12 @@ dxf_lwpolyline_read
                 {
                         /* Now follows a string containing a linetype
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", lwpolyline->linetype);
+                        dxf_read_string (fp, &lwpolyline->linetype);
                 }
                 else if (strcmp (temp_string, "8") == 0)
                 {
                         /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", lwpolyline->layer);
+                        dxf_read_string (fp, &lwpolyline->layer);
                 }
                 else if (strcmp (temp_string, "10") == 0)
                 {
@@ -359,15 +360,13 @@ dxf_lwpolyline_read
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", lwpolyline->dictionary_owner_soft);
+                        dxf_read_string (fp, &lwpolyline->dictionary_owner_soft);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", lwpolyline->dictionary_owner_hard);
+                        dxf_read_string (fp, &lwpolyline->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "999") == 0)
                 {
@@ -390,11 +389,13 @@ dxf_lwpolyline_read
         /* Handle omitted members and/or illegal values. */
         if (strcmp (lwpolyline->linetype, "") == 0)
         {
-                lwpolyline->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (lwpolyline->linetype);
+                lwpolyline->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (lwpolyline->layer, "") == 0)
         {
-                lwpolyline->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (lwpolyline->layer);
+                lwpolyline->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Clean up. */
         free (temp_string);
@@ -474,7 +475,8 @@ dxf_lwpolyline_write
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                lwpolyline->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (lwpolyline->linetype);
+                lwpolyline->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (lwpolyline->layer, "") == 0)
         {
@@ -484,7 +486,8 @@ dxf_lwpolyline_write
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0\n")),
                   dxf_entity_name);
-                lwpolyline->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (lwpolyline->layer);
+                lwpolyline->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Start writing output. */
         fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
@@ -619,8 +622,11 @@ dxf_lwpolyline_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (lwpolyline->linetype);
-        free (lwpolyline->layer);
+        dxf_string_free (lwpolyline->linetype);
+        dxf_string_free (lwpolyline->layer);
+        dxf_string_free (lwpolyline->color_name);
+        dxf_string_free (lwpolyline->material);
+        dxf_string_free (lwpolyline->plot_style_name);
         free (lwpolyline);
         lwpolyline = NULL;
 #if DEBUG
@@ -792,6 +798,8 @@ dxf_lwpolyline_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (lwpolyline == NULL)
         {
@@ -807,7 +815,13 @@ dxf_lwpolyline_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        lwpolyline->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (lwpolyline->linetype);
+        lwpolyline->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -867,6 +881,8 @@ dxf_lwpolyline_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (lwpolyline == NULL)
         {
@@ -882,7 +898,13 @@ dxf_lwpolyline_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        lwpolyline->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (lwpolyline->layer);
+        lwpolyline->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1673,6 +1695,8 @@ dxf_lwpolyline_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (lwpolyline == NULL)
         {
@@ -1688,7 +1712,13 @@ dxf_lwpolyline_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        lwpolyline->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (lwpolyline->dictionary_owner_soft);
+        lwpolyline->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1756,6 +1786,8 @@ dxf_lwpolyline_set_material
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (lwpolyline == NULL)
         {
@@ -1771,7 +1803,13 @@ dxf_lwpolyline_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        lwpolyline->material = strdup (material);
+        copy = dxf_string_share (material);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (lwpolyline->material);
+        lwpolyline->material = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1836,6 +1874,8 @@ dxf_lwpolyline_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (lwpolyline == NULL)
         {
@@ -1851,7 +1891,13 @@ dxf_lwpolyline_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        lwpolyline->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (lwpolyline->dictionary_owner_hard);
+        lwpolyline->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1981,6 +2027,8 @@ dxf_lwpolyline_set_plot_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (lwpolyline == NULL)
         {
@@ -1996,7 +2044,13 @@ dxf_lwpolyline_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        lwpolyline->plot_style_name = strdup (plot_style_name);
+        copy = dxf_string_share (plot_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (lwpolyline->plot_style_name);
+        lwpolyline->plot_style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2126,6 +2180,8 @@ dxf_lwpolyline_set_color_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (lwpolyline == NULL)
         {
@@ -2141,7 +2197,13 @@ dxf_lwpolyline_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        lwpolyline->color_name = strdup (color_name);
+        copy = dxf_string_share (color_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (lwpolyline->color_name);
+        lwpolyline->color_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
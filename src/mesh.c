@@ -35,6 +35,8 @@
 
 
 #include "mesh.h"
+#include "stats.h"
+#include "util.h"
 
 
 /*!
@@ -67,6 +69,7 @@ dxf_mesh_new ()
         else
         {
                 memset (mesh, 0, size);
+                dxf_stats_count_allocation (MESH, size);
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -108,8 +111,8 @@ dxf_mesh_init
                 return (NULL);
         }
         mesh->id_code = 0;
-        mesh->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        mesh->layer = strdup (DXF_DEFAULT_LAYER);
+        mesh->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        mesh->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         mesh->elevation = 0.0;
         mesh->thickness = 0.0;
         mesh->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
@@ -118,19 +121,17 @@ dxf_mesh_init
         mesh->paperspace = DXF_MODELSPACE;
         mesh->graphics_data_size = 0;
         mesh->shadow_mode = 0;
-        mesh->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_new ();
-        mesh->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_init (mesh->binary_graphics_data);
-        mesh->dictionary_owner_soft = strdup ("");
-        mesh->object_owner_soft = strdup ("");
-        mesh->material = strdup ("");
-        mesh->dictionary_owner_hard = strdup ("");
+        mesh->binary_graphics_data = NULL;
+        mesh->dictionary_owner_soft = dxf_string_share ("");
+        mesh->object_owner_soft = dxf_string_share ("");
+        mesh->material = dxf_string_share ("");
+        mesh->dictionary_owner_hard = dxf_string_share ("");
         mesh->lineweight = 0;
-        mesh->plot_style_name = strdup ("");
+        mesh->plot_style_name = dxf_string_share ("");
         mesh->color_value = 0;
-        mesh->color_name = strdup ("");
+        mesh->color_name = dxf_string_share ("");
         mesh->transparency = 0;
         mesh->p0 = dxf_point_new ();
-        mesh->p0 = dxf_point_init (mesh->p0);
         mesh->p0->x0 = 0.0;
         mesh->p0->y0 = 0.0;
         mesh->p0->z0 = 0.0;
@@ -231,14 +232,12 @@ dxf_mesh_read
                 {
                         /* Now follows a string containing a linetype
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mesh->linetype);
+                        dxf_read_string (fp, &mesh->linetype);
                 }
                 else if (strcmp (temp_string, "8") == 0)
                 {
                         /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mesh->layer);
+                        dxf_read_string (fp, &mesh->layer);
                 }
                 else if (strcmp (temp_string, "10") == 0)
                 {
@@ -344,10 +343,7 @@ dxf_mesh_read
                 {
                         /* Now follows a string containing binary
                          * graphics data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", iter310->data_line);
-                        dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) iter310->next);
-                        iter310 = (DxfBinaryGraphicsData *) iter310->next;
+                        iter310 = dxf_binary_graphics_data_read (fp, &mesh->binary_graphics_data, iter310);
                 }
                 else if (strcmp (temp_string, "330") == 0)
                 {
@@ -355,15 +351,13 @@ dxf_mesh_read
                         {
                                 /* Now follows a string containing a soft-pointer
                                  * ID/handle to owner dictionary. */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%s\n", mesh->dictionary_owner_soft);
+                                dxf_read_string (fp, &mesh->dictionary_owner_soft);
                         }
                         if (iter330 == 1)
                         {
                                 /* Now follows a string containing a soft-pointer
                                  * ID/handle to owner object. */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%s\n", mesh->object_owner_soft);
+                                dxf_read_string (fp, &mesh->object_owner_soft);
                         }
                         iter330++;
                 }
@@ -371,15 +365,13 @@ dxf_mesh_read
                 {
                         /* Now follows a string containing a
                          * hard-pointer ID/handle to material object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mesh->material);
+                        dxf_read_string (fp, &mesh->material);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mesh->dictionary_owner_hard);
+                        dxf_read_string (fp, &mesh->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "370") == 0)
                 {
@@ -392,8 +384,7 @@ dxf_mesh_read
                 {
                         /* Now follows a string containing a plot style
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mesh->plot_style_name);
+                        dxf_read_string (fp, &mesh->plot_style_name);
                 }
                 else if (strcmp (temp_string, "420") == 0)
                 {
@@ -405,8 +396,7 @@ dxf_mesh_read
                 {
                         /* Now follows a string containing a color
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mesh->color_name);
+                        dxf_read_string (fp, &mesh->color_name);
                 }
                 else if (strcmp (temp_string, "440") == 0)
                 {
@@ -432,11 +422,13 @@ dxf_mesh_read
         /* Handle omitted members and/or illegal values. */
         if (strcmp (mesh->linetype, "") == 0)
         {
-                mesh->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (mesh->linetype);
+                mesh->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (mesh->layer, "") == 0)
         {
-                mesh->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (mesh->layer);
+                mesh->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Clean up. */
         free (temp_string);
@@ -503,7 +495,8 @@ dxf_mesh_write
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                mesh->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (mesh->linetype);
+                mesh->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (mesh->layer, "") == 0)
         {
@@ -726,15 +719,18 @@ dxf_mesh_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (mesh->linetype);
-        free (mesh->layer);
-        dxf_binary_graphics_data_free_list (mesh->binary_graphics_data);
-        free (mesh->dictionary_owner_soft);
-        free (mesh->object_owner_soft);
-        free (mesh->material);
-        free (mesh->dictionary_owner_hard);
-        free (mesh->plot_style_name);
-        free (mesh->color_name);
+        dxf_string_free (mesh->linetype);
+        dxf_string_free (mesh->layer);
+        if (mesh->binary_graphics_data != NULL)
+        {
+                dxf_binary_graphics_data_free_list (mesh->binary_graphics_data);
+        }
+        dxf_string_free (mesh->dictionary_owner_soft);
+        dxf_string_free (mesh->object_owner_soft);
+        dxf_string_free (mesh->material);
+        dxf_string_free (mesh->dictionary_owner_hard);
+        dxf_string_free (mesh->plot_style_name);
+        dxf_string_free (mesh->color_name);
         dxf_point_free_list (mesh->p0);
         dxf_int32_free_list (mesh->face_list_item);
         dxf_int32_free_list (mesh->edge_vertex_index);
@@ -915,6 +911,8 @@ dxf_mesh_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (mesh == NULL)
         {
@@ -930,7 +928,13 @@ dxf_mesh_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        mesh->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (mesh->linetype);
+        mesh->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -994,6 +998,8 @@ dxf_mesh_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (mesh == NULL)
         {
@@ -1009,7 +1015,13 @@ dxf_mesh_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        mesh->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (mesh->layer);
+        mesh->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1809,6 +1821,8 @@ dxf_mesh_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (mesh == NULL)
         {
@@ -1824,7 +1838,13 @@ dxf_mesh_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        mesh->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (mesh->dictionary_owner_soft);
+        mesh->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1892,6 +1912,8 @@ dxf_mesh_set_object_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (mesh == NULL)
         {
@@ -1907,7 +1929,13 @@ dxf_mesh_set_object_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        mesh->object_owner_soft = strdup (object_owner_soft);
+        copy = dxf_string_share (object_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (mesh->object_owner_soft);
+        mesh->object_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1974,6 +2002,8 @@ dxf_mesh_set_material
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (mesh == NULL)
         {
@@ -1989,7 +2019,13 @@ dxf_mesh_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        mesh->material = strdup (material);
+        copy = dxf_string_share (material);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (mesh->material);
+        mesh->material = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2057,6 +2093,8 @@ dxf_mesh_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (mesh == NULL)
         {
@@ -2072,7 +2110,13 @@ dxf_mesh_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        mesh->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (mesh->dictionary_owner_hard);
+        mesh->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2202,6 +2246,8 @@ dxf_mesh_set_plot_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (mesh == NULL)
         {
@@ -2217,7 +2263,13 @@ dxf_mesh_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        mesh->plot_style_name = strdup (plot_style_name);
+        copy = dxf_string_share (plot_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (mesh->plot_style_name);
+        mesh->plot_style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2347,6 +2399,8 @@ dxf_mesh_set_color_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (mesh == NULL)
         {
@@ -2362,7 +2416,13 @@ dxf_mesh_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        mesh->color_name = strdup (color_name);
+        copy = dxf_string_share (color_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (mesh->color_name);
+        mesh->color_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -0,0 +1,1511 @@
+/*!
+ * \file mesh_subdivision.c
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Functions for compressed sparse row storage and
+ * Catmull-Clark subdivision of DXF meshes (\c MESH).
+ *
+ * The face list, edge list and crease list of a \c MESH entity are
+ * single linked lists of values, which are converted once into flat
+ * arrays (compressed sparse rows).\n
+ * Every subdivision level computes the face points, edge points and
+ * vertex points in three passes over flat arrays, each pass divided over
+ * a number of threads.\n
+ * Creased edges follow the semi-sharp crease rules: an edge with a crease
+ * value of \c s is sharp for \c s levels, with a fractional remainder
+ * blending between the smooth and the sharp rules, boundary edges are
+ * always sharp.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include <pthread.h>
+
+#include "mesh_subdivision.h"
+
+
+#define DXF_MESH_SUBDIVISION_FACE_PASS 0
+        /*!< \brief Compute the face points. */
+
+#define DXF_MESH_SUBDIVISION_EDGE_PASS 1
+        /*!< \brief Compute the edge points. */
+
+#define DXF_MESH_SUBDIVISION_VERTEX_PASS 2
+        /*!< \brief Compute the vertex points. */
+
+
+/*!
+ * \brief A directed edge of a face, used for finding the unique
+ * edges.
+ */
+typedef struct
+dxf_mesh_subdivision_half_edge_struct
+{
+        int a;
+                /*!< Lowest vertex index of the edge. */
+        int b;
+                /*!< Highest vertex index of the edge. */
+        int corner;
+                /*!< Face corner the edge starts at. */
+} DxfMeshSubdivisionHalfEdge;
+
+
+/*!
+ * \brief The topology of a single subdivision level.
+ *
+ * The result vertices are numbered: the vertex points first, then the
+ * edge points and then the face points.
+ */
+typedef struct
+dxf_mesh_subdivision_level_struct
+{
+        DxfMeshCsr *csr;
+                /*!< The mesh to subdivide. */
+        DxfMeshCsr *result;
+                /*!< The subdivided mesh. */
+        int number_of_edges;
+                /*!< Number of unique edges. */
+        int *edge_v0;
+                /*!< Lowest vertex index of each edge. */
+        int *edge_v1;
+                /*!< Highest vertex index of each edge. */
+        int *edge_f0;
+                /*!< First face of each edge. */
+        int *edge_f1;
+                /*!< Second face of each edge, -1 when none. */
+        int *edge_number_of_faces;
+                /*!< Number of faces of each edge, an edge with other
+                 * than two faces is sharp. */
+        double *edge_sharpness;
+                /*!< Crease value of each edge. */
+        int *corner_face;
+                /*!< Face of each face corner. */
+        int *corner_edge;
+                /*!< Edge from each face corner to the next corner. */
+        int *vertex_edge_start;
+                /*!< Index of the first edge of each vertex in
+                 * \c vertex_edges, with an extra entry at the end. */
+        int *vertex_edges;
+                /*!< Edges of all vertices. */
+        int *vertex_face_start;
+                /*!< Index of the first face of each vertex in
+                 * \c vertex_faces, with an extra entry at the end. */
+        int *vertex_faces;
+                /*!< Faces of all vertices. */
+} DxfMeshSubdivisionLevel;
+
+
+/*!
+ * \brief Work item for a thread in a subdivision pass.
+ */
+typedef struct
+dxf_mesh_subdivision_job_struct
+{
+        DxfMeshSubdivisionLevel *level;
+                /*!< The subdivision level. */
+        int pass;
+                /*!< The pass. */
+        int begin;
+                /*!< First item of this job. */
+        int end;
+                /*!< One past the last item of this job. */
+} DxfMeshSubdivisionJob;
+
+
+static int dxf_mesh_subdivision_compare_half_edges (const void *a, const void *b);
+static int dxf_mesh_subdivision_find_edge (DxfMeshSubdivisionLevel *level, int a, int b);
+static int dxf_mesh_subdivision_build_level (DxfMeshSubdivisionLevel *level);
+static void dxf_mesh_subdivision_free_level (DxfMeshSubdivisionLevel *level);
+static int dxf_mesh_subdivision_run_pass (DxfMeshSubdivisionLevel *level, int pass, int number_of_items, int number_of_threads);
+static void *dxf_mesh_subdivision_run_job (void *data);
+static void dxf_mesh_subdivision_face_points (DxfMeshSubdivisionLevel *level, int begin, int end);
+static void dxf_mesh_subdivision_edge_points (DxfMeshSubdivisionLevel *level, int begin, int end);
+static void dxf_mesh_subdivision_vertex_points (DxfMeshSubdivisionLevel *level, int begin, int end);
+
+
+/*!
+ * \brief Allocate memory for a \c DxfMeshCsr.
+ *
+ * Fill the memory contents with zeros.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfMeshCsr *
+dxf_mesh_csr_new ()
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfMeshCsr *csr = NULL;
+        size_t size;
+
+        size = sizeof (DxfMeshCsr);
+        /* avoid malloc of 0 bytes */
+        if (size == 0) size = 1;
+        if ((csr = malloc (size)) == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                csr = NULL;
+        }
+        else
+        {
+                memset (csr, 0, size);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (csr);
+}
+
+
+/*!
+ * \brief Allocate memory and initialize data fields in a
+ * \c DxfMeshCsr.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfMeshCsr *
+dxf_mesh_csr_init
+(
+        DxfMeshCsr *csr
+                /*!< a pointer to the mesh arrays. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (csr == NULL)
+        {
+                fprintf (stderr,
+                  (_("Warning in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                csr = dxf_mesh_csr_new ();
+        }
+        if (csr == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        csr->number_of_vertices = 0;
+        csr->x = NULL;
+        csr->y = NULL;
+        csr->z = NULL;
+        csr->number_of_faces = 0;
+        csr->face_start = NULL;
+        csr->face_vertices = NULL;
+        csr->number_of_edges = 0;
+        csr->edge_vertices = NULL;
+        csr->edge_creases = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (csr);
+}
+
+
+/*!
+ * \brief Convert the vertex list, face list and crease lists of a DXF
+ * \c MESH entity into a \c DxfMeshCsr.
+ *
+ * The face list holds for every face the number of vertices followed by
+ * the vertex indices, the edge list holds two vertex indices per edge
+ * with a crease value per edge in the crease list.\n
+ * Faces with less than three vertices are skipped, a negative crease
+ * value makes an edge always sharp.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred or a vertex index is out of range.
+ */
+int
+dxf_mesh_csr_from_mesh
+(
+        DxfMeshCsr *csr,
+                /*!< a pointer to the mesh arrays receiving the
+                 * result. */
+        DxfMesh *mesh
+                /*!< a pointer to a DXF \c MESH entity. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfPoint *point = NULL;
+        DxfInt32 *item = NULL;
+        DxfDouble *crease = NULL;
+        int number_of_items;
+        int number_of_corners;
+        int n;
+        int i;
+
+        /* Do some basic checks. */
+        if ((csr == NULL) || (mesh == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_mesh_csr_clear (csr);
+        for (point = mesh->p0; point != NULL; point = (DxfPoint *) point->next)
+        {
+                csr->number_of_vertices++;
+        }
+        number_of_items = 0;
+        for (item = mesh->face_list_item; item != NULL; item = (DxfInt32 *) item->next)
+        {
+                number_of_items++;
+        }
+        for (item = mesh->edge_vertex_index; item != NULL; item = (DxfInt32 *) item->next)
+        {
+                csr->number_of_edges++;
+        }
+        csr->number_of_edges /= 2;
+        /* The number of faces and corners is bounded by the number of
+         * items in the face list. */
+        csr->x = malloc ((csr->number_of_vertices + 1) * sizeof (double));
+        csr->y = malloc ((csr->number_of_vertices + 1) * sizeof (double));
+        csr->z = malloc ((csr->number_of_vertices + 1) * sizeof (double));
+        csr->face_start = malloc ((number_of_items + 1) * sizeof (int));
+        csr->face_vertices = malloc ((number_of_items + 1) * sizeof (int));
+        csr->edge_vertices = malloc ((2 * csr->number_of_edges + 1) * sizeof (int));
+        csr->edge_creases = malloc ((csr->number_of_edges + 1) * sizeof (double));
+        if ((csr->x == NULL) || (csr->y == NULL) || (csr->z == NULL)
+          || (csr->face_start == NULL) || (csr->face_vertices == NULL)
+          || (csr->edge_vertices == NULL) || (csr->edge_creases == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                dxf_mesh_csr_clear (csr);
+                return (EXIT_FAILURE);
+        }
+        i = 0;
+        for (point = mesh->p0; point != NULL; point = (DxfPoint *) point->next)
+        {
+                csr->x[i] = point->x0;
+                csr->y[i] = point->y0;
+                csr->z[i] = point->z0;
+                i++;
+        }
+        number_of_corners = 0;
+        csr->face_start[0] = 0;
+        item = mesh->face_list_item;
+        while (item != NULL)
+        {
+                n = item->value;
+                item = (DxfInt32 *) item->next;
+                for (i = 0; (i < n) && (item != NULL); i++)
+                {
+                        if ((item->value < 0) || (item->value >= csr->number_of_vertices))
+                        {
+                                fprintf (stderr,
+                                  (_("Error in %s () vertex index %d out of range.\n")),
+                                  __FUNCTION__, (int) item->value);
+                                dxf_mesh_csr_clear (csr);
+                                return (EXIT_FAILURE);
+                        }
+                        csr->face_vertices[number_of_corners + i] = item->value;
+                        item = (DxfInt32 *) item->next;
+                }
+                if (i >= 3)
+                {
+                        number_of_corners += i;
+                        csr->number_of_faces++;
+                        csr->face_start[csr->number_of_faces] = number_of_corners;
+                }
+        }
+        item = mesh->edge_vertex_index;
+        crease = mesh->edge_create_value;
+        for (i = 0; i < csr->number_of_edges; i++)
+        {
+                csr->edge_vertices[2 * i] = item->value;
+                item = (DxfInt32 *) item->next;
+                csr->edge_vertices[2 * i + 1] = item->value;
+                item = (DxfInt32 *) item->next;
+                if ((csr->edge_vertices[2 * i] < 0)
+                  || (csr->edge_vertices[2 * i] >= csr->number_of_vertices)
+                  || (csr->edge_vertices[2 * i + 1] < 0)
+                  || (csr->edge_vertices[2 * i + 1] >= csr->number_of_vertices))
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () edge vertex index out of range.\n")),
+                          __FUNCTION__);
+                        dxf_mesh_csr_clear (csr);
+                        return (EXIT_FAILURE);
+                }
+                if (crease != NULL)
+                {
+                        csr->edge_creases[i] = (crease->value < 0.0) ? HUGE_VAL : crease->value;
+                        crease = (DxfDouble *) crease->next;
+                }
+                else
+                {
+                        csr->edge_creases[i] = 0.0;
+                }
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Subdivide a \c DxfMeshCsr a single level with the
+ * Catmull-Clark rules.
+ *
+ * Every face of \c n vertices becomes \c n quadrilaterals, the creased
+ * edges of the result have their crease value lowered by one.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_mesh_csr_subdivide
+(
+        DxfMeshCsr *csr,
+                /*!< a pointer to the mesh arrays to subdivide. */
+        DxfMeshCsr *result,
+                /*!< a pointer to the mesh arrays receiving the result,
+                 * not the same as \c csr. */
+        int number_of_threads
+                /*!< number of threads to use. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfMeshSubdivisionLevel level;
+        int number_of_corners;
+        int number_of_vertices;
+        int number_of_creases;
+        int start;
+        int n;
+        int f;
+        int e;
+        int i;
+        int k;
+
+        /* Do some basic checks. */
+        if ((csr == NULL) || (result == NULL) || (csr == result))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_mesh_csr_clear (result);
+        memset (&level, 0, sizeof (DxfMeshSubdivisionLevel));
+        level.csr = csr;
+        level.result = result;
+        if (dxf_mesh_subdivision_build_level (&level) != EXIT_SUCCESS)
+        {
+                dxf_mesh_subdivision_free_level (&level);
+                return (EXIT_FAILURE);
+        }
+        number_of_corners = csr->face_start[csr->number_of_faces];
+        number_of_vertices = csr->number_of_vertices + level.number_of_edges + csr->number_of_faces;
+        number_of_creases = 0;
+        for (e = 0; e < level.number_of_edges; e++)
+        {
+                if ((level.edge_number_of_faces[e] == 2) && (level.edge_sharpness[e] > 1.0))
+                {
+                        number_of_creases += 2;
+                }
+        }
+        result->x = malloc ((number_of_vertices + 1) * sizeof (double));
+        result->y = malloc ((number_of_vertices + 1) * sizeof (double));
+        result->z = malloc ((number_of_vertices + 1) * sizeof (double));
+        result->face_start = malloc ((number_of_corners + 1) * sizeof (int));
+        result->face_vertices = malloc ((4 * number_of_corners + 1) * sizeof (int));
+        result->edge_vertices = malloc ((2 * number_of_creases + 1) * sizeof (int));
+        result->edge_creases = malloc ((number_of_creases + 1) * sizeof (double));
+        if ((result->x == NULL) || (result->y == NULL) || (result->z == NULL)
+          || (result->face_start == NULL) || (result->face_vertices == NULL)
+          || (result->edge_vertices == NULL) || (result->edge_creases == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                dxf_mesh_subdivision_free_level (&level);
+                dxf_mesh_csr_clear (result);
+                return (EXIT_FAILURE);
+        }
+        result->number_of_vertices = number_of_vertices;
+        /* The edge points need the face points, the vertex points need
+         * both. */
+        if ((dxf_mesh_subdivision_run_pass (&level, DXF_MESH_SUBDIVISION_FACE_PASS, csr->number_of_faces, number_of_threads) != EXIT_SUCCESS)
+          || (dxf_mesh_subdivision_run_pass (&level, DXF_MESH_SUBDIVISION_EDGE_PASS, level.number_of_edges, number_of_threads) != EXIT_SUCCESS)
+          || (dxf_mesh_subdivision_run_pass (&level, DXF_MESH_SUBDIVISION_VERTEX_PASS, csr->number_of_vertices, number_of_threads) != EXIT_SUCCESS))
+        {
+                dxf_mesh_subdivision_free_level (&level);
+                dxf_mesh_csr_clear (result);
+                return (EXIT_FAILURE);
+        }
+        /* A quadrilateral per face corner: vertex point, edge point of
+         * the next edge, face point and edge point of the previous
+         * edge. */
+        k = 0;
+        for (f = 0; f < csr->number_of_faces; f++)
+        {
+                start = csr->face_start[f];
+                n = csr->face_start[f + 1] - start;
+                for (i = 0; i < n; i++)
+                {
+                        result->face_start[k] = 4 * k;
+                        result->face_vertices[4 * k] = csr->face_vertices[start + i];
+                        result->face_vertices[4 * k + 1] = csr->number_of_vertices
+                          + level.corner_edge[start + i];
+                        result->face_vertices[4 * k + 2] = csr->number_of_vertices
+                          + level.number_of_edges + f;
+                        result->face_vertices[4 * k + 3] = csr->number_of_vertices
+                          + level.corner_edge[start + (i + n - 1) % n];
+                        k++;
+                }
+        }
+        result->face_start[k] = 4 * k;
+        result->number_of_faces = k;
+        /* Both halves of a creased edge keep the remainder of the
+         * crease. */
+        k = 0;
+        for (e = 0; e < level.number_of_edges; e++)
+        {
+                if ((level.edge_number_of_faces[e] != 2) || (level.edge_sharpness[e] <= 1.0))
+                {
+                        continue;
+                }
+                result->edge_vertices[2 * k] = level.edge_v0[e];
+                result->edge_vertices[2 * k + 1] = csr->number_of_vertices + e;
+                result->edge_creases[k] = level.edge_sharpness[e] - 1.0;
+                k++;
+                result->edge_vertices[2 * k] = csr->number_of_vertices + e;
+                result->edge_vertices[2 * k + 1] = level.edge_v1[e];
+                result->edge_creases[k] = level.edge_sharpness[e] - 1.0;
+                k++;
+        }
+        result->number_of_edges = k;
+        dxf_mesh_subdivision_free_level (&level);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Triangulate the faces of a \c DxfMeshCsr into an indexed
+ * triangle buffer.
+ *
+ * Every face of \c n vertices becomes a fan of \c n - 2 triangles.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_mesh_csr_triangulate
+(
+        DxfMeshCsr *csr,
+                /*!< a pointer to the mesh arrays. */
+        DxfMeshTriangles *triangles
+                /*!< a pointer to the triangle buffer receiving the
+                 * result. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        int number_of_triangles;
+        int start;
+        int n;
+        int f;
+        int i;
+        int k;
+
+        /* Do some basic checks. */
+        if ((csr == NULL) || (triangles == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_mesh_triangles_clear (triangles);
+        number_of_triangles = 0;
+        for (f = 0; f < csr->number_of_faces; f++)
+        {
+                number_of_triangles += csr->face_start[f + 1] - csr->face_start[f] - 2;
+        }
+        triangles->x = malloc ((csr->number_of_vertices + 1) * sizeof (double));
+        triangles->y = malloc ((csr->number_of_vertices + 1) * sizeof (double));
+        triangles->z = malloc ((csr->number_of_vertices + 1) * sizeof (double));
+        triangles->indices = malloc ((3 * number_of_triangles + 1) * sizeof (int));
+        if ((triangles->x == NULL) || (triangles->y == NULL)
+          || (triangles->z == NULL) || (triangles->indices == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                dxf_mesh_triangles_clear (triangles);
+                return (EXIT_FAILURE);
+        }
+        if (csr->number_of_vertices > 0)
+        {
+                memcpy (triangles->x, csr->x, csr->number_of_vertices * sizeof (double));
+                memcpy (triangles->y, csr->y, csr->number_of_vertices * sizeof (double));
+                memcpy (triangles->z, csr->z, csr->number_of_vertices * sizeof (double));
+        }
+        triangles->number_of_vertices = csr->number_of_vertices;
+        k = 0;
+        for (f = 0; f < csr->number_of_faces; f++)
+        {
+                start = csr->face_start[f];
+                n = csr->face_start[f + 1] - start;
+                for (i = 1; i < n - 1; i++)
+                {
+                        triangles->indices[3 * k] = csr->face_vertices[start];
+                        triangles->indices[3 * k + 1] = csr->face_vertices[start + i];
+                        triangles->indices[3 * k + 2] = csr->face_vertices[start + i + 1];
+                        k++;
+                }
+        }
+        triangles->number_of_triangles = k;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Clear the contents of a \c DxfMeshCsr, the mesh arrays
+ * themselves are not freed.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_mesh_csr_clear
+(
+        DxfMeshCsr *csr
+                /*!< a pointer to the mesh arrays. */
+)
+{
+        /* Do some basic checks. */
+        if (csr == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        free (csr->x);
+        free (csr->y);
+        free (csr->z);
+        free (csr->face_start);
+        free (csr->face_vertices);
+        free (csr->edge_vertices);
+        free (csr->edge_creases);
+        dxf_mesh_csr_init (csr);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Free the allocated memory for a \c DxfMeshCsr and all it's
+ * data fields.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_mesh_csr_free
+(
+        DxfMeshCsr *csr
+                /*!< a pointer to the mesh arrays. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (csr == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_mesh_csr_clear (csr);
+        free (csr);
+        csr = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Allocate memory for a \c DxfMeshTriangles.
+ *
+ * Fill the memory contents with zeros.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfMeshTriangles *
+dxf_mesh_triangles_new ()
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfMeshTriangles *triangles = NULL;
+        size_t size;
+
+        size = sizeof (DxfMeshTriangles);
+        /* avoid malloc of 0 bytes */
+        if (size == 0) size = 1;
+        if ((triangles = malloc (size)) == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                triangles = NULL;
+        }
+        else
+        {
+                memset (triangles, 0, size);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (triangles);
+}
+
+
+/*!
+ * \brief Allocate memory and initialize data fields in a
+ * \c DxfMeshTriangles.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfMeshTriangles *
+dxf_mesh_triangles_init
+(
+        DxfMeshTriangles *triangles
+                /*!< a pointer to the triangle buffer. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (triangles == NULL)
+        {
+                fprintf (stderr,
+                  (_("Warning in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                triangles = dxf_mesh_triangles_new ();
+        }
+        if (triangles == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        triangles->number_of_vertices = 0;
+        triangles->x = NULL;
+        triangles->y = NULL;
+        triangles->z = NULL;
+        triangles->number_of_triangles = 0;
+        triangles->indices = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (triangles);
+}
+
+
+/*!
+ * \brief Clear the contents of a \c DxfMeshTriangles, the triangle
+ * buffer itself is not freed.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_mesh_triangles_clear
+(
+        DxfMeshTriangles *triangles
+                /*!< a pointer to the triangle buffer. */
+)
+{
+        /* Do some basic checks. */
+        if (triangles == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        free (triangles->x);
+        free (triangles->y);
+        free (triangles->z);
+        free (triangles->indices);
+        dxf_mesh_triangles_init (triangles);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Free the allocated memory for a \c DxfMeshTriangles and all
+ * it's data fields.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_mesh_triangles_free
+(
+        DxfMeshTriangles *triangles
+                /*!< a pointer to the triangle buffer. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (triangles == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_mesh_triangles_clear (triangles);
+        free (triangles);
+        triangles = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Compute the subdivided surface of a DXF \c MESH entity as an
+ * indexed triangle buffer.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_mesh_subdivide
+(
+        DxfMesh *mesh,
+                /*!< a pointer to a DXF \c MESH entity. */
+        int level,
+                /*!< number of subdivision levels, a negative value
+                 * uses the subdivision level of the entity, at most
+                 * \c DXF_MESH_SUBDIVISION_MAX_LEVEL. */
+        DxfMeshTriangles *triangles,
+                /*!< a pointer to the triangle buffer receiving the
+                 * result. */
+        int number_of_threads
+                /*!< number of threads to use. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfMeshCsr *csr = NULL;
+        DxfMeshCsr *next = NULL;
+        DxfMeshCsr *swap = NULL;
+        int status;
+        int i;
+
+        /* Do some basic checks. */
+        if ((mesh == NULL) || (triangles == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (level < 0)
+        {
+                level = mesh->subdivision_level;
+        }
+        if (level > DXF_MESH_SUBDIVISION_MAX_LEVEL)
+        {
+                fprintf (stderr,
+                  (_("Warning in %s () subdivision level %d reduced to %d.\n")),
+                  __FUNCTION__, level, DXF_MESH_SUBDIVISION_MAX_LEVEL);
+                level = DXF_MESH_SUBDIVISION_MAX_LEVEL;
+        }
+        csr = dxf_mesh_csr_init (dxf_mesh_csr_new ());
+        next = dxf_mesh_csr_init (dxf_mesh_csr_new ());
+        if ((csr == NULL) || (next == NULL))
+        {
+                if (csr != NULL) dxf_mesh_csr_free (csr);
+                if (next != NULL) dxf_mesh_csr_free (next);
+                return (EXIT_FAILURE);
+        }
+        status = dxf_mesh_csr_from_mesh (csr, mesh);
+        for (i = 0; (i < level) && (status == EXIT_SUCCESS); i++)
+        {
+                status = dxf_mesh_csr_subdivide (csr, next, number_of_threads);
+                swap = csr;
+                csr = next;
+                next = swap;
+        }
+        if (status == EXIT_SUCCESS)
+        {
+                status = dxf_mesh_csr_triangulate (csr, triangles);
+        }
+        dxf_mesh_csr_free (csr);
+        dxf_mesh_csr_free (next);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (status);
+}
+
+
+/*!
+ * \brief Compare two half edges on their vertex indices.
+ *
+ * \return a negative value, zero or a positive value.
+ */
+static int
+dxf_mesh_subdivision_compare_half_edges
+(
+        const void *a,
+                /*!< a pointer to the first half edge. */
+        const void *b
+                /*!< a pointer to the second half edge. */
+)
+{
+        const DxfMeshSubdivisionHalfEdge *ha = a;
+        const DxfMeshSubdivisionHalfEdge *hb = b;
+
+        if (ha->a != hb->a)
+        {
+                return ((ha->a < hb->a) ? -1 : 1);
+        }
+        if (ha->b != hb->b)
+        {
+                return ((ha->b < hb->b) ? -1 : 1);
+        }
+        return (ha->corner - hb->corner);
+}
+
+
+/*!
+ * \brief Find the unique edge between two vertices with a binary
+ * search.
+ *
+ * \return the edge index, or -1 when the vertices share no edge.
+ */
+static int
+dxf_mesh_subdivision_find_edge
+(
+        DxfMeshSubdivisionLevel *level,
+                /*!< a pointer to the subdivision level. */
+        int a,
+                /*!< first vertex index. */
+        int b
+                /*!< second vertex index. */
+)
+{
+        int low;
+        int high;
+        int middle;
+
+        if (a > b)
+        {
+                middle = a;
+                a = b;
+                b = middle;
+        }
+        low = 0;
+        high = level->number_of_edges - 1;
+        while (low <= high)
+        {
+                middle = (low + high) / 2;
+                if ((level->edge_v0[middle] < a)
+                  || ((level->edge_v0[middle] == a) && (level->edge_v1[middle] < b)))
+                {
+                        low = middle + 1;
+                }
+                else if ((level->edge_v0[middle] == a) && (level->edge_v1[middle] == b))
+                {
+                        return (middle);
+                }
+                else
+                {
+                        high = middle - 1;
+                }
+        }
+        return (-1);
+}
+
+
+/*!
+ * \brief Build the edges and the vertex adjacency of a subdivision
+ * level.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_mesh_subdivision_build_level
+(
+        DxfMeshSubdivisionLevel *level
+                /*!< a pointer to the subdivision level. */
+)
+{
+        DxfMeshCsr *csr = NULL;
+        DxfMeshSubdivisionHalfEdge *half_edges = NULL;
+        int number_of_corners;
+        int number_of_vertices;
+        int start;
+        int n;
+        int f;
+        int e;
+        int i;
+
+        csr = level->csr;
+        number_of_corners = (csr->number_of_faces > 0) ? csr->face_start[csr->number_of_faces] : 0;
+        number_of_vertices = csr->number_of_vertices;
+        half_edges = malloc ((number_of_corners + 1) * sizeof (DxfMeshSubdivisionHalfEdge));
+        level->corner_face = malloc ((number_of_corners + 1) * sizeof (int));
+        level->corner_edge = malloc ((number_of_corners + 1) * sizeof (int));
+        level->edge_v0 = malloc ((number_of_corners + 1) * sizeof (int));
+        level->edge_v1 = malloc ((number_of_corners + 1) * sizeof (int));
+        level->edge_f0 = malloc ((number_of_corners + 1) * sizeof (int));
+        level->edge_f1 = malloc ((number_of_corners + 1) * sizeof (int));
+        level->edge_number_of_faces = calloc (number_of_corners + 1, sizeof (int));
+        level->edge_sharpness = calloc (number_of_corners + 1, sizeof (double));
+        level->vertex_edge_start = calloc (number_of_vertices + 1, sizeof (int));
+        level->vertex_edges = malloc ((2 * number_of_corners + 1) * sizeof (int));
+        level->vertex_face_start = calloc (number_of_vertices + 1, sizeof (int));
+        level->vertex_faces = malloc ((number_of_corners + 1) * sizeof (int));
+        if ((half_edges == NULL) || (level->corner_face == NULL)
+          || (level->corner_edge == NULL) || (level->edge_v0 == NULL)
+          || (level->edge_v1 == NULL) || (level->edge_f0 == NULL)
+          || (level->edge_f1 == NULL) || (level->edge_number_of_faces == NULL)
+          || (level->edge_sharpness == NULL) || (level->vertex_edge_start == NULL)
+          || (level->vertex_edges == NULL) || (level->vertex_face_start == NULL)
+          || (level->vertex_faces == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                free (half_edges);
+                return (EXIT_FAILURE);
+        }
+        /* Unique edges from the sorted half edges. */
+        for (f = 0; f < csr->number_of_faces; f++)
+        {
+                start = csr->face_start[f];
+                n = csr->face_start[f + 1] - start;
+                for (i = 0; i < n; i++)
+                {
+                        int a = csr->face_vertices[start + i];
+                        int b = csr->face_vertices[start + (i + 1) % n];
+
+                        half_edges[start + i].a = (a < b) ? a : b;
+                        half_edges[start + i].b = (a < b) ? b : a;
+                        half_edges[start + i].corner = start + i;
+                        level->corner_face[start + i] = f;
+                }
+        }
+        qsort (half_edges, number_of_corners, sizeof (DxfMeshSubdivisionHalfEdge),
+          dxf_mesh_subdivision_compare_half_edges);
+        level->number_of_edges = 0;
+        for (i = 0; i < number_of_corners; i++)
+        {
+                e = level->number_of_edges - 1;
+                if ((i == 0)
+                  || (half_edges[i].a != half_edges[i - 1].a)
+                  || (half_edges[i].b != half_edges[i - 1].b))
+                {
+                        e = level->number_of_edges;
+                        level->edge_v0[e] = half_edges[i].a;
+                        level->edge_v1[e] = half_edges[i].b;
+                        level->edge_f0[e] = level->corner_face[half_edges[i].corner];
+                        level->edge_f1[e] = -1;
+                        level->number_of_edges++;
+                }
+                else if (level->edge_number_of_faces[e] == 1)
+                {
+                        level->edge_f1[e] = level->corner_face[half_edges[i].corner];
+                }
+                level->edge_number_of_faces[e]++;
+                level->corner_edge[half_edges[i].corner] = e;
+        }
+        free (half_edges);
+        /* Crease values of the stored edges. */
+        for (i = 0; i < csr->number_of_edges; i++)
+        {
+                e = dxf_mesh_subdivision_find_edge (level,
+                  csr->edge_vertices[2 * i], csr->edge_vertices[2 * i + 1]);
+                if (e >= 0)
+                {
+                        level->edge_sharpness[e] = csr->edge_creases[i];
+                }
+        }
+        /* Vertex to edge and vertex to face adjacency, by counting. */
+        for (e = 0; e < level->number_of_edges; e++)
+        {
+                level->vertex_edge_start[level->edge_v0[e] + 1]++;
+                level->vertex_edge_start[level->edge_v1[e] + 1]++;
+        }
+        for (i = 0; i < number_of_corners; i++)
+        {
+                level->vertex_face_start[csr->face_vertices[i] + 1]++;
+        }
+        for (i = 0; i < number_of_vertices; i++)
+        {
+                level->vertex_edge_start[i + 1] += level->vertex_edge_start[i];
+                level->vertex_face_start[i + 1] += level->vertex_face_start[i];
+        }
+        for (e = 0; e < level->number_of_edges; e++)
+        {
+                level->vertex_edges[level->vertex_edge_start[level->edge_v0[e]]++] = e;
+                level->vertex_edges[level->vertex_edge_start[level->edge_v1[e]]++] = e;
+        }
+        for (i = 0; i < number_of_corners; i++)
+        {
+                level->vertex_faces[level->vertex_face_start[csr->face_vertices[i]]++] = level->corner_face[i];
+        }
+        /* The fill moved every start to the next start. */
+        for (i = number_of_vertices; i > 0; i--)
+        {
+                level->vertex_edge_start[i] = level->vertex_edge_start[i - 1];
+                level->vertex_face_start[i] = level->vertex_face_start[i - 1];
+        }
+        level->vertex_edge_start[0] = 0;
+        level->vertex_face_start[0] = 0;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Free the arrays of a subdivision level.
+ */
+static void
+dxf_mesh_subdivision_free_level
+(
+        DxfMeshSubdivisionLevel *level
+                /*!< a pointer to the subdivision level. */
+)
+{
+        free (level->edge_v0);
+        free (level->edge_v1);
+        free (level->edge_f0);
+        free (level->edge_f1);
+        free (level->edge_number_of_faces);
+        free (level->edge_sharpness);
+        free (level->corner_face);
+        free (level->corner_edge);
+        free (level->vertex_edge_start);
+        free (level->vertex_edges);
+        free (level->vertex_face_start);
+        free (level->vertex_faces);
+}
+
+
+/*!
+ * \brief Run a pass of a subdivision level, distributed over a number
+ * of threads.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_mesh_subdivision_run_pass
+(
+        DxfMeshSubdivisionLevel *level,
+                /*!< a pointer to the subdivision level. */
+        int pass,
+                /*!< the pass. */
+        int number_of_items,
+                /*!< number of faces, edges or vertices. */
+        int number_of_threads
+                /*!< number of threads to use. */
+)
+{
+        DxfMeshSubdivisionJob *jobs = NULL;
+        pthread_t *threads = NULL;
+        int *started = NULL;
+        int chunk;
+        int i;
+
+        if (number_of_items <= 0)
+        {
+                return (EXIT_SUCCESS);
+        }
+        if (number_of_threads < 1)
+        {
+                number_of_threads = 1;
+        }
+        if (number_of_threads > number_of_items)
+        {
+                number_of_threads = number_of_items;
+        }
+        jobs = calloc (number_of_threads, sizeof (DxfMeshSubdivisionJob));
+        threads = calloc (number_of_threads, sizeof (pthread_t));
+        started = calloc (number_of_threads, sizeof (int));
+        if ((jobs == NULL) || (threads == NULL) || (started == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                free (jobs);
+                free (threads);
+                free (started);
+                return (EXIT_FAILURE);
+        }
+        chunk = (number_of_items + number_of_threads - 1) / number_of_threads;
+        for (i = 0; i < number_of_threads; i++)
+        {
+                jobs[i].level = level;
+                jobs[i].pass = pass;
+                jobs[i].begin = i * chunk;
+                jobs[i].end = ((i + 1) * chunk < number_of_items) ? (i + 1) * chunk : number_of_items;
+        }
+        /* The first chunk is done by the calling thread. */
+        for (i = 1; i < number_of_threads; i++)
+        {
+                if (pthread_create (&threads[i], NULL, dxf_mesh_subdivision_run_job, &jobs[i]) == 0)
+                {
+                        started[i] = TRUE;
+                }
+        }
+        dxf_mesh_subdivision_run_job (&jobs[0]);
+        for (i = 1; i < number_of_threads; i++)
+        {
+                if (started[i])
+                {
+                        pthread_join (threads[i], NULL);
+                }
+                else
+                {
+                        dxf_mesh_subdivision_run_job (&jobs[i]);
+                }
+        }
+        free (jobs);
+        free (threads);
+        free (started);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Run a subdivision job, used as thread entry point.
+ */
+static void *
+dxf_mesh_subdivision_run_job
+(
+        void *data
+                /*!< a pointer to a \c DxfMeshSubdivisionJob. */
+)
+{
+        DxfMeshSubdivisionJob *job = NULL;
+
+        job = (DxfMeshSubdivisionJob *) data;
+        switch (job->pass)
+        {
+                case DXF_MESH_SUBDIVISION_FACE_PASS:
+                        dxf_mesh_subdivision_face_points (job->level,
+                          job->begin, job->end);
+                        break;
+                case DXF_MESH_SUBDIVISION_EDGE_PASS:
+                        dxf_mesh_subdivision_edge_points (job->level,
+                          job->begin, job->end);
+                        break;
+                default:
+                        dxf_mesh_subdivision_vertex_points (job->level,
+                          job->begin, job->end);
+                        break;
+        }
+        return (NULL);
+}
+
+
+/*!
+ * \brief Compute the face points (the average of the face vertices) of
+ * a range of faces.
+ */
+static void
+dxf_mesh_subdivision_face_points
+(
+        DxfMeshSubdivisionLevel *level,
+                /*!< a pointer to the subdivision level. */
+        int begin,
+                /*!< first face. */
+        int end
+                /*!< one past the last face. */
+)
+{
+        DxfMeshCsr *csr = NULL;
+        DxfMeshCsr *result = NULL;
+        double x;
+        double y;
+        double z;
+        int offset;
+        int v;
+        int f;
+        int i;
+
+        csr = level->csr;
+        result = level->result;
+        offset = csr->number_of_vertices + level->number_of_edges;
+        for (f = begin; f < end; f++)
+        {
+                x = 0.0;
+                y = 0.0;
+                z = 0.0;
+                for (i = csr->face_start[f]; i < csr->face_start[f + 1]; i++)
+                {
+                        v = csr->face_vertices[i];
+                        x += csr->x[v];
+                        y += csr->y[v];
+                        z += csr->z[v];
+                }
+                i = csr->face_start[f + 1] - csr->face_start[f];
+                result->x[offset + f] = x / i;
+                result->y[offset + f] = y / i;
+                result->z[offset + f] = z / i;
+        }
+}
+
+
+/*!
+ * \brief Compute the edge points of a range of edges.
+ *
+ * A smooth edge point is the average of the edge end points and the
+ * face points of both faces, a sharp edge point is the edge midpoint.
+ */
+static void
+dxf_mesh_subdivision_edge_points
+(
+        DxfMeshSubdivisionLevel *level,
+                /*!< a pointer to the subdivision level. */
+        int begin,
+                /*!< first edge. */
+        int end
+                /*!< one past the last edge. */
+)
+{
+        DxfMeshCsr *csr = NULL;
+        DxfMeshCsr *result = NULL;
+        double sharp[3];
+        double smooth[3];
+        double s;
+        int face_offset;
+        int f0;
+        int f1;
+        int v0;
+        int v1;
+        int e;
+
+        csr = level->csr;
+        result = level->result;
+        face_offset = csr->number_of_vertices + level->number_of_edges;
+        for (e = begin; e < end; e++)
+        {
+                v0 = level->edge_v0[e];
+                v1 = level->edge_v1[e];
+                sharp[0] = (csr->x[v0] + csr->x[v1]) / 2.0;
+                sharp[1] = (csr->y[v0] + csr->y[v1]) / 2.0;
+                sharp[2] = (csr->z[v0] + csr->z[v1]) / 2.0;
+                s = level->edge_sharpness[e];
+                if ((level->edge_number_of_faces[e] != 2) || (s >= 1.0))
+                {
+                        result->x[csr->number_of_vertices + e] = sharp[0];
+                        result->y[csr->number_of_vertices + e] = sharp[1];
+                        result->z[csr->number_of_vertices + e] = sharp[2];
+                        continue;
+                }
+                f0 = face_offset + level->edge_f0[e];
+                f1 = face_offset + level->edge_f1[e];
+                smooth[0] = (sharp[0] + (result->x[f0] + result->x[f1]) / 2.0) / 2.0;
+                smooth[1] = (sharp[1] + (result->y[f0] + result->y[f1]) / 2.0) / 2.0;
+                smooth[2] = (sharp[2] + (result->z[f0] + result->z[f1]) / 2.0) / 2.0;
+                if (s < 0.0)
+                {
+                        s = 0.0;
+                }
+                result->x[csr->number_of_vertices + e] = (1.0 - s) * smooth[0] + s * sharp[0];
+                result->y[csr->number_of_vertices + e] = (1.0 - s) * smooth[1] + s * sharp[1];
+                result->z[csr->number_of_vertices + e] = (1.0 - s) * smooth[2] + s * sharp[2];
+        }
+}
+
+
+/*!
+ * \brief Compute the vertex points of a range of vertices.
+ *
+ * A vertex with less than two sharp edges follows the smooth rule
+ * (F + 2R + (n - 3)P) / n, a vertex with two sharp edges the crease
+ * rule (A + 6P + B) / 8 and a vertex with more sharp edges stays
+ * (corner rule), a fractional crease value blends between the smooth
+ * rule and the others.
+ */
+static void
+dxf_mesh_subdivision_vertex_points
+(
+        DxfMeshSubdivisionLevel *level,
+                /*!< a pointer to the subdivision level. */
+        int begin,
+                /*!< first vertex. */
+        int end
+                /*!< one past the last vertex. */
+)
+{
+        DxfMeshCsr *csr = NULL;
+        DxfMeshCsr *result = NULL;
+        double p[3];
+        double f[3];
+        double r[3];
+        double smooth[3];
+        double sharp[3];
+        double sharpness;
+        int others[2];
+        int number_of_sharp_edges;
+        int number_of_edges;
+        int number_of_faces;
+        int face_offset;
+        int other;
+        int e;
+        int v;
+        int i;
+        int j;
+
+        csr = level->csr;
+        result = level->result;
+        face_offset = csr->number_of_vertices + level->number_of_edges;
+        for (v = begin; v < end; v++)
+        {
+                p[0] = csr->x[v];
+                p[1] = csr->y[v];
+                p[2] = csr->z[v];
+                number_of_edges = level->vertex_edge_start[v + 1] - level->vertex_edge_start[v];
+                number_of_faces = level->vertex_face_start[v + 1] - level->vertex_face_start[v];
+                if ((number_of_edges == 0) || (number_of_faces == 0))
+                {
+                        result->x[v] = p[0];
+                        result->y[v] = p[1];
+                        result->z[v] = p[2];
+                        continue;
+                }
+                f[0] = f[1] = f[2] = 0.0;
+                for (i = level->vertex_face_start[v]; i < level->vertex_face_start[v + 1]; i++)
+                {
+                        j = face_offset + level->vertex_faces[i];
+                        f[0] += result->x[j];
+                        f[1] += result->y[j];
+                        f[2] += result->z[j];
+                }
+                r[0] = r[1] = r[2] = 0.0;
+                number_of_sharp_edges = 0;
+                sharpness = 0.0;
+                for (i = level->vertex_edge_start[v]; i < level->vertex_edge_start[v + 1]; i++)
+                {
+                        e = level->vertex_edges[i];
+                        other = (level->edge_v0[e] == v) ? level->edge_v1[e] : level->edge_v0[e];
+                        r[0] += (p[0] + csr->x[other]) / 2.0;
+                        r[1] += (p[1] + csr->y[other]) / 2.0;
+                        r[2] += (p[2] + csr->z[other]) / 2.0;
+                        if ((level->edge_number_of_faces[e] != 2)
+                          || (level->edge_sharpness[e] > 0.0))
+                        {
+                                if (number_of_sharp_edges < 2)
+                                {
+                                        others[number_of_sharp_edges] = other;
+                                }
+                                number_of_sharp_edges++;
+                                sharpness += (level->edge_number_of_faces[e] != 2)
+                                  ? HUGE_VAL : level->edge_sharpness[e];
+                        }
+                }
+                for (j = 0; j < 3; j++)
+                {
+                        smooth[j] = (f[j] / number_of_faces
+                          + 2.0 * r[j] / number_of_edges
+                          + (number_of_edges - 3) * p[j]) / number_of_edges;
+                }
+                if (number_of_sharp_edges < 2)
+                {
+                        result->x[v] = smooth[0];
+                        result->y[v] = smooth[1];
+                        result->z[v] = smooth[2];
+                        continue;
+                }
+                if (number_of_sharp_edges == 2)
+                {
+                        sharp[0] = (csr->x[others[0]] + 6.0 * p[0] + csr->x[others[1]]) / 8.0;
+                        sharp[1] = (csr->y[others[0]] + 6.0 * p[1] + csr->y[others[1]]) / 8.0;
+                        sharp[2] = (csr->z[others[0]] + 6.0 * p[2] + csr->z[others[1]]) / 8.0;
+                }
+                else
+                {
+                        sharp[0] = p[0];
+                        sharp[1] = p[1];
+                        sharp[2] = p[2];
+                }
+                sharpness /= number_of_sharp_edges;
+                if (sharpness >= 1.0)
+                {
+                        result->x[v] = sharp[0];
+                        result->y[v] = sharp[1];
+                        result->z[v] = sharp[2];
+                }
+                else
+                {
+                        result->x[v] = (1.0 - sharpness) * smooth[0] + sharpness * sharp[0];
+                        result->y[v] = (1.0 - sharpness) * smooth[1] + sharpness * sharp[1];
+                        result->z[v] = (1.0 - sharpness) * smooth[2] + sharpness * sharp[2];
+                }
+        }
+}
+
+
+/* EOF */
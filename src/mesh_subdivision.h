@@ -0,0 +1,136 @@
+/*!
+ * \file mesh_subdivision.h
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Header file for compressed sparse row storage and
+ * Catmull-Clark subdivision of DXF meshes (\c MESH).
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#ifndef LIBDXF_SRC_MESH_SUBDIVISION_H
+#define LIBDXF_SRC_MESH_SUBDIVISION_H
+
+
+#include "global.h"
+#include "mesh.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define DXF_MESH_SUBDIVISION_MAX_LEVEL 8
+        /*!< \brief Highest subdivision level, every level multiplies
+         * the number of faces by about four. */
+
+
+/*!
+ * \brief Definition of a mesh in compressed sparse row (CSR) arrays.
+ *
+ * The vertices of face \c f are
+ * <tt>face_vertices[face_start[f]]</tt> up to (not including)
+ * <tt>face_vertices[face_start[f + 1]]</tt>.\n
+ * Only creased edges are stored, every edge is a pair of vertex
+ * indices with a crease value (the number of subdivision levels the
+ * edge stays sharp, \c HUGE_VAL for an edge that is always sharp).
+ */
+typedef struct
+dxf_mesh_csr_struct
+{
+        int number_of_vertices;
+                /*!< Number of vertices. */
+        double *x;
+                /*!< X-coordinates of the vertices. */
+        double *y;
+                /*!< Y-coordinates of the vertices. */
+        double *z;
+                /*!< Z-coordinates of the vertices. */
+        int number_of_faces;
+                /*!< Number of faces. */
+        int *face_start;
+                /*!< Index of the first vertex of each face in
+                 * \c face_vertices, with an extra entry for the end of
+                 * the last face. */
+        int *face_vertices;
+                /*!< Vertex indices of all faces. */
+        int number_of_edges;
+                /*!< Number of creased edges. */
+        int *edge_vertices;
+                /*!< Two vertex indices per creased edge. */
+        double *edge_creases;
+                /*!< Crease value per creased edge. */
+} DxfMeshCsr;
+
+
+/*!
+ * \brief Definition of an indexed triangle buffer.
+ */
+typedef struct
+dxf_mesh_triangles_struct
+{
+        int number_of_vertices;
+                /*!< Number of vertices. */
+        double *x;
+                /*!< X-coordinates of the vertices. */
+        double *y;
+                /*!< Y-coordinates of the vertices. */
+        double *z;
+                /*!< Z-coordinates of the vertices. */
+        int number_of_triangles;
+                /*!< Number of triangles. */
+        int *indices;
+                /*!< Three vertex indices per triangle, in the
+                 * orientation of the face they stem from. */
+} DxfMeshTriangles;
+
+
+DxfMeshCsr *dxf_mesh_csr_new ();
+DxfMeshCsr *dxf_mesh_csr_init (DxfMeshCsr *csr);
+int dxf_mesh_csr_from_mesh (DxfMeshCsr *csr, DxfMesh *mesh);
+int dxf_mesh_csr_subdivide (DxfMeshCsr *csr, DxfMeshCsr *result, int number_of_threads);
+int dxf_mesh_csr_triangulate (DxfMeshCsr *csr, DxfMeshTriangles *triangles);
+int dxf_mesh_csr_clear (DxfMeshCsr *csr);
+int dxf_mesh_csr_free (DxfMeshCsr *csr);
+DxfMeshTriangles *dxf_mesh_triangles_new ();
+DxfMeshTriangles *dxf_mesh_triangles_init (DxfMeshTriangles *triangles);
+int dxf_mesh_triangles_clear (DxfMeshTriangles *triangles);
+int dxf_mesh_triangles_free (DxfMeshTriangles *triangles);
+int dxf_mesh_subdivide (DxfMesh *mesh, int level, DxfMeshTriangles *triangles, int number_of_threads);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* LIBDXF_SRC_MESH_SUBDIVISION_H */
+
+
+/* EOF */
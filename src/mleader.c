@@ -35,6 +35,14 @@
 
 
 #include "mleader.h"
+#include "stats.h"
+#include "util.h"
+
+
+static void dxf_mleader_set_point_coordinate (DxfPoint *point, int group_code, const char *value);
+static void dxf_mleader_decode_context_data_group (DxfMLeaderContextData *data, int group_code, const char *value);
+static void dxf_mleader_decode_leader_node_group (DxfMLeaderLeaderNode *node, int group_code, const char *value);
+static void dxf_mleader_decode_leader_line_group (DxfMLeaderLeaderLine *line, DxfPoint **vertex, int group_code, const char *value);
 
 
 /*!
@@ -67,6 +75,7 @@ dxf_mleader_new ()
         else
         {
                 memset (mleader, 0, size);
+                dxf_stats_count_allocation (MLEADER, size);
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -165,6 +174,13 @@ dxf_mleader_init
         mleader->text_style_id = strdup ("");
         mleader->block_content_id = strdup ("");
         mleader->arrow_head_id = strdup ("");
+        mleader->context_data_index.values = NULL;
+        mleader->context_data_index.values_length = 0;
+        mleader->context_data_index.values_size = 0;
+        mleader->context_data_index.spans = NULL;
+        mleader->context_data_index.number_of_spans = 0;
+        mleader->context_data_index.max_number_of_spans = 0;
+        mleader->context_data = NULL;
         mleader->next = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -196,9 +212,12 @@ dxf_mleader_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        char *end = NULL;
         DxfBinaryGraphicsData *iter310 = NULL;
         int iter330;
+        int group_code;
+        int status;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -206,8 +225,6 @@ dxf_mleader_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (mleader == NULL)
@@ -220,112 +237,129 @@ dxf_mleader_read
         }
         iter310 = (DxfBinaryGraphicsData *) mleader->binary_graphics_data;
         iter330 = 0;
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        while ((dxf_read_group_code (fp, temp_string, DXF_MAX_STRING_LENGTH) == EXIT_SUCCESS)
+          && (strcmp (temp_string, "0") != 0))
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
                 if (strcmp (temp_string, "5") == 0)
                 {
                         /* Now follows a string containing a sequential
                          * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &mleader->id_code);
+                        status = dxf_read_hex (fp, &mleader->id_code);
                 }
                 else if (strcmp (temp_string, "6") == 0)
                 {
                         /* Now follows a string containing a linetype
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mleader->linetype);
+                        status = dxf_read_string (fp, &mleader->linetype);
                 }
                 else if (strcmp (temp_string, "8") == 0)
                 {
                         /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mleader->layer);
+                        status = dxf_read_string (fp, &mleader->layer);
                 }
                 else if ((fp->acad_version_number <= AutoCAD_11)
                         && (strcmp (temp_string, "38") == 0))
                 {
                         /* Now follows a string containing the
                          * elevation. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mleader->elevation);
+                        status = dxf_read_double (fp, &mleader->elevation);
                 }
                 else if (strcmp (temp_string, "39") == 0)
                 {
                         /* Now follows a string containing the
                          * thickness. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mleader->thickness);
+                        status = dxf_read_double (fp, &mleader->thickness);
                 }
                 else if (strcmp (temp_string, "48") == 0)
                 {
                         /* Now follows a string containing the linetype
                          * scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mleader->linetype_scale);
+                        status = dxf_read_double (fp, &mleader->linetype_scale);
                 }
                 else if (strcmp (temp_string, "60") == 0)
                 {
                         /* Now follows a string containing the
                          * visibility value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &mleader->visibility);
+                        status = dxf_read_int16 (fp, &mleader->visibility);
                 }
                 else if (strcmp (temp_string, "62") == 0)
                 {
                         /* Now follows a string containing the
                          * color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &mleader->color);
+                        status = dxf_read_int (fp, &mleader->color);
                 }
                 else if (strcmp (temp_string, "67") == 0)
                 {
                         /* Now follows a string containing the
                          * paperspace value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &mleader->paperspace);
+                        status = dxf_read_int (fp, &mleader->paperspace);
                 }
                 else if (strcmp (temp_string, "92") == 0)
                 {
                         /* Now follows a string containing the
                          * graphics data size value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &mleader->graphics_data_size);
+                        status = dxf_read_int (fp, &mleader->graphics_data_size);
                 }
                 else if (strcmp (temp_string, "160") == 0)
                 {
                         /* Now follows a string containing the
                          * graphics data size value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &mleader->graphics_data_size);
+                        status = dxf_read_int (fp, &mleader->graphics_data_size);
                 }
                 else if (strcmp (temp_string, "284") == 0)
                 {
                         /* Now follows a string containing the shadow
                          * mode value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &mleader->shadow_mode);
+                        status = dxf_read_int16 (fp, &mleader->shadow_mode);
+                }
+                else if (strcmp (temp_string, "300") == 0)
+                {
+                        /* Now follows the "CONTEXT_DATA{" string, the
+                         * groups up to group code 301 are kept as is
+                         * and decoded on demand. */
+                        status = dxf_read_text_line (fp, temp_string, DXF_MAX_STRING_LENGTH);
+                        while (status == EXIT_SUCCESS)
+                        {
+                                status = dxf_read_group_code (fp, temp_string, DXF_MAX_STRING_LENGTH);
+                                if (status != EXIT_SUCCESS)
+                                {
+                                        break;
+                                }
+                                group_code = (int) strtol (temp_string, &end, 10);
+                                if ((end == temp_string) || (*end != '\0'))
+                                {
+                                        status = EXIT_FAILURE;
+                                        break;
+                                }
+                                status = dxf_read_text_line (fp, temp_string, DXF_MAX_STRING_LENGTH);
+                                if ((status != EXIT_SUCCESS)
+                                  || (group_code == 301))
+                                {
+                                        break;
+                                }
+                                status = dxf_mleader_append_context_data_group (mleader,
+                                  group_code, temp_string);
+                        }
                 }
                 else if (strcmp (temp_string, "310") == 0)
                 {
                         /* Now follows a string containing binary
                          * graphics data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", iter310->data_line);
-                        dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) iter310->next);
-                        iter310 = (DxfBinaryGraphicsData *) iter310->next;
+                        if (strcmp (iter310->data_line, "") != 0)
+                        {
+                                iter310->next = (struct DxfBinaryGraphicsData *) dxf_binary_graphics_data_init (NULL);
+                                iter310 = (DxfBinaryGraphicsData *) iter310->next;
+                        }
+                        status = dxf_read_text_line (fp, temp_string, DXF_MAX_STRING_LENGTH);
+                        if ((status == EXIT_SUCCESS) && (iter310 != NULL))
+                        {
+                                free (iter310->data_line);
+                                iter310->data_line = strdup (temp_string);
+                        }
+                        else
+                        {
+                                status = EXIT_FAILURE;
+                        }
                 }
                 else if (strcmp (temp_string, "330") == 0)
                 {
@@ -333,15 +367,17 @@ dxf_mleader_read
                         {
                                 /* Now follows a string containing a soft-pointer
                                  * ID/handle to owner dictionary. */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%s\n", mleader->dictionary_owner_soft);
+                                status = dxf_read_string (fp, &mleader->dictionary_owner_soft);
                         }
-                        if (iter330 == 1)
+                        else if (iter330 == 1)
                         {
                                 /* Now follows a string containing a soft-pointer
                                  * ID/handle to owner object. */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%s\n", mleader->object_owner_soft);
+                                status = dxf_read_string (fp, &mleader->object_owner_soft);
+                        }
+                        else
+                        {
+                                status = dxf_read_text_line (fp, temp_string, DXF_MAX_STRING_LENGTH);
                         }
                         iter330++;
                 }
@@ -349,62 +385,66 @@ dxf_mleader_read
                 {
                         /* Now follows a string containing a
                          * hard-pointer ID/handle to material object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mleader->material);
+                        status = dxf_read_string (fp, &mleader->material);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mleader->dictionary_owner_hard);
+                        status = dxf_read_string (fp, &mleader->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "370") == 0)
                 {
                         /* Now follows a string containing the lineweight
                          * value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &mleader->lineweight);
+                        status = dxf_read_int16 (fp, &mleader->lineweight);
                 }
                 else if (strcmp (temp_string, "390") == 0)
                 {
                         /* Now follows a string containing a plot style
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mleader->plot_style_name);
+                        status = dxf_read_string (fp, &mleader->plot_style_name);
                 }
                 else if (strcmp (temp_string, "420") == 0)
                 {
                         /* Now follows a string containing a color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%ld\n", &mleader->color_value);
+                        status = dxf_read_long (fp, &mleader->color_value);
                 }
                 else if (strcmp (temp_string, "430") == 0)
                 {
                         /* Now follows a string containing a color
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mleader->color_name);
+                        status = dxf_read_string (fp, &mleader->color_name);
                 }
                 else if (strcmp (temp_string, "440") == 0)
                 {
                         /* Now follows a string containing a transparency
                          * value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%ld\n", &mleader->transparency);
+                        status = dxf_read_long (fp, &mleader->transparency);
                 }
                 else if (strcmp (temp_string, "999") == 0)
                 {
                         /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
+                        status = dxf_read_text_line (fp, temp_string, DXF_MAX_STRING_LENGTH);
+                        if (status == EXIT_SUCCESS)
+                        {
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                        }
                 }
                 else
                 {
                         fprintf (stderr,
                           (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                           __FUNCTION__, fp->filename, fp->line_number);
+                        /* Skip the value of the unknown group code. */
+                        status = dxf_read_text_line (fp, temp_string, DXF_MAX_STRING_LENGTH);
+                }
+                if (status != EXIT_SUCCESS)
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                          __FUNCTION__, fp->filename, fp->line_number);
+                        return (NULL);
                 }
         }
         /* Handle omitted members and/or illegal values. */
@@ -416,8 +456,6 @@ dxf_mleader_read
         {
                 mleader->layer = strdup (DXF_DEFAULT_LAYER);
         }
-        /* Clean up. */
-        free (temp_string);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -460,15 +498,15 @@ dxf_mleader_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (mleader->linetype);
-        free (mleader->layer);
+        dxf_string_free (mleader->linetype);
+        dxf_string_free (mleader->layer);
         dxf_binary_graphics_data_free_list (mleader->binary_graphics_data);
-        free (mleader->dictionary_owner_soft);
-        free (mleader->object_owner_soft);
-        free (mleader->material);
-        free (mleader->dictionary_owner_hard);
-        free (mleader->plot_style_name);
-        free (mleader->color_name);
+        dxf_string_free (mleader->dictionary_owner_soft);
+        dxf_string_free (mleader->object_owner_soft);
+        dxf_string_free (mleader->material);
+        dxf_string_free (mleader->dictionary_owner_hard);
+        dxf_string_free (mleader->plot_style_name);
+        dxf_string_free (mleader->color_name);
         free (mleader->block_attribute_text_string);
         free (mleader->block_attribute_id);
         free (mleader->leader_style_id);
@@ -477,6 +515,12 @@ dxf_mleader_free
         free (mleader->text_style_id);
         free (mleader->block_content_id);
         free (mleader->arrow_head_id);
+        free (mleader->context_data_index.values);
+        free (mleader->context_data_index.spans);
+        if (mleader->context_data != NULL)
+        {
+                dxf_mleader_context_data_free_list ((DxfMLeaderContextData *) mleader->context_data);
+        }
         free (mleader);
         mleader = NULL;
 #if DEBUG
@@ -4995,6 +5039,395 @@ dxf_mleader_get_last
 }
 
 
+/*!
+ * \brief Append a raw group to the context data of a DXF \c MLEADER
+ * entity.
+ *
+ * The group is kept in the compact span index of the entity, the
+ * context data tree is decoded from the index when it is asked for by
+ * \c dxf_mleader_get_context_data ().\n
+ * A decoded context data tree is discarded.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_mleader_append_context_data_group
+(
+        DxfMLeader *mleader,
+                /*!< a pointer to a DXF \c MLEADER entity. */
+        int group_code,
+                /*!< the group code. */
+        const char *value
+                /*!< the value of the group. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfMLeaderSpanIndex *index = NULL;
+        DxfMLeaderSpan *spans = NULL;
+        char *values = NULL;
+        int length;
+        int size;
+
+        /* Do some basic checks. */
+        if ((mleader == NULL) || (value == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        index = &mleader->context_data_index;
+        length = strlen (value) + 1;
+        if (index->values_length + length > index->values_size)
+        {
+                size = (index->values_size > 0) ? index->values_size : 256;
+                while (index->values_length + length > size)
+                {
+                        size *= 2;
+                }
+                values = realloc (index->values, size);
+                if (values == NULL)
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () could not allocate memory.\n")),
+                          __FUNCTION__);
+                        return (EXIT_FAILURE);
+                }
+                index->values = values;
+                index->values_size = size;
+        }
+        if (index->number_of_spans == index->max_number_of_spans)
+        {
+                size = (index->max_number_of_spans > 0) ? 2 * index->max_number_of_spans : 32;
+                spans = realloc (index->spans, size * sizeof (DxfMLeaderSpan));
+                if (spans == NULL)
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () could not allocate memory.\n")),
+                          __FUNCTION__);
+                        return (EXIT_FAILURE);
+                }
+                index->spans = spans;
+                index->max_number_of_spans = size;
+        }
+        memcpy (index->values + index->values_length, value, length);
+        index->spans[index->number_of_spans].group_code = group_code;
+        index->spans[index->number_of_spans].offset = index->values_length;
+        index->number_of_spans++;
+        index->values_length += length;
+        if (mleader->context_data != NULL)
+        {
+                dxf_mleader_context_data_free_list ((DxfMLeaderContextData *) mleader->context_data);
+                mleader->context_data = NULL;
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Get the context data of a DXF \c MLEADER entity.
+ *
+ * The context data tree (with its leader nodes and leader lines) is
+ * decoded from the span index on the first call, later calls return
+ * the same tree.
+ *
+ * \return a pointer to the context data, or \c NULL when the entity
+ * has no context data or an error occurred.
+ */
+DxfMLeaderContextData *
+dxf_mleader_get_context_data
+(
+        DxfMLeader *mleader
+                /*!< a pointer to a DXF \c MLEADER entity. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfMLeaderSpanIndex *index = NULL;
+        DxfMLeaderContextData *data = NULL;
+        DxfMLeaderLeaderNode *node = NULL;
+        DxfMLeaderLeaderNode *new_node = NULL;
+        DxfMLeaderLeaderLine *line = NULL;
+        DxfMLeaderLeaderLine *new_line = NULL;
+        DxfPoint *vertex = NULL;
+        const char *value = NULL;
+        int group_code;
+        int depth;
+        int i;
+
+        /* Do some basic checks. */
+        if (mleader == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        if (mleader->context_data != NULL)
+        {
+                return ((DxfMLeaderContextData *) mleader->context_data);
+        }
+        index = &mleader->context_data_index;
+        if (index->number_of_spans == 0)
+        {
+                return (NULL);
+        }
+        data = dxf_mleader_context_data_init (dxf_mleader_context_data_new ());
+        if (data == NULL)
+        {
+                return (NULL);
+        }
+        /* Depth 0 is the context data, 1 a leader node and 2 a leader
+         * line. */
+        depth = 0;
+        for (i = 0; i < index->number_of_spans; i++)
+        {
+                group_code = index->spans[i].group_code;
+                value = index->values + index->spans[i].offset;
+                if ((depth == 0) && (group_code == 302))
+                {
+                        /* "LEADER{" */
+                        new_node = dxf_mleader_leader_node_init (dxf_mleader_leader_node_new ());
+                        if (new_node == NULL)
+                        {
+                                break;
+                        }
+                        if (node == NULL)
+                        {
+                                data->leader_node = (struct DxfMLeaderLeaderNode *) new_node;
+                        }
+                        else
+                        {
+                                node->next = (struct DxfMLeaderLeaderNode *) new_node;
+                        }
+                        node = new_node;
+                        line = NULL;
+                        depth = 1;
+                }
+                else if ((depth == 1) && (group_code == 303))
+                {
+                        depth = 0;
+                }
+                else if ((depth == 1) && (group_code == 304))
+                {
+                        /* "LEADER_LINE{" */
+                        new_line = dxf_mleader_leader_line_init (dxf_mleader_leader_line_new ());
+                        if (new_line == NULL)
+                        {
+                                break;
+                        }
+                        if (line == NULL)
+                        {
+                                node->leader_line = (struct DxfMLeaderLeaderLine *) new_line;
+                        }
+                        else
+                        {
+                                line->next = (struct DxfMLeaderLeaderLine *) new_line;
+                        }
+                        line = new_line;
+                        vertex = NULL;
+                        depth = 2;
+                }
+                else if ((depth == 2) && (group_code == 305))
+                {
+                        depth = 1;
+                }
+                else if (depth == 0)
+                {
+                        dxf_mleader_decode_context_data_group (data,
+                          group_code, value);
+                }
+                else if (depth == 1)
+                {
+                        dxf_mleader_decode_leader_node_group (node,
+                          group_code, value);
+                }
+                else
+                {
+                        dxf_mleader_decode_leader_line_group (line,
+                          &vertex, group_code, value);
+                }
+        }
+        mleader->context_data = (struct DxfMLeaderContextData *) data;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (data);
+}
+
+
+/*!
+ * \brief Get the text contents of a DXF \c MLEADER entity without
+ * decoding the context data.
+ *
+ * \return a pointer to the text contents (owned by the entity), or
+ * \c NULL when the entity has no text contents.
+ */
+char *
+dxf_mleader_get_text_contents
+(
+        DxfMLeader *mleader
+                /*!< a pointer to a DXF \c MLEADER entity. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfMLeaderSpanIndex *index = NULL;
+        int group_code;
+        int depth;
+        int i;
+
+        /* Do some basic checks. */
+        if (mleader == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        if (mleader->context_data != NULL)
+        {
+                return (((DxfMLeaderContextData *) mleader->context_data)->default_text_contents);
+        }
+        index = &mleader->context_data_index;
+        depth = 0;
+        for (i = 0; i < index->number_of_spans; i++)
+        {
+                group_code = index->spans[i].group_code;
+                if ((group_code == 302) || (group_code == 304 && depth == 1))
+                {
+                        depth++;
+                }
+                else if ((group_code == 303) || (group_code == 305))
+                {
+                        depth--;
+                }
+                else if ((depth == 0) && (group_code == 304))
+                {
+                        return (index->values + index->spans[i].offset);
+                }
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (NULL);
+}
+
+
+/*!
+ * \brief Get the arrow tip (the first vertex of the first leader line)
+ * of a DXF \c MLEADER entity without decoding the context data.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when the entity
+ * has no leader line or an error occurred.
+ */
+int
+dxf_mleader_get_arrow_tip
+(
+        DxfMLeader *mleader,
+                /*!< a pointer to a DXF \c MLEADER entity. */
+        double *x,
+                /*!< a pointer receiving the X-coordinate. */
+        double *y,
+                /*!< a pointer receiving the Y-coordinate. */
+        double *z
+                /*!< a pointer receiving the Z-coordinate. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfMLeaderSpanIndex *index = NULL;
+        DxfMLeaderContextData *data = NULL;
+        DxfMLeaderLeaderNode *node = NULL;
+        DxfMLeaderLeaderLine *line = NULL;
+        const char *value = NULL;
+        int group_code;
+        int depth;
+        int found;
+        int i;
+
+        /* Do some basic checks. */
+        if ((mleader == NULL) || (x == NULL) || (y == NULL) || (z == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (mleader->context_data != NULL)
+        {
+                data = (DxfMLeaderContextData *) mleader->context_data;
+                node = (DxfMLeaderLeaderNode *) data->leader_node;
+                line = (node != NULL) ? (DxfMLeaderLeaderLine *) node->leader_line : NULL;
+                if ((line == NULL) || (line->p0 == NULL))
+                {
+                        return (EXIT_FAILURE);
+                }
+                *x = line->p0->x0;
+                *y = line->p0->y0;
+                *z = line->p0->z0;
+                return (EXIT_SUCCESS);
+        }
+        index = &mleader->context_data_index;
+        *x = 0.0;
+        *y = 0.0;
+        *z = 0.0;
+        depth = 0;
+        found = FALSE;
+        for (i = 0; i < index->number_of_spans; i++)
+        {
+                group_code = index->spans[i].group_code;
+                value = index->values + index->spans[i].offset;
+                if ((group_code == 302) || (group_code == 304 && depth == 1))
+                {
+                        depth++;
+                }
+                else if ((group_code == 303) || (group_code == 305))
+                {
+                        if (found)
+                        {
+                                break;
+                        }
+                        depth--;
+                }
+                else if (depth == 2)
+                {
+                        if (group_code == 10)
+                        {
+                                if (found)
+                                {
+                                        /* The second vertex. */
+                                        break;
+                                }
+                                *x = strtod (value, NULL);
+                                found = TRUE;
+                        }
+                        else if (found && (group_code == 20))
+                        {
+                                *y = strtod (value, NULL);
+                        }
+                        else if (found && (group_code == 30))
+                        {
+                                *z = strtod (value, NULL);
+                        }
+                }
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return ((found) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+
 /*!
  * \brief Allocate memory for a DxfMLeaderContextData object for a DXF
  * \c MLEADER entity.
@@ -5119,6 +5552,7 @@ dxf_mleader_context_data_init
         data->default_text_contents = strdup ("");
         data->type_style_id = strdup ("");
         data->block_content_id = strdup ("");
+        data->leader_node = NULL;
         data->next = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -5171,6 +5605,10 @@ dxf_mleader_context_data_free
         free (data->default_text_contents);
         free (data->type_style_id);
         free (data->block_content_id);
+        if (data->leader_node != NULL)
+        {
+                dxf_mleader_leader_node_free_list ((DxfMLeaderLeaderNode *) data->leader_node);
+        }
         free (data);
         data = NULL;
 #if DEBUG
@@ -10249,6 +10687,7 @@ dxf_mleader_leader_node_init
         node->leader_branch_index = 0;
         node->has_set_last_leader_line_point = 0;
         node->has_set_dogleg_vector = 0;
+        node->leader_line = NULL;
         node->next = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -10295,6 +10734,10 @@ dxf_mleader_leader_node_free
         dxf_point_free_list (node->p1);
         dxf_point_free_list (node->p2);
         dxf_point_free_list (node->p3);
+        if (node->leader_line != NULL)
+        {
+                dxf_mleader_leader_line_free_list ((DxfMLeaderLeaderLine *) node->leader_line);
+        }
         free (node);
         node = NULL;
 #if DEBUG
@@ -13472,4 +13915,303 @@ dxf_mleader_leader_line_get_last
 }
 
 
+/*!
+ * \brief Set a coordinate of a point from the value of a group, group
+ * codes 10 up to 18 are X-coordinates, 20 up to 28 Y-coordinates and
+ * 30 up to 38 Z-coordinates.
+ */
+static void
+dxf_mleader_set_point_coordinate
+(
+        DxfPoint *point,
+                /*!< a pointer to the point. */
+        int group_code,
+                /*!< the group code. */
+        const char *value
+                /*!< the value of the group. */
+)
+{
+        if (point == NULL)
+        {
+                return;
+        }
+        switch (group_code / 10)
+        {
+                case 1:
+                        point->x0 = strtod (value, NULL);
+                        break;
+                case 2:
+                        point->y0 = strtod (value, NULL);
+                        break;
+                case 3:
+                        point->z0 = strtod (value, NULL);
+                        break;
+                default:
+                        break;
+        }
+}
+
+
+/*!
+ * \brief Decode a raw group of the context data of a DXF \c MLEADER
+ * entity.
+ */
+static void
+dxf_mleader_decode_context_data_group
+(
+        DxfMLeaderContextData *data,
+                /*!< a pointer to the context data. */
+        int group_code,
+                /*!< the group code. */
+        const char *value
+                /*!< the value of the group. */
+)
+{
+        switch (group_code)
+        {
+                case 10: case 20: case 30:
+                        dxf_mleader_set_point_coordinate (data->p0, group_code, value);
+                        break;
+                case 11: case 21: case 31:
+                        dxf_mleader_set_point_coordinate (data->p1, group_code, value);
+                        break;
+                case 12: case 22: case 32:
+                        dxf_mleader_set_point_coordinate (data->p2, group_code, value);
+                        break;
+                case 13: case 23: case 33:
+                        dxf_mleader_set_point_coordinate (data->p3, group_code, value);
+                        break;
+                case 14: case 24: case 34:
+                        dxf_mleader_set_point_coordinate (data->p4, group_code, value);
+                        break;
+                case 15: case 25: case 35:
+                        dxf_mleader_set_point_coordinate (data->p5, group_code, value);
+                        break;
+                case 16:
+                        data->block_content_scale = strtod (value, NULL);
+                        break;
+                case 40:
+                        data->content_scale = strtod (value, NULL);
+                        break;
+                case 41:
+                        data->text_height = strtod (value, NULL);
+                        break;
+                case 42:
+                        data->text_rotation = strtod (value, NULL);
+                        break;
+                case 43:
+                        data->text_width = strtod (value, NULL);
+                        break;
+                case 44:
+                        data->text_height2 = strtod (value, NULL);
+                        break;
+                case 45:
+                        data->text_line_spacing_factor = strtod (value, NULL);
+                        break;
+                case 46:
+                        data->block_content_rotation = strtod (value, NULL);
+                        break;
+                case 47:
+                        data->block_transformation_matrix = strtod (value, NULL);
+                        break;
+                case 90:
+                        data->text_color = strtol (value, NULL, 10);
+                        break;
+                case 91:
+                        data->text_background_color = strtol (value, NULL, 10);
+                        break;
+                case 92:
+                        data->text_background_transparency = strtol (value, NULL, 10);
+                        break;
+                case 93:
+                        data->block_content_color = strtol (value, NULL, 10);
+                        break;
+                case 110:
+                        data->MLeader_plane_origin_point = strtod (value, NULL);
+                        break;
+                case 111:
+                        data->MLeader_plane_X_axis_direction = strtod (value, NULL);
+                        break;
+                case 112:
+                        data->MLeader_plane_Y_axis_direction = strtod (value, NULL);
+                        break;
+                case 140:
+                        data->arrowhead_size = strtod (value, NULL);
+                        break;
+                case 141:
+                        data->text_background_scale_factor = strtod (value, NULL);
+                        break;
+                case 142:
+                        data->text_column_width = strtod (value, NULL);
+                        break;
+                case 143:
+                        data->text_column_gutter_width = strtod (value, NULL);
+                        break;
+                case 144:
+                        data->text_column_height = strtod (value, NULL);
+                        break;
+                case 145:
+                        data->landing_gap = strtod (value, NULL);
+                        break;
+                case 170:
+                        data->text_line_spacing_style = strtol (value, NULL, 10);
+                        break;
+                case 171:
+                        data->text_attachment = strtol (value, NULL, 10);
+                        break;
+                case 172:
+                        data->text_flow_direction = strtol (value, NULL, 10);
+                        break;
+                case 173:
+                        data->text_column_type = strtol (value, NULL, 10);
+                        break;
+                case 290:
+                        data->has_Mtext = strtol (value, NULL, 10);
+                        break;
+                case 291:
+                        data->is_text_background_color_on = strtol (value, NULL, 10);
+                        break;
+                case 292:
+                        data->is_text_background_fill_on = strtol (value, NULL, 10);
+                        break;
+                case 293:
+                        data->use_text_auto_height = strtol (value, NULL, 10);
+                        break;
+                case 294:
+                        data->text_column_flow_reversed = strtol (value, NULL, 10);
+                        break;
+                case 295:
+                        data->text_use_word_break = strtol (value, NULL, 10);
+                        break;
+                case 296:
+                        data->has_block = strtol (value, NULL, 10);
+                        break;
+                case 297:
+                        data->MLeader_plane_normal_reversed = strtol (value, NULL, 10);
+                        break;
+                case 304:
+                        free (data->default_text_contents);
+                        data->default_text_contents = strdup (value);
+                        break;
+                case 340:
+                        free (data->type_style_id);
+                        data->type_style_id = strdup (value);
+                        break;
+                case 341:
+                        free (data->block_content_id);
+                        data->block_content_id = strdup (value);
+                        break;
+                default:
+                        break;
+        }
+}
+
+
+/*!
+ * \brief Decode a raw group of a leader node of a DXF \c MLEADER
+ * entity.
+ */
+static void
+dxf_mleader_decode_leader_node_group
+(
+        DxfMLeaderLeaderNode *node,
+                /*!< a pointer to the leader node. */
+        int group_code,
+                /*!< the group code. */
+        const char *value
+                /*!< the value of the group. */
+)
+{
+        switch (group_code)
+        {
+                case 10: case 20: case 30:
+                        dxf_mleader_set_point_coordinate (node->p0, group_code, value);
+                        break;
+                case 11: case 21: case 31:
+                        dxf_mleader_set_point_coordinate (node->p1, group_code, value);
+                        break;
+                case 12: case 22: case 32:
+                        dxf_mleader_set_point_coordinate (node->p2, group_code, value);
+                        break;
+                case 13: case 23: case 33:
+                        dxf_mleader_set_point_coordinate (node->p3, group_code, value);
+                        break;
+                case 40:
+                        node->dogleg_length = strtod (value, NULL);
+                        break;
+                case 90:
+                        node->leader_branch_index = strtol (value, NULL, 10);
+                        break;
+                case 290:
+                        node->has_set_last_leader_line_point = strtol (value, NULL, 10);
+                        break;
+                case 291:
+                        node->has_set_dogleg_vector = strtol (value, NULL, 10);
+                        break;
+                default:
+                        break;
+        }
+}
+
+
+/*!
+ * \brief Decode a raw group of a leader line of a DXF \c MLEADER
+ * entity, every group code 10 starts a new vertex.
+ */
+static void
+dxf_mleader_decode_leader_line_group
+(
+        DxfMLeaderLeaderLine *line,
+                /*!< a pointer to the leader line. */
+        DxfPoint **vertex,
+                /*!< a pointer to the last vertex, \c NULL before the
+                 * first vertex. */
+        int group_code,
+                /*!< the group code. */
+        const char *value
+                /*!< the value of the group. */
+)
+{
+        DxfPoint *point = NULL;
+
+        switch (group_code)
+        {
+                case 10:
+                        if (*vertex == NULL)
+                        {
+                                *vertex = line->p0;
+                        }
+                        else
+                        {
+                                point = dxf_point_init (dxf_point_new ());
+                                if (point == NULL)
+                                {
+                                        return;
+                                }
+                                (*vertex)->next = (struct DxfPoint *) point;
+                                *vertex = point;
+                        }
+                        dxf_mleader_set_point_coordinate (*vertex, group_code, value);
+                        break;
+                case 20: case 30:
+                        dxf_mleader_set_point_coordinate (*vertex, group_code, value);
+                        break;
+                case 11: case 21: case 31:
+                        dxf_mleader_set_point_coordinate (line->p1, group_code, value);
+                        break;
+                case 12: case 22: case 32:
+                        dxf_mleader_set_point_coordinate (line->p2, group_code, value);
+                        break;
+                case 90:
+                        line->break_point_index = strtol (value, NULL, 10);
+                        break;
+                case 91:
+                        line->leader_line_index = strtol (value, NULL, 10);
+                        break;
+                default:
+                        break;
+        }
+}
+
+
 /* EOF*/
@@ -48,6 +48,47 @@ extern "C" {
 #endif
 
 
+/*!
+ * \brief Definition of a single raw group in the context data of a DXF
+ * \c MLEADER entity.
+ */
+typedef struct
+dxf_mleader_span_struct
+{
+        int group_code;
+                /*!< Group code. */
+        int offset;
+                /*!< Offset of the \c NUL terminated value in the value
+                 * buffer of the span index. */
+} DxfMLeaderSpan;
+
+
+/*!
+ * \brief Definition of the compact index of the raw groups in the
+ * context data of a DXF \c MLEADER entity.
+ *
+ * The groups between "CONTEXT_DATA{" and "}" are kept as read, all
+ * values back to back in a single buffer, and are only decoded into a
+ * \c DxfMLeaderContextData tree when it is asked for.
+ */
+typedef struct
+dxf_mleader_span_index_struct
+{
+        char *values;
+                /*!< The values, each terminated by a \c NUL. */
+        int values_length;
+                /*!< Number of bytes in use in \c values. */
+        int values_size;
+                /*!< Number of bytes allocated for \c values. */
+        DxfMLeaderSpan *spans;
+                /*!< The groups in file order. */
+        int number_of_spans;
+                /*!< Number of groups. */
+        int max_number_of_spans;
+                /*!< Number of groups allocated for \c spans. */
+} DxfMLeaderSpanIndex;
+
+
 /*!
  * \brief DXF definition of an AutoCAD mleader entity (\c MLEADER).
  */
@@ -312,6 +353,12 @@ dxf_mleader_struct
                  * IDs).\n
                  * Another Arrowhead ID ?.\n
                  * Group code = 345. */
+        DxfMLeaderSpanIndex context_data_index;
+                /*!< The raw groups of the context data.\n
+                 * Group codes = 300 up to 301. */
+        struct DxfMLeaderContextData *context_data;
+                /*!< The decoded context data, \c NULL until it is
+                 * decoded by \c dxf_mleader_get_context_data (). */
         struct DxfMLeader *next;
                 /*!< Pointer to the next DxfMLeader.\n
                  * \c NULL in the last DxfMLeader. */
@@ -461,6 +508,9 @@ dxf_mleader_context_data_struct
                 /*!< Block content ID (string representing hex object
                  * IDs).\n
                  * Group code = 341. */
+        struct DxfMLeaderLeaderNode *leader_node;
+                /*!< Pointer to the first leader node.\n
+                 * Group codes = 302 up to 303. */
         struct DxfMLeaderContextData *next;
                 /*!< Pointer to the next DxfMLeaderContextData.\n
                  * \c NULL in the last DxfMLeaderContextData. */
@@ -497,6 +547,9 @@ dxf_mleader_leader_node_struct
         int has_set_dogleg_vector;
                 /*!< Has set dogleg vector (boolean).\n
                  * Group code = 291. */
+        struct DxfMLeaderLeaderLine *leader_line;
+                /*!< Pointer to the first leader line.\n
+                 * Group codes = 304 up to 305. */
         struct DxfMLeaderLeaderNode *next;
                 /*!< Pointer to the next DxfMLeaderLeaderNode.\n
                  * \c NULL in the last DxfMLeaderLeaderNode. */
@@ -510,7 +563,9 @@ typedef struct
 dxf_mleader_leader_line_struct
 {
         DxfPoint *p0;
-                /*!< Vertex.\n
+                /*!< Vertex, a single linked list of points when the
+                 * leader line has more vertices, the first vertex is
+                 * the arrow tip.\n
                  * Group codes = 10, 20 and 30.*/
         DxfPoint *p1;
                 /*!< Break start point.\n
@@ -654,6 +709,10 @@ DxfMLeader *dxf_mleader_set_arrow_head_id (DxfMLeader *mleader, char *arrow_head
 DxfMLeader *dxf_mleader_get_next (DxfMLeader *mleader);
 DxfMLeader *dxf_mleader_set_next (DxfMLeader *mleader, DxfMLeader *next);
 DxfMLeader *dxf_mleader_get_last (DxfMLeader *mleader);
+int dxf_mleader_append_context_data_group (DxfMLeader *mleader, int group_code, const char *value);
+DxfMLeaderContextData *dxf_mleader_get_context_data (DxfMLeader *mleader);
+char *dxf_mleader_get_text_contents (DxfMLeader *mleader);
+int dxf_mleader_get_arrow_tip (DxfMLeader *mleader, double *x, double *y, double *z);
 DxfMLeaderContextData *dxf_mleader_context_data_new ();
 DxfMLeaderContextData *dxf_mleader_context_data_init (DxfMLeaderContextData *data);
 int dxf_mleader_context_data_free (DxfMLeaderContextData *data);
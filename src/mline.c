@@ -42,6 +42,7 @@
 
 
 #include "mline.h"
+#include "util.h"
 
 
 /*!
@@ -116,8 +117,8 @@ dxf_mline_init
               return (NULL);
         }
         dxf_mline_set_id_code (mline, 0);
-        dxf_mline_set_linetype (mline, strdup (DXF_DEFAULT_LINETYPE));
-        dxf_mline_set_layer (mline, strdup (DXF_DEFAULT_LAYER));
+        mline->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        mline->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         dxf_mline_set_elevation (mline, 0.0);
         dxf_mline_set_thickness (mline, 0.0);
         dxf_mline_set_linetype_scale (mline, DXF_DEFAULT_LINETYPE_SCALE);
@@ -126,17 +127,16 @@ dxf_mline_init
         dxf_mline_set_paperspace (mline, DXF_MODELSPACE);
         dxf_mline_set_graphics_data_size (mline, 0);
         dxf_mline_set_shadow_mode (mline, 0);
-        dxf_mline_set_binary_graphics_data (mline, dxf_binary_graphics_data_new ());
-        dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) dxf_mline_get_binary_graphics_data (mline));
-        dxf_mline_set_dictionary_owner_soft (mline, strdup (""));
-        dxf_mline_set_material (mline, strdup (""));
-        dxf_mline_set_dictionary_owner_hard (mline, strdup (""));
+        mline->binary_graphics_data = NULL;
+        mline->dictionary_owner_soft = dxf_string_share ("");
+        mline->material = dxf_string_share ("");
+        mline->dictionary_owner_hard = dxf_string_share ("");
         dxf_mline_set_lineweight (mline, 0);
-        dxf_mline_set_plot_style_name (mline, strdup (""));
+        mline->plot_style_name = dxf_string_share ("");
         dxf_mline_set_color_value (mline, 0);
-        dxf_mline_set_color_name (mline, strdup (""));
+        mline->color_name = dxf_string_share ("");
         dxf_mline_set_transparency (mline, 0);
-        dxf_mline_set_style_name (mline, strdup (""));
+        mline->style_name = dxf_string_share ("");
         dxf_mline_set_p0 (mline, dxf_point_new ());
         dxf_point_init ((DxfPoint *) dxf_mline_get_p0 (mline));
         dxf_mline_set_p1 (mline, dxf_point_new ());
@@ -159,7 +159,7 @@ dxf_mline_init
         dxf_mline_set_extr_x0 (mline, 0.0);
         dxf_mline_set_extr_y0 (mline, 0.0);
         dxf_mline_set_extr_z0 (mline, 1.0);
-        dxf_mline_set_mlinestyle_dictionary (mline, strdup (""));
+        mline->mlinestyle_dictionary = dxf_string_share ("");
         dxf_mline_set_next (mline, NULL);
 #if DEBUG
         DXF_DEBUG_END
@@ -246,8 +246,7 @@ dxf_mline_read
                         /* Now follows a string containing a string of
                          * up to 32 characters with the name of the
                          * style used for this mline. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mline->style_name);
+                        dxf_read_string (fp, &mline->style_name);
                 }
                 if (strcmp (temp_string, "5") == 0)
                 {
@@ -260,14 +259,12 @@ dxf_mline_read
                 {
                         /* Now follows a string containing a linetype
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mline->linetype);
+                        dxf_read_string (fp, &mline->linetype);
                 }
                 else if (strcmp (temp_string, "8") == 0)
                 {
                         /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mline->layer);
+                        dxf_read_string (fp, &mline->layer);
                 }
                 else if (strcmp (temp_string, "10") == 0)
                 {
@@ -545,22 +542,19 @@ dxf_mline_read
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mline->dictionary_owner_soft);
+                        dxf_read_string (fp, &mline->dictionary_owner_soft);
                 }
                 else if (strcmp (temp_string, "340") == 0)
                 {
                         /* Now follows a string containing a
                          * Pointer-handle/ID of MLINESTYLE dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mline->mlinestyle_dictionary);
+                        dxf_read_string (fp, &mline->mlinestyle_dictionary);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mline->dictionary_owner_hard);
+                        dxf_read_string (fp, &mline->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "999") == 0)
                 {
@@ -916,20 +910,23 @@ dxf_mline_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (mline->linetype);
-        free (mline->layer);
-        dxf_binary_graphics_data_free_list (mline->binary_graphics_data);
-        free (mline->dictionary_owner_soft);
-        free (mline->material);
-        free (mline->dictionary_owner_hard);
-        free (mline->plot_style_name);
-        free (mline->color_name);
-        free (mline->style_name);
+        dxf_string_free (mline->linetype);
+        dxf_string_free (mline->layer);
+        if (mline->binary_graphics_data != NULL)
+        {
+                dxf_binary_graphics_data_free_list (mline->binary_graphics_data);
+        }
+        dxf_string_free (mline->dictionary_owner_soft);
+        dxf_string_free (mline->material);
+        dxf_string_free (mline->dictionary_owner_hard);
+        dxf_string_free (mline->plot_style_name);
+        dxf_string_free (mline->color_name);
+        dxf_string_free (mline->style_name);
         dxf_point_free (mline->p0);
         dxf_point_free_list (mline->p1);
         dxf_point_free_list (mline->p2);
         dxf_point_free_list (mline->p3);
-        free (mline->mlinestyle_dictionary);
+        dxf_string_free (mline->mlinestyle_dictionary);
         free (mline);
         mline = NULL;
 #if DEBUG
@@ -1101,6 +1098,8 @@ dxf_mline_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (mline == NULL)
         {
@@ -1116,7 +1115,13 @@ dxf_mline_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        mline->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (mline->linetype);
+        mline->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1176,6 +1181,8 @@ dxf_mline_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (mline == NULL)
         {
@@ -1191,7 +1198,13 @@ dxf_mline_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        mline->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (mline->layer);
+        mline->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1980,6 +1993,8 @@ dxf_mline_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (mline == NULL)
         {
@@ -1995,7 +2010,13 @@ dxf_mline_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        mline->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (mline->dictionary_owner_soft);
+        mline->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2062,6 +2083,8 @@ dxf_mline_set_material
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (mline == NULL)
         {
@@ -2077,7 +2100,13 @@ dxf_mline_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        mline->material = strdup (material);
+        copy = dxf_string_share (material);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (mline->material);
+        mline->material = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2142,6 +2171,8 @@ dxf_mline_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (mline == NULL)
         {
@@ -2157,7 +2188,13 @@ dxf_mline_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        mline->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (mline->dictionary_owner_hard);
+        mline->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2287,6 +2324,8 @@ dxf_mline_set_plot_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (mline == NULL)
         {
@@ -2302,7 +2341,13 @@ dxf_mline_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        mline->plot_style_name = strdup (plot_style_name);
+        copy = dxf_string_share (plot_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (mline->plot_style_name);
+        mline->plot_style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2432,6 +2477,8 @@ dxf_mline_set_color_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (mline == NULL)
         {
@@ -2447,7 +2494,13 @@ dxf_mline_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        mline->color_name = strdup (color_name);
+        copy = dxf_string_share (color_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (mline->color_name);
+        mline->color_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2577,6 +2630,8 @@ dxf_mline_set_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (mline == NULL)
         {
@@ -2592,7 +2647,13 @@ dxf_mline_set_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        mline->style_name = strdup (style_name);
+        copy = dxf_string_share (style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (mline->style_name);
+        mline->style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -5012,6 +5073,8 @@ dxf_mline_set_mlinestyle_dictionary
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (mline == NULL)
         {
@@ -5027,7 +5090,13 @@ dxf_mline_set_mlinestyle_dictionary
                   __FUNCTION__);
                 return (NULL);
         }
-        mline->mlinestyle_dictionary = strdup (mlinestyle_dictionary);
+        copy = dxf_string_share (mlinestyle_dictionary);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (mline->mlinestyle_dictionary);
+        mline->mlinestyle_dictionary = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
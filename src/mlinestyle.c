@@ -42,6 +42,7 @@
 
 
 #include "mlinestyle.h"
+#include "util.h"
 
 
 /*!
@@ -116,11 +117,11 @@ dxf_mlinestyle_init
                   __FUNCTION__);
                 return (NULL);
         }
-        dxf_mlinestyle_set_name (mlinestyle, strdup (""));
-        dxf_mlinestyle_set_description (mlinestyle, strdup (""));
+        mlinestyle->name = dxf_string_share ("");
+        mlinestyle->description = dxf_string_share ("");
         dxf_mlinestyle_set_id_code (mlinestyle, 0);
-        dxf_mlinestyle_set_dictionary_owner_soft (mlinestyle, strdup (""));
-        dxf_mlinestyle_set_dictionary_owner_hard (mlinestyle, strdup (""));
+        mlinestyle->dictionary_owner_soft = dxf_string_share ("");
+        mlinestyle->dictionary_owner_hard = dxf_string_share ("");
         dxf_mlinestyle_set_start_angle (mlinestyle, 0.0);
         dxf_mlinestyle_set_end_angle (mlinestyle, 0.0);
         dxf_mlinestyle_set_color (mlinestyle, DXF_COLOR_BYLAYER);
@@ -209,15 +210,13 @@ dxf_mlinestyle_read
                 {
                         /* Now follows a string containing a mlinestyle
                          * name string. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mlinestyle->name);
+                        dxf_read_string (fp, &mlinestyle->name);
                 }
                 if (strcmp (temp_string, "3") == 0)
                 {
                         /* Now follows a string containing a description
                          * string. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mlinestyle->description);
+                        dxf_read_string (fp, &mlinestyle->description);
                 }
                 if (strcmp (temp_string, "5") == 0)
                 {
@@ -304,15 +303,13 @@ dxf_mlinestyle_read
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mlinestyle->dictionary_owner_soft);
+                        dxf_read_string (fp, &mlinestyle->dictionary_owner_soft);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mlinestyle->dictionary_owner_hard);
+                        dxf_read_string (fp, &mlinestyle->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "999") == 0)
                 {
@@ -489,10 +486,10 @@ dxf_mlinestyle_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (dxf_mlinestyle_get_dictionary_owner_soft (mlinestyle));
-        free (dxf_mlinestyle_get_dictionary_owner_hard (mlinestyle));
-        free (dxf_mlinestyle_get_name (mlinestyle));
-        free (dxf_mlinestyle_get_description (mlinestyle));
+        dxf_string_free (mlinestyle->dictionary_owner_soft);
+        dxf_string_free (mlinestyle->dictionary_owner_hard);
+        dxf_string_free (mlinestyle->name);
+        dxf_string_free (mlinestyle->description);
         for (i = 0; i < DXF_MAX_PARAM; i++)
         {
                 free (dxf_mlinestyle_get_ith_element_linetype (mlinestyle, 1));
@@ -673,6 +670,8 @@ dxf_mlinestyle_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (mlinestyle == NULL)
         {
@@ -688,7 +687,13 @@ dxf_mlinestyle_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        mlinestyle->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (mlinestyle->dictionary_owner_soft);
+        mlinestyle->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -753,6 +758,8 @@ dxf_mlinestyle_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (mlinestyle == NULL)
         {
@@ -768,7 +775,13 @@ dxf_mlinestyle_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        mlinestyle->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (mlinestyle->dictionary_owner_hard);
+        mlinestyle->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -830,6 +843,8 @@ dxf_mlinestyle_set_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (mlinestyle == NULL)
         {
@@ -845,7 +860,13 @@ dxf_mlinestyle_set_name
                   __FUNCTION__);
                 return (NULL);
         }
-        mlinestyle->name = strdup (name);
+        copy = dxf_string_share (name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (mlinestyle->name);
+        mlinestyle->name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -908,6 +929,8 @@ dxf_mlinestyle_set_description
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (mlinestyle == NULL)
         {
@@ -923,7 +946,13 @@ dxf_mlinestyle_set_description
                   __FUNCTION__);
                 return (NULL);
         }
-        mlinestyle->description = strdup (description);
+        copy = dxf_string_share (description);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (mlinestyle->description);
+        mlinestyle->description = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
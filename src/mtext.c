@@ -42,6 +42,8 @@
 
 
 #include "mtext.h"
+#include "stats.h"
+#include "util.h"
 
 
 /*!
@@ -71,6 +73,7 @@ dxf_mtext_new ()
         else
         {
                 memset (mtext, 0, size);
+                dxf_stats_count_allocation (MTEXT, size);
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -95,8 +98,6 @@ dxf_mtext_init
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        int i;
-
         /* Do some basic checks. */
         if (mtext == NULL)
         {
@@ -114,16 +115,16 @@ dxf_mtext_init
         }
         mtext->id_code = 0;
         mtext->text_value = strdup ("");
-        for (i = 1; i < DXF_MAX_PARAM; i++)
-        {
-                mtext->text_additional_value[i] = strdup ("");
-        }
         mtext->linetype = strdup (DXF_DEFAULT_LINETYPE);
         mtext->text_style = strdup ("");
         mtext->layer = strdup (DXF_DEFAULT_LAYER);
+        mtext->p0 = dxf_point_new ();
+        mtext->p0 = dxf_point_init (mtext->p0);
         mtext->p0->x0 = 0.0;
         mtext->p0->y0 = 0.0;
         mtext->p0->z0 = 0.0;
+        mtext->p1 = dxf_point_new ();
+        mtext->p1 = dxf_point_init (mtext->p1);
         mtext->p1->x0 = 0.0;
         mtext->p1->y0 = 0.0;
         mtext->p1->z0 = 0.0;
@@ -156,6 +157,9 @@ dxf_mtext_init
         mtext->background_color_rgb = 0;
         mtext->background_color_name = strdup ("");
         mtext->background_transparency = 0;
+        mtext->dictionary_owner_soft = strdup ("");
+        mtext->dictionary_owner_hard = strdup ("");
+        mtext->next = NULL;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -172,8 +176,7 @@ dxf_mtext_init
  * section marker \c ENDSEC. \n
  * While parsing the DXF file store data in \c mtext. \n
  *
- * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
- * occurred.
+ * \return a pointer to \c mtext, or \c NULL when an error occurred.
  */
 DxfMtext *
 dxf_mtext_read
@@ -187,7 +190,8 @@ dxf_mtext_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        int status;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -195,8 +199,6 @@ dxf_mtext_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (mtext == NULL)
@@ -207,102 +209,82 @@ dxf_mtext_read
                 mtext = dxf_mtext_new ();
                 mtext = dxf_mtext_init (mtext);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        while ((dxf_read_group_code (fp, temp_string, DXF_MAX_STRING_LENGTH) == EXIT_SUCCESS)
+          && (strcmp (temp_string, "0") != 0))
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "1") == 0)
-                {
-                        /* Now follows a string containing a text value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mtext->text_value);
-                }
-                else if (strcmp (temp_string, "3") == 0)
+                if ((strcmp (temp_string, "1") == 0)
+                  || (strcmp (temp_string, "3") == 0))
                 {
-                        /* Now follows a string containing a text value. */
-                        (fp->line_number)++;
-                        //fscanf (fp->fp, "%s\n", mtext->text_additional_value[number_additional]);
-                        //number_additional++;
+                        /* Now follows a string containing (a chunk of)
+                         * a text value, the chunks are joined in the
+                         * order read. */
+                        status = dxf_read_text_line (fp, temp_string, DXF_MAX_STRING_LENGTH);
+                        if (status == EXIT_SUCCESS)
+                        {
+                                if (dxf_mtext_append_text_value (mtext, temp_string) == NULL)
+                                {
+                                        status = EXIT_FAILURE;
+                                }
+                        }
                 }
-                /*!< I'm not sure this number_additional is correct.*/
                 else if (strcmp (temp_string, "5") == 0)
                 {
                         /* Now follows a string containing a sequential
                          * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &mtext->id_code);
+                        status = dxf_read_hex (fp, &mtext->id_code);
                 }
                 else if (strcmp (temp_string, "6") == 0)
                 {
                         /* Now follows a string containing a linetype
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mtext->linetype);
+                        status = dxf_read_string (fp, &mtext->linetype);
                 }
                 else if (strcmp (temp_string, "7") == 0)
                 {
                         /* Now follows a string containing a text style
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mtext->text_style);
+                        status = dxf_read_string (fp, &mtext->text_style);
                 }
                 else if (strcmp (temp_string, "8") == 0)
                 {
                         /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mtext->layer);
+                        status = dxf_read_string (fp, &mtext->layer);
                 }
                 else if (strcmp (temp_string, "10") == 0)
                 {
                         /* Now follows a string containing the
                          * X-coordinate of the insertion point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mtext->p0->x0);
+                        status = dxf_read_double (fp, &mtext->p0->x0);
                 }
                 else if (strcmp (temp_string, "20") == 0)
                 {
                         /* Now follows a string containing the
                          * Y-coordinate of the insertion point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mtext->p0->y0);
+                        status = dxf_read_double (fp, &mtext->p0->y0);
                 }
                 else if (strcmp (temp_string, "30") == 0)
                 {
                         /* Now follows a string containing the
                          * Z-coordinate of the insertion point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mtext->p0->z0);
+                        status = dxf_read_double (fp, &mtext->p0->z0);
                 }
                 else if (strcmp (temp_string, "11") == 0)
                 {
                         /* Now follows a string containing the
                          * X-coordinate of the direction vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mtext->p1->x0);
+                        status = dxf_read_double (fp, &mtext->p1->x0);
                 }
                 else if (strcmp (temp_string, "21") == 0)
                 {
                         /* Now follows a string containing the
                          * Y-coordinate of the direction vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mtext->p1->y0);
+                        status = dxf_read_double (fp, &mtext->p1->y0);
                 }
                 else if (strcmp (temp_string, "31") == 0)
                 {
                         /* Now follows a string containing the
                          * Z-coordinate of the direction vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mtext->p1->z0);
+                        status = dxf_read_double (fp, &mtext->p1->z0);
                 }
                 else if ((fp->acad_version_number <= AutoCAD_11)
                   && DXF_FLATLAND
@@ -310,160 +292,141 @@ dxf_mtext_read
                 {
                         /* Now follows a string containing the
                          * elevation. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mtext->elevation);
+                        status = dxf_read_double (fp, &mtext->elevation);
                 }
                 else if (strcmp (temp_string, "39") == 0)
                 {
                         /* Now follows a string containing the
                          * thickness. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mtext->thickness);
+                        status = dxf_read_double (fp, &mtext->thickness);
                 }
                 else if (strcmp (temp_string, "40") == 0)
                 {
                         /* Now follows a string containing the
                          * height. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mtext->height);
+                        status = dxf_read_double (fp, &mtext->height);
                 }
                 else if (strcmp (temp_string, "41") == 0)
                 {
                         /* Now follows a string containing the
                          * reference rectangle width. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mtext->rectangle_width);
+                        status = dxf_read_double (fp, &mtext->rectangle_width);
                 }
                 else if (strcmp (temp_string, "42") == 0)
                 {
                         /* Now follows a string containing the
                          * horizontal width of the characters. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mtext->horizontal_width);
+                        status = dxf_read_double (fp, &mtext->horizontal_width);
                 }
                 else if (strcmp (temp_string, "43") == 0)
                 {
                         /* Now follows a string containing the
                          * vertical rectangle height. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mtext->rectangle_height);
+                        status = dxf_read_double (fp, &mtext->rectangle_height);
                 }
                 else if (strcmp (temp_string, "44") == 0)
                 {
                         /* Now follows a string containing the
                          * text line spacing factor. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mtext->spacing_factor);
+                        status = dxf_read_double (fp, &mtext->spacing_factor);
                 }
                 else if (strcmp (temp_string, "45") == 0)
                 {
                         /* Now follows a string containing the
                          * fill box scale (border around text). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mtext->box_scale);
+                        status = dxf_read_double (fp, &mtext->box_scale);
                 }
                 else if (strcmp (temp_string, "48") == 0)
                 {
                         /* Now follows a string containing the
                          * column width. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mtext->column_width);
+                        status = dxf_read_double (fp, &mtext->column_width);
                 }
                 else if (strcmp (temp_string, "49") == 0)
                 {
                         /* Now follows a string containing the
                          * column gutter. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mtext->column_gutter);
+                        status = dxf_read_double (fp, &mtext->column_gutter);
                 }
                 else if ((fp->acad_version_number <= AutoCAD_2006)
                         && (strcmp (temp_string, "50") == 0))
                 {
                         /* Now follows a string containing the
                          * rotation angle. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mtext->rot_angle);
+                        status = dxf_read_double (fp, &mtext->rot_angle);
                 }
                 else if ((fp->acad_version_number >= AutoCAD_2007)
                         && (strcmp (temp_string, "50") == 0))
                 {
                         /* Can follows a string containing the
                          * rotation angle or column heights. */
-                        (fp->line_number)++;
-                /*!< Add more code here, I'm stop because the double use of group code 50*/
+                        /*! \todo Add column heights, for now the
+                         * value is taken as the rotation angle. */
+                        status = dxf_read_double (fp, &mtext->rot_angle);
                 }
                 else if (strcmp (temp_string, "63") == 0)
                 {
                         /* Now follows a string containing the
                          * color to use for background fill. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &mtext->background_color);
+                        status = dxf_read_int (fp, &mtext->background_color);
                 }
                 else if (strcmp (temp_string, "71") == 0)
                 {
                         /* Now follows a string containing the
                          * attachment point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &mtext->attachment_point);
+                        status = dxf_read_int (fp, &mtext->attachment_point);
                 }
                 else if (strcmp (temp_string, "72") == 0)
                 {
                         /* Now follows a string containing the
                          * drawing direction. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &mtext->drawing_direction);
+                        status = dxf_read_int (fp, &mtext->drawing_direction);
                 }
                 else if (strcmp (temp_string, "73") == 0)
                 {
                         /* Now follows a string containing the
                          * mtext line spacing style. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &mtext->spacing_style);
+                        status = dxf_read_int (fp, &mtext->spacing_style);
                 }
                 else if (strcmp (temp_string, "75") == 0)
                 {
                         /* Now follows a string containing the
                          * column type. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &mtext->column_type);
+                        status = dxf_read_int (fp, &mtext->column_type);
                 }
                 else if (strcmp (temp_string, "76") == 0)
                 {
                         /* Now follows a string containing the
                          * column count. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &mtext->column_count);
+                        status = dxf_read_int (fp, &mtext->column_count);
                 }
                 else if (strcmp (temp_string, "78") == 0)
                 {
                         /* Now follows a string containing the
                          * column flow reverse. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &mtext->column_flow);
+                        status = dxf_read_int (fp, &mtext->column_flow);
                 }
                 else if (strcmp (temp_string, "79") == 0)
                 {
                         /* Now follows a string containing the
                          * column autoheight. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &mtext->column_autoheight);
+                        status = dxf_read_int (fp, &mtext->column_autoheight);
                 }
                 else if (strcmp (temp_string, "90") == 0)
                 {
                         /* Now follows a string containing the
                          * background fill setting. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &mtext->background_fill);
+                        status = dxf_read_int (fp, &mtext->background_fill);
                 }
                 else if ((fp->acad_version_number >= AutoCAD_13)
                         && (strcmp (temp_string, "100") == 0))
                 {
                         /* Now follows a string containing the
                          * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if ((strcmp (temp_string, "AcDbEntity") != 0)
-                        && ((strcmp (temp_string, "AcDbMText") != 0)))
+                        status = dxf_read_text_line (fp, temp_string, DXF_MAX_STRING_LENGTH);
+                        if ((status == EXIT_SUCCESS)
+                          && (strcmp (temp_string, "AcDbEntity") != 0)
+                          && (strcmp (temp_string, "AcDbMText") != 0))
                         {
                                 fprintf (stderr,
                                   (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
@@ -474,36 +437,43 @@ dxf_mtext_read
                 {
                         /* Now follows a string containing the
                          * X-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mtext->extr_x0);
+                        status = dxf_read_double (fp, &mtext->extr_x0);
                 }
                 else if (strcmp (temp_string, "220") == 0)
                 {
                         /* Now follows a string containing the
                          * Y-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mtext->extr_y0);
+                        status = dxf_read_double (fp, &mtext->extr_y0);
                 }
                 else if (strcmp (temp_string, "230") == 0)
                 {
                         /* Now follows a string containing the
                          * Z-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mtext->extr_z0);
+                        status = dxf_read_double (fp, &mtext->extr_z0);
                 }
                 else if (strcmp (temp_string, "999") == 0)
                 {
                         /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
+                        status = dxf_read_text_line (fp, temp_string, DXF_MAX_STRING_LENGTH);
+                        if (status == EXIT_SUCCESS)
+                        {
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                        }
                 }
-
                 else
                 {
                         fprintf (stderr,
                           (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                           __FUNCTION__, fp->filename, fp->line_number);
+                        /* Skip the value of the unknown group code. */
+                        status = dxf_read_text_line (fp, temp_string, DXF_MAX_STRING_LENGTH);
+                }
+                if (status != EXIT_SUCCESS)
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                          __FUNCTION__, fp->filename, fp->line_number);
+                        return (NULL);
                 }
         }
         /* Handle omitted members and/or illegal values. */
@@ -515,12 +485,10 @@ dxf_mtext_read
         {
                 mtext->layer = strdup (DXF_DEFAULT_LAYER);
         }
-        /* Clean up. */
-        free (temp_string);
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (EXIT_SUCCESS);
+        return (mtext);
 }
 
 
@@ -550,6 +518,8 @@ dxf_mtext_write
         DXF_DEBUG_BEGIN
 #endif
         char *dxf_entity_name = strdup ("MTEXT");
+        char *text_value = NULL;
+        size_t length;
         int i;
 
         /* Do some basic checks. */
@@ -681,13 +651,22 @@ dxf_mtext_write
         fprintf (fp->fp, " 41\n%f\n", mtext->rectangle_width);
         fprintf (fp->fp, " 71\n%d\n", mtext->attachment_point);
         fprintf (fp->fp, " 72\n%d\n", mtext->drawing_direction);
-        fprintf (fp->fp, "  1\n%s\n", mtext->text_value);
-        i = 0;
-        while (strlen (mtext->text_additional_value[i]) > 0)
-        {
-                fprintf (fp->fp, "  3\n%s\n", mtext->text_additional_value[i]);
-                i++;
+        /* Divide the text value in chunks, all but the last one in
+         * group 3, without splitting an UTF-8 sequence. */
+        text_value = mtext->text_value;
+        length = strlen (text_value);
+        while (length >= DXF_MTEXT_CHUNK_LENGTH)
+        {
+                i = DXF_MTEXT_CHUNK_LENGTH;
+                while ((i > 1) && ((text_value[i] & 0xC0) == 0x80))
+                {
+                        i--;
+                }
+                fprintf (fp->fp, "  3\n%.*s\n", i, text_value);
+                text_value += i;
+                length -= i;
         }
+        fprintf (fp->fp, "  1\n%s\n", text_value);
         fprintf (fp->fp, "  7\n%s\n", mtext->text_style);
 
         if ((fp->acad_version_number >= AutoCAD_12)
@@ -731,8 +710,6 @@ dxf_mtext_free
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        int i;
-
         /* Do some basic checks. */
         if (mtext == NULL)
         {
@@ -748,17 +725,15 @@ dxf_mtext_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (mtext->linetype);
-        free (mtext->layer);
-        free (mtext->text_value);
-        for (i = 0; i < DXF_MAX_PARAM; i++)
-        {
-                free (mtext->text_additional_value[i]);
-        }
-        free (mtext->text_style);
-        free (mtext->dictionary_owner_soft);
-        free (mtext->dictionary_owner_hard);
-        free (mtext->background_color_name);
+        dxf_string_free (mtext->linetype);
+        dxf_string_free (mtext->layer);
+        dxf_string_free (mtext->text_value);
+        dxf_string_free (mtext->text_style);
+        dxf_string_free (mtext->dictionary_owner_soft);
+        dxf_string_free (mtext->dictionary_owner_hard);
+        dxf_string_free (mtext->background_color_name);
+        dxf_point_free (mtext->p0);
+        dxf_point_free (mtext->p1);
         free (mtext);
         mtext = NULL;
 #if DEBUG
@@ -2429,6 +2404,62 @@ dxf_mtext_set_text_value
 }
 
 
+/*!
+ * \brief Append a string to the \c text_value of a DXF \c MTEXT
+ * entity, e.g. a chunk of the text value read from group code 3 or 1.
+ *
+ * \return a pointer to \c mtext when successful, or \c NULL when an
+ * error occurred.
+ */
+DxfMtext *
+dxf_mtext_append_text_value
+(
+        DxfMtext *mtext,
+                /*!< a pointer to a DXF \c MTEXT entity. */
+        char *text_value
+                /*!< a string containing the part of the \c text_value
+                 * to append. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        char *joined = NULL;
+        size_t length;
+
+        /* Do some basic checks. */
+        if (mtext == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        if (text_value == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        length = (mtext->text_value == NULL) ? 0 : strlen (mtext->text_value);
+        joined = realloc (mtext->text_value, length + strlen (text_value) + 1);
+        if (joined == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        strcpy (joined + length, text_value);
+        mtext->text_value = joined;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (mtext);
+}
+
+
 /*!
  * \brief Get the \c text_style from a DXF \c MTEXT entity.
  *
@@ -55,6 +55,11 @@ extern "C" {
 #endif
 
 
+#define DXF_MTEXT_CHUNK_LENGTH 250
+        /*!< \brief Maximum number of characters in a group 3 chunk of
+         * the text string. */
+
+
 /*!
  * \brief DXF definition of an AutoCAD mtext entity (\c MTEXT).
  */
@@ -195,11 +200,9 @@ dxf_mtext_struct
                  * which appear in one or more group 3 codes.\n
                  * If group 3 codes are used, the last group is a group
                  * 1 and has fewer than 250 characters.\n
-                 * Group code = 1. */
-        char *text_additional_value[DXF_MAX_PARAM];
-                /*!< Optional, only if the text string in group 1 is
-                 * greater than 250 characters.\n
-                 * Group code = 3. */
+                 * The chunks are joined into this single string while
+                 * reading, and divided again while writing.\n
+                 * Group codes = 1 and 3. */
         char *text_style;
                 /*!< Text style.\n
                  * Optional, defaults to \c STANDARD.\n
@@ -394,6 +397,7 @@ long dxf_mtext_get_transparency (DxfMtext *mtext);
 DxfMtext *dxf_mtext_set_transparency (DxfMtext *mtext, long transparency);
 char *dxf_mtext_get_text_value (DxfMtext *mtext);
 DxfMtext *dxf_mtext_set_text_value (DxfMtext *mtext, char *text_value);
+DxfMtext *dxf_mtext_append_text_value (DxfMtext *mtext, char *text_value);
 char *dxf_mtext_get_text_style (DxfMtext *mtext);
 DxfMtext *dxf_mtext_set_text_style (DxfMtext *mtext, char *text_style);
 DxfPoint *dxf_mtext_get_p0 (DxfMtext *mtext);
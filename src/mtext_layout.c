@@ -0,0 +1,1943 @@
+/*!
+ * \file mtext_layout.c
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Functions for parsing the inline formatting codes of DXF
+ * \c MTEXT entities and laying out the resulting runs.
+ *
+ * The text string is parsed in a single pass into a list of runs with a
+ * single format each, and the plain text without formatting codes.\n
+ * The layout breaks the runs into lines at spaces, paragraph breaks and
+ * the width of the reference rectangle, using advance widths from a
+ * cache per font, so the advance widths of a font are determined only
+ * once for many \c MTEXT entities.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include "mtext_layout.h"
+
+
+/*!
+ * \brief The format of the text while parsing.
+ */
+typedef struct
+dxf_mtext_run_state_struct
+{
+        int font;
+        int flags;
+        double height;
+        double width_factor;
+        double oblique_angle;
+        double tracking;
+        int color;
+        long color_value;
+} DxfMtextRunState;
+
+
+static int dxf_mtext_run_list_add_run (DxfMtextRunList *list, DxfMtextRunState *state, int type);
+static int dxf_mtext_run_list_append (DxfMtextRunList *list, const char *bytes, int length);
+static int dxf_mtext_run_list_append_unescaped (DxfMtextRunList *list, const char *bytes, int length);
+static int dxf_mtext_run_list_append_codepoint (DxfMtextRunList *list, unsigned int codepoint);
+static int dxf_mtext_run_list_put (DxfMtextRunList *list, DxfMtextRunState *state, int *run, const char *bytes, int length);
+static int dxf_mtext_run_list_add_font (DxfMtextRunList *list, const char *name, int length);
+static int dxf_mtext_run_list_read_value (const char *text, int *position);
+static unsigned int dxf_mtext_decode (const char *text, int *position);
+static int dxf_mtext_glyph_cache_find_font (DxfMtextGlyphCache *cache, const char *font);
+static double dxf_mtext_glyph_cache_get_font_advance (DxfMtextGlyphCache *cache, int font, unsigned int codepoint);
+static double dxf_mtext_glyph_cache_estimate (unsigned int codepoint);
+static double dxf_mtext_layout_get_width (DxfMtextGlyphCache *cache, int font, DxfMtextRun *run, const char *text, int length);
+static int dxf_mtext_layout_add_line (DxfMtextLayout *layout, double height);
+static int dxf_mtext_layout_add_fragment (DxfMtextLayout *layout, int run, int text_start, int text_length, double x);
+
+
+/*!
+ * \brief Allocate memory for a \c DxfMtextRunList.
+ *
+ * Fill the memory contents with zeros.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfMtextRunList *
+dxf_mtext_run_list_new ()
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfMtextRunList *list = NULL;
+        size_t size;
+
+        size = sizeof (DxfMtextRunList);
+        /* avoid malloc of 0 bytes */
+        if (size == 0) size = 1;
+        if ((list = malloc (size)) == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                list = NULL;
+        }
+        else
+        {
+                memset (list, 0, size);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (list);
+}
+
+
+/*!
+ * \brief Allocate memory and initialize data fields in a
+ * \c DxfMtextRunList.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfMtextRunList *
+dxf_mtext_run_list_init
+(
+        DxfMtextRunList *list
+                /*!< a pointer to the run list. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (list == NULL)
+        {
+                fprintf (stderr,
+                  (_("Warning in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                list = dxf_mtext_run_list_new ();
+        }
+        if (list == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        list->number_of_runs = 0;
+        list->max_number_of_runs = 0;
+        list->runs = NULL;
+        list->text_length = 0;
+        list->max_text_length = 0;
+        list->text = NULL;
+        list->font_names_length = 0;
+        list->max_font_names_length = 0;
+        list->font_names = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (list);
+}
+
+
+/*!
+ * \brief Parse an \c MTEXT text string into a \c DxfMtextRunList.
+ *
+ * Recognised are the formatting codes \\P and \\N (breaks), \\~ (non
+ * breaking space), \\\\, \\{ and \\} (literals), \\L, \\l, \\O, \\o,
+ * \\K and \\k (underline, overline and strike through), \\f and \\F
+ * (font), \\H, \\W and \\T (height, width and tracking, absolute or
+ * relative with a trailing x), \\Q (obliquing), \\C and \\c (ACI and
+ * true color), \\S (stacking), \\U+ (unicode character), the groups
+ * { and }, and the special characters %%d, %%p, %%c and %%%.\n
+ * The codes \\A and \\p are skipped, other codes are kept as text.\n
+ * Any previous contents of the list are replaced, the memory is
+ * reused.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_mtext_run_list_parse
+(
+        DxfMtextRunList *list,
+                /*!< a pointer to the run list. */
+        const char *text,
+                /*!< the text string. */
+        double height
+                /*!< the text height of the \c MTEXT entity. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfMtextRunState state;
+        DxfMtextRunState *stack = NULL;
+        DxfMtextRunState *grown = NULL;
+        DxfMtextRun *stacked = NULL;
+        const char *value = NULL;
+        char *end = NULL;
+        int max_depth;
+        int depth;
+        int run;
+        int position;
+        int start;
+        int length;
+        int separator;
+        int status;
+        int j;
+        char code;
+
+        /* Do some basic checks. */
+        if ((list == NULL) || (text == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        list->number_of_runs = 0;
+        list->text_length = 0;
+        list->font_names_length = 0;
+        status = dxf_mtext_run_list_append (list, "", 0);
+        state.font = -1;
+        state.flags = 0;
+        state.height = height;
+        state.width_factor = 1.0;
+        state.oblique_angle = 0.0;
+        state.tracking = 1.0;
+        state.color = DXF_COLOR_BYLAYER;
+        state.color_value = -1;
+        max_depth = 0;
+        depth = 0;
+        /* No text run open. */
+        run = -1;
+        position = 0;
+        while ((status == EXIT_SUCCESS) && (text[position] != '\0'))
+        {
+                if (text[position] == '{')
+                {
+                        if (depth == max_depth)
+                        {
+                                max_depth = (max_depth == 0) ? 8 : 2 * max_depth;
+                                grown = realloc (stack, max_depth * sizeof (DxfMtextRunState));
+                                if (grown == NULL)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () could not allocate memory.\n")),
+                                          __FUNCTION__);
+                                        status = EXIT_FAILURE;
+                                        break;
+                                }
+                                stack = grown;
+                        }
+                        stack[depth] = state;
+                        depth++;
+                        position++;
+                        continue;
+                }
+                if (text[position] == '}')
+                {
+                        /* An unbalanced brace is ignored. */
+                        if (depth > 0)
+                        {
+                                depth--;
+                                state = stack[depth];
+                                run = -1;
+                        }
+                        position++;
+                        continue;
+                }
+                if ((text[position] == '%') && (text[position + 1] == '%')
+                  && (text[position + 2] != '\0')
+                  && (strchr ("dDpPcC%", text[position + 2]) != NULL))
+                {
+                        switch (tolower ((unsigned char) text[position + 2]))
+                        {
+                                case 'd':
+                                        /* Degree sign. */
+                                        status = dxf_mtext_run_list_put (list, &state, &run, "\xC2\xB0", 2);
+                                        break;
+                                case 'p':
+                                        /* Plus minus sign. */
+                                        status = dxf_mtext_run_list_put (list, &state, &run, "\xC2\xB1", 2);
+                                        break;
+                                case 'c':
+                                        /* Diameter sign. */
+                                        status = dxf_mtext_run_list_put (list, &state, &run, "\xE2\x8C\x80", 3);
+                                        break;
+                                default:
+                                        status = dxf_mtext_run_list_put (list, &state, &run, "%", 1);
+                                        break;
+                        }
+                        position += 3;
+                        continue;
+                }
+                if ((text[position] != '\\') || (text[position + 1] == '\0'))
+                {
+                        status = dxf_mtext_run_list_put (list, &state, &run, text + position, 1);
+                        position++;
+                        continue;
+                }
+                code = text[position + 1];
+                position += 2;
+                switch (code)
+                {
+                        case 'P':
+                        case 'N':
+                                run = -1;
+                                status = dxf_mtext_run_list_add_run (list, &state, DXF_MTEXT_RUN_PARAGRAPH);
+                                if (status == EXIT_SUCCESS)
+                                {
+                                        status = dxf_mtext_run_list_append (list, "\n", 1);
+                                        list->runs[list->number_of_runs - 1].text_length = 1;
+                                }
+                                break;
+                        case '~':
+                                /* Non breaking space. */
+                                status = dxf_mtext_run_list_put (list, &state, &run, "\xC2\xA0", 2);
+                                break;
+                        case '\\':
+                        case '{':
+                        case '}':
+                                status = dxf_mtext_run_list_put (list, &state, &run, &code, 1);
+                                break;
+                        case 'L':
+                        case 'l':
+                                state.flags = (code == 'L')
+                                  ? (state.flags | DXF_MTEXT_RUN_UNDERLINE)
+                                  : (state.flags & ~DXF_MTEXT_RUN_UNDERLINE);
+                                run = -1;
+                                break;
+                        case 'O':
+                        case 'o':
+                                state.flags = (code == 'O')
+                                  ? (state.flags | DXF_MTEXT_RUN_OVERLINE)
+                                  : (state.flags & ~DXF_MTEXT_RUN_OVERLINE);
+                                run = -1;
+                                break;
+                        case 'K':
+                        case 'k':
+                                state.flags = (code == 'K')
+                                  ? (state.flags | DXF_MTEXT_RUN_STRIKETHROUGH)
+                                  : (state.flags & ~DXF_MTEXT_RUN_STRIKETHROUGH);
+                                run = -1;
+                                break;
+                        case 'f':
+                        case 'F':
+                                /* Font name, for \f followed by options
+                                 * like |b1|i0|c0|p34. */
+                                start = position;
+                                length = dxf_mtext_run_list_read_value (text, &position);
+                                value = text + start;
+                                j = 0;
+                                while ((j < length) && ((code == 'F') || (value[j] != '|')))
+                                {
+                                        j++;
+                                }
+                                state.font = dxf_mtext_run_list_add_font (list, value, j);
+                                if (state.font < 0)
+                                {
+                                        status = EXIT_FAILURE;
+                                }
+                                for (; j + 2 < length; j++)
+                                {
+                                        if (value[j] != '|')
+                                        {
+                                                continue;
+                                        }
+                                        if (value[j + 1] == 'b')
+                                        {
+                                                state.flags = (value[j + 2] == '1')
+                                                  ? (state.flags | DXF_MTEXT_RUN_BOLD)
+                                                  : (state.flags & ~DXF_MTEXT_RUN_BOLD);
+                                        }
+                                        else if (value[j + 1] == 'i')
+                                        {
+                                                state.flags = (value[j + 2] == '1')
+                                                  ? (state.flags | DXF_MTEXT_RUN_ITALIC)
+                                                  : (state.flags & ~DXF_MTEXT_RUN_ITALIC);
+                                        }
+                                }
+                                run = -1;
+                                break;
+                        case 'H':
+                        case 'W':
+                        case 'T':
+                        case 'Q':
+                                start = position;
+                                length = dxf_mtext_run_list_read_value (text, &position);
+                                value = text + start;
+                                if (length == 0)
+                                {
+                                        break;
+                                }
+                                /* A trailing x makes the value relative
+                                 * to the current one. */
+                                if (code == 'H')
+                                {
+                                        state.height = (value[length - 1] == 'x')
+                                          ? state.height * strtod (value, &end)
+                                          : strtod (value, &end);
+                                }
+                                else if (code == 'W')
+                                {
+                                        state.width_factor = (value[length - 1] == 'x')
+                                          ? state.width_factor * strtod (value, &end)
+                                          : strtod (value, &end);
+                                }
+                                else if (code == 'T')
+                                {
+                                        state.tracking = (value[length - 1] == 'x')
+                                          ? state.tracking * strtod (value, &end)
+                                          : strtod (value, &end);
+                                }
+                                else
+                                {
+                                        state.oblique_angle = strtod (value, &end);
+                                }
+                                run = -1;
+                                break;
+                        case 'C':
+                                start = position;
+                                dxf_mtext_run_list_read_value (text, &position);
+                                state.color = (int) strtol (text + start, &end, 10);
+                                state.color_value = -1;
+                                run = -1;
+                                break;
+                        case 'c':
+                                start = position;
+                                dxf_mtext_run_list_read_value (text, &position);
+                                state.color_value = strtol (text + start, &end, 10) & 0xFFFFFF;
+                                run = -1;
+                                break;
+                        case 'A':
+                        case 'p':
+                                /* Alignment and paragraph properties do
+                                 * not change the runs. */
+                                dxf_mtext_run_list_read_value (text, &position);
+                                break;
+                        case 'S':
+                                /* Stack up to the first unescaped ';',
+                                 * split at the first unescaped '^', '/'
+                                 * or '#'. */
+                                start = position;
+                                separator = -1;
+                                while ((text[position] != '\0') && (text[position] != ';'))
+                                {
+                                        if ((text[position] == '\\') && (text[position + 1] != '\0'))
+                                        {
+                                                position += 2;
+                                                continue;
+                                        }
+                                        if ((separator < 0) && (strchr ("^/#", text[position]) != NULL))
+                                        {
+                                                separator = position;
+                                        }
+                                        position++;
+                                }
+                                length = position - start;
+                                if (text[position] == ';')
+                                {
+                                        position++;
+                                }
+                                if (separator < 0)
+                                {
+                                        if (run == -1)
+                                        {
+                                                status = dxf_mtext_run_list_put (list, &state, &run, "", 0);
+                                        }
+                                        j = list->text_length;
+                                        if (status == EXIT_SUCCESS)
+                                        {
+                                                status = dxf_mtext_run_list_append_unescaped (list, text + start, length);
+                                                list->runs[run].text_length += list->text_length - j;
+                                        }
+                                        break;
+                                }
+                                run = -1;
+                                status = dxf_mtext_run_list_add_run (list, &state, DXF_MTEXT_RUN_STACK);
+                                if (status == EXIT_SUCCESS)
+                                {
+                                        status = dxf_mtext_run_list_append_unescaped (list, text + start, separator - start);
+                                }
+                                if (status == EXIT_SUCCESS)
+                                {
+                                        status = dxf_mtext_run_list_append (list, text + separator, 1);
+                                }
+                                if (status == EXIT_SUCCESS)
+                                {
+                                        stacked = &list->runs[list->number_of_runs - 1];
+                                        stacked->stack_type = text[separator];
+                                        stacked->denominator_start = list->text_length;
+                                        status = dxf_mtext_run_list_append_unescaped (list, text + separator + 1, start + length - separator - 1);
+                                        stacked = &list->runs[list->number_of_runs - 1];
+                                        stacked->denominator_length = list->text_length - stacked->denominator_start;
+                                        stacked->text_length = list->text_length - stacked->text_start;
+                                }
+                                break;
+                        case 'U':
+                                if ((text[position] == '+')
+                                  && isxdigit ((unsigned char) text[position + 1])
+                                  && isxdigit ((unsigned char) text[position + 2])
+                                  && isxdigit ((unsigned char) text[position + 3])
+                                  && isxdigit ((unsigned char) text[position + 4]))
+                                {
+                                        char digits[5];
+
+                                        memcpy (digits, text + position + 1, 4);
+                                        digits[4] = '\0';
+                                        position += 5;
+                                        if (run == -1)
+                                        {
+                                                status = dxf_mtext_run_list_put (list, &state, &run, "", 0);
+                                        }
+                                        j = list->text_length;
+                                        if (status == EXIT_SUCCESS)
+                                        {
+                                                status = dxf_mtext_run_list_append_codepoint (list, (unsigned int) strtoul (digits, NULL, 16));
+                                                list->runs[run].text_length += list->text_length - j;
+                                        }
+                                        break;
+                                }
+                                /* Not a unicode character, keep it as an
+                                 * unknown code. */
+                                /* Fall through. */
+                        default:
+                                /* An unknown code is kept as text. */
+                                status = dxf_mtext_run_list_put (list, &state, &run, text + position - 2, 2);
+                                break;
+                }
+        }
+        free (stack);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (status);
+}
+
+
+/*!
+ * \brief Parse the text string of a DXF \c MTEXT entity into a
+ * \c DxfMtextRunList.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_mtext_run_list_parse_mtext
+(
+        DxfMtextRunList *list,
+                /*!< a pointer to the run list. */
+        DxfMtext *mtext
+                /*!< a pointer to a DXF \c MTEXT entity. */
+)
+{
+        /* Do some basic checks. */
+        if ((list == NULL) || (mtext == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        return (dxf_mtext_run_list_parse (list,
+          (mtext->text_value == NULL) ? "" : mtext->text_value,
+          mtext->height));
+}
+
+
+/*!
+ * \brief Get the font name of a run.
+ *
+ * \return the font name, or \c NULL when the run uses the font of the
+ * text style.
+ */
+const char *
+dxf_mtext_run_list_get_font_name
+(
+        DxfMtextRunList *list,
+                /*!< a pointer to the run list. */
+        DxfMtextRun *run
+                /*!< a pointer to a run in the list. */
+)
+{
+        /* Do some basic checks. */
+        if ((list == NULL) || (run == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        if (run->font < 0)
+        {
+                return (NULL);
+        }
+        return (list->font_names + run->font);
+}
+
+
+/*!
+ * \brief Clear the contents of a \c DxfMtextRunList, the list itself is
+ * not freed.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_mtext_run_list_clear
+(
+        DxfMtextRunList *list
+                /*!< a pointer to the run list. */
+)
+{
+        /* Do some basic checks. */
+        if (list == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        free (list->runs);
+        free (list->text);
+        free (list->font_names);
+        dxf_mtext_run_list_init (list);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Free the allocated memory for a \c DxfMtextRunList and all
+ * it's data fields.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_mtext_run_list_free
+(
+        DxfMtextRunList *list
+                /*!< a pointer to the run list. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (list == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_mtext_run_list_clear (list);
+        free (list);
+        list = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Allocate memory for a \c DxfMtextGlyphCache.
+ *
+ * Fill the memory contents with zeros.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfMtextGlyphCache *
+dxf_mtext_glyph_cache_new ()
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfMtextGlyphCache *cache = NULL;
+        size_t size;
+
+        size = sizeof (DxfMtextGlyphCache);
+        /* avoid malloc of 0 bytes */
+        if (size == 0) size = 1;
+        if ((cache = malloc (size)) == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                cache = NULL;
+        }
+        else
+        {
+                memset (cache, 0, size);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (cache);
+}
+
+
+/*!
+ * \brief Allocate memory and initialize data fields in a
+ * \c DxfMtextGlyphCache.
+ *
+ * Without an \c advance function the advance widths are estimated:
+ * 1.0 for wide (CJK) characters and 0.6 for other characters.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfMtextGlyphCache *
+dxf_mtext_glyph_cache_init
+(
+        DxfMtextGlyphCache *cache,
+                /*!< a pointer to the cache. */
+        DxfMtextAdvanceFunction advance,
+                /*!< function returning the advance widths, or \c NULL
+                 * for an estimate. */
+        void *data
+                /*!< data passed to \c advance. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (cache == NULL)
+        {
+                fprintf (stderr,
+                  (_("Warning in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                cache = dxf_mtext_glyph_cache_new ();
+        }
+        if (cache == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        cache->advance = advance;
+        cache->data = data;
+        cache->number_of_fonts = 0;
+        cache->max_number_of_fonts = 0;
+        cache->font_names = NULL;
+        cache->ascii_advance = NULL;
+        cache->number_of_glyphs = 0;
+        cache->number_of_slots = 0;
+        cache->glyph_key = NULL;
+        cache->glyph_advance = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (cache);
+}
+
+
+/*!
+ * \brief Get the advance width of a character from a
+ * \c DxfMtextGlyphCache.
+ *
+ * \return the advance width as a factor of the text height, or 0.0
+ * when an error occurred.
+ */
+double
+dxf_mtext_glyph_cache_get_advance
+(
+        DxfMtextGlyphCache *cache,
+                /*!< a pointer to the cache. */
+        const char *font,
+                /*!< the font name, \c NULL for the default font. */
+        unsigned int codepoint
+                /*!< the unicode codepoint of the character. */
+)
+{
+        int index;
+
+        /* Do some basic checks. */
+        if (cache == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (0.0);
+        }
+        index = dxf_mtext_glyph_cache_find_font (cache, (font == NULL) ? "" : font);
+        if (index < 0)
+        {
+                return (0.0);
+        }
+        return (dxf_mtext_glyph_cache_get_font_advance (cache, index, codepoint));
+}
+
+
+/*!
+ * \brief Clear the contents of a \c DxfMtextGlyphCache, the cache
+ * itself is not freed and keeps its advance function.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_mtext_glyph_cache_clear
+(
+        DxfMtextGlyphCache *cache
+                /*!< a pointer to the cache. */
+)
+{
+        int i;
+
+        /* Do some basic checks. */
+        if (cache == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        for (i = 0; i < cache->number_of_fonts; i++)
+        {
+                free (cache->font_names[i]);
+        }
+        free (cache->font_names);
+        free (cache->ascii_advance);
+        free (cache->glyph_key);
+        free (cache->glyph_advance);
+        dxf_mtext_glyph_cache_init (cache, cache->advance, cache->data);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Free the allocated memory for a \c DxfMtextGlyphCache and all
+ * it's data fields.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_mtext_glyph_cache_free
+(
+        DxfMtextGlyphCache *cache
+                /*!< a pointer to the cache. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (cache == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_mtext_glyph_cache_clear (cache);
+        free (cache);
+        cache = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Allocate memory for a \c DxfMtextLayout.
+ *
+ * Fill the memory contents with zeros.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfMtextLayout *
+dxf_mtext_layout_new ()
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfMtextLayout *layout = NULL;
+        size_t size;
+
+        size = sizeof (DxfMtextLayout);
+        /* avoid malloc of 0 bytes */
+        if (size == 0) size = 1;
+        if ((layout = malloc (size)) == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                layout = NULL;
+        }
+        else
+        {
+                memset (layout, 0, size);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (layout);
+}
+
+
+/*!
+ * \brief Allocate memory and initialize data fields in a
+ * \c DxfMtextLayout.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfMtextLayout *
+dxf_mtext_layout_init
+(
+        DxfMtextLayout *layout
+                /*!< a pointer to the layout. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (layout == NULL)
+        {
+                fprintf (stderr,
+                  (_("Warning in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                layout = dxf_mtext_layout_new ();
+        }
+        if (layout == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        layout->number_of_fragments = 0;
+        layout->max_number_of_fragments = 0;
+        layout->fragments = NULL;
+        layout->number_of_lines = 0;
+        layout->max_number_of_lines = 0;
+        layout->lines = NULL;
+        layout->width = 0.0;
+        layout->height = 0.0;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (layout);
+}
+
+
+/*!
+ * \brief Lay out the runs of a \c DxfMtextRunList in lines.
+ *
+ * Lines are broken at paragraph breaks, and at spaces before a word
+ * that would end beyond the width of the reference rectangle, a word
+ * wider than the rectangle gets a line of its own.\n
+ * A stack is not broken, its width is the width of the widest part at
+ * \c DXF_MTEXT_STACK_SCALE times the text height.\n
+ * The distance between baselines is \c DXF_MTEXT_LINE_SPACING times
+ * the spacing factor times the height of the highest run in the next
+ * line.\n
+ * Any previous contents of the layout are replaced, the memory is
+ * reused.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_mtext_layout_build
+(
+        DxfMtextLayout *layout,
+                /*!< a pointer to the layout. */
+        DxfMtextRunList *list,
+                /*!< a pointer to the parsed runs. */
+        DxfMtextGlyphCache *cache,
+                /*!< a pointer to the cache of advance widths. */
+        const char *style_font,
+                /*!< the font of the text style, used for runs without a
+                 * font of their own, \c NULL for the default font. */
+        double rectangle_width,
+                /*!< the width of the reference rectangle, 0.0 for no
+                 * line breaks but paragraph breaks. */
+        double spacing_factor
+                /*!< the line spacing factor, 0.0 is taken as 1.0. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfMtextRun *run = NULL;
+        DxfMtextLine *line = NULL;
+        DxfMtextFragment *fragment = NULL;
+        const char *text = NULL;
+        double x;
+        double word_width;
+        double space_width;
+        int style_font_index;
+        int font;
+        int line_index;
+        int word_start;
+        int word_end;
+        int next;
+        int end;
+        int status;
+        int i;
+        int j;
+
+        /* Do some basic checks. */
+        if ((layout == NULL) || (list == NULL) || (cache == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (spacing_factor <= 0.0)
+        {
+                spacing_factor = 1.0;
+        }
+        layout->number_of_fragments = 0;
+        layout->number_of_lines = 0;
+        layout->width = 0.0;
+        layout->height = 0.0;
+        style_font_index = dxf_mtext_glyph_cache_find_font (cache, (style_font == NULL) ? "" : style_font);
+        if (style_font_index < 0)
+        {
+                return (EXIT_FAILURE);
+        }
+        text = list->text;
+        line_index = dxf_mtext_layout_add_line (layout,
+          (list->number_of_runs > 0) ? list->runs[0].height : 0.0);
+        status = (line_index < 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+        x = 0.0;
+        for (i = 0; (status == EXIT_SUCCESS) && (i < list->number_of_runs); i++)
+        {
+                run = &list->runs[i];
+                if (run->type == DXF_MTEXT_RUN_PARAGRAPH)
+                {
+                        line_index = dxf_mtext_layout_add_line (layout, run->height);
+                        status = (line_index < 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+                        x = 0.0;
+                        continue;
+                }
+                font = (run->font < 0)
+                  ? style_font_index
+                  : dxf_mtext_glyph_cache_find_font (cache, list->font_names + run->font);
+                if (font < 0)
+                {
+                        status = EXIT_FAILURE;
+                        break;
+                }
+                if (run->type == DXF_MTEXT_RUN_STACK)
+                {
+                        word_width = dxf_mtext_layout_get_width (cache, font, run,
+                          text + run->text_start,
+                          run->denominator_start - run->text_start - 1);
+                        space_width = dxf_mtext_layout_get_width (cache, font, run,
+                          text + run->denominator_start, run->denominator_length);
+                        if (space_width > word_width)
+                        {
+                                word_width = space_width;
+                        }
+                        word_width *= DXF_MTEXT_STACK_SCALE;
+                        line = &layout->lines[line_index];
+                        if ((rectangle_width > 0.0)
+                          && (line->number_of_fragments > 0)
+                          && (x + word_width > rectangle_width))
+                        {
+                                line_index = dxf_mtext_layout_add_line (layout, run->height);
+                                if (line_index < 0)
+                                {
+                                        status = EXIT_FAILURE;
+                                        break;
+                                }
+                                x = 0.0;
+                        }
+                        if (dxf_mtext_layout_add_fragment (layout, i, run->text_start, run->text_length, x) < 0)
+                        {
+                                status = EXIT_FAILURE;
+                                break;
+                        }
+                        layout->fragments[layout->number_of_fragments - 1].width = word_width;
+                        x += word_width;
+                        line = &layout->lines[line_index];
+                        line->width = x;
+                        if (run->height > line->height)
+                        {
+                                line->height = run->height;
+                        }
+                        continue;
+                }
+                /* A text run, word by word, every word followed by its
+                 * spaces. */
+                end = run->text_start + run->text_length;
+                next = run->text_start;
+                while (next < end)
+                {
+                        word_start = next;
+                        word_end = word_start;
+                        while ((word_end < end) && (text[word_end] != ' '))
+                        {
+                                word_end++;
+                        }
+                        next = word_end;
+                        while ((next < end) && (text[next] == ' '))
+                        {
+                                next++;
+                        }
+                        word_width = dxf_mtext_layout_get_width (cache, font, run,
+                          text + word_start, word_end - word_start);
+                        space_width = dxf_mtext_layout_get_width (cache, font, run,
+                          text + word_end, next - word_end);
+                        line = &layout->lines[line_index];
+                        if ((rectangle_width > 0.0)
+                          && (word_end > word_start)
+                          && (line->number_of_fragments > 0)
+                          && (x + word_width > rectangle_width))
+                        {
+                                line_index = dxf_mtext_layout_add_line (layout, run->height);
+                                if (line_index < 0)
+                                {
+                                        status = EXIT_FAILURE;
+                                        break;
+                                }
+                                x = 0.0;
+                                line = &layout->lines[line_index];
+                        }
+                        fragment = (line->number_of_fragments > 0)
+                          ? &layout->fragments[layout->number_of_fragments - 1]
+                          : NULL;
+                        if ((fragment == NULL)
+                          || (fragment->run != i)
+                          || (fragment->text_start + fragment->text_length != word_start))
+                        {
+                                if (dxf_mtext_layout_add_fragment (layout, i, word_start, 0, x) < 0)
+                                {
+                                        status = EXIT_FAILURE;
+                                        break;
+                                }
+                                fragment = &layout->fragments[layout->number_of_fragments - 1];
+                                line = &layout->lines[line_index];
+                        }
+                        fragment->text_length = next - fragment->text_start;
+                        if (word_end > word_start)
+                        {
+                                line->width = x + word_width;
+                        }
+                        x += word_width + space_width;
+                        fragment->width = x - fragment->x;
+                        if (run->height > line->height)
+                        {
+                                line->height = run->height;
+                        }
+                }
+        }
+        if (status != EXIT_SUCCESS)
+        {
+                return (EXIT_FAILURE);
+        }
+        /* Place the baselines. */
+        for (i = 0; i < layout->number_of_lines; i++)
+        {
+                line = &layout->lines[i];
+                line->y = (i == 0)
+                  ? -line->height
+                  : layout->lines[i - 1].y - (spacing_factor * DXF_MTEXT_LINE_SPACING * line->height);
+                for (j = 0; j < line->number_of_fragments; j++)
+                {
+                        layout->fragments[line->first_fragment + j].y = line->y;
+                }
+                if (line->width > layout->width)
+                {
+                        layout->width = line->width;
+                }
+        }
+        layout->height = -layout->lines[layout->number_of_lines - 1].y;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Clear the contents of a \c DxfMtextLayout, the layout itself
+ * is not freed.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_mtext_layout_clear
+(
+        DxfMtextLayout *layout
+                /*!< a pointer to the layout. */
+)
+{
+        /* Do some basic checks. */
+        if (layout == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        free (layout->fragments);
+        free (layout->lines);
+        dxf_mtext_layout_init (layout);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Free the allocated memory for a \c DxfMtextLayout and all
+ * it's data fields.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_mtext_layout_free
+(
+        DxfMtextLayout *layout
+                /*!< a pointer to the layout. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (layout == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_mtext_layout_clear (layout);
+        free (layout);
+        layout = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Add a run with the current format to a \c DxfMtextRunList,
+ * starting at the end of the plain text.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_mtext_run_list_add_run
+(
+        DxfMtextRunList *list,
+                /*!< a pointer to the run list. */
+        DxfMtextRunState *state,
+                /*!< the current format. */
+        int type
+                /*!< the type of the run. */
+)
+{
+        DxfMtextRun *runs = NULL;
+        DxfMtextRun *run = NULL;
+        int max_number_of_runs;
+
+        if (list->number_of_runs == list->max_number_of_runs)
+        {
+                max_number_of_runs = (list->max_number_of_runs == 0) ? 16 : 2 * list->max_number_of_runs;
+                runs = realloc (list->runs, max_number_of_runs * sizeof (DxfMtextRun));
+                if (runs == NULL)
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () could not allocate memory.\n")),
+                          __FUNCTION__);
+                        return (EXIT_FAILURE);
+                }
+                list->runs = runs;
+                list->max_number_of_runs = max_number_of_runs;
+        }
+        run = &list->runs[list->number_of_runs];
+        run->type = type;
+        run->text_start = list->text_length;
+        run->text_length = 0;
+        run->denominator_start = 0;
+        run->denominator_length = 0;
+        run->stack_type = '\0';
+        run->font = state->font;
+        run->flags = state->flags;
+        run->height = state->height;
+        run->width_factor = state->width_factor;
+        run->oblique_angle = state->oblique_angle;
+        run->tracking = state->tracking;
+        run->color = state->color;
+        run->color_value = state->color_value;
+        list->number_of_runs++;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Append bytes to the plain text of a \c DxfMtextRunList, the
+ * plain text stays terminated.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_mtext_run_list_append
+(
+        DxfMtextRunList *list,
+                /*!< a pointer to the run list. */
+        const char *bytes,
+                /*!< the bytes to append. */
+        int length
+                /*!< the number of bytes. */
+)
+{
+        char *text = NULL;
+        int max_text_length;
+
+        if (list->text_length + length + 1 > list->max_text_length)
+        {
+                max_text_length = (list->max_text_length == 0) ? 256 : list->max_text_length;
+                while (list->text_length + length + 1 > max_text_length)
+                {
+                        max_text_length *= 2;
+                }
+                text = realloc (list->text, max_text_length);
+                if (text == NULL)
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () could not allocate memory.\n")),
+                          __FUNCTION__);
+                        return (EXIT_FAILURE);
+                }
+                list->text = text;
+                list->max_text_length = max_text_length;
+        }
+        memcpy (list->text + list->text_length, bytes, length);
+        list->text_length += length;
+        list->text[list->text_length] = '\0';
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Append bytes to the plain text of a \c DxfMtextRunList,
+ * dropping the backslash of escaped characters.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_mtext_run_list_append_unescaped
+(
+        DxfMtextRunList *list,
+                /*!< a pointer to the run list. */
+        const char *bytes,
+                /*!< the bytes to append. */
+        int length
+                /*!< the number of bytes. */
+)
+{
+        int i;
+
+        for (i = 0; i < length; i++)
+        {
+                if ((bytes[i] == '\\') && (i + 1 < length))
+                {
+                        i++;
+                }
+                if (dxf_mtext_run_list_append (list, bytes + i, 1) != EXIT_SUCCESS)
+                {
+                        return (EXIT_FAILURE);
+                }
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Append a character, encoded in UTF-8, to the plain text of a
+ * \c DxfMtextRunList.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_mtext_run_list_append_codepoint
+(
+        DxfMtextRunList *list,
+                /*!< a pointer to the run list. */
+        unsigned int codepoint
+                /*!< the unicode codepoint of the character. */
+)
+{
+        char bytes[4];
+        int length;
+
+        if (codepoint < 0x80)
+        {
+                bytes[0] = (char) codepoint;
+                length = 1;
+        }
+        else if (codepoint < 0x800)
+        {
+                bytes[0] = (char) (0xC0 | (codepoint >> 6));
+                bytes[1] = (char) (0x80 | (codepoint & 0x3F));
+                length = 2;
+        }
+        else
+        {
+                bytes[0] = (char) (0xE0 | (codepoint >> 12));
+                bytes[1] = (char) (0x80 | ((codepoint >> 6) & 0x3F));
+                bytes[2] = (char) (0x80 | (codepoint & 0x3F));
+                length = 3;
+        }
+        return (dxf_mtext_run_list_append (list, bytes, length));
+}
+
+
+/*!
+ * \brief Append text with the current format, opening a new text run
+ * when no text run is open.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_mtext_run_list_put
+(
+        DxfMtextRunList *list,
+                /*!< a pointer to the run list. */
+        DxfMtextRunState *state,
+                /*!< the current format. */
+        int *run,
+                /*!< index of the open text run, -1 when no text run is
+                 * open. */
+        const char *bytes,
+                /*!< the bytes to append. */
+        int length
+                /*!< the number of bytes. */
+)
+{
+        if (*run == -1)
+        {
+                if (dxf_mtext_run_list_add_run (list, state, DXF_MTEXT_RUN_TEXT) != EXIT_SUCCESS)
+                {
+                        return (EXIT_FAILURE);
+                }
+                *run = list->number_of_runs - 1;
+        }
+        if (dxf_mtext_run_list_append (list, bytes, length) != EXIT_SUCCESS)
+        {
+                return (EXIT_FAILURE);
+        }
+        list->runs[*run].text_length += length;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Add a font name to a \c DxfMtextRunList, unless it was added
+ * before.
+ *
+ * \return the index of the font name, or -1 when an error occurred.
+ */
+static int
+dxf_mtext_run_list_add_font
+(
+        DxfMtextRunList *list,
+                /*!< a pointer to the run list. */
+        const char *name,
+                /*!< the font name, not necessarily terminated. */
+        int length
+                /*!< the length of the font name. */
+)
+{
+        char *font_names = NULL;
+        int max_font_names_length;
+        int index;
+
+        index = 0;
+        while (index < list->font_names_length)
+        {
+                if ((strncasecmp (list->font_names + index, name, length) == 0)
+                  && (list->font_names[index + length] == '\0'))
+                {
+                        return (index);
+                }
+                index += strlen (list->font_names + index) + 1;
+        }
+        if (list->font_names_length + length + 1 > list->max_font_names_length)
+        {
+                max_font_names_length = (list->max_font_names_length == 0) ? 64 : list->max_font_names_length;
+                while (list->font_names_length + length + 1 > max_font_names_length)
+                {
+                        max_font_names_length *= 2;
+                }
+                font_names = realloc (list->font_names, max_font_names_length);
+                if (font_names == NULL)
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () could not allocate memory.\n")),
+                          __FUNCTION__);
+                        return (-1);
+                }
+                list->font_names = font_names;
+                list->max_font_names_length = max_font_names_length;
+        }
+        index = list->font_names_length;
+        memcpy (list->font_names + index, name, length);
+        list->font_names[index + length] = '\0';
+        list->font_names_length += length + 1;
+        return (index);
+}
+
+
+/*!
+ * \brief Skip the value of a formatting code, up to and including the
+ * terminating ';'.
+ *
+ * \return the length of the value, without the ';'.
+ */
+static int
+dxf_mtext_run_list_read_value
+(
+        const char *text,
+                /*!< the text string. */
+        int *position
+                /*!< the position of the value, set to the position
+                 * after the value. */
+)
+{
+        int start;
+
+        start = *position;
+        while ((text[*position] != '\0') && (text[*position] != ';'))
+        {
+                (*position)++;
+        }
+        if (text[*position] == ';')
+        {
+                (*position)++;
+                return (*position - start - 1);
+        }
+        return (*position - start);
+}
+
+
+/*!
+ * \brief Decode the UTF-8 character at a position, an invalid byte is
+ * taken as a character of its own.
+ *
+ * \return the unicode codepoint of the character.
+ */
+static unsigned int
+dxf_mtext_decode
+(
+        const char *text,
+                /*!< the text. */
+        int *position
+                /*!< the position of the character, set to the position
+                 * of the next character. */
+)
+{
+        const unsigned char *bytes = (const unsigned char *) text + *position;
+        unsigned int codepoint;
+        int length;
+        int i;
+
+        if (bytes[0] < 0x80)
+        {
+                (*position)++;
+                return (bytes[0]);
+        }
+        if ((bytes[0] & 0xE0) == 0xC0)
+        {
+                codepoint = bytes[0] & 0x1F;
+                length = 2;
+        }
+        else if ((bytes[0] & 0xF0) == 0xE0)
+        {
+                codepoint = bytes[0] & 0x0F;
+                length = 3;
+        }
+        else if ((bytes[0] & 0xF8) == 0xF0)
+        {
+                codepoint = bytes[0] & 0x07;
+                length = 4;
+        }
+        else
+        {
+                (*position)++;
+                return (bytes[0]);
+        }
+        for (i = 1; i < length; i++)
+        {
+                if ((bytes[i] & 0xC0) != 0x80)
+                {
+                        (*position)++;
+                        return (bytes[0]);
+                }
+                codepoint = (codepoint << 6) | (bytes[i] & 0x3F);
+        }
+        *position += length;
+        return (codepoint);
+}
+
+
+/*!
+ * \brief Find a font in a \c DxfMtextGlyphCache, adding it when not
+ * found.
+ *
+ * \return the index of the font, or -1 when an error occurred.
+ */
+static int
+dxf_mtext_glyph_cache_find_font
+(
+        DxfMtextGlyphCache *cache,
+                /*!< a pointer to the cache. */
+        const char *font
+                /*!< the font name. */
+)
+{
+        char **font_names = NULL;
+        double *ascii_advance = NULL;
+        int max_number_of_fonts;
+        int i;
+
+        for (i = 0; i < cache->number_of_fonts; i++)
+        {
+                if (strcasecmp (cache->font_names[i], font) == 0)
+                {
+                        return (i);
+                }
+        }
+        if (cache->number_of_fonts == cache->max_number_of_fonts)
+        {
+                max_number_of_fonts = (cache->max_number_of_fonts == 0) ? 4 : 2 * cache->max_number_of_fonts;
+                font_names = realloc (cache->font_names, max_number_of_fonts * sizeof (char *));
+                if (font_names == NULL)
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () could not allocate memory.\n")),
+                          __FUNCTION__);
+                        return (-1);
+                }
+                cache->font_names = font_names;
+                ascii_advance = realloc (cache->ascii_advance, max_number_of_fonts * 128 * sizeof (double));
+                if (ascii_advance == NULL)
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () could not allocate memory.\n")),
+                          __FUNCTION__);
+                        return (-1);
+                }
+                cache->ascii_advance = ascii_advance;
+                cache->max_number_of_fonts = max_number_of_fonts;
+        }
+        cache->font_names[cache->number_of_fonts] = strdup (font);
+        if (cache->font_names[cache->number_of_fonts] == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (-1);
+        }
+        for (i = 0; i < 128; i++)
+        {
+                cache->ascii_advance[(cache->number_of_fonts * 128) + i] = -1.0;
+        }
+        cache->number_of_fonts++;
+        return (cache->number_of_fonts - 1);
+}
+
+
+/*!
+ * \brief Get the advance width of a character in a font of a
+ * \c DxfMtextGlyphCache, determining it when not yet cached.
+ *
+ * \return the advance width as a factor of the text height.
+ */
+static double
+dxf_mtext_glyph_cache_get_font_advance
+(
+        DxfMtextGlyphCache *cache,
+                /*!< a pointer to the cache. */
+        int font,
+                /*!< the index of the font. */
+        unsigned int codepoint
+                /*!< the unicode codepoint of the character. */
+)
+{
+        unsigned long long *glyph_key = NULL;
+        unsigned long long key;
+        double *glyph_advance = NULL;
+        double advance;
+        unsigned int slot;
+        int number_of_slots;
+        int i;
+
+        if (codepoint < 128)
+        {
+                advance = cache->ascii_advance[(font * 128) + codepoint];
+                if (advance < 0.0)
+                {
+                        advance = (cache->advance == NULL)
+                          ? dxf_mtext_glyph_cache_estimate (codepoint)
+                          : cache->advance (cache->font_names[font], codepoint, cache->data);
+                        cache->ascii_advance[(font * 128) + codepoint] = advance;
+                }
+                return (advance);
+        }
+        key = (((unsigned long long) (font + 1)) << 32) | codepoint;
+        if (cache->number_of_slots > 0)
+        {
+                slot = ((unsigned int) (key ^ (key >> 32)) * 2654435761u) & (cache->number_of_slots - 1);
+                while (cache->glyph_key[slot] != 0)
+                {
+                        if (cache->glyph_key[slot] == key)
+                        {
+                                return (cache->glyph_advance[slot]);
+                        }
+                        slot = (slot + 1) & (cache->number_of_slots - 1);
+                }
+        }
+        advance = (cache->advance == NULL)
+          ? dxf_mtext_glyph_cache_estimate (codepoint)
+          : cache->advance (cache->font_names[font], codepoint, cache->data);
+        /* Grow the hash table for a load factor of at most 0.5. */
+        if (2 * (cache->number_of_glyphs + 1) > cache->number_of_slots)
+        {
+                number_of_slots = (cache->number_of_slots == 0) ? 64 : 2 * cache->number_of_slots;
+                glyph_key = calloc (number_of_slots, sizeof (unsigned long long));
+                glyph_advance = malloc (number_of_slots * sizeof (double));
+                if ((glyph_key == NULL) || (glyph_advance == NULL))
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () could not allocate memory.\n")),
+                          __FUNCTION__);
+                        free (glyph_key);
+                        free (glyph_advance);
+                        /* Not cached, but still a valid answer. */
+                        return (advance);
+                }
+                for (i = 0; i < cache->number_of_slots; i++)
+                {
+                        if (cache->glyph_key[i] == 0)
+                        {
+                                continue;
+                        }
+                        slot = ((unsigned int) (cache->glyph_key[i] ^ (cache->glyph_key[i] >> 32)) * 2654435761u) & (number_of_slots - 1);
+                        while (glyph_key[slot] != 0)
+                        {
+                                slot = (slot + 1) & (number_of_slots - 1);
+                        }
+                        glyph_key[slot] = cache->glyph_key[i];
+                        glyph_advance[slot] = cache->glyph_advance[i];
+                }
+                free (cache->glyph_key);
+                free (cache->glyph_advance);
+                cache->glyph_key = glyph_key;
+                cache->glyph_advance = glyph_advance;
+                cache->number_of_slots = number_of_slots;
+        }
+        slot = ((unsigned int) (key ^ (key >> 32)) * 2654435761u) & (cache->number_of_slots - 1);
+        while (cache->glyph_key[slot] != 0)
+        {
+                slot = (slot + 1) & (cache->number_of_slots - 1);
+        }
+        cache->glyph_key[slot] = key;
+        cache->glyph_advance[slot] = advance;
+        cache->number_of_glyphs++;
+        return (advance);
+}
+
+
+/*!
+ * \brief Estimate the advance width of a character without font
+ * metrics.
+ *
+ * \return the advance width as a factor of the text height.
+ */
+static double
+dxf_mtext_glyph_cache_estimate
+(
+        unsigned int codepoint
+                /*!< the unicode codepoint of the character. */
+)
+{
+        /* CJK, Hangul and fullwidth forms are as wide as high. */
+        if (((codepoint >= 0x1100) && (codepoint <= 0x115F))
+          || ((codepoint >= 0x2E80) && (codepoint <= 0xD7A3))
+          || ((codepoint >= 0xF900) && (codepoint <= 0xFAFF))
+          || ((codepoint >= 0xFF00) && (codepoint <= 0xFF60)))
+        {
+                return (1.0);
+        }
+        return (0.6);
+}
+
+
+/*!
+ * \brief Get the width of a piece of the plain text in the format of a
+ * run.
+ *
+ * \return the width.
+ */
+static double
+dxf_mtext_layout_get_width
+(
+        DxfMtextGlyphCache *cache,
+                /*!< a pointer to the cache. */
+        int font,
+                /*!< the index of the font in the cache. */
+        DxfMtextRun *run,
+                /*!< the run holding the text. */
+        const char *text,
+                /*!< the text. */
+        int length
+                /*!< the number of bytes of the text. */
+)
+{
+        double width;
+        int position;
+
+        width = 0.0;
+        position = 0;
+        while (position < length)
+        {
+                width += dxf_mtext_glyph_cache_get_font_advance (cache, font,
+                  dxf_mtext_decode (text, &position));
+        }
+        return (width * run->height * run->width_factor * run->tracking);
+}
+
+
+/*!
+ * \brief Start a new line in a \c DxfMtextLayout.
+ *
+ * \return the index of the line, or -1 when an error occurred.
+ */
+static int
+dxf_mtext_layout_add_line
+(
+        DxfMtextLayout *layout,
+                /*!< a pointer to the layout. */
+        double height
+                /*!< the height of the line while it is empty. */
+)
+{
+        DxfMtextLine *lines = NULL;
+        DxfMtextLine *line = NULL;
+        int max_number_of_lines;
+
+        if (layout->number_of_lines == layout->max_number_of_lines)
+        {
+                max_number_of_lines = (layout->max_number_of_lines == 0) ? 8 : 2 * layout->max_number_of_lines;
+                lines = realloc (layout->lines, max_number_of_lines * sizeof (DxfMtextLine));
+                if (lines == NULL)
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () could not allocate memory.\n")),
+                          __FUNCTION__);
+                        return (-1);
+                }
+                layout->lines = lines;
+                layout->max_number_of_lines = max_number_of_lines;
+        }
+        line = &layout->lines[layout->number_of_lines];
+        line->first_fragment = layout->number_of_fragments;
+        line->number_of_fragments = 0;
+        line->width = 0.0;
+        line->height = height;
+        line->y = 0.0;
+        layout->number_of_lines++;
+        return (layout->number_of_lines - 1);
+}
+
+
+/*!
+ * \brief Add a fragment to the last line of a \c DxfMtextLayout.
+ *
+ * \return the index of the fragment, or -1 when an error occurred.
+ */
+static int
+dxf_mtext_layout_add_fragment
+(
+        DxfMtextLayout *layout,
+                /*!< a pointer to the layout. */
+        int run,
+                /*!< the index of the run. */
+        int text_start,
+                /*!< index of the first byte in the plain text. */
+        int text_length,
+                /*!< number of bytes in the plain text. */
+        double x
+                /*!< X-coordinate of the start of the fragment. */
+)
+{
+        DxfMtextFragment *fragments = NULL;
+        DxfMtextFragment *fragment = NULL;
+        int max_number_of_fragments;
+
+        if (layout->number_of_fragments == layout->max_number_of_fragments)
+        {
+                max_number_of_fragments = (layout->max_number_of_fragments == 0) ? 16 : 2 * layout->max_number_of_fragments;
+                fragments = realloc (layout->fragments, max_number_of_fragments * sizeof (DxfMtextFragment));
+                if (fragments == NULL)
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () could not allocate memory.\n")),
+                          __FUNCTION__);
+                        return (-1);
+                }
+                layout->fragments = fragments;
+                layout->max_number_of_fragments = max_number_of_fragments;
+        }
+        fragment = &layout->fragments[layout->number_of_fragments];
+        fragment->run = run;
+        fragment->text_start = text_start;
+        fragment->text_length = text_length;
+        fragment->x = x;
+        fragment->y = 0.0;
+        fragment->width = 0.0;
+        layout->lines[layout->number_of_lines - 1].number_of_fragments++;
+        layout->number_of_fragments++;
+        return (layout->number_of_fragments - 1);
+}
+
+
+/* EOF */
@@ -0,0 +1,297 @@
+/*!
+ * \file mtext_layout.h
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Header file for parsing the inline formatting codes of DXF
+ * \c MTEXT entities and laying out the resulting runs.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#ifndef LIBDXF_SRC_MTEXT_LAYOUT_H
+#define LIBDXF_SRC_MTEXT_LAYOUT_H
+
+
+#include "global.h"
+#include "mtext.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define DXF_MTEXT_RUN_TEXT 0
+        /*!< \brief A run of text with a single format. */
+
+#define DXF_MTEXT_RUN_PARAGRAPH 1
+        /*!< \brief A paragraph (\\P) or column (\\N) break. */
+
+#define DXF_MTEXT_RUN_STACK 2
+        /*!< \brief A stacked fraction or tolerance (\\S). */
+
+#define DXF_MTEXT_RUN_UNDERLINE 1
+        /*!< \brief Flag for underlined text (\\L). */
+
+#define DXF_MTEXT_RUN_OVERLINE 2
+        /*!< \brief Flag for overlined text (\\O). */
+
+#define DXF_MTEXT_RUN_STRIKETHROUGH 4
+        /*!< \brief Flag for struck through text (\\K). */
+
+#define DXF_MTEXT_RUN_BOLD 8
+        /*!< \brief Flag for bold text (\\f...|b1). */
+
+#define DXF_MTEXT_RUN_ITALIC 16
+        /*!< \brief Flag for italic text (\\f...|i1). */
+
+#define DXF_MTEXT_LINE_SPACING 1.666666666666667
+        /*!< \brief Distance between the baselines of two lines, as a
+         * factor of the text height, for a spacing factor of 1.0. */
+
+#define DXF_MTEXT_STACK_SCALE 0.7
+        /*!< \brief Height of the parts of a stack as a factor of the
+         * text height. */
+
+
+/*!
+ * \brief Function returning the advance width of a character, as a
+ * factor of the text height (for a width factor of 1.0).
+ */
+typedef double (*DxfMtextAdvanceFunction) (const char *font, unsigned int codepoint, void *data);
+
+
+/*!
+ * \brief Definition of a single run of an \c MTEXT text string.
+ */
+typedef struct
+dxf_mtext_run_struct
+{
+        int type;
+                /*!< \c DXF_MTEXT_RUN_TEXT, \c DXF_MTEXT_RUN_PARAGRAPH
+                 * or \c DXF_MTEXT_RUN_STACK. */
+        int text_start;
+                /*!< Index of the first byte of the run in the plain
+                 * text. */
+        int text_length;
+                /*!< Number of bytes of the run in the plain text. */
+        int denominator_start;
+                /*!< Index of the first byte of the lower part of a
+                 * stack in the plain text. */
+        int denominator_length;
+                /*!< Number of bytes of the lower part of a stack. */
+        char stack_type;
+                /*!< Separator of a stack, '/' (horizontal fraction),
+                 * '#' (diagonal fraction) or '^' (tolerance). */
+        int font;
+                /*!< Index of the font name in the font names, or -1 for
+                 * the text style font. */
+        int flags;
+                /*!< Bitwise or of the \c DXF_MTEXT_RUN_UNDERLINE ...
+                 * \c DXF_MTEXT_RUN_ITALIC flags. */
+        double height;
+                /*!< Text height. */
+        double width_factor;
+                /*!< Width factor. */
+        double oblique_angle;
+                /*!< Obliquing angle in degrees. */
+        double tracking;
+                /*!< Tracking factor (character spacing). */
+        int color;
+                /*!< ACI color number, 256 for BYLAYER. */
+        long color_value;
+                /*!< True color value, or -1 when not set. */
+} DxfMtextRun;
+
+
+/*!
+ * \brief Definition of the runs of a parsed \c MTEXT text string.
+ *
+ * The plain text holds the text without formatting codes (in UTF-8),
+ * with a new line for every paragraph break and the upper and lower
+ * part of a stack separated by the stack separator, so it can be
+ * searched without parsing again.
+ */
+typedef struct
+dxf_mtext_run_list_struct
+{
+        int number_of_runs;
+                /*!< Number of runs. */
+        int max_number_of_runs;
+                /*!< Number of runs that fit in \c runs. */
+        DxfMtextRun *runs;
+                /*!< The runs, in text order. */
+        int text_length;
+                /*!< Number of bytes of the plain text. */
+        int max_text_length;
+                /*!< Number of bytes that fit in \c text. */
+        char *text;
+                /*!< The plain text, terminated with a '\\0'. */
+        int font_names_length;
+                /*!< Number of bytes of the font names. */
+        int max_font_names_length;
+                /*!< Number of bytes that fit in \c font_names. */
+        char *font_names;
+                /*!< The font names of the runs, each one terminated
+                 * with a '\\0'. */
+} DxfMtextRunList;
+
+
+/*!
+ * \brief Definition of a cache of character advance widths per font.
+ *
+ * Advance widths of ASCII characters are held in a table per font,
+ * other characters in an open addressing hash table.\n
+ * A cache is not safe to be shared between threads.
+ */
+typedef struct
+dxf_mtext_glyph_cache_struct
+{
+        DxfMtextAdvanceFunction advance;
+                /*!< Function returning the advance widths, or \c NULL
+                 * for an estimate. */
+        void *data;
+                /*!< Data passed to \c advance. */
+        int number_of_fonts;
+                /*!< Number of fonts. */
+        int max_number_of_fonts;
+                /*!< Number of fonts that fit in the font arrays. */
+        char **font_names;
+                /*!< Name of each font. */
+        double *ascii_advance;
+                /*!< 128 advance widths for each font, negative when not
+                 * yet known. */
+        int number_of_glyphs;
+                /*!< Number of non ASCII characters cached. */
+        int number_of_slots;
+                /*!< Number of hash slots, a power of 2. */
+        unsigned long long *glyph_key;
+                /*!< Font index plus one (high 32 bits) and codepoint
+                 * (low 32 bits) of each slot, 0 for an empty slot. */
+        double *glyph_advance;
+                /*!< Advance width of each slot. */
+} DxfMtextGlyphCache;
+
+
+/*!
+ * \brief Definition of a placed part of a run.
+ */
+typedef struct
+dxf_mtext_fragment_struct
+{
+        int run;
+                /*!< Index of the run. */
+        int text_start;
+                /*!< Index of the first byte in the plain text. */
+        int text_length;
+                /*!< Number of bytes in the plain text. */
+        double x;
+                /*!< X-coordinate of the start, relative to the left of
+                 * the text. */
+        double y;
+                /*!< Y-coordinate of the baseline, relative to the top
+                 * of the text. */
+        double width;
+                /*!< Width of the fragment. */
+} DxfMtextFragment;
+
+
+/*!
+ * \brief Definition of a single line of laid out text.
+ */
+typedef struct
+dxf_mtext_line_struct
+{
+        int first_fragment;
+                /*!< Index of the first fragment of the line. */
+        int number_of_fragments;
+                /*!< Number of fragments of the line. */
+        double width;
+                /*!< Width of the line, without trailing spaces. */
+        double height;
+                /*!< Height of the highest run in the line. */
+        double y;
+                /*!< Y-coordinate of the baseline, relative to the top
+                 * of the text. */
+} DxfMtextLine;
+
+
+/*!
+ * \brief Definition of the layout of an \c MTEXT text string.
+ */
+typedef struct
+dxf_mtext_layout_struct
+{
+        int number_of_fragments;
+                /*!< Number of fragments. */
+        int max_number_of_fragments;
+                /*!< Number of fragments that fit in \c fragments. */
+        DxfMtextFragment *fragments;
+                /*!< The fragments, line by line. */
+        int number_of_lines;
+                /*!< Number of lines. */
+        int max_number_of_lines;
+                /*!< Number of lines that fit in \c lines. */
+        DxfMtextLine *lines;
+                /*!< The lines, from top to bottom. */
+        double width;
+                /*!< Width of the widest line. */
+        double height;
+                /*!< Distance from the top to the baseline of the last
+                 * line. */
+} DxfMtextLayout;
+
+
+DxfMtextRunList *dxf_mtext_run_list_new ();
+DxfMtextRunList *dxf_mtext_run_list_init (DxfMtextRunList *list);
+int dxf_mtext_run_list_parse (DxfMtextRunList *list, const char *text, double height);
+int dxf_mtext_run_list_parse_mtext (DxfMtextRunList *list, DxfMtext *mtext);
+const char *dxf_mtext_run_list_get_font_name (DxfMtextRunList *list, DxfMtextRun *run);
+int dxf_mtext_run_list_clear (DxfMtextRunList *list);
+int dxf_mtext_run_list_free (DxfMtextRunList *list);
+DxfMtextGlyphCache *dxf_mtext_glyph_cache_new ();
+DxfMtextGlyphCache *dxf_mtext_glyph_cache_init (DxfMtextGlyphCache *cache, DxfMtextAdvanceFunction advance, void *data);
+double dxf_mtext_glyph_cache_get_advance (DxfMtextGlyphCache *cache, const char *font, unsigned int codepoint);
+int dxf_mtext_glyph_cache_clear (DxfMtextGlyphCache *cache);
+int dxf_mtext_glyph_cache_free (DxfMtextGlyphCache *cache);
+DxfMtextLayout *dxf_mtext_layout_new ();
+DxfMtextLayout *dxf_mtext_layout_init (DxfMtextLayout *layout);
+int dxf_mtext_layout_build (DxfMtextLayout *layout, DxfMtextRunList *list, DxfMtextGlyphCache *cache, const char *style_font, double rectangle_width, double spacing_factor);
+int dxf_mtext_layout_clear (DxfMtextLayout *layout);
+int dxf_mtext_layout_free (DxfMtextLayout *layout);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* LIBDXF_SRC_MTEXT_LAYOUT_H */
+
+
+/* EOF */
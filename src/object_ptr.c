@@ -42,6 +42,7 @@
 
 
 #include "object_ptr.h"
+#include "util.h"
 
 
 /*!
@@ -112,8 +113,8 @@ dxf_object_ptr_init
                 return (NULL);
         }
         object_ptr->id_code = 0;
-        object_ptr->dictionary_owner_soft = strdup ("");
-        object_ptr->dictionary_owner_hard = strdup ("");
+        object_ptr->dictionary_owner_soft = dxf_string_share ("");
+        object_ptr->dictionary_owner_hard = dxf_string_share ("");
         object_ptr->xdata->value = NULL;
         object_ptr->xdata->length = 0;
         object_ptr->xdata->next = NULL;
@@ -199,15 +200,13 @@ dxf_object_ptr_read
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", object_ptr->dictionary_owner_soft);
+                        dxf_read_string (fp, &object_ptr->dictionary_owner_soft);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", object_ptr->dictionary_owner_hard);
+                        dxf_read_string (fp, &object_ptr->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "999") == 0)
                 {
@@ -365,8 +364,8 @@ dxf_object_ptr_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (object_ptr->dictionary_owner_soft);
-        free (object_ptr->dictionary_owner_hard);
+        dxf_string_free (object_ptr->dictionary_owner_soft);
+        dxf_string_free (object_ptr->dictionary_owner_hard);
         while (object_ptr->xdata->value != NULL)
         {
                 iter = (struct DxfChar *) object_ptr->xdata->next;
@@ -555,6 +554,8 @@ dxf_object_ptr_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (object_ptr == NULL)
         {
@@ -570,7 +571,13 @@ dxf_object_ptr_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        object_ptr->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (object_ptr->dictionary_owner_soft);
+        object_ptr->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -635,6 +642,8 @@ dxf_object_ptr_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (object_ptr == NULL)
         {
@@ -650,7 +659,13 @@ dxf_object_ptr_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        object_ptr->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (object_ptr->dictionary_owner_hard);
+        object_ptr->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -42,6 +42,8 @@
 
 
 #include "ole2frame.h"
+#include "stats.h"
+#include "util.h"
 
 
 /*!
@@ -71,6 +73,7 @@ dxf_ole2frame_new ()
         else
         {
                 memset (ole2frame, 0, size);
+                dxf_stats_count_allocation (OLE2FRAME, size);
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -112,18 +115,18 @@ dxf_ole2frame_init
               return (NULL);
         }
         ole2frame->id_code = 0;
-        ole2frame->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        ole2frame->layer = strdup (DXF_DEFAULT_LAYER);
+        ole2frame->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        ole2frame->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         ole2frame->elevation = 0.0;
         ole2frame->thickness = 0.0;
         ole2frame->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
         ole2frame->visibility = DXF_DEFAULT_VISIBILITY;
         ole2frame->color = DXF_COLOR_BYLAYER;
         ole2frame->paperspace = DXF_MODELSPACE;
-        ole2frame->dictionary_owner_soft = strdup ("");
-        ole2frame->dictionary_owner_hard = strdup ("");
-        ole2frame->end_of_data = strdup ("OLE");
-        ole2frame->length_of_binary_data = strdup ("");
+        ole2frame->dictionary_owner_soft = dxf_string_share ("");
+        ole2frame->dictionary_owner_hard = dxf_string_share ("");
+        ole2frame->end_of_data = dxf_string_share ("OLE");
+        ole2frame->length_of_binary_data = dxf_string_share ("");
         dxf_ole2frame_set_p0 (ole2frame, dxf_point_new ());
         dxf_point_init ((DxfPoint *) dxf_ole2frame_get_p0 (ole2frame));
         ole2frame->p0->x0 = 0.0;
@@ -227,8 +230,7 @@ dxf_ole2frame_read
                 {
                         /* Now follows a string containing the length of
                          * binary data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ole2frame->length_of_binary_data);
+                        dxf_read_string (fp, &ole2frame->length_of_binary_data);
                 }
                 if (strcmp (temp_string, "5") == 0)
                 {
@@ -241,14 +243,12 @@ dxf_ole2frame_read
                 {
                         /* Now follows a string containing a linetype
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ole2frame->linetype);
+                        dxf_read_string (fp, &ole2frame->linetype);
                 }
                 else if (strcmp (temp_string, "8") == 0)
                 {
                         /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ole2frame->layer);
+                        dxf_read_string (fp, &ole2frame->layer);
                 }
                 else if (strcmp (temp_string, "10") == 0)
                 {
@@ -390,15 +390,13 @@ dxf_ole2frame_read
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ole2frame->dictionary_owner_soft);
+                        dxf_read_string (fp, &ole2frame->dictionary_owner_soft);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ole2frame->dictionary_owner_hard);
+                        dxf_read_string (fp, &ole2frame->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "999") == 0)
                 {
@@ -417,11 +415,13 @@ dxf_ole2frame_read
         /* Handle omitted members and/or illegal values. */
         if (strcmp (ole2frame->linetype, "") == 0)
         {
-                ole2frame->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (ole2frame->linetype);
+                ole2frame->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (ole2frame->layer, "") == 0)
         {
-                ole2frame->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (ole2frame->layer);
+                ole2frame->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Clean up. */
         free (temp_string);
@@ -486,7 +486,8 @@ dxf_ole2frame_write
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                ole2frame->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (ole2frame->linetype);
+                ole2frame->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (ole2frame->layer, "") == 0)
         {
@@ -496,7 +497,8 @@ dxf_ole2frame_write
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0")),
                   dxf_entity_name);
-                ole2frame->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (ole2frame->layer);
+                ole2frame->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Start writing output. */
         fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
@@ -634,16 +636,27 @@ dxf_ole2frame_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (ole2frame->end_of_data);
-        free (ole2frame->length_of_binary_data);
-        free (ole2frame->linetype);
-        free (ole2frame->layer);
-        free (ole2frame->dictionary_owner_soft);
-        free (ole2frame->dictionary_owner_hard);
+        dxf_string_free (ole2frame->end_of_data);
+        dxf_string_free (ole2frame->length_of_binary_data);
+        dxf_string_free (ole2frame->linetype);
+        dxf_string_free (ole2frame->layer);
+        dxf_string_free (ole2frame->dictionary_owner_soft);
+        dxf_string_free (ole2frame->dictionary_owner_hard);
         free (ole2frame->binary_data->value);
         /*! \todo Needs a proper implementation. */
         free (ole2frame->binary_data);
         /*! \todo Needs a proper implementation. */
+        dxf_string_free (ole2frame->color_name);
+        dxf_string_free (ole2frame->material);
+        dxf_string_free (ole2frame->plot_style_name);
+        if (ole2frame->p0 != NULL)
+        {
+                dxf_point_free (ole2frame->p0);
+        }
+        if (ole2frame->p1 != NULL)
+        {
+                dxf_point_free (ole2frame->p1);
+        }
         free (ole2frame);
         ole2frame = NULL;
 #if DEBUG
@@ -815,6 +828,8 @@ dxf_ole2frame_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (ole2frame == NULL)
         {
@@ -830,7 +845,13 @@ dxf_ole2frame_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        ole2frame->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (ole2frame->linetype);
+        ole2frame->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -890,6 +911,8 @@ dxf_ole2frame_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (ole2frame == NULL)
         {
@@ -905,7 +928,13 @@ dxf_ole2frame_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        ole2frame->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (ole2frame->layer);
+        ole2frame->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1683,6 +1712,8 @@ dxf_ole2frame_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (ole2frame == NULL)
         {
@@ -1698,7 +1729,13 @@ dxf_ole2frame_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        ole2frame->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (ole2frame->dictionary_owner_soft);
+        ole2frame->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1767,6 +1804,8 @@ dxf_ole2frame_set_material
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (ole2frame == NULL)
         {
@@ -1782,7 +1821,13 @@ dxf_ole2frame_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        ole2frame->material = strdup (material);
+        copy = dxf_string_share (material);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (ole2frame->material);
+        ole2frame->material = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1847,6 +1892,8 @@ dxf_ole2frame_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (ole2frame == NULL)
         {
@@ -1862,7 +1909,13 @@ dxf_ole2frame_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        ole2frame->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (ole2frame->dictionary_owner_hard);
+        ole2frame->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1992,6 +2045,8 @@ dxf_ole2frame_set_plot_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (ole2frame == NULL)
         {
@@ -2007,7 +2062,13 @@ dxf_ole2frame_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        ole2frame->plot_style_name = strdup (plot_style_name);
+        copy = dxf_string_share (plot_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (ole2frame->plot_style_name);
+        ole2frame->plot_style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2137,6 +2198,8 @@ dxf_ole2frame_set_color_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (ole2frame == NULL)
         {
@@ -2152,7 +2215,13 @@ dxf_ole2frame_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        ole2frame->color_name = strdup (color_name);
+        copy = dxf_string_share (color_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (ole2frame->color_name);
+        ole2frame->color_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2282,6 +2351,8 @@ dxf_ole2frame_set_end_of_data
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (ole2frame == NULL)
         {
@@ -2297,7 +2368,13 @@ dxf_ole2frame_set_end_of_data
                   __FUNCTION__);
                 return (NULL);
         }
-        ole2frame->end_of_data = strdup (end_of_data);
+        copy = dxf_string_share (end_of_data);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (ole2frame->end_of_data);
+        ole2frame->end_of_data = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2362,6 +2439,8 @@ dxf_ole2frame_set_length_of_binary_data
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (ole2frame == NULL)
         {
@@ -2377,7 +2456,13 @@ dxf_ole2frame_set_length_of_binary_data
                   __FUNCTION__);
                 return (NULL);
         }
-        ole2frame->length_of_binary_data = strdup (length_of_binary_data);
+        copy = dxf_string_share (length_of_binary_data);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (ole2frame->length_of_binary_data);
+        ole2frame->length_of_binary_data = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
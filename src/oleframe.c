@@ -40,6 +40,8 @@
 
 
 #include "oleframe.h"
+#include "stats.h"
+#include "util.h"
 
 
 /*!
@@ -69,6 +71,7 @@ dxf_oleframe_new ()
         else
         {
                 memset (oleframe, 0, size);
+                dxf_stats_count_allocation (OLEFRAME, size);
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -110,16 +113,16 @@ dxf_oleframe_init
               return (NULL);
         }
         oleframe->id_code = 0;
-        oleframe->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        oleframe->layer = strdup (DXF_DEFAULT_LAYER);
+        oleframe->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        oleframe->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         oleframe->elevation = 0.0;
         oleframe->thickness = 0.0;
         oleframe->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
         oleframe->visibility = DXF_DEFAULT_VISIBILITY;
         oleframe->color = DXF_COLOR_BYLAYER;
         oleframe->paperspace = DXF_MODELSPACE;
-        oleframe->dictionary_owner_soft = strdup ("");
-        oleframe->dictionary_owner_hard = strdup ("");
+        oleframe->dictionary_owner_soft = dxf_string_share ("");
+        oleframe->dictionary_owner_hard = dxf_string_share ("");
         oleframe->ole_version_number = 1;
         oleframe->length = 0;
         oleframe->binary_data = dxf_char_new ();
@@ -218,14 +221,12 @@ dxf_oleframe_read
                 {
                         /* Now follows a string containing a linetype
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", oleframe->linetype);
+                        dxf_read_string (fp, &oleframe->linetype);
                 }
                 else if (strcmp (temp_string, "8") == 0)
                 {
                         /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", oleframe->layer);
+                        dxf_read_string (fp, &oleframe->layer);
                 }
                 else if ((fp->acad_version_number <= AutoCAD_11)
                         && (strcmp (temp_string, "38") == 0)
@@ -312,15 +313,13 @@ dxf_oleframe_read
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", oleframe->dictionary_owner_soft);
+                        dxf_read_string (fp, &oleframe->dictionary_owner_soft);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", oleframe->dictionary_owner_hard);
+                        dxf_read_string (fp, &oleframe->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "999") == 0)
                 {
@@ -339,11 +338,13 @@ dxf_oleframe_read
         /* Handle omitted members and/or illegal values. */
         if (strcmp (oleframe->linetype, "") == 0)
         {
-                oleframe->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (oleframe->linetype);
+                oleframe->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (oleframe->layer, "") == 0)
         {
-                oleframe->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (oleframe->layer);
+                oleframe->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Clean up. */
         free (temp_string);
@@ -408,7 +409,8 @@ dxf_oleframe_write
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                oleframe->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (oleframe->linetype);
+                oleframe->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (oleframe->layer, "") == 0)
         {
@@ -418,7 +420,8 @@ dxf_oleframe_write
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0")),
                   dxf_entity_name);
-                oleframe->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (oleframe->layer);
+                oleframe->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Start writing output. */
         fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
@@ -547,11 +550,14 @@ dxf_oleframe_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (oleframe->linetype);
-        free (oleframe->layer);
-        free (oleframe->dictionary_owner_soft);
-        free (oleframe->dictionary_owner_hard);
+        dxf_string_free (oleframe->linetype);
+        dxf_string_free (oleframe->layer);
+        dxf_string_free (oleframe->dictionary_owner_soft);
+        dxf_string_free (oleframe->dictionary_owner_hard);
         dxf_char_free_list (oleframe->binary_data);
+        dxf_string_free (oleframe->color_name);
+        dxf_string_free (oleframe->material);
+        dxf_string_free (oleframe->plot_style_name);
         free (oleframe);
         oleframe = NULL;
 #if DEBUG
@@ -721,6 +727,8 @@ dxf_oleframe_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (oleframe == NULL)
         {
@@ -736,7 +744,13 @@ dxf_oleframe_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        oleframe->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (oleframe->linetype);
+        oleframe->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -796,6 +810,8 @@ dxf_oleframe_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (oleframe == NULL)
         {
@@ -811,7 +827,13 @@ dxf_oleframe_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        oleframe->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (oleframe->layer);
+        oleframe->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1588,6 +1610,8 @@ dxf_oleframe_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (oleframe == NULL)
         {
@@ -1603,7 +1627,13 @@ dxf_oleframe_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        oleframe->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (oleframe->dictionary_owner_soft);
+        oleframe->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1671,6 +1701,8 @@ dxf_oleframe_set_material
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (oleframe == NULL)
         {
@@ -1686,7 +1718,13 @@ dxf_oleframe_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        oleframe->material = strdup (material);
+        copy = dxf_string_share (material);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (oleframe->material);
+        oleframe->material = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1751,6 +1789,8 @@ dxf_oleframe_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (oleframe == NULL)
         {
@@ -1766,7 +1806,13 @@ dxf_oleframe_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        oleframe->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (oleframe->dictionary_owner_hard);
+        oleframe->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1896,6 +1942,8 @@ dxf_oleframe_set_plot_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (oleframe == NULL)
         {
@@ -1911,7 +1959,13 @@ dxf_oleframe_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        oleframe->plot_style_name = strdup (plot_style_name);
+        copy = dxf_string_share (plot_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (oleframe->plot_style_name);
+        oleframe->plot_style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2041,6 +2095,8 @@ dxf_oleframe_set_color_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (oleframe == NULL)
         {
@@ -2056,7 +2112,13 @@ dxf_oleframe_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        oleframe->color_name = strdup (color_name);
+        copy = dxf_string_share (color_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (oleframe->color_name);
+        oleframe->color_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -0,0 +1,1051 @@
+/*!
+ * \file passthrough.c
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Functions for lossless pass-through rewriting of DXF files.
+ *
+ * The source file is kept in memory and split into records, every record
+ * starting at a group code 0.\n
+ * Records are only decoded on request (see
+ * dxf_passthrough_open_record ()), and only records marked dirty are
+ * serialized again when saving, all other records are copied verbatim
+ * from the source buffer, including group codes the readers of libDXF do
+ * not model.\n
+ * Consecutive clean records form a single contiguous range of the source
+ * buffer and are written with a single \c fwrite () call, so the time
+ * spent on saving is dominated by the size of the edits.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include "passthrough.h"
+#include "header.h"
+#include "stats.h"
+
+
+static int dxf_passthrough_index (DxfPassthrough *passthrough);
+static int dxf_passthrough_add_record (DxfPassthrough *passthrough, size_t offset, size_t type_offset, int type_length, size_t body_offset);
+static size_t dxf_passthrough_next_line (DxfPassthrough *passthrough, size_t offset, size_t end, int *length);
+static size_t dxf_passthrough_skip_spaces (DxfPassthrough *passthrough, size_t offset, size_t end);
+static int dxf_passthrough_find_value (DxfPassthrough *passthrough, size_t offset, size_t end, int group_code, size_t *value_offset, int *value_length);
+static int dxf_passthrough_write_range (DxfFile *fp, const char *buffer, size_t length, int number_of_lines);
+
+
+/*!
+ * \brief Allocate memory for a \c DxfPassthrough.
+ *
+ * Fill the memory contents with zeros.
+ */
+DxfPassthrough *
+dxf_passthrough_new ()
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfPassthrough *passthrough = NULL;
+        size_t size;
+
+        size = sizeof (DxfPassthrough);
+        /* avoid malloc of 0 bytes */
+        if (size == 0) size = 1;
+        if ((passthrough = malloc (size)) == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory for a DxfPassthrough struct.\n")),
+                  __FUNCTION__);
+                passthrough = NULL;
+        }
+        else
+        {
+                memset (passthrough, 0, size);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (passthrough);
+}
+
+
+/*!
+ * \brief Allocate memory and initialize data fields in a
+ * \c DxfPassthrough.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfPassthrough *
+dxf_passthrough_init
+(
+        DxfPassthrough *passthrough
+                /*!< a pointer to the pass-through file. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (passthrough == NULL)
+        {
+                fprintf (stderr,
+                  (_("Warning in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                passthrough = dxf_passthrough_new ();
+        }
+        if (passthrough == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory for a DxfPassthrough struct.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        passthrough->filename = NULL;
+        passthrough->buffer = NULL;
+        passthrough->size = 0;
+        passthrough->records = NULL;
+        passthrough->number_of_records = 0;
+        passthrough->max_number_of_records = 0;
+        passthrough->acad_version_number = 0;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (passthrough);
+}
+
+
+/*!
+ * \brief Load a DXF file into memory and index its records.
+ *
+ * Previously loaded contents are discarded, including any dirty
+ * records.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_passthrough_load
+(
+        DxfPassthrough *passthrough,
+                /*!< a pointer to the pass-through file. */
+        const char *filename
+                /*!< filename of the (ASCII) DXF file. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        FILE *fp = NULL;
+        long size;
+        size_t value_offset;
+        size_t next;
+        size_t end;
+        int value_length;
+        int length;
+        int i;
+        char version[DXF_MAX_STRING_LENGTH];
+
+        /* Do some basic checks. */
+        if ((passthrough == NULL) || (filename == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        free (passthrough->filename);
+        free (passthrough->buffer);
+        free (passthrough->records);
+        dxf_passthrough_init (passthrough);
+        fp = fopen (filename, "rb");
+        if (fp == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not open file: %s for reading.\n")),
+                  __FUNCTION__, filename);
+                return (EXIT_FAILURE);
+        }
+        if ((fseek (fp, 0, SEEK_END) != 0)
+          || ((size = ftell (fp)) < 0)
+          || (fseek (fp, 0, SEEK_SET) != 0))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not determine the size of: %s.\n")),
+                  __FUNCTION__, filename);
+                fclose (fp);
+                return (EXIT_FAILURE);
+        }
+        /* One extra byte, so that an empty file is not a malloc of 0
+         * bytes. */
+        passthrough->buffer = malloc ((size_t) size + 1);
+        passthrough->filename = strdup (filename);
+        if ((passthrough->buffer == NULL) || (passthrough->filename == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                fclose (fp);
+                return (EXIT_FAILURE);
+        }
+        passthrough->size = fread (passthrough->buffer, 1, (size_t) size, fp);
+        if (ferror (fp))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () while reading from: %s.\n")),
+                  __FUNCTION__, filename);
+                fclose (fp);
+                return (EXIT_FAILURE);
+        }
+        fclose (fp);
+        /* Terminate the buffer for strtol (). */
+        passthrough->buffer[passthrough->size] = '\0';
+        if (dxf_passthrough_index (passthrough) != EXIT_SUCCESS)
+        {
+                return (EXIT_FAILURE);
+        }
+        /* The writers of modified records need the version of the
+         * source file, the header variables are all part of the record
+         * of the HEADER section. */
+        i = dxf_passthrough_find (passthrough, 0, "SECTION", 2, "HEADER");
+        if (i >= 0)
+        {
+                end = passthrough->records[i].offset + passthrough->records[i].length;
+                next = passthrough->records[i].body_offset;
+                while (dxf_passthrough_find_value (passthrough, next, end,
+                  9, &value_offset, &value_length) == EXIT_SUCCESS)
+                {
+                        /* Continue after the line holding the value. */
+                        next = dxf_passthrough_next_line (passthrough,
+                          value_offset, end, &length);
+                        if ((value_length == 8)
+                          && (strncmp (passthrough->buffer + value_offset, "$ACADVER", 8) == 0))
+                        {
+                                if (dxf_passthrough_find_value (passthrough, next, end,
+                                  1, &value_offset, &value_length) == EXIT_SUCCESS)
+                                {
+                                        if (value_length >= (int) sizeof (version))
+                                        {
+                                                value_length = sizeof (version) - 1;
+                                        }
+                                        memcpy (version, passthrough->buffer + value_offset, value_length);
+                                        version[value_length] = '\0';
+                                        passthrough->acad_version_number = dxf_header_acad_version_from_string (version);
+                                }
+                                break;
+                        }
+                }
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Get the number of records of a pass-through file.
+ *
+ * \return the number of records, or -1 when an error occurred.
+ */
+int
+dxf_passthrough_get_number_of_records
+(
+        DxfPassthrough *passthrough
+                /*!< a pointer to the pass-through file. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (passthrough == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (-1);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (passthrough->number_of_records);
+}
+
+
+/*!
+ * \brief Get the type of a record (the value of its group code 0, e.g.
+ * \c LINE or \c SECTION).
+ *
+ * The type of the bytes in front of the first group code 0 (if any) is
+ * an empty string.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_passthrough_get_type
+(
+        DxfPassthrough *passthrough,
+                /*!< a pointer to the pass-through file. */
+        int index,
+                /*!< index of the record. */
+        char *type,
+                /*!< buffer receiving the type. */
+        int size
+                /*!< size of \c type. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfPassthroughRecord *record = NULL;
+        int length;
+
+        /* Do some basic checks. */
+        if ((passthrough == NULL) || (type == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if ((index < 0) || (index >= passthrough->number_of_records) || (size <= 0))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () an invalid index or size was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        record = &passthrough->records[index];
+        length = (record->type_length < size) ? record->type_length : size - 1;
+        memcpy (type, passthrough->buffer + record->type_offset, length);
+        type[length] = '\0';
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Get the value of the first occurrence of a group code in a
+ * record, e.g. the layer (group code 8) of an entity.
+ *
+ * The value is taken from the source buffer, also for dirty records.
+ *
+ * \return \c EXIT_SUCCESS when the group code was found, or
+ * \c EXIT_FAILURE when not or when an error occurred.
+ */
+int
+dxf_passthrough_get_value
+(
+        DxfPassthrough *passthrough,
+                /*!< a pointer to the pass-through file. */
+        int index,
+                /*!< index of the record. */
+        int group_code,
+                /*!< group code of the value. */
+        char *value,
+                /*!< buffer receiving the value. */
+        int size
+                /*!< size of \c value. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfPassthroughRecord *record = NULL;
+        size_t value_offset;
+        int value_length;
+
+        /* Do some basic checks. */
+        if ((passthrough == NULL) || (value == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if ((index < 0) || (index >= passthrough->number_of_records) || (size <= 0))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () an invalid index or size was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        record = &passthrough->records[index];
+        if (group_code == 0)
+        {
+                return (dxf_passthrough_get_type (passthrough, index, value, size));
+        }
+        if (dxf_passthrough_find_value (passthrough, record->body_offset,
+          record->offset + record->length, group_code,
+          &value_offset, &value_length) != EXIT_SUCCESS)
+        {
+                return (EXIT_FAILURE);
+        }
+        if (value_length >= size)
+        {
+                value_length = size - 1;
+        }
+        memcpy (value, passthrough->buffer + value_offset, value_length);
+        value[value_length] = '\0';
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Find the next record of a type, optionally with a value for a
+ * group code, e.g. the next \c LINE on layer "WALLS".
+ *
+ * \return the index of the record, or -1 when no record was found or
+ * when an error occurred.
+ */
+int
+dxf_passthrough_find
+(
+        DxfPassthrough *passthrough,
+                /*!< a pointer to the pass-through file. */
+        int start,
+                /*!< index of the first record to look at. */
+        const char *type,
+                /*!< type of the record, \c NULL for any type. */
+        int group_code,
+                /*!< group code to match, or -1 for none. */
+        const char *value
+                /*!< value of \c group_code to match. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfPassthroughRecord *record = NULL;
+        size_t value_offset;
+        int value_length;
+        int i;
+
+        /* Do some basic checks. */
+        if ((passthrough == NULL) || ((group_code >= 0) && (value == NULL)))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (-1);
+        }
+        for (i = (start > 0) ? start : 0; i < passthrough->number_of_records; i++)
+        {
+                record = &passthrough->records[i];
+                if ((type != NULL)
+                  && (((size_t) record->type_length != strlen (type))
+                  || (strncmp (passthrough->buffer + record->type_offset, type, record->type_length) != 0)))
+                {
+                        continue;
+                }
+                if (group_code < 0)
+                {
+                        return (i);
+                }
+                if ((dxf_passthrough_find_value (passthrough, record->body_offset,
+                  record->offset + record->length, group_code,
+                  &value_offset, &value_length) == EXIT_SUCCESS)
+                  && ((size_t) value_length == strlen (value))
+                  && (strncmp (passthrough->buffer + value_offset, value, value_length) == 0))
+                {
+                        return (i);
+                }
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (-1);
+}
+
+
+/*!
+ * \brief Open a record for decoding by one of the entity readers.
+ *
+ * The returned file handle reads from the source buffer, starting with
+ * the group code following the record type and ending with the group
+ * code 0 of the next record, as expected by readers like
+ * dxf_line_read ().\n
+ * Close the handle with dxf_read_close ().
+ *
+ * \return a DXF file handle, or \c NULL when an error occurred.
+ */
+DxfFile *
+dxf_passthrough_open_record
+(
+        DxfPassthrough *passthrough,
+                /*!< a pointer to the pass-through file. */
+        int index
+                /*!< index of the record. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfPassthroughRecord *record = NULL;
+        DxfFile *file = NULL;
+        size_t end;
+        int length;
+
+        /* Do some basic checks. */
+        if (passthrough == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        if ((index < 0) || (index >= passthrough->number_of_records))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () an invalid index was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        record = &passthrough->records[index];
+        end = record->offset + record->length;
+        if (index + 1 < passthrough->number_of_records)
+        {
+                /* Include the group code 0 of the next record. */
+                end = dxf_passthrough_next_line (passthrough, end, passthrough->size, &length);
+        }
+        file = malloc (sizeof (DxfFile));
+        if (file == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory for a DxfFile struct.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        memset (file, 0, sizeof (DxfFile));
+        file->fp = fmemopen (passthrough->buffer + record->body_offset,
+          end - record->body_offset, "r");
+        file->filename = strdup (passthrough->filename);
+        if ((file->fp == NULL) || (file->filename == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not open record %d of: %s.\n")),
+                  __FUNCTION__, index, passthrough->filename);
+                if (file->fp != NULL)
+                {
+                        fclose (file->fp);
+                }
+                free (file->filename);
+                free (file);
+                return (NULL);
+        }
+        file->acad_version_number = passthrough->acad_version_number;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (file);
+}
+
+
+/*!
+ * \brief Mark a record as modified.
+ *
+ * When saving, \c writer is invoked with \c object instead of copying
+ * the record from the source buffer.\n
+ * A \c NULL \c writer deletes the record from the output.\n
+ * The \c object is owned by the caller and has to stay valid until the
+ * file is saved.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_passthrough_set_dirty
+(
+        DxfPassthrough *passthrough,
+                /*!< a pointer to the pass-through file. */
+        int index,
+                /*!< index of the record. */
+        DxfPassthroughWriter writer,
+                /*!< writer of the modified record, \c NULL to delete
+                 * the record. */
+        void *object
+                /*!< object passed to \c writer. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (passthrough == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if ((index < 0) || (index >= passthrough->number_of_records))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () an invalid index was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        passthrough->records[index].dirty = TRUE;
+        passthrough->records[index].writer = writer;
+        passthrough->records[index].object = object;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Save a pass-through file.
+ *
+ * Runs of clean records are copied verbatim from the source buffer with
+ * a single \c fwrite () per run, dirty records are written by their
+ * writer (or left out when they have none).\n
+ * Saving to the name of the source file is allowed, the source is held
+ * in memory.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_passthrough_save
+(
+        DxfPassthrough *passthrough,
+                /*!< a pointer to the pass-through file. */
+        const char *filename
+                /*!< filename of the output file. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfPassthroughRecord *record = NULL;
+        DxfFile fp;
+        size_t run_offset = 0;
+        size_t run_length = 0;
+        int run_lines = 0;
+        int status = EXIT_SUCCESS;
+        int i;
+
+        /* Do some basic checks. */
+        if ((passthrough == NULL) || (filename == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        memset (&fp, 0, sizeof (DxfFile));
+        fp.fp = fopen (filename, "wb");
+        if (fp.fp == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not open file: %s for writing.\n")),
+                  __FUNCTION__, filename);
+                return (EXIT_FAILURE);
+        }
+        fp.filename = (char *) filename;
+        fp.acad_version_number = passthrough->acad_version_number;
+        for (i = 0; i < passthrough->number_of_records; i++)
+        {
+                record = &passthrough->records[i];
+                if (!record->dirty)
+                {
+                        /* Records are contiguous in the source buffer. */
+                        if (run_length == 0)
+                        {
+                                run_offset = record->offset;
+                        }
+                        run_length += record->length;
+                        run_lines += record->number_of_lines;
+                        continue;
+                }
+                if (dxf_passthrough_write_range (&fp, passthrough->buffer + run_offset,
+                  run_length, run_lines) != EXIT_SUCCESS)
+                {
+                        status = EXIT_FAILURE;
+                }
+                run_length = 0;
+                run_lines = 0;
+                if ((record->writer != NULL)
+                  && (record->writer (&fp, record->object) != EXIT_SUCCESS))
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () could not write record %d to: %s.\n")),
+                          __FUNCTION__, i, filename);
+                        status = EXIT_FAILURE;
+                }
+        }
+        if (dxf_passthrough_write_range (&fp, passthrough->buffer + run_offset,
+          run_length, run_lines) != EXIT_SUCCESS)
+        {
+                status = EXIT_FAILURE;
+        }
+        if (fclose (fp.fp) != 0)
+        {
+                status = EXIT_FAILURE;
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (status);
+}
+
+
+/*!
+ * \brief Free the allocated memory for a pass-through file and all it's
+ * data fields.
+ *
+ * The objects attached to dirty records are owned by the caller and are
+ * not freed.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_passthrough_free
+(
+        DxfPassthrough *passthrough
+                /*!< a pointer to the pass-through file. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (passthrough == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        free (passthrough->filename);
+        free (passthrough->buffer);
+        free (passthrough->records);
+        free (passthrough);
+        passthrough = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Split the source buffer into records.
+ *
+ * The source is read as pairs of a group code line and a value line, a
+ * record starts at every group code 0.\n
+ * Bytes in front of the first group code 0 form a record of their own
+ * with an empty type.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_passthrough_index
+(
+        DxfPassthrough *passthrough
+                /*!< a pointer to the pass-through file. */
+)
+{
+        DxfPassthroughRecord *record = NULL;
+        size_t offset = 0;
+        size_t value_offset;
+        size_t next;
+        char *end = NULL;
+        int code_length;
+        int value_length;
+        int number_of_lines = 0;
+        int total_lines = 0;
+        int group_code;
+        int i;
+
+        while (offset < passthrough->size)
+        {
+                value_offset = dxf_passthrough_next_line (passthrough, offset,
+                  passthrough->size, &code_length);
+                next = dxf_passthrough_next_line (passthrough, value_offset,
+                  passthrough->size, &value_length);
+                group_code = (int) strtol (passthrough->buffer + offset, &end, 10);
+                if ((end != passthrough->buffer + offset)
+                  && (end < passthrough->buffer + value_offset)
+                  && (group_code == 0))
+                {
+                        if ((passthrough->number_of_records == 0) && (offset > 0))
+                        {
+                                /* Bytes in front of the first record. */
+                                if (dxf_passthrough_add_record (passthrough, 0, 0, 0, 0) != EXIT_SUCCESS)
+                                {
+                                        return (EXIT_FAILURE);
+                                }
+                                passthrough->records[0].number_of_lines = number_of_lines;
+                                number_of_lines = 0;
+                        }
+                        if (dxf_passthrough_add_record (passthrough, offset,
+                          value_offset + dxf_passthrough_skip_spaces (passthrough, value_offset, next),
+                          value_length, next) != EXIT_SUCCESS)
+                        {
+                                return (EXIT_FAILURE);
+                        }
+                        number_of_lines = 0;
+                }
+                number_of_lines += (next > value_offset) ? 2 : 1;
+                total_lines += (next > value_offset) ? 2 : 1;
+                if (passthrough->number_of_records > 0)
+                {
+                        passthrough->records[passthrough->number_of_records - 1].number_of_lines = number_of_lines;
+                }
+                offset = next;
+        }
+        if ((passthrough->number_of_records == 0) && (passthrough->size > 0))
+        {
+                /* No group code 0 at all, keep the bytes anyway. */
+                if (dxf_passthrough_add_record (passthrough, 0, 0, 0, 0) != EXIT_SUCCESS)
+                {
+                        return (EXIT_FAILURE);
+                }
+                passthrough->records[0].number_of_lines = number_of_lines;
+        }
+        /* Every record ends where the next one starts. */
+        for (i = 0; i < passthrough->number_of_records; i++)
+        {
+                record = &passthrough->records[i];
+                record->length = ((i + 1 < passthrough->number_of_records)
+                  ? passthrough->records[i + 1].offset
+                  : passthrough->size) - record->offset;
+        }
+        dxf_stats_add_read (NULL, passthrough->size, total_lines);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Append a record to the index.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_passthrough_add_record
+(
+        DxfPassthrough *passthrough,
+                /*!< a pointer to the pass-through file. */
+        size_t offset,
+                /*!< offset of the record. */
+        size_t type_offset,
+                /*!< offset of the record type. */
+        int type_length,
+                /*!< length of the record type. */
+        size_t body_offset
+                /*!< offset of the group code following the type. */
+)
+{
+        DxfPassthroughRecord *records = NULL;
+        DxfPassthroughRecord *record = NULL;
+        int max_number_of_records;
+
+        if (passthrough->number_of_records == passthrough->max_number_of_records)
+        {
+                max_number_of_records = (passthrough->max_number_of_records > 0)
+                  ? 2 * passthrough->max_number_of_records
+                  : 256;
+                records = realloc (passthrough->records,
+                  max_number_of_records * sizeof (DxfPassthroughRecord));
+                if (records == NULL)
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () could not allocate memory.\n")),
+                          __FUNCTION__);
+                        return (EXIT_FAILURE);
+                }
+                passthrough->records = records;
+                passthrough->max_number_of_records = max_number_of_records;
+        }
+        record = &passthrough->records[passthrough->number_of_records++];
+        memset (record, 0, sizeof (DxfPassthroughRecord));
+        record->offset = offset;
+        record->type_offset = type_offset;
+        record->type_length = type_length;
+        record->body_offset = body_offset;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Find the end of a line in the source buffer.
+ *
+ * \return the offset of the line following the line at \c offset.
+ */
+static size_t
+dxf_passthrough_next_line
+(
+        DxfPassthrough *passthrough,
+                /*!< a pointer to the pass-through file. */
+        size_t offset,
+                /*!< offset of the line. */
+        size_t end,
+                /*!< offset where the search stops. */
+        int *length
+                /*!< length of the line, without line ending and
+                 * surrounding spaces. */
+)
+{
+        const char *line = passthrough->buffer + offset;
+        const char *newline = NULL;
+        size_t first;
+        size_t last;
+
+        newline = (offset < end) ? memchr (line, '\n', end - offset) : NULL;
+        last = (newline != NULL) ? (size_t) (newline - passthrough->buffer) : end;
+        first = offset + dxf_passthrough_skip_spaces (passthrough, offset, last);
+        while ((last > first)
+          && ((passthrough->buffer[last - 1] == '\r') || (passthrough->buffer[last - 1] == ' ')))
+        {
+                last--;
+        }
+        *length = (int) (last - first);
+        return ((newline != NULL) ? (size_t) (newline - passthrough->buffer) + 1 : end);
+}
+
+
+/*!
+ * \brief Count the leading spaces of a line in the source buffer.
+ *
+ * \return the number of leading spaces.
+ */
+static size_t
+dxf_passthrough_skip_spaces
+(
+        DxfPassthrough *passthrough,
+                /*!< a pointer to the pass-through file. */
+        size_t offset,
+                /*!< offset of the line. */
+        size_t end
+                /*!< offset of the next line. */
+)
+{
+        size_t first = offset;
+
+        while ((first < end) && (passthrough->buffer[first] == ' '))
+        {
+                first++;
+        }
+        return (first - offset);
+}
+
+
+/*!
+ * \brief Find the value of a group code in a range of the source
+ * buffer.
+ *
+ * \return \c EXIT_SUCCESS when the group code was found, or
+ * \c EXIT_FAILURE when not.
+ */
+static int
+dxf_passthrough_find_value
+(
+        DxfPassthrough *passthrough,
+                /*!< a pointer to the pass-through file. */
+        size_t offset,
+                /*!< offset of the first group code line. */
+        size_t end,
+                /*!< offset where the search stops. */
+        int group_code,
+                /*!< group code to find. */
+        size_t *value_offset,
+                /*!< offset of the value found. */
+        int *value_length
+                /*!< length of the value found. */
+)
+{
+        size_t value;
+        size_t next;
+        char *stop = NULL;
+        int length;
+        int code;
+
+        while (offset < end)
+        {
+                value = dxf_passthrough_next_line (passthrough, offset, end, &length);
+                next = dxf_passthrough_next_line (passthrough, value, end, value_length);
+                code = (int) strtol (passthrough->buffer + offset, &stop, 10);
+                if ((stop != passthrough->buffer + offset)
+                  && (stop < passthrough->buffer + value)
+                  && (code == group_code))
+                {
+                        *value_offset = value + dxf_passthrough_skip_spaces (passthrough, value, next);
+                        return (EXIT_SUCCESS);
+                }
+                offset = next;
+        }
+        return (EXIT_FAILURE);
+}
+
+
+/*!
+ * \brief Write a range of the source buffer verbatim.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_passthrough_write_range
+(
+        DxfFile *fp,
+                /*!< DXF file handle of the output file. */
+        const char *buffer,
+                /*!< first byte of the range. */
+        size_t length,
+                /*!< number of bytes in the range. */
+        int number_of_lines
+                /*!< number of lines in the range. */
+)
+{
+        if (length == 0)
+        {
+                return (EXIT_SUCCESS);
+        }
+        if (fwrite (buffer, 1, length, fp->fp) != length)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () while writing to: %s.\n")),
+                  __FUNCTION__, fp->filename);
+                return (EXIT_FAILURE);
+        }
+        dxf_stats_add_write (fp, length, number_of_lines);
+        return (EXIT_SUCCESS);
+}
+
+
+/* EOF */
@@ -0,0 +1,152 @@
+/*!
+ * \file passthrough.h
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Header file for lossless pass-through rewriting of DXF files.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#ifndef LIBDXF_SRC_PASSTHROUGH_H
+#define LIBDXF_SRC_PASSTHROUGH_H
+
+
+#include "global.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*!
+ * \brief Writer invoked for a modified record when saving.
+ *
+ * The writer is expected to write the complete record, starting with
+ * the group code 0 and the record type, e.g. a wrapper around
+ * dxf_line_write ().
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+typedef int (*DxfPassthroughWriter)
+(
+        DxfFile *fp,
+                /*!< DXF file handle of the output file. */
+        void *object
+                /*!< the object passed to dxf_passthrough_set_dirty (). */
+);
+
+
+/*!
+ * \brief Definition of a record in the source of a pass-through file.
+ *
+ * A record starts with a group code 0 and ends in front of the next
+ * group code 0 (or at the end of the source).
+ */
+typedef struct
+dxf_passthrough_record_struct
+{
+        size_t offset;
+                /*!< Offset of the first byte of the record in the
+                 * source buffer. */
+        size_t length;
+                /*!< Number of bytes of the record. */
+        size_t type_offset;
+                /*!< Offset of the record type (the value of the group
+                 * code 0) in the source buffer. */
+        int type_length;
+                /*!< Length of the record type, 0 for bytes in front of
+                 * the first group code 0. */
+        size_t body_offset;
+                /*!< Offset of the first group code following the
+                 * record type in the source buffer. */
+        int number_of_lines;
+                /*!< Number of lines of the record. */
+        int dirty;
+                /*!< \c TRUE when the record was modified and has to be
+                 * written by \c writer. */
+        DxfPassthroughWriter writer;
+                /*!< Writer of a modified record, \c NULL when a
+                 * modified record is deleted. */
+        void *object;
+                /*!< Object passed to \c writer. */
+} DxfPassthroughRecord;
+
+
+/*!
+ * \brief Definition of a DXF file kept for lossless pass-through
+ * rewriting.
+ *
+ * The complete source file is kept in memory together with an index of
+ * its records, clean records are copied verbatim when saving.
+ */
+typedef struct
+dxf_passthrough_struct
+{
+        char *filename;
+                /*!< Name of the source file. */
+        char *buffer;
+                /*!< Contents of the source file. */
+        size_t size;
+                /*!< Number of bytes in \c buffer. */
+        DxfPassthroughRecord *records;
+                /*!< Records of the source file, in file order. */
+        int number_of_records;
+                /*!< Number of records. */
+        int max_number_of_records;
+                /*!< Number of records that fit in \c records. */
+        int acad_version_number;
+                /*!< AutoCAD version number of the source file (from
+                 * the \c $ACADVER header variable), passed to the
+                 * writers of modified records. */
+} DxfPassthrough;
+
+
+DxfPassthrough *dxf_passthrough_new ();
+DxfPassthrough *dxf_passthrough_init (DxfPassthrough *passthrough);
+int dxf_passthrough_load (DxfPassthrough *passthrough, const char *filename);
+int dxf_passthrough_get_number_of_records (DxfPassthrough *passthrough);
+int dxf_passthrough_get_type (DxfPassthrough *passthrough, int index, char *type, int size);
+int dxf_passthrough_get_value (DxfPassthrough *passthrough, int index, int group_code, char *value, int size);
+int dxf_passthrough_find (DxfPassthrough *passthrough, int start, const char *type, int group_code, const char *value);
+DxfFile *dxf_passthrough_open_record (DxfPassthrough *passthrough, int index);
+int dxf_passthrough_set_dirty (DxfPassthrough *passthrough, int index, DxfPassthroughWriter writer, void *object);
+int dxf_passthrough_save (DxfPassthrough *passthrough, const char *filename);
+int dxf_passthrough_free (DxfPassthrough *passthrough);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* LIBDXF_SRC_PASSTHROUGH_H */
+
+
+/* EOF */
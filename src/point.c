@@ -57,6 +57,62 @@
 
 
 #include "point.h"
+#include "schema.h"
+#include "stats.h"
+#include "util.h"
+
+
+/*!
+ * \brief Group code schema of a DXF \c POINT entity.
+ *
+ * The fields are listed in the order they are written.
+ */
+static const DxfSchemaField dxf_point_schema_fields[] =
+{
+        {.group_code = 5, .type = DXF_SCHEMA_HEX, .offset = offsetof (DxfPoint, id_code), .flags = DXF_SCHEMA_SKIP_DEFAULT, .default_int = -1},
+        {.group_code = 330, .type = DXF_SCHEMA_STRING, .offset = offsetof (DxfPoint, dictionary_owner_soft), .min_version = AutoCAD_14, .flags = DXF_SCHEMA_SKIP_DEFAULT, .default_string = "", .group_name = "{ACAD_REACTORS"},
+        {.group_code = 360, .type = DXF_SCHEMA_STRING, .offset = offsetof (DxfPoint, dictionary_owner_hard), .min_version = AutoCAD_14, .flags = DXF_SCHEMA_SKIP_DEFAULT, .default_string = "", .group_name = "{ACAD_XDICTIONARY"},
+        {.group_code = 100, .type = DXF_SCHEMA_SUBCLASS, .min_version = AutoCAD_13, .default_string = "AcDbEntity"},
+        {.group_code = 67, .type = DXF_SCHEMA_INT, .offset = offsetof (DxfPoint, paperspace), .flags = DXF_SCHEMA_SKIP_DEFAULT, .default_int = DXF_MODELSPACE},
+        {.group_code = 8, .type = DXF_SCHEMA_STRING, .offset = offsetof (DxfPoint, layer)},
+        {.group_code = 6, .type = DXF_SCHEMA_STRING, .offset = offsetof (DxfPoint, linetype), .flags = DXF_SCHEMA_SKIP_DEFAULT, .default_string = DXF_DEFAULT_LINETYPE},
+        {.group_code = 347, .type = DXF_SCHEMA_STRING, .offset = offsetof (DxfPoint, material), .min_version = AutoCAD_2008, .flags = DXF_SCHEMA_SKIP_DEFAULT, .default_string = ""},
+        {.group_code = 38, .type = DXF_SCHEMA_DOUBLE, .offset = offsetof (DxfPoint, elevation), .max_version = AutoCAD_11, .flags = DXF_SCHEMA_FLATLAND | DXF_SCHEMA_SKIP_DEFAULT},
+        {.group_code = 62, .type = DXF_SCHEMA_INT, .offset = offsetof (DxfPoint, color), .flags = DXF_SCHEMA_SKIP_DEFAULT, .default_int = DXF_COLOR_BYLAYER},
+        {.group_code = 370, .type = DXF_SCHEMA_INT16, .offset = offsetof (DxfPoint, lineweight), .min_version = AutoCAD_2000, .flags = DXF_SCHEMA_SKIP_DEFAULT},
+        {.group_code = 48, .type = DXF_SCHEMA_DOUBLE, .offset = offsetof (DxfPoint, linetype_scale), .flags = DXF_SCHEMA_SKIP_DEFAULT, .default_double = {1.0}},
+        {.group_code = 60, .type = DXF_SCHEMA_INT16, .offset = offsetof (DxfPoint, visibility), .flags = DXF_SCHEMA_SKIP_DEFAULT},
+#ifdef BUILD_64
+        {.group_code = 160, .type = DXF_SCHEMA_INT, .offset = offsetof (DxfPoint, graphics_data_size), .min_version = AutoCAD_2000, .flags = DXF_SCHEMA_SKIP_DEFAULT},
+        {.group_code = 92, .type = DXF_SCHEMA_INT, .offset = offsetof (DxfPoint, graphics_data_size), .flags = DXF_SCHEMA_READ_ONLY},
+#else
+        {.group_code = 92, .type = DXF_SCHEMA_INT, .offset = offsetof (DxfPoint, graphics_data_size), .min_version = AutoCAD_2000, .flags = DXF_SCHEMA_SKIP_DEFAULT},
+        {.group_code = 160, .type = DXF_SCHEMA_INT, .offset = offsetof (DxfPoint, graphics_data_size), .flags = DXF_SCHEMA_READ_ONLY},
+#endif
+        {.group_code = 310, .type = DXF_SCHEMA_BINARY_LIST, .offset = offsetof (DxfPoint, binary_graphics_data), .min_version = AutoCAD_2000, .flags = DXF_SCHEMA_SKIP_DEFAULT},
+        {.group_code = 420, .type = DXF_SCHEMA_LONG, .offset = offsetof (DxfPoint, color_value), .min_version = AutoCAD_2004, .flags = DXF_SCHEMA_SKIP_DEFAULT},
+        {.group_code = 430, .type = DXF_SCHEMA_STRING, .offset = offsetof (DxfPoint, color_name), .min_version = AutoCAD_2004, .flags = DXF_SCHEMA_SKIP_DEFAULT, .default_string = ""},
+        {.group_code = 440, .type = DXF_SCHEMA_LONG, .offset = offsetof (DxfPoint, transparency), .min_version = AutoCAD_2004, .flags = DXF_SCHEMA_SKIP_DEFAULT},
+        {.group_code = 390, .type = DXF_SCHEMA_STRING, .offset = offsetof (DxfPoint, plot_style_name), .min_version = AutoCAD_2009, .flags = DXF_SCHEMA_SKIP_DEFAULT, .default_string = ""},
+        {.group_code = 284, .type = DXF_SCHEMA_INT16, .offset = offsetof (DxfPoint, shadow_mode), .min_version = AutoCAD_2009, .flags = DXF_SCHEMA_SKIP_DEFAULT},
+        {.group_code = 100, .type = DXF_SCHEMA_SUBCLASS, .min_version = AutoCAD_13, .default_string = "AcDbPoint"},
+        {.group_code = 10, .type = DXF_SCHEMA_POINT, .offset = offsetof (DxfPoint, x0)},
+        {.group_code = 39, .type = DXF_SCHEMA_DOUBLE, .offset = offsetof (DxfPoint, thickness), .flags = DXF_SCHEMA_SKIP_DEFAULT},
+        {.group_code = 210, .type = DXF_SCHEMA_POINT, .offset = offsetof (DxfPoint, extr_x0), .min_version = AutoCAD_12, .flags = DXF_SCHEMA_SKIP_DEFAULT, .default_double = {0.0, 0.0, 1.0}},
+        {.group_code = 50, .type = DXF_SCHEMA_DOUBLE, .offset = offsetof (DxfPoint, angle_to_X)}
+};
+
+
+/*!
+ * \brief Schema of a DXF \c POINT entity.
+ */
+static const DxfSchema dxf_point_schema =
+{
+        "POINT",
+        POINT,
+        dxf_point_schema_fields,
+        sizeof (dxf_point_schema_fields) / sizeof (dxf_point_schema_fields[0])
+};
 
 
 /*!
@@ -86,6 +142,7 @@ dxf_point_new ()
         else
         {
                 memset (point, 0, size);
+                dxf_stats_count_allocation (POINT, size);
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -126,8 +183,10 @@ dxf_point_init
                 return (NULL);
         }
         point->id_code = 0;
-        point->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        point->layer = strdup (DXF_DEFAULT_LAYER);
+        /* Default strings are shared, they are not copied until a
+         * different value is set. */
+        point->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        point->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         point->x0 = 0.0;
         point->y0 = 0.0;
         point->z0 = 0.0;
@@ -138,11 +197,20 @@ dxf_point_init
         point->visibility = DXF_DEFAULT_VISIBILITY;
         point->color = DXF_COLOR_BYLAYER;
         point->paperspace = DXF_MODELSPACE;
+        point->graphics_data_size = 0;
+        point->shadow_mode = 0;
+        point->binary_graphics_data = NULL;
         point->extr_x0 = 0.0;
         point->extr_y0 = 0.0;
-        point->extr_z0 = 0.0;
-        point->dictionary_owner_soft = strdup ("");
-        point->dictionary_owner_hard = strdup ("");
+        point->extr_z0 = 1.0;
+        point->dictionary_owner_soft = dxf_string_share ("");
+        point->material = dxf_string_share ("");
+        point->dictionary_owner_hard = dxf_string_share ("");
+        point->lineweight = 0;
+        point->plot_style_name = dxf_string_share ("");
+        point->color_value = 0;
+        point->color_name = dxf_string_share ("");
+        point->transparency = 0;
         point->next = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -160,8 +228,7 @@ dxf_point_init
  * \c ENTITY section marker \c ENDSEC. \n
  * While parsing the DXF file store data in \c point. \n
  *
- * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
- * occurred.
+ * \return a pointer to \c point, or \c NULL when an error occurred.
  */
 DxfPoint *
 dxf_point_read
@@ -175,16 +242,12 @@ dxf_point_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
-
         /* Do some basic checks. */
         if (fp == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (point == NULL)
@@ -195,187 +258,20 @@ dxf_point_read
                 point = dxf_point_new ();
                 point = dxf_point_init (point);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
-        {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &point->id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", point->linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", point->layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &point->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &point->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &point->z0);
-                }
-                else if ((fp->acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0)
-                        && (point->elevation != 0.0))
-                {
-                        /* Now follows a string containing the
-                         * elevation. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &point->elevation);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &point->thickness);
-                }
-                else if (strcmp (temp_string, "48") == 0)
-                {
-                        /* Now follows a string containing the linetype
-                         * scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &point->linetype_scale);
-                }
-                else if (strcmp (temp_string, "50") == 0)
-                {
-                        /* Now follows a string containing the
-                         * start angle. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &point->angle_to_X);
-                }
-                else if (strcmp (temp_string, "60") == 0)
-                {
-                        /* Now follows a string containing the
-                         * visibility value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &point->visibility);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &point->color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &point->paperspace);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if ((strcmp (temp_string, "AcDbEntity") != 0)
-                        && ((strcmp (temp_string, "AcDbPoint") != 0)))
-                        {
-                                fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "210") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &point->extr_x0);
-                }
-                else if (strcmp (temp_string, "220") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &point->extr_y0);
-                }
-                else if (strcmp (temp_string, "230") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &point->extr_z0);
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", point->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", point->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning: in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                }
+        if (dxf_schema_read (fp, &dxf_point_schema, point) != EXIT_SUCCESS)
+        {
+                fclose (fp->fp);
+                return (NULL);
         }
         /* Handle omitted members and/or illegal values. */
-        if (strcmp (point->linetype, "") == 0)
+        if ((point->linetype == NULL) || (strcmp (point->linetype, "") == 0))
         {
-                point->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_point_set_linetype (point, DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (point->layer, "") == 0)
+        if ((point->layer == NULL) || (strcmp (point->layer, "") == 0))
         {
-                point->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_point_set_layer (point, DXF_DEFAULT_LAYER);
         }
-        /* Clean up. */
-        free (temp_string);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -422,7 +318,7 @@ dxf_point_write
                 free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
-        if (strcmp (point->linetype, "") == 0)
+        if ((point->linetype == NULL) || (strcmp (point->linetype, "") == 0))
         {
                 fprintf (stderr,
                   (_("Warning in %s () empty linetype string for the %s entity with id-code: %x\n")),
@@ -430,9 +326,9 @@ dxf_point_write
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                point->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_point_set_linetype (point, DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (point->layer, "") == 0)
+        if ((point->layer == NULL) || (strcmp (point->layer, "") == 0))
         {
                 fprintf (stderr,
                   (_("Warning in %s () empty layer string for the %s entity with id-code: %x\n")),
@@ -441,90 +337,15 @@ dxf_point_write
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0")),
                   dxf_entity_name);
-                point->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_point_set_layer (point, DXF_DEFAULT_LAYER);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
-        if (point->id_code != -1)
-        {
-                fprintf (fp->fp, "  5\n%x\n", point->id_code);
-        }
-        /*!
-         * \todo for version R14.\n
-         * Implementing the start of application-defined group
-         * "{application_name", with Group code 102.\n
-         * For example: "{ACAD_REACTORS" indicates the start of the
-         * AutoCAD persistent reactors group.\n\n
-         * application-defined codes: Group codes and values within the
-         * 102 groups are application defined (optional).\n\n
-         * End of group, "}" (optional), with Group code 102.
-         */
-        if ((strcmp (point->dictionary_owner_soft, "") != 0)
-          && (fp->acad_version_number >= AutoCAD_14))
-        {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", point->dictionary_owner_soft);
-                fprintf (fp->fp, "102\n}\n");
-        }
-        if ((strcmp (point->dictionary_owner_hard, "") != 0)
-          && (fp->acad_version_number >= AutoCAD_14))
-        {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", point->dictionary_owner_hard);
-                fprintf (fp->fp, "102\n}\n");
-        }
-        if (fp->acad_version_number >= AutoCAD_13)
-        {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
-        }
-        if (point->paperspace == DXF_PAPERSPACE)
-        {
-                fprintf (fp->fp, " 67\n%d\n", DXF_PAPERSPACE);
-        }
-        fprintf (fp->fp, "  8\n%s\n", point->layer);
-        if (strcmp (point->linetype, DXF_DEFAULT_LINETYPE) != 0)
-        {
-                fprintf (fp->fp, "  6\n%s\n", point->linetype);
-        }
-        if ((fp->acad_version_number <= AutoCAD_11)
-          && DXF_FLATLAND
-          && (point->elevation != 0.0))
-        {
-                fprintf (fp->fp, " 38\n%f\n", point->elevation);
-        }
-        if (point->color != DXF_COLOR_BYLAYER)
-        {
-                fprintf (fp->fp, " 62\n%d\n", point->color);
-        }
-        if (point->linetype_scale != 1.0)
-        {
-                fprintf (fp->fp, " 48\n%f\n", point->linetype_scale);
-        }
-        if (point->visibility != 0)
-        {
-                fprintf (fp->fp, " 60\n%d\n", point->visibility);
-        }
-        if (fp->acad_version_number >= AutoCAD_13)
+        if (dxf_schema_write (fp, &dxf_point_schema, point) != EXIT_SUCCESS)
         {
-                fprintf (fp->fp, "100\nAcDbPoint\n");
-        }
-        fprintf (fp->fp, " 10\n%f\n", point->x0);
-        fprintf (fp->fp, " 20\n%f\n", point->y0);
-        fprintf (fp->fp, " 30\n%f\n", point->z0);
-        if (point->thickness != 0.0)
-        {
-                fprintf (fp->fp, " 39\n%f\n", point->thickness);
-        }
-        if ((fp->acad_version_number >= AutoCAD_12)
-                && (point->extr_x0 != 0.0)
-                && (point->extr_y0 != 0.0)
-                && (point->extr_z0 != 1.0))
-        {
-                fprintf (fp->fp, "210\n%f\n", point->extr_x0);
-                fprintf (fp->fp, "220\n%f\n", point->extr_y0);
-                fprintf (fp->fp, "230\n%f\n", point->extr_z0);
+                /* Clean up. */
+                free (dxf_entity_name);
+                return (EXIT_FAILURE);
         }
-        fprintf (fp->fp, " 50\n%f\n", point->angle_to_X);
         /* Clean up. */
         free (dxf_entity_name);
 #if DEBUG
@@ -567,10 +388,17 @@ dxf_point_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (point->linetype);
-        free (point->layer);
-        free (point->dictionary_owner_soft);
-        free (point->dictionary_owner_hard);
+        dxf_string_free (point->linetype);
+        dxf_string_free (point->layer);
+        if (point->binary_graphics_data != NULL)
+        {
+                dxf_binary_graphics_data_free_list (point->binary_graphics_data);
+        }
+        dxf_string_free (point->dictionary_owner_soft);
+        dxf_string_free (point->material);
+        dxf_string_free (point->dictionary_owner_hard);
+        dxf_string_free (point->plot_style_name);
+        dxf_string_free (point->color_name);
         free (point);
         point = NULL;
 #if DEBUG
@@ -754,6 +582,8 @@ dxf_point_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (point == NULL)
         {
@@ -769,7 +599,13 @@ dxf_point_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        point->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (point->linetype);
+        point->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -835,6 +671,8 @@ dxf_point_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (point == NULL)
         {
@@ -850,7 +688,13 @@ dxf_point_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        point->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (point->layer);
+        point->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1697,6 +1541,8 @@ dxf_point_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (point == NULL)
         {
@@ -1712,7 +1558,13 @@ dxf_point_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        point->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (point->dictionary_owner_soft);
+        point->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1782,6 +1634,8 @@ dxf_point_set_material
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (point == NULL)
         {
@@ -1797,7 +1651,13 @@ dxf_point_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        point->material = strdup (material);
+        copy = dxf_string_share (material);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (point->material);
+        point->material = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1868,6 +1728,8 @@ dxf_point_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (point == NULL)
         {
@@ -1883,7 +1745,13 @@ dxf_point_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        point->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (point->dictionary_owner_hard);
+        point->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2019,6 +1887,8 @@ dxf_point_set_plot_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (point == NULL)
         {
@@ -2034,7 +1904,13 @@ dxf_point_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        point->plot_style_name = strdup (plot_style_name);
+        copy = dxf_string_share (plot_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (point->plot_style_name);
+        point->plot_style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2170,6 +2046,8 @@ dxf_point_set_color_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (point == NULL)
         {
@@ -2185,7 +2063,13 @@ dxf_point_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        point->color_name = strdup (color_name);
+        copy = dxf_string_share (color_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (point->color_name);
+        point->color_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
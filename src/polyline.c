@@ -42,6 +42,11 @@
 
 
 #include "polyline.h"
+#include "stats.h"
+#include "util.h"
+
+
+static void dxf_polyline_sync_vertex_list (DxfPolyline *polyline);
 
 
 /*!
@@ -71,6 +76,7 @@ dxf_polyline_new ()
         else
         {
                 memset (polyline, 0, size);
+                dxf_stats_count_allocation (POLYLINE, size);
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -111,8 +117,8 @@ dxf_polyline_init
               return (NULL);
         }
         dxf_polyline_set_id_code (polyline, 0);
-        dxf_polyline_set_linetype (polyline, strdup (DXF_DEFAULT_LINETYPE));
-        dxf_polyline_set_layer (polyline, strdup (DXF_DEFAULT_LAYER));
+        polyline->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        polyline->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         dxf_polyline_set_elevation (polyline, 0.0);
         dxf_polyline_set_thickness (polyline, 0.0);
         dxf_polyline_set_linetype_scale (polyline, DXF_DEFAULT_LINETYPE_SCALE);
@@ -121,14 +127,14 @@ dxf_polyline_init
         dxf_polyline_set_paperspace (polyline, DXF_MODELSPACE);
         dxf_polyline_set_graphics_data_size (polyline, 0);
         dxf_polyline_set_shadow_mode (polyline, 0);
-        dxf_polyline_set_binary_graphics_data (polyline, (DxfBinaryGraphicsData *) dxf_binary_graphics_data_new ());
-        dxf_polyline_set_dictionary_owner_soft (polyline, strdup (""));
-        dxf_polyline_set_material (polyline, strdup (""));
-        dxf_polyline_set_dictionary_owner_hard (polyline, strdup (""));
+        polyline->binary_graphics_data = NULL;
+        polyline->dictionary_owner_soft = dxf_string_share ("");
+        polyline->material = dxf_string_share ("");
+        polyline->dictionary_owner_hard = dxf_string_share ("");
         dxf_polyline_set_lineweight (polyline, 0);
-        dxf_polyline_set_plot_style_name (polyline, strdup (""));
+        polyline->plot_style_name = dxf_string_share ("");
         dxf_polyline_set_color_value (polyline, 0);
-        dxf_polyline_set_color_name (polyline, strdup (""));
+        polyline->color_name = dxf_string_share ("");
         dxf_polyline_set_transparency (polyline, 0);
         dxf_polyline_set_p0 (polyline, (DxfPoint *) dxf_point_new ());
         dxf_point_init ((DxfPoint *) dxf_polyline_get_p0 (polyline));
@@ -227,14 +233,12 @@ dxf_polyline_read
                 {
                         /* Now follows a string containing a linetype
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", polyline->linetype);
+                        dxf_read_string (fp, &polyline->linetype);
                 }
                 else if (strcmp (temp_string, "8") == 0)
                 {
                         /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", polyline->layer);
+                        dxf_read_string (fp, &polyline->layer);
                 }
                 else if (strcmp (temp_string, "10") == 0)
                 {
@@ -397,15 +401,13 @@ dxf_polyline_read
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", polyline->dictionary_owner_soft);
+                        dxf_read_string (fp, &polyline->dictionary_owner_soft);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", polyline->dictionary_owner_hard);
+                        dxf_read_string (fp, &polyline->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "999") == 0)
                 {
@@ -675,16 +677,20 @@ dxf_polyline_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (dxf_polyline_get_linetype (polyline));
-        free (dxf_polyline_get_layer (polyline));
-        dxf_binary_graphics_data_free_list (dxf_polyline_get_binary_graphics_data (polyline));
-        free (dxf_polyline_get_dictionary_owner_soft (polyline));
-        free (dxf_polyline_get_material (polyline));
-        free (dxf_polyline_get_dictionary_owner_hard (polyline));
-        free (dxf_polyline_get_plot_style_name (polyline));
-        free (dxf_polyline_get_color_name (polyline));
+        dxf_string_free (polyline->linetype);
+        dxf_string_free (polyline->layer);
+        if (polyline->binary_graphics_data != NULL)
+        {
+                dxf_binary_graphics_data_free_list (polyline->binary_graphics_data);
+        }
+        dxf_string_free (polyline->dictionary_owner_soft);
+        dxf_string_free (polyline->material);
+        dxf_string_free (polyline->dictionary_owner_hard);
+        dxf_string_free (polyline->plot_style_name);
+        dxf_string_free (polyline->color_name);
         dxf_point_free (dxf_polyline_get_p0 (polyline));
         dxf_vertex_free_list (dxf_polyline_get_vertices (polyline));
+        dxf_list_clear (&polyline->vertex_list);
         free (polyline);
         polyline = NULL;
 #if DEBUG
@@ -864,6 +870,8 @@ dxf_polyline_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (polyline == NULL)
         {
@@ -879,7 +887,13 @@ dxf_polyline_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        polyline->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (polyline->linetype);
+        polyline->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -945,6 +959,8 @@ dxf_polyline_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (polyline == NULL)
         {
@@ -960,7 +976,13 @@ dxf_polyline_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        polyline->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (polyline->layer);
+        polyline->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1768,6 +1790,8 @@ dxf_polyline_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (polyline == NULL)
         {
@@ -1783,7 +1807,13 @@ dxf_polyline_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        polyline->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (polyline->dictionary_owner_soft);
+        polyline->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1852,6 +1882,8 @@ dxf_polyline_set_material
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (polyline == NULL)
         {
@@ -1867,7 +1899,13 @@ dxf_polyline_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        polyline->material = strdup (material);
+        copy = dxf_string_share (material);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (polyline->material);
+        polyline->material = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1935,6 +1973,8 @@ dxf_polyline_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (polyline == NULL)
         {
@@ -1950,7 +1990,13 @@ dxf_polyline_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        polyline->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (polyline->dictionary_owner_hard);
+        polyline->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2080,6 +2126,8 @@ dxf_polyline_set_plot_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (polyline == NULL)
         {
@@ -2095,7 +2143,13 @@ dxf_polyline_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        polyline->plot_style_name = strdup (plot_style_name);
+        copy = dxf_string_share (plot_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (polyline->plot_style_name);
+        polyline->plot_style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2225,6 +2279,8 @@ dxf_polyline_set_color_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (polyline == NULL)
         {
@@ -2240,7 +2296,13 @@ dxf_polyline_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        polyline->color_name = strdup (color_name);
+        copy = dxf_string_share (color_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (polyline->color_name);
+        polyline->color_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -3624,6 +3686,122 @@ dxf_polyline_set_vertices
 }
 
 
+/*!
+ * \brief Append a vertex to the linked list of \c vertices of a DXF
+ * \c POLYLINE entity.
+ *
+ * The vertex is linked after the last vertex without walking the list,
+ * the \c next member of the vertex is set to \c NULL.
+ *
+ * \return a pointer to the DXF \c POLYLINE entity when OK, \c NULL when
+ * an error occurred.
+ */
+DxfPolyline *
+dxf_polyline_append_vertex
+(
+        DxfPolyline *polyline,
+                /*!< a pointer to a DXF \c POLYLINE entity. */
+        DxfVertex *vertex
+                /*!< a pointer to the vertex. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (polyline == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        if (vertex == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        dxf_polyline_sync_vertex_list (polyline);
+        if (dxf_list_append (&polyline->vertex_list, vertex) != EXIT_SUCCESS)
+        {
+                return (NULL);
+        }
+        polyline->vertices = (DxfVertex *) dxf_list_get_head (&polyline->vertex_list);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (polyline);
+}
+
+
+/*!
+ * \brief Get the number of \c vertices of a DXF \c POLYLINE entity.
+ *
+ * \return the number of vertices, or -1 when an error occurred.
+ */
+int
+dxf_polyline_get_number_of_vertices
+(
+        DxfPolyline *polyline
+                /*!< a pointer to a DXF \c POLYLINE entity. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (polyline == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (-1);
+        }
+        dxf_polyline_sync_vertex_list (polyline);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (dxf_list_get_number_of_items (&polyline->vertex_list));
+}
+
+
+/*!
+ * \brief Get the vertex at a position in the linked list of
+ * \c vertices of a DXF \c POLYLINE entity.
+ *
+ * \return a pointer to the vertex, \c NULL when the position is out of
+ * range or an error occurred.
+ */
+DxfVertex *
+dxf_polyline_get_vertex
+(
+        DxfPolyline *polyline,
+                /*!< a pointer to a DXF \c POLYLINE entity. */
+        int position
+                /*!< position of the vertex, starting at 0. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (polyline == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        dxf_polyline_sync_vertex_list (polyline);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return ((DxfVertex *) dxf_list_get_item (&polyline->vertex_list, position));
+}
+
+
 /*!
  * \brief Get the pointer to the next \c POLYLINE entity from a DXF 
  * \c POLYLINE entity.
@@ -3748,4 +3926,27 @@ dxf_polyline_get_last
 }
 
 
+/*!
+ * \brief Let the list container of a DXF \c POLYLINE entity take over
+ * the linked list of \c vertices when it was linked by other means,
+ * e.g. with dxf_polyline_set_vertices ().
+ */
+static void
+dxf_polyline_sync_vertex_list
+(
+        DxfPolyline *polyline
+                /*!< a pointer to a DXF \c POLYLINE entity. */
+)
+{
+        if (polyline->vertex_list.next_offset == 0)
+        {
+                dxf_list_init (&polyline->vertex_list, offsetof (DxfVertex, next));
+        }
+        if (polyline->vertices != dxf_list_get_head (&polyline->vertex_list))
+        {
+                dxf_list_set_head (&polyline->vertex_list, polyline->vertices);
+        }
+}
+
+
 /* EOF */
@@ -45,6 +45,7 @@
 
 #include "global.h"
 #include "binary_graphics_data.h"
+#include "list.h"
 #include "vertex.h"
 #include "point.h"
 
@@ -301,6 +302,9 @@ dxf_polyline_struct
                  * \c NULL in the last DxfVertex.\n
                  * \note Not all members of the DxfVertex struct are
                  * used for polylines. */
+        DxfList vertex_list;
+                /*!< List container for the \c vertices, for O(1)
+                 * appends and random access. */
         struct DxfPolyline *next;
                 /*!< pointer to the next DxfPolyline.\n
                  * \c NULL in the last DxfPolyline. */
@@ -387,6 +391,9 @@ double dxf_polyline_get_extr_z0 (DxfPolyline *polyline);
 DxfPolyline *dxf_polyline_set_extr_z0 (DxfPolyline *polyline, double extr_z0);
 DxfVertex *dxf_polyline_get_vertices (DxfPolyline *polyline);
 DxfPolyline *dxf_polyline_set_vertices (DxfPolyline *polyline, DxfVertex *vertices);
+DxfPolyline *dxf_polyline_append_vertex (DxfPolyline *polyline, DxfVertex *vertex);
+int dxf_polyline_get_number_of_vertices (DxfPolyline *polyline);
+DxfVertex *dxf_polyline_get_vertex (DxfPolyline *polyline, int position);
 DxfPolyline *dxf_polyline_get_next (DxfPolyline *polyline);
 DxfPolyline *dxf_polyline_set_next (DxfPolyline *polyline, DxfPolyline *next);
 DxfPolyline *dxf_polyline_get_last (DxfPolyline *polyline);
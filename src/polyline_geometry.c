@@ -0,0 +1,1567 @@
+/*!
+ * \file polyline_geometry.c
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Functions for geometric operations on DXF polylines
+ * (\c LWPOLYLINE and \c POLYLINE).
+ *
+ * The polyline vertices are copied once into contiguous arrays, after
+ * which the length, area and centroid are computed in a single pass
+ * each, taking bulged (arc) segments into account exactly.\n
+ * The test for self intersections sorts the (flattened) segments on
+ * their lowest X-coordinate and sweeps over them, only segments with
+ * overlapping X-ranges are tested against each other.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include <pthread.h>
+
+#include "polyline_geometry.h"
+
+
+/*!
+ * \brief Bounding box of a segment in the test for self
+ * intersections.
+ */
+typedef struct
+dxf_polyline_geometry_segment_struct
+{
+        double min_x;
+                /*!< Lowest X-coordinate of the segment. */
+        double max_x;
+                /*!< Highest X-coordinate of the segment. */
+        double min_y;
+                /*!< Lowest Y-coordinate of the segment. */
+        double max_y;
+                /*!< Highest Y-coordinate of the segment. */
+} DxfPolylineGeometrySegment;
+
+
+/*!
+ * \brief Uniform grid over the segments of a flattened polyline, in
+ * compressed sparse row layout.
+ */
+typedef struct
+dxf_polyline_geometry_grid_struct
+{
+        double min_x;
+                /*!< X-coordinate of the lower left corner of the grid. */
+        double min_y;
+                /*!< Y-coordinate of the lower left corner of the grid. */
+        double cell_width;
+                /*!< Width of a cell. */
+        double cell_height;
+                /*!< Height of a cell. */
+        int number_of_columns;
+                /*!< Number of columns of cells. */
+        int number_of_rows;
+                /*!< Number of rows of cells. */
+        int *cell_start;
+                /*!< Index in \c cell_segments of the first segment of
+                 * every cell, followed by the total number of
+                 * entries. */
+        int *cell_segments;
+                /*!< Segments overlapping the cells, cell after
+                 * cell. */
+} DxfPolylineGeometryGrid;
+
+
+/*!
+ * \brief Work item for a thread in a batch computation.
+ */
+typedef struct
+dxf_polyline_geometry_job_struct
+{
+        void **entities;
+                /*!< Array of pointers to the entities. */
+        int is_lwpolyline;
+                /*!< \c TRUE for \c LWPOLYLINE entities, \c FALSE for
+                 * \c POLYLINE entities. */
+        double tolerance;
+                /*!< Tolerance for flattening bulged segments. */
+        DxfPolylineGeometryResult *results;
+                /*!< Array receiving the results. */
+        int begin;
+                /*!< First entity of this job. */
+        int end;
+                /*!< One past the last entity of this job. */
+} DxfPolylineGeometryJob;
+
+
+static double dxf_polyline_geometry_orientation (double ax, double ay, double bx, double by, double cx, double cy);
+static int dxf_polyline_geometry_segments_intersect (DxfFlattenBuffer *buffer, int i, int j, int is_adjacent);
+static int dxf_polyline_geometry_grid_build (DxfPolylineGeometryGrid *grid, DxfPolylineGeometrySegment *segments, int number_of_segments, double mean_width, double mean_height);
+static void dxf_polyline_geometry_grid_get_cells (DxfPolylineGeometryGrid *grid, DxfPolylineGeometrySegment *segment, int *first_column, int *first_row, int *last_column, int *last_row);
+static int dxf_polyline_geometry_grid_get_cell (double value, double origin, double size, int number_of_cells);
+static int dxf_polyline_geometry_compute_list (void **entities, int number_of_entities, int is_lwpolyline, double tolerance, DxfPolylineGeometryResult *results, int number_of_threads);
+static void *dxf_polyline_geometry_run_job (void *data);
+
+
+/*!
+ * \brief Allocate memory for a \c DxfPolylineGeometry.
+ *
+ * Fill the memory contents with zeros.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfPolylineGeometry *
+dxf_polyline_geometry_new ()
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfPolylineGeometry *geometry = NULL;
+        size_t size;
+
+        size = sizeof (DxfPolylineGeometry);
+        /* avoid malloc of 0 bytes */
+        if (size == 0) size = 1;
+        if ((geometry = malloc (size)) == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                geometry = NULL;
+        }
+        else
+        {
+                memset (geometry, 0, size);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (geometry);
+}
+
+
+/*!
+ * \brief Allocate memory and initialize data fields in a
+ * \c DxfPolylineGeometry.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfPolylineGeometry *
+dxf_polyline_geometry_init
+(
+        DxfPolylineGeometry *geometry,
+                /*!< a pointer to the polyline geometry. */
+        int max_number_of_vertices
+                /*!< the number of vertices to allocate room for. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (geometry == NULL)
+        {
+                fprintf (stderr,
+                  (_("Warning in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                geometry = dxf_polyline_geometry_new ();
+        }
+        if (geometry == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        geometry->x = NULL;
+        geometry->y = NULL;
+        geometry->bulge = NULL;
+        geometry->number_of_vertices = 0;
+        geometry->max_number_of_vertices = 0;
+        geometry->is_closed = FALSE;
+        if (dxf_polyline_geometry_reserve (geometry, max_number_of_vertices) != EXIT_SUCCESS)
+        {
+                dxf_polyline_geometry_free (geometry);
+                return (NULL);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (geometry);
+}
+
+
+/*!
+ * \brief Grow the vertex arrays of a \c DxfPolylineGeometry.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_polyline_geometry_reserve
+(
+        DxfPolylineGeometry *geometry,
+                /*!< a pointer to the polyline geometry. */
+        int max_number_of_vertices
+                /*!< the number of vertices to allocate room for. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        double *x = NULL;
+        double *y = NULL;
+        double *bulge = NULL;
+
+        /* Do some basic checks. */
+        if (geometry == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (max_number_of_vertices <= geometry->max_number_of_vertices)
+        {
+                return (EXIT_SUCCESS);
+        }
+        x = realloc (geometry->x, max_number_of_vertices * sizeof (double));
+        if (x != NULL)
+        {
+                geometry->x = x;
+        }
+        y = realloc (geometry->y, max_number_of_vertices * sizeof (double));
+        if (y != NULL)
+        {
+                geometry->y = y;
+        }
+        bulge = realloc (geometry->bulge, max_number_of_vertices * sizeof (double));
+        if (bulge != NULL)
+        {
+                geometry->bulge = bulge;
+        }
+        if ((x == NULL) || (y == NULL) || (bulge == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        geometry->max_number_of_vertices = max_number_of_vertices;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Free the allocated memory for a \c DxfPolylineGeometry and
+ * its arrays.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_polyline_geometry_free
+(
+        DxfPolylineGeometry *geometry
+                /*!< a pointer to the polyline geometry. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        if (geometry == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        free (geometry->x);
+        free (geometry->y);
+        free (geometry->bulge);
+        free (geometry);
+        geometry = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Copy the vertices of a DXF \c LWPOLYLINE entity into a
+ * \c DxfPolylineGeometry.
+ *
+ * A closing vertex coinciding with the first vertex of a closed
+ * lwpolyline is dropped.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_polyline_geometry_from_lwpolyline
+(
+        DxfPolylineGeometry *geometry,
+                /*!< a pointer to the polyline geometry. */
+        DxfLWPolyline *lwpolyline
+                /*!< a pointer to a DXF \c LWPOLYLINE entity. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfVertex *iter = NULL;
+        int n;
+
+        /* Do some basic checks. */
+        if ((geometry == NULL) || (lwpolyline == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        n = 0;
+        geometry->number_of_vertices = 0;
+        geometry->is_closed = DXF_CHECK_BIT (lwpolyline->flag, 0) ? TRUE : FALSE;
+        iter = (DxfVertex *) lwpolyline->vertices;
+        while ((iter != NULL) && (iter->p0 != NULL))
+        {
+                /* The number of vertices, when known, takes precedence
+                 * over a trailing empty vertex in the list. */
+                if ((lwpolyline->number_vertices > 0)
+                  && (n >= lwpolyline->number_vertices))
+                {
+                        break;
+                }
+                if (n >= geometry->max_number_of_vertices)
+                {
+                        if (dxf_polyline_geometry_reserve (geometry, (n < 8) ? 16 : 2 * n) != EXIT_SUCCESS)
+                        {
+                                return (EXIT_FAILURE);
+                        }
+                }
+                geometry->x[n] = iter->p0->x0;
+                geometry->y[n] = iter->p0->y0;
+                geometry->bulge[n] = iter->bulge;
+                n++;
+                iter = (DxfVertex *) iter->next;
+        }
+        if (geometry->is_closed
+          && (n > 1)
+          && (geometry->x[n - 1] == geometry->x[0])
+          && (geometry->y[n - 1] == geometry->y[0]))
+        {
+                n--;
+        }
+        geometry->number_of_vertices = n;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Copy the vertices of a 2D DXF \c POLYLINE entity into a
+ * \c DxfPolylineGeometry.
+ *
+ * Spline frame control points (vertex flag bit 16) are skipped, a
+ * closing vertex coinciding with the first vertex of a closed polyline
+ * is dropped.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_polyline_geometry_from_polyline
+(
+        DxfPolylineGeometry *geometry,
+                /*!< a pointer to the polyline geometry. */
+        DxfPolyline *polyline
+                /*!< a pointer to a DXF \c POLYLINE entity. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfVertex *iter = NULL;
+        int n;
+
+        /* Do some basic checks. */
+        if ((geometry == NULL) || (polyline == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (DXF_CHECK_BIT (polyline->flag, 4)
+          || DXF_CHECK_BIT (polyline->flag, 6))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a polygon mesh or polyface mesh was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        n = 0;
+        geometry->number_of_vertices = 0;
+        geometry->is_closed = DXF_CHECK_BIT (polyline->flag, 0) ? TRUE : FALSE;
+        iter = polyline->vertices;
+        while (iter != NULL)
+        {
+                if ((iter->p0 == NULL) || DXF_CHECK_BIT (iter->flag, 4))
+                {
+                        iter = (DxfVertex *) iter->next;
+                        continue;
+                }
+                if (n >= geometry->max_number_of_vertices)
+                {
+                        if (dxf_polyline_geometry_reserve (geometry, (n < 8) ? 16 : 2 * n) != EXIT_SUCCESS)
+                        {
+                                return (EXIT_FAILURE);
+                        }
+                }
+                geometry->x[n] = iter->p0->x0;
+                geometry->y[n] = iter->p0->y0;
+                geometry->bulge[n] = iter->bulge;
+                n++;
+                iter = (DxfVertex *) iter->next;
+        }
+        if (geometry->is_closed
+          && (n > 1)
+          && (geometry->x[n - 1] == geometry->x[0])
+          && (geometry->y[n - 1] == geometry->y[0]))
+        {
+                n--;
+        }
+        geometry->number_of_vertices = n;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Get the length of a \c DxfPolylineGeometry.
+ *
+ * A bulged segment contributes the length of its arc
+ * <tt>r * |theta|</tt>, with <tt>theta = 4 * atan (bulge)</tt>.
+ *
+ * \return the length, including the closing segment of a closed
+ * polyline.
+ */
+double
+dxf_polyline_geometry_get_length
+(
+        DxfPolylineGeometry *geometry
+                /*!< a pointer to the polyline geometry. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        double length;
+        double chord;
+        double b;
+        int number_of_segments;
+        int i;
+        int j;
+
+        /* Do some basic checks. */
+        if (geometry == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (0.0);
+        }
+        number_of_segments = geometry->is_closed
+          ? geometry->number_of_vertices : geometry->number_of_vertices - 1;
+        length = 0.0;
+        for (i = 0; i < number_of_segments; i++)
+        {
+                j = (i + 1 == geometry->number_of_vertices) ? 0 : i + 1;
+                chord = hypot (geometry->x[j] - geometry->x[i],
+                  geometry->y[j] - geometry->y[i]);
+                b = geometry->bulge[i];
+                if (b == 0.0)
+                {
+                        length += chord;
+                }
+                else
+                {
+                        /* radius * included angle. */
+                        length += (chord * (1.0 + (b * b)) / (4.0 * fabs (b)))
+                          * fabs (4.0 * atan (b));
+                }
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (length);
+}
+
+
+/*!
+ * \brief Get the signed enclosed area of a \c DxfPolylineGeometry.
+ *
+ * The shoelace formula over the chords, corrected with the signed area
+ * of the circular segment between each bulged segment and its chord,
+ * <tt>r^2 / 2 * (theta - sin (theta))</tt>.\n
+ * An open polyline is taken as closed.
+ *
+ * \return the area, positive for counterclockwise polylines.
+ */
+double
+dxf_polyline_geometry_get_signed_area
+(
+        DxfPolylineGeometry *geometry
+                /*!< a pointer to the polyline geometry. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        double area;
+        double chord;
+        double radius;
+        double theta;
+        double b;
+        int i;
+        int j;
+
+        /* Do some basic checks. */
+        if (geometry == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (0.0);
+        }
+        area = 0.0;
+        for (i = 0; i < geometry->number_of_vertices; i++)
+        {
+                j = (i + 1 == geometry->number_of_vertices) ? 0 : i + 1;
+                area += ((geometry->x[i] * geometry->y[j])
+                  - (geometry->x[j] * geometry->y[i])) / 2.0;
+                b = geometry->bulge[i];
+                /* The closing segment of an open polyline is straight. */
+                if ((b != 0.0) && (geometry->is_closed || (j != 0)))
+                {
+                        chord = hypot (geometry->x[j] - geometry->x[i],
+                          geometry->y[j] - geometry->y[i]);
+                        radius = chord * (1.0 + (b * b)) / (4.0 * fabs (b));
+                        theta = 4.0 * atan (b);
+                        area += radius * radius * (theta - sin (theta)) / 2.0;
+                }
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (area);
+}
+
+
+/*!
+ * \brief Get the centroid of the enclosed area of a
+ * \c DxfPolylineGeometry.
+ *
+ * The first moments of the chord polygon and of the circular segments
+ * of the bulged segments are summed and divided by the total area.\n
+ * A circular segment with half angle \c a has its centroid at
+ * <tt>4 * r * sin^3 (a) / (3 * (2 * a - sin (2 * a)))</tt> from the
+ * center of the arc, towards the middle of the arc.\n
+ * An open polyline is taken as closed.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred or the area is zero.
+ */
+int
+dxf_polyline_geometry_get_centroid
+(
+        DxfPolylineGeometry *geometry,
+                /*!< a pointer to the polyline geometry. */
+        double *x,
+                /*!< receives the X-coordinate of the centroid. */
+        double *y
+                /*!< receives the Y-coordinate of the centroid. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        double area;
+        double moment_x;
+        double moment_y;
+        double cross;
+        double dx;
+        double dy;
+        double chord;
+        double radius;
+        double theta;
+        double alpha;
+        double offset;
+        double cx;
+        double cy;
+        double mx;
+        double my;
+        double distance;
+        double segment_area;
+        double b;
+        int i;
+        int j;
+
+        /* Do some basic checks. */
+        if ((geometry == NULL) || (x == NULL) || (y == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        area = 0.0;
+        moment_x = 0.0;
+        moment_y = 0.0;
+        for (i = 0; i < geometry->number_of_vertices; i++)
+        {
+                j = (i + 1 == geometry->number_of_vertices) ? 0 : i + 1;
+                cross = (geometry->x[i] * geometry->y[j])
+                  - (geometry->x[j] * geometry->y[i]);
+                area += cross / 2.0;
+                moment_x += (geometry->x[i] + geometry->x[j]) * cross / 6.0;
+                moment_y += (geometry->y[i] + geometry->y[j]) * cross / 6.0;
+                b = geometry->bulge[i];
+                if ((b == 0.0) || (!geometry->is_closed && (j == 0)))
+                {
+                        continue;
+                }
+                dx = geometry->x[j] - geometry->x[i];
+                dy = geometry->y[j] - geometry->y[i];
+                chord = hypot (dx, dy);
+                if (chord == 0.0)
+                {
+                        continue;
+                }
+                radius = chord * (1.0 + (b * b)) / (4.0 * fabs (b));
+                theta = 4.0 * atan (b);
+                segment_area = radius * radius * (theta - sin (theta)) / 2.0;
+                /* Center of the arc and middle of the arc. */
+                offset = (1.0 - (b * b)) / (4.0 * b);
+                cx = ((geometry->x[i] + geometry->x[j]) / 2.0) - (offset * dy);
+                cy = ((geometry->y[i] + geometry->y[j]) / 2.0) + (offset * dx);
+                mx = ((geometry->x[i] + geometry->x[j]) / 2.0) + (b * dy / 2.0);
+                my = ((geometry->y[i] + geometry->y[j]) / 2.0) - (b * dx / 2.0);
+                alpha = fabs (theta) / 2.0;
+                distance = 4.0 * radius * pow (sin (alpha), 3.0)
+                  / (3.0 * ((2.0 * alpha) - sin (2.0 * alpha)));
+                offset = hypot (mx - cx, my - cy);
+                if (offset == 0.0)
+                {
+                        continue;
+                }
+                area += segment_area;
+                moment_x += segment_area * (cx + ((mx - cx) * distance / offset));
+                moment_y += segment_area * (cy + ((my - cy) * distance / offset));
+        }
+        if (area == 0.0)
+        {
+                fprintf (stderr,
+                  (_("Warning in %s () a polyline without area was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        *x = moment_x / area;
+        *y = moment_y / area;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Test if a \c DxfPolylineGeometry is simple, that is none of
+ * its segments intersect or touch each other, other than neighbouring
+ * segments in their common vertex.
+ *
+ * Bulged segments are flattened within \c tolerance first.\n
+ * The segments are bucketed into a uniform grid with cells of about
+ * the mean segment size, and only segments sharing a cell and with
+ * overlapping bounding boxes are tested for intersection, so long runs
+ * of edges overlapping in X (serpentines, combs) do not degrade to
+ * testing every pair.
+ *
+ * \return \c TRUE when simple, \c FALSE when not simple, or
+ * \c DXF_ERROR when an error occurred.
+ */
+int
+dxf_polyline_geometry_is_simple
+(
+        DxfPolylineGeometry *geometry,
+                /*!< a pointer to the polyline geometry. */
+        double tolerance
+                /*!< tolerance for flattening bulged segments. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfFlattenBuffer *buffer = NULL;
+        DxfPolylineGeometrySegment *segments = NULL;
+        DxfPolylineGeometryGrid grid;
+        int *marks = NULL;
+        double mean_width;
+        double mean_height;
+        int number_of_segments;
+        int first_column;
+        int first_row;
+        int last_column;
+        int last_row;
+        int column;
+        int row;
+        int cell;
+        int is_adjacent;
+        int result;
+        int pass;
+        int i;
+        int j;
+        int k;
+
+        /* Do some basic checks. */
+        if (geometry == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (DXF_ERROR);
+        }
+        if (geometry->number_of_vertices < 3)
+        {
+                return (TRUE);
+        }
+        buffer = dxf_flatten_buffer_init (dxf_flatten_buffer_new (), 2 * geometry->number_of_vertices, 0);
+        if (buffer == NULL)
+        {
+                return (DXF_ERROR);
+        }
+        /* Flatten, a second pass is needed when the buffer was too
+         * small. */
+        for (pass = 0; pass < 2; pass++)
+        {
+                dxf_flatten_buffer_reset (buffer);
+                for (i = 0; i < geometry->number_of_vertices; i++)
+                {
+                        j = (i + 1 == geometry->number_of_vertices) ? 0 : i + 1;
+                        if ((j == 0) && !geometry->is_closed)
+                        {
+                                break;
+                        }
+                        dxf_flatten_bulge (geometry->x[i], geometry->y[i],
+                          geometry->x[j], geometry->y[j],
+                          geometry->bulge[i], tolerance, buffer);
+                }
+                if (!dxf_flatten_buffer_is_overflowed (buffer))
+                {
+                        break;
+                }
+                if (dxf_flatten_buffer_reserve (buffer, buffer->number_of_vertices, 0) != EXIT_SUCCESS)
+                {
+                        dxf_flatten_buffer_free (buffer);
+                        return (DXF_ERROR);
+                }
+        }
+        /* Drop repeated vertices, zero length segments would touch
+         * segments that are not their neighbours. */
+        k = 0;
+        for (i = 0; i < buffer->number_of_vertices; i++)
+        {
+                if ((k > 0)
+                  && (buffer->x[i] == buffer->x[k - 1])
+                  && (buffer->y[i] == buffer->y[k - 1]))
+                {
+                        continue;
+                }
+                buffer->x[k] = buffer->x[i];
+                buffer->y[k] = buffer->y[i];
+                k++;
+        }
+        buffer->number_of_vertices = k;
+        number_of_segments = buffer->number_of_vertices - 1;
+        if (number_of_segments < 2)
+        {
+                dxf_flatten_buffer_free (buffer);
+                return (TRUE);
+        }
+        segments = malloc (number_of_segments * sizeof (DxfPolylineGeometrySegment));
+        marks = malloc (number_of_segments * sizeof (int));
+        if ((segments == NULL) || (marks == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                free (segments);
+                free (marks);
+                dxf_flatten_buffer_free (buffer);
+                return (DXF_ERROR);
+        }
+        mean_width = 0.0;
+        mean_height = 0.0;
+        for (i = 0; i < number_of_segments; i++)
+        {
+                segments[i].min_x = fmin (buffer->x[i], buffer->x[i + 1]);
+                segments[i].max_x = fmax (buffer->x[i], buffer->x[i + 1]);
+                segments[i].min_y = fmin (buffer->y[i], buffer->y[i + 1]);
+                segments[i].max_y = fmax (buffer->y[i], buffer->y[i + 1]);
+                mean_width += segments[i].max_x - segments[i].min_x;
+                mean_height += segments[i].max_y - segments[i].min_y;
+                marks[i] = -1;
+        }
+        mean_width /= number_of_segments;
+        mean_height /= number_of_segments;
+        if (dxf_polyline_geometry_grid_build (&grid, segments, number_of_segments,
+          mean_width, mean_height) != EXIT_SUCCESS)
+        {
+                free (segments);
+                free (marks);
+                dxf_flatten_buffer_free (buffer);
+                return (DXF_ERROR);
+        }
+        result = TRUE;
+        for (i = 0; (i < number_of_segments) && result; i++)
+        {
+                dxf_polyline_geometry_grid_get_cells (&grid, &segments[i],
+                  &first_column, &first_row, &last_column, &last_row);
+                for (row = first_row; (row <= last_row) && result; row++)
+                {
+                        for (column = first_column; (column <= last_column) && result; column++)
+                        {
+                                cell = (row * grid.number_of_columns) + column;
+                                for (k = grid.cell_start[cell]; k < grid.cell_start[cell + 1]; k++)
+                                {
+                                        j = grid.cell_segments[k];
+                                        /* Every pair is tested once, from
+                                         * its lowest segment. */
+                                        if ((j <= i) || (marks[j] == i))
+                                        {
+                                                continue;
+                                        }
+                                        marks[j] = i;
+                                        if ((segments[j].min_x > segments[i].max_x)
+                                          || (segments[j].max_x < segments[i].min_x)
+                                          || (segments[j].min_y > segments[i].max_y)
+                                          || (segments[j].max_y < segments[i].min_y))
+                                        {
+                                                continue;
+                                        }
+                                        is_adjacent = (j - i == 1)
+                                          || (geometry->is_closed
+                                            && (i == 0) && (j == number_of_segments - 1));
+                                        if (dxf_polyline_geometry_segments_intersect (buffer, i, j, is_adjacent))
+                                        {
+                                                result = FALSE;
+                                                break;
+                                        }
+                                }
+                        }
+                }
+        }
+        free (grid.cell_start);
+        free (grid.cell_segments);
+        free (segments);
+        free (marks);
+        dxf_flatten_buffer_free (buffer);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (result);
+}
+
+
+/*!
+ * \brief Compute length, area, centroid, orientation and simplicity of
+ * a \c DxfPolylineGeometry.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_polyline_geometry_compute
+(
+        DxfPolylineGeometry *geometry,
+                /*!< a pointer to the polyline geometry. */
+        double tolerance,
+                /*!< tolerance for flattening bulged segments. */
+        DxfPolylineGeometryResult *result
+                /*!< receives the results. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        double signed_area;
+
+        /* Do some basic checks. */
+        if ((geometry == NULL) || (result == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        memset (result, 0, sizeof (DxfPolylineGeometryResult));
+        result->length = dxf_polyline_geometry_get_length (geometry);
+        signed_area = dxf_polyline_geometry_get_signed_area (geometry);
+        result->area = fabs (signed_area);
+        result->is_counterclockwise = (signed_area > 0.0) ? TRUE : FALSE;
+        if (signed_area != 0.0)
+        {
+                dxf_polyline_geometry_get_centroid (geometry,
+                  &result->centroid_x, &result->centroid_y);
+        }
+        result->is_simple = dxf_polyline_geometry_is_simple (geometry, tolerance);
+        result->status = (result->is_simple == DXF_ERROR) ? EXIT_FAILURE : EXIT_SUCCESS;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (result->status);
+}
+
+
+/*!
+ * \brief Compute the geometric properties of every DXF \c LWPOLYLINE
+ * entity in a single linked list.
+ *
+ * The entities are divided in equal chunks over \c number_of_threads
+ * threads, a value of 1 or less does all work in the calling thread.
+ *
+ * \return the number of entities processed (at most
+ * \c max_number_of_results), or \c DXF_ERROR when an error occurred.
+ */
+int
+dxf_polyline_geometry_compute_lwpolyline_list
+(
+        DxfLWPolyline *lwpolylines,
+                /*!< a pointer to a single linked list of DXF
+                 * \c LWPOLYLINE entities. */
+        double tolerance,
+                /*!< tolerance for flattening bulged segments. */
+        DxfPolylineGeometryResult *results,
+                /*!< array receiving a result per entity. */
+        int max_number_of_results,
+                /*!< number of entries in \c results. */
+        int number_of_threads
+                /*!< number of threads to use. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfLWPolyline *iter = NULL;
+        void **entities = NULL;
+        int n;
+        int result;
+
+        /* Do some basic checks. */
+        if (results == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (DXF_ERROR);
+        }
+        entities = malloc (((max_number_of_results > 0) ? max_number_of_results : 1) * sizeof (void *));
+        if (entities == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (DXF_ERROR);
+        }
+        /* Random access to the entities for the threads. */
+        n = 0;
+        iter = lwpolylines;
+        while ((iter != NULL) && (n < max_number_of_results))
+        {
+                entities[n] = iter;
+                n++;
+                iter = (DxfLWPolyline *) iter->next;
+        }
+        result = dxf_polyline_geometry_compute_list (entities, n, TRUE,
+          tolerance, results, number_of_threads);
+        free (entities);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return ((result == EXIT_SUCCESS) ? n : DXF_ERROR);
+}
+
+
+/*!
+ * \brief Compute the geometric properties of every DXF \c POLYLINE
+ * entity in a single linked list.
+ *
+ * The entities are divided in equal chunks over \c number_of_threads
+ * threads, a value of 1 or less does all work in the calling thread.
+ *
+ * \return the number of entities processed (at most
+ * \c max_number_of_results), or \c DXF_ERROR when an error occurred.
+ */
+int
+dxf_polyline_geometry_compute_polyline_list
+(
+        DxfPolyline *polylines,
+                /*!< a pointer to a single linked list of DXF
+                 * \c POLYLINE entities. */
+        double tolerance,
+                /*!< tolerance for flattening bulged segments. */
+        DxfPolylineGeometryResult *results,
+                /*!< array receiving a result per entity. */
+        int max_number_of_results,
+                /*!< number of entries in \c results. */
+        int number_of_threads
+                /*!< number of threads to use. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfPolyline *iter = NULL;
+        void **entities = NULL;
+        int n;
+        int result;
+
+        /* Do some basic checks. */
+        if (results == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (DXF_ERROR);
+        }
+        entities = malloc (((max_number_of_results > 0) ? max_number_of_results : 1) * sizeof (void *));
+        if (entities == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (DXF_ERROR);
+        }
+        /* Random access to the entities for the threads. */
+        n = 0;
+        iter = polylines;
+        while ((iter != NULL) && (n < max_number_of_results))
+        {
+                entities[n] = iter;
+                n++;
+                iter = (DxfPolyline *) iter->next;
+        }
+        result = dxf_polyline_geometry_compute_list (entities, n, FALSE,
+          tolerance, results, number_of_threads);
+        free (entities);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return ((result == EXIT_SUCCESS) ? n : DXF_ERROR);
+}
+
+
+/*!
+ * \brief Orientation of point \c c with respect to the line from \c a
+ * to \c b.
+ *
+ * \return a positive value for a left turn, a negative value for a
+ * right turn and zero for collinear points.
+ */
+static double
+dxf_polyline_geometry_orientation
+(
+        double ax,
+                /*!< X-coordinate of point a. */
+        double ay,
+                /*!< Y-coordinate of point a. */
+        double bx,
+                /*!< X-coordinate of point b. */
+        double by,
+                /*!< Y-coordinate of point b. */
+        double cx,
+                /*!< X-coordinate of point c. */
+        double cy
+                /*!< Y-coordinate of point c. */
+)
+{
+        return (((bx - ax) * (cy - ay)) - ((by - ay) * (cx - ax)));
+}
+
+
+/*!
+ * \brief Test two segments of a flattened polyline for intersection.
+ *
+ * Adjacent segments share a vertex, they only count as intersecting
+ * when they fold back over each other.
+ *
+ * \return \c TRUE when the segments intersect, \c FALSE otherwise.
+ */
+static int
+dxf_polyline_geometry_segments_intersect
+(
+        DxfFlattenBuffer *buffer,
+                /*!< buffer with the flattened polyline. */
+        int i,
+                /*!< index of the first vertex of the first segment. */
+        int j,
+                /*!< index of the first vertex of the second segment. */
+        int is_adjacent
+                /*!< \c TRUE when the segments share a vertex. */
+)
+{
+        double ax = buffer->x[i];
+        double ay = buffer->y[i];
+        double bx = buffer->x[i + 1];
+        double by = buffer->y[i + 1];
+        double cx = buffer->x[j];
+        double cy = buffer->y[j];
+        double dx = buffer->x[j + 1];
+        double dy = buffer->y[j + 1];
+        double o1;
+        double o2;
+        double o3;
+        double o4;
+
+        if (((ax > cx) && (ax > dx) && (bx > cx) && (bx > dx))
+          || ((ay > cy) && (ay > dy) && (by > cy) && (by > dy))
+          || ((ay < cy) && (ay < dy) && (by < cy) && (by < dy)))
+        {
+                return (FALSE);
+        }
+        o1 = dxf_polyline_geometry_orientation (ax, ay, bx, by, cx, cy);
+        o2 = dxf_polyline_geometry_orientation (ax, ay, bx, by, dx, dy);
+        o3 = dxf_polyline_geometry_orientation (cx, cy, dx, dy, ax, ay);
+        o4 = dxf_polyline_geometry_orientation (cx, cy, dx, dy, bx, by);
+        if (is_adjacent)
+        {
+                /* Only a collinear fold back is an intersection. */
+                if ((o1 != 0.0) || (o2 != 0.0))
+                {
+                        return (FALSE);
+                }
+                if ((bx == cx) && (by == cy))
+                {
+                        return ((((ax - bx) * (dx - bx)) + ((ay - by) * (dy - by))) > 0.0);
+                }
+                return ((((cx - ax) * (bx - ax)) + ((cy - ay) * (by - ay))) > 0.0);
+        }
+        if ((((o1 > 0.0) && (o2 < 0.0)) || ((o1 < 0.0) && (o2 > 0.0)))
+          && (((o3 > 0.0) && (o4 < 0.0)) || ((o3 < 0.0) && (o4 > 0.0))))
+        {
+                return (TRUE);
+        }
+        /* Touching: an end point on the other segment. */
+        if ((o1 == 0.0)
+          && (fmin (ax, bx) <= cx) && (cx <= fmax (ax, bx))
+          && (fmin (ay, by) <= cy) && (cy <= fmax (ay, by)))
+        {
+                return (TRUE);
+        }
+        if ((o2 == 0.0)
+          && (fmin (ax, bx) <= dx) && (dx <= fmax (ax, bx))
+          && (fmin (ay, by) <= dy) && (dy <= fmax (ay, by)))
+        {
+                return (TRUE);
+        }
+        if ((o3 == 0.0)
+          && (fmin (cx, dx) <= ax) && (ax <= fmax (cx, dx))
+          && (fmin (cy, dy) <= ay) && (ay <= fmax (cy, dy)))
+        {
+                return (TRUE);
+        }
+        if ((o4 == 0.0)
+          && (fmin (cx, dx) <= bx) && (bx <= fmax (cx, dx))
+          && (fmin (cy, dy) <= by) && (by <= fmax (cy, dy)))
+        {
+                return (TRUE);
+        }
+        return (FALSE);
+}
+
+
+/*!
+ * \brief Bucket the segments of a flattened polyline into a uniform
+ * grid.
+ *
+ * The cells are about the size of the mean segment bounding box, with
+ * at most four cells per segment, so that a segment overlaps a few
+ * cells and a cell holds a few segments.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when no memory
+ * could be allocated.
+ */
+static int
+dxf_polyline_geometry_grid_build
+(
+        DxfPolylineGeometryGrid *grid,
+                /*!< the grid to build. */
+        DxfPolylineGeometrySegment *segments,
+                /*!< array of segment bounding boxes. */
+        int number_of_segments,
+                /*!< number of segments. */
+        double mean_width,
+                /*!< mean width of the segment bounding boxes. */
+        double mean_height
+                /*!< mean height of the segment bounding boxes. */
+)
+{
+        int *cursor = NULL;
+        double max_x;
+        double max_y;
+        double columns;
+        double rows;
+        double scale;
+        long number_of_entries;
+        int number_of_cells;
+        int first_column;
+        int first_row;
+        int last_column;
+        int last_row;
+        int column;
+        int row;
+        int cell;
+        int i;
+
+        grid->min_x = segments[0].min_x;
+        grid->min_y = segments[0].min_y;
+        max_x = segments[0].max_x;
+        max_y = segments[0].max_y;
+        for (i = 1; i < number_of_segments; i++)
+        {
+                grid->min_x = fmin (grid->min_x, segments[i].min_x);
+                grid->min_y = fmin (grid->min_y, segments[i].min_y);
+                max_x = fmax (max_x, segments[i].max_x);
+                max_y = fmax (max_y, segments[i].max_y);
+        }
+        columns = (mean_width > 0.0) ? (max_x - grid->min_x) / mean_width : 1.0;
+        rows = (mean_height > 0.0) ? (max_y - grid->min_y) / mean_height : 1.0;
+        columns = fmin (fmax (columns, 1.0), 4.0 * number_of_segments);
+        rows = fmin (fmax (rows, 1.0), 4.0 * number_of_segments);
+        if (columns * rows > 4.0 * number_of_segments)
+        {
+                scale = sqrt (columns * rows / (4.0 * number_of_segments));
+                columns = fmax (columns / scale, 1.0);
+                rows = fmax (rows / scale, 1.0);
+        }
+        grid->number_of_columns = (int) columns;
+        grid->number_of_rows = (int) rows;
+        grid->cell_width = (max_x > grid->min_x)
+          ? (max_x - grid->min_x) / grid->number_of_columns : 1.0;
+        grid->cell_height = (max_y > grid->min_y)
+          ? (max_y - grid->min_y) / grid->number_of_rows : 1.0;
+        number_of_cells = grid->number_of_columns * grid->number_of_rows;
+        grid->cell_segments = NULL;
+        grid->cell_start = calloc (number_of_cells + 1, sizeof (int));
+        cursor = malloc (number_of_cells * sizeof (int));
+        if ((grid->cell_start == NULL) || (cursor == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                free (grid->cell_start);
+                free (cursor);
+                return (EXIT_FAILURE);
+        }
+        /* Count the segments of every cell, then place them. */
+        number_of_entries = 0;
+        for (i = 0; i < number_of_segments; i++)
+        {
+                dxf_polyline_geometry_grid_get_cells (grid, &segments[i],
+                  &first_column, &first_row, &last_column, &last_row);
+                for (row = first_row; row <= last_row; row++)
+                {
+                        for (column = first_column; column <= last_column; column++)
+                        {
+                                grid->cell_start[(row * grid->number_of_columns) + column + 1]++;
+                        }
+                }
+                number_of_entries += (long) (last_column - first_column + 1)
+                  * (last_row - first_row + 1);
+        }
+        if (number_of_entries > INT_MAX)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () too many grid entries.\n")),
+                  __FUNCTION__);
+                free (grid->cell_start);
+                free (cursor);
+                return (EXIT_FAILURE);
+        }
+        for (cell = 0; cell < number_of_cells; cell++)
+        {
+                grid->cell_start[cell + 1] += grid->cell_start[cell];
+                cursor[cell] = grid->cell_start[cell];
+        }
+        grid->cell_segments = malloc ((number_of_entries + 1) * sizeof (int));
+        if (grid->cell_segments == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                free (grid->cell_start);
+                free (cursor);
+                return (EXIT_FAILURE);
+        }
+        for (i = 0; i < number_of_segments; i++)
+        {
+                dxf_polyline_geometry_grid_get_cells (grid, &segments[i],
+                  &first_column, &first_row, &last_column, &last_row);
+                for (row = first_row; row <= last_row; row++)
+                {
+                        for (column = first_column; column <= last_column; column++)
+                        {
+                                cell = (row * grid->number_of_columns) + column;
+                                grid->cell_segments[cursor[cell]] = i;
+                                cursor[cell]++;
+                        }
+                }
+        }
+        free (cursor);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Get the range of grid cells overlapped by the bounding box of
+ * a segment.
+ */
+static void
+dxf_polyline_geometry_grid_get_cells
+(
+        DxfPolylineGeometryGrid *grid,
+                /*!< a pointer to the grid. */
+        DxfPolylineGeometrySegment *segment,
+                /*!< a pointer to the segment. */
+        int *first_column,
+                /*!< receives the first column. */
+        int *first_row,
+                /*!< receives the first row. */
+        int *last_column,
+                /*!< receives the last column. */
+        int *last_row
+                /*!< receives the last row. */
+)
+{
+        *first_column = dxf_polyline_geometry_grid_get_cell (segment->min_x,
+          grid->min_x, grid->cell_width, grid->number_of_columns);
+        *last_column = dxf_polyline_geometry_grid_get_cell (segment->max_x,
+          grid->min_x, grid->cell_width, grid->number_of_columns);
+        *first_row = dxf_polyline_geometry_grid_get_cell (segment->min_y,
+          grid->min_y, grid->cell_height, grid->number_of_rows);
+        *last_row = dxf_polyline_geometry_grid_get_cell (segment->max_y,
+          grid->min_y, grid->cell_height, grid->number_of_rows);
+}
+
+
+/*!
+ * \brief Get the grid cell of a coordinate along one axis.
+ *
+ * \return the cell, clamped to the grid.
+ */
+static int
+dxf_polyline_geometry_grid_get_cell
+(
+        double value,
+                /*!< the coordinate. */
+        double origin,
+                /*!< the coordinate of the first cell. */
+        double size,
+                /*!< the size of a cell. */
+        int number_of_cells
+                /*!< the number of cells along the axis. */
+)
+{
+        int cell;
+
+        cell = (int) ((value - origin) / size);
+        if (cell < 0)
+        {
+                return (0);
+        }
+        if (cell >= number_of_cells)
+        {
+                return (number_of_cells - 1);
+        }
+        return (cell);
+}
+
+
+/*!
+ * \brief Compute the geometric properties of an array of polyline
+ * entities, distributed over a number of threads.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_polyline_geometry_compute_list
+(
+        void **entities,
+                /*!< array of pointers to the entities. */
+        int number_of_entities,
+                /*!< number of entities. */
+        int is_lwpolyline,
+                /*!< \c TRUE for \c LWPOLYLINE entities. */
+        double tolerance,
+                /*!< tolerance for flattening bulged segments. */
+        DxfPolylineGeometryResult *results,
+                /*!< array receiving the results. */
+        int number_of_threads
+                /*!< number of threads to use. */
+)
+{
+        DxfPolylineGeometryJob *jobs = NULL;
+        pthread_t *threads = NULL;
+        int *started = NULL;
+        int chunk;
+        int i;
+
+        if (number_of_entities <= 0)
+        {
+                return (EXIT_SUCCESS);
+        }
+        if (number_of_threads < 1)
+        {
+                number_of_threads = 1;
+        }
+        if (number_of_threads > number_of_entities)
+        {
+                number_of_threads = number_of_entities;
+        }
+        jobs = calloc (number_of_threads, sizeof (DxfPolylineGeometryJob));
+        threads = calloc (number_of_threads, sizeof (pthread_t));
+        started = calloc (number_of_threads, sizeof (int));
+        if ((jobs == NULL) || (threads == NULL) || (started == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                free (jobs);
+                free (threads);
+                free (started);
+                return (EXIT_FAILURE);
+        }
+        chunk = (number_of_entities + number_of_threads - 1) / number_of_threads;
+        for (i = 0; i < number_of_threads; i++)
+        {
+                jobs[i].entities = entities;
+                jobs[i].is_lwpolyline = is_lwpolyline;
+                jobs[i].tolerance = tolerance;
+                jobs[i].results = results;
+                jobs[i].begin = i * chunk;
+                jobs[i].end = ((i + 1) * chunk < number_of_entities) ? (i + 1) * chunk : number_of_entities;
+        }
+        /* The first chunk is done by the calling thread. */
+        for (i = 1; i < number_of_threads; i++)
+        {
+                if (pthread_create (&threads[i], NULL, dxf_polyline_geometry_run_job, &jobs[i]) == 0)
+                {
+                        started[i] = TRUE;
+                }
+        }
+        dxf_polyline_geometry_run_job (&jobs[0]);
+        for (i = 1; i < number_of_threads; i++)
+        {
+                if (started[i])
+                {
+                        pthread_join (threads[i], NULL);
+                }
+                else
+                {
+                        dxf_polyline_geometry_run_job (&jobs[i]);
+                }
+        }
+        free (jobs);
+        free (threads);
+        free (started);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Run a batch computation job, used as thread entry point.
+ *
+ * A single \c DxfPolylineGeometry is reused for all entities of the
+ * job.
+ */
+static void *
+dxf_polyline_geometry_run_job
+(
+        void *data
+                /*!< a pointer to a \c DxfPolylineGeometryJob. */
+)
+{
+        DxfPolylineGeometryJob *job = NULL;
+        DxfPolylineGeometry *geometry = NULL;
+        int status;
+        int i;
+
+        job = (DxfPolylineGeometryJob *) data;
+        geometry = dxf_polyline_geometry_init (dxf_polyline_geometry_new (), 64);
+        for (i = job->begin; i < job->end; i++)
+        {
+                if (geometry == NULL)
+                {
+                        memset (&job->results[i], 0, sizeof (DxfPolylineGeometryResult));
+                        job->results[i].status = EXIT_FAILURE;
+                        continue;
+                }
+                if (job->is_lwpolyline)
+                {
+                        status = dxf_polyline_geometry_from_lwpolyline (geometry,
+                          (DxfLWPolyline *) job->entities[i]);
+                }
+                else
+                {
+                        status = dxf_polyline_geometry_from_polyline (geometry,
+                          (DxfPolyline *) job->entities[i]);
+                }
+                if (status != EXIT_SUCCESS)
+                {
+                        memset (&job->results[i], 0, sizeof (DxfPolylineGeometryResult));
+                        job->results[i].status = EXIT_FAILURE;
+                        continue;
+                }
+                dxf_polyline_geometry_compute (geometry, job->tolerance, &job->results[i]);
+        }
+        if (geometry != NULL)
+        {
+                dxf_polyline_geometry_free (geometry);
+        }
+        return (NULL);
+}
+
+
+/* EOF */
@@ -0,0 +1,124 @@
+/*!
+ * \file polyline_geometry.h
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Header file for geometric operations on DXF polylines
+ * (\c LWPOLYLINE and \c POLYLINE).
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#ifndef LIBDXF_SRC_POLYLINE_GEOMETRY_H
+#define LIBDXF_SRC_POLYLINE_GEOMETRY_H
+
+
+#include "global.h"
+#include "flatten.h"
+#include "lwpolyline.h"
+#include "polyline.h"
+#include "vertex.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*!
+ * \brief Definition of a polyline as contiguous vertex arrays.
+ */
+typedef struct
+dxf_polyline_geometry_struct
+{
+        double *x;
+                /*!< Array of X-coordinates of the vertices. */
+        double *y;
+                /*!< Array of Y-coordinates of the vertices. */
+        double *bulge;
+                /*!< Array of bulges of the segments starting at each
+                 * vertex. */
+        int number_of_vertices;
+                /*!< Number of vertices. */
+        int max_number_of_vertices;
+                /*!< Number of vertices that fit in the arrays. */
+        int is_closed;
+                /*!< \c TRUE when the last vertex connects to the first
+                 * vertex. */
+} DxfPolylineGeometry;
+
+
+/*!
+ * \brief Definition of the results of the geometric operations on a
+ * polyline.
+ */
+typedef struct
+dxf_polyline_geometry_result_struct
+{
+        double length;
+                /*!< Length of the polyline, including the closing
+                 * segment of a closed polyline. */
+        double area;
+                /*!< Enclosed area, an open polyline is taken as
+                 * closed. */
+        double centroid_x;
+                /*!< X-coordinate of the centroid of the enclosed area. */
+        double centroid_y;
+                /*!< Y-coordinate of the centroid of the enclosed area. */
+        int is_counterclockwise;
+                /*!< \c TRUE when the vertices run counterclockwise. */
+        int is_simple;
+                /*!< \c TRUE when no segments intersect each other. */
+        int status;
+                /*!< \c EXIT_SUCCESS or \c EXIT_FAILURE. */
+} DxfPolylineGeometryResult;
+
+
+DxfPolylineGeometry *dxf_polyline_geometry_new ();
+DxfPolylineGeometry *dxf_polyline_geometry_init (DxfPolylineGeometry *geometry, int max_number_of_vertices);
+int dxf_polyline_geometry_reserve (DxfPolylineGeometry *geometry, int max_number_of_vertices);
+int dxf_polyline_geometry_free (DxfPolylineGeometry *geometry);
+int dxf_polyline_geometry_from_lwpolyline (DxfPolylineGeometry *geometry, DxfLWPolyline *lwpolyline);
+int dxf_polyline_geometry_from_polyline (DxfPolylineGeometry *geometry, DxfPolyline *polyline);
+double dxf_polyline_geometry_get_length (DxfPolylineGeometry *geometry);
+double dxf_polyline_geometry_get_signed_area (DxfPolylineGeometry *geometry);
+int dxf_polyline_geometry_get_centroid (DxfPolylineGeometry *geometry, double *x, double *y);
+int dxf_polyline_geometry_is_simple (DxfPolylineGeometry *geometry, double tolerance);
+int dxf_polyline_geometry_compute (DxfPolylineGeometry *geometry, double tolerance, DxfPolylineGeometryResult *result);
+int dxf_polyline_geometry_compute_lwpolyline_list (DxfLWPolyline *lwpolylines, double tolerance, DxfPolylineGeometryResult *results, int max_number_of_results, int number_of_threads);
+int dxf_polyline_geometry_compute_polyline_list (DxfPolyline *polylines, double tolerance, DxfPolylineGeometryResult *results, int max_number_of_results, int number_of_threads);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* LIBDXF_SRC_POLYLINE_GEOMETRY_H */
+
+
+/* EOF */
@@ -42,6 +42,7 @@
 
 
 #include "rastervariables.h"
+#include "util.h"
 
 
 /*!
@@ -112,8 +113,8 @@ dxf_rastervariables_init
                 return (NULL);
         }
         rastervariables->id_code = 0;
-        rastervariables->dictionary_owner_soft = strdup ("");
-        rastervariables->dictionary_owner_hard = strdup ("");
+        rastervariables->dictionary_owner_soft = dxf_string_share ("");
+        rastervariables->dictionary_owner_hard = dxf_string_share ("");
         rastervariables->display_image_frame = 0;
         rastervariables->display_quality = 0;
         rastervariables->units = 0;
@@ -244,16 +245,14 @@ dxf_rastervariables_read
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", rastervariables->dictionary_owner_soft);
+                        dxf_read_string (fp, &rastervariables->dictionary_owner_soft);
                         i++;
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", rastervariables->dictionary_owner_hard);
+                        dxf_read_string (fp, &rastervariables->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "999") == 0)
                 {
@@ -403,8 +402,8 @@ dxf_rastervariables_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (rastervariables->dictionary_owner_soft);
-        free (rastervariables->dictionary_owner_hard);
+        dxf_string_free (rastervariables->dictionary_owner_soft);
+        dxf_string_free (rastervariables->dictionary_owner_hard);
         free (rastervariables);
         rastervariables = NULL;
 #if DEBUG
@@ -579,6 +578,8 @@ dxf_rastervariables_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (rastervariables == NULL)
         {
@@ -594,7 +595,13 @@ dxf_rastervariables_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        rastervariables->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (rastervariables->dictionary_owner_soft);
+        rastervariables->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -659,6 +666,8 @@ dxf_rastervariables_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (rastervariables == NULL)
         {
@@ -674,7 +683,13 @@ dxf_rastervariables_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        rastervariables->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (rastervariables->dictionary_owner_hard);
+        rastervariables->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -42,6 +42,8 @@
 
 
 #include "ray.h"
+#include "stats.h"
+#include "util.h"
 
 
 /*!
@@ -74,6 +76,7 @@ dxf_ray_new ()
         else
         {
                 memset (ray, 0, size);
+                dxf_stats_count_allocation (RAY, size);
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -114,8 +117,8 @@ dxf_ray_init
               return (NULL);
         }
         ray->id_code = 0;
-        ray->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        ray->layer = strdup (DXF_DEFAULT_LAYER);
+        ray->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        ray->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         ray->elevation = 0.0;
         ray->thickness = 0.0;
         ray->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
@@ -124,15 +127,14 @@ dxf_ray_init
         ray->paperspace = DXF_MODELSPACE;
         ray->graphics_data_size = 0;
         ray->shadow_mode = 0;
-        ray->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_new ();
-        ray->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) ray->binary_graphics_data);
-        ray->dictionary_owner_soft = strdup ("");
-        ray->material = strdup ("");
-        ray->dictionary_owner_hard = strdup ("");
+        ray->binary_graphics_data = NULL;
+        ray->dictionary_owner_soft = dxf_string_share ("");
+        ray->material = dxf_string_share ("");
+        ray->dictionary_owner_hard = dxf_string_share ("");
         ray->lineweight = 0;
-        ray->plot_style_name = strdup ("");
+        ray->plot_style_name = dxf_string_share ("");
         ray->color_value = 0;
-        ray->color_name = strdup ("");
+        ray->color_name = dxf_string_share ("");
         ray->transparency = 0;
         ray->p0 = (DxfPoint *) dxf_point_new ();
         ray->p0 = dxf_point_init ((DxfPoint *) ray->p0);
@@ -221,14 +223,12 @@ dxf_ray_read
                 {
                         /* Now follows a string containing a linetype
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ray->linetype);
+                        dxf_read_string (fp, &ray->linetype);
                 }
                 else if (strcmp (temp_string, "8") == 0)
                 {
                         /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ray->layer);
+                        dxf_read_string (fp, &ray->layer);
                 }
                 else if (strcmp (temp_string, "10") == 0)
                 {
@@ -335,15 +335,13 @@ dxf_ray_read
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ray->dictionary_owner_soft);
+                        dxf_read_string (fp, &ray->dictionary_owner_soft);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ray->dictionary_owner_hard);
+                        dxf_read_string (fp, &ray->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "999") == 0)
                 {
@@ -362,11 +360,13 @@ dxf_ray_read
         /* Handle omitted members and/or illegal values. */
         if (strcmp (ray->linetype, "") == 0)
         {
-                ray->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (ray->linetype);
+                ray->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (ray->layer, "") == 0)
         {
-                ray->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (ray->layer);
+                ray->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Clean up. */
         free (temp_string);
@@ -442,7 +442,8 @@ dxf_ray_write
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                ray->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (ray->linetype);
+                ray->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (ray->layer, "") == 0)
         {
@@ -452,7 +453,8 @@ dxf_ray_write
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0\n")),
                   dxf_entity_name);
-                ray->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (ray->layer);
+                ray->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Start writing output. */
         fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
@@ -571,12 +573,16 @@ dxf_ray_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (ray->linetype);
-        free (ray->layer);
-        free (ray->dictionary_owner_soft);
-        free (ray->dictionary_owner_hard);
+        dxf_string_free (ray->linetype);
+        dxf_string_free (ray->layer);
+        dxf_string_free (ray->dictionary_owner_soft);
+        dxf_string_free (ray->dictionary_owner_hard);
         dxf_point_free (ray->p0);
         dxf_point_free (ray->p1);
+        if (ray->binary_graphics_data != NULL)
+        {
+                dxf_binary_graphics_data_free_list (ray->binary_graphics_data);
+        }
         free (ray);
         ray = NULL;
 #if DEBUG
@@ -747,6 +753,8 @@ dxf_ray_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (ray == NULL)
         {
@@ -762,7 +770,13 @@ dxf_ray_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        ray->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (ray->linetype);
+        ray->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -823,6 +837,8 @@ dxf_ray_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (ray == NULL)
         {
@@ -838,7 +854,13 @@ dxf_ray_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        ray->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (ray->layer);
+        ray->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1628,6 +1650,8 @@ dxf_ray_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (ray == NULL)
         {
@@ -1643,7 +1667,13 @@ dxf_ray_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        ray->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (ray->dictionary_owner_soft);
+        ray->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1710,6 +1740,8 @@ dxf_ray_set_material
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (ray == NULL)
         {
@@ -1725,7 +1757,13 @@ dxf_ray_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        ray->material = strdup (material);
+        copy = dxf_string_share (material);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (ray->material);
+        ray->material = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1790,6 +1828,8 @@ dxf_ray_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (ray == NULL)
         {
@@ -1805,7 +1845,13 @@ dxf_ray_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        ray->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (ray->dictionary_owner_hard);
+        ray->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1935,6 +1981,8 @@ dxf_ray_set_plot_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (ray == NULL)
         {
@@ -1950,7 +1998,13 @@ dxf_ray_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        ray->plot_style_name = strdup (plot_style_name);
+        copy = dxf_string_share (plot_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (ray->plot_style_name);
+        ray->plot_style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2080,6 +2134,8 @@ dxf_ray_set_color_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (ray == NULL)
         {
@@ -2095,7 +2151,13 @@ dxf_ray_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        ray->color_name = strdup (color_name);
+        copy = dxf_string_share (color_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (ray->color_name);
+        ray->color_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -42,6 +42,8 @@
 
 
 #include "region.h"
+#include "stats.h"
+#include "util.h"
 
 
 /*!
@@ -71,6 +73,7 @@ dxf_region_new ()
         else
         {
                 memset (region, 0, size);
+                dxf_stats_count_allocation (REGION, size);
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -113,8 +116,8 @@ dxf_region_init
         }
         region->modeler_format_version_number = 0;
         region->id_code = 0;
-        region->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        region->layer = strdup (DXF_DEFAULT_LAYER);
+        region->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        region->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         region->elevation = 0.0;
         region->thickness = 0.0;
         region->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
@@ -132,8 +135,8 @@ dxf_region_init
         region->additional_proprietary_data->value = strdup ("");
         region->additional_proprietary_data->length = 0;
         region->additional_proprietary_data->next = NULL;
-        region->dictionary_owner_soft = strdup ("");
-        region->dictionary_owner_hard = strdup ("");
+        region->dictionary_owner_soft = dxf_string_share ("");
+        region->dictionary_owner_hard = dxf_string_share ("");
         region->next = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -233,14 +236,12 @@ dxf_region_read
                 {
                         /* Now follows a string containing a linetype
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", region->linetype);
+                        dxf_read_string (fp, &region->linetype);
                 }
                 else if (strcmp (temp_string, "8") == 0)
                 {
                         /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", region->layer);
+                        dxf_read_string (fp, &region->layer);
                 }
                 else if ((fp->acad_version_number <= AutoCAD_11)
                         && (strcmp (temp_string, "38") == 0)
@@ -311,15 +312,13 @@ dxf_region_read
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", region->dictionary_owner_soft);
+                        dxf_read_string (fp, &region->dictionary_owner_soft);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", region->dictionary_owner_hard);
+                        dxf_read_string (fp, &region->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "999") == 0)
                 {
@@ -338,11 +337,13 @@ dxf_region_read
         /* Handle omitted members and/or illegal values. */
         if (strcmp (region->linetype, "") == 0)
         {
-                region->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (region->linetype);
+                region->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (region->layer, "") == 0)
         {
-                region->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (region->layer);
+                region->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Clean up. */
         free (temp_string);
@@ -408,7 +409,8 @@ dxf_region_write
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                region->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (region->linetype);
+                region->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (region->layer, "") == 0)
         {
@@ -418,7 +420,8 @@ dxf_region_write
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0")),
                   dxf_entity_name);
-                region->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (region->layer);
+                region->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Start writing output. */
         fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
@@ -561,14 +564,17 @@ dxf_region_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (region->linetype);
-        free (region->layer);
-        dxf_binary_graphics_data_free_list (region->binary_graphics_data);
-        free (region->dictionary_owner_soft);
-        free (region->material);
-        free (region->dictionary_owner_hard);
-        free (region->plot_style_name);
-        free (region->color_name);
+        dxf_string_free (region->linetype);
+        dxf_string_free (region->layer);
+        if (region->binary_graphics_data != NULL)
+        {
+                dxf_binary_graphics_data_free_list (region->binary_graphics_data);
+        }
+        dxf_string_free (region->dictionary_owner_soft);
+        dxf_string_free (region->material);
+        dxf_string_free (region->dictionary_owner_hard);
+        dxf_string_free (region->plot_style_name);
+        dxf_string_free (region->color_name);
         dxf_char_free_list (region->proprietary_data);
         dxf_char_free_list (region->additional_proprietary_data);
         free (region);
@@ -741,6 +747,8 @@ dxf_region_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (region == NULL)
         {
@@ -756,7 +764,13 @@ dxf_region_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        region->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (region->linetype);
+        region->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -817,6 +831,8 @@ dxf_region_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (region == NULL)
         {
@@ -832,7 +848,13 @@ dxf_region_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        region->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (region->layer);
+        region->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1623,6 +1645,8 @@ dxf_region_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (region == NULL)
         {
@@ -1638,7 +1662,13 @@ dxf_region_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        region->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (region->dictionary_owner_soft);
+        region->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1705,6 +1735,8 @@ dxf_region_set_material
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (region == NULL)
         {
@@ -1720,7 +1752,13 @@ dxf_region_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        region->material = strdup (material);
+        copy = dxf_string_share (material);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (region->material);
+        region->material = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1785,6 +1823,8 @@ dxf_region_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (region == NULL)
         {
@@ -1800,7 +1840,13 @@ dxf_region_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        region->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (region->dictionary_owner_hard);
+        region->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1930,6 +1976,8 @@ dxf_region_set_plot_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (region == NULL)
         {
@@ -1945,7 +1993,13 @@ dxf_region_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        region->plot_style_name = strdup (plot_style_name);
+        copy = dxf_string_share (plot_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (region->plot_style_name);
+        region->plot_style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2075,6 +2129,8 @@ dxf_region_set_color_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (region == NULL)
         {
@@ -2090,7 +2146,13 @@ dxf_region_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        region->color_name = strdup (color_name);
+        copy = dxf_string_share (color_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (region->color_name);
+        region->color_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -0,0 +1,625 @@
+/*!
+ * \file schema.c
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Functions for table driven reading and writing of DXF
+ * entities from a declarative group code schema.
+ *
+ * Every entity type used to carry its own chain of \c strcmp () calls
+ * for reading and its own sequence of \c fprintf () calls for writing.\n
+ * With a schema the entity is described once as a table of fields
+ * (group code, value type, member offset, version range, default value)
+ * and the generic functions in this file do the parsing and formatting,
+ * so improvements to number parsing or output buffering apply to every
+ * entity type that is described by a schema.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include "schema.h"
+#include "handle.h"
+#include "stats.h"
+#include "util.h"
+
+
+#define DXF_SCHEMA_INITIAL_BUFFER_SIZE 1024
+        /*!< \brief Initial size of the output buffer of an entity. */
+
+
+/*!
+ * \brief Definition of a growing output buffer.
+ */
+typedef struct
+dxf_schema_buffer_struct
+{
+        char *data;
+                /*!< Buffer contents, not \c NUL terminated. */
+        size_t length;
+                /*!< Number of characters in the buffer. */
+        size_t max_length;
+                /*!< Number of characters that fit in the buffer. */
+        int status;
+                /*!< \c EXIT_FAILURE after a failed allocation. */
+} DxfSchemaBuffer;
+
+
+static const DxfSchemaField *dxf_schema_find_field (const DxfSchema *schema, int group_code, int *component);
+static void *dxf_schema_get_member (const DxfSchemaField *field, void *entity);
+static int dxf_schema_set_value (const DxfSchemaField *field, int component, void *entity, const char *value);
+static int dxf_schema_is_default (const DxfSchemaField *field, void *member);
+static void dxf_schema_buffer_printf (DxfSchemaBuffer *buffer, const char *format, ...);
+
+
+/*!
+ * \brief Read the group codes and values of a DXF entity with a
+ * schema.
+ *
+ * The last line read from file contained the entity name.\n
+ * Group code and value pairs are read until group code 0 is found,
+ * every pair is dispatched to the schema field with a matching group
+ * code.\n
+ * Group code 102 (application defined group markers) is skipped,
+ * group code 999 (comment) is echoed to \c stdout and unknown group
+ * codes give a warning.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_schema_read
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an input file (or device). */
+        const DxfSchema *schema,
+                /*!< a pointer to the schema of the entity. */
+        void *entity
+                /*!< a pointer to the entity. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        const DxfSchemaField *field = NULL;
+        char code_line[DXF_MAX_STRING_LENGTH];
+        char value[DXF_MAX_STRING_LENGTH];
+        char *end = NULL;
+        int group_code;
+        int component;
+        int i;
+
+        /* Do some basic checks. */
+        if ((fp == NULL) || (schema == NULL) || (entity == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        while (dxf_read_text_line (fp, code_line, DXF_MAX_STRING_LENGTH) == EXIT_SUCCESS)
+        {
+                group_code = (int) strtol (code_line, &end, 10);
+                if (end == code_line)
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () a bad group code was found while reading from: %s in line: %d.\n")),
+                          __FUNCTION__, fp->filename, fp->line_number);
+                        return (EXIT_FAILURE);
+                }
+                if (group_code == 0)
+                {
+                        dxf_stats_count_entity_read (fp, schema->type);
+#if DEBUG
+                        DXF_DEBUG_END
+#endif
+                        return (EXIT_SUCCESS);
+                }
+                if (dxf_read_text_line (fp, value, DXF_MAX_STRING_LENGTH) != EXIT_SUCCESS)
+                {
+                        break;
+                }
+                if (group_code == 102)
+                {
+                        /* Start or end of an application defined
+                         * group, the group members are read as
+                         * ordinary fields. */
+                        dxf_stats_count_skipped_group_code (fp);
+                        continue;
+                }
+                if (group_code == 999)
+                {
+                        fprintf (stdout, "DXF comment: %s\n", value);
+                        dxf_stats_count_skipped_group_code (fp);
+                        continue;
+                }
+                if (group_code == 100)
+                {
+                        for (i = 0; i < schema->number_of_fields; i++)
+                        {
+                                if ((schema->fields[i].type == DXF_SCHEMA_SUBCLASS)
+                                  && (strcmp (value, schema->fields[i].default_string) == 0))
+                                {
+                                        break;
+                                }
+                        }
+                        if (i == schema->number_of_fields)
+                        {
+                                fprintf (stderr,
+                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  __FUNCTION__, fp->filename, fp->line_number);
+                        }
+                        continue;
+                }
+                field = dxf_schema_find_field (schema, group_code, &component);
+                if (field == NULL)
+                {
+                        fprintf (stderr,
+                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
+                          __FUNCTION__, fp->filename, fp->line_number);
+                        dxf_stats_count_unknown_group_code (fp);
+                        continue;
+                }
+                if (dxf_schema_set_value (field, component, entity, value) != EXIT_SUCCESS)
+                {
+                        return (EXIT_FAILURE);
+                }
+        }
+        if (ferror (fp->fp))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () while reading from: %s in line: %d.\n")),
+                  __FUNCTION__, fp->filename, fp->line_number);
+                return (EXIT_FAILURE);
+        }
+        fprintf (stderr,
+          (_("Error in %s () unexpected end of file while reading a %s entity from: %s.\n")),
+          __FUNCTION__, schema->name, fp->filename);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_FAILURE);
+}
+
+
+/*!
+ * \brief Write a DXF entity with a schema.
+ *
+ * The fields are written in the order of the schema, starting with the
+ * entity name after group code 0.\n
+ * Fields outside their version range, \c DXF_SCHEMA_FLATLAND fields
+ * when \c DXF_FLATLAND is not enabled, \c DXF_SCHEMA_SKIP_DEFAULT
+ * fields holding their default value and \c DXF_SCHEMA_READ_ONLY
+ * fields are not written.\n
+ * The output is formatted into a buffer and written with a single
+ * call to \c fwrite ().
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_schema_write
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an output file (or device). */
+        const DxfSchema *schema,
+                /*!< a pointer to the schema of the entity. */
+        void *entity
+                /*!< a pointer to the entity. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        const DxfSchemaField *field = NULL;
+        DxfSchemaBuffer buffer;
+        DxfBinaryGraphicsData *iter = NULL;
+        void *member = NULL;
+        double *coordinates = NULL;
+        char handle[DXF_HANDLE_HEX_SIZE];
+        int status;
+        int lines;
+        int i;
+
+        /* Do some basic checks. */
+        if ((fp == NULL) || (schema == NULL) || (entity == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        buffer.data = NULL;
+        buffer.length = 0;
+        buffer.max_length = 0;
+        buffer.status = EXIT_SUCCESS;
+        dxf_schema_buffer_printf (&buffer, "  0\n%s\n", schema->name);
+        for (i = 0; i < schema->number_of_fields; i++)
+        {
+                field = &schema->fields[i];
+                if ((field->flags & DXF_SCHEMA_READ_ONLY)
+                  || ((field->min_version != DXF_SCHEMA_ANY_VERSION)
+                  && (fp->acad_version_number < field->min_version))
+                  || ((field->max_version != DXF_SCHEMA_ANY_VERSION)
+                  && (fp->acad_version_number > field->max_version))
+                  || ((field->flags & DXF_SCHEMA_FLATLAND) && !DXF_FLATLAND))
+                {
+                        continue;
+                }
+                if (field->type == DXF_SCHEMA_SUBCLASS)
+                {
+                        dxf_schema_buffer_printf (&buffer, "100\n%s\n", field->default_string);
+                        continue;
+                }
+                member = dxf_schema_get_member (field, entity);
+                if ((member == NULL)
+                  || ((field->flags & DXF_SCHEMA_SKIP_DEFAULT)
+                  && dxf_schema_is_default (field, member)))
+                {
+                        continue;
+                }
+                if ((field->type == DXF_SCHEMA_STRING)
+                  && (*(char **) member == NULL))
+                {
+                        continue;
+                }
+                if (field->group_name != NULL)
+                {
+                        dxf_schema_buffer_printf (&buffer, "102\n%s\n", field->group_name);
+                }
+                switch (field->type)
+                {
+                        case DXF_SCHEMA_HEX:
+                                dxf_handle_to_hex (*(int *) member, handle);
+                                dxf_schema_buffer_printf (&buffer, "%3d\n%s\n", field->group_code, handle);
+                                break;
+                        case DXF_SCHEMA_INT16:
+                                dxf_schema_buffer_printf (&buffer, "%3d\n%d\n", field->group_code, *(int16_t *) member);
+                                break;
+                        case DXF_SCHEMA_INT:
+                                dxf_schema_buffer_printf (&buffer, "%3d\n%d\n", field->group_code, *(int *) member);
+                                break;
+                        case DXF_SCHEMA_LONG:
+                                dxf_schema_buffer_printf (&buffer, "%3d\n%ld\n", field->group_code, *(long *) member);
+                                break;
+                        case DXF_SCHEMA_DOUBLE:
+                                dxf_schema_buffer_printf (&buffer, "%3d\n%f\n", field->group_code, *(double *) member);
+                                break;
+                        case DXF_SCHEMA_POINT:
+                                coordinates = (double *) member;
+                                dxf_schema_buffer_printf (&buffer, "%3d\n%f\n%3d\n%f\n%3d\n%f\n",
+                                  field->group_code, coordinates[0],
+                                  field->group_code + 10, coordinates[1],
+                                  field->group_code + 20, coordinates[2]);
+                                break;
+                        case DXF_SCHEMA_STRING:
+                                dxf_schema_buffer_printf (&buffer, "%3d\n%s\n", field->group_code, *(char **) member);
+                                break;
+                        case DXF_SCHEMA_BINARY_LIST:
+                                for (iter = *(DxfBinaryGraphicsData **) member; iter != NULL; iter = (DxfBinaryGraphicsData *) iter->next)
+                                {
+                                        dxf_schema_buffer_printf (&buffer, "%3d\n%s\n", field->group_code, iter->data_line);
+                                }
+                                break;
+                        default:
+                                break;
+                }
+                if (field->group_name != NULL)
+                {
+                        dxf_schema_buffer_printf (&buffer, "102\n}\n");
+                }
+        }
+        status = buffer.status;
+        if ((status == EXIT_SUCCESS)
+          && (fwrite (buffer.data, 1, buffer.length, fp->fp) != buffer.length))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () while writing to: %s.\n")),
+                  __FUNCTION__, fp->filename);
+                status = EXIT_FAILURE;
+        }
+        if ((status == EXIT_SUCCESS) && dxf_stats_enabled)
+        {
+                for (i = 0, lines = 0; (size_t) i < buffer.length; i++)
+                {
+                        lines += (buffer.data[i] == '\n');
+                }
+                dxf_stats_add_write (fp, buffer.length, lines);
+                dxf_stats_count_entity_written (fp, schema->type);
+        }
+        free (buffer.data);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (status);
+}
+
+
+/*!
+ * \brief Find the schema field for a group code.
+ *
+ * \return a pointer to the field, or \c NULL when the schema has no
+ * field for the group code.
+ */
+static const DxfSchemaField *
+dxf_schema_find_field
+(
+        const DxfSchema *schema,
+                /*!< a pointer to the schema of the entity. */
+        int group_code,
+                /*!< group code to look for. */
+        int *component
+                /*!< coordinate index (0, 1 or 2) for a point field. */
+)
+{
+        const DxfSchemaField *field = NULL;
+        int i;
+
+        for (i = 0; i < schema->number_of_fields; i++)
+        {
+                field = &schema->fields[i];
+                if (field->type == DXF_SCHEMA_SUBCLASS)
+                {
+                        continue;
+                }
+                if (field->group_code == group_code)
+                {
+                        *component = 0;
+                        return (field);
+                }
+                if ((field->type == DXF_SCHEMA_POINT)
+                  && ((group_code == field->group_code + 10)
+                  || (group_code == field->group_code + 20)))
+                {
+                        *component = (group_code - field->group_code) / 10;
+                        return (field);
+                }
+        }
+        return (NULL);
+}
+
+
+/*!
+ * \brief Get the address of the member of a schema field.
+ *
+ * \return the address of the member, or \c NULL when the struct
+ * holding an indirect member is not allocated.
+ */
+static void *
+dxf_schema_get_member
+(
+        const DxfSchemaField *field,
+                /*!< a pointer to the schema field. */
+        void *entity
+                /*!< a pointer to the entity. */
+)
+{
+        char *base = (char *) entity + field->offset;
+
+        if (field->flags & DXF_SCHEMA_INDIRECT)
+        {
+                base = *(char **) base;
+                if (base == NULL)
+                {
+                        return (NULL);
+                }
+                base += field->indirect_offset;
+        }
+        return ((void *) base);
+}
+
+
+/*!
+ * \brief Store a value that was read in the member of a schema field.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_schema_set_value
+(
+        const DxfSchemaField *field,
+                /*!< a pointer to the schema field. */
+        int component,
+                /*!< coordinate index (0, 1 or 2) for a point field. */
+        void *entity,
+                /*!< a pointer to the entity. */
+        const char *value
+                /*!< the value as read from file. */
+)
+{
+        DxfBinaryGraphicsData *data = NULL;
+        DxfBinaryGraphicsData **iter = NULL;
+        void *member = NULL;
+        char *copy = NULL;
+
+        member = dxf_schema_get_member (field, entity);
+        if (member == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () no memory was allocated for group code %d.\n")),
+                  __FUNCTION__, field->group_code);
+                return (EXIT_FAILURE);
+        }
+        switch (field->type)
+        {
+                case DXF_SCHEMA_HEX:
+                        if (dxf_handle_from_hex (value, (int *) member) != EXIT_SUCCESS)
+                        {
+                                fprintf (stderr,
+                                  (_("Warning in %s () invalid handle: %s for group code %d.\n")),
+                                  __FUNCTION__, value, field->group_code);
+                        }
+                        break;
+                case DXF_SCHEMA_INT16:
+                        *(int16_t *) member = (int16_t) strtol (value, NULL, 10);
+                        break;
+                case DXF_SCHEMA_INT:
+                        *(int *) member = (int) strtol (value, NULL, 10);
+                        break;
+                case DXF_SCHEMA_LONG:
+                        *(long *) member = strtol (value, NULL, 10);
+                        break;
+                case DXF_SCHEMA_DOUBLE:
+                        *(double *) member = strtod (value, NULL);
+                        break;
+                case DXF_SCHEMA_POINT:
+                        ((double *) member)[component] = strtod (value, NULL);
+                        break;
+                case DXF_SCHEMA_STRING:
+                        copy = dxf_string_share (value);
+                        if (copy == NULL)
+                        {
+                                return (EXIT_FAILURE);
+                        }
+                        dxf_string_free (*(char **) member);
+                        *(char **) member = copy;
+                        break;
+                case DXF_SCHEMA_BINARY_LIST:
+                        data = dxf_binary_graphics_data_new ();
+                        if (data == NULL)
+                        {
+                                return (EXIT_FAILURE);
+                        }
+                        data->data_line = strdup (value);
+                        data->length = strlen (value);
+                        for (iter = (DxfBinaryGraphicsData **) member;
+                          *iter != NULL;
+                          iter = (DxfBinaryGraphicsData **) &(*iter)->next);
+                        *iter = data;
+                        break;
+                default:
+                        break;
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Test if the member of a schema field holds its default value.
+ *
+ * \return \c TRUE when the member holds the default value, \c FALSE
+ * otherwise.
+ */
+static int
+dxf_schema_is_default
+(
+        const DxfSchemaField *field,
+                /*!< a pointer to the schema field. */
+        void *member
+                /*!< the address of the member. */
+)
+{
+        const char *string = NULL;
+        double *coordinates = NULL;
+
+        switch (field->type)
+        {
+                case DXF_SCHEMA_HEX:
+                case DXF_SCHEMA_INT:
+                        return (*(int *) member == (int) field->default_int);
+                case DXF_SCHEMA_INT16:
+                        return (*(int16_t *) member == (int16_t) field->default_int);
+                case DXF_SCHEMA_LONG:
+                        return (*(long *) member == field->default_int);
+                case DXF_SCHEMA_DOUBLE:
+                        return (*(double *) member == field->default_double[0]);
+                case DXF_SCHEMA_POINT:
+                        coordinates = (double *) member;
+                        return ((coordinates[0] == field->default_double[0])
+                          && (coordinates[1] == field->default_double[1])
+                          && (coordinates[2] == field->default_double[2]));
+                case DXF_SCHEMA_STRING:
+                        string = *(char **) member;
+                        return ((string == NULL)
+                          || (strcmp (string, (field->default_string != NULL) ? field->default_string : "") == 0));
+                case DXF_SCHEMA_BINARY_LIST:
+                        return (*(DxfBinaryGraphicsData **) member == NULL);
+                default:
+                        return (FALSE);
+        }
+}
+
+
+/*!
+ * \brief Append formatted output to a schema output buffer.
+ */
+static void
+dxf_schema_buffer_printf
+(
+        DxfSchemaBuffer *buffer,
+                /*!< a pointer to the output buffer. */
+        const char *format,
+                /*!< \c printf () style format string. */
+        ...
+)
+{
+        va_list arguments;
+        size_t max_length;
+        char *data = NULL;
+        int length;
+
+        if (buffer->status != EXIT_SUCCESS)
+        {
+                return;
+        }
+        for (;;)
+        {
+                va_start (arguments, format);
+                length = vsnprintf (buffer->data + buffer->length,
+                  buffer->max_length - buffer->length, format, arguments);
+                va_end (arguments);
+                if (length < 0)
+                {
+                        buffer->status = EXIT_FAILURE;
+                        return;
+                }
+                if ((size_t) length < buffer->max_length - buffer->length)
+                {
+                        buffer->length += length;
+                        return;
+                }
+                max_length = (buffer->max_length > 0) ? 2 * buffer->max_length : DXF_SCHEMA_INITIAL_BUFFER_SIZE;
+                while (max_length <= buffer->length + length)
+                {
+                        max_length *= 2;
+                }
+                data = realloc (buffer->data, max_length);
+                if (data == NULL)
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () could not allocate memory.\n")),
+                          __FUNCTION__);
+                        buffer->status = EXIT_FAILURE;
+                        return;
+                }
+                buffer->data = data;
+                buffer->max_length = max_length;
+        }
+}
+
+
+/* EOF */
@@ -0,0 +1,178 @@
+/*!
+ * \file schema.h
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Header file for table driven reading and writing of DXF
+ * entities from a declarative group code schema.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#ifndef LIBDXF_SRC_SCHEMA_H
+#define LIBDXF_SRC_SCHEMA_H
+
+
+#include "global.h"
+#include "binary_graphics_data.h"
+#include <stddef.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define DXF_SCHEMA_ANY_VERSION 0
+        /*!< \brief Value of the \c min_version or \c max_version
+         * member of a schema field without a version limit. */
+
+#define DXF_SCHEMA_SKIP_DEFAULT 1
+        /*!< \brief Flag: do not write the field when it holds its
+         * default value. */
+
+#define DXF_SCHEMA_FLATLAND 2
+        /*!< \brief Flag: only write the field when \c DXF_FLATLAND is
+         * enabled. */
+
+#define DXF_SCHEMA_INDIRECT 4
+        /*!< \brief Flag: the member at \c offset is a pointer to the
+         * struct holding the field at \c indirect_offset. */
+
+#define DXF_SCHEMA_READ_ONLY 8
+        /*!< \brief Flag: accept the group code when reading, but never
+         * write it (e.g. an alternative group code). */
+
+
+/*!
+ * \brief Value types of the fields in a schema.
+ */
+typedef enum
+dxf_schema_type
+{
+        DXF_SCHEMA_HEX,
+                /*!< \c int written as a hexadecimal handle. */
+        DXF_SCHEMA_INT16,
+                /*!< \c int16_t. */
+        DXF_SCHEMA_INT,
+                /*!< \c int. */
+        DXF_SCHEMA_LONG,
+                /*!< \c long. */
+        DXF_SCHEMA_DOUBLE,
+                /*!< \c double. */
+        DXF_SCHEMA_POINT,
+                /*!< Three consecutive \c double members, read and
+                 * written with group codes \c group_code,
+                 * \c group_code + 10 and \c group_code + 20. */
+        DXF_SCHEMA_STRING,
+                /*!< \c char pointer, owned or shared, see
+                 * dxf_string_share (). */
+        DXF_SCHEMA_BINARY_LIST,
+                /*!< Pointer to a single linked list of
+                 * \c DxfBinaryGraphicsData, one line per item, items
+                 * that are read are appended. */
+        DXF_SCHEMA_SUBCLASS
+                /*!< Subclass marker (group code 100), the marker is
+                 * \c default_string, no member is stored. */
+} DxfSchemaType;
+
+
+/*!
+ * \brief Definition of a single field in an entity schema.
+ */
+typedef struct
+dxf_schema_field_struct
+{
+        int group_code;
+                /*!< Group code of the field. */
+        DxfSchemaType type;
+                /*!< Value type of the field. */
+        size_t offset;
+                /*!< Offset of the member in the entity struct, or of
+                 * the pointer to the struct holding the member. */
+        size_t indirect_offset;
+                /*!< Offset of the member in the struct pointed to by
+                 * the member at \c offset, only used with the
+                 * \c DXF_SCHEMA_INDIRECT flag. */
+        int min_version;
+                /*!< Lowest AutoCAD version number to write the field
+                 * for, or \c DXF_SCHEMA_ANY_VERSION. */
+        int max_version;
+                /*!< Highest AutoCAD version number to write the field
+                 * for, or \c DXF_SCHEMA_ANY_VERSION. */
+        int flags;
+                /*!< Bit coded flags (\c DXF_SCHEMA_SKIP_DEFAULT,
+                 * \c DXF_SCHEMA_FLATLAND, \c DXF_SCHEMA_INDIRECT,
+                 * \c DXF_SCHEMA_READ_ONLY). */
+        long default_int;
+                /*!< Default value of an integer field. */
+        double default_double[3];
+                /*!< Default value of a \c double field, or of the
+                 * three coordinates of a point field. */
+        const char *default_string;
+                /*!< Default value of a string field, or the subclass
+                 * marker of a subclass field. */
+        const char *group_name;
+                /*!< Name of the application defined group (group code
+                 * 102) to wrap the field in when writing, e.g.
+                 * "{ACAD_REACTORS", or \c NULL. */
+} DxfSchemaField;
+
+
+/*!
+ * \brief Definition of an entity schema.
+ *
+ * The fields are written in the order of the table, reading dispatches
+ * on the group code and accepts any order.
+ */
+typedef struct
+dxf_schema_struct
+{
+        const char *name;
+                /*!< Entity name as written after group code 0. */
+        DxfEntityType type;
+                /*!< Entity type, for the statistics. */
+        const DxfSchemaField *fields;
+                /*!< Table of fields. */
+        int number_of_fields;
+                /*!< Number of fields in the table. */
+} DxfSchema;
+
+
+int dxf_schema_read (DxfFile *fp, const DxfSchema *schema, void *entity);
+int dxf_schema_write (DxfFile *fp, const DxfSchema *schema, void *entity);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* LIBDXF_SRC_SCHEMA_H */
+
+
+/* EOF */
@@ -38,25 +38,37 @@
 
 
 #include "section.h"
+#include "drawing.h"
+#include "stats.h"
 
 
 /*!
  * \brief Function reads a SECTION in a DXF file.
+ *
+ * The parsed data is stored in \c drawing, reading stops at the
+ * \c ENDSEC keyword or at the end of the file.
+ *
+ * \note This function is reentrant, it keeps no state outside of
+ * \c fp and \c drawing.
  */
 int
 dxf_section_read
 (
-        DxfFile *fp
+        DxfFile *fp,
                 /*!< DXF file handle of input file (or device). */
+        DxfDrawing *drawing
+                /*!< a pointer to the drawing receiving the parsed
+                 * data. */
 )
 {
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         char temp_string[DXF_MAX_STRING_LENGTH];
-        DxfHeader dxf_header;
-        DxfBlock dxf_block;
+        int acad_version_number = 0;
         char *dxf_entities_list = NULL;
+        DxfStatsSection section;
+        double start;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -66,31 +78,71 @@ dxf_section_read
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
+        if (drawing == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (drawing->header != NULL)
+        {
+                acad_version_number = ((DxfHeader *) drawing->header)->_AcadVer;
+        }
         memset(temp_string, 0, sizeof(temp_string));
         dxf_read_line (temp_string, fp);
-        if (strcmp (temp_string, "2") == 0)
+        /* Group codes may be padded with leading spaces. */
+        if (strcmp (temp_string + strspn (temp_string, " "), "2") == 0)
         {
-                while (!feof (fp->fp)) /* Does this actually work? */
+                while (!feof (fp->fp) && !ferror (fp->fp))
                 {
                         memset(temp_string, 0, sizeof(temp_string));
-                        dxf_read_line (temp_string, fp);
+                        if (dxf_read_line (temp_string, fp) <= 0)
+                        {
+                                /* Nothing left to read. */
+                                break;
+                        }
+                        if (strcmp (temp_string, "ENDSEC") == 0)
+                        {
+                                /* We have found the end of the section. */
+                                break;
+                        }
+                        section = DXF_STATS_NUMBER_OF_SECTIONS;
+                        start = dxf_stats_get_time ();
                         if (strcmp (temp_string, "HEADER") == 0)
                         {
+                                section = DXF_STATS_SECTION_HEADER;
                                 /* We have found the begin of the HEADER section. */
-                                dxf_header_read (fp, &dxf_header);
+                                if (drawing->header == NULL)
+                                {
+                                        drawing->header = (struct DxfHeader *) dxf_header_new ();
+                                }
+                                if (drawing->header != NULL)
+                                {
+                                        dxf_header_read (fp, (DxfHeader *) drawing->header);
+                                        acad_version_number = ((DxfHeader *) drawing->header)->_AcadVer;
+                                        if (((DxfHeader *) drawing->header)->HandSeed != NULL)
+                                        {
+                                                dxf_handle_allocator_set_seed_hex (&drawing->handles,
+                                                  ((DxfHeader *) drawing->header)->HandSeed);
+                                        }
+                                }
                         }
                         else if (strcmp (temp_string, "CLASSES") == 0)
                         {
+                                section = DXF_STATS_SECTION_CLASSES;
                                 /* We have found the begin of the CLASSES sction. */
                                 /*! \todo Invoke a function for parsing the \c CLASSES section. */ 
                         }
                         else if (strcmp (temp_string, "TABLES") == 0)
                         {
+                                section = DXF_STATS_SECTION_TABLES;
                                 /* We have found the begin of the TABLES sction. */
                                 /*! \todo Invoke a function for parsing the \c TABLES section. */ 
                         }
                         else if (strcmp (temp_string, "BLOCKS") == 0)
                         {
+                                section = DXF_STATS_SECTION_BLOCKS;
                                 /* We have found the begin of the BLOCKS sction. */
 
                                 /*! \todo Experimental usage of block_read */
@@ -103,22 +155,28 @@ dxf_section_read
                         }
                         else if (strcmp (temp_string, "ENTITIES") == 0)
                         {
+                                section = DXF_STATS_SECTION_ENTITIES;
                                 /* We have found the begin of the ENTITIES sction. */
                                 dxf_entities_read_table (fp->filename,
                                                    fp->fp,
                                                    fp->line_number,
                                                    dxf_entities_list,
-                                                   dxf_header._AcadVer);                        }
+                                                   acad_version_number);                        }
                         else if (strcmp (temp_string, "OBJECTS") == 0)
                         {
+                                section = DXF_STATS_SECTION_OBJECTS;
                                 /* We have found the begin of the OBJECTS sction. */
                                 /*! \todo Invoke a function for parsing the \c OBJECTS section. */ 
                         }
                         else if (strcmp (temp_string, "THUMBNAIL") == 0)
                         {
+                                section = DXF_STATS_SECTION_THUMBNAIL;
                                 /* We have found the begin of the THUMBNAIL sction. */
                                 /*! \todo Invoke a function for parsing the \c THUMBNAIL section. */ 
                         }
+                        /* Sections are only timed when the statistics are
+                         * enabled, see dxf_stats_enable (). */
+                        dxf_stats_add_section_time (fp, section, dxf_stats_get_time () - start);
                 }
         }
         else
@@ -51,7 +51,12 @@ extern "C" {
 #endif
 
 
-int dxf_section_read (DxfFile *fp);
+struct dxf_drawing_struct;
+        /* Declared in drawing.h, which can not be included here
+         * without creating an include cycle. */
+
+
+int dxf_section_read (DxfFile *fp, struct dxf_drawing_struct *drawing);
 int dxf_section_write (DxfFile *fp, char *section_name);
 
 
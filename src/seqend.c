@@ -42,6 +42,7 @@
 
 
 #include "seqend.h"
+#include "util.h"
 
 
 /*!
@@ -115,8 +116,8 @@ dxf_seqend_init
               return (NULL);
         }
         seqend->id_code = 0;
-        seqend->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        seqend->layer = strdup (DXF_DEFAULT_LAYER);
+        seqend->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        seqend->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         seqend->elevation = 0.0;
         seqend->thickness = 0.0;
         seqend->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
@@ -125,17 +126,16 @@ dxf_seqend_init
         seqend->paperspace = DXF_MODELSPACE;
         seqend->graphics_data_size = 0;
         seqend->shadow_mode = 0;
-        seqend->binary_graphics_data = dxf_binary_graphics_data_new ();
-        seqend->binary_graphics_data = dxf_binary_graphics_data_init (seqend->binary_graphics_data);
-        seqend->dictionary_owner_soft = strdup ("");
-        seqend->material = strdup ("");
-        seqend->dictionary_owner_hard = strdup ("");
+        seqend->binary_graphics_data = NULL;
+        seqend->dictionary_owner_soft = dxf_string_share ("");
+        seqend->material = dxf_string_share ("");
+        seqend->dictionary_owner_hard = dxf_string_share ("");
         seqend->lineweight = 0;
-        seqend->plot_style_name = strdup ("");
+        seqend->plot_style_name = dxf_string_share ("");
         seqend->color_value = 0;
-        seqend->color_name = strdup ("");
+        seqend->color_name = dxf_string_share ("");
         seqend->transparency = 0;
-        seqend->app_name = strdup ("");
+        seqend->app_name = dxf_string_share ("");
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -204,8 +204,7 @@ dxf_seqend_read
                 {
                         /* Now follows a string containing an application
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", seqend->app_name);
+                        dxf_read_string (fp, &seqend->app_name);
                 }
                 else if (strcmp (temp_string, "5") == 0)
                 {
@@ -218,14 +217,12 @@ dxf_seqend_read
                 {
                         /* Now follows a string containing a linetype
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", seqend->linetype);
+                        dxf_read_string (fp, &seqend->linetype);
                 }
                 else if (strcmp (temp_string, "8") == 0)
                 {
                         /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", seqend->layer);
+                        dxf_read_string (fp, &seqend->layer);
                 }
                 else if (strcmp (temp_string, "38") == 0)
                 {
@@ -301,31 +298,25 @@ dxf_seqend_read
                 {
                         /* Now follows a string containing binary
                          * graphics data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", seqend->binary_graphics_data->data_line);
-                        dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) seqend->binary_graphics_data->next);
-                        seqend->binary_graphics_data = (DxfBinaryGraphicsData *) seqend->binary_graphics_data->next;
+                        dxf_binary_graphics_data_read (fp, &seqend->binary_graphics_data, NULL);
                 }
                 else if (strcmp (temp_string, "330") == 0)
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", seqend->dictionary_owner_soft);
+                        dxf_read_string (fp, &seqend->dictionary_owner_soft);
                 }
                 else if (strcmp (temp_string, "347") == 0)
                 {
                         /* Now follows a string containing a
                          * hard-pointer ID/handle to material object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", seqend->material);
+                        dxf_read_string (fp, &seqend->material);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", seqend->dictionary_owner_hard);
+                        dxf_read_string (fp, &seqend->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "370") == 0)
                 {
@@ -338,8 +329,7 @@ dxf_seqend_read
                 {
                         /* Now follows a string containing a plot style
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", seqend->plot_style_name);
+                        dxf_read_string (fp, &seqend->plot_style_name);
                 }
                 else if (strcmp (temp_string, "420") == 0)
                 {
@@ -351,8 +341,7 @@ dxf_seqend_read
                 {
                         /* Now follows a string containing a color
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", seqend->color_name);
+                        dxf_read_string (fp, &seqend->color_name);
                 }
                 else if (strcmp (temp_string, "440") == 0)
                 {
@@ -378,11 +367,13 @@ dxf_seqend_read
         /* Handle omitted members and/or illegal values. */
         if (strcmp (seqend->linetype, "") == 0)
         {
-                seqend->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (seqend->linetype);
+                seqend->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (seqend->layer, "") == 0)
         {
-                seqend->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (seqend->layer);
+                seqend->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Clean up. */
         free (temp_string);
@@ -448,7 +439,8 @@ dxf_seqend_write
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                seqend->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (seqend->linetype);
+                seqend->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (seqend->layer, "") == 0)
         {
@@ -600,15 +592,18 @@ dxf_seqend_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (seqend->linetype);
-        free (seqend->layer);
-        dxf_binary_graphics_data_free_list (seqend->binary_graphics_data);
-        free (seqend->dictionary_owner_soft);
-        free (seqend->material);
-        free (seqend->dictionary_owner_hard);
-        free (seqend->plot_style_name);
-        free (seqend->color_name);
-        free (seqend->app_name);
+        dxf_string_free (seqend->linetype);
+        dxf_string_free (seqend->layer);
+        if (seqend->binary_graphics_data != NULL)
+        {
+                dxf_binary_graphics_data_free_list (seqend->binary_graphics_data);
+        }
+        dxf_string_free (seqend->dictionary_owner_soft);
+        dxf_string_free (seqend->material);
+        dxf_string_free (seqend->dictionary_owner_hard);
+        dxf_string_free (seqend->plot_style_name);
+        dxf_string_free (seqend->color_name);
+        dxf_string_free (seqend->app_name);
         free (seqend);
         seqend = NULL;
 #if DEBUG
@@ -746,6 +741,8 @@ dxf_seqend_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (seqend == NULL)
         {
@@ -761,7 +758,13 @@ dxf_seqend_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        seqend->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (seqend->linetype);
+        seqend->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -822,6 +825,8 @@ dxf_seqend_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (seqend == NULL)
         {
@@ -837,7 +842,13 @@ dxf_seqend_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        seqend->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (seqend->layer);
+        seqend->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1629,6 +1640,8 @@ dxf_seqend_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (seqend == NULL)
         {
@@ -1644,7 +1657,13 @@ dxf_seqend_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        seqend->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (seqend->dictionary_owner_soft);
+        seqend->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1711,6 +1730,8 @@ dxf_seqend_set_material
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (seqend == NULL)
         {
@@ -1726,7 +1747,13 @@ dxf_seqend_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        seqend->material = strdup (material);
+        copy = dxf_string_share (material);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (seqend->material);
+        seqend->material = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1791,6 +1818,8 @@ dxf_seqend_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (seqend == NULL)
         {
@@ -1806,7 +1835,13 @@ dxf_seqend_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        seqend->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (seqend->dictionary_owner_hard);
+        seqend->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1936,6 +1971,8 @@ dxf_seqend_set_plot_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (seqend == NULL)
         {
@@ -1951,7 +1988,13 @@ dxf_seqend_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        seqend->plot_style_name = strdup (plot_style_name);
+        copy = dxf_string_share (plot_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (seqend->plot_style_name);
+        seqend->plot_style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2081,6 +2124,8 @@ dxf_seqend_set_color_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (seqend == NULL)
         {
@@ -2096,7 +2141,13 @@ dxf_seqend_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        seqend->color_name = strdup (color_name);
+        copy = dxf_string_share (color_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (seqend->color_name);
+        seqend->color_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2226,6 +2277,8 @@ dxf_seqend_set_app_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (seqend == NULL)
         {
@@ -2241,7 +2294,13 @@ dxf_seqend_set_app_name
                   __FUNCTION__);
                 return (NULL);
         }
-        seqend->app_name = strdup (app_name);
+        copy = dxf_string_share (app_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (seqend->app_name);
+        seqend->app_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -42,6 +42,8 @@
 
 
 #include "shape.h"
+#include "stats.h"
+#include "util.h"
 
 
 /*!
@@ -74,6 +76,7 @@ dxf_shape_new ()
         else
         {
                 memset (shape, 0, size);
+                dxf_stats_count_allocation (SHAPE, size);
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -115,8 +118,8 @@ dxf_shape_init
               return (NULL);
         }
         shape->id_code = 0;
-        shape->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        shape->layer = strdup (DXF_DEFAULT_LAYER);
+        shape->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        shape->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         shape->elevation = 0.0;
         shape->thickness = 0.0;
         shape->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
@@ -125,17 +128,20 @@ dxf_shape_init
         shape->paperspace = DXF_MODELSPACE;
         shape->graphics_data_size = 0;
         shape->shadow_mode = 0;
-        shape->binary_graphics_data = dxf_binary_graphics_data_new ();
-        shape->binary_graphics_data = dxf_binary_graphics_data_init (shape->binary_graphics_data);
-        shape->dictionary_owner_soft = strdup ("");
-        shape->material = strdup ("");
-        shape->dictionary_owner_hard = strdup ("");
+        shape->binary_graphics_data = NULL;
+        shape->dictionary_owner_soft = dxf_string_share ("");
+        shape->material = dxf_string_share ("");
+        shape->dictionary_owner_hard = dxf_string_share ("");
         shape->lineweight = 0;
-        shape->plot_style_name = strdup ("");
+        shape->plot_style_name = dxf_string_share ("");
         shape->color_value = 0;
-        shape->color_name = strdup ("");
+        shape->color_name = dxf_string_share ("");
         shape->transparency = 0;
-        shape->shape_name = strdup ("");
+        shape->shape_name = dxf_string_share ("");
+        if (shape->p0 == NULL)
+        {
+                shape->p0 = (DxfPoint *) dxf_point_new ();
+        }
         shape->p0->x0 = 0.0;
         shape->p0->y0 = 0.0;
         shape->p0->z0 = 0.0;
@@ -215,8 +221,7 @@ dxf_shape_read
                 {
                         /* Now follows a string containing a shape
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", shape->shape_name);
+                        dxf_read_string (fp, &shape->shape_name);
                 }
                 else if (strcmp (temp_string, "5") == 0)
                 {
@@ -229,14 +234,12 @@ dxf_shape_read
                 {
                         /* Now follows a string containing a linetype
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", shape->linetype);
+                        dxf_read_string (fp, &shape->linetype);
                 }
                 else if (strcmp (temp_string, "8") == 0)
                 {
                         /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", shape->layer);
+                        dxf_read_string (fp, &shape->layer);
                 }
                 else if (strcmp (temp_string, "10") == 0)
                 {
@@ -383,31 +386,25 @@ dxf_shape_read
                 {
                         /* Now follows a string containing binary
                          * graphics data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", shape->binary_graphics_data->data_line);
-                        dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) shape->binary_graphics_data->next);
-                        shape->binary_graphics_data = (DxfBinaryGraphicsData *) shape->binary_graphics_data->next;
+                        dxf_binary_graphics_data_read (fp, &shape->binary_graphics_data, NULL);
                 }
                 else if (strcmp (temp_string, "330") == 0)
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", shape->dictionary_owner_soft);
+                        dxf_read_string (fp, &shape->dictionary_owner_soft);
                 }
                 else if (strcmp (temp_string, "347") == 0)
                 {
                         /* Now follows a string containing a
                          * hard-pointer ID/handle to material object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", shape->material);
+                        dxf_read_string (fp, &shape->material);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", shape->dictionary_owner_hard);
+                        dxf_read_string (fp, &shape->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "370") == 0)
                 {
@@ -420,8 +417,7 @@ dxf_shape_read
                 {
                         /* Now follows a string containing a plot style
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", shape->plot_style_name);
+                        dxf_read_string (fp, &shape->plot_style_name);
                 }
                 else if (strcmp (temp_string, "420") == 0)
                 {
@@ -433,8 +429,7 @@ dxf_shape_read
                 {
                         /* Now follows a string containing a color
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", shape->color_name);
+                        dxf_read_string (fp, &shape->color_name);
                 }
                 else if (strcmp (temp_string, "440") == 0)
                 {
@@ -467,11 +462,13 @@ dxf_shape_read
         }
         if (strcmp (shape->linetype, "") == 0)
         {
-                shape->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (shape->linetype);
+                shape->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (shape->layer, "") == 0)
         {
-                shape->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (shape->layer);
+                shape->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Clean up. */
         free (temp_string);
@@ -538,7 +535,8 @@ dxf_shape_write
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                shape->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (shape->linetype);
+                shape->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (shape->layer, "") == 0)
         {
@@ -548,7 +546,8 @@ dxf_shape_write
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0")),
                   dxf_entity_name);
-                shape->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (shape->layer);
+                shape->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         if (shape->size == 0.0)
         {
@@ -743,15 +742,18 @@ dxf_shape_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (shape->linetype);
-        free (shape->layer);
-        dxf_binary_graphics_data_free_list (shape->binary_graphics_data);
-        free (shape->dictionary_owner_soft);
-        free (shape->material);
-        free (shape->dictionary_owner_hard);
-        free (shape->plot_style_name);
-        free (shape->color_name);
-        free (shape->shape_name);
+        dxf_string_free (shape->linetype);
+        dxf_string_free (shape->layer);
+        if (shape->binary_graphics_data != NULL)
+        {
+                dxf_binary_graphics_data_free_list (shape->binary_graphics_data);
+        }
+        dxf_string_free (shape->dictionary_owner_soft);
+        dxf_string_free (shape->material);
+        dxf_string_free (shape->dictionary_owner_hard);
+        dxf_string_free (shape->plot_style_name);
+        dxf_string_free (shape->color_name);
+        dxf_string_free (shape->shape_name);
         dxf_point_free (shape->p0);
         free (shape);
         shape = NULL;
@@ -923,6 +925,8 @@ dxf_shape_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (shape == NULL)
         {
@@ -938,7 +942,13 @@ dxf_shape_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        shape->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (shape->linetype);
+        shape->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -999,6 +1009,8 @@ dxf_shape_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (shape == NULL)
         {
@@ -1014,7 +1026,13 @@ dxf_shape_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        shape->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (shape->layer);
+        shape->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1792,6 +1810,8 @@ dxf_shape_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (shape == NULL)
         {
@@ -1807,7 +1827,13 @@ dxf_shape_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        shape->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (shape->dictionary_owner_soft);
+        shape->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1874,6 +1900,8 @@ dxf_shape_set_material
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (shape == NULL)
         {
@@ -1889,7 +1917,13 @@ dxf_shape_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        shape->material = strdup (material);
+        copy = dxf_string_share (material);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (shape->material);
+        shape->material = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1954,6 +1988,8 @@ dxf_shape_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (shape == NULL)
         {
@@ -1969,7 +2005,13 @@ dxf_shape_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        shape->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (shape->dictionary_owner_hard);
+        shape->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2099,6 +2141,8 @@ dxf_shape_set_plot_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (shape == NULL)
         {
@@ -2114,7 +2158,13 @@ dxf_shape_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        shape->plot_style_name = strdup (plot_style_name);
+        copy = dxf_string_share (plot_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (shape->plot_style_name);
+        shape->plot_style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2244,6 +2294,8 @@ dxf_shape_set_color_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (shape == NULL)
         {
@@ -2259,7 +2311,13 @@ dxf_shape_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        shape->color_name = strdup (color_name);
+        copy = dxf_string_share (color_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (shape->color_name);
+        shape->color_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
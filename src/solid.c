@@ -49,6 +49,8 @@
 
 
 #include "solid.h"
+#include "stats.h"
+#include "util.h"
 
 
 /*!
@@ -80,6 +82,7 @@ dxf_solid_new ()
         else
         {
                 memset (solid, 0, size);
+                dxf_stats_count_allocation (SOLID, size);
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -120,8 +123,8 @@ dxf_solid_init
                 return (NULL);
         }
         solid->id_code = 0;
-        solid->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        solid->layer = strdup (DXF_DEFAULT_LAYER);
+        solid->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        solid->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         solid->elevation = 0.0;
         solid->thickness = 0.0;
         solid->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
@@ -130,15 +133,14 @@ dxf_solid_init
         solid->paperspace = DXF_MODELSPACE;
         solid->graphics_data_size = 0;
         solid->shadow_mode = 0;
-        solid->binary_graphics_data = dxf_binary_graphics_data_new ();
-        solid->binary_graphics_data = dxf_binary_graphics_data_init (solid->binary_graphics_data);
-        solid->dictionary_owner_soft = strdup ("");
-        solid->material = strdup ("");
-        solid->dictionary_owner_hard = strdup ("");
+        solid->binary_graphics_data = NULL;
+        solid->dictionary_owner_soft = dxf_string_share ("");
+        solid->material = dxf_string_share ("");
+        solid->dictionary_owner_hard = dxf_string_share ("");
         solid->lineweight = 0;
-        solid->plot_style_name = strdup ("");
+        solid->plot_style_name = dxf_string_share ("");
         solid->color_value = 0;
-        solid->color_name = strdup ("");
+        solid->color_name = dxf_string_share ("");
         solid->transparency = 0;
         solid->p0 = (DxfPoint *) dxf_point_new ();
         solid->p0 = (DxfPoint *) dxf_point_init ((DxfPoint *) solid->p0);
@@ -272,14 +274,12 @@ dxf_solid_read
                 {
                         /* Now follows a string containing a linetype
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", solid->linetype);
+                        dxf_read_string (fp, &solid->linetype);
                 }
                 else if (strcmp (temp_string, "8") == 0)
                 {
                         /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", solid->layer);
+                        dxf_read_string (fp, &solid->layer);
                 }
                 else if (strcmp (temp_string, "10") == 0)
                 {
@@ -464,31 +464,25 @@ dxf_solid_read
                 {
                         /* Now follows a string containing binary
                          * graphics data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", solid->binary_graphics_data->data_line);
-                        dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) solid->binary_graphics_data->next);
-                        solid->binary_graphics_data = (DxfBinaryGraphicsData *) solid->binary_graphics_data->next;
+                        dxf_binary_graphics_data_read (fp, &solid->binary_graphics_data, NULL);
                 }
                 else if (strcmp (temp_string, "330") == 0)
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", solid->dictionary_owner_soft);
+                        dxf_read_string (fp, &solid->dictionary_owner_soft);
                 }
                 else if (strcmp (temp_string, "347") == 0)
                 {
                         /* Now follows a string containing a
                          * hard-pointer ID/handle to material object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", solid->material);
+                        dxf_read_string (fp, &solid->material);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", solid->dictionary_owner_hard);
+                        dxf_read_string (fp, &solid->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "370") == 0)
                 {
@@ -501,8 +495,7 @@ dxf_solid_read
                 {
                         /* Now follows a string containing a plot style
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", solid->plot_style_name);
+                        dxf_read_string (fp, &solid->plot_style_name);
                 }
                 else if (strcmp (temp_string, "420") == 0)
                 {
@@ -514,8 +507,7 @@ dxf_solid_read
                 {
                         /* Now follows a string containing a color
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", solid->color_name);
+                        dxf_read_string (fp, &solid->color_name);
                 }
                 else if (strcmp (temp_string, "440") == 0)
                 {
@@ -541,11 +533,13 @@ dxf_solid_read
         /* Handle omitted members and/or illegal values. */
         if (strcmp (solid->linetype, "") == 0)
         {
-                solid->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (solid->linetype);
+                solid->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (solid->layer, "") == 0)
         {
-                solid->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (solid->layer);
+                solid->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Clean up. */
         free (temp_string);
@@ -603,7 +597,8 @@ dxf_solid_write
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                solid->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (solid->linetype);
+                solid->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (solid->layer, "") == 0)
         {
@@ -613,7 +608,8 @@ dxf_solid_write
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0")),
                   dxf_entity_name);
-                solid->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (solid->layer);
+                solid->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         if (solid->p0 == NULL)
         {
@@ -822,10 +818,30 @@ dxf_solid_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (solid->linetype);
-        free (solid->layer);
-        free (solid->dictionary_owner_soft);
-        free (solid->dictionary_owner_hard);
+        dxf_string_free (solid->linetype);
+        dxf_string_free (solid->layer);
+        dxf_string_free (solid->dictionary_owner_soft);
+        dxf_string_free (solid->dictionary_owner_hard);
+        if (solid->binary_graphics_data != NULL)
+        {
+                dxf_binary_graphics_data_free_list (solid->binary_graphics_data);
+        }
+        if (solid->p0 != NULL)
+        {
+                dxf_point_free (solid->p0);
+        }
+        if (solid->p1 != NULL)
+        {
+                dxf_point_free (solid->p1);
+        }
+        if (solid->p2 != NULL)
+        {
+                dxf_point_free (solid->p2);
+        }
+        if (solid->p3 != NULL)
+        {
+                dxf_point_free (solid->p3);
+        }
         free (solid);
         solid = NULL;
 #if DEBUG
@@ -996,6 +1012,8 @@ dxf_solid_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (solid == NULL)
         {
@@ -1011,7 +1029,13 @@ dxf_solid_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        solid->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (solid->linetype);
+        solid->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1072,6 +1096,8 @@ dxf_solid_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (solid == NULL)
         {
@@ -1087,7 +1113,13 @@ dxf_solid_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        solid->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (solid->layer);
+        solid->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1862,6 +1894,8 @@ dxf_solid_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (solid == NULL)
         {
@@ -1877,7 +1911,13 @@ dxf_solid_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        solid->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (solid->dictionary_owner_soft);
+        solid->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1944,6 +1984,8 @@ dxf_solid_set_material
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (solid == NULL)
         {
@@ -1959,7 +2001,13 @@ dxf_solid_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        solid->material = strdup (material);
+        copy = dxf_string_share (material);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (solid->material);
+        solid->material = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2024,6 +2072,8 @@ dxf_solid_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (solid == NULL)
         {
@@ -2039,7 +2089,13 @@ dxf_solid_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        solid->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (solid->dictionary_owner_hard);
+        solid->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2169,6 +2225,8 @@ dxf_solid_set_plot_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (solid == NULL)
         {
@@ -2184,7 +2242,13 @@ dxf_solid_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        solid->plot_style_name = strdup (plot_style_name);
+        copy = dxf_string_share (plot_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (solid->plot_style_name);
+        solid->plot_style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2314,6 +2378,8 @@ dxf_solid_set_color_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (solid == NULL)
         {
@@ -2329,7 +2395,13 @@ dxf_solid_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        solid->color_name = strdup (color_name);
+        copy = dxf_string_share (color_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (solid->color_name);
+        solid->color_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
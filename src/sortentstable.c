@@ -51,6 +51,7 @@
 
 
 #include "sortentstable.h"
+#include "util.h"
 
 
 /*!
@@ -121,11 +122,11 @@ dxf_sortentstable_init
                 return (NULL);
         }
         sortentstable->id_code = 0;
-        sortentstable->dictionary_owner_soft = strdup ("");
-        sortentstable->dictionary_owner_hard = strdup ("");
-        sortentstable->block_owner = strdup ("");
+        sortentstable->dictionary_owner_soft = dxf_string_share ("");
+        sortentstable->dictionary_owner_hard = dxf_string_share ("");
+        sortentstable->block_owner = dxf_string_share ("");
         sortentstable->entity_owner = dxf_char_init (sortentstable->entity_owner);
-        sortentstable->sort_handle->value = 0;
+        sortentstable->sort_handle = dxf_int_init (sortentstable->sort_handle);
         sortentstable->next = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -244,8 +245,7 @@ dxf_sortentstable_read
                 {
                         /* Now follows a string containing a soft-pointer
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", sortentstable->dictionary_owner_soft);
+                        dxf_read_string (fp, &sortentstable->dictionary_owner_soft);
                         j++;
                 }
                 else if ((strcmp (temp_string, "330") == 0)
@@ -254,8 +254,7 @@ dxf_sortentstable_read
                         /* Now follows a string containing a soft pointer
                          * ID/handle to owner (currently only the
                          * *MODEL_SPACE or *PAPER_SPACE blocks). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", sortentstable->block_owner);
+                        dxf_read_string (fp, &sortentstable->block_owner);
                         j++;
                         /*! \todo Check for overrun of array index. */
                 }
@@ -273,8 +272,7 @@ dxf_sortentstable_read
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", sortentstable->dictionary_owner_hard);
+                        dxf_read_string (fp, &sortentstable->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "999") == 0)
                 {
@@ -441,9 +439,9 @@ dxf_sortentstable_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (sortentstable->dictionary_owner_soft);
-        free (sortentstable->dictionary_owner_hard);
-        free (sortentstable->block_owner);
+        dxf_string_free (sortentstable->dictionary_owner_soft);
+        dxf_string_free (sortentstable->dictionary_owner_hard);
+        dxf_string_free (sortentstable->block_owner);
         dxf_char_free_list (sortentstable->entity_owner);
         free (sortentstable);
         sortentstable = NULL;
@@ -619,6 +617,8 @@ dxf_sortentstable_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (sortentstable == NULL)
         {
@@ -634,7 +634,13 @@ dxf_sortentstable_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        sortentstable->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (sortentstable->dictionary_owner_soft);
+        sortentstable->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -699,6 +705,8 @@ dxf_sortentstable_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (sortentstable == NULL)
         {
@@ -714,7 +722,13 @@ dxf_sortentstable_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        sortentstable->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (sortentstable->dictionary_owner_hard);
+        sortentstable->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -779,6 +793,8 @@ dxf_sortentstable_set_block_owner
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (sortentstable == NULL)
         {
@@ -794,7 +810,13 @@ dxf_sortentstable_set_block_owner
                   __FUNCTION__);
                 return (NULL);
         }
-        sortentstable->block_owner = strdup (block_owner);
+        copy = dxf_string_share (block_owner);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (sortentstable->block_owner);
+        sortentstable->block_owner = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
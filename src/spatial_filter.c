@@ -42,6 +42,7 @@
 
 
 #include "spatial_filter.h"
+#include "util.h"
 
 
 /*!
@@ -114,14 +115,12 @@ dxf_spatial_filter_init
                 return (NULL);
         }
         spatial_filter->id_code = 0;
-        spatial_filter->dictionary_owner_soft = strdup ("");
-        spatial_filter->dictionary_owner_hard = strdup ("");
+        spatial_filter->dictionary_owner_soft = dxf_string_share ("");
+        spatial_filter->dictionary_owner_hard = dxf_string_share ("");
         spatial_filter->p0 = dxf_point_new ();
-        spatial_filter->p0 = dxf_point_init (spatial_filter->p0);
         spatial_filter->p0->x0 = 0.0;
         spatial_filter->p0->y0 = 0.0;
         spatial_filter->p1 = dxf_point_new ();
-        spatial_filter->p1 = dxf_point_init (spatial_filter->p1);
         spatial_filter->p1->x0 = 0.0;
         spatial_filter->p1->y0 = 0.0;
         spatial_filter->p1->z0 = 0.0;
@@ -374,16 +373,14 @@ dxf_spatial_filter_read
                         /* Now follows a string containing the Z-value
                          * of the normal to the plane containing the
                          * clip boundary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", spatial_filter->dictionary_owner_soft);
+                        dxf_read_string (fp, &spatial_filter->dictionary_owner_soft);
                         i++;
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", spatial_filter->dictionary_owner_hard);
+                        dxf_read_string (fp, &spatial_filter->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "999") == 0)
                 {
@@ -586,8 +583,16 @@ dxf_spatial_filter_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (spatial_filter->dictionary_owner_soft);
-        free (spatial_filter->dictionary_owner_hard);
+        dxf_string_free (spatial_filter->dictionary_owner_soft);
+        dxf_string_free (spatial_filter->dictionary_owner_hard);
+        if (spatial_filter->p0 != NULL)
+        {
+                dxf_point_free (spatial_filter->p0);
+        }
+        if (spatial_filter->p1 != NULL)
+        {
+                dxf_point_free (spatial_filter->p1);
+        }
         free (spatial_filter);
         spatial_filter = NULL;
 #if DEBUG
@@ -762,6 +767,8 @@ dxf_spatial_filter_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (spatial_filter == NULL)
         {
@@ -777,7 +784,13 @@ dxf_spatial_filter_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        spatial_filter->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (spatial_filter->dictionary_owner_soft);
+        spatial_filter->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -842,6 +855,8 @@ dxf_spatial_filter_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (spatial_filter == NULL)
         {
@@ -857,7 +872,13 @@ dxf_spatial_filter_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        spatial_filter->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (spatial_filter->dictionary_owner_hard);
+        spatial_filter->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -77,14 +77,6 @@ dxf_spatial_filter_struct
                 /*!< The clip boundary definition point (in OCS) (always
                  * 2 or more) based on an xref scale of 1.\n
                  * Group codes = 10 and 20. */
-        double x0[DXF_MAX_PARAM];
-                /*!< X-value of the clip boundary definition point (in
-                 * OCS) (always 2 or more) based on an xref scale of 1.\n
-                 * Group code = 10. */
-        double y0[DXF_MAX_PARAM];
-                /*!< Y-value of the clip boundary definition point (in
-                 * OCS) (always 2 or more) based on an xref scale of 1.\n
-                 * Group code = 20. */
         DxfPoint *p1;
                 /*!< The origin used to define the local coordinate
                  * system of the clip boundary.\n
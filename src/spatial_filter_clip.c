@@ -0,0 +1,980 @@
+/*!
+ * \file spatial_filter_clip.c
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Functions for clipping geometry with a DXF \c SPATIAL_FILTER
+ * object (XCLIP).
+ *
+ * The clip boundary is compiled once per spatial filter, after which
+ * the flattened geometry of an exploded block reference (\c INSERT) is
+ * clipped segment by segment.\n
+ * Every segment is cut at its crossings with the clip boundary and
+ * with the front and back clipping planes, the parts inside are kept.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include "spatial_filter_clip.h"
+
+
+#define DXF_SPATIAL_FILTER_CLIP_STACK_CROSSINGS 64
+        /*!< \brief Number of crossings of a single segment that fit in
+         * the stack buffer, more crossings use the heap. */
+
+
+static void dxf_spatial_filter_clip_multiply (const double *a, const double *b, double *result);
+static void dxf_spatial_filter_clip_transform (DxfSpatialFilterClip *clip, double x, double y, double *cx, double *cy, double *cz);
+static int dxf_spatial_filter_clip_segment (DxfSpatialFilterClip *clip, double x0, double y0, double x1, double y1, double *last_t, DxfFlattenBuffer *result);
+static void dxf_spatial_filter_clip_emit (double x0, double y0, double x1, double y1, double t0, double t1, double *last_t, DxfFlattenBuffer *result);
+
+
+/*!
+ * \brief Allocate memory for a \c DxfSpatialFilterClip.
+ *
+ * Fill the memory contents with zeros.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfSpatialFilterClip *
+dxf_spatial_filter_clip_new ()
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfSpatialFilterClip *clip = NULL;
+        size_t size;
+
+        size = sizeof (DxfSpatialFilterClip);
+        /* avoid malloc of 0 bytes */
+        if (size == 0) size = 1;
+        if ((clip = malloc (size)) == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                clip = NULL;
+        }
+        else
+        {
+                memset (clip, 0, size);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (clip);
+}
+
+
+/*!
+ * \brief Allocate memory and initialize data fields in a
+ * \c DxfSpatialFilterClip.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfSpatialFilterClip *
+dxf_spatial_filter_clip_init
+(
+        DxfSpatialFilterClip *clip
+                /*!< a pointer to the clip. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        int i;
+
+        /* Do some basic checks. */
+        if (clip == NULL)
+        {
+                fprintf (stderr,
+                  (_("Warning in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                clip = dxf_spatial_filter_clip_new ();
+        }
+        if (clip == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        for (i = 0; i < 12; i++)
+        {
+                clip->matrix[i] = ((i == 0) || (i == 4) || (i == 8)) ? 1.0 : 0.0;
+        }
+        clip->is_rectangle = FALSE;
+        clip->min_x = 0.0;
+        clip->min_y = 0.0;
+        clip->max_x = 0.0;
+        clip->max_y = 0.0;
+        clip->front_clipping_plane_flag = FALSE;
+        clip->front_clipping_plane_distance = 0.0;
+        clip->back_clipping_plane_flag = FALSE;
+        clip->back_clipping_plane_distance = 0.0;
+        clip->number_of_edges = 0;
+        clip->edge_x0 = NULL;
+        clip->edge_y0 = NULL;
+        clip->edge_x1 = NULL;
+        clip->edge_y1 = NULL;
+        clip->number_of_bands = 0;
+        clip->band_height = 0.0;
+        clip->band_start = NULL;
+        clip->band_edges = NULL;
+        clip->index = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (clip);
+}
+
+
+/*!
+ * \brief Compile the clip boundary of a DXF \c SPATIAL_FILTER object.
+ *
+ * World coordinates are transformed into the coordinate system of the
+ * clip boundary by the inverse block transformation followed by the
+ * block transformation, a matrix of all zeros (not present in the
+ * file) is taken as the identity matrix.\n
+ * Two boundary points define a rectangle (lower left and upper right),
+ * more points define a polygon.\n
+ * Any previous contents of the clip are cleared.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_spatial_filter_clip_build
+(
+        DxfSpatialFilterClip *clip,
+                /*!< a pointer to the clip. */
+        DxfSpatialFilter *spatial_filter
+                /*!< a pointer to a DXF \c SPATIAL_FILTER object. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfFlattenBuffer *boundary = NULL;
+        DxfPoint *iter = NULL;
+        double identity[12];
+        const double *inverse_block_transformation = NULL;
+        const double *block_transformation = NULL;
+        double low;
+        double high;
+        int number_of_points;
+        int is_set;
+        int pass;
+        int b0;
+        int b1;
+        int b;
+        int i;
+        int k;
+
+        /* Do some basic checks. */
+        if ((clip == NULL) || (spatial_filter == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_spatial_filter_clip_clear (clip);
+        for (i = 0; i < 12; i++)
+        {
+                identity[i] = ((i == 0) || (i == 4) || (i == 8)) ? 1.0 : 0.0;
+        }
+        inverse_block_transformation = identity;
+        block_transformation = identity;
+        is_set = FALSE;
+        for (i = 0; i < 12; i++)
+        {
+                is_set |= (spatial_filter->inverse_block_transformation[i] != 0.0);
+        }
+        if (is_set)
+        {
+                inverse_block_transformation = spatial_filter->inverse_block_transformation;
+        }
+        is_set = FALSE;
+        for (i = 0; i < 12; i++)
+        {
+                is_set |= (spatial_filter->block_transformation[i] != 0.0);
+        }
+        if (is_set)
+        {
+                block_transformation = spatial_filter->block_transformation;
+        }
+        dxf_spatial_filter_clip_multiply (block_transformation,
+          inverse_block_transformation, clip->matrix);
+        clip->front_clipping_plane_flag = (spatial_filter->front_clipping_plane_flag == 1);
+        clip->front_clipping_plane_distance = spatial_filter->front_clipping_plane_distance;
+        clip->back_clipping_plane_flag = (spatial_filter->back_clipping_plane_flag == 1);
+        clip->back_clipping_plane_distance = spatial_filter->back_clipping_plane_distance;
+        /* The reader leaves an empty point at the end of the list. */
+        number_of_points = 0;
+        for (iter = spatial_filter->p0; iter != NULL; iter = (DxfPoint *) iter->next)
+        {
+                if ((spatial_filter->number_of_points > 0)
+                  && (number_of_points == spatial_filter->number_of_points))
+                {
+                        break;
+                }
+                number_of_points++;
+        }
+        if (number_of_points < 2)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a spatial filter with less than 2 boundary points was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        iter = spatial_filter->p0;
+        if (number_of_points == 2)
+        {
+                clip->is_rectangle = TRUE;
+                clip->min_x = iter->x0;
+                clip->min_y = iter->y0;
+                iter = (DxfPoint *) iter->next;
+                clip->max_x = iter->x0;
+                clip->max_y = iter->y0;
+                if (clip->min_x > clip->max_x)
+                {
+                        low = clip->min_x;
+                        clip->min_x = clip->max_x;
+                        clip->max_x = low;
+                }
+                if (clip->min_y > clip->max_y)
+                {
+                        low = clip->min_y;
+                        clip->min_y = clip->max_y;
+                        clip->max_y = low;
+                }
+                return (EXIT_SUCCESS);
+        }
+        /* A polygonal boundary: the edges and the point-in-polygon
+         * index. */
+        boundary = dxf_flatten_buffer_init (dxf_flatten_buffer_new (), number_of_points, 1);
+        clip->edge_x0 = malloc (number_of_points * sizeof (double));
+        clip->edge_y0 = malloc (number_of_points * sizeof (double));
+        clip->edge_x1 = malloc (number_of_points * sizeof (double));
+        clip->edge_y1 = malloc (number_of_points * sizeof (double));
+        clip->index = dxf_boundary_index_init (dxf_boundary_index_new ());
+        if ((boundary == NULL)
+          || (clip->edge_x0 == NULL)
+          || (clip->edge_y0 == NULL)
+          || (clip->edge_x1 == NULL)
+          || (clip->edge_y1 == NULL)
+          || (clip->index == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                if (boundary != NULL)
+                {
+                        dxf_flatten_buffer_free (boundary);
+                }
+                dxf_spatial_filter_clip_clear (clip);
+                return (EXIT_FAILURE);
+        }
+        dxf_flatten_buffer_begin_path (boundary);
+        for (i = 0; i < number_of_points; i++)
+        {
+                dxf_flatten_buffer_append (boundary, iter->x0, iter->y0);
+                clip->edge_x0[i] = iter->x0;
+                clip->edge_y0[i] = iter->y0;
+                if (i > 0)
+                {
+                        clip->edge_x1[i - 1] = iter->x0;
+                        clip->edge_y1[i - 1] = iter->y0;
+                }
+                if ((i == 0) || (iter->x0 < clip->min_x)) clip->min_x = iter->x0;
+                if ((i == 0) || (iter->y0 < clip->min_y)) clip->min_y = iter->y0;
+                if ((i == 0) || (iter->x0 > clip->max_x)) clip->max_x = iter->x0;
+                if ((i == 0) || (iter->y0 > clip->max_y)) clip->max_y = iter->y0;
+                iter = (DxfPoint *) iter->next;
+        }
+        clip->edge_x1[number_of_points - 1] = clip->edge_x0[0];
+        clip->edge_y1[number_of_points - 1] = clip->edge_y0[0];
+        clip->number_of_edges = number_of_points;
+        if (dxf_boundary_index_build (clip->index, boundary, DXF_BOUNDARY_INDEX_STYLE_NORMAL) != EXIT_SUCCESS)
+        {
+                dxf_flatten_buffer_free (boundary);
+                dxf_spatial_filter_clip_clear (clip);
+                return (EXIT_FAILURE);
+        }
+        dxf_flatten_buffer_free (boundary);
+        /* Sort the edges into horizontal bands, horizontal edges
+         * included. */
+        clip->number_of_bands = clip->number_of_edges / DXF_SPATIAL_FILTER_CLIP_EDGES_PER_BAND;
+        if (clip->number_of_bands < 1)
+        {
+                clip->number_of_bands = 1;
+        }
+        if (clip->number_of_bands > DXF_SPATIAL_FILTER_CLIP_MAX_BANDS)
+        {
+                clip->number_of_bands = DXF_SPATIAL_FILTER_CLIP_MAX_BANDS;
+        }
+        clip->band_height = (clip->max_y - clip->min_y) / clip->number_of_bands;
+        if (clip->band_height <= 0.0)
+        {
+                clip->band_height = 1.0;
+        }
+        clip->band_start = calloc (clip->number_of_bands + 1, sizeof (int));
+        if (clip->band_start == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                dxf_spatial_filter_clip_clear (clip);
+                return (EXIT_FAILURE);
+        }
+        /* First pass counts the edges per band, second pass fills the
+         * bands. */
+        for (pass = 0; pass < 2; pass++)
+        {
+                for (i = 0; i < clip->number_of_edges; i++)
+                {
+                        low = (clip->edge_y0[i] < clip->edge_y1[i]) ? clip->edge_y0[i] : clip->edge_y1[i];
+                        high = (clip->edge_y0[i] < clip->edge_y1[i]) ? clip->edge_y1[i] : clip->edge_y0[i];
+                        b0 = (int) ((low - clip->min_y) / clip->band_height);
+                        b1 = (int) ((high - clip->min_y) / clip->band_height);
+                        if (b0 >= clip->number_of_bands) b0 = clip->number_of_bands - 1;
+                        if (b1 >= clip->number_of_bands) b1 = clip->number_of_bands - 1;
+                        for (b = b0; b <= b1; b++)
+                        {
+                                if (pass == 0)
+                                {
+                                        clip->band_start[b + 1]++;
+                                }
+                                else
+                                {
+                                        clip->band_edges[clip->band_start[b]] = i;
+                                        clip->band_start[b]++;
+                                }
+                        }
+                }
+                if (pass == 0)
+                {
+                        for (b = 0; b < clip->number_of_bands; b++)
+                        {
+                                clip->band_start[b + 1] += clip->band_start[b];
+                        }
+                        k = clip->band_start[clip->number_of_bands];
+                        clip->band_edges = malloc (((k > 0) ? k : 1) * sizeof (int));
+                        if (clip->band_edges == NULL)
+                        {
+                                fprintf (stderr,
+                                  (_("Error in %s () could not allocate memory.\n")),
+                                  __FUNCTION__);
+                                dxf_spatial_filter_clip_clear (clip);
+                                return (EXIT_FAILURE);
+                        }
+                }
+        }
+        /* The fill pass advanced every band start to the start of the
+         * next band. */
+        for (b = clip->number_of_bands; b > 0; b--)
+        {
+                clip->band_start[b] = clip->band_start[b - 1];
+        }
+        clip->band_start[0] = 0;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Test if a point in world coordinates is kept by a
+ * \c DxfSpatialFilterClip.
+ *
+ * \return \c INSIDE or \c OUTSIDE, or \c DXF_ERROR when an error
+ * occurred.
+ */
+int
+dxf_spatial_filter_clip_point_inside
+(
+        DxfSpatialFilterClip *clip,
+                /*!< a pointer to the clip. */
+        double x,
+                /*!< X-coordinate of the point. */
+        double y
+                /*!< Y-coordinate of the point. */
+)
+{
+        double cx;
+        double cy;
+        double cz;
+
+        /* Do some basic checks. */
+        if (clip == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (DXF_ERROR);
+        }
+        dxf_spatial_filter_clip_transform (clip, x, y, &cx, &cy, &cz);
+        if ((clip->front_clipping_plane_flag && (cz > clip->front_clipping_plane_distance))
+          || (clip->back_clipping_plane_flag && (cz < clip->back_clipping_plane_distance))
+          || (cx < clip->min_x) || (cx > clip->max_x)
+          || (cy < clip->min_y) || (cy > clip->max_y))
+        {
+                return (OUTSIDE);
+        }
+        if (clip->is_rectangle)
+        {
+                return (INSIDE);
+        }
+        if (clip->index == NULL)
+        {
+                return (OUTSIDE);
+        }
+        return (dxf_boundary_index_point_inside (clip->index, cx, cy));
+}
+
+
+/*!
+ * \brief Clip a single path in world coordinates with a
+ * \c DxfSpatialFilterClip.
+ *
+ * The parts of the path inside the clip boundary and between the
+ * clipping planes are appended to \c result as separate paths, with
+ * the coordinates of the original geometry.\n
+ * When \c result overflowed, its counts hold the required sizes and the
+ * call can be repeated after dxf_flatten_buffer_reserve ().
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred or \c result overflowed.
+ */
+int
+dxf_spatial_filter_clip_path
+(
+        DxfSpatialFilterClip *clip,
+                /*!< a pointer to the clip. */
+        const double *x,
+                /*!< array of X-coordinates of the path. */
+        const double *y,
+                /*!< array of Y-coordinates of the path. */
+        int number_of_vertices,
+                /*!< number of vertices of the path. */
+        DxfFlattenBuffer *result
+                /*!< buffer receiving the clipped paths. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        double last_t;
+        int i;
+
+        /* Do some basic checks. */
+        if ((clip == NULL) || (x == NULL) || (y == NULL) || (result == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (number_of_vertices == 1)
+        {
+                if (dxf_spatial_filter_clip_point_inside (clip, x[0], y[0]) == INSIDE)
+                {
+                        dxf_flatten_buffer_begin_path (result);
+                        dxf_flatten_buffer_append (result, x[0], y[0]);
+                }
+                return (dxf_flatten_buffer_is_overflowed (result) ? EXIT_FAILURE : EXIT_SUCCESS);
+        }
+        /* A negative value: not continuing a path. */
+        last_t = -1.0;
+        for (i = 0; i + 1 < number_of_vertices; i++)
+        {
+                if ((x[i] == x[i + 1]) && (y[i] == y[i + 1]))
+                {
+                        continue;
+                }
+                /* Continue the path when the previous segment ended
+                 * inside. */
+                last_t = (last_t == 1.0) ? 0.0 : -1.0;
+                if (dxf_spatial_filter_clip_segment (clip, x[i], y[i], x[i + 1], y[i + 1], &last_t, result) != EXIT_SUCCESS)
+                {
+                        return (EXIT_FAILURE);
+                }
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (dxf_flatten_buffer_is_overflowed (result) ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Clip all paths in a \c DxfFlattenBuffer, e.g. the flattened
+ * entities of an exploded block reference.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred or \c result overflowed.
+ */
+int
+dxf_spatial_filter_clip_paths
+(
+        DxfSpatialFilterClip *clip,
+                /*!< a pointer to the clip. */
+        DxfFlattenBuffer *paths,
+                /*!< buffer holding the paths to clip. */
+        DxfFlattenBuffer *result
+                /*!< buffer receiving the clipped paths. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        int first;
+        int i;
+
+        /* Do some basic checks. */
+        if ((clip == NULL) || (paths == NULL) || (result == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (dxf_flatten_buffer_is_overflowed (paths))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () an overflowed buffer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (paths->path_start == NULL)
+        {
+                dxf_spatial_filter_clip_path (clip, paths->x, paths->y,
+                  paths->number_of_vertices, result);
+        }
+        else
+        {
+                for (i = 0; i < paths->number_of_paths; i++)
+                {
+                        first = paths->path_start[i];
+                        dxf_spatial_filter_clip_path (clip,
+                          paths->x + first, paths->y + first,
+                          dxf_flatten_buffer_get_path_size (paths, i),
+                          result);
+                }
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (dxf_flatten_buffer_is_overflowed (result) ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Clear the contents of a \c DxfSpatialFilterClip, the clip
+ * itself is not freed.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_spatial_filter_clip_clear
+(
+        DxfSpatialFilterClip *clip
+                /*!< a pointer to the clip. */
+)
+{
+        /* Do some basic checks. */
+        if (clip == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        free (clip->edge_x0);
+        free (clip->edge_y0);
+        free (clip->edge_x1);
+        free (clip->edge_y1);
+        free (clip->band_start);
+        free (clip->band_edges);
+        if (clip->index != NULL)
+        {
+                dxf_boundary_index_free (clip->index);
+        }
+        dxf_spatial_filter_clip_init (clip);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Free the allocated memory for a \c DxfSpatialFilterClip and
+ * all it's data fields.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_spatial_filter_clip_free
+(
+        DxfSpatialFilterClip *clip
+                /*!< a pointer to the clip. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (clip == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_spatial_filter_clip_clear (clip);
+        free (clip);
+        clip = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Multiply two 4x3 transformation matrices in column major
+ * order, the result applies \c b first and then \c a.
+ */
+static void
+dxf_spatial_filter_clip_multiply
+(
+        const double *a,
+                /*!< the matrix applied last. */
+        const double *b,
+                /*!< the matrix applied first. */
+        double *result
+                /*!< receives the product, must not overlap \c a or
+                 * \c b. */
+)
+{
+        int row;
+        int column;
+
+        for (column = 0; column < 4; column++)
+        {
+                for (row = 0; row < 3; row++)
+                {
+                        result[(column * 3) + row] = (a[row] * b[(column * 3)])
+                          + (a[3 + row] * b[(column * 3) + 1])
+                          + (a[6 + row] * b[(column * 3) + 2])
+                          + ((column == 3) ? a[9 + row] : 0.0);
+                }
+        }
+}
+
+
+/*!
+ * \brief Transform a point (with a Z-value of 0.0) into the coordinate
+ * system of the clip boundary.
+ */
+static void
+dxf_spatial_filter_clip_transform
+(
+        DxfSpatialFilterClip *clip,
+                /*!< a pointer to the clip. */
+        double x,
+                /*!< X-coordinate of the point. */
+        double y,
+                /*!< Y-coordinate of the point. */
+        double *cx,
+                /*!< receives the transformed X-coordinate. */
+        double *cy,
+                /*!< receives the transformed Y-coordinate. */
+        double *cz
+                /*!< receives the transformed Z-coordinate. */
+)
+{
+        *cx = (clip->matrix[0] * x) + (clip->matrix[3] * y) + clip->matrix[9];
+        *cy = (clip->matrix[1] * x) + (clip->matrix[4] * y) + clip->matrix[10];
+        *cz = (clip->matrix[2] * x) + (clip->matrix[5] * y) + clip->matrix[11];
+}
+
+
+/*!
+ * \brief Clip a single segment.
+ *
+ * The segment is cut at the parameters of its crossings with the clip
+ * boundary, of the resulting intervals those with their middle inside
+ * the boundary are kept, limited to the interval between the clipping
+ * planes.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_spatial_filter_clip_segment
+(
+        DxfSpatialFilterClip *clip,
+                /*!< a pointer to the clip. */
+        double x0,
+                /*!< X-coordinate of the start of the segment. */
+        double y0,
+                /*!< Y-coordinate of the start of the segment. */
+        double x1,
+                /*!< X-coordinate of the end of the segment. */
+        double y1,
+                /*!< Y-coordinate of the end of the segment. */
+        double *last_t,
+                /*!< parameter of the last vertex written to the open
+                 * path, or a negative value when no path is open. */
+        DxfFlattenBuffer *result
+                /*!< buffer receiving the clipped paths. */
+)
+{
+        double stack_crossings[DXF_SPATIAL_FILTER_CLIP_STACK_CROSSINGS];
+        double *crossings = stack_crossings;
+        double *grown = NULL;
+        double ax;
+        double ay;
+        double az;
+        double bx;
+        double by;
+        double bz;
+        double dx;
+        double dy;
+        double ex;
+        double ey;
+        double denominator;
+        double t;
+        double u;
+        double t_low;
+        double t_high;
+        double t0;
+        double t1;
+        double p[4];
+        double q[4];
+        int max_number_of_crossings;
+        int number_of_crossings;
+        int b0;
+        int b1;
+        int b;
+        int e;
+        int i;
+        int j;
+
+        dxf_spatial_filter_clip_transform (clip, x0, y0, &ax, &ay, &az);
+        dxf_spatial_filter_clip_transform (clip, x1, y1, &bx, &by, &bz);
+        /* Limit to the clipping planes, Z is linear along the
+         * segment. */
+        t_low = 0.0;
+        t_high = 1.0;
+        if (clip->front_clipping_plane_flag)
+        {
+                if (az == bz)
+                {
+                        if (az > clip->front_clipping_plane_distance) return (EXIT_SUCCESS);
+                }
+                else
+                {
+                        t = (clip->front_clipping_plane_distance - az) / (bz - az);
+                        if (bz > az) { if (t < t_high) t_high = t; }
+                        else { if (t > t_low) t_low = t; }
+                }
+        }
+        if (clip->back_clipping_plane_flag)
+        {
+                if (az == bz)
+                {
+                        if (az < clip->back_clipping_plane_distance) return (EXIT_SUCCESS);
+                }
+                else
+                {
+                        t = (clip->back_clipping_plane_distance - az) / (bz - az);
+                        if (bz > az) { if (t > t_low) t_low = t; }
+                        else { if (t < t_high) t_high = t; }
+                }
+        }
+        /* Limit to the boundary extents (Liang-Barsky), for a
+         * rectangular boundary this is the complete clip. */
+        dx = bx - ax;
+        dy = by - ay;
+        p[0] = -dx; q[0] = ax - clip->min_x;
+        p[1] = dx; q[1] = clip->max_x - ax;
+        p[2] = -dy; q[2] = ay - clip->min_y;
+        p[3] = dy; q[3] = clip->max_y - ay;
+        for (i = 0; i < 4; i++)
+        {
+                if (p[i] == 0.0)
+                {
+                        if (q[i] < 0.0) return (EXIT_SUCCESS);
+                        continue;
+                }
+                t = q[i] / p[i];
+                if (p[i] < 0.0) { if (t > t_low) t_low = t; }
+                else { if (t < t_high) t_high = t; }
+        }
+        if (t_low >= t_high)
+        {
+                return (EXIT_SUCCESS);
+        }
+        if (clip->is_rectangle)
+        {
+                dxf_spatial_filter_clip_emit (x0, y0, x1, y1, t_low, t_high, last_t, result);
+                return (EXIT_SUCCESS);
+        }
+        if (clip->index == NULL)
+        {
+                return (EXIT_SUCCESS);
+        }
+        /* Collect the crossings with the boundary edges in the bands
+         * overlapping the segment, an edge in several bands may be
+         * found more than once. */
+        crossings[0] = t_low;
+        number_of_crossings = 1;
+        max_number_of_crossings = DXF_SPATIAL_FILTER_CLIP_STACK_CROSSINGS;
+        b0 = (int) ((((ay < by) ? ay : by) - clip->min_y) / clip->band_height);
+        b1 = (int) ((((ay < by) ? by : ay) - clip->min_y) / clip->band_height);
+        if (b0 < 0) b0 = 0;
+        if (b1 >= clip->number_of_bands) b1 = clip->number_of_bands - 1;
+        for (b = b0; b <= b1; b++)
+        {
+                for (j = clip->band_start[b]; j < clip->band_start[b + 1]; j++)
+                {
+                        e = clip->band_edges[j];
+                        ex = clip->edge_x1[e] - clip->edge_x0[e];
+                        ey = clip->edge_y1[e] - clip->edge_y0[e];
+                        denominator = (dx * ey) - (dy * ex);
+                        if (denominator == 0.0)
+                        {
+                                continue;
+                        }
+                        t = (((clip->edge_x0[e] - ax) * ey) - ((clip->edge_y0[e] - ay) * ex)) / denominator;
+                        u = (((clip->edge_x0[e] - ax) * dy) - ((clip->edge_y0[e] - ay) * dx)) / denominator;
+                        if ((t <= t_low) || (t >= t_high) || (u < 0.0) || (u > 1.0))
+                        {
+                                continue;
+                        }
+                        if (number_of_crossings + 1 >= max_number_of_crossings)
+                        {
+                                grown = malloc (2 * max_number_of_crossings * sizeof (double));
+                                if (grown == NULL)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () could not allocate memory.\n")),
+                                          __FUNCTION__);
+                                        if (crossings != stack_crossings) free (crossings);
+                                        return (EXIT_FAILURE);
+                                }
+                                memcpy (grown, crossings, number_of_crossings * sizeof (double));
+                                if (crossings != stack_crossings) free (crossings);
+                                crossings = grown;
+                                max_number_of_crossings *= 2;
+                        }
+                        crossings[number_of_crossings] = t;
+                        number_of_crossings++;
+                }
+        }
+        crossings[number_of_crossings] = t_high;
+        number_of_crossings++;
+        /* Insertion sort, segments rarely cross many edges. */
+        for (i = 2; i < number_of_crossings - 1; i++)
+        {
+                t = crossings[i];
+                for (j = i - 1; (j > 0) && (crossings[j] > t); j--)
+                {
+                        crossings[j + 1] = crossings[j];
+                }
+                crossings[j + 1] = t;
+        }
+        for (i = 0; i + 1 < number_of_crossings; i++)
+        {
+                t0 = crossings[i];
+                t1 = crossings[i + 1];
+                if (t1 <= t0)
+                {
+                        continue;
+                }
+                t = (t0 + t1) / 2.0;
+                if (dxf_boundary_index_point_inside (clip->index, ax + (t * dx), ay + (t * dy)) == INSIDE)
+                {
+                        dxf_spatial_filter_clip_emit (x0, y0, x1, y1, t0, t1, last_t, result);
+                }
+        }
+        if (crossings != stack_crossings)
+        {
+                free (crossings);
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Write the part of a segment between two parameters to the
+ * result, continuing the open path when the part starts where it
+ * ended.
+ */
+static void
+dxf_spatial_filter_clip_emit
+(
+        double x0,
+                /*!< X-coordinate of the start of the segment. */
+        double y0,
+                /*!< Y-coordinate of the start of the segment. */
+        double x1,
+                /*!< X-coordinate of the end of the segment. */
+        double y1,
+                /*!< Y-coordinate of the end of the segment. */
+        double t0,
+                /*!< parameter of the start of the part. */
+        double t1,
+                /*!< parameter of the end of the part. */
+        double *last_t,
+                /*!< parameter of the last vertex written to the open
+                 * path, or a negative value when no path is open. */
+        DxfFlattenBuffer *result
+                /*!< buffer receiving the clipped paths. */
+)
+{
+        if (t0 != *last_t)
+        {
+                dxf_flatten_buffer_begin_path (result);
+                dxf_flatten_buffer_append (result,
+                  (t0 == 0.0) ? x0 : x0 + (t0 * (x1 - x0)),
+                  (t0 == 0.0) ? y0 : y0 + (t0 * (y1 - y0)));
+        }
+        dxf_flatten_buffer_append (result,
+          (t1 == 1.0) ? x1 : x0 + (t1 * (x1 - x0)),
+          (t1 == 1.0) ? y1 : y0 + (t1 * (y1 - y0)));
+        *last_t = t1;
+}
+
+
+/* EOF */
@@ -0,0 +1,143 @@
+/*!
+ * \file spatial_filter_clip.h
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Header file for clipping geometry with a DXF
+ * \c SPATIAL_FILTER object (XCLIP).
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#ifndef LIBDXF_SRC_SPATIAL_FILTER_CLIP_H
+#define LIBDXF_SRC_SPATIAL_FILTER_CLIP_H
+
+
+#include "global.h"
+#include "boundary_index.h"
+#include "flatten.h"
+#include "spatial_filter.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define DXF_SPATIAL_FILTER_CLIP_EDGES_PER_BAND 4
+        /*!< \brief The average number of boundary edges aimed for in a
+         * single horizontal band of the edge index. */
+
+#define DXF_SPATIAL_FILTER_CLIP_MAX_BANDS 65536
+        /*!< \brief The maximum number of horizontal bands in the edge
+         * index. */
+
+
+/*!
+ * \brief Definition of a compiled clip boundary of a DXF
+ * \c SPATIAL_FILTER object.
+ *
+ * Geometry is transformed into the coordinate system of the clip
+ * boundary with a single combined matrix.\n
+ * A rectangular boundary is clipped against directly, the edges of a
+ * polygonal boundary are sorted into horizontal bands to find the
+ * crossings of a segment, and a \c DxfBoundaryIndex decides which
+ * parts of a segment are inside.\n
+ * After dxf_spatial_filter_clip_build () the clip is read only, and may
+ * be shared between threads.
+ */
+typedef struct
+dxf_spatial_filter_clip_struct
+{
+        double matrix[12];
+                /*!< 4x3 transformation matrix in column major order
+                 * from world coordinates into the coordinate system of
+                 * the clip boundary. */
+        int is_rectangle;
+                /*!< \c TRUE for a rectangular clip boundary. */
+        double min_x;
+                /*!< Lower left X-coordinate of the boundary extents. */
+        double min_y;
+                /*!< Lower left Y-coordinate of the boundary extents. */
+        double max_x;
+                /*!< Upper right X-coordinate of the boundary extents. */
+        double max_y;
+                /*!< Upper right Y-coordinate of the boundary extents. */
+        int front_clipping_plane_flag;
+                /*!< \c TRUE when the front clipping plane is used. */
+        double front_clipping_plane_distance;
+                /*!< Geometry with a Z-value above this distance is
+                 * clipped. */
+        int back_clipping_plane_flag;
+                /*!< \c TRUE when the back clipping plane is used. */
+        double back_clipping_plane_distance;
+                /*!< Geometry with a Z-value below this distance is
+                 * clipped. */
+        int number_of_edges;
+                /*!< Number of edges of a polygonal boundary. */
+        double *edge_x0;
+                /*!< X-coordinate of the start of each edge. */
+        double *edge_y0;
+                /*!< Y-coordinate of the start of each edge. */
+        double *edge_x1;
+                /*!< X-coordinate of the end of each edge. */
+        double *edge_y1;
+                /*!< Y-coordinate of the end of each edge. */
+        int number_of_bands;
+                /*!< Number of horizontal bands of the edge index. */
+        double band_height;
+                /*!< Height of a single band. */
+        int *band_start;
+                /*!< Index in \c band_edges of the first edge of each
+                 * band, with an extra entry for the end of the last
+                 * band. */
+        int *band_edges;
+                /*!< Edge numbers of the edges overlapping each band. */
+        DxfBoundaryIndex *index;
+                /*!< Point-in-polygon index of a polygonal boundary. */
+} DxfSpatialFilterClip;
+
+
+DxfSpatialFilterClip *dxf_spatial_filter_clip_new ();
+DxfSpatialFilterClip *dxf_spatial_filter_clip_init (DxfSpatialFilterClip *clip);
+int dxf_spatial_filter_clip_build (DxfSpatialFilterClip *clip, DxfSpatialFilter *spatial_filter);
+int dxf_spatial_filter_clip_point_inside (DxfSpatialFilterClip *clip, double x, double y);
+int dxf_spatial_filter_clip_path (DxfSpatialFilterClip *clip, const double *x, const double *y, int number_of_vertices, DxfFlattenBuffer *result);
+int dxf_spatial_filter_clip_paths (DxfSpatialFilterClip *clip, DxfFlattenBuffer *paths, DxfFlattenBuffer *result);
+int dxf_spatial_filter_clip_clear (DxfSpatialFilterClip *clip);
+int dxf_spatial_filter_clip_free (DxfSpatialFilterClip *clip);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* LIBDXF_SRC_SPATIAL_FILTER_CLIP_H */
+
+
+/* EOF */
@@ -45,6 +45,7 @@
 
 
 #include "spatial_index.h"
+#include "util.h"
 
 
 /*!
@@ -119,11 +120,12 @@ dxf_spatial_index_init
                 return (NULL);
         }
         spatial_index->id_code = 0;
-        spatial_index->dictionary_owner_soft = strdup ("");
-        spatial_index->dictionary_owner_hard = strdup ("");
+        spatial_index->dictionary_owner_soft = dxf_string_share ("");
+        spatial_index->dictionary_owner_hard = dxf_string_share ("");
         if (time (&now) != (time_t)(-1))
         {
-                struct tm *current_time = localtime (&now);
+                struct tm current_tm;
+                struct tm *current_time = localtime_r (&now, &current_tm);
 
                 /* Transform the current local gregorian date in a julian date.*/
                 JD = current_time->tm_mday - 32075 + 1461 * (current_time->tm_year + 6700 + (current_time->tm_mon - 13) / 12) / 4 + 367 * (current_time->tm_mon - 1 - (current_time->tm_mon - 13) / 12 * 12) / 12 - 3 * ((current_time->tm_year + 6800 + (current_time->tm_mon - 13) / 12) / 100) / 4;
@@ -236,15 +238,13 @@ dxf_spatial_index_read
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", spatial_index->dictionary_owner_soft);
+                        dxf_read_string (fp, &spatial_index->dictionary_owner_soft);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", spatial_index->dictionary_owner_hard);
+                        dxf_read_string (fp, &spatial_index->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "999") == 0)
                 {
@@ -398,8 +398,8 @@ dxf_spatial_index_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (spatial_index->dictionary_owner_soft);
-        free (spatial_index->dictionary_owner_hard);
+        dxf_string_free (spatial_index->dictionary_owner_soft);
+        dxf_string_free (spatial_index->dictionary_owner_hard);
         free (spatial_index);
         spatial_index = NULL;
 #if DEBUG
@@ -574,6 +574,8 @@ dxf_spatial_index_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (spatial_index == NULL)
         {
@@ -589,7 +591,13 @@ dxf_spatial_index_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        spatial_index->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (spatial_index->dictionary_owner_soft);
+        spatial_index->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -654,6 +662,8 @@ dxf_spatial_index_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (spatial_index == NULL)
         {
@@ -669,7 +679,13 @@ dxf_spatial_index_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        spatial_index->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (spatial_index->dictionary_owner_hard);
+        spatial_index->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
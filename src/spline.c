@@ -231,6 +231,8 @@
 
 
 #include "spline.h"
+#include "stats.h"
+#include "util.h"
 
 
 /*!
@@ -263,6 +265,7 @@ dxf_spline_new ()
         else
         {
                 memset (spline, 0, size);
+                dxf_stats_count_allocation (SPLINE, size);
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -304,8 +307,8 @@ dxf_spline_init
                 return (NULL);
         }
         spline->id_code = 0;
-        spline->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        spline->layer = strdup (DXF_DEFAULT_LAYER);
+        spline->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        spline->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         spline->elevation = 0.0;
         spline->thickness = 0.0;
         spline->linetype_scale = 1.0;
@@ -315,22 +318,18 @@ dxf_spline_init
         spline->graphics_data_size = 0;
         spline->shadow_mode = 0;
         dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) spline->binary_graphics_data);
-        spline->dictionary_owner_soft = strdup ("");
-        spline->material = strdup ("");
-        spline->dictionary_owner_hard = strdup ("");
+        spline->dictionary_owner_soft = dxf_string_share ("");
+        spline->material = dxf_string_share ("");
+        spline->dictionary_owner_hard = dxf_string_share ("");
         spline->lineweight = 0;
-        spline->plot_style_name = strdup ("");
+        spline->plot_style_name = dxf_string_share ("");
         spline->color_value = 0;
-        spline->color_name = strdup ("");
+        spline->color_name = dxf_string_share ("");
         spline->transparency = 0;
         spline->p0 = dxf_point_new ();
-        spline->p0 = dxf_point_init (spline->p0);
         spline->p1 = dxf_point_new ();
-        spline->p1 = dxf_point_init (spline->p1);
         spline->p2 = dxf_point_new ();
-        spline->p2 = dxf_point_init (spline->p2);
         spline->p3 = dxf_point_new ();
-        spline->p3 = dxf_point_init (spline->p3);
         dxf_double_new (spline->knot_value);
         spline->knot_value = dxf_double_init (spline->knot_value);
         spline->knot_value->value = 0.0;
@@ -438,14 +437,12 @@ dxf_spline_read
                 {
                         /* Now follows a string containing a linetype
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", spline->linetype);
+                        dxf_read_string (fp, &spline->linetype);
                 }
                 else if (strcmp (temp_string, "8") == 0)
                 {
                         /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", spline->layer);
+                        dxf_read_string (fp, &spline->layer);
                 }
                 else if (strcmp (temp_string, "10") == 0)
                 {
@@ -680,22 +677,19 @@ dxf_spline_read
                 {
                         /* Now follows a string containing a
                          * soft-pointer ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", spline->dictionary_owner_soft);
+                        dxf_read_string (fp, &spline->dictionary_owner_soft);
                 }
                 else if (strcmp (temp_string, "347") == 0)
                 {
                         /* Now follows a string containing a
                          * hard-pointer ID/handle to material object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", spline->material);
+                        dxf_read_string (fp, &spline->material);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing a
                          * hard-pointer ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", spline->dictionary_owner_hard);
+                        dxf_read_string (fp, &spline->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "370") == 0)
                 {
@@ -708,8 +702,7 @@ dxf_spline_read
                 {
                         /* Now follows a string containing a plot style
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", spline->plot_style_name);
+                        dxf_read_string (fp, &spline->plot_style_name);
                 }
                 else if (strcmp (temp_string, "420") == 0)
                 {
@@ -721,8 +714,7 @@ dxf_spline_read
                 {
                         /* Now follows a string containing a color
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", spline->color_name);
+                        dxf_read_string (fp, &spline->color_name);
                 }
                 else if (strcmp (temp_string, "440") == 0)
                 {
@@ -748,11 +740,13 @@ dxf_spline_read
         /* Handle omitted members and/or illegal values. */
         if (strcmp (spline->linetype, "") == 0)
         {
-                spline->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (spline->linetype);
+                spline->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (spline->layer, "") == 0)
         {
-                spline->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (spline->layer);
+                spline->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Clean up. */
         free (temp_string);
@@ -822,7 +816,8 @@ dxf_spline_write
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                spline->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (spline->linetype);
+                spline->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (spline->layer, "") == 0)
         {
@@ -957,14 +952,14 @@ dxf_spline_write
                         /*! \todo implement as a single linked list of double. */
                 }
         }
-        while (spline->p0 != NULL)
+        while (p0 != NULL)
         {
                 fprintf (fp->fp, " 10\n%f\n", p0->x0);
                 fprintf (fp->fp, " 20\n%f\n", p0->y0);
                 fprintf (fp->fp, " 30\n%f\n", p0->z0);
                 p0 = (DxfPoint *) dxf_point_get_next (p0);
         }
-        while (spline->p1 != NULL)
+        while (p1 != NULL)
         {
                 fprintf (fp->fp, " 11\n%f\n", p1->x0);
                 fprintf (fp->fp, " 21\n%f\n", p1->y0);
@@ -1013,14 +1008,14 @@ dxf_spline_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (spline->linetype);
-        free (spline->layer);
+        dxf_string_free (spline->linetype);
+        dxf_string_free (spline->layer);
         dxf_binary_graphics_data_free_list ((DxfBinaryGraphicsData *) spline->binary_graphics_data);
-        free (spline->dictionary_owner_soft);
-        free (spline->material);
-        free (spline->dictionary_owner_hard);
-        free (spline->plot_style_name);
-        free (spline->color_name);
+        dxf_string_free (spline->dictionary_owner_soft);
+        dxf_string_free (spline->material);
+        dxf_string_free (spline->dictionary_owner_hard);
+        dxf_string_free (spline->plot_style_name);
+        dxf_string_free (spline->color_name);
         dxf_point_free_list (spline->p0);
         dxf_point_free_list (spline->p1);
         dxf_point_free (spline->p2);
@@ -1202,6 +1197,8 @@ dxf_spline_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (spline == NULL)
         {
@@ -1217,7 +1214,13 @@ dxf_spline_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        spline->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (spline->linetype);
+        spline->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1280,6 +1283,8 @@ dxf_spline_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (spline == NULL)
         {
@@ -1295,7 +1300,13 @@ dxf_spline_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        spline->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (spline->layer);
+        spline->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2118,6 +2129,8 @@ dxf_spline_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (spline == NULL)
         {
@@ -2133,7 +2146,13 @@ dxf_spline_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        spline->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (spline->dictionary_owner_soft);
+        spline->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2200,6 +2219,8 @@ dxf_spline_set_material
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (spline == NULL)
         {
@@ -2215,7 +2236,13 @@ dxf_spline_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        spline->material = strdup (material);
+        copy = dxf_string_share (material);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (spline->material);
+        spline->material = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2284,6 +2311,8 @@ dxf_spline_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (spline == NULL)
         {
@@ -2299,7 +2328,13 @@ dxf_spline_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        spline->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (spline->dictionary_owner_hard);
+        spline->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2429,6 +2464,8 @@ dxf_spline_set_plot_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (spline == NULL)
         {
@@ -2444,7 +2481,13 @@ dxf_spline_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        spline->plot_style_name = strdup (plot_style_name);
+        copy = dxf_string_share (plot_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (spline->plot_style_name);
+        spline->plot_style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2574,6 +2617,8 @@ dxf_spline_set_color_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (spline == NULL)
         {
@@ -2589,7 +2634,13 @@ dxf_spline_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        spline->color_name = strdup (color_name);
+        copy = dxf_string_share (color_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (spline->color_name);
+        spline->color_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
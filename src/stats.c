@@ -0,0 +1,835 @@
+/*!
+ * \file stats.c
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Functions for the parse and write statistics of libdxf.
+ *
+ * The statistics are a low overhead alternative for the
+ * \c DXF_DEBUG_BEGIN and \c DXF_DEBUG_END messages: every thread counts
+ * in its own block of counters, without locking, and the blocks are only
+ * added up when the statistics are requested with dxf_stats_get ().\n
+ * Counting is disabled by default and is enabled with
+ * dxf_stats_enable ().\n
+ * Counts for a file are also added to the statistics its \c DxfFile
+ * points at, dxf_file_read_stream () folds them into the \c DxfDrawing
+ * read, see dxf_drawing_get_stats ().\n
+ * Entity struct allocations are only counted in the totals of the
+ * threads, the constructors do not know the file they are read from.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include "stats.h"
+#include <pthread.h>
+
+
+/*!
+ * \brief Definition of the block of counters of a single thread.
+ */
+typedef struct
+dxf_stats_block_struct
+{
+        DxfStats stats;
+                /*!< Counters of the thread. */
+        struct dxf_stats_block_struct *next;
+                /*!< Pointer to the block of the next thread. */
+} DxfStatsBlock;
+
+
+int dxf_stats_enabled = FALSE;
+        /*!< \brief \c TRUE when the statistics are collected. */
+
+static pthread_mutex_t dxf_stats_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t dxf_stats_once = PTHREAD_ONCE_INIT;
+static pthread_key_t dxf_stats_key;
+static DxfStatsBlock *dxf_stats_blocks = NULL;
+static DxfStats dxf_stats_retired;
+static __thread DxfStatsBlock *dxf_stats_thread_block = NULL;
+
+static const char *dxf_stats_section_names[DXF_STATS_NUMBER_OF_SECTIONS] =
+{
+        "HEADER",
+        "CLASSES",
+        "TABLES",
+        "BLOCKS",
+        "ENTITIES",
+        "OBJECTS",
+        "THUMBNAIL"
+};
+
+static const char *dxf_stats_entity_names[DXF_STATS_NUMBER_OF_ENTITY_TYPES] =
+{
+        "UNKNOWN",
+        "3DFACE",
+        "3DSOLID",
+        "ACAD_PROXY_ENTITY",
+        "ARC",
+        "ATTDEF",
+        "ATTRIB",
+        "BODY",
+        "CIRCLE",
+        "DIMENSION",
+        "ELLIPSE",
+        "HATCH",
+        "HELIX",
+        "IMAGE",
+        "INSERT",
+        "LEADER",
+        "LIGHT",
+        "LINE",
+        "LWPOLYLINE",
+        "MESH",
+        "MLEADER",
+        "MLEADERSTYLE",
+        "MTEXT",
+        "OLEFRAME",
+        "OLE2FRAME",
+        "POINT",
+        "POLYLINE",
+        "RAY",
+        "REGION",
+        "SECTION",
+        "SHAPE",
+        "SOLID",
+        "SPLINE",
+        "SUN",
+        "SURFACE",
+        "TABLE",
+        "TEXT",
+        "TOLERANCE",
+        "TRACE",
+        "UNDERLAY",
+        "VERTEX",
+        "VIEWPORT",
+        "WIPEOUT",
+        "XLINE"
+};
+
+
+static void dxf_stats_create_key ();
+static void dxf_stats_release_block (void *data);
+static DxfStatsBlock *dxf_stats_get_block ();
+static int dxf_stats_get_type_index (DxfEntityType type);
+static int dxf_stats_get_targets (DxfFile *fp, DxfStats **targets);
+static void dxf_stats_add_counter (uint64_t *counter, uint64_t value);
+static void dxf_stats_add_seconds (double *counter, double seconds);
+static void dxf_stats_load_block (DxfStats *stats, DxfStats *block);
+static void dxf_stats_clear_block (DxfStats *block);
+
+
+/*!
+ * \brief Enable or disable the collection of statistics.
+ *
+ * Counters that were collected are kept when disabled, use
+ * dxf_stats_reset () to clear them.
+ */
+void
+dxf_stats_enable
+(
+        int enable
+                /*!< \c TRUE to enable, \c FALSE to disable. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        dxf_stats_enabled = enable ? TRUE : FALSE;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+}
+
+
+/*!
+ * \brief Get the time of a monotonic clock.
+ *
+ * \return the time in seconds, or 0.0 when the statistics are not
+ * enabled.
+ */
+double
+dxf_stats_get_time ()
+{
+        struct timespec now;
+
+        if (!dxf_stats_enabled)
+        {
+                return (0.0);
+        }
+        clock_gettime (CLOCK_MONOTONIC, &now);
+        return ((double) now.tv_sec + 1.0e-9 * (double) now.tv_nsec);
+}
+
+
+/*!
+ * \brief Count bytes and lines consumed from an input file.
+ *
+ * Like all counting functions this function has no debug output, it
+ * is called for every line.
+ */
+void
+dxf_stats_add_read
+(
+        DxfFile *fp,
+                /*!< the file read or written, may be \c NULL. */
+        size_t bytes,
+                /*!< number of bytes consumed. */
+        int lines
+                /*!< number of lines consumed. */
+)
+{
+        DxfStats *targets[2];
+        int number_of_targets;
+        int i;
+
+        number_of_targets = dxf_stats_get_targets (fp, targets);
+        for (i = 0; i < number_of_targets; i++)
+        {
+                dxf_stats_add_counter (&targets[i]->bytes_read, bytes);
+                dxf_stats_add_counter (&targets[i]->lines_read, lines);
+        }
+}
+
+
+/*!
+ * \brief Count bytes and lines written to an output file.
+ */
+void
+dxf_stats_add_write
+(
+        DxfFile *fp,
+                /*!< the file read or written, may be \c NULL. */
+        size_t bytes,
+                /*!< number of bytes written. */
+        int lines
+                /*!< number of lines written. */
+)
+{
+        DxfStats *targets[2];
+        int number_of_targets;
+        int i;
+
+        number_of_targets = dxf_stats_get_targets (fp, targets);
+        for (i = 0; i < number_of_targets; i++)
+        {
+                dxf_stats_add_counter (&targets[i]->bytes_written, bytes);
+                dxf_stats_add_counter (&targets[i]->lines_written, lines);
+        }
+}
+
+
+/*!
+ * \brief Count an entity that was decoded.
+ */
+void
+dxf_stats_count_entity_read
+(
+        DxfFile *fp,
+                /*!< the file read or written, may be \c NULL. */
+        DxfEntityType type
+                /*!< type of the entity. */
+)
+{
+        DxfStats *targets[2];
+        int number_of_targets;
+        int i;
+
+        number_of_targets = dxf_stats_get_targets (fp, targets);
+        for (i = 0; i < number_of_targets; i++)
+        {
+                dxf_stats_add_counter (&targets[i]->entities_read[dxf_stats_get_type_index (type)], 1);
+        }
+}
+
+
+/*!
+ * \brief Count an entity that was written.
+ */
+void
+dxf_stats_count_entity_written
+(
+        DxfFile *fp,
+                /*!< the file read or written, may be \c NULL. */
+        DxfEntityType type
+                /*!< type of the entity. */
+)
+{
+        DxfStats *targets[2];
+        int number_of_targets;
+        int i;
+
+        number_of_targets = dxf_stats_get_targets (fp, targets);
+        for (i = 0; i < number_of_targets; i++)
+        {
+                dxf_stats_add_counter (&targets[i]->entities_written[dxf_stats_get_type_index (type)], 1);
+        }
+}
+
+
+/*!
+ * \brief Count the allocation of an entity struct.
+ */
+void
+dxf_stats_count_allocation
+(
+        DxfEntityType type,
+                /*!< type of the entity. */
+        size_t size
+                /*!< number of bytes allocated. */
+)
+{
+        DxfStatsBlock *block = NULL;
+        int i;
+
+        if (!dxf_stats_enabled || ((block = dxf_stats_get_block ()) == NULL))
+        {
+                return;
+        }
+        i = dxf_stats_get_type_index (type);
+        dxf_stats_add_counter (&block->stats.allocations[i], 1);
+        dxf_stats_add_counter (&block->stats.allocated_bytes[i], size);
+}
+
+
+/*!
+ * \brief Count a group code that was not recognized.
+ */
+void
+dxf_stats_count_unknown_group_code
+(
+        DxfFile *fp
+                /*!< the file read, may be \c NULL. */
+)
+{
+        DxfStats *targets[2];
+        int number_of_targets;
+        int i;
+
+        number_of_targets = dxf_stats_get_targets (fp, targets);
+        for (i = 0; i < number_of_targets; i++)
+        {
+                dxf_stats_add_counter (&targets[i]->unknown_group_codes, 1);
+        }
+}
+
+
+/*!
+ * \brief Count a group code that was recognized and skipped.
+ */
+void
+dxf_stats_count_skipped_group_code
+(
+        DxfFile *fp
+                /*!< the file read, may be \c NULL. */
+)
+{
+        DxfStats *targets[2];
+        int number_of_targets;
+        int i;
+
+        number_of_targets = dxf_stats_get_targets (fp, targets);
+        for (i = 0; i < number_of_targets; i++)
+        {
+                dxf_stats_add_counter (&targets[i]->skipped_group_codes, 1);
+        }
+}
+
+
+/*!
+ * \brief Add the time spent reading a section.
+ */
+void
+dxf_stats_add_section_time
+(
+        DxfFile *fp,
+                /*!< the file read or written, may be \c NULL. */
+        DxfStatsSection section,
+                /*!< the section that was read. */
+        double seconds
+                /*!< time spent, see dxf_stats_get_time (). */
+)
+{
+        DxfStats *targets[2];
+        int number_of_targets;
+        int i;
+
+        if ((section < 0) || (section >= DXF_STATS_NUMBER_OF_SECTIONS))
+        {
+                return;
+        }
+        number_of_targets = dxf_stats_get_targets (fp, targets);
+        for (i = 0; i < number_of_targets; i++)
+        {
+                dxf_stats_add_counter (&targets[i]->section_count[section], 1);
+                dxf_stats_add_seconds (&targets[i]->section_time[section], seconds);
+        }
+}
+
+
+/*!
+ * \brief Get the statistics of all threads.
+ *
+ * The counters of the other threads are read with relaxed atomic
+ * loads, counters of threads that are still counting may be a few
+ * counts behind.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_stats_get
+(
+        DxfStats *stats
+                /*!< a pointer to the statistics to fill. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfStatsBlock *iter = NULL;
+
+        /* Do some basic checks. */
+        if (stats == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        memset (stats, 0, sizeof (DxfStats));
+        pthread_mutex_lock (&dxf_stats_mutex);
+        dxf_stats_merge (stats, &dxf_stats_retired);
+        for (iter = dxf_stats_blocks; iter != NULL; iter = iter->next)
+        {
+                dxf_stats_load_block (stats, &iter->stats);
+        }
+        pthread_mutex_unlock (&dxf_stats_mutex);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Clear the statistics of all threads.
+ *
+ * The counters of the other threads are cleared with relaxed atomic
+ * stores, a count added by a thread while it is cleared may survive
+ * the reset.
+ *
+ * \return \c EXIT_SUCCESS when done.
+ */
+int
+dxf_stats_reset ()
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfStatsBlock *iter = NULL;
+
+        pthread_mutex_lock (&dxf_stats_mutex);
+        memset (&dxf_stats_retired, 0, sizeof (DxfStats));
+        for (iter = dxf_stats_blocks; iter != NULL; iter = iter->next)
+        {
+                dxf_stats_clear_block (&iter->stats);
+        }
+        pthread_mutex_unlock (&dxf_stats_mutex);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Add statistics to other statistics.
+ *
+ * Used to sum the statistics of the files of a batch, see
+ * dxf_drawing_get_stats ().
+ */
+void
+dxf_stats_merge
+(
+        DxfStats *stats,
+                /*!< statistics to add to. */
+        const DxfStats *block
+                /*!< statistics to add. */
+)
+{
+        int i;
+
+        stats->bytes_read += block->bytes_read;
+        stats->lines_read += block->lines_read;
+        stats->bytes_written += block->bytes_written;
+        stats->lines_written += block->lines_written;
+        stats->unknown_group_codes += block->unknown_group_codes;
+        stats->skipped_group_codes += block->skipped_group_codes;
+        for (i = 0; i < DXF_STATS_NUMBER_OF_ENTITY_TYPES; i++)
+        {
+                stats->entities_read[i] += block->entities_read[i];
+                stats->entities_written[i] += block->entities_written[i];
+                stats->allocations[i] += block->allocations[i];
+                stats->allocated_bytes[i] += block->allocated_bytes[i];
+        }
+        for (i = 0; i < DXF_STATS_NUMBER_OF_SECTIONS; i++)
+        {
+                stats->section_count[i] += block->section_count[i];
+                stats->section_time[i] += block->section_time[i];
+        }
+}
+
+
+/*!
+ * \brief Write statistics to a file as a JSON object.
+ *
+ * Only sections and entity types with non zero counters are listed.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_stats_write_json
+(
+        FILE *fp,
+                /*!< file pointer to an output file (or device). */
+        DxfStats *stats
+                /*!< a pointer to the statistics, see
+                 * dxf_stats_get (). */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        const char *separator = "";
+        int i;
+
+        /* Do some basic checks. */
+        if ((fp == NULL) || (stats == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        fprintf (fp, "{\n");
+        fprintf (fp, "  \"bytes_read\": %" PRIu64 ",\n", stats->bytes_read);
+        fprintf (fp, "  \"lines_read\": %" PRIu64 ",\n", stats->lines_read);
+        fprintf (fp, "  \"bytes_written\": %" PRIu64 ",\n", stats->bytes_written);
+        fprintf (fp, "  \"lines_written\": %" PRIu64 ",\n", stats->lines_written);
+        fprintf (fp, "  \"unknown_group_codes\": %" PRIu64 ",\n", stats->unknown_group_codes);
+        fprintf (fp, "  \"skipped_group_codes\": %" PRIu64 ",\n", stats->skipped_group_codes);
+        fprintf (fp, "  \"sections\": {");
+        for (i = 0; i < DXF_STATS_NUMBER_OF_SECTIONS; i++)
+        {
+                if (stats->section_count[i] == 0)
+                {
+                        continue;
+                }
+                fprintf (fp, "%s\n    \"%s\": {\"count\": %" PRIu64 ", \"seconds\": %.9f}",
+                  separator, dxf_stats_section_names[i],
+                  stats->section_count[i], stats->section_time[i]);
+                separator = ",";
+        }
+        fprintf (fp, "%s},\n", (*separator != '\0') ? "\n  " : "");
+        separator = "";
+        fprintf (fp, "  \"entities\": {");
+        for (i = 0; i < DXF_STATS_NUMBER_OF_ENTITY_TYPES; i++)
+        {
+                if ((stats->entities_read[i] == 0)
+                  && (stats->entities_written[i] == 0)
+                  && (stats->allocations[i] == 0))
+                {
+                        continue;
+                }
+                fprintf (fp, "%s\n    \"%s\": {\"read\": %" PRIu64 ", \"written\": %" PRIu64 ", \"allocations\": %" PRIu64 ", \"allocated_bytes\": %" PRIu64 "}",
+                  separator, dxf_stats_entity_names[i],
+                  stats->entities_read[i], stats->entities_written[i],
+                  stats->allocations[i], stats->allocated_bytes[i]);
+                separator = ",";
+        }
+        fprintf (fp, "%s}\n", (*separator != '\0') ? "\n  " : "");
+        fprintf (fp, "}\n");
+        if (ferror (fp))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () while writing statistics.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Create the thread specific key that releases the block of an
+ * exiting thread, called once through pthread_once ().
+ */
+static void
+dxf_stats_create_key ()
+{
+        pthread_key_create (&dxf_stats_key, dxf_stats_release_block);
+}
+
+
+/*!
+ * \brief Add the counters of an exiting thread to the retired counters
+ * and free its block.
+ */
+static void
+dxf_stats_release_block
+(
+        void *data
+                /*!< the block of the exiting thread. */
+)
+{
+        DxfStatsBlock *block = (DxfStatsBlock *) data;
+        DxfStatsBlock **iter = NULL;
+
+        pthread_mutex_lock (&dxf_stats_mutex);
+        dxf_stats_merge (&dxf_stats_retired, &block->stats);
+        for (iter = &dxf_stats_blocks; *iter != NULL; iter = &(*iter)->next)
+        {
+                if (*iter == block)
+                {
+                        *iter = block->next;
+                        break;
+                }
+        }
+        pthread_mutex_unlock (&dxf_stats_mutex);
+        free (block);
+}
+
+
+/*!
+ * \brief Get the block of counters of the calling thread, the block is
+ * created on first use.
+ *
+ * \return a pointer to the block, or \c NULL when no memory was
+ * allocated.
+ */
+static DxfStatsBlock *
+dxf_stats_get_block ()
+{
+        DxfStatsBlock *block = dxf_stats_thread_block;
+
+        if (block != NULL)
+        {
+                return (block);
+        }
+        pthread_once (&dxf_stats_once, dxf_stats_create_key);
+        block = calloc (1, sizeof (DxfStatsBlock));
+        if (block == NULL)
+        {
+                return (NULL);
+        }
+        pthread_mutex_lock (&dxf_stats_mutex);
+        block->next = dxf_stats_blocks;
+        dxf_stats_blocks = block;
+        pthread_mutex_unlock (&dxf_stats_mutex);
+        pthread_setspecific (dxf_stats_key, block);
+        dxf_stats_thread_block = block;
+        return (block);
+}
+
+
+/*!
+ * \brief Map an entity type to a counter index, out of range types are
+ * counted as \c UNKNOWN_ENTITY.
+ */
+static int
+dxf_stats_get_type_index
+(
+        DxfEntityType type
+                /*!< type of the entity. */
+)
+{
+        if (((int) type < 0) || ((int) type >= DXF_STATS_NUMBER_OF_ENTITY_TYPES))
+        {
+                return (UNKNOWN_ENTITY);
+        }
+        return ((int) type);
+}
+
+
+
+
+/*!
+ * \brief Get the statistics to count in, the statistics of \c fp (when
+ * set) and the block of the calling thread.
+ *
+ * \return the number of statistics in \c targets, 0 when the
+ * statistics are not enabled.
+ */
+static int
+dxf_stats_get_targets
+(
+        DxfFile *fp,
+                /*!< the file read or written, may be \c NULL. */
+        DxfStats **targets
+                /*!< array of at least two pointers to fill. */
+)
+{
+        DxfStatsBlock *block = NULL;
+        int number_of_targets = 0;
+
+        if (!dxf_stats_enabled)
+        {
+                return (0);
+        }
+        if ((fp != NULL) && (fp->stats != NULL))
+        {
+                targets[number_of_targets++] = fp->stats;
+        }
+        if ((block = dxf_stats_get_block ()) != NULL)
+        {
+                targets[number_of_targets++] = &block->stats;
+        }
+        return (number_of_targets);
+}
+
+
+/*!
+ * \brief Add to a counter of the calling thread or of a file.
+ *
+ * Only the owner adds to a counter, so a relaxed load and store
+ * suffice; they keep dxf_stats_get () and dxf_stats_reset () in other
+ * threads free of data races without a locked instruction per line.
+ */
+static void
+dxf_stats_add_counter
+(
+        uint64_t *counter,
+                /*!< the counter to add to. */
+        uint64_t value
+                /*!< the value to add. */
+)
+{
+        __atomic_store_n (counter,
+          __atomic_load_n (counter, __ATOMIC_RELAXED) + value,
+          __ATOMIC_RELAXED);
+}
+
+
+/*!
+ * \brief Add to a section time of the calling thread or of a file,
+ * see dxf_stats_add_counter ().
+ */
+static void
+dxf_stats_add_seconds
+(
+        double *counter,
+                /*!< the time to add to. */
+        double seconds
+                /*!< the time to add. */
+)
+{
+        double value;
+
+        __atomic_load (counter, &value, __ATOMIC_RELAXED);
+        value += seconds;
+        __atomic_store (counter, &value, __ATOMIC_RELAXED);
+}
+
+
+/*!
+ * \brief Add the counters of a block that may still be counting, like
+ * dxf_stats_merge () but with relaxed atomic loads.
+ */
+static void
+dxf_stats_load_block
+(
+        DxfStats *stats,
+                /*!< statistics to add to. */
+        DxfStats *block
+                /*!< counters of a thread. */
+)
+{
+        double seconds;
+        int i;
+
+        stats->bytes_read += __atomic_load_n (&block->bytes_read, __ATOMIC_RELAXED);
+        stats->lines_read += __atomic_load_n (&block->lines_read, __ATOMIC_RELAXED);
+        stats->bytes_written += __atomic_load_n (&block->bytes_written, __ATOMIC_RELAXED);
+        stats->lines_written += __atomic_load_n (&block->lines_written, __ATOMIC_RELAXED);
+        stats->unknown_group_codes += __atomic_load_n (&block->unknown_group_codes, __ATOMIC_RELAXED);
+        stats->skipped_group_codes += __atomic_load_n (&block->skipped_group_codes, __ATOMIC_RELAXED);
+        for (i = 0; i < DXF_STATS_NUMBER_OF_ENTITY_TYPES; i++)
+        {
+                stats->entities_read[i] += __atomic_load_n (&block->entities_read[i], __ATOMIC_RELAXED);
+                stats->entities_written[i] += __atomic_load_n (&block->entities_written[i], __ATOMIC_RELAXED);
+                stats->allocations[i] += __atomic_load_n (&block->allocations[i], __ATOMIC_RELAXED);
+                stats->allocated_bytes[i] += __atomic_load_n (&block->allocated_bytes[i], __ATOMIC_RELAXED);
+        }
+        for (i = 0; i < DXF_STATS_NUMBER_OF_SECTIONS; i++)
+        {
+                stats->section_count[i] += __atomic_load_n (&block->section_count[i], __ATOMIC_RELAXED);
+                __atomic_load (&block->section_time[i], &seconds, __ATOMIC_RELAXED);
+                stats->section_time[i] += seconds;
+        }
+}
+
+
+/*!
+ * \brief Clear the counters of a block that may still be counting with
+ * relaxed atomic stores.
+ */
+static void
+dxf_stats_clear_block
+(
+        DxfStats *block
+                /*!< counters of a thread. */
+)
+{
+        double zero = 0.0;
+        int i;
+
+        __atomic_store_n (&block->bytes_read, 0, __ATOMIC_RELAXED);
+        __atomic_store_n (&block->lines_read, 0, __ATOMIC_RELAXED);
+        __atomic_store_n (&block->bytes_written, 0, __ATOMIC_RELAXED);
+        __atomic_store_n (&block->lines_written, 0, __ATOMIC_RELAXED);
+        __atomic_store_n (&block->unknown_group_codes, 0, __ATOMIC_RELAXED);
+        __atomic_store_n (&block->skipped_group_codes, 0, __ATOMIC_RELAXED);
+        for (i = 0; i < DXF_STATS_NUMBER_OF_ENTITY_TYPES; i++)
+        {
+                __atomic_store_n (&block->entities_read[i], 0, __ATOMIC_RELAXED);
+                __atomic_store_n (&block->entities_written[i], 0, __ATOMIC_RELAXED);
+                __atomic_store_n (&block->allocations[i], 0, __ATOMIC_RELAXED);
+                __atomic_store_n (&block->allocated_bytes[i], 0, __ATOMIC_RELAXED);
+        }
+        for (i = 0; i < DXF_STATS_NUMBER_OF_SECTIONS; i++)
+        {
+                __atomic_store_n (&block->section_count[i], 0, __ATOMIC_RELAXED);
+                __atomic_store (&block->section_time[i], &zero, __ATOMIC_RELAXED);
+        }
+}
+
+
+/* EOF */
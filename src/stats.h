@@ -0,0 +1,138 @@
+/*!
+ * \file stats.h
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Header file for the parse and write statistics of libdxf.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#ifndef LIBDXF_SRC_STATS_H
+#define LIBDXF_SRC_STATS_H
+
+
+#include "global.h"
+#include "entity.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define DXF_STATS_NUMBER_OF_ENTITY_TYPES (XLINE + 1)
+        /*!< \brief Number of entity types counted, one for every
+         * \c DxfEntityType value. */
+
+
+/*!
+ * \brief Sections timed by the statistics.
+ */
+typedef enum
+dxf_stats_section
+{
+        DXF_STATS_SECTION_HEADER,
+        DXF_STATS_SECTION_CLASSES,
+        DXF_STATS_SECTION_TABLES,
+        DXF_STATS_SECTION_BLOCKS,
+        DXF_STATS_SECTION_ENTITIES,
+        DXF_STATS_SECTION_OBJECTS,
+        DXF_STATS_SECTION_THUMBNAIL,
+        DXF_STATS_NUMBER_OF_SECTIONS
+} DxfStatsSection;
+
+
+/*!
+ * \brief Definition of the parse and write statistics.
+ *
+ * Counters are collected per thread, dxf_stats_get () adds the
+ * counters of all threads (including threads that have exited).
+ */
+typedef struct
+dxf_stats_struct
+{
+        uint64_t bytes_read;
+                /*!< Number of bytes consumed from input files. */
+        uint64_t lines_read;
+                /*!< Number of lines consumed from input files. */
+        uint64_t bytes_written;
+                /*!< Number of bytes written to output files. */
+        uint64_t lines_written;
+                /*!< Number of lines written to output files. */
+        uint64_t unknown_group_codes;
+                /*!< Number of group codes that were not recognized. */
+        uint64_t skipped_group_codes;
+                /*!< Number of group codes that were recognized and
+                 * skipped (comments, application defined group
+                 * markers). */
+        uint64_t entities_read[DXF_STATS_NUMBER_OF_ENTITY_TYPES];
+                /*!< Number of entities decoded, per entity type. */
+        uint64_t entities_written[DXF_STATS_NUMBER_OF_ENTITY_TYPES];
+                /*!< Number of entities written, per entity type. */
+        uint64_t allocations[DXF_STATS_NUMBER_OF_ENTITY_TYPES];
+                /*!< Number of entity structs allocated, per entity
+                 * type. */
+        uint64_t allocated_bytes[DXF_STATS_NUMBER_OF_ENTITY_TYPES];
+                /*!< Number of bytes allocated for entity structs, per
+                 * entity type. */
+        uint64_t section_count[DXF_STATS_NUMBER_OF_SECTIONS];
+                /*!< Number of sections read, per section. */
+        double section_time[DXF_STATS_NUMBER_OF_SECTIONS];
+                /*!< Wall clock time in seconds spent reading, per
+                 * section. */
+} DxfStats;
+
+
+extern int dxf_stats_enabled;
+
+
+void dxf_stats_enable (int enable);
+double dxf_stats_get_time ();
+void dxf_stats_add_read (DxfFile *fp, size_t bytes, int lines);
+void dxf_stats_add_write (DxfFile *fp, size_t bytes, int lines);
+void dxf_stats_count_entity_read (DxfFile *fp, DxfEntityType type);
+void dxf_stats_count_entity_written (DxfFile *fp, DxfEntityType type);
+void dxf_stats_count_allocation (DxfEntityType type, size_t size);
+void dxf_stats_count_unknown_group_code (DxfFile *fp);
+void dxf_stats_count_skipped_group_code (DxfFile *fp);
+void dxf_stats_add_section_time (DxfFile *fp, DxfStatsSection section, double seconds);
+int dxf_stats_get (DxfStats *stats);
+int dxf_stats_reset ();
+void dxf_stats_merge (DxfStats *stats, const DxfStats *block);
+int dxf_stats_write_json (FILE *fp, DxfStats *stats);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* LIBDXF_SRC_STATS_H */
+
+
+/* EOF */
@@ -0,0 +1,1029 @@
+/*!
+ * \file stream_writer.c
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Functions for streaming (append-mode) output of DXF files.
+ *
+ * A stream writer writes a DXF file front to back without holding the
+ * drawing in memory: the \c HEADER section is written when the file is
+ * opened, sections are opened and closed in file order, and entities are
+ * written one at a time (or in batches) as they are produced.\n
+ * The drawing extents and the handle seed are not known until the last
+ * entity has been written, they are kept up to date while writing and
+ * patched into fixed width slots, reserved in the \c HEADER section, when
+ * the file is closed.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include "stream_writer.h"
+#include "arc.h"
+#include "circle.h"
+#include "file.h"
+#include "insert.h"
+#include "line.h"
+#include "lwpolyline.h"
+#include "point.h"
+#include "stats.h"
+#include "text.h"
+#include "vertex.h"
+
+
+static int dxf_stream_writer_write_slot (DxfStreamWriter *writer, int group_code, long *offset, const char *format, ...);
+static int dxf_stream_writer_patch_slot (DxfStreamWriter *writer, long offset, const char *format, ...);
+static int dxf_stream_writer_add_entity_extents (DxfStreamWriter *writer, DxfEntityType type, void *entity);
+static int dxf_stream_writer_add_dxf_point (DxfStreamWriter *writer, DxfPoint *point);
+
+
+/*!
+ * \brief Allocate memory for a \c DxfStreamWriter.
+ *
+ * Fill the memory contents with zeros.
+ */
+DxfStreamWriter *
+dxf_stream_writer_new ()
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfStreamWriter *writer = NULL;
+        size_t size;
+
+        size = sizeof (DxfStreamWriter);
+        /* avoid malloc of 0 bytes */
+        if (size == 0) size = 1;
+        if ((writer = malloc (size)) == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory for a DxfStreamWriter struct.\n")),
+                  __FUNCTION__);
+                writer = NULL;
+        }
+        else
+        {
+                memset (writer, 0, size);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (writer);
+}
+
+
+/*!
+ * \brief Allocate memory and initialize data fields in a
+ * \c DxfStreamWriter.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when successful.
+ */
+DxfStreamWriter *
+dxf_stream_writer_init
+(
+        DxfStreamWriter *writer
+                /*!< a pointer to the stream writer. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        int i;
+
+        /* Do some basic checks. */
+        if (writer == NULL)
+        {
+                fprintf (stderr,
+                  (_("Warning in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                writer = dxf_stream_writer_new ();
+        }
+        if (writer == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory for a DxfStreamWriter struct.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        memset (&writer->file, 0, sizeof (DxfFile));
+        writer->buffer = NULL;
+        writer->in_section = FALSE;
+        writer->wrote_objects = FALSE;
+        writer->handle_seed_offset = -1;
+        for (i = 0; i < 3; i++)
+        {
+                writer->ext_min_offset[i] = -1;
+                writer->ext_max_offset[i] = -1;
+                writer->ext_min[i] = 0.0;
+                writer->ext_max[i] = 0.0;
+        }
+        dxf_handle_allocator_init (&writer->handles);
+        writer->has_extents = FALSE;
+        writer->number_of_entities = 0;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (writer);
+}
+
+
+/*!
+ * \brief Open a DXF file for streaming output.
+ *
+ * Writes the start of the \c HEADER section with the \c $ACADVER
+ * variable and reserved slots for the \c $HANDSEED, \c $EXTMIN and
+ * \c $EXTMAX variables.\n
+ * The \c HEADER section is left open, so that the caller can append
+ * more header variables with the \c DxfFile returned by
+ * dxf_stream_writer_get_file ().\n
+ * When \c filename is \c NULL the output goes to \c stdout, in that
+ * case the slots can not be patched and keep their initial values.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_stream_writer_open
+(
+        DxfStreamWriter *writer,
+                /*!< a pointer to the stream writer. */
+        const char *filename,
+                /*!< filename of the output file, or \c NULL for
+                 * \c stdout. */
+        int acad_version_number
+                /*!< AutoCAD version number of the output file. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        FILE *fp = NULL;
+
+        /* Do some basic checks. */
+        if (writer == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (writer->file.fp != NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () the stream writer is already open.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_stream_writer_init (writer);
+        if (filename == NULL)
+        {
+                fp = stdout;
+        }
+        else
+        {
+                fp = fopen (filename, "wb");
+        }
+        if (fp == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not open file: %s for writing.\n")),
+                  __FUNCTION__, filename);
+                return (EXIT_FAILURE);
+        }
+        /* stdout may already be in use, only a freshly opened file gets
+         * the large buffer. */
+        if (fp != stdout)
+        {
+                writer->buffer = malloc (DXF_STREAM_WRITER_BUFFER_SIZE);
+        }
+        if (writer->buffer != NULL)
+        {
+                setvbuf (fp, writer->buffer, _IOFBF, DXF_STREAM_WRITER_BUFFER_SIZE);
+        }
+        writer->file.fp = fp;
+        writer->file.filename = (filename == NULL) ? NULL : strdup (filename);
+        writer->file.acad_version_number = acad_version_number;
+        /* Start writing output. */
+        fprintf (fp, "  0\nSECTION\n  2\nHEADER\n");
+        fprintf (fp, "  9\n$ACADVER\n  1\nAC%d\n", acad_version_number);
+        writer->in_section = TRUE;
+        /* Reserve the slots, they stay at -1 when the output is not
+         * seekable. */
+        fprintf (fp, "  9\n$HANDSEED\n");
+        dxf_stream_writer_write_slot (writer, 5,
+          &writer->handle_seed_offset,
+          DXF_STREAM_WRITER_HANDLE_FORMAT,
+          dxf_handle_allocator_get_seed (&writer->handles));
+        fprintf (fp, "  9\n$EXTMIN\n");
+        dxf_stream_writer_write_slot (writer, 10,
+          &writer->ext_min_offset[0], DXF_STREAM_WRITER_DOUBLE_FORMAT, 0.0);
+        dxf_stream_writer_write_slot (writer, 20,
+          &writer->ext_min_offset[1], DXF_STREAM_WRITER_DOUBLE_FORMAT, 0.0);
+        dxf_stream_writer_write_slot (writer, 30,
+          &writer->ext_min_offset[2], DXF_STREAM_WRITER_DOUBLE_FORMAT, 0.0);
+        fprintf (fp, "  9\n$EXTMAX\n");
+        dxf_stream_writer_write_slot (writer, 10,
+          &writer->ext_max_offset[0], DXF_STREAM_WRITER_DOUBLE_FORMAT, 0.0);
+        dxf_stream_writer_write_slot (writer, 20,
+          &writer->ext_max_offset[1], DXF_STREAM_WRITER_DOUBLE_FORMAT, 0.0);
+        dxf_stream_writer_write_slot (writer, 30,
+          &writer->ext_max_offset[2], DXF_STREAM_WRITER_DOUBLE_FORMAT, 0.0);
+        if (ferror (fp))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not write to file: %s.\n")),
+                  __FUNCTION__, filename);
+                return (EXIT_FAILURE);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Get the DXF file handle of a stream writer.
+ *
+ * The returned \c DxfFile can be passed to the existing
+ * \c dxf_*_write () functions to append output between the calls of
+ * the stream writer functions.
+ *
+ * \return a pointer to the DXF file handle, or \c NULL when the stream
+ * writer is not open.
+ */
+DxfFile *
+dxf_stream_writer_get_file
+(
+        DxfStreamWriter *writer
+                /*!< a pointer to the stream writer. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (writer == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        if (writer->file.fp == NULL)
+        {
+                return (NULL);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (&writer->file);
+}
+
+
+/*!
+ * \brief Begin a section in the output file.
+ *
+ * A section that is still open (for example the \c HEADER section) is
+ * ended first.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_stream_writer_begin_section
+(
+        DxfStreamWriter *writer,
+                /*!< a pointer to the stream writer. */
+        const char *name
+                /*!< name of the section, for example \c "TABLES",
+                 * \c "BLOCKS" or \c "ENTITIES". */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if ((writer == NULL) || (name == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (writer->file.fp == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () the stream writer is not open.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (writer->in_section)
+        {
+                dxf_stream_writer_end_section (writer);
+        }
+        fprintf (writer->file.fp, "  0\nSECTION\n  2\n%s\n", name);
+        writer->in_section = TRUE;
+        if (strcmp (name, "OBJECTS") == 0)
+        {
+                writer->wrote_objects = TRUE;
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief End the open section in the output file.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_stream_writer_end_section
+(
+        DxfStreamWriter *writer
+                /*!< a pointer to the stream writer. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (writer == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if ((writer->file.fp == NULL) || (!writer->in_section))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () no section is open.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        fprintf (writer->file.fp, "  0\nENDSEC\n");
+        writer->in_section = FALSE;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Hand out the next free handle.
+ *
+ * \return the handle, or 0 when an error occurred.
+ */
+int
+dxf_stream_writer_new_handle
+(
+        DxfStreamWriter *writer
+                /*!< a pointer to the stream writer. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (writer == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (0);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (dxf_handle_allocator_next (&writer->handles));
+}
+
+
+/*!
+ * \brief Tell the stream writer that a handle was used.
+ *
+ * Handles assigned by the caller (for example to table entries written
+ * with the \c DxfFile of the stream writer) are accounted for in the
+ * handle seed, so that the patched \c $HANDSEED stays above every
+ * handle in the file.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_stream_writer_use_handle
+(
+        DxfStreamWriter *writer,
+                /*!< a pointer to the stream writer. */
+        int handle
+                /*!< the handle that was used. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (writer == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (dxf_handle_allocator_use (&writer->handles, handle));
+}
+
+
+/*!
+ * \brief Add a point to the drawing extents.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_stream_writer_add_point
+(
+        DxfStreamWriter *writer,
+                /*!< a pointer to the stream writer. */
+        double x,
+                /*!< X-coordinate of the point. */
+        double y,
+                /*!< Y-coordinate of the point. */
+        double z
+                /*!< Z-coordinate of the point. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (writer == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (!writer->has_extents)
+        {
+                writer->ext_min[0] = writer->ext_max[0] = x;
+                writer->ext_min[1] = writer->ext_max[1] = y;
+                writer->ext_min[2] = writer->ext_max[2] = z;
+                writer->has_extents = TRUE;
+        }
+        else
+        {
+                if (x < writer->ext_min[0]) writer->ext_min[0] = x;
+                if (y < writer->ext_min[1]) writer->ext_min[1] = y;
+                if (z < writer->ext_min[2]) writer->ext_min[2] = z;
+                if (x > writer->ext_max[0]) writer->ext_max[0] = x;
+                if (y > writer->ext_max[1]) writer->ext_max[1] = y;
+                if (z > writer->ext_max[2]) writer->ext_max[2] = z;
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Write a single entity to the output file.
+ *
+ * An entity without a handle (\c id_code of 0 or less) gets the next
+ * free handle, an entity with a handle moves the handle seed past it.\n
+ * The extents are updated for the supported entity types: \c ARC,
+ * \c CIRCLE, \c INSERT, \c LINE, \c LWPOLYLINE, \c POINT and \c TEXT.
+ *
+ * \warning The extents are computed from the WCS coordinates of the
+ * definition points, extrusion directions are not taken into account
+ * and arcs contribute the bounding box of their full circle.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_stream_writer_write_entity
+(
+        DxfStreamWriter *writer,
+                /*!< a pointer to the stream writer. */
+        DxfEntityType type,
+                /*!< type of the entity. */
+        void *entity
+                /*!< a pointer to the entity. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        int *id_code = NULL;
+        int status;
+
+        /* Do some basic checks. */
+        if ((writer == NULL) || (entity == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if ((writer->file.fp == NULL) || (!writer->in_section))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () no section is open.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        switch (type)
+        {
+                case ARC:
+                        id_code = &((DxfArc *) entity)->id_code;
+                        break;
+                case CIRCLE:
+                        id_code = &((DxfCircle *) entity)->id_code;
+                        break;
+                case INSERT:
+                        id_code = &((DxfInsert *) entity)->id_code;
+                        break;
+                case LINE:
+                        id_code = &((DxfLine *) entity)->id_code;
+                        break;
+                case LWPOLYLINE:
+                        id_code = &((DxfLWPolyline *) entity)->id_code;
+                        break;
+                case POINT:
+                        id_code = &((DxfPoint *) entity)->id_code;
+                        break;
+                case TEXT:
+                        id_code = &((DxfText *) entity)->id_code;
+                        break;
+                default:
+                        fprintf (stderr,
+                          (_("Error in %s () unsupported entity type: %d.\n")),
+                          __FUNCTION__, type);
+                        return (EXIT_FAILURE);
+        }
+        if (*id_code <= 0)
+        {
+                *id_code = dxf_handle_allocator_next (&writer->handles);
+        }
+        else
+        {
+                dxf_stream_writer_use_handle (writer, *id_code);
+        }
+        dxf_stream_writer_add_entity_extents (writer, type, entity);
+        switch (type)
+        {
+                case ARC:
+                        status = dxf_arc_write (&writer->file, (DxfArc *) entity);
+                        break;
+                case CIRCLE:
+                        status = dxf_circle_write (&writer->file, (DxfCircle *) entity);
+                        break;
+                case INSERT:
+                        status = dxf_insert_write (&writer->file, (DxfInsert *) entity);
+                        break;
+                case LINE:
+                        status = dxf_line_write (&writer->file, (DxfLine *) entity);
+                        break;
+                case LWPOLYLINE:
+                        status = dxf_lwpolyline_write (&writer->file, (DxfLWPolyline *) entity);
+                        break;
+                case POINT:
+                        status = dxf_point_write (&writer->file, (DxfPoint *) entity);
+                        break;
+                default:
+                        status = dxf_text_write (&writer->file, (DxfText *) entity);
+                        break;
+        }
+        if (status == EXIT_SUCCESS)
+        {
+                writer->number_of_entities++;
+                dxf_stats_count_entity_written (&writer->file, type);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (status);
+}
+
+
+/*!
+ * \brief Write a batch of entities of the same type to the output file.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred, the entities before the failing entity are written.
+ */
+int
+dxf_stream_writer_write_entities
+(
+        DxfStreamWriter *writer,
+                /*!< a pointer to the stream writer. */
+        DxfEntityType type,
+                /*!< type of the entities. */
+        void **entities,
+                /*!< array of pointers to the entities. */
+        int number_of_entities
+                /*!< number of entities in the array. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        int i;
+
+        /* Do some basic checks. */
+        if ((writer == NULL) || (entities == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        for (i = 0; i < number_of_entities; i++)
+        {
+                if (dxf_stream_writer_write_entity (writer, type, entities[i]) != EXIT_SUCCESS)
+                {
+                        return (EXIT_FAILURE);
+                }
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Close the output file of a stream writer.
+ *
+ * Ends the open section, writes an \c OBJECTS section with the root
+ * dictionary when none was written and the AutoCAD version requires
+ * one, writes the \c EOF marker and patches the \c $HANDSEED,
+ * \c $EXTMIN and \c $EXTMAX slots.\n
+ * When no extents were added, \c $EXTMIN is patched to 1e20 and
+ * \c $EXTMAX to -1e20, as AutoCAD does for an empty drawing.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_stream_writer_close
+(
+        DxfStreamWriter *writer
+                /*!< a pointer to the stream writer. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        FILE *fp = NULL;
+        double ext_min[3];
+        double ext_max[3];
+        int status = EXIT_SUCCESS;
+        char handle[DXF_HANDLE_HEX_SIZE];
+        int i;
+
+        /* Do some basic checks. */
+        if (writer == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        fp = writer->file.fp;
+        if (fp == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () the stream writer is not open.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (writer->in_section)
+        {
+                dxf_stream_writer_end_section (writer);
+        }
+        if ((!writer->wrote_objects)
+          && (writer->file.acad_version_number >= AutoCAD_13))
+        {
+                dxf_stream_writer_begin_section (writer, "OBJECTS");
+                dxf_handle_to_hex (dxf_handle_allocator_next (&writer->handles), handle);
+                fprintf (fp, "  0\nDICTIONARY\n  5\n%s\n", handle);
+                fprintf (fp, "100\nAcDbDictionary\n");
+                dxf_stream_writer_end_section (writer);
+        }
+        dxf_file_write_eof (&writer->file);
+        for (i = 0; i < 3; i++)
+        {
+                ext_min[i] = (writer->has_extents) ? writer->ext_min[i] : 1e20;
+                ext_max[i] = (writer->has_extents) ? writer->ext_max[i] : -1e20;
+        }
+        if (dxf_stream_writer_patch_slot (writer, writer->handle_seed_offset,
+          DXF_STREAM_WRITER_HANDLE_FORMAT,
+          dxf_handle_allocator_get_seed (&writer->handles)) != EXIT_SUCCESS)
+        {
+                status = EXIT_FAILURE;
+        }
+        for (i = 0; i < 3; i++)
+        {
+                if ((dxf_stream_writer_patch_slot (writer,
+                  writer->ext_min_offset[i],
+                  DXF_STREAM_WRITER_DOUBLE_FORMAT, ext_min[i]) != EXIT_SUCCESS)
+                  || (dxf_stream_writer_patch_slot (writer,
+                  writer->ext_max_offset[i],
+                  DXF_STREAM_WRITER_DOUBLE_FORMAT, ext_max[i]) != EXIT_SUCCESS))
+                {
+                        status = EXIT_FAILURE;
+                }
+        }
+        if (ferror (fp))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not write to file: %s.\n")),
+                  __FUNCTION__, writer->file.filename);
+                status = EXIT_FAILURE;
+        }
+        if (fp == stdout)
+        {
+                if (fflush (fp) != 0)
+                {
+                        status = EXIT_FAILURE;
+                }
+        }
+        else if (fclose (fp) != 0)
+        {
+                status = EXIT_FAILURE;
+        }
+        free (writer->buffer);
+        free (writer->file.filename);
+        writer->buffer = NULL;
+        writer->file.filename = NULL;
+        writer->file.fp = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (status);
+}
+
+
+/*!
+ * \brief Free the allocated memory for a \c DxfStreamWriter.
+ *
+ * An open output file is closed first.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_stream_writer_free
+(
+        DxfStreamWriter *writer
+                /*!< a pointer to the stream writer. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        int status = EXIT_SUCCESS;
+
+        /* Do some basic checks. */
+        if (writer == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (writer->file.fp != NULL)
+        {
+                status = dxf_stream_writer_close (writer);
+        }
+        free (writer);
+        writer = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (status);
+}
+
+
+/*!
+ * \brief Write a group code and a fixed width value, and remember the
+ * offset of the value for dxf_stream_writer_patch_slot ().
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when the
+ * output is not seekable.
+ */
+static int
+dxf_stream_writer_write_slot
+(
+        DxfStreamWriter *writer,
+                /*!< a pointer to the stream writer. */
+        int group_code,
+                /*!< group code of the slot. */
+        long *offset,
+                /*!< offset of the value, -1 when the output is not
+                 * seekable. */
+        const char *format,
+                /*!< fixed width format of the value. */
+        ...
+)
+{
+        va_list args;
+
+        fprintf (writer->file.fp, "%3d\n", group_code);
+        *offset = ftell (writer->file.fp);
+        va_start (args, format);
+        vfprintf (writer->file.fp, format, args);
+        va_end (args);
+        fprintf (writer->file.fp, "\n");
+        return ((*offset < 0) ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Overwrite the value in a reserved slot.
+ *
+ * The file position is restored to the end of the file afterwards.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_stream_writer_patch_slot
+(
+        DxfStreamWriter *writer,
+                /*!< a pointer to the stream writer. */
+        long offset,
+                /*!< offset of the value. */
+        const char *format,
+                /*!< fixed width format of the value, as passed to
+                 * dxf_stream_writer_write_slot (). */
+        ...
+)
+{
+        va_list args;
+
+        if (offset < 0)
+        {
+                /* The output is not seekable, keep the initial value. */
+                return (EXIT_SUCCESS);
+        }
+        if (fseek (writer->file.fp, offset, SEEK_SET) != 0)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not seek in file: %s.\n")),
+                  __FUNCTION__, writer->file.filename);
+                return (EXIT_FAILURE);
+        }
+        va_start (args, format);
+        vfprintf (writer->file.fp, format, args);
+        va_end (args);
+        fseek (writer->file.fp, 0, SEEK_END);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Add the definition points of an entity to the extents.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_stream_writer_add_entity_extents
+(
+        DxfStreamWriter *writer,
+                /*!< a pointer to the stream writer. */
+        DxfEntityType type,
+                /*!< type of the entity. */
+        void *entity
+                /*!< a pointer to the entity. */
+)
+{
+        DxfPoint *p0 = NULL;
+        DxfVertex *iter = NULL;
+        double radius;
+
+        switch (type)
+        {
+                case ARC:
+                case CIRCLE:
+                        if (type == ARC)
+                        {
+                                p0 = ((DxfArc *) entity)->p0;
+                                radius = ((DxfArc *) entity)->radius;
+                        }
+                        else
+                        {
+                                p0 = ((DxfCircle *) entity)->p0;
+                                radius = ((DxfCircle *) entity)->radius;
+                        }
+                        if (p0 == NULL)
+                        {
+                                return (EXIT_FAILURE);
+                        }
+                        dxf_stream_writer_add_point (writer,
+                          p0->x0 - radius, p0->y0 - radius, p0->z0);
+                        dxf_stream_writer_add_point (writer,
+                          p0->x0 + radius, p0->y0 + radius, p0->z0);
+                        break;
+                case INSERT:
+                        dxf_stream_writer_add_dxf_point (writer,
+                          ((DxfInsert *) entity)->p0);
+                        break;
+                case LINE:
+                        dxf_stream_writer_add_dxf_point (writer,
+                          ((DxfLine *) entity)->p0);
+                        dxf_stream_writer_add_dxf_point (writer,
+                          ((DxfLine *) entity)->p1);
+                        break;
+                case LWPOLYLINE:
+                        iter = (DxfVertex *) ((DxfLWPolyline *) entity)->vertices;
+                        while (iter != NULL)
+                        {
+                                if (iter->p0 != NULL)
+                                {
+                                        dxf_stream_writer_add_point (writer,
+                                          iter->p0->x0, iter->p0->y0,
+                                          ((DxfLWPolyline *) entity)->elevation);
+                                }
+                                iter = (DxfVertex *) iter->next;
+                        }
+                        break;
+                case POINT:
+                        dxf_stream_writer_add_point (writer,
+                          ((DxfPoint *) entity)->x0,
+                          ((DxfPoint *) entity)->y0,
+                          ((DxfPoint *) entity)->z0);
+                        break;
+                case TEXT:
+                        dxf_stream_writer_add_dxf_point (writer,
+                          ((DxfText *) entity)->p0);
+                        break;
+                default:
+                        return (EXIT_FAILURE);
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Add a \c DxfPoint to the extents, a \c NULL point is skipped.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when a \c NULL
+ * point was passed.
+ */
+static int
+dxf_stream_writer_add_dxf_point
+(
+        DxfStreamWriter *writer,
+                /*!< a pointer to the stream writer. */
+        DxfPoint *point
+                /*!< a pointer to the point. */
+)
+{
+        if (point == NULL)
+        {
+                return (EXIT_FAILURE);
+        }
+        return (dxf_stream_writer_add_point (writer,
+          point->x0, point->y0, point->z0));
+}
+
+
+/* EOF */
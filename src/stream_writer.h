@@ -0,0 +1,127 @@
+/*!
+ * \file stream_writer.h
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Header file for streaming (append-mode) output of DXF files.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#ifndef LIBDXF_SRC_STREAM_WRITER_H
+#define LIBDXF_SRC_STREAM_WRITER_H
+
+
+#include "global.h"
+#include "entity.h"
+#include "handle.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define DXF_STREAM_WRITER_BUFFER_SIZE 1048576
+        /*!< \brief Size of the stdio output buffer of a stream
+         * writer. */
+
+#define DXF_STREAM_WRITER_HANDLE_FORMAT "%016X"
+        /*!< \brief Fixed width format of the reserved \c $HANDSEED
+         * slot. */
+
+#define DXF_STREAM_WRITER_DOUBLE_FORMAT "%24.16e"
+        /*!< \brief Fixed width format of the reserved \c $EXTMIN and
+         * \c $EXTMAX coordinate slots. */
+
+
+/*!
+ * \brief Definition of a streaming DXF writer.
+ *
+ * The writer keeps no entities, only the running extents and the next
+ * free handle, which are patched into reserved fixed width slots of the
+ * \c HEADER section when the writer is closed.
+ */
+typedef struct
+dxf_stream_writer_struct
+{
+        DxfFile file;
+                /*!< DXF file handle of the output file, passed to the
+                 * entity writers. */
+        char *buffer;
+                /*!< stdio output buffer. */
+        int in_section;
+                /*!< \c TRUE while a section is open. */
+        int wrote_objects;
+                /*!< \c TRUE when an \c OBJECTS section was written. */
+        long handle_seed_offset;
+                /*!< Offset of the \c $HANDSEED slot, -1 when the output
+                 * is not seekable. */
+        long ext_min_offset[3];
+                /*!< Offsets of the \c $EXTMIN coordinate slots. */
+        long ext_max_offset[3];
+                /*!< Offsets of the \c $EXTMAX coordinate slots. */
+        DxfHandleAllocator handles;
+                /*!< Handle allocator, the next handle is the handle
+                 * seed. */
+        int has_extents;
+                /*!< \c TRUE when at least one point was added to the
+                 * extents. */
+        double ext_min[3];
+                /*!< Lower left corner of the extents. */
+        double ext_max[3];
+                /*!< Upper right corner of the extents. */
+        long number_of_entities;
+                /*!< Number of entities written by
+                 * dxf_stream_writer_write_entity (). */
+} DxfStreamWriter;
+
+
+DxfStreamWriter *dxf_stream_writer_new ();
+DxfStreamWriter *dxf_stream_writer_init (DxfStreamWriter *writer);
+int dxf_stream_writer_open (DxfStreamWriter *writer, const char *filename, int acad_version_number);
+DxfFile *dxf_stream_writer_get_file (DxfStreamWriter *writer);
+int dxf_stream_writer_begin_section (DxfStreamWriter *writer, const char *name);
+int dxf_stream_writer_end_section (DxfStreamWriter *writer);
+int dxf_stream_writer_new_handle (DxfStreamWriter *writer);
+int dxf_stream_writer_use_handle (DxfStreamWriter *writer, int handle);
+int dxf_stream_writer_add_point (DxfStreamWriter *writer, double x, double y, double z);
+int dxf_stream_writer_write_entity (DxfStreamWriter *writer, DxfEntityType type, void *entity);
+int dxf_stream_writer_write_entities (DxfStreamWriter *writer, DxfEntityType type, void **entities, int number_of_entities);
+int dxf_stream_writer_close (DxfStreamWriter *writer);
+int dxf_stream_writer_free (DxfStreamWriter *writer);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* LIBDXF_SRC_STREAM_WRITER_H */
+
+
+/* EOF */
@@ -47,6 +47,7 @@
 
 
 #include "style.h"
+#include "util.h"
 
 
 /*!
@@ -122,15 +123,15 @@ dxf_style_init
         style->id_code = 0;
         style->style_name = strdup ("");
         style->primary_font_filename = strdup ("");
-        style->big_font_filename = strdup ("");
+        style->big_font_filename = dxf_string_share ("");
         style->height = 0.0;
         style->width = 0.0;
         style->last_height = 0.0;
         style->oblique_angle = 0.0;
         style->flag = 0;
         style->text_generation_flag = 0;
-        style->dictionary_owner_soft = strdup ("");
-        style->dictionary_owner_hard = strdup ("");
+        style->dictionary_owner_soft = dxf_string_share ("");
+        style->dictionary_owner_hard = dxf_string_share ("");
         style->ttf_flags = 0;
         style->next = NULL;
 #if DEBUG
@@ -221,8 +222,7 @@ dxf_style_read
                 {
                         /* Now follows a string containing a big font
                          * filename. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", style->big_font_filename);
+                        dxf_read_string (fp, &style->big_font_filename);
                 }
                 else if (strcmp (temp_string, "40") == 0)
                 {
@@ -285,15 +285,13 @@ dxf_style_read
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", style->dictionary_owner_soft);
+                        dxf_read_string (fp, &style->dictionary_owner_soft);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", style->dictionary_owner_hard);
+                        dxf_read_string (fp, &style->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "999") == 0)
                 {
@@ -468,9 +466,9 @@ dxf_style_free
         }
         free (style->style_name);
         free (style->primary_font_filename);
-        free (style->big_font_filename);
-        free (style->dictionary_owner_soft);
-        free (style->dictionary_owner_hard);
+        dxf_string_free (style->big_font_filename);
+        dxf_string_free (style->dictionary_owner_soft);
+        dxf_string_free (style->dictionary_owner_hard);
         free (style);
         style = NULL;
 #if DEBUG
@@ -810,6 +808,8 @@ dxf_style_set_big_font_filename
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (style == NULL)
         {
@@ -825,7 +825,13 @@ dxf_style_set_big_font_filename
                   __FUNCTION__);
                 return (NULL);
         }
-        style->big_font_filename = strdup (big_font_filename);
+        copy = dxf_string_share (big_font_filename);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (style->big_font_filename);
+        style->big_font_filename = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1556,6 +1562,8 @@ dxf_style_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (style == NULL)
         {
@@ -1571,7 +1579,13 @@ dxf_style_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        style->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (style->dictionary_owner_soft);
+        style->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1636,6 +1650,8 @@ dxf_style_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (style == NULL)
         {
@@ -1651,7 +1667,13 @@ dxf_style_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        style->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (style->dictionary_owner_hard);
+        style->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
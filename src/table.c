@@ -45,6 +45,8 @@
 
 
 #include "table.h"
+#include "stats.h"
+#include "util.h"
 
 
 /*!
@@ -115,6 +117,7 @@ dxf_table_new ()
         else
         {
                 memset (table, 0, size);
+                dxf_stats_count_allocation (TABLE, size);
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -157,13 +160,13 @@ dxf_table_cell_init
                   __FUNCTION__);
                 return (NULL);
         }
-        cell->text_string = strdup ("");
+        cell->text_string = dxf_string_share ("");
         for (i = 0; i < DXF_MAX_PARAM; i++)
         {
                 cell->optional_text_string[i] = strdup ("");
                 cell->attdef_soft_pointer[i] = strdup ("");
         }
-        cell->text_style_name = strdup (DXF_DEFAULT_TEXTSTYLE);
+        cell->text_style_name = dxf_string_share (DXF_DEFAULT_TEXTSTYLE);
         cell->color_bg = 0;
         cell->color_fg = DXF_COLOR_BYLAYER;
         cell->border_color_right = DXF_COLOR_BYLAYER;
@@ -192,9 +195,9 @@ dxf_table_cell_init
         cell->border_visibility_override_bottom = 0;
         cell->border_visibility_override_left = 0;
         cell->border_visibility_override_top = 0;
-        cell->attdef_text_string = strdup ("");
-        cell->block_table_record_hard_pointer = strdup ("");
-        cell->field_object_pointer = strdup ("");
+        cell->attdef_text_string = dxf_string_share ("");
+        cell->block_table_record_hard_pointer = dxf_string_share ("");
+        cell->field_object_pointer = dxf_string_share ("");
         cell->next = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -238,8 +241,8 @@ dxf_table_init
                 return (NULL);
         }
         table->id_code = 0;
-        table->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        table->layer = strdup (DXF_DEFAULT_LAYER);
+        table->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        table->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         table->elevation = 0.0;
         table->thickness = 0.0;
         table->visibility = 0;
@@ -252,10 +255,10 @@ dxf_table_init
                 table->row_height[i] = 0.0;
                 table->column_height[i] = 0.0;
         }
-        table->dictionary_owner_soft = strdup ("");
-        table->dictionary_owner_hard = strdup ("");
-        table->block_name = strdup ("");
-        table->table_text_style_name = strdup ("");
+        table->dictionary_owner_soft = dxf_string_share ("");
+        table->dictionary_owner_hard = dxf_string_share ("");
+        table->block_name = dxf_string_share ("");
+        table->table_text_style_name = dxf_string_share ("");
         table->x0 = 0.0;
         table->y0 = 0.0;
         table->z0 = 0.0;
@@ -284,8 +287,8 @@ dxf_table_init
         table->suppress_table_title = 0;
         table->suppress_header_row = 0;
         table->table_cell_color_fill_override = 0;
-        table->tablestyle_object_pointer = strdup ("");
-        table->owning_block_pointer = strdup ("");
+        table->tablestyle_object_pointer = dxf_string_share ("");
+        table->owning_block_pointer = dxf_string_share ("");
         table->cells = NULL;
         table->next = NULL;
 #if DEBUG
@@ -364,7 +367,7 @@ dxf_table_read
                 {
                         /* Now follows a string containing a block name;
                          * an anonymous block begins with a *T value. */
-                        fscanf (fp->fp, "%s\n", table->block_name);
+                        dxf_read_string (fp, &table->block_name);
                 }
                 if (strcmp (temp_string, "5") == 0)
                 {
@@ -521,29 +524,25 @@ dxf_table_read
                 {
                         /* Now follows a string containing a soft-pointer
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", table->dictionary_owner_soft);
+                        dxf_read_string (fp, &table->dictionary_owner_soft);
                 }
                 else if (strcmp (temp_string, "342") == 0)
                 {
                         /* Now follows a string containing a hard pointer
                          * ID of the TABLESTYLE object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", table->tablestyle_object_pointer);
+                        dxf_read_string (fp, &table->tablestyle_object_pointer);
                 }
                 else if (strcmp (temp_string, "343") == 0)
                 {
                         /* Now follows a string containing a hard pointer
                          * ID of the owning BLOCK record. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", table->owning_block_pointer);
+                        dxf_read_string (fp, &table->owning_block_pointer);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing a hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", table->dictionary_owner_hard);
+                        dxf_read_string (fp, &table->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "999") == 0)
                 {
@@ -787,16 +786,16 @@ dxf_table_cell_free
                 __FUNCTION__);
               return (EXIT_FAILURE);
         }
-        free (cell->text_string);
+        dxf_string_free (cell->text_string);
         for (i = 0; i < DXF_MAX_PARAM; i++)
         {
                 free (cell->optional_text_string[i]);
                 free (cell->attdef_soft_pointer[i]);
         }
-        free (cell->text_style_name);
-        free (cell->attdef_text_string);
-        free (cell->block_table_record_hard_pointer);
-        free (cell->field_object_pointer);
+        dxf_string_free (cell->text_style_name);
+        dxf_string_free (cell->attdef_text_string);
+        dxf_string_free (cell->block_table_record_hard_pointer);
+        dxf_string_free (cell->field_object_pointer);
         free (cell);
         cell = NULL;
 #if DEBUG
@@ -840,18 +839,18 @@ dxf_table_free
                 __FUNCTION__);
               return (EXIT_FAILURE);
         }
-        free (table->linetype);
-        free (table->layer);
+        dxf_string_free (table->linetype);
+        dxf_string_free (table->layer);
         for (i = 0; i < DXF_MAX_PARAM; i++)
         {
                 free (table->binary_graphics_data[i]);
         }
-        free (table->dictionary_owner_soft);
-        free (table->dictionary_owner_hard);
-        free (table->block_name);
-        free (table->table_text_style_name);
-        free (table->tablestyle_object_pointer);
-        free (table->owning_block_pointer);
+        dxf_string_free (table->dictionary_owner_soft);
+        dxf_string_free (table->dictionary_owner_hard);
+        dxf_string_free (table->block_name);
+        dxf_string_free (table->table_text_style_name);
+        dxf_string_free (table->tablestyle_object_pointer);
+        dxf_string_free (table->owning_block_pointer);
 //        dxf_table_cells_free_list (table->cells);
         free (table);
         table = NULL;
@@ -36,6 +36,9 @@
 #include "section.h"
 
 
+static void **dxf_tables_get_list_member (DxfTables *tables, DxfTablesType type, size_t *next_offset);
+
+
 /*!
  * \brief Allocate memory for a DXF \c TABLES section.
  *
@@ -91,6 +94,10 @@ dxf_tables_init
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        void **list_member = NULL;
+        size_t next_offset;
+        int i;
+
         /* Do some basic checks. */
         if (tables == NULL)
         {
@@ -116,6 +123,12 @@ dxf_tables_init
         tables->ucss = (DxfUcs *) dxf_ucs_init ((DxfUcs *) tables->ucss);
         tables->views = (DxfView *) dxf_view_init ((DxfView *) tables->views);
         tables->vports = (DxfVPort *) dxf_vport_init ((DxfVPort *) tables->vports);
+        for (i = 0; i < DXF_TABLES_NUMBER_OF_TYPES; i++)
+        {
+                list_member = dxf_tables_get_list_member (tables, (DxfTablesType) i, &next_offset);
+                dxf_list_init (&tables->lists[i], next_offset);
+                dxf_list_set_head (&tables->lists[i], *list_member);
+        }
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -180,6 +193,8 @@ dxf_tables_free
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        int i;
+
         if (tables == NULL)
         {
                 fprintf (stderr,
@@ -187,15 +202,20 @@ dxf_tables_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (tables->appids);
-        free (tables->block_records);
-        free (tables->dimstyles);
-        free (tables->layers);
-        free (tables->ltypes);
-        free (tables->styles);
-        free (tables->ucss);
-        free (tables->views);
-        free (tables->vports);
+        dxf_appid_free_list (tables->appids);
+        dxf_block_record_free_list (tables->block_records);
+        dxf_dimstyle_free_list (tables->dimstyles);
+        dxf_layer_free_list (tables->layers);
+        dxf_ltype_free_list (tables->ltypes);
+        dxf_style_free_list (tables->styles);
+        dxf_ucs_free_list (tables->ucss);
+        dxf_view_free_list (tables->views);
+        dxf_vport_free_list (tables->vports);
+        for (i = 0; i < DXF_TABLES_NUMBER_OF_TYPES; i++)
+        {
+                dxf_list_clear (&tables->lists[i]);
+        }
+        free (tables);
         tables = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -345,6 +365,7 @@ dxf_tables_set_appids
                 return (NULL);
         }
         tables->appids = appids;
+        dxf_list_set_head (&tables->lists[DXF_TABLES_APPID], tables->appids);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -420,6 +441,7 @@ dxf_tables_set_block_records
                 return (NULL);
         }
         tables->block_records = block_records;
+        dxf_list_set_head (&tables->lists[DXF_TABLES_BLOCK_RECORD], tables->block_records);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -495,6 +517,7 @@ dxf_tables_set_dimstyles
                 return (NULL);
         }
         tables->dimstyles = dimstyles;
+        dxf_list_set_head (&tables->lists[DXF_TABLES_DIMSTYLE], tables->dimstyles);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -570,6 +593,7 @@ dxf_tables_set_layers
                 return (NULL);
         }
         tables->layers = layers;
+        dxf_list_set_head (&tables->lists[DXF_TABLES_LAYER], tables->layers);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -645,6 +669,7 @@ dxf_tables_set_ltypes
                 return (NULL);
         }
         tables->ltypes = ltypes;
+        dxf_list_set_head (&tables->lists[DXF_TABLES_LTYPE], tables->ltypes);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -720,6 +745,7 @@ dxf_tables_set_styles
                 return (NULL);
         }
         tables->styles = styles;
+        dxf_list_set_head (&tables->lists[DXF_TABLES_STYLE], tables->styles);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -795,6 +821,7 @@ dxf_tables_set_ucss
                 return (NULL);
         }
         tables->ucss = ucss;
+        dxf_list_set_head (&tables->lists[DXF_TABLES_UCS], tables->ucss);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -870,6 +897,7 @@ dxf_tables_set_views
                 return (NULL);
         }
         tables->views = views;
+        dxf_list_set_head (&tables->lists[DXF_TABLES_VIEW], tables->views);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -945,6 +973,7 @@ dxf_tables_set_vports
                 return (NULL);
         }
         tables->vports = vports;
+        dxf_list_set_head (&tables->lists[DXF_TABLES_VPORT], tables->vports);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -952,4 +981,203 @@ dxf_tables_set_vports
 }
 
 
+/*!
+ * \brief Append an entry to a symbol table in a DXF \c TABLES section.
+ *
+ * The entry is linked after the last entry of the symbol table without
+ * walking the list, the \c next member of the entry is set to
+ * \c NULL.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_tables_append
+(
+        DxfTables *tables,
+                /*!< a pointer to a DXF \c TABLES section. */
+        void *entry,
+                /*!< a pointer to the symbol table entry. */
+        DxfTablesType type
+                /*!< type of the symbol table. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        void **list_member = NULL;
+        size_t next_offset;
+
+        /* Do some basic checks. */
+        if ((tables == NULL) || (entry == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        list_member = dxf_tables_get_list_member (tables, type, &next_offset);
+        if (list_member == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () an invalid symbol table type was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        /* Take over a list that was linked by other means. */
+        if (*list_member != dxf_list_get_head (&tables->lists[type]))
+        {
+                dxf_list_set_head (&tables->lists[type], *list_member);
+        }
+        if (dxf_list_append (&tables->lists[type], entry) != EXIT_SUCCESS)
+        {
+                return (EXIT_FAILURE);
+        }
+        *list_member = dxf_list_get_head (&tables->lists[type]);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Get the number of entries in a symbol table in a DXF
+ * \c TABLES section.
+ *
+ * \return the number of entries, or -1 when an error occurred.
+ */
+int
+dxf_tables_get_number_of_entries
+(
+        DxfTables *tables,
+                /*!< a pointer to a DXF \c TABLES section. */
+        DxfTablesType type
+                /*!< type of the symbol table. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (tables == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (-1);
+        }
+        if (((int) type < 0) || ((int) type >= DXF_TABLES_NUMBER_OF_TYPES))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () an invalid symbol table type was passed.\n")),
+                  __FUNCTION__);
+                return (-1);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (dxf_list_get_number_of_items (&tables->lists[type]));
+}
+
+
+/*!
+ * \brief Get the entry at a position in a symbol table in a DXF
+ * \c TABLES section.
+ *
+ * \return a pointer to the entry, \c NULL when the position is out of
+ * range or an error occurred.
+ */
+void *
+dxf_tables_get_entry
+(
+        DxfTables *tables,
+                /*!< a pointer to a DXF \c TABLES section. */
+        DxfTablesType type,
+                /*!< type of the symbol table. */
+        int position
+                /*!< position of the entry in the symbol table,
+                 * starting at 0. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (tables == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        if (((int) type < 0) || ((int) type >= DXF_TABLES_NUMBER_OF_TYPES))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () an invalid symbol table type was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (dxf_list_get_item (&tables->lists[type], position));
+}
+
+
+/*!
+ * \brief Get the address of the list member for a symbol table type in
+ * a DXF \c TABLES section.
+ *
+ * \return the address of the member, \c NULL for an invalid symbol
+ * table type.
+ */
+static void **
+dxf_tables_get_list_member
+(
+        DxfTables *tables,
+                /*!< a pointer to a DXF \c TABLES section. */
+        DxfTablesType type,
+                /*!< type of the symbol table. */
+        size_t *next_offset
+                /*!< offset of the \c next member in the entry
+                 * struct. */
+)
+{
+        switch (type)
+        {
+                case DXF_TABLES_APPID:
+                        *next_offset = offsetof (DxfAppid, next);
+                        return ((void **) &tables->appids);
+                case DXF_TABLES_BLOCK_RECORD:
+                        *next_offset = offsetof (DxfBlockRecord, next);
+                        return ((void **) &tables->block_records);
+                case DXF_TABLES_DIMSTYLE:
+                        *next_offset = offsetof (DxfDimStyle, next);
+                        return ((void **) &tables->dimstyles);
+                case DXF_TABLES_LAYER:
+                        *next_offset = offsetof (DxfLayer, next);
+                        return ((void **) &tables->layers);
+                case DXF_TABLES_LTYPE:
+                        *next_offset = offsetof (DxfLType, next);
+                        return ((void **) &tables->ltypes);
+                case DXF_TABLES_STYLE:
+                        *next_offset = offsetof (DxfStyle, next);
+                        return ((void **) &tables->styles);
+                case DXF_TABLES_UCS:
+                        *next_offset = offsetof (DxfUcs, next);
+                        return ((void **) &tables->ucss);
+                case DXF_TABLES_VIEW:
+                        *next_offset = offsetof (DxfView, next);
+                        return ((void **) &tables->views);
+                case DXF_TABLES_VPORT:
+                        *next_offset = offsetof (DxfVPort, next);
+                        return ((void **) &tables->vports);
+                default:
+                        *next_offset = 0;
+                        return (NULL);
+        }
+}
+
+
 /* EOF */
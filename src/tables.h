@@ -60,6 +60,7 @@
 #include "block_record.h"
 #include "dimstyle.h"
 #include "layer.h"
+#include "list.h"
 #include "ltype.h"
 #include "style.h"
 #include "ucs.h"
@@ -72,6 +73,29 @@ extern "C" {
 #endif
 
 
+/*!
+ * \brief DXF symbol table types in a \c TABLES section.
+ */
+typedef enum
+dxf_tables_type
+{
+        DXF_TABLES_APPID,
+        DXF_TABLES_BLOCK_RECORD,
+        DXF_TABLES_DIMSTYLE,
+        DXF_TABLES_LAYER,
+        DXF_TABLES_LTYPE,
+        DXF_TABLES_STYLE,
+        DXF_TABLES_UCS,
+        DXF_TABLES_VIEW,
+        DXF_TABLES_VPORT
+} DxfTablesType;
+
+
+#define DXF_TABLES_NUMBER_OF_TYPES (DXF_TABLES_VPORT + 1)
+        /*!< \brief The number of symbol table types in
+         * \c DxfTablesType. */
+
+
 /*!
  * \brief DXF definition of a tables section.
  */
@@ -99,6 +123,10 @@ dxf_tables_struct
                 /*!< Pointer to the first \c VIEW symbol table entry. */
         DxfVPort *vports;
                 /*!< Pointer to the first \c VPORT symbol table entry. */
+        DxfList lists[DXF_TABLES_NUMBER_OF_TYPES];
+                /*!< List containers for the symbol tables above,
+                 * indexed by symbol table type, for O(1) appends and
+                 * random access. */
 } DxfTables;
 
 
@@ -126,6 +154,9 @@ DxfView *dxf_tables_get_views (DxfTables *tables);
 DxfTables *dxf_tables_set_views (DxfTables *tables, DxfView *views);
 DxfVPort *dxf_tables_get_vports (DxfTables *tables);
 DxfTables *dxf_tables_set_vports (DxfTables *tables, DxfVPort *vports);
+int dxf_tables_append (DxfTables *tables, void *entry, DxfTablesType type);
+int dxf_tables_get_number_of_entries (DxfTables *tables, DxfTablesType type);
+void *dxf_tables_get_entry (DxfTables *tables, DxfTablesType type, int position);
 
 
 #ifdef __cplusplus
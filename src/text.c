@@ -42,6 +42,8 @@
 
 
 #include "text.h"
+#include "stats.h"
+#include "util.h"
 
 
 /*!
@@ -71,6 +73,7 @@ dxf_text_new ()
         else
         {
                 memset (text, 0, size);
+                dxf_stats_count_allocation (TEXT, size);
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -111,8 +114,8 @@ dxf_text_init
               return (NULL);
         }
         text->id_code = 0;
-        text->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        text->layer = strdup (DXF_DEFAULT_LAYER);
+        text->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        text->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         text->elevation = 0.0;
         text->thickness = 0.0;
         text->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
@@ -121,18 +124,17 @@ dxf_text_init
         text->paperspace = DXF_MODELSPACE;
         text->graphics_data_size = 0;
         text->shadow_mode = 0;
-        text->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_new ();
-        text->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) text->binary_graphics_data);
-        text->dictionary_owner_soft = strdup ("");
-        text->material = strdup ("");
-        text->dictionary_owner_hard = strdup ("");
+        text->binary_graphics_data = NULL;
+        text->dictionary_owner_soft = dxf_string_share ("");
+        text->material = dxf_string_share ("");
+        text->dictionary_owner_hard = dxf_string_share ("");
         text->lineweight = 0;
-        text->plot_style_name = strdup ("");
+        text->plot_style_name = dxf_string_share ("");
         text->color_value = 0;
-        text->color_name = strdup ("");
+        text->color_name = dxf_string_share ("");
         text->transparency = 0;
-        text->text_value = strdup ("");
-        text->text_style = strdup ("");
+        text->text_value = dxf_string_share ("");
+        text->text_style = dxf_string_share ("");
         text->p0 = (DxfPoint *) dxf_point_new ();
         text->p0 = dxf_point_init ((DxfPoint *) text->p0);
         text->p0->x0 = 0.0;
@@ -223,8 +225,7 @@ dxf_text_read
                 if (strcmp (temp_string, "1") == 0)
                 {
                         /* Now follows a string containing a text value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", text->text_value);
+                        dxf_read_string (fp, &text->text_value);
                 }
                 else if (strcmp (temp_string, "5") == 0)
                 {
@@ -237,21 +238,18 @@ dxf_text_read
                 {
                         /* Now follows a string containing a linetype
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", text->linetype);
+                        dxf_read_string (fp, &text->linetype);
                 }
                 else if (strcmp (temp_string, "7") == 0)
                 {
                         /* Now follows a string containing a text style
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", text->text_style);
+                        dxf_read_string (fp, &text->text_style);
                 }
                 else if (strcmp (temp_string, "8") == 0)
                 {
                         /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", text->layer);
+                        dxf_read_string (fp, &text->layer);
                 }
                 else if (strcmp (temp_string, "10") == 0)
                 {
@@ -449,31 +447,25 @@ dxf_text_read
                 {
                         /* Now follows a string containing binary
                          * graphics data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", text->binary_graphics_data->data_line);
-                        dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) text->binary_graphics_data->next);
-                        text->binary_graphics_data = (DxfBinaryGraphicsData *) text->binary_graphics_data->next;
+                        dxf_binary_graphics_data_read (fp, &text->binary_graphics_data, NULL);
                 }
                 else if (strcmp (temp_string, "330") == 0)
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", text->dictionary_owner_soft);
+                        dxf_read_string (fp, &text->dictionary_owner_soft);
                 }
                 else if (strcmp (temp_string, "347") == 0)
                 {
                         /* Now follows a string containing a
                          * hard-pointer ID/handle to material object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", text->material);
+                        dxf_read_string (fp, &text->material);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", text->dictionary_owner_hard);
+                        dxf_read_string (fp, &text->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "370") == 0)
                 {
@@ -486,8 +478,7 @@ dxf_text_read
                 {
                         /* Now follows a string containing a plot style
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", text->plot_style_name);
+                        dxf_read_string (fp, &text->plot_style_name);
                 }
                 else if (strcmp (temp_string, "420") == 0)
                 {
@@ -499,8 +490,7 @@ dxf_text_read
                 {
                         /* Now follows a string containing a color
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", text->color_name);
+                        dxf_read_string (fp, &text->color_name);
                 }
                 else if (strcmp (temp_string, "440") == 0)
                 {
@@ -534,11 +524,13 @@ dxf_text_read
         }
         if (strcmp (text->linetype, "") == 0)
         {
-                text->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (text->linetype);
+                text->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (text->layer, "") == 0)
         {
-                text->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (text->layer);
+                text->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Clean up. */
         free (temp_string);
@@ -600,7 +592,9 @@ dxf_text_write
                 fprintf (stderr,
                   (_("Warning in %s () text style string is empty for the %s entity with id-code: %x\n")),
                   __FUNCTION__, dxf_entity_name, text->id_code);
-                text->text_style = strdup (DXF_DEFAULT_TEXTSTYLE);        }
+                dxf_string_free (text->text_style);
+                text->text_style = dxf_string_share (DXF_DEFAULT_TEXTSTYLE);
+        }
         if (strcmp (text->layer, "") == 0)
         {
                 fprintf (stderr,
@@ -609,7 +603,8 @@ dxf_text_write
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0")),
                   dxf_entity_name);
-                text->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (text->layer);
+                text->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         if (text->height == 0.0)
         {
@@ -840,16 +835,19 @@ dxf_text_free
                 __FUNCTION__);
               return (EXIT_FAILURE);
         }
-        free (text->linetype);
-        free (text->layer);
-        dxf_binary_graphics_data_free_list (text->binary_graphics_data);
-        free (text->dictionary_owner_soft);
-        free (text->material);
-        free (text->dictionary_owner_hard);
-        free (text->plot_style_name);
-        free (text->color_name);
-        free (text->text_value);
-        free (text->text_style);
+        dxf_string_free (text->linetype);
+        dxf_string_free (text->layer);
+        if (text->binary_graphics_data != NULL)
+        {
+                dxf_binary_graphics_data_free_list (text->binary_graphics_data);
+        }
+        dxf_string_free (text->dictionary_owner_soft);
+        dxf_string_free (text->material);
+        dxf_string_free (text->dictionary_owner_hard);
+        dxf_string_free (text->plot_style_name);
+        dxf_string_free (text->color_name);
+        dxf_string_free (text->text_value);
+        dxf_string_free (text->text_style);
         dxf_point_free (text->p0);
         dxf_point_free (text->p1);
         free (text);
@@ -1022,6 +1020,8 @@ dxf_text_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (text == NULL)
         {
@@ -1037,7 +1037,13 @@ dxf_text_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        text->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (text->linetype);
+        text->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1098,6 +1104,8 @@ dxf_text_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (text == NULL)
         {
@@ -1113,7 +1121,13 @@ dxf_text_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        text->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (text->layer);
+        text->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1888,6 +1902,8 @@ dxf_text_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (text == NULL)
         {
@@ -1903,7 +1919,13 @@ dxf_text_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        text->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (text->dictionary_owner_soft);
+        text->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1970,6 +1992,8 @@ dxf_text_set_material
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (text == NULL)
         {
@@ -1985,7 +2009,13 @@ dxf_text_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        text->material = strdup (material);
+        copy = dxf_string_share (material);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (text->material);
+        text->material = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2050,6 +2080,8 @@ dxf_text_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (text == NULL)
         {
@@ -2065,7 +2097,13 @@ dxf_text_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        text->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (text->dictionary_owner_hard);
+        text->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2195,6 +2233,8 @@ dxf_text_set_plot_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (text == NULL)
         {
@@ -2210,7 +2250,13 @@ dxf_text_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        text->plot_style_name = strdup (plot_style_name);
+        copy = dxf_string_share (plot_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (text->plot_style_name);
+        text->plot_style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2340,6 +2386,8 @@ dxf_text_set_color_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (text == NULL)
         {
@@ -2355,7 +2403,13 @@ dxf_text_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        text->color_name = strdup (color_name);
+        copy = dxf_string_share (color_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (text->color_name);
+        text->color_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2485,6 +2539,8 @@ dxf_text_set_text_value
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (text == NULL)
         {
@@ -2500,7 +2556,13 @@ dxf_text_set_text_value
                   __FUNCTION__);
                 return (NULL);
         }
-        text->text_value = strdup (text_value);
+        copy = dxf_string_share (text_value);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (text->text_value);
+        text->text_value = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2565,6 +2627,8 @@ dxf_text_set_text_style
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (text == NULL)
         {
@@ -2580,7 +2644,13 @@ dxf_text_set_text_style
                   __FUNCTION__);
                 return (NULL);
         }
-        text->text_style = strdup (text_style);
+        copy = dxf_string_share (text_style);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (text->text_style);
+        text->text_style = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
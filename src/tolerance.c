@@ -40,6 +40,8 @@
 
 
 #include "tolerance.h"
+#include "stats.h"
+#include "util.h"
 
 
 /*!
@@ -72,6 +74,7 @@ dxf_tolerance_new ()
         else
         {
                 memset (tolerance, 0, size);
+                dxf_stats_count_allocation (TOLERANCE, size);
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -113,8 +116,8 @@ dxf_tolerance_init
                 return (NULL);
         }
         tolerance->id_code = 0;
-        tolerance->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        tolerance->layer = strdup (DXF_DEFAULT_LAYER);
+        tolerance->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        tolerance->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         tolerance->elevation = 0.0;
         tolerance->thickness = 0.0;
         tolerance->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
@@ -123,17 +126,16 @@ dxf_tolerance_init
         tolerance->paperspace = DXF_MODELSPACE;
         tolerance->graphics_data_size = 0;
         tolerance->shadow_mode = 0;
-        tolerance->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_new ();
-        tolerance->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) tolerance->binary_graphics_data);
-        tolerance->dictionary_owner_soft = strdup ("");
-        tolerance->material = strdup ("");
-        tolerance->dictionary_owner_hard = strdup ("");
+        tolerance->binary_graphics_data = NULL;
+        tolerance->dictionary_owner_soft = dxf_string_share ("");
+        tolerance->material = dxf_string_share ("");
+        tolerance->dictionary_owner_hard = dxf_string_share ("");
         tolerance->lineweight = 0;
-        tolerance->plot_style_name = strdup ("");
+        tolerance->plot_style_name = dxf_string_share ("");
         tolerance->color_value = 0;
-        tolerance->color_name = strdup ("");
+        tolerance->color_name = dxf_string_share ("");
         tolerance->transparency = 0;
-        tolerance->dimstyle_name = strdup ("");
+        tolerance->dimstyle_name = dxf_string_share ("");
         tolerance->p0 = (DxfPoint *) dxf_point_new ();
         tolerance->p0 = dxf_point_init ((DxfPoint *) tolerance->p0);
         tolerance->p0->x0 = 0.0;
@@ -216,8 +218,7 @@ dxf_tolerance_read
                 {
                         /* Now follows a string containing the dimension
                          * style name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", tolerance->dimstyle_name);
+                        dxf_read_string (fp, &tolerance->dimstyle_name);
                 }
                 if (strcmp (temp_string, "5") == 0)
                 {
@@ -230,14 +231,12 @@ dxf_tolerance_read
                 {
                         /* Now follows a string containing a linetype
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", tolerance->linetype);
+                        dxf_read_string (fp, &tolerance->linetype);
                 }
                 else if (strcmp (temp_string, "8") == 0)
                 {
                         /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", tolerance->layer);
+                        dxf_read_string (fp, &tolerance->layer);
                 }
                 else if (strcmp (temp_string, "10") == 0)
                 {
@@ -385,31 +384,25 @@ dxf_tolerance_read
                 {
                         /* Now follows a string containing binary
                          * graphics data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", tolerance->binary_graphics_data->data_line);
-                        dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) tolerance->binary_graphics_data->next);
-                        tolerance->binary_graphics_data = (DxfBinaryGraphicsData *) tolerance->binary_graphics_data->next;
+                        dxf_binary_graphics_data_read (fp, &tolerance->binary_graphics_data, NULL);
                 }
                 else if (strcmp (temp_string, "330") == 0)
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", tolerance->dictionary_owner_soft);
+                        dxf_read_string (fp, &tolerance->dictionary_owner_soft);
                 }
                 else if (strcmp (temp_string, "347") == 0)
                 {
                         /* Now follows a string containing a
                          * hard-pointer ID/handle to material object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", tolerance->material);
+                        dxf_read_string (fp, &tolerance->material);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", tolerance->dictionary_owner_hard);
+                        dxf_read_string (fp, &tolerance->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "370") == 0)
                 {
@@ -422,8 +415,7 @@ dxf_tolerance_read
                 {
                         /* Now follows a string containing a plot style
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", tolerance->plot_style_name);
+                        dxf_read_string (fp, &tolerance->plot_style_name);
                 }
                 else if (strcmp (temp_string, "420") == 0)
                 {
@@ -435,8 +427,7 @@ dxf_tolerance_read
                 {
                         /* Now follows a string containing a color
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", tolerance->color_name);
+                        dxf_read_string (fp, &tolerance->color_name);
                 }
                 else if (strcmp (temp_string, "440") == 0)
                 {
@@ -466,11 +457,13 @@ dxf_tolerance_read
         }
         if (strcmp (tolerance->linetype, "") == 0)
         {
-                tolerance->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (tolerance->linetype);
+                tolerance->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (tolerance->layer, "") == 0)
         {
-                tolerance->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (tolerance->layer);
+                tolerance->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Clean up. */
         free (temp_string);
@@ -538,7 +531,8 @@ dxf_tolerance_write
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                tolerance->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (tolerance->linetype);
+                tolerance->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (tolerance->layer, "") == 0)
         {
@@ -716,11 +710,23 @@ dxf_tolerance_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (tolerance->dimstyle_name);
-        free (tolerance->linetype);
-        free (tolerance->layer);
-        free (tolerance->dictionary_owner_soft);
-        free (tolerance->dictionary_owner_hard);
+        dxf_string_free (tolerance->dimstyle_name);
+        dxf_string_free (tolerance->linetype);
+        dxf_string_free (tolerance->layer);
+        dxf_string_free (tolerance->dictionary_owner_soft);
+        dxf_string_free (tolerance->dictionary_owner_hard);
+        if (tolerance->binary_graphics_data != NULL)
+        {
+                dxf_binary_graphics_data_free_list (tolerance->binary_graphics_data);
+        }
+        if (tolerance->p0 != NULL)
+        {
+                dxf_point_free (tolerance->p0);
+        }
+        if (tolerance->p1 != NULL)
+        {
+                dxf_point_free (tolerance->p1);
+        }
         free (tolerance);
         tolerance = NULL;
 #if DEBUG
@@ -891,6 +897,8 @@ dxf_tolerance_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (tolerance == NULL)
         {
@@ -906,7 +914,13 @@ dxf_tolerance_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        tolerance->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (tolerance->linetype);
+        tolerance->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -967,6 +981,8 @@ dxf_tolerance_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (tolerance == NULL)
         {
@@ -982,7 +998,13 @@ dxf_tolerance_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        tolerance->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (tolerance->layer);
+        tolerance->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1760,6 +1782,8 @@ dxf_tolerance_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (tolerance == NULL)
         {
@@ -1775,7 +1799,13 @@ dxf_tolerance_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        tolerance->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (tolerance->dictionary_owner_soft);
+        tolerance->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1844,6 +1874,8 @@ dxf_tolerance_set_material
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (tolerance == NULL)
         {
@@ -1859,7 +1891,13 @@ dxf_tolerance_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        tolerance->material = strdup (material);
+        copy = dxf_string_share (material);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (tolerance->material);
+        tolerance->material = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1924,6 +1962,8 @@ dxf_tolerance_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (tolerance == NULL)
         {
@@ -1939,7 +1979,13 @@ dxf_tolerance_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        tolerance->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (tolerance->dictionary_owner_hard);
+        tolerance->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2069,6 +2115,8 @@ dxf_tolerance_set_plot_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (tolerance == NULL)
         {
@@ -2084,7 +2132,13 @@ dxf_tolerance_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        tolerance->plot_style_name = strdup (plot_style_name);
+        copy = dxf_string_share (plot_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (tolerance->plot_style_name);
+        tolerance->plot_style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2214,6 +2268,8 @@ dxf_tolerance_set_color_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (tolerance == NULL)
         {
@@ -2229,7 +2285,13 @@ dxf_tolerance_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        tolerance->color_name = strdup (color_name);
+        copy = dxf_string_share (color_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (tolerance->color_name);
+        tolerance->color_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2359,6 +2421,8 @@ dxf_tolerance_set_dimstyle_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (tolerance == NULL)
         {
@@ -2374,7 +2438,13 @@ dxf_tolerance_set_dimstyle_name
                   __FUNCTION__);
                 return (NULL);
         }
-        tolerance->dimstyle_name = strdup (dimstyle_name);
+        copy = dxf_string_share (dimstyle_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (tolerance->dimstyle_name);
+        tolerance->dimstyle_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
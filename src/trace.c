@@ -42,6 +42,8 @@
 
 
 #include "trace.h"
+#include "stats.h"
+#include "util.h"
 
 
 /*!
@@ -74,6 +76,7 @@ dxf_trace_new ()
         else
         {
                 memset (trace, 0, size);
+                dxf_stats_count_allocation (TRACE, size);
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -115,8 +118,8 @@ dxf_trace_init
                 return (NULL);
         }
         trace->id_code = 0;
-        trace->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        trace->layer = strdup (DXF_DEFAULT_LAYER);
+        trace->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        trace->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         trace->elevation = 0.0;
         trace->thickness = 0.0;
         trace->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
@@ -125,25 +128,40 @@ dxf_trace_init
         trace->paperspace = DXF_MODELSPACE;
         trace->graphics_data_size = 0;
         trace->shadow_mode = 0;
-        trace->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_new ();
-        trace->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) trace->binary_graphics_data);
-        trace->dictionary_owner_soft = strdup ("");
-        trace->material = strdup ("");
-        trace->dictionary_owner_hard = strdup ("");
+        trace->binary_graphics_data = NULL;
+        trace->dictionary_owner_soft = dxf_string_share ("");
+        trace->material = dxf_string_share ("");
+        trace->dictionary_owner_hard = dxf_string_share ("");
         trace->lineweight = 0;
-        trace->plot_style_name = strdup ("");
+        trace->plot_style_name = dxf_string_share ("");
         trace->color_value = 0;
-        trace->color_name = strdup ("");
+        trace->color_name = dxf_string_share ("");
         trace->transparency = 0;
+        if (trace->p0 == NULL)
+        {
+                trace->p0 = (DxfPoint *) dxf_point_new ();
+        }
         trace->p0->x0 = 0.0;
         trace->p0->y0 = 0.0;
         trace->p0->z0 = 0.0;
+        if (trace->p1 == NULL)
+        {
+                trace->p1 = (DxfPoint *) dxf_point_new ();
+        }
         trace->p1->x0 = 0.0;
         trace->p1->y0 = 0.0;
         trace->p1->z0 = 0.0;
+        if (trace->p2 == NULL)
+        {
+                trace->p2 = (DxfPoint *) dxf_point_new ();
+        }
         trace->p2->x0 = 0.0;
         trace->p2->y0 = 0.0;
         trace->p2->z0 = 0.0;
+        if (trace->p3 == NULL)
+        {
+                trace->p3 = (DxfPoint *) dxf_point_new ();
+        }
         trace->p3->x0 = 0.0;
         trace->p3->y0 = 0.0;
         trace->p3->z0 = 0.0;
@@ -224,14 +242,12 @@ dxf_trace_read
                 {
                         /* Now follows a string containing a linetype
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", trace->linetype);
+                        dxf_read_string (fp, &trace->linetype);
                 }
                 else if (strcmp (temp_string, "8") == 0)
                 {
                         /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", trace->layer);
+                        dxf_read_string (fp, &trace->layer);
                 }
                 else if (strcmp (temp_string, "10") == 0)
                 {
@@ -422,31 +438,25 @@ dxf_trace_read
                 {
                         /* Now follows a string containing binary
                          * graphics data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", trace->binary_graphics_data->data_line);
-                        dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) trace->binary_graphics_data->next);
-                        trace->binary_graphics_data = (DxfBinaryGraphicsData *) trace->binary_graphics_data->next;
+                        dxf_binary_graphics_data_read (fp, &trace->binary_graphics_data, NULL);
                 }
                 else if (strcmp (temp_string, "330") == 0)
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", trace->dictionary_owner_soft);
+                        dxf_read_string (fp, &trace->dictionary_owner_soft);
                 }
                 else if (strcmp (temp_string, "347") == 0)
                 {
                         /* Now follows a string containing a
                          * hard-pointer ID/handle to material object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", trace->material);
+                        dxf_read_string (fp, &trace->material);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", trace->dictionary_owner_hard);
+                        dxf_read_string (fp, &trace->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "370") == 0)
                 {
@@ -459,8 +469,7 @@ dxf_trace_read
                 {
                         /* Now follows a string containing a plot style
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", trace->plot_style_name);
+                        dxf_read_string (fp, &trace->plot_style_name);
                 }
                 else if (strcmp (temp_string, "420") == 0)
                 {
@@ -472,8 +481,7 @@ dxf_trace_read
                 {
                         /* Now follows a string containing a color
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", trace->color_name);
+                        dxf_read_string (fp, &trace->color_name);
                 }
                 else if (strcmp (temp_string, "440") == 0)
                 {
@@ -499,11 +507,13 @@ dxf_trace_read
         /* Handle omitted members and/or illegal values. */
         if (strcmp (trace->linetype, "") == 0)
         {
-                trace->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (trace->linetype);
+                trace->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (trace->layer, "") == 0)
         {
-                trace->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (trace->layer);
+                trace->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Clean up. */
         free (temp_string);
@@ -561,7 +571,8 @@ dxf_trace_write
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                trace->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (trace->linetype);
+                trace->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (trace->layer, "") == 0)
         {
@@ -571,7 +582,8 @@ dxf_trace_write
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0")),
                   dxf_entity_name);
-                trace->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (trace->layer);
+                trace->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Start writing output. */
         fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
@@ -744,14 +756,17 @@ dxf_trace_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (trace->linetype);
-        free (trace->layer);
-        dxf_binary_graphics_data_free_list (trace->binary_graphics_data);
-        free (trace->dictionary_owner_soft);
-        free (trace->material);
-        free (trace->dictionary_owner_hard);
-        free (trace->plot_style_name);
-        free (trace->color_name);
+        dxf_string_free (trace->linetype);
+        dxf_string_free (trace->layer);
+        if (trace->binary_graphics_data != NULL)
+        {
+                dxf_binary_graphics_data_free_list (trace->binary_graphics_data);
+        }
+        dxf_string_free (trace->dictionary_owner_soft);
+        dxf_string_free (trace->material);
+        dxf_string_free (trace->dictionary_owner_hard);
+        dxf_string_free (trace->plot_style_name);
+        dxf_string_free (trace->color_name);
         dxf_point_free (trace->p0);
         dxf_point_free (trace->p1);
         dxf_point_free (trace->p2);
@@ -926,6 +941,8 @@ dxf_trace_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (trace == NULL)
         {
@@ -941,7 +958,13 @@ dxf_trace_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        trace->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (trace->linetype);
+        trace->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1002,6 +1025,8 @@ dxf_trace_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (trace == NULL)
         {
@@ -1017,7 +1042,13 @@ dxf_trace_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        trace->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (trace->layer);
+        trace->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1792,6 +1823,8 @@ dxf_trace_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (trace == NULL)
         {
@@ -1807,7 +1840,13 @@ dxf_trace_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        trace->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (trace->dictionary_owner_soft);
+        trace->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1874,6 +1913,8 @@ dxf_trace_set_material
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (trace == NULL)
         {
@@ -1889,7 +1930,13 @@ dxf_trace_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        trace->material = strdup (material);
+        copy = dxf_string_share (material);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (trace->material);
+        trace->material = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1954,6 +2001,8 @@ dxf_trace_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (trace == NULL)
         {
@@ -1969,7 +2018,13 @@ dxf_trace_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        trace->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (trace->dictionary_owner_hard);
+        trace->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2099,6 +2154,8 @@ dxf_trace_set_plot_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (trace == NULL)
         {
@@ -2114,7 +2171,13 @@ dxf_trace_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        trace->plot_style_name = strdup (plot_style_name);
+        copy = dxf_string_share (plot_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (trace->plot_style_name);
+        trace->plot_style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2244,6 +2307,8 @@ dxf_trace_set_color_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (trace == NULL)
         {
@@ -2259,7 +2324,13 @@ dxf_trace_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        trace->color_name = strdup (color_name);
+        copy = dxf_string_share (color_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (trace->color_name);
+        trace->color_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -40,6 +40,7 @@
 
 
 #include "ucs.h"
+#include "util.h"
 
 
 /*!
@@ -113,24 +114,20 @@ dxf_ucs_init
                 return (NULL);
         }
         ucs->id_code = 0;
-        ucs->UCS_name = strdup ("");
+        ucs->UCS_name = dxf_string_share ("");
         ucs->origin = dxf_point_new ();
-        ucs->origin = dxf_point_init (ucs->origin);
         ucs->origin->x0 = 0.0;
         ucs->origin->y0 = 0.0;
         ucs->origin->z0 = 0.0;
         ucs->X_dir = dxf_point_new ();
-        ucs->X_dir = dxf_point_init (ucs->X_dir);
         ucs->X_dir->x0 = 0.0;
         ucs->X_dir->y0 = 0.0;
         ucs->X_dir->z0 = 0.0;
         ucs->Y_dir = dxf_point_new ();
-        ucs->Y_dir = dxf_point_init (ucs->Y_dir);
         ucs->Y_dir->x0 = 0.0;
         ucs->Y_dir->y0 = 0.0;
         ucs->Y_dir->z0 = 0.0;
         ucs->orthographic_type_origin = dxf_point_new ();
-        ucs->orthographic_type_origin = dxf_point_init (ucs->orthographic_type_origin);
         ucs->orthographic_type_origin->x0 = 0.0;
         ucs->orthographic_type_origin->y0 = 0.0;
         ucs->orthographic_type_origin->z0 = 0.0;
@@ -138,10 +135,10 @@ dxf_ucs_init
         ucs->orthographic_type = 0;
         ucs->other_base_UCS = 0;
         ucs->elevation = 0.0;
-        ucs->dictionary_owner_soft = strdup ("");
-        ucs->object_owner_soft = strdup ("");
-        ucs->base_UCS = strdup ("");
-        ucs->dictionary_owner_hard = strdup ("");
+        ucs->dictionary_owner_soft = dxf_string_share ("");
+        ucs->object_owner_soft = dxf_string_share ("");
+        ucs->base_UCS = dxf_string_share ("");
+        ucs->dictionary_owner_hard = dxf_string_share ("");
         ucs->next = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -220,8 +217,7 @@ dxf_ucs_read
                 {
                         /* Now follows a string containing an UCS
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ucs->UCS_name);
+                        dxf_read_string (fp, &ucs->UCS_name);
                 }
                 else if (strcmp (temp_string, "10") == 0)
                 {
@@ -376,29 +372,25 @@ dxf_ucs_read
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ucs->dictionary_owner_soft);
+                        dxf_read_string (fp, &ucs->dictionary_owner_soft);
                         i++;
                 }
                 else if (strcmp (temp_string, "330") == 0)
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to object owner. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ucs->object_owner_soft);
+                        dxf_read_string (fp, &ucs->object_owner_soft);
                 }
                 else if (strcmp (temp_string, "346") == 0)
                 {
                         /* Now follows a string containing a base UCS. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ucs->base_UCS);
+                        dxf_read_string (fp, &ucs->base_UCS);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ucs->dictionary_owner_hard);
+                        dxf_read_string (fp, &ucs->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "999") == 0)
                 {
@@ -587,9 +579,25 @@ dxf_ucs_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (ucs->UCS_name);
-        free (ucs->dictionary_owner_soft);
-        free (ucs->dictionary_owner_hard);
+        dxf_string_free (ucs->UCS_name);
+        dxf_string_free (ucs->dictionary_owner_soft);
+        dxf_string_free (ucs->dictionary_owner_hard);
+        if (ucs->origin != NULL)
+        {
+                dxf_point_free (ucs->origin);
+        }
+        if (ucs->X_dir != NULL)
+        {
+                dxf_point_free (ucs->X_dir);
+        }
+        if (ucs->Y_dir != NULL)
+        {
+                dxf_point_free (ucs->Y_dir);
+        }
+        if (ucs->orthographic_type_origin != NULL)
+        {
+                dxf_point_free (ucs->orthographic_type_origin);
+        }
         free (ucs);
         ucs = NULL;
 #if DEBUG
@@ -760,6 +768,8 @@ dxf_ucs_set_UCS_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (ucs == NULL)
         {
@@ -775,7 +785,13 @@ dxf_ucs_set_UCS_name
                   __FUNCTION__);
                 return (NULL);
         }
-        ucs->UCS_name = strdup (UCS_name);
+        copy = dxf_string_share (UCS_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (ucs->UCS_name);
+        ucs->UCS_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2290,6 +2306,8 @@ dxf_ucs_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (ucs == NULL)
         {
@@ -2305,7 +2323,13 @@ dxf_ucs_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        ucs->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (ucs->dictionary_owner_soft);
+        ucs->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2370,6 +2394,8 @@ dxf_ucs_set_object_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (ucs == NULL)
         {
@@ -2385,7 +2411,13 @@ dxf_ucs_set_object_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        ucs->object_owner_soft = strdup (object_owner_soft);
+        copy = dxf_string_share (object_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (ucs->object_owner_soft);
+        ucs->object_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2450,6 +2482,8 @@ dxf_ucs_set_object_base_UCS
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (ucs == NULL)
         {
@@ -2465,7 +2499,13 @@ dxf_ucs_set_object_base_UCS
                   __FUNCTION__);
                 return (NULL);
         }
-        ucs->base_UCS = strdup (base_UCS);
+        copy = dxf_string_share (base_UCS);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (ucs->base_UCS);
+        ucs->base_UCS = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2530,6 +2570,8 @@ dxf_ucs_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (ucs == NULL)
         {
@@ -2545,7 +2587,13 @@ dxf_ucs_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        ucs->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (ucs->dictionary_owner_hard);
+        ucs->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
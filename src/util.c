@@ -37,6 +37,27 @@
 
 #include <stdarg.h>
 #include "util.h"
+#include "stats.h"
+
+
+static int dxf_read_is_number_end (const char *line, const char *end);
+
+
+/*!
+ * \brief Shared immutable instances of the most common default string
+ * values, see dxf_string_share ().
+ */
+static const char *dxf_shared_strings[] =
+{
+        "",
+        DXF_DEFAULT_LAYER,
+        DXF_DEFAULT_LINETYPE,
+        "BYBLOCK",
+        "CONTINUOUS"
+};
+
+#define DXF_NUMBER_OF_SHARED_STRINGS (sizeof (dxf_shared_strings) / sizeof (dxf_shared_strings[0]))
+        /*!< \brief Number of shared immutable strings. */
 
 
 /*!
@@ -806,6 +827,111 @@ dxf_int32_free_list
 }
 
 
+/*!
+ * \brief Get a shared copy of a string.
+ *
+ * Default values that occur in almost every entity (an empty string,
+ * layer "0", linetype "BYLAYER", ...) are not duplicated, a pointer to
+ * a single static immutable instance is returned instead.\n
+ * Any other value is duplicated with \c strdup ().\n
+ * A shared string must never be modified or passed to \c free (),
+ * replace it with a new value and release it with
+ * dxf_string_free ().
+ *
+ * \return a pointer to the (shared) copy, or \c NULL when a \c NULL
+ * pointer was passed or no memory could be allocated.
+ */
+char *
+dxf_string_share
+(
+        const char *value
+                /*!< the string to copy. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        char *result = NULL;
+        size_t i;
+
+        /* Do some basic checks. */
+        if (value == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        for (i = 0; i < DXF_NUMBER_OF_SHARED_STRINGS; i++)
+        {
+                if (strcmp (value, dxf_shared_strings[i]) == 0)
+                {
+                        return ((char *) dxf_shared_strings[i]);
+                }
+        }
+        result = strdup (value);
+        if (result == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (result);
+}
+
+
+/*!
+ * \brief Test if a string is one of the shared immutable strings.
+ *
+ * \return \c TRUE when the string is shared, \c FALSE when the string
+ * is owned by the caller (or \c NULL).
+ */
+int
+dxf_string_is_shared
+(
+        const char *string
+                /*!< the string to test. */
+)
+{
+        size_t i;
+
+        for (i = 0; i < DXF_NUMBER_OF_SHARED_STRINGS; i++)
+        {
+                if (string == dxf_shared_strings[i])
+                {
+                        return (TRUE);
+                }
+        }
+        return (FALSE);
+}
+
+
+/*!
+ * \brief Release a string obtained from dxf_string_share ().
+ *
+ * Owned strings are freed, shared strings and \c NULL pointers are
+ * left alone.
+ *
+ * \return \c EXIT_SUCCESS.
+ */
+int
+dxf_string_free
+(
+        char *string
+                /*!< the string to release. */
+)
+{
+        if ((string != NULL) && (!dxf_string_is_shared (string)))
+        {
+                free (string);
+        }
+        return (EXIT_SUCCESS);
+}
+
+
 int
 dxf_read_is_double (int type)
 {
@@ -910,6 +1036,17 @@ dxf_read_init (const char *filename)
                 return (NULL);
         }
         file = malloc (sizeof(DxfFile));
+        if (file == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory for a DxfFile struct.\n")),
+                  __FUNCTION__);
+                fclose (fp);
+                return (NULL);
+        }
+        /* Every DxfFile carries its own parse state, start from a clean
+         * slate. */
+        memset (file, 0, sizeof (DxfFile));
         file->fp = fp;
         file->filename = strdup(filename);
         file->line_number = 0;
@@ -962,6 +1099,7 @@ dxf_read_line (char * temp_string, DxfFile *fp)
         DXF_DEBUG_BEGIN
 #endif
         int ret;
+        size_t length;
 
         ret = fscanf (fp->fp, "%[^\n]\n", temp_string);
         if (ferror (fp->fp))
@@ -971,9 +1109,16 @@ dxf_read_line (char * temp_string, DxfFile *fp)
                   fp->filename, fp->line_number);
                 return (EXIT_FAILURE);
         }
-        if (ret)
+        if (ret > 0)
         {
                 fp->line_number++;
+                length = strlen (temp_string);
+                dxf_stats_add_read (fp, length + 1, 1);
+                /* Drop the carriage return of DOS style line endings. */
+                if ((length > 0) && (temp_string[length - 1] == '\r'))
+                {
+                        temp_string[length - 1] = '\0';
+                }
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -1028,4 +1173,320 @@ dxf_read_scanf (DxfFile *fp, const char *template, ...)
 }
 
 
+/*!
+ * \brief Read a single line, without the line end, from a DXF file.
+ *
+ * Leading white space is preserved, the remainder of a line that does
+ * not fit in \c line is skipped.
+ *
+ * \return \c EXIT_SUCCESS when a line was read, \c EXIT_FAILURE at the
+ * end of the file or when an error occurred.
+ */
+int
+dxf_read_text_line
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an input file (or device). */
+        char *line,
+                /*!< buffer for the line. */
+        int size
+                /*!< size of the buffer. */
+)
+{
+        size_t length;
+        int c;
+
+        if (fgets (line, size, fp->fp) == NULL)
+        {
+                line[0] = '\0';
+                if (ferror (fp->fp))
+                {
+                        fprintf (stderr,
+                          (_("Error: while reading from: %s in line: %d.\n")),
+                          fp->filename, fp->line_number);
+                }
+                return (EXIT_FAILURE);
+        }
+        (fp->line_number)++;
+        length = strlen (line);
+        dxf_stats_add_read (fp, length, 1);
+        if ((length > 0) && (line[length - 1] != '\n'))
+        {
+                do
+                {
+                        c = fgetc (fp->fp);
+                }
+                while ((c != '\n') && (c != EOF));
+        }
+        while ((length > 0)
+          && ((line[length - 1] == '\n') || (line[length - 1] == '\r')))
+        {
+                length--;
+        }
+        line[length] = '\0';
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Read a group code line from a DXF file.
+ *
+ * The leading and trailing blanks used to right align group codes are
+ * removed, "  0" is returned as "0".
+ *
+ * \return \c EXIT_SUCCESS when a group code was read, \c EXIT_FAILURE
+ * at the end of the file or when an error occurred.
+ */
+int
+dxf_read_group_code
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an input file (or device). */
+        char *group_code,
+                /*!< buffer for the group code. */
+        int size
+                /*!< size of the buffer. */
+)
+{
+        size_t length;
+        size_t i;
+
+        if (dxf_read_text_line (fp, group_code, size) != EXIT_SUCCESS)
+        {
+                return (EXIT_FAILURE);
+        }
+        for (i = 0; (group_code[i] == ' ') || (group_code[i] == '\t'); i++);
+        length = strlen (group_code + i);
+        memmove (group_code, group_code + i, length + 1);
+        while ((length > 0)
+          && ((group_code[length - 1] == ' ') || (group_code[length - 1] == '\t')))
+        {
+                length--;
+        }
+        group_code[length] = '\0';
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Read a string value from a DXF file.
+ *
+ * The string in \c value is released with dxf_string_free () and
+ * replaced by a (shared) copy of the line read.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_read_string
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an input file (or device). */
+        char **value
+                /*!< pointer to the string to replace. */
+)
+{
+        char line[DXF_MAX_STRING_LENGTH];
+        char *result = NULL;
+
+        if (dxf_read_text_line (fp, line, DXF_MAX_STRING_LENGTH) != EXIT_SUCCESS)
+        {
+                return (EXIT_FAILURE);
+        }
+        result = dxf_string_share (line);
+        if (result == NULL)
+        {
+                return (EXIT_FAILURE);
+        }
+        dxf_string_free (*value);
+        *value = result;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Read a double value from a DXF file.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred or the line does not hold a number.
+ */
+int
+dxf_read_double
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an input file (or device). */
+        double *value
+                /*!< pointer to the value to set. */
+)
+{
+        char line[DXF_MAX_STRING_LENGTH];
+        char *end = NULL;
+        double result;
+
+        if (dxf_read_text_line (fp, line, DXF_MAX_STRING_LENGTH) != EXIT_SUCCESS)
+        {
+                return (EXIT_FAILURE);
+        }
+        result = strtod (line, &end);
+        if (!dxf_read_is_number_end (line, end))
+        {
+                fprintf (stderr,
+                  (_("Error: a bad numeric value was found while reading from: %s in line: %d.\n")),
+                  fp->filename, fp->line_number);
+                return (EXIT_FAILURE);
+        }
+        *value = result;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Read an integer value from a DXF file.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred or the line does not hold a number.
+ */
+int
+dxf_read_int
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an input file (or device). */
+        int *value
+                /*!< pointer to the value to set. */
+)
+{
+        long result;
+
+        if (dxf_read_long (fp, &result) != EXIT_SUCCESS)
+        {
+                return (EXIT_FAILURE);
+        }
+        *value = (int) result;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Read a 16 bit integer value from a DXF file.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred or the line does not hold a number.
+ */
+int
+dxf_read_int16
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an input file (or device). */
+        int16_t *value
+                /*!< pointer to the value to set. */
+)
+{
+        long result;
+
+        if (dxf_read_long (fp, &result) != EXIT_SUCCESS)
+        {
+                return (EXIT_FAILURE);
+        }
+        *value = (int16_t) result;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Read a long integer value from a DXF file.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred or the line does not hold a number.
+ */
+int
+dxf_read_long
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an input file (or device). */
+        long *value
+                /*!< pointer to the value to set. */
+)
+{
+        char line[DXF_MAX_STRING_LENGTH];
+        char *end = NULL;
+        long result;
+
+        if (dxf_read_text_line (fp, line, DXF_MAX_STRING_LENGTH) != EXIT_SUCCESS)
+        {
+                return (EXIT_FAILURE);
+        }
+        result = strtol (line, &end, 10);
+        if (!dxf_read_is_number_end (line, end))
+        {
+                fprintf (stderr,
+                  (_("Error: a bad numeric value was found while reading from: %s in line: %d.\n")),
+                  fp->filename, fp->line_number);
+                return (EXIT_FAILURE);
+        }
+        *value = result;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Read a hexadecimal value (a handle) from a DXF file.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred or the line does not hold a hexadecimal number.
+ */
+int
+dxf_read_hex
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an input file (or device). */
+        int *value
+                /*!< pointer to the value to set. */
+)
+{
+        char line[DXF_MAX_STRING_LENGTH];
+        char *end = NULL;
+        unsigned long result;
+
+        if (dxf_read_text_line (fp, line, DXF_MAX_STRING_LENGTH) != EXIT_SUCCESS)
+        {
+                return (EXIT_FAILURE);
+        }
+        result = strtoul (line, &end, 16);
+        if (!dxf_read_is_number_end (line, end))
+        {
+                fprintf (stderr,
+                  (_("Error: a bad hexadecimal value was found while reading from: %s in line: %d.\n")),
+                  fp->filename, fp->line_number);
+                return (EXIT_FAILURE);
+        }
+        *value = (int) result;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Test if a number parsed from \c line ends at \c end, only
+ * trailing white space is allowed after the number.
+ */
+static int
+dxf_read_is_number_end
+(
+        const char *line,
+                /*!< the line parsed. */
+        const char *end
+                /*!< the end of the number parsed. */
+)
+{
+        if (end == line)
+        {
+                return (FALSE);
+        }
+        while ((*end == ' ') || (*end == '\t'))
+        {
+                end++;
+        }
+        return (*end == '\0');
+}
+
+
 /* EOF */
@@ -84,11 +84,22 @@ DxfInt32 *dxf_int32_new ();
 DxfInt32 *dxf_int32_init (DxfInt32 *i);
 int dxf_int32_free (DxfInt32 *i);
 int dxf_int32_free_list (DxfInt32 *ints);
+char *dxf_string_share (const char *value);
+int dxf_string_is_shared (const char *string);
+int dxf_string_free (char *string);
 int dxf_read_is_double (int type);
 int dxf_read_is_int (int type);
 int dxf_read_is_string (int type);
 int dxf_read_line (char * temp_string, DxfFile *fp);
 int dxf_read_scanf (DxfFile *fp, const char *template, ...);
+int dxf_read_text_line (DxfFile *fp, char *line, int size);
+int dxf_read_group_code (DxfFile *fp, char *group_code, int size);
+int dxf_read_string (DxfFile *fp, char **value);
+int dxf_read_double (DxfFile *fp, double *value);
+int dxf_read_int (DxfFile *fp, int *value);
+int dxf_read_int16 (DxfFile *fp, int16_t *value);
+int dxf_read_long (DxfFile *fp, long *value);
+int dxf_read_hex (DxfFile *fp, int *value);
 DxfFile *dxf_read_init (const char *filename);
 void dxf_read_close (DxfFile *file);
 
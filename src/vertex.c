@@ -42,6 +42,8 @@
 
 
 #include "vertex.h"
+#include "stats.h"
+#include "util.h"
 
 
 /*!
@@ -71,6 +73,7 @@ dxf_vertex_new ()
         else
         {
                 memset (vertex, 0, size);
+                dxf_stats_count_allocation (VERTEX, size);
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -111,8 +114,8 @@ dxf_vertex_init
               return (NULL);
         }
         vertex->id_code = 0;
-        vertex->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        vertex->layer = strdup (DXF_DEFAULT_LAYER);
+        vertex->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        vertex->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         vertex->elevation = 0.0;
         vertex->thickness = 0.0;
         vertex->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
@@ -121,15 +124,14 @@ dxf_vertex_init
         vertex->paperspace = DXF_MODELSPACE;
         vertex->graphics_data_size = 0;
         vertex->shadow_mode = 0;
-        vertex->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_new ();
-        vertex->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) vertex->binary_graphics_data);
-        vertex->dictionary_owner_soft = strdup ("");
-        vertex->material = strdup ("");
-        vertex->dictionary_owner_hard = strdup ("");
+        vertex->binary_graphics_data = NULL;
+        vertex->dictionary_owner_soft = dxf_string_share ("");
+        vertex->material = dxf_string_share ("");
+        vertex->dictionary_owner_hard = dxf_string_share ("");
         vertex->lineweight = 0;
-        vertex->plot_style_name = strdup ("");
+        vertex->plot_style_name = dxf_string_share ("");
         vertex->color_value = 0;
-        vertex->color_name = strdup ("");
+        vertex->color_name = dxf_string_share ("");
         vertex->transparency = 0;
         vertex->p0 = (DxfPoint *) dxf_point_new ();
         vertex->p0 = dxf_point_init ((DxfPoint *) vertex->p0);
@@ -221,14 +223,12 @@ dxf_vertex_read
                 {
                         /* Now follows a string containing a linetype
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", vertex->linetype);
+                        dxf_read_string (fp, &vertex->linetype);
                 }
                 else if (strcmp (temp_string, "8") == 0)
                 {
                         /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", vertex->layer);
+                        dxf_read_string (fp, &vertex->layer);
                 }
                 else if (strcmp (temp_string, "10") == 0)
                 {
@@ -400,31 +400,25 @@ dxf_vertex_read
                 {
                         /* Now follows a string containing binary
                          * graphics data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", vertex->binary_graphics_data->data_line);
-                        dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) vertex->binary_graphics_data->next);
-                        vertex->binary_graphics_data = (DxfBinaryGraphicsData *) vertex->binary_graphics_data->next;
+                        dxf_binary_graphics_data_read (fp, &vertex->binary_graphics_data, NULL);
                 }
                 else if (strcmp (temp_string, "330") == 0)
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", vertex->dictionary_owner_soft);
+                        dxf_read_string (fp, &vertex->dictionary_owner_soft);
                 }
                 else if (strcmp (temp_string, "347") == 0)
                 {
                         /* Now follows a string containing a
                          * hard-pointer ID/handle to material object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", vertex->material);
+                        dxf_read_string (fp, &vertex->material);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", vertex->dictionary_owner_hard);
+                        dxf_read_string (fp, &vertex->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "370") == 0)
                 {
@@ -437,8 +431,7 @@ dxf_vertex_read
                 {
                         /* Now follows a string containing a plot style
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", vertex->plot_style_name);
+                        dxf_read_string (fp, &vertex->plot_style_name);
                 }
                 else if (strcmp (temp_string, "420") == 0)
                 {
@@ -450,8 +443,7 @@ dxf_vertex_read
                 {
                         /* Now follows a string containing a color
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", vertex->color_name);
+                        dxf_read_string (fp, &vertex->color_name);
                 }
                 else if (strcmp (temp_string, "440") == 0)
                 {
@@ -477,11 +469,13 @@ dxf_vertex_read
         /* Handle omitted members and/or illegal values. */
         if (strcmp (vertex->linetype, "") == 0)
         {
-                vertex->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (vertex->linetype);
+                vertex->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (vertex->layer, "") == 0)
         {
-                vertex->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (vertex->layer);
+                vertex->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Clean up. */
         free (temp_string);
@@ -539,7 +533,8 @@ dxf_vertex_write
                 fprintf (stderr,
                   (_("    %s entity is reset to default linetype")),
                   dxf_entity_name);
-                vertex->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (vertex->linetype);
+                vertex->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (vertex->layer, "") == 0)
         {
@@ -549,7 +544,8 @@ dxf_vertex_write
                 fprintf (stderr,
                   (_("    %s entity is relocated to layer 0")),
                   dxf_entity_name);
-                vertex->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (vertex->layer);
+                vertex->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Start writing output. */
         fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
@@ -711,15 +707,21 @@ dxf_vertex_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (vertex->linetype);
-        free (vertex->layer);
-        dxf_binary_graphics_data_free_list (vertex->binary_graphics_data);
-        free (vertex->dictionary_owner_soft);
-        free (vertex->material);
-        free (vertex->dictionary_owner_hard);
-        free (vertex->plot_style_name);
-        free (vertex->color_name);
-        dxf_point_free (vertex->p0);
+        dxf_string_free (vertex->linetype);
+        dxf_string_free (vertex->layer);
+        if (vertex->binary_graphics_data != NULL)
+        {
+                dxf_binary_graphics_data_free_list (vertex->binary_graphics_data);
+        }
+        dxf_string_free (vertex->dictionary_owner_soft);
+        dxf_string_free (vertex->material);
+        dxf_string_free (vertex->dictionary_owner_hard);
+        dxf_string_free (vertex->plot_style_name);
+        dxf_string_free (vertex->color_name);
+        if (vertex->p0 != NULL)
+        {
+                dxf_point_free (vertex->p0);
+        }
         free (vertex);
         vertex = NULL;
 #if DEBUG
@@ -890,6 +892,8 @@ dxf_vertex_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (vertex == NULL)
         {
@@ -905,7 +909,13 @@ dxf_vertex_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        vertex->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (vertex->linetype);
+        vertex->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -966,6 +976,8 @@ dxf_vertex_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (vertex == NULL)
         {
@@ -981,7 +993,13 @@ dxf_vertex_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        vertex->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (vertex->layer);
+        vertex->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1764,6 +1782,8 @@ dxf_vertex_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (vertex == NULL)
         {
@@ -1779,7 +1799,13 @@ dxf_vertex_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        vertex->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (vertex->dictionary_owner_soft);
+        vertex->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1846,6 +1872,8 @@ dxf_vertex_set_material
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (vertex == NULL)
         {
@@ -1861,7 +1889,13 @@ dxf_vertex_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        vertex->material = strdup (material);
+        copy = dxf_string_share (material);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (vertex->material);
+        vertex->material = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1926,6 +1960,8 @@ dxf_vertex_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (vertex == NULL)
         {
@@ -1941,7 +1977,13 @@ dxf_vertex_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        vertex->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (vertex->dictionary_owner_hard);
+        vertex->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2071,6 +2113,8 @@ dxf_vertex_set_plot_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (vertex == NULL)
         {
@@ -2086,7 +2130,13 @@ dxf_vertex_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        vertex->plot_style_name = strdup (plot_style_name);
+        copy = dxf_string_share (plot_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (vertex->plot_style_name);
+        vertex->plot_style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2216,6 +2266,8 @@ dxf_vertex_set_color_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (vertex == NULL)
         {
@@ -2231,7 +2283,13 @@ dxf_vertex_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        vertex->color_name = strdup (color_name);
+        copy = dxf_string_share (color_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (vertex->color_name);
+        vertex->color_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
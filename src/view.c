@@ -40,6 +40,7 @@
 
 
 #include "view.h"
+#include "util.h"
 
 
 /*!
@@ -113,18 +114,15 @@ dxf_view_init
                 return (NULL);
         }
         view->id_code = 0;
-        view->name = strdup ("");
+        view->name = dxf_string_share ("");
         view->p0 = dxf_point_new ();
-        view->p0 = dxf_point_init (view->p0);
         view->p0->x0 = 0.0;
         view->p0->y0 = 0.0;
         view->p1 = dxf_point_new ();
-        view->p1 = dxf_point_init (view->p1);
         view->p1->x0 = 0.0;
         view->p1->y0 = 0.0;
         view->p1->z0 = 0.0;
         view->p2 = dxf_point_new ();
-        view->p2 = dxf_point_init (view->p2);
         view->p2->x0 = 0.0;
         view->p2->y0 = 0.0;
         view->p2->z0 = 0.0;
@@ -136,8 +134,8 @@ dxf_view_init
         view->twist_angle = 0.0;
         view->flag = 0;
         view->mode = 0;
-        view->dictionary_owner_soft = strdup ("");
-        view->dictionary_owner_hard = strdup ("");
+        view->dictionary_owner_soft = dxf_string_share ("");
+        view->dictionary_owner_hard = dxf_string_share ("");
         view->next = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -214,8 +212,7 @@ dxf_view_read
                 {
                         /* Now follows a string containing a view
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", view->name);
+                        dxf_read_string (fp, &view->name);
                 }
                 else if (strcmp (temp_string, "10") == 0)
                 {
@@ -351,15 +348,13 @@ dxf_view_read
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", view->dictionary_owner_soft);
+                        dxf_read_string (fp, &view->dictionary_owner_soft);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", view->dictionary_owner_hard);
+                        dxf_read_string (fp, &view->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "999") == 0)
                 {
@@ -529,9 +524,21 @@ dxf_view_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (view->name);
-        free (view->dictionary_owner_soft);
-        free (view->dictionary_owner_hard);
+        dxf_string_free (view->name);
+        dxf_string_free (view->dictionary_owner_soft);
+        dxf_string_free (view->dictionary_owner_hard);
+        if (view->p0 != NULL)
+        {
+                dxf_point_free (view->p0);
+        }
+        if (view->p1 != NULL)
+        {
+                dxf_point_free (view->p1);
+        }
+        if (view->p2 != NULL)
+        {
+                dxf_point_free (view->p2);
+        }
         free (view);
         view = NULL;
 #if DEBUG
@@ -702,6 +709,8 @@ dxf_view_set_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (view == NULL)
         {
@@ -717,7 +726,13 @@ dxf_view_set_name
                   __FUNCTION__);
                 return (NULL);
         }
-        view->name = strdup (name);
+        copy = dxf_string_share (name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (view->name);
+        view->name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2223,6 +2238,8 @@ dxf_view_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (view == NULL)
         {
@@ -2238,7 +2255,13 @@ dxf_view_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        view->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (view->dictionary_owner_soft);
+        view->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2303,6 +2326,8 @@ dxf_view_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (view == NULL)
         {
@@ -2318,7 +2343,13 @@ dxf_view_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        view->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (view->dictionary_owner_hard);
+        view->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
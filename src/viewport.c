@@ -40,6 +40,8 @@
 
 
 #include "viewport.h"
+#include "stats.h"
+#include "util.h"
 
 
 /*!
@@ -69,6 +71,7 @@ dxf_viewport_new ()
         else
         {
                 memset (viewport, 0, size);
+                dxf_stats_count_allocation (VIEWPORT, size);
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -110,10 +113,9 @@ dxf_viewport_init
                 return (NULL);
         }
         viewport->id_code = 0;
-        viewport->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        viewport->layer = strdup (DXF_DEFAULT_LAYER);
+        viewport->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        viewport->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         viewport->center = dxf_point_new ();
-        viewport->center = dxf_point_init (viewport->center);
         viewport->center->x0 = 0.0;
         viewport->center->y0 = 0.0;
         viewport->center->z0 = 0.0;
@@ -132,19 +134,16 @@ dxf_viewport_init
         viewport->window_descriptor_begin = strdup ("{"); /* Always "{". */
         viewport->extended_entity_data_version = 16;
         viewport->target = dxf_point_new ();
-        viewport->target = dxf_point_init (viewport->target);
         viewport->target->x0 = 0.0;
         viewport->target->y0 = 0.0;
         viewport->target->z0 = 0.0;
         viewport->direction = dxf_point_new ();
-        viewport->direction = dxf_point_init (viewport->direction);
         viewport->direction->x0 = 0.0;
         viewport->direction->y0 = 0.0;
         viewport->direction->z0 = 0.0;
         viewport->view_twist_angle = 0.0;
         viewport->view_height = 0.0;
         viewport->view_center = dxf_point_new ();
-        viewport->view_center = dxf_point_init (viewport->view_center);
         viewport->view_center->x0 = 0.0;
         viewport->view_center->y0 = 0.0;
         viewport->perspective_lens_length = 0.0;
@@ -160,15 +159,12 @@ dxf_viewport_init
         viewport->snap_isopair = 0;
         viewport->snap_rotation_angle = 0.0;
         viewport->snap_base = dxf_point_new ();
-        viewport->snap_base = dxf_point_init (viewport->snap_base);
         viewport->snap_base->x0 = 0.0;
         viewport->snap_base->y0 = 0.0;
         viewport->snap_spacing = dxf_point_new ();
-        viewport->snap_spacing = dxf_point_init (viewport->snap_spacing);
         viewport->snap_spacing->x0 = 0.0;
         viewport->snap_spacing->y0 = 0.0;
         viewport->grid_spacing = dxf_point_new ();
-        viewport->grid_spacing = dxf_point_init (viewport->grid_spacing);
         viewport->grid_spacing->x0 = 0.0;
         viewport->grid_spacing->y0 = 0.0;
         viewport->plot_flag = 0;
@@ -180,8 +176,8 @@ dxf_viewport_init
         viewport->frozen_layers->next = NULL;
         viewport->frozen_layer_list_end = strdup ("}"); /* Always "}". */
         viewport->window_descriptor_end = strdup ("}"); /* Always "}". */
-        viewport->dictionary_owner_soft = strdup ("");
-        viewport->dictionary_owner_hard = strdup ("");
+        viewport->dictionary_owner_soft = dxf_string_share ("");
+        viewport->dictionary_owner_hard = dxf_string_share ("");
         viewport->next = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -260,14 +256,12 @@ dxf_viewport_read
                 {
                         /* Now follows a string containing a linetype
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", viewport->linetype);
+                        dxf_read_string (fp, &viewport->linetype);
                 }
                 else if (strcmp (temp_string, "8") == 0)
                 {
                         /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", viewport->layer);
+                        dxf_read_string (fp, &viewport->layer);
                 }
                 else if (strcmp (temp_string, "10") == 0)
                 {
@@ -376,8 +370,7 @@ dxf_viewport_read
                         /* Now follows a sequence of ordered data fields. */
                         /* Now follows a string containing the appname,
                          * always "ACAD". */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", viewport->app_name);
+                        dxf_read_string (fp, &viewport->app_name);
                         if (strcmp (viewport->app_name, "ACAD") == 1)
                         {
                                 fprintf (stderr,
@@ -401,8 +394,7 @@ dxf_viewport_read
                         }
                         /* Now follows a string containing the viewport
                          * data, always "MVIEW". */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", viewport->viewport_data);
+                        dxf_read_string (fp, &viewport->viewport_data);
                         if (strcmp (viewport->viewport_data, "MVIEW") == 1)
                         {
                                 fprintf (stderr,
@@ -426,8 +418,7 @@ dxf_viewport_read
                         }
                         /* Now follows a string containing the window
                          * begin descriptor, always "{". */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", viewport->window_descriptor_begin);
+                        dxf_read_string (fp, &viewport->window_descriptor_begin);
                         if (strcmp (viewport->window_descriptor_begin, "{") == 1)
                         {
                                 fprintf (stderr,
@@ -890,8 +881,7 @@ dxf_viewport_read
                         }
                         /* Now follows a string containing the frozen
                          * layer list begin descriptor, always "{". */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", viewport->frozen_layer_list_begin);
+                        dxf_read_string (fp, &viewport->frozen_layer_list_begin);
                         if (strcmp (viewport->frozen_layer_list_begin, "{") == 1)
                         {
                                 fprintf (stderr,
@@ -955,8 +945,7 @@ dxf_viewport_read
                         }
                         /* Now follows a string containing the frozen
                          * layer list end descriptor, always "}". */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", viewport->frozen_layer_list_end);
+                        dxf_read_string (fp, &viewport->frozen_layer_list_end);
                         if (strcmp (viewport->frozen_layer_list_end, "}") == 1)
                         {
                                 fprintf (stderr,
@@ -980,8 +969,7 @@ dxf_viewport_read
                         }
                         /* Now follows a string containing the window
                          * end descriptor, always "}". */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", viewport->window_descriptor_end);
+                        dxf_read_string (fp, &viewport->window_descriptor_end);
                         if (strcmp (viewport->window_descriptor_end, "}") == 1)
                         {
                                 fprintf (stderr,
@@ -1003,11 +991,13 @@ dxf_viewport_read
         /* Handle omitted members and/or illegal values. */
         if (strcmp (viewport->linetype, "") == 0)
         {
-                viewport->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (viewport->linetype);
+                viewport->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (viewport->layer, "") == 0)
         {
-                viewport->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (viewport->layer);
+                viewport->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Clean up. */
         free (temp_string);
@@ -1066,7 +1056,8 @@ dxf_viewport_write
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                viewport->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (viewport->linetype);
+                viewport->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (viewport->layer, "") == 0)
         {
@@ -1076,7 +1067,8 @@ dxf_viewport_write
                 fprintf (stderr,
                   (_("\t%s entity is relocated to default layer.\n")),
                   dxf_entity_name);
-                viewport->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (viewport->layer);
+                viewport->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Start writing output. */
         fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
@@ -1244,15 +1236,46 @@ dxf_viewport_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (viewport->linetype);
-        free (viewport->layer);
-        free (viewport->app_name);
-        free (viewport->viewport_data);
-        free (viewport->window_descriptor_begin);
-        free (viewport->frozen_layer_list_begin);
+        dxf_string_free (viewport->linetype);
+        dxf_string_free (viewport->layer);
+        dxf_string_free (viewport->app_name);
+        dxf_string_free (viewport->viewport_data);
+        dxf_string_free (viewport->window_descriptor_begin);
+        dxf_string_free (viewport->frozen_layer_list_begin);
         dxf_char_free_list (viewport->frozen_layers);
-        free (viewport->frozen_layer_list_end);
-        free (viewport->window_descriptor_end);
+        dxf_string_free (viewport->frozen_layer_list_end);
+        dxf_string_free (viewport->window_descriptor_end);
+        dxf_string_free (viewport->color_name);
+        dxf_string_free (viewport->material);
+        dxf_string_free (viewport->plot_style_name);
+        if (viewport->center != NULL)
+        {
+                dxf_point_free (viewport->center);
+        }
+        if (viewport->target != NULL)
+        {
+                dxf_point_free (viewport->target);
+        }
+        if (viewport->direction != NULL)
+        {
+                dxf_point_free (viewport->direction);
+        }
+        if (viewport->view_center != NULL)
+        {
+                dxf_point_free (viewport->view_center);
+        }
+        if (viewport->snap_base != NULL)
+        {
+                dxf_point_free (viewport->snap_base);
+        }
+        if (viewport->snap_spacing != NULL)
+        {
+                dxf_point_free (viewport->snap_spacing);
+        }
+        if (viewport->grid_spacing != NULL)
+        {
+                dxf_point_free (viewport->grid_spacing);
+        }
         free (viewport);
         viewport = NULL;
 #if DEBUG
@@ -1423,6 +1446,8 @@ dxf_viewport_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (viewport == NULL)
         {
@@ -1438,7 +1463,13 @@ dxf_viewport_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        viewport->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (viewport->linetype);
+        viewport->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1499,6 +1530,8 @@ dxf_viewport_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (viewport == NULL)
         {
@@ -1514,7 +1547,13 @@ dxf_viewport_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        viewport->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (viewport->layer);
+        viewport->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2305,6 +2344,8 @@ dxf_viewport_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (viewport == NULL)
         {
@@ -2320,7 +2361,13 @@ dxf_viewport_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        viewport->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (viewport->dictionary_owner_soft);
+        viewport->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2389,6 +2436,8 @@ dxf_viewport_set_material
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (viewport == NULL)
         {
@@ -2404,7 +2453,13 @@ dxf_viewport_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        viewport->material = strdup (material);
+        copy = dxf_string_share (material);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (viewport->material);
+        viewport->material = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2469,6 +2524,8 @@ dxf_viewport_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (viewport == NULL)
         {
@@ -2484,7 +2541,13 @@ dxf_viewport_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        viewport->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (viewport->dictionary_owner_hard);
+        viewport->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2614,6 +2677,8 @@ dxf_viewport_set_plot_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (viewport == NULL)
         {
@@ -2629,7 +2694,13 @@ dxf_viewport_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        viewport->plot_style_name = strdup (plot_style_name);
+        copy = dxf_string_share (plot_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (viewport->plot_style_name);
+        viewport->plot_style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2759,6 +2830,8 @@ dxf_viewport_set_color_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (viewport == NULL)
         {
@@ -2774,7 +2847,13 @@ dxf_viewport_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        viewport->color_name = strdup (color_name);
+        copy = dxf_string_share (color_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (viewport->color_name);
+        viewport->color_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -3472,6 +3551,8 @@ dxf_viewport_set_app_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (viewport == NULL)
         {
@@ -3487,7 +3568,13 @@ dxf_viewport_set_app_name
                   __FUNCTION__);
                 return (NULL);
         }
-        viewport->app_name = strdup (app_name);
+        copy = dxf_string_share (app_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (viewport->app_name);
+        viewport->app_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -3552,6 +3639,8 @@ dxf_viewport_set_viewport_data
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (viewport == NULL)
         {
@@ -3567,7 +3656,13 @@ dxf_viewport_set_viewport_data
                   __FUNCTION__);
                 return (NULL);
         }
-        viewport->viewport_data = strdup (viewport_data);
+        copy = dxf_string_share (viewport_data);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (viewport->viewport_data);
+        viewport->viewport_data = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -3634,6 +3729,8 @@ dxf_viewport_set_window_descriptor_begin
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (viewport == NULL)
         {
@@ -3649,7 +3746,13 @@ dxf_viewport_set_window_descriptor_begin
                   __FUNCTION__);
                 return (NULL);
         }
-        viewport->window_descriptor_begin = strdup (window_descriptor_begin);
+        copy = dxf_string_share (window_descriptor_begin);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (viewport->window_descriptor_begin);
+        viewport->window_descriptor_begin = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -6311,6 +6414,8 @@ dxf_viewport_set_frozen_layer_list_begin
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (viewport == NULL)
         {
@@ -6326,7 +6431,13 @@ dxf_viewport_set_frozen_layer_list_begin
                   __FUNCTION__);
                 return (NULL);
         }
-        viewport->frozen_layer_list_begin = strdup (frozen_layer_list_begin);
+        copy = dxf_string_share (frozen_layer_list_begin);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (viewport->frozen_layer_list_begin);
+        viewport->frozen_layer_list_begin = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -6467,6 +6578,8 @@ dxf_viewport_set_frozen_layer_list_end
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (viewport == NULL)
         {
@@ -6482,7 +6595,13 @@ dxf_viewport_set_frozen_layer_list_end
                   __FUNCTION__);
                 return (NULL);
         }
-        viewport->frozen_layer_list_end = strdup (frozen_layer_list_end);
+        copy = dxf_string_share (frozen_layer_list_end);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (viewport->frozen_layer_list_end);
+        viewport->frozen_layer_list_end = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -6546,6 +6665,8 @@ dxf_viewport_set_window_descriptor_end
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (viewport == NULL)
         {
@@ -6561,7 +6682,13 @@ dxf_viewport_set_window_descriptor_end
                   __FUNCTION__);
                 return (NULL);
         }
-        viewport->window_descriptor_end = strdup (window_descriptor_end);
+        copy = dxf_string_share (window_descriptor_end);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (viewport->window_descriptor_end);
+        viewport->window_descriptor_end = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
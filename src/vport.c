@@ -46,6 +46,7 @@
 
 
 #include "vport.h"
+#include "util.h"
 
 
 /*!
@@ -116,38 +117,30 @@ dxf_vport_init
                 return (NULL);
         }
         vport->id_code = 0;
-        vport->viewport_name = strdup ("");
+        vport->viewport_name = dxf_string_share ("");
         vport->min = dxf_point_new ();
-        vport->min = dxf_point_init (vport->min);
         vport->min->x0 = 0.0;
         vport->min->y0 = 0.0;
         vport->max = dxf_point_new ();
-        vport->max = dxf_point_init (vport->max);
         vport->max->x0 = 0.0;
         vport->max->y0 = 0.0;
         vport->center = dxf_point_new ();
-        vport->center = dxf_point_init (vport->center);
         vport->center->x0 = 0.0;
         vport->center->y0 = 0.0;
         vport->snap_base = dxf_point_new ();
-        vport->snap_base = dxf_point_init (vport->snap_base);
         vport->snap_base->x0 = 0.0;
         vport->snap_base->y0 = 0.0;
         vport->snap_spacing = dxf_point_new ();
-        vport->snap_spacing = dxf_point_init (vport->snap_spacing);
         vport->snap_spacing->x0 = 0.0;
         vport->snap_spacing->y0 = 0.0;
         vport->grid_spacing = dxf_point_new ();
-        vport->grid_spacing = dxf_point_init (vport->grid_spacing);
         vport->grid_spacing->x0 = 0.0;
         vport->grid_spacing->y0 = 0.0;
         vport->direction = dxf_point_new ();
-        vport->direction = dxf_point_init (vport->direction);
         vport->direction->x0 = 0.0;
         vport->direction->y0 = 0.0;
         vport->direction->z0 = 0.0;
         vport->target = dxf_point_new ();
-        vport->target = dxf_point_init (vport->target);
         vport->target->x0 = 0.0;
         vport->target->y0 = 0.0;
         vport->target->z0 = 0.0;
@@ -169,8 +162,8 @@ dxf_vport_init
         vport->grid_on = 0;
         vport->snap_style = 0;
         vport->snap_isopair = 0;
-        vport->dictionary_owner_soft = strdup ("");
-        vport->dictionary_owner_hard = strdup ("");
+        vport->dictionary_owner_soft = dxf_string_share ("");
+        vport->dictionary_owner_hard = dxf_string_share ("");
         vport->next = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -312,8 +305,7 @@ dxf_vport_read
                 {
                         /* Now follows a string containing a viewport
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", vport->viewport_name);
+                        dxf_read_string (fp, &vport->viewport_name);
                 }
                 else if (strcmp (temp_string, "10") == 0)
                 {
@@ -571,15 +563,13 @@ dxf_vport_read
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", vport->dictionary_owner_soft);
+                        dxf_read_string (fp, &vport->dictionary_owner_soft);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", vport->dictionary_owner_hard);
+                        dxf_read_string (fp, &vport->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "999") == 0)
                 {
@@ -844,7 +834,7 @@ dxf_vport_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (vport->viewport_name);
+        dxf_string_free (vport->viewport_name);
         dxf_point_free (vport->min);
         dxf_point_free (vport->max);
         dxf_point_free (vport->center);
@@ -853,8 +843,8 @@ dxf_vport_free
         dxf_point_free (vport->grid_spacing);
         dxf_point_free (vport->direction);
         dxf_point_free (vport->target);
-        free (vport->dictionary_owner_soft);
-        free (vport->dictionary_owner_hard);
+        dxf_string_free (vport->dictionary_owner_soft);
+        dxf_string_free (vport->dictionary_owner_hard);
         free (vport);
         vport = NULL;
 #if DEBUG
@@ -1025,6 +1015,8 @@ dxf_vport_set_viewport_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (vport == NULL)
         {
@@ -1040,7 +1032,13 @@ dxf_vport_set_viewport_name
                   __FUNCTION__);
                 return (NULL);
         }
-        vport->viewport_name = strdup (viewport_name);
+        copy = dxf_string_share (viewport_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (vport->viewport_name);
+        vport->viewport_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -4493,6 +4491,8 @@ dxf_vport_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (vport == NULL)
         {
@@ -4508,7 +4508,13 @@ dxf_vport_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        vport->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (vport->dictionary_owner_soft);
+        vport->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -4573,6 +4579,8 @@ dxf_vport_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (vport == NULL)
         {
@@ -4588,7 +4596,13 @@ dxf_vport_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        vport->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (vport->dictionary_owner_hard);
+        vport->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -40,6 +40,8 @@
 
 
 #include "xline.h"
+#include "stats.h"
+#include "util.h"
 
 
 /*!
@@ -72,6 +74,7 @@ dxf_xline_new ()
         else
         {
                 memset (xline, 0, size);
+                dxf_stats_count_allocation (XLINE, size);
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -112,8 +115,8 @@ dxf_xline_init
               return (NULL);
         }
         xline->id_code = 0;
-        xline->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        xline->layer = strdup (DXF_DEFAULT_LAYER);
+        xline->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
+        xline->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         xline->elevation = 0.0;
         xline->thickness = 0.0;
         xline->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
@@ -122,15 +125,14 @@ dxf_xline_init
         xline->paperspace = DXF_MODELSPACE;
         xline->graphics_data_size = 0;
         xline->shadow_mode = 0;
-        xline->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_new ();
-        xline->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) xline->binary_graphics_data);
-        xline->dictionary_owner_soft = strdup ("");
-        xline->material = strdup ("");
-        xline->dictionary_owner_hard = strdup ("");
+        xline->binary_graphics_data = NULL;
+        xline->dictionary_owner_soft = dxf_string_share ("");
+        xline->material = dxf_string_share ("");
+        xline->dictionary_owner_hard = dxf_string_share ("");
         xline->lineweight = 0;
-        xline->plot_style_name = strdup ("");
+        xline->plot_style_name = dxf_string_share ("");
         xline->color_value = 0;
-        xline->color_name = strdup ("");
+        xline->color_name = dxf_string_share ("");
         xline->transparency = 0;
         xline->p0 = (DxfPoint *) dxf_point_new ();
         xline->p0 = dxf_point_init ((DxfPoint *) xline->p0);
@@ -209,14 +211,6 @@ dxf_xline_read
                 xline->p1 = dxf_point_new ();
                 xline->p1 = dxf_point_init (xline->p1);
         }
-        if (xline->binary_graphics_data == NULL)
-        {
-                fprintf (stderr,
-                  (_("Warning in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                xline->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_new ();
-                xline->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) xline->binary_graphics_data);
-        }
         (fp->line_number)++;
         fscanf (fp->fp, "%[^\n]", temp_string);
         while (strcmp (temp_string, "0") != 0)
@@ -242,14 +236,12 @@ dxf_xline_read
                 {
                         /* Now follows a string containing a linetype
                          * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", xline->linetype);
+                        dxf_read_string (fp, &xline->linetype);
                 }
                 else if (strcmp (temp_string, "8") == 0)
                 {
                         /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", xline->layer);
+                        dxf_read_string (fp, &xline->layer);
                 }
                 else if (strcmp (temp_string, "10") == 0)
                 {
@@ -376,31 +368,25 @@ dxf_xline_read
                 {
                         /* Now follows a string containing binary
                          * graphics data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", xline->binary_graphics_data->data_line);
-                        dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) xline->binary_graphics_data->next);
-                        xline->binary_graphics_data = (DxfBinaryGraphicsData *) xline->binary_graphics_data->next;
+                        dxf_binary_graphics_data_read (fp, &xline->binary_graphics_data, NULL);
                 }
                 else if (strcmp (temp_string, "330") == 0)
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", xline->dictionary_owner_soft);
+                        dxf_read_string (fp, &xline->dictionary_owner_soft);
                 }
                 else if (strcmp (temp_string, "347") == 0)
                 {
                         /* Now follows a string containing a
                          * hard-pointer ID/handle to material object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", xline->material);
+                        dxf_read_string (fp, &xline->material);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", xline->dictionary_owner_hard);
+                        dxf_read_string (fp, &xline->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "370") == 0)
                 {
@@ -413,8 +399,7 @@ dxf_xline_read
                 {
                         /* Now follows a string containing a plot style
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", xline->plot_style_name);
+                        dxf_read_string (fp, &xline->plot_style_name);
                 }
                 else if (strcmp (temp_string, "420") == 0)
                 {
@@ -426,8 +411,7 @@ dxf_xline_read
                 {
                         /* Now follows a string containing a color
                          * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", xline->color_name);
+                        dxf_read_string (fp, &xline->color_name);
                 }
                 else if (strcmp (temp_string, "440") == 0)
                 {
@@ -453,11 +437,13 @@ dxf_xline_read
         /* Handle omitted members and/or illegal values. */
         if (strcmp (xline->linetype, "") == 0)
         {
-                xline->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_string_free (xline->linetype);
+                xline->linetype = dxf_string_share (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (xline->layer, "") == 0)
         {
-                xline->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (xline->layer);
+                xline->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Clean up. */
         free (temp_string);
@@ -551,7 +537,8 @@ dxf_xline_write
                 fprintf (stderr,
                   (_("    %s entity is relocated to layer 0\n")),
                   dxf_entity_name);
-                xline->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_string_free (xline->layer);
+                xline->layer = dxf_string_share (DXF_DEFAULT_LAYER);
         }
         /* Start writing output. */
         fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
@@ -710,14 +697,17 @@ dxf_xline_free
                 __FUNCTION__);
               return (EXIT_FAILURE);
         }
-        free (xline->linetype);
-        free (xline->layer);
-        dxf_binary_graphics_data_free_list (xline->binary_graphics_data);
-        free (xline->dictionary_owner_soft);
-        free (xline->material);
-        free (xline->dictionary_owner_hard);
-        free (xline->plot_style_name);
-        free (xline->color_name);
+        dxf_string_free (xline->linetype);
+        dxf_string_free (xline->layer);
+        if (xline->binary_graphics_data != NULL)
+        {
+                dxf_binary_graphics_data_free_list (xline->binary_graphics_data);
+        }
+        dxf_string_free (xline->dictionary_owner_soft);
+        dxf_string_free (xline->material);
+        dxf_string_free (xline->dictionary_owner_hard);
+        dxf_string_free (xline->plot_style_name);
+        dxf_string_free (xline->color_name);
         dxf_point_free (xline->p0);
         dxf_point_free (xline->p1);
         free (xline);
@@ -891,6 +881,8 @@ dxf_xline_set_linetype
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (xline == NULL)
         {
@@ -906,7 +898,13 @@ dxf_xline_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        xline->linetype = strdup (linetype);
+        copy = dxf_string_share (linetype);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (xline->linetype);
+        xline->linetype = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -966,6 +964,8 @@ dxf_xline_set_layer
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (xline == NULL)
         {
@@ -981,7 +981,13 @@ dxf_xline_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        xline->layer = strdup (layer);
+        copy = dxf_string_share (layer);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (xline->layer);
+        xline->layer = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1775,6 +1781,8 @@ dxf_xline_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (xline == NULL)
         {
@@ -1790,7 +1798,13 @@ dxf_xline_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        xline->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (xline->dictionary_owner_soft);
+        xline->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1859,6 +1873,8 @@ dxf_xline_set_material
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (xline == NULL)
         {
@@ -1874,7 +1890,13 @@ dxf_xline_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        xline->material = strdup (material);
+        copy = dxf_string_share (material);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (xline->material);
+        xline->material = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1939,6 +1961,8 @@ dxf_xline_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (xline == NULL)
         {
@@ -1954,7 +1978,13 @@ dxf_xline_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        xline->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (xline->dictionary_owner_hard);
+        xline->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2084,6 +2114,8 @@ dxf_xline_set_plot_style_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (xline == NULL)
         {
@@ -2099,7 +2131,13 @@ dxf_xline_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        xline->plot_style_name = strdup (plot_style_name);
+        copy = dxf_string_share (plot_style_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (xline->plot_style_name);
+        xline->plot_style_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2229,6 +2267,8 @@ dxf_xline_set_color_name
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (xline == NULL)
         {
@@ -2244,7 +2284,13 @@ dxf_xline_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        xline->color_name = strdup (color_name);
+        copy = dxf_string_share (color_name);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (xline->color_name);
+        xline->color_name = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -42,6 +42,7 @@
 
 
 #include "xrecord.h"
+#include "util.h"
 
 
 /*!
@@ -112,15 +113,15 @@ dxf_xrecord_init
                 return (NULL);
         }
         xrecord->id_code = 0;
-        xrecord->dictionary_owner_soft = strdup ("");
-        xrecord->dictionary_owner_hard = strdup ("");
+        xrecord->dictionary_owner_soft = dxf_string_share ("");
+        xrecord->dictionary_owner_hard = dxf_string_share ("");
         xrecord->group_code = 0;
         xrecord->I8 = 0;
         xrecord->I16 = 0;
         xrecord->I32 = 0;
         xrecord->D = 0.0;
         xrecord->F = 0.0;
-        xrecord->S = strdup ("");
+        xrecord->S = dxf_string_share ("");
         xrecord->next = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -217,15 +218,13 @@ dxf_xrecord_read
                 {
                         /* Now follows a string containing Soft-pointer
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", xrecord->dictionary_owner_soft);
+                        dxf_read_string (fp, &xrecord->dictionary_owner_soft);
                 }
                 else if (strcmp (temp_string, "360") == 0)
                 {
                         /* Now follows a string containing Hard owner
                          * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", xrecord->dictionary_owner_hard);
+                        dxf_read_string (fp, &xrecord->dictionary_owner_hard);
                 }
                 else if (strcmp (temp_string, "999") == 0)
                 {
@@ -244,8 +243,7 @@ dxf_xrecord_read
                 {
                         xrecord->group_code = scanf (temp_string, "%d");
                         /* Now follows a string value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", xrecord->S);
+                        dxf_read_string (fp, &xrecord->S);
                 }
                 else if
                   (
@@ -488,9 +486,9 @@ dxf_xrecord_free
                 __FUNCTION__);
               return (EXIT_FAILURE);
         }
-        free (xrecord->dictionary_owner_soft);
-        free (xrecord->dictionary_owner_hard);
-        free (xrecord->S);
+        dxf_string_free (xrecord->dictionary_owner_soft);
+        dxf_string_free (xrecord->dictionary_owner_hard);
+        dxf_string_free (xrecord->S);
         free (xrecord);
         xrecord = NULL;
 #if DEBUG
@@ -667,6 +665,8 @@ dxf_xrecord_set_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (xrecord == NULL)
         {
@@ -682,7 +682,13 @@ dxf_xrecord_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        xrecord->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        copy = dxf_string_share (dictionary_owner_soft);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (xrecord->dictionary_owner_soft);
+        xrecord->dictionary_owner_soft = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -747,6 +753,8 @@ dxf_xrecord_set_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (xrecord == NULL)
         {
@@ -762,7 +770,13 @@ dxf_xrecord_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        xrecord->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        copy = dxf_string_share (dictionary_owner_hard);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (xrecord->dictionary_owner_hard);
+        xrecord->dictionary_owner_hard = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1204,6 +1218,8 @@ dxf_xrecord_set_S
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        char *copy = NULL;
+
         /* Do some basic checks. */
         if (xrecord == NULL)
         {
@@ -1219,7 +1235,13 @@ dxf_xrecord_set_S
                   __FUNCTION__);
                 return (NULL);
         }
-        xrecord->S = strdup (S);
+        copy = dxf_string_share (S);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        dxf_string_free (xrecord->S);
+        xrecord->S = copy;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -0,0 +1,657 @@
+/*!
+ * \file bench_corpus.c
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Synthetic DXF corpus generator for the benchmarks.
+ *
+ * The entities are created with the library functions and written with
+ * the \c dxf_*_write () functions, so the generated files also measure
+ * the write performance of the library.\n
+ * A small pseudo random generator with an explicit state is used, the
+ * same options always give a byte identical file.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include "bench_corpus.h"
+
+
+/*!
+ * \brief Definition of a named AutoCAD version.
+ */
+typedef struct
+bench_corpus_version_struct
+{
+        const char *name;
+                /*!< Release name, e.g. "R2000". */
+        int acad_version_number;
+                /*!< AutoCAD version number. */
+} BenchCorpusVersion;
+
+
+static const BenchCorpusVersion bench_corpus_versions[] =
+{
+        {"R12", AutoCAD_12},
+        {"R13", AutoCAD_13},
+        {"R14", AutoCAD_14},
+        {"R2000", AutoCAD_2000},
+        {"R2004", AutoCAD_2004},
+        {"R2007", AutoCAD_2007},
+        {"R2010", AutoCAD_2010},
+        {"R2013", AutoCAD_2013},
+        {"R2018", AutoCAD_2018}
+};
+
+static const char *bench_corpus_kind_names[BENCH_CORPUS_NUMBER_OF_KINDS] =
+{
+        "line",
+        "lwpolyline",
+        "insert",
+        "hatch",
+        "mtext",
+        "spline"
+};
+
+static const int bench_corpus_kind_min_version[BENCH_CORPUS_NUMBER_OF_KINDS] =
+{
+        AutoCAD_12,
+        AutoCAD_14,
+        AutoCAD_12,
+        AutoCAD_14,
+        AutoCAD_13,
+        AutoCAD_13
+};
+
+static const char *bench_corpus_layers[] =
+{
+        "0",
+        "WALLS",
+        "DOORS",
+        "TEXT",
+        "HATCH"
+};
+
+
+static unsigned long bench_corpus_random (unsigned long *state);
+static double bench_corpus_uniform (unsigned long *state, double min, double max);
+static int bench_corpus_write_line (DxfFile *fp, unsigned long *state, int id_code);
+static int bench_corpus_write_lwpolyline (DxfFile *fp, unsigned long *state, int id_code);
+static int bench_corpus_write_insert (DxfFile *fp, unsigned long *state, int id_code);
+static int bench_corpus_write_hatch (DxfFile *fp, unsigned long *state, int id_code);
+static int bench_corpus_write_mtext (DxfFile *fp, unsigned long *state, int id_code);
+static int bench_corpus_write_spline (DxfFile *fp, unsigned long *state, int id_code);
+
+
+/*!
+ * \brief Set the default options: an R2000 file with 10000 entities,
+ * mostly lines and polylines.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+bench_corpus_set_defaults
+(
+        BenchCorpusOptions *options
+                /*!< a pointer to the options. */
+)
+{
+        if (options == NULL)
+        {
+                return (EXIT_FAILURE);
+        }
+        options->acad_version_number = AutoCAD_2000;
+        options->number_of_entities = 10000;
+        options->weights[BENCH_CORPUS_LINE] = 40;
+        options->weights[BENCH_CORPUS_LWPOLYLINE] = 25;
+        options->weights[BENCH_CORPUS_INSERT] = 15;
+        options->weights[BENCH_CORPUS_HATCH] = 5;
+        options->weights[BENCH_CORPUS_MTEXT] = 10;
+        options->weights[BENCH_CORPUS_SPLINE] = 5;
+        options->seed = 1;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Get the AutoCAD version number of a release name.
+ *
+ * \return the AutoCAD version number, or -1 for an unknown name.
+ */
+int
+bench_corpus_parse_version
+(
+        const char *name
+                /*!< release name, "R12" up to "R2018". */
+)
+{
+        size_t i;
+
+        if (name == NULL)
+        {
+                return (-1);
+        }
+        for (i = 0; i < sizeof (bench_corpus_versions) / sizeof (bench_corpus_versions[0]); i++)
+        {
+                if (strcmp (name, bench_corpus_versions[i].name) == 0)
+                {
+                        return (bench_corpus_versions[i].acad_version_number);
+                }
+        }
+        return (-1);
+}
+
+
+/*!
+ * \brief Set the entity mix from a string like
+ * "line=50,lwpolyline=20,hatch=5".
+ *
+ * Entity types that are not listed get a weight of 0.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when the
+ * string could not be parsed.
+ */
+int
+bench_corpus_parse_mix
+(
+        BenchCorpusOptions *options,
+                /*!< a pointer to the options. */
+        const char *mix
+                /*!< the entity mix. */
+)
+{
+        char name[32];
+        int weight;
+        int length;
+        int i;
+
+        if ((options == NULL) || (mix == NULL))
+        {
+                return (EXIT_FAILURE);
+        }
+        memset (options->weights, 0, sizeof (options->weights));
+        while (*mix != '\0')
+        {
+                if (sscanf (mix, "%31[a-z0-9]=%d%n", name, &weight, &length) != 2)
+                {
+                        fprintf (stderr, "Error: bad entity mix: %s.\n", mix);
+                        return (EXIT_FAILURE);
+                }
+                for (i = 0; i < BENCH_CORPUS_NUMBER_OF_KINDS; i++)
+                {
+                        if (strcmp (name, bench_corpus_kind_names[i]) == 0)
+                        {
+                                options->weights[i] = (weight > 0) ? weight : 0;
+                                break;
+                        }
+                }
+                if (i == BENCH_CORPUS_NUMBER_OF_KINDS)
+                {
+                        fprintf (stderr, "Error: unknown entity type in mix: %s.\n", name);
+                        return (EXIT_FAILURE);
+                }
+                mix += length;
+                if (*mix == ',')
+                {
+                        mix++;
+                }
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Write a synthetic DXF file.
+ *
+ * The file holds a \c HEADER section with the version and an
+ * \c ENTITIES section with the generated entities.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+bench_corpus_write
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an output file (or device). */
+        BenchCorpusOptions *options,
+                /*!< a pointer to the options. */
+        long *number_written
+                /*!< number of entities written, may be \c NULL. */
+)
+{
+        unsigned long state;
+        long total_weight = 0;
+        long draw;
+        long count = 0;
+        long n;
+        int id_code = 0x100;
+        int status = EXIT_SUCCESS;
+        int kind;
+
+        if ((fp == NULL) || (options == NULL))
+        {
+                return (EXIT_FAILURE);
+        }
+        for (kind = 0; kind < BENCH_CORPUS_NUMBER_OF_KINDS; kind++)
+        {
+                if (options->acad_version_number >= bench_corpus_kind_min_version[kind])
+                {
+                        total_weight += options->weights[kind];
+                }
+        }
+        if (total_weight == 0)
+        {
+                fprintf (stderr, "Error: no entity types left in the mix for this version.\n");
+                return (EXIT_FAILURE);
+        }
+        fp->acad_version_number = options->acad_version_number;
+        /* A zero seed would stop the generator. */
+        state = (options->seed != 0) ? options->seed : 0x9e3779b97f4a7c15UL;
+        dxf_section_write (fp, "HEADER");
+        fprintf (fp->fp, "  9\n$ACADVER\n  1\nAC%d\n", options->acad_version_number);
+        dxf_endsec_write (fp);
+        dxf_section_write (fp, "ENTITIES");
+        for (n = 0; (n < options->number_of_entities) && (status == EXIT_SUCCESS); n++)
+        {
+                draw = (long) (bench_corpus_random (&state) % (unsigned long) total_weight);
+                for (kind = 0; kind < BENCH_CORPUS_NUMBER_OF_KINDS; kind++)
+                {
+                        if (options->acad_version_number < bench_corpus_kind_min_version[kind])
+                        {
+                                continue;
+                        }
+                        draw -= options->weights[kind];
+                        if (draw < 0)
+                        {
+                                break;
+                        }
+                }
+                switch (kind)
+                {
+                        case BENCH_CORPUS_LINE:
+                                status = bench_corpus_write_line (fp, &state, id_code);
+                                break;
+                        case BENCH_CORPUS_LWPOLYLINE:
+                                status = bench_corpus_write_lwpolyline (fp, &state, id_code);
+                                break;
+                        case BENCH_CORPUS_INSERT:
+                                status = bench_corpus_write_insert (fp, &state, id_code);
+                                break;
+                        case BENCH_CORPUS_HATCH:
+                                status = bench_corpus_write_hatch (fp, &state, id_code);
+                                break;
+                        case BENCH_CORPUS_MTEXT:
+                                status = bench_corpus_write_mtext (fp, &state, id_code);
+                                break;
+                        default:
+                                status = bench_corpus_write_spline (fp, &state, id_code);
+                                break;
+                }
+                id_code++;
+                count++;
+        }
+        dxf_endsec_write (fp);
+        dxf_file_write_eof (fp);
+        if (number_written != NULL)
+        {
+                *number_written = count;
+        }
+        if (ferror (fp->fp))
+        {
+                fprintf (stderr, "Error: while writing to: %s.\n", fp->filename);
+                return (EXIT_FAILURE);
+        }
+        return (status);
+}
+
+
+/*!
+ * \brief Next value of a xorshift64* pseudo random generator.
+ */
+static unsigned long
+bench_corpus_random
+(
+        unsigned long *state
+                /*!< state of the generator, never 0. */
+)
+{
+        *state ^= *state >> 12;
+        *state ^= *state << 25;
+        *state ^= *state >> 27;
+        return ((*state * 0x2545f4914f6cdd1dUL) >> 11);
+}
+
+
+/*!
+ * \brief Uniformly distributed value in [min, max).
+ */
+static double
+bench_corpus_uniform
+(
+        unsigned long *state,
+                /*!< state of the generator. */
+        double min,
+                /*!< lower limit. */
+        double max
+                /*!< upper limit. */
+)
+{
+        return (min + (max - min) * (double) (bench_corpus_random (state) % 1000000UL) / 1000000.0);
+}
+
+
+/*!
+ * \brief Generate and write a \c LINE entity.
+ */
+static int
+bench_corpus_write_line
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an output file (or device). */
+        unsigned long *state,
+                /*!< state of the generator. */
+        int id_code
+                /*!< id code of the entity. */
+)
+{
+        DxfLine *line = NULL;
+        int status;
+
+        line = dxf_line_init (dxf_line_new ());
+        if (line == NULL)
+        {
+                return (EXIT_FAILURE);
+        }
+        line->id_code = id_code;
+        dxf_line_set_layer (line, (char *) bench_corpus_layers[bench_corpus_random (state) % 5]);
+        line->p0->x0 = bench_corpus_uniform (state, 0.0, 1000.0);
+        line->p0->y0 = bench_corpus_uniform (state, 0.0, 1000.0);
+        line->p1->x0 = line->p0->x0 + bench_corpus_uniform (state, 1.0, 50.0);
+        line->p1->y0 = line->p0->y0 + bench_corpus_uniform (state, 1.0, 50.0);
+        status = dxf_line_write (fp, line);
+        dxf_line_free (line);
+        return (status);
+}
+
+
+/*!
+ * \brief Generate and write a \c LWPOLYLINE entity with 3 up to 12
+ * vertices.
+ */
+static int
+bench_corpus_write_lwpolyline
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an output file (or device). */
+        unsigned long *state,
+                /*!< state of the generator. */
+        int id_code
+                /*!< id code of the entity. */
+)
+{
+        DxfLWPolyline *lwpolyline = NULL;
+        DxfVertex *vertex = NULL;
+        DxfVertex *last = NULL;
+        double x;
+        double y;
+        int number_of_vertices;
+        int status;
+        int i;
+
+        lwpolyline = dxf_lwpolyline_init (dxf_lwpolyline_new ());
+        if (lwpolyline == NULL)
+        {
+                return (EXIT_FAILURE);
+        }
+        /* Replace the bare vertex of dxf_lwpolyline_init (). */
+        dxf_vertex_free ((DxfVertex *) lwpolyline->vertices);
+        lwpolyline->vertices = NULL;
+        lwpolyline->id_code = id_code;
+        number_of_vertices = 3 + (int) (bench_corpus_random (state) % 10);
+        x = bench_corpus_uniform (state, 0.0, 1000.0);
+        y = bench_corpus_uniform (state, 0.0, 1000.0);
+        for (i = 0; i < number_of_vertices; i++)
+        {
+                vertex = dxf_vertex_init (dxf_vertex_new ());
+                if (vertex == NULL)
+                {
+                        break;
+                }
+                x += bench_corpus_uniform (state, -20.0, 20.0);
+                y += bench_corpus_uniform (state, -20.0, 20.0);
+                vertex->p0->x0 = x;
+                vertex->p0->y0 = y;
+                vertex->bulge = ((bench_corpus_random (state) % 4) == 0) ? 0.5 : 0.0;
+                if (last == NULL)
+                {
+                        lwpolyline->vertices = (struct DxfVertex *) vertex;
+                }
+                else
+                {
+                        last->next = (struct DxfVertex *) vertex;
+                }
+                last = vertex;
+        }
+        lwpolyline->number_vertices = i;
+        lwpolyline->flag = (int) (bench_corpus_random (state) % 2);
+        status = dxf_lwpolyline_write (fp, lwpolyline);
+        /* dxf_vertex_free () refuses a vertex that is still linked. */
+        vertex = (DxfVertex *) lwpolyline->vertices;
+        while (vertex != NULL)
+        {
+                last = (DxfVertex *) vertex->next;
+                vertex->next = NULL;
+                dxf_vertex_free (vertex);
+                vertex = last;
+        }
+        lwpolyline->vertices = NULL;
+        dxf_lwpolyline_free (lwpolyline);
+        return (status);
+}
+
+
+/*!
+ * \brief Generate and write an \c INSERT entity.
+ */
+static int
+bench_corpus_write_insert
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an output file (or device). */
+        unsigned long *state,
+                /*!< state of the generator. */
+        int id_code
+                /*!< id code of the entity. */
+)
+{
+        DxfInsert *insert = NULL;
+        int status;
+
+        insert = dxf_insert_init (dxf_insert_new ());
+        if (insert == NULL)
+        {
+                return (EXIT_FAILURE);
+        }
+        insert->id_code = id_code;
+        dxf_insert_set_block_name (insert, "BENCH_BLOCK");
+        insert->p0->x0 = bench_corpus_uniform (state, 0.0, 1000.0);
+        insert->p0->y0 = bench_corpus_uniform (state, 0.0, 1000.0);
+        insert->rel_x_scale = bench_corpus_uniform (state, 0.5, 2.0);
+        insert->rel_y_scale = insert->rel_x_scale;
+        insert->rel_z_scale = 1.0;
+        insert->rot_angle = bench_corpus_uniform (state, 0.0, 360.0);
+        status = dxf_insert_write (fp, insert);
+        dxf_insert_free (insert);
+        return (status);
+}
+
+
+/*!
+ * \brief Generate and write a solid filled \c HATCH entity.
+ */
+static int
+bench_corpus_write_hatch
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an output file (or device). */
+        unsigned long *state,
+                /*!< state of the generator. */
+        int id_code
+                /*!< id code of the entity. */
+)
+{
+        DxfHatch *hatch = NULL;
+        int status;
+
+        hatch = dxf_hatch_init (dxf_hatch_new ());
+        if (hatch == NULL)
+        {
+                return (EXIT_FAILURE);
+        }
+        hatch->id_code = id_code;
+        dxf_hatch_set_pattern_name (hatch, "SOLID");
+        hatch->solid_fill = 1;
+        hatch->p0->z0 = bench_corpus_uniform (state, 0.0, 10.0);
+        hatch->color = 1 + (int) (bench_corpus_random (state) % 255);
+        status = dxf_hatch_write (fp, hatch);
+        dxf_hatch_free (hatch);
+        return (status);
+}
+
+
+/*!
+ * \brief Generate and write an \c MTEXT entity.
+ */
+static int
+bench_corpus_write_mtext
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an output file (or device). */
+        unsigned long *state,
+                /*!< state of the generator. */
+        int id_code
+                /*!< id code of the entity. */
+)
+{
+        DxfMtext *mtext = NULL;
+        char text[64];
+        int status;
+
+        mtext = dxf_mtext_init (dxf_mtext_new ());
+        if (mtext == NULL)
+        {
+                return (EXIT_FAILURE);
+        }
+        mtext->id_code = id_code;
+        snprintf (text, sizeof (text), "Room %lu\\PArea %lu m2",
+          bench_corpus_random (state) % 1000, bench_corpus_random (state) % 100);
+        free (mtext->text_value);
+        mtext->text_value = strdup (text);
+        free (mtext->text_style);
+        mtext->text_style = strdup ("STANDARD");
+        mtext->p0->x0 = bench_corpus_uniform (state, 0.0, 1000.0);
+        mtext->p0->y0 = bench_corpus_uniform (state, 0.0, 1000.0);
+        mtext->height = 2.5;
+        mtext->rectangle_width = 40.0;
+        mtext->attachment_point = 1;
+        mtext->drawing_direction = 1;
+        mtext->extr_z0 = 1.0;
+        status = dxf_mtext_write (fp, mtext);
+        dxf_mtext_free (mtext);
+        return (status);
+}
+
+
+/*!
+ * \brief Generate and write a cubic \c SPLINE entity with 4 up to 11
+ * control points.
+ */
+static int
+bench_corpus_write_spline
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an output file (or device). */
+        unsigned long *state,
+                /*!< state of the generator. */
+        int id_code
+                /*!< id code of the entity. */
+)
+{
+        DxfSpline *spline = NULL;
+        DxfPoint *point = NULL;
+        DxfPoint *last = NULL;
+        int number_of_control_points;
+        int status;
+        int i;
+
+        spline = dxf_spline_init (dxf_spline_new ());
+        if (spline == NULL)
+        {
+                return (EXIT_FAILURE);
+        }
+        spline->id_code = id_code;
+        spline->degree = 3;
+        spline->flag = 8;
+        number_of_control_points = 4 + (int) (bench_corpus_random (state) % 8);
+        last = spline->p0;
+        last->x0 = bench_corpus_uniform (state, 0.0, 1000.0);
+        last->y0 = bench_corpus_uniform (state, 0.0, 1000.0);
+        for (i = 1; i < number_of_control_points; i++)
+        {
+                point = dxf_point_init (dxf_point_new ());
+                if (point == NULL)
+                {
+                        break;
+                }
+                point->x0 = last->x0 + bench_corpus_uniform (state, 1.0, 20.0);
+                point->y0 = last->y0 + bench_corpus_uniform (state, -10.0, 10.0);
+                last->next = (struct DxfPoint *) point;
+                last = point;
+        }
+        spline->number_of_control_points = i;
+        spline->number_of_knots = i + spline->degree + 1;
+        spline->knot_tolerance = 0.0000001;
+        spline->control_point_tolerance = 0.0000001;
+        status = dxf_spline_write (fp, spline);
+        /* dxf_point_free () refuses a point that is still linked. */
+        point = (DxfPoint *) spline->p0->next;
+        spline->p0->next = NULL;
+        while (point != NULL)
+        {
+                last = (DxfPoint *) point->next;
+                point->next = NULL;
+                dxf_point_free (point);
+                point = last;
+        }
+        dxf_spline_free (spline);
+        return (status);
+}
+
+
+/* EOF */
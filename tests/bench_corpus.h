@@ -0,0 +1,88 @@
+/*!
+ * \file bench_corpus.h
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Header file for the synthetic DXF corpus generator of the
+ * benchmarks.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#ifndef LIBDXF_TESTS_BENCH_CORPUS_H
+#define LIBDXF_TESTS_BENCH_CORPUS_H
+
+
+#include "includes.h"
+
+
+/*!
+ * \brief Entity types generated for the benchmarks.
+ */
+typedef enum
+bench_corpus_kind
+{
+        BENCH_CORPUS_LINE,
+        BENCH_CORPUS_LWPOLYLINE,
+        BENCH_CORPUS_INSERT,
+        BENCH_CORPUS_HATCH,
+        BENCH_CORPUS_MTEXT,
+        BENCH_CORPUS_SPLINE,
+        BENCH_CORPUS_NUMBER_OF_KINDS
+} BenchCorpusKind;
+
+
+/*!
+ * \brief Definition of the options of a generated DXF file.
+ */
+typedef struct
+bench_corpus_options_struct
+{
+        int acad_version_number;
+                /*!< AutoCAD version number of the output. */
+        long number_of_entities;
+                /*!< Number of entities to generate. */
+        int weights[BENCH_CORPUS_NUMBER_OF_KINDS];
+                /*!< Relative frequency of every entity type, entity
+                 * types that do not exist in the output version are
+                 * left out. */
+        unsigned long seed;
+                /*!< Seed of the pseudo random generator, the same
+                 * options always give the same file. */
+} BenchCorpusOptions;
+
+
+int bench_corpus_set_defaults (BenchCorpusOptions *options);
+int bench_corpus_parse_version (const char *name);
+int bench_corpus_parse_mix (BenchCorpusOptions *options, const char *mix);
+int bench_corpus_write (DxfFile *fp, BenchCorpusOptions *options, long *number_written);
+
+
+#endif /* LIBDXF_TESTS_BENCH_CORPUS_H */
+
+
+/* EOF */
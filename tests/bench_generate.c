@@ -0,0 +1,125 @@
+/*!
+ * \file bench_generate.c
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Command line tool to generate synthetic DXF files for the
+ * benchmarks.
+ *
+ * Usage: bench_generate [-v version] [-n entities] [-m mix] [-s seed]
+ * output.dxf\n
+ * For example: bench_generate -v R2010 -n 100000
+ * -m line=50,lwpolyline=30,mtext=20 big.dxf
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include "bench_corpus.h"
+
+
+/*!
+ * \brief Print the usage of the program.
+ */
+static void
+bench_generate_usage ()
+{
+        fprintf (stderr,
+          "Usage: bench_generate [-v version] [-n entities] [-m mix] [-s seed] output.dxf\n"
+          "  -v version   R12, R13, R14, R2000, R2004, R2007, R2010, R2013 or R2018 (default R2000)\n"
+          "  -n entities  number of entities (default 10000)\n"
+          "  -m mix       e.g. line=40,lwpolyline=25,insert=15,hatch=5,mtext=10,spline=5\n"
+          "  -s seed      seed of the pseudo random generator (default 1)\n");
+}
+
+
+int
+main
+(
+        int argc,
+        char **argv
+)
+{
+        BenchCorpusOptions options;
+        DxfFile file;
+        long number_written = 0;
+        int status;
+        int c;
+
+        bench_corpus_set_defaults (&options);
+        while ((c = getopt (argc, argv, "v:n:m:s:h")) != -1)
+        {
+                switch (c)
+                {
+                        case 'v':
+                                options.acad_version_number = bench_corpus_parse_version (optarg);
+                                if (options.acad_version_number < 0)
+                                {
+                                        fprintf (stderr, "Error: unknown version: %s.\n", optarg);
+                                        return (EXIT_FAILURE);
+                                }
+                                break;
+                        case 'n':
+                                options.number_of_entities = atol (optarg);
+                                break;
+                        case 'm':
+                                if (bench_corpus_parse_mix (&options, optarg) != EXIT_SUCCESS)
+                                {
+                                        return (EXIT_FAILURE);
+                                }
+                                break;
+                        case 's':
+                                options.seed = strtoul (optarg, NULL, 0);
+                                break;
+                        default:
+                                bench_generate_usage ();
+                                return (EXIT_FAILURE);
+                }
+        }
+        if (optind != argc - 1)
+        {
+                bench_generate_usage ();
+                return (EXIT_FAILURE);
+        }
+        memset (&file, 0, sizeof (DxfFile));
+        file.filename = argv[optind];
+        file.fp = fopen (file.filename, "w");
+        if (file.fp == NULL)
+        {
+                fprintf (stderr, "Error: could not open file: %s for writing.\n", file.filename);
+                return (EXIT_FAILURE);
+        }
+        status = bench_corpus_write (&file, &options, &number_written);
+        if (fclose (file.fp) != 0)
+        {
+                status = EXIT_FAILURE;
+        }
+        fprintf (stdout, "%s: %ld entities\n", file.filename, number_written);
+        return (status);
+}
+
+
+/* EOF */
@@ -0,0 +1,493 @@
+/*!
+ * \file bench_run.c
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Benchmark driver for reading and writing DXF files.
+ *
+ * The driver generates a synthetic corpus for a number of DXF versions
+ * (measuring the write speed), then reads the generated files and any
+ * DXF files or directories given on the command line (measuring the read
+ * speed).\n
+ * Files are read with dxf_file_read_drawing ().\n
+ * Reported per file are megabytes, seconds (best of the repeats),
+ * MB/s, entities, entities/s and the number of allocations, counted by
+ * wrapping \c malloc (), \c calloc () and \c realloc ().\n
+ * The peak resident set size of the process is reported at the end.\n
+ * Usage: bench_run [-n entities] [-v versions] [-m mix] [-s seed]
+ * [-r repeats] [-o directory] [-k] [-j] [file or directory ...]
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include "bench_corpus.h"
+#include <dirent.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+
+
+#define BENCH_RUN_MAX_FILES 1024
+        /*!< \brief Maximum number of files read from a directory. */
+
+
+/*!
+ * \brief Definition of the result of a single benchmark.
+ */
+typedef struct
+bench_run_result_struct
+{
+        double bytes;
+                /*!< Number of bytes read or written. */
+        double seconds;
+                /*!< Best time of the repeats. */
+        long entities;
+                /*!< Number of entities written, or decoded by the
+                 * library. */
+        uint64_t allocations;
+                /*!< Number of malloc (), calloc () and realloc () calls
+                 * of a single repeat. */
+} BenchRunResult;
+
+
+static double bench_run_get_time ();
+static uint64_t bench_run_get_allocations ();
+static int bench_run_read (const char *filename, BenchRunResult *result);
+static void bench_run_print (const char *name, BenchRunResult *result);
+static int bench_run_read_path (const char *path, int repeats);
+static int bench_run_compare (const void *a, const void *b);
+
+
+static uint64_t bench_run_allocations = 0;
+        /*!< \brief Number of allocations counted by the malloc ()
+         * wrappers. */
+
+
+#ifdef __GLIBC__
+/* The allocation functions of the C library are interposed to count
+ * every allocation made by the library, not only the entity structs
+ * counted by the library statistics. */
+extern void *__libc_malloc (size_t size);
+extern void *__libc_calloc (size_t number, size_t size);
+extern void *__libc_realloc (void *ptr, size_t size);
+
+
+/*!
+ * \brief Count and forward a call to \c malloc ().
+ */
+void *
+malloc
+(
+        size_t size
+                /*!< number of bytes to allocate. */
+)
+{
+        __atomic_add_fetch (&bench_run_allocations, 1, __ATOMIC_RELAXED);
+        return (__libc_malloc (size));
+}
+
+
+/*!
+ * \brief Count and forward a call to \c calloc ().
+ */
+void *
+calloc
+(
+        size_t number,
+                /*!< number of elements to allocate. */
+        size_t size
+                /*!< size of an element. */
+)
+{
+        __atomic_add_fetch (&bench_run_allocations, 1, __ATOMIC_RELAXED);
+        return (__libc_calloc (number, size));
+}
+
+
+/*!
+ * \brief Count and forward a call to \c realloc ().
+ */
+void *
+realloc
+(
+        void *ptr,
+                /*!< pointer to the memory to resize, may be \c NULL. */
+        size_t size
+                /*!< new number of bytes. */
+)
+{
+        __atomic_add_fetch (&bench_run_allocations, 1, __ATOMIC_RELAXED);
+        return (__libc_realloc (ptr, size));
+}
+#endif /* __GLIBC__ */
+
+
+int
+main
+(
+        int argc,
+        char **argv
+)
+{
+        BenchCorpusOptions options;
+        BenchRunResult result;
+        BenchRunResult best;
+        DxfFile file;
+        DxfStats stats;
+        struct rusage usage;
+        char *versions = "R12,R2000,R2018";
+        char *directory = ".";
+        char *version = NULL;
+        char *save = NULL;
+        char filename[DXF_MAX_STRING_LENGTH];
+        long number_written;
+        uint64_t allocations;
+        double start;
+        int repeats = 3;
+        int keep = FALSE;
+        int json = FALSE;
+        int status = EXIT_SUCCESS;
+        int c;
+        int i;
+
+        bench_corpus_set_defaults (&options);
+        options.number_of_entities = 100000;
+        while ((c = getopt (argc, argv, "n:v:m:s:r:o:kjh")) != -1)
+        {
+                switch (c)
+                {
+                        case 'n':
+                                options.number_of_entities = atol (optarg);
+                                break;
+                        case 'v':
+                                versions = optarg;
+                                break;
+                        case 'm':
+                                if (bench_corpus_parse_mix (&options, optarg) != EXIT_SUCCESS)
+                                {
+                                        return (EXIT_FAILURE);
+                                }
+                                break;
+                        case 's':
+                                options.seed = strtoul (optarg, NULL, 0);
+                                break;
+                        case 'r':
+                                repeats = (atoi (optarg) > 0) ? atoi (optarg) : 1;
+                                break;
+                        case 'o':
+                                directory = optarg;
+                                break;
+                        case 'k':
+                                keep = TRUE;
+                                break;
+                        case 'j':
+                                json = TRUE;
+                                break;
+                        default:
+                                fprintf (stderr,
+                                  "Usage: bench_run [-n entities] [-v versions] [-m mix] [-s seed]\n"
+                                  "                 [-r repeats] [-o directory] [-k] [-j] [file or directory ...]\n");
+                                return (EXIT_FAILURE);
+                }
+        }
+        dxf_stats_enable (TRUE);
+        fprintf (stdout, "%-40s %10s %8s %10s %10s %12s %12s\n",
+          "file", "MB", "seconds", "MB/s", "entities", "entities/s",
+          "allocations");
+        /* Write and read the synthetic corpus. */
+        versions = strdup (versions);
+        for (version = strtok_r (versions, ",", &save);
+          version != NULL;
+          version = strtok_r (NULL, ",", &save))
+        {
+                options.acad_version_number = bench_corpus_parse_version (version);
+                if (options.acad_version_number < 0)
+                {
+                        fprintf (stderr, "Error: unknown version: %s.\n", version);
+                        status = EXIT_FAILURE;
+                        continue;
+                }
+                snprintf (filename, sizeof (filename), "%s/bench_%s.dxf", directory, version);
+                memset (&best, 0, sizeof (BenchRunResult));
+                for (i = 0; i < repeats; i++)
+                {
+                        memset (&file, 0, sizeof (DxfFile));
+                        file.filename = filename;
+                        file.fp = fopen (filename, "w");
+                        if (file.fp == NULL)
+                        {
+                                fprintf (stderr, "Error: could not open file: %s for writing.\n", filename);
+                                status = EXIT_FAILURE;
+                                break;
+                        }
+                        allocations = bench_run_get_allocations ();
+                        start = bench_run_get_time ();
+                        if (bench_corpus_write (&file, &options, &number_written) != EXIT_SUCCESS)
+                        {
+                                status = EXIT_FAILURE;
+                        }
+                        result.bytes = (double) ftell (file.fp);
+                        fclose (file.fp);
+                        result.seconds = bench_run_get_time () - start;
+                        result.entities = number_written;
+                        result.allocations = bench_run_get_allocations () - allocations;
+                        if ((i == 0) || (result.seconds < best.seconds))
+                        {
+                                best = result;
+                        }
+                }
+                if (i == 0)
+                {
+                        continue;
+                }
+                snprintf (filename, sizeof (filename), "write bench_%s.dxf", version);
+                bench_run_print (filename, &best);
+                snprintf (filename, sizeof (filename), "%s/bench_%s.dxf", directory, version);
+                if (bench_run_read_path (filename, repeats) != EXIT_SUCCESS)
+                {
+                        status = EXIT_FAILURE;
+                }
+                if (!keep)
+                {
+                        remove (filename);
+                }
+        }
+        free (versions);
+        /* Read the files and directories on the command line. */
+        for (i = optind; i < argc; i++)
+        {
+                if (bench_run_read_path (argv[i], repeats) != EXIT_SUCCESS)
+                {
+                        status = EXIT_FAILURE;
+                }
+        }
+        getrusage (RUSAGE_SELF, &usage);
+        fprintf (stdout, "peak RSS: %ld kB\n", usage.ru_maxrss);
+        if (json)
+        {
+                dxf_stats_get (&stats);
+                dxf_stats_write_json (stdout, &stats);
+        }
+        return (status);
+}
+
+
+/*!
+ * \brief Get the time of a monotonic clock in seconds.
+ */
+static double
+bench_run_get_time ()
+{
+        struct timespec now;
+
+        clock_gettime (CLOCK_MONOTONIC, &now);
+        return ((double) now.tv_sec + 1.0e-9 * (double) now.tv_nsec);
+}
+
+
+/*!
+ * \brief Get the number of allocations made by the library (and this
+ * program) so far.
+ *
+ * \return the number of allocations, or 0 when \c malloc () can not be
+ * interposed.
+ */
+static uint64_t
+bench_run_get_allocations ()
+{
+        return (__atomic_load_n (&bench_run_allocations, __ATOMIC_RELAXED));
+}
+
+
+/*!
+ * \brief Read a DXF file once with dxf_file_read_drawing ().
+ *
+ * The number of entities is taken from the statistics of the drawing,
+ * only entities decoded by the library are counted.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+bench_run_read
+(
+        const char *filename,
+                /*!< name of the input file. */
+        BenchRunResult *result
+                /*!< result of the benchmark. */
+)
+{
+        DxfDrawing *drawing = NULL;
+        DxfStats *stats = NULL;
+        struct stat file_status;
+        uint64_t allocations;
+        double start;
+        int status;
+        int i;
+
+        memset (result, 0, sizeof (BenchRunResult));
+        if (stat (filename, &file_status) != 0)
+        {
+                fprintf (stderr, "Error: could not open file: %s for reading.\n", filename);
+                return (EXIT_FAILURE);
+        }
+        result->bytes = (double) file_status.st_size;
+        drawing = dxf_drawing_new ();
+        if (drawing == NULL)
+        {
+                fprintf (stderr, "Error: could not allocate a drawing.\n");
+                return (EXIT_FAILURE);
+        }
+        allocations = bench_run_get_allocations ();
+        start = bench_run_get_time ();
+        status = dxf_file_read_drawing ((char *) filename, drawing);
+        result->seconds = bench_run_get_time () - start;
+        result->allocations = bench_run_get_allocations () - allocations;
+        stats = dxf_drawing_get_stats (drawing);
+        for (i = 0; i < DXF_STATS_NUMBER_OF_ENTITY_TYPES; i++)
+        {
+                result->entities += (long) stats->entities_read[i];
+        }
+        dxf_drawing_free (drawing);
+        return (status);
+}
+
+
+/*!
+ * \brief Print a result line.
+ */
+static void
+bench_run_print
+(
+        const char *name,
+                /*!< name of the benchmark. */
+        BenchRunResult *result
+                /*!< result of the benchmark. */
+)
+{
+        double seconds = (result->seconds > 0.0) ? result->seconds : 1.0e-9;
+
+        fprintf (stdout, "%-40s %10.3f %8.4f %10.2f %10ld %12.0f %12" PRIu64 "\n",
+          name, result->bytes / 1.0e6, result->seconds,
+          result->bytes / 1.0e6 / seconds, result->entities,
+          (double) result->entities / seconds, result->allocations);
+}
+
+
+/*!
+ * \brief Read a DXF file, or all DXF files in a directory, and print
+ * the best result of the repeats for every file.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+bench_run_read_path
+(
+        const char *path,
+                /*!< name of a file or a directory. */
+        int repeats
+                /*!< number of repeats. */
+)
+{
+        BenchRunResult result;
+        BenchRunResult best;
+        DIR *dir = NULL;
+        struct dirent *entry = NULL;
+        char *names[BENCH_RUN_MAX_FILES];
+        char filename[DXF_MAX_STRING_LENGTH];
+        char *base = NULL;
+        size_t length;
+        int number_of_names = 0;
+        int status = EXIT_SUCCESS;
+        int i;
+        int j;
+
+        dir = opendir (path);
+        if (dir == NULL)
+        {
+                names[number_of_names++] = strdup (path);
+        }
+        else
+        {
+                while (((entry = readdir (dir)) != NULL)
+                  && (number_of_names < BENCH_RUN_MAX_FILES))
+                {
+                        length = strlen (entry->d_name);
+                        if ((length > 4)
+                          && (strcasecmp (entry->d_name + length - 4, ".dxf") == 0))
+                        {
+                                snprintf (filename, sizeof (filename), "%s/%s", path, entry->d_name);
+                                names[number_of_names++] = strdup (filename);
+                        }
+                }
+                closedir (dir);
+                qsort (names, number_of_names, sizeof (char *), bench_run_compare);
+        }
+        for (i = 0; i < number_of_names; i++)
+        {
+                for (j = 0; j < repeats; j++)
+                {
+                        if (bench_run_read (names[i], &result) != EXIT_SUCCESS)
+                        {
+                                status = EXIT_FAILURE;
+                                break;
+                        }
+                        if ((j == 0) || (result.seconds < best.seconds))
+                        {
+                                best = result;
+                        }
+                }
+                if (j == repeats)
+                {
+                        base = strrchr (names[i], '/');
+                        snprintf (filename, sizeof (filename), "read %s",
+                          (base != NULL) ? base + 1 : names[i]);
+                        bench_run_print (filename, &best);
+                }
+                free (names[i]);
+        }
+        return (status);
+}
+
+
+/*!
+ * \brief Compare two file names for qsort ().
+ */
+static int
+bench_run_compare
+(
+        const void *a,
+                /*!< pointer to the first name. */
+        const void *b
+                /*!< pointer to the second name. */
+)
+{
+        return (strcmp (*(char * const *) a, *(char * const *) b));
+}
+
+
+/* EOF */
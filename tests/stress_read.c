@@ -0,0 +1,474 @@
+/*!
+ * \file stress_read.c
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Stress test for reading DXF files from many threads at once.
+ *
+ * Every file is first read once by the main thread to obtain a reference
+ * result, after which a number of threads read all files for a number of
+ * rounds at the same time, each thread into its own drawing.\n
+ * Every thread starts at a different file, so that the same file is read
+ * by several threads at the same time as well as different files.\n
+ * The same amount of reading is then repeated with dxf_batch_process ()
+ * on a list holding every file once for every thread and round.\n
+ * The test fails when a result differs from the reference or when the
+ * number of lines counted by the library statistics does not add up.\n
+ * Usage: stress_read [-t threads] [-r rounds] [file or directory ...]
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include "includes.h"
+#include <dirent.h>
+#include <pthread.h>
+
+
+#define STRESS_READ_MAX_FILES 1024
+        /*!< \brief Maximum number of files read from the command line
+         * and directories. */
+
+#define STRESS_READ_MAX_THREADS 256
+        /*!< \brief Maximum number of reading threads. */
+
+
+/*!
+ * \brief Definition of the result of reading a single file.
+ */
+typedef struct
+stress_read_result_struct
+{
+        int status;
+                /*!< Return value of dxf_file_read_drawing (). */
+        int acad_version_number;
+                /*!< AutoCAD version number found in the header. */
+        double ext_min_x;
+                /*!< X-coordinate of the lower left drawing extent. */
+        double ext_min_y;
+                /*!< Y-coordinate of the lower left drawing extent. */
+        double ext_max_x;
+                /*!< X-coordinate of the upper right drawing extent. */
+        double ext_max_y;
+                /*!< Y-coordinate of the upper right drawing extent. */
+        uint64_t lines_read;
+                /*!< Number of lines read, from the statistics of the
+                 * drawing. */
+} StressReadResult;
+
+
+/*!
+ * \brief Definition of the work of a single thread.
+ */
+typedef struct
+stress_read_thread_struct
+{
+        int number;
+                /*!< Number of the thread. */
+        int rounds;
+                /*!< Number of times all files are read. */
+        int number_of_files;
+                /*!< Number of files. */
+        char **names;
+                /*!< File names. */
+        StressReadResult *reference;
+                /*!< Reference result of each file. */
+        long mismatches;
+                /*!< Number of results differing from the reference. */
+} StressReadThread;
+
+
+/*!
+ * \brief Definition of the reference of a batch.
+ */
+typedef struct
+stress_read_batch_struct
+{
+        int number_of_files;
+                /*!< Number of files. */
+        char **names;
+                /*!< File names. */
+        StressReadResult *reference;
+                /*!< Reference result of each file. */
+        long mismatches;
+                /*!< Number of results differing from the reference,
+                 * updated atomically. */
+} StressReadBatch;
+
+
+static int stress_read_file (const char *filename, StressReadResult *result);
+static void stress_read_get_result (DxfDrawing *drawing, int status, StressReadResult *result);
+static void *stress_read_thread (void *data);
+static int stress_read_batch (const char *path, DxfDrawing *drawing, int status, void *user_data);
+static int stress_read_add_path (const char *path, char **names, int number_of_names);
+static int stress_read_compare (const void *a, const void *b);
+
+
+int
+main
+(
+        int argc,
+        char **argv
+)
+{
+        StressReadThread threads[STRESS_READ_MAX_THREADS];
+        pthread_t ids[STRESS_READ_MAX_THREADS];
+        StressReadResult reference[STRESS_READ_MAX_FILES];
+        char *names[STRESS_READ_MAX_FILES];
+        char **paths = NULL;
+        StressReadBatch batch;
+        DxfStats stats;
+        uint64_t reference_lines;
+        uint64_t expected_lines;
+        long mismatches = 0;
+        int number_of_threads = 16;
+        int number_of_files = 0;
+        int rounds = 4;
+        int status = EXIT_SUCCESS;
+        int c;
+        int i;
+
+        while ((c = getopt (argc, argv, "t:r:h")) != -1)
+        {
+                switch (c)
+                {
+                        case 't':
+                                number_of_threads = atoi (optarg);
+                                if (number_of_threads < 1)
+                                {
+                                        number_of_threads = 1;
+                                }
+                                if (number_of_threads > STRESS_READ_MAX_THREADS)
+                                {
+                                        number_of_threads = STRESS_READ_MAX_THREADS;
+                                }
+                                break;
+                        case 'r':
+                                rounds = (atoi (optarg) > 0) ? atoi (optarg) : 1;
+                                break;
+                        default:
+                                fprintf (stderr,
+                                  "Usage: %s [-t threads] [-r rounds] [file or directory ...]\n",
+                                  argv[0]);
+                                return ((c == 'h') ? EXIT_SUCCESS : EXIT_FAILURE);
+                }
+        }
+        for (i = optind; i < argc; i++)
+        {
+                number_of_files = stress_read_add_path (argv[i], names, number_of_files);
+        }
+        if (number_of_files == 0)
+        {
+                fprintf (stderr, "No DXF files to read.\n");
+                return (EXIT_FAILURE);
+        }
+        /* Obtain the reference results from a single thread. */
+        dxf_stats_enable (TRUE);
+        dxf_stats_reset ();
+        for (i = 0; i < number_of_files; i++)
+        {
+                stress_read_file (names[i], &reference[i]);
+        }
+        dxf_stats_get (&stats);
+        reference_lines = stats.lines_read;
+        /* Read all files from all threads at the same time. */
+        dxf_stats_reset ();
+        for (i = 0; i < number_of_threads; i++)
+        {
+                threads[i].number = i;
+                threads[i].rounds = rounds;
+                threads[i].number_of_files = number_of_files;
+                threads[i].names = names;
+                threads[i].reference = reference;
+                threads[i].mismatches = 0;
+                if (pthread_create (&ids[i], NULL, stress_read_thread, &threads[i]) != 0)
+                {
+                        fprintf (stderr, "Could not create thread %d.\n", i);
+                        number_of_threads = i;
+                        status = EXIT_FAILURE;
+                        break;
+                }
+        }
+        for (i = 0; i < number_of_threads; i++)
+        {
+                pthread_join (ids[i], NULL);
+                mismatches += threads[i].mismatches;
+        }
+        dxf_stats_get (&stats);
+        expected_lines = reference_lines * (uint64_t) number_of_threads * (uint64_t) rounds;
+        fprintf (stdout, "%d files, %d threads, %d rounds: %ld mismatches, %llu of %llu lines read\n",
+          number_of_files, number_of_threads, rounds, mismatches,
+          (unsigned long long) stats.lines_read,
+          (unsigned long long) expected_lines);
+        if ((mismatches != 0) || (stats.lines_read != expected_lines))
+        {
+                status = EXIT_FAILURE;
+        }
+        /* Read the same files with the batch scheduler. */
+        paths = malloc (number_of_files * number_of_threads * rounds * sizeof (char *));
+        if (paths == NULL)
+        {
+                fprintf (stderr, "Could not allocate the batch.\n");
+                status = EXIT_FAILURE;
+        }
+        else
+        {
+                for (i = 0; i < number_of_files * number_of_threads * rounds; i++)
+                {
+                        paths[i] = names[i % number_of_files];
+                }
+                batch.number_of_files = number_of_files;
+                batch.names = names;
+                batch.reference = reference;
+                batch.mismatches = 0;
+                dxf_stats_reset ();
+                if (dxf_batch_process (paths, number_of_files * number_of_threads * rounds,
+                  number_of_threads, stress_read_batch, &batch) != EXIT_SUCCESS)
+                {
+                        status = EXIT_FAILURE;
+                }
+                dxf_stats_get (&stats);
+                fprintf (stdout, "%d files, %d threads, %d rounds (batch): %ld mismatches, %llu of %llu lines read\n",
+                  number_of_files, number_of_threads, rounds, batch.mismatches,
+                  (unsigned long long) stats.lines_read,
+                  (unsigned long long) expected_lines);
+                if ((batch.mismatches != 0) || (stats.lines_read != expected_lines))
+                {
+                        status = EXIT_FAILURE;
+                }
+                free (paths);
+        }
+        for (i = 0; i < number_of_files; i++)
+        {
+                free (names[i]);
+        }
+        return (status);
+}
+
+
+/*!
+ * \brief Read a DXF file into a drawing of its own and record the
+ * result.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+stress_read_file
+(
+        const char *filename,
+                /*!< name of the DXF file. */
+        StressReadResult *result
+                /*!< pointer to the result. */
+)
+{
+        DxfDrawing *drawing = NULL;
+
+        drawing = dxf_drawing_new ();
+        if (drawing == NULL)
+        {
+                stress_read_get_result (NULL, EXIT_FAILURE, result);
+                return (EXIT_FAILURE);
+        }
+        stress_read_get_result (drawing,
+          dxf_file_read_drawing ((char *) filename, drawing), result);
+        dxf_drawing_free (drawing);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Record the result of reading a DXF file into a drawing.
+ */
+static void
+stress_read_get_result
+(
+        DxfDrawing *drawing,
+                /*!< drawing holding the contents of the file. */
+        int status,
+                /*!< return value of the reader. */
+        StressReadResult *result
+                /*!< pointer to the result. */
+)
+{
+        DxfHeader *header = NULL;
+
+        memset (result, 0, sizeof (StressReadResult));
+        result->status = status;
+        if (drawing == NULL)
+        {
+                return;
+        }
+        header = (DxfHeader *) drawing->header;
+        if (header != NULL)
+        {
+                result->acad_version_number = header->_AcadVer;
+                result->ext_min_x = header->ExtMin.x0;
+                result->ext_min_y = header->ExtMin.y0;
+                result->ext_max_x = header->ExtMax.x0;
+                result->ext_max_y = header->ExtMax.y0;
+        }
+        result->lines_read = dxf_drawing_get_stats (drawing)->lines_read;
+}
+
+
+/*!
+ * \brief Read all files for a number of rounds and compare the results
+ * with the reference.
+ */
+static void *
+stress_read_thread
+(
+        void *data
+                /*!< pointer to the work of the thread. */
+)
+{
+        StressReadThread *thread = (StressReadThread *) data;
+        StressReadResult result;
+        int round;
+        int i;
+        int j;
+
+        for (round = 0; round < thread->rounds; round++)
+        {
+                for (i = 0; i < thread->number_of_files; i++)
+                {
+                        j = (i + thread->number) % thread->number_of_files;
+                        stress_read_file (thread->names[j], &result);
+                        if (memcmp (&result, &thread->reference[j], sizeof (StressReadResult)) != 0)
+                        {
+                                fprintf (stderr, "Thread %d: result of %s differs from the reference.\n",
+                                  thread->number, thread->names[j]);
+                                thread->mismatches++;
+                        }
+                }
+        }
+        return (NULL);
+}
+
+
+/*!
+ * \brief Compare the result of a file read by dxf_batch_process () with
+ * the reference, used as batch callback.
+ *
+ * \return \c EXIT_SUCCESS.
+ */
+static int
+stress_read_batch
+(
+        const char *path,
+                /*!< name of the file. */
+        DxfDrawing *drawing,
+                /*!< drawing holding the contents of the file. */
+        int status,
+                /*!< return value of the reader. */
+        void *user_data
+                /*!< pointer to the reference of the batch. */
+)
+{
+        StressReadBatch *batch = (StressReadBatch *) user_data;
+        StressReadResult result;
+        int i;
+
+        /* The batch holds pointers to the names. */
+        for (i = 0; (i < batch->number_of_files) && (batch->names[i] != path); i++);
+        stress_read_get_result (drawing, status, &result);
+        if ((i == batch->number_of_files)
+          || (memcmp (&result, &batch->reference[i], sizeof (StressReadResult)) != 0))
+        {
+                fprintf (stderr, "Batch: result of %s differs from the reference.\n", path);
+                __sync_fetch_and_add (&batch->mismatches, 1);
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Add a DXF file, or the DXF files in a directory, to the list
+ * of names.
+ *
+ * \return The new number of names.
+ */
+static int
+stress_read_add_path
+(
+        const char *path,
+                /*!< name of a file or a directory. */
+        char **names,
+                /*!< list of names. */
+        int number_of_names
+                /*!< number of names in the list. */
+)
+{
+        DIR *dir = NULL;
+        struct dirent *entry = NULL;
+        char filename[DXF_MAX_STRING_LENGTH];
+        size_t length;
+        int first = number_of_names;
+
+        dir = opendir (path);
+        if (dir == NULL)
+        {
+                if (number_of_names < STRESS_READ_MAX_FILES)
+                {
+                        names[number_of_names++] = strdup (path);
+                }
+                return (number_of_names);
+        }
+        while (((entry = readdir (dir)) != NULL)
+          && (number_of_names < STRESS_READ_MAX_FILES))
+        {
+                length = strlen (entry->d_name);
+                if ((length > 4)
+                  && (strcasecmp (entry->d_name + length - 4, ".dxf") == 0))
+                {
+                        snprintf (filename, sizeof (filename), "%s/%s", path, entry->d_name);
+                        names[number_of_names++] = strdup (filename);
+                }
+        }
+        closedir (dir);
+        qsort (names + first, number_of_names - first, sizeof (char *), stress_read_compare);
+        return (number_of_names);
+}
+
+
+/*!
+ * \brief Compare two file names for qsort ().
+ */
+static int
+stress_read_compare
+(
+        const void *a,
+                /*!< pointer to the first name. */
+        const void *b
+                /*!< pointer to the second name. */
+)
+{
+        return (strcmp (*(char * const *) a, *(char * const *) b));
+}
+
+
+/* EOF */
@@ -0,0 +1,299 @@
+/*!
+ * \file test_golden.c
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Round trip test of the \c LINE and \c POINT golden files.
+ *
+ * Every golden file in \c tests/golden is read with the entity reader
+ * and written again with the entity writer for the same AutoCAD
+ * version, every group code and value of the golden file has to come
+ * out again.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include <stdio.h>
+#include <string.h>
+#include "includes.h"
+
+
+#ifndef TEST_GOLDEN_DIR
+#define TEST_GOLDEN_DIR "golden"
+        /*!< \brief Directory holding the golden files. */
+#endif
+
+#define TEST_GOLDEN_MAX_PAIRS 64
+        /*!< \brief Maximum number of group code and value pairs in a
+         * golden file. */
+
+
+/*!
+ * \brief Definition of a group code and value pair.
+ */
+typedef struct
+test_golden_pair_struct
+{
+        int group_code;
+                /*!< Group code. */
+        char value[DXF_MAX_STRING_LENGTH];
+                /*!< Value without leading blanks. */
+} TestGoldenPair;
+
+
+/*!
+ * \brief Read the group code and value pairs of a single entity.
+ *
+ * Reading stops at an empty line, at the end of the file or at the
+ * group code 0 following the first pair.
+ *
+ * \return the number of pairs read, or -1 when an error occurred.
+ */
+static int
+test_golden_read_pairs
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an input file. */
+        TestGoldenPair *pairs
+                /*!< array of \c TEST_GOLDEN_MAX_PAIRS pairs. */
+)
+{
+        char line[DXF_MAX_STRING_LENGTH];
+        char *value = NULL;
+        int number_of_pairs = 0;
+
+        while ((dxf_read_text_line (fp, line, DXF_MAX_STRING_LENGTH) == EXIT_SUCCESS)
+          && (line[0] != '\0'))
+        {
+                if (number_of_pairs == TEST_GOLDEN_MAX_PAIRS)
+                {
+                        return (-1);
+                }
+                pairs[number_of_pairs].group_code = (int) strtol (line, NULL, 10);
+                if ((number_of_pairs > 0)
+                  && (pairs[number_of_pairs].group_code == 0))
+                {
+                        break;
+                }
+                if (dxf_read_text_line (fp, line, DXF_MAX_STRING_LENGTH) != EXIT_SUCCESS)
+                {
+                        return (-1);
+                }
+                for (value = line; *value == ' '; value++);
+                strcpy (pairs[number_of_pairs].value, value);
+                number_of_pairs++;
+        }
+        return (number_of_pairs);
+}
+
+
+/*!
+ * \brief Compare two values, numbers are compared by value.
+ *
+ * \return \c TRUE when the values are equal, \c FALSE otherwise.
+ */
+static int
+test_golden_equal_values
+(
+        const char *expected,
+                /*!< value from the golden file. */
+        const char *value
+                /*!< value written by the library. */
+)
+{
+        char *expected_end = NULL;
+        char *value_end = NULL;
+        double expected_number;
+        double number;
+
+        if (strcmp (expected, value) == 0)
+        {
+                return (TRUE);
+        }
+        expected_number = strtod (expected, &expected_end);
+        number = strtod (value, &value_end);
+        return ((expected_end != expected) && (*expected_end == '\0')
+          && (value_end != value) && (*value_end == '\0')
+          && (expected_number == number));
+}
+
+
+/*!
+ * \brief Read a golden file, write the entity and compare.
+ *
+ * \return \c EXIT_SUCCESS when all pairs of the golden file were
+ * written, or \c EXIT_FAILURE when an error occurred.
+ */
+static int
+test_golden_round_trip
+(
+        const char *entity_name,
+                /*!< entity name, \c "LINE" or \c "POINT". */
+        const char *version_name,
+                /*!< version part of the golden file name. */
+        int acad_version_number
+                /*!< AutoCAD version number of the golden file. */
+)
+{
+        DxfFile file;
+        DxfLine *line = NULL;
+        DxfPoint *point = NULL;
+        TestGoldenPair expected[TEST_GOLDEN_MAX_PAIRS];
+        TestGoldenPair written[TEST_GOLDEN_MAX_PAIRS];
+        char filename[DXF_MAX_STRING_LENGTH];
+        int number_of_expected;
+        int number_of_written = -1;
+        int status = EXIT_SUCCESS;
+        int i;
+        int j;
+
+        snprintf (filename, sizeof (filename), "%s/%s_%s.dxf",
+          TEST_GOLDEN_DIR, (strcmp (entity_name, "LINE") == 0) ? "line" : "point",
+          version_name);
+        memset (&file, 0, sizeof (DxfFile));
+        file.filename = filename;
+        file.acad_version_number = acad_version_number;
+        file.fp = fopen (filename, "r");
+        if (file.fp == NULL)
+        {
+                fprintf (stderr, "Error: could not open file: %s for reading.\n", filename);
+                return (EXIT_FAILURE);
+        }
+        number_of_expected = test_golden_read_pairs (&file, expected);
+        fclose (file.fp);
+        if ((number_of_expected < 1)
+          || (strcmp (expected[0].value, entity_name) != 0))
+        {
+                fprintf (stderr, "Error: %s does not hold a %s entity.\n", filename, entity_name);
+                return (EXIT_FAILURE);
+        }
+        /* The golden file holds a single entity without a terminating
+         * group code 0, copy it and terminate it. */
+        file.fp = tmpfile ();
+        if (file.fp == NULL)
+        {
+                fprintf (stderr, "Error: could not open a temporary file.\n");
+                return (EXIT_FAILURE);
+        }
+        for (i = 1; i < number_of_expected; i++)
+        {
+                fprintf (file.fp, "%3d\n%s\n", expected[i].group_code, expected[i].value);
+        }
+        fprintf (file.fp, "  0\nENDSEC\n");
+        rewind (file.fp);
+        if (strcmp (entity_name, "LINE") == 0)
+        {
+                line = dxf_line_read (&file, dxf_line_init (dxf_line_new ()));
+                if (line != NULL)
+                {
+                        fclose (file.fp);
+                }
+        }
+        else
+        {
+                point = dxf_point_read (&file, dxf_point_init (dxf_point_new ()));
+                if (point != NULL)
+                {
+                        fclose (file.fp);
+                }
+        }
+        if ((line == NULL) && (point == NULL))
+        {
+                fprintf (stderr, "Error: could not read %s.\n", filename);
+                return (EXIT_FAILURE);
+        }
+        file.fp = tmpfile ();
+        if (file.fp != NULL)
+        {
+                if (((line != NULL) && (dxf_line_write (&file, line) == EXIT_SUCCESS))
+                  || ((point != NULL) && (dxf_point_write (&file, point) == EXIT_SUCCESS)))
+                {
+                        rewind (file.fp);
+                        number_of_written = test_golden_read_pairs (&file, written);
+                }
+                fclose (file.fp);
+        }
+        if (number_of_written < 1)
+        {
+                fprintf (stderr, "Error: could not write the %s entity of %s.\n", entity_name, filename);
+                status = EXIT_FAILURE;
+        }
+        for (i = 0; (status == EXIT_SUCCESS) && (i < number_of_expected); i++)
+        {
+                for (j = 0; j < number_of_written; j++)
+                {
+                        if ((written[j].group_code == expected[i].group_code)
+                          && test_golden_equal_values (expected[i].value, written[j].value))
+                        {
+                                break;
+                        }
+                }
+                if (j == number_of_written)
+                {
+                        fprintf (stderr, "Error: group code %d with value %s of %s was not written.\n",
+                          expected[i].group_code, expected[i].value, filename);
+                        status = EXIT_FAILURE;
+                }
+        }
+        if (line != NULL)
+        {
+                dxf_line_free (line);
+        }
+        if (point != NULL)
+        {
+                dxf_point_free (point);
+        }
+        return (status);
+}
+
+
+int
+main (void)
+{
+        const char *entity_names[] = {"LINE", "POINT"};
+        const char *version_names[] = {"R12", "R2000", "R2004", "R2007", "R2010"};
+        int acad_version_numbers[] = {AutoCAD_12, AutoCAD_2000, AutoCAD_2004, AutoCAD_2007, AutoCAD_2010};
+        size_t i;
+        size_t j;
+        int status = EXIT_SUCCESS;
+
+        for (i = 0; i < sizeof (entity_names) / sizeof (entity_names[0]); i++)
+        {
+                for (j = 0; j < sizeof (version_names) / sizeof (version_names[0]); j++)
+                {
+                        if (test_golden_round_trip (entity_names[i], version_names[j],
+                          acad_version_numbers[j]) != EXIT_SUCCESS)
+                        {
+                                status = EXIT_FAILURE;
+                        }
+                }
+        }
+        return (status);
+}
+
+
+/* EOF */
@@ -0,0 +1,337 @@
+/*!
+ * \file test_handle.c
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Testing program for the DXF handle functions.
+ *
+ * Covers the hexadecimal codec, the handle map, renumbering and
+ * remapping of a merged drawing and the reservation of blocks of
+ * handles.\n
+ * The handle seed written to the \c $HANDSEED header variable has to
+ * seed the handle allocator of the drawing it is read into again.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include <stdio.h>
+#include <string.h>
+#include "includes.h"
+
+
+#define TEST_HANDLE_FILENAME "test_handle.dxf"
+        /*!< \brief Scratch file written and read by the tests. */
+
+
+/*!
+ * \brief Test the hexadecimal codec.
+ */
+static int
+test_handle_hex (void)
+{
+        int handles[] = {1, 0xA, 0xFF, 0x1FFFF, 0x7FFFFFFF};
+        char buffer[DXF_HANDLE_HEX_SIZE];
+        int handle;
+        size_t i;
+        int status = EXIT_SUCCESS;
+
+        for (i = 0; i < sizeof (handles) / sizeof (handles[0]); i++)
+        {
+                dxf_handle_to_hex (handles[i], buffer);
+                if ((dxf_handle_from_hex (buffer, &handle) != EXIT_SUCCESS)
+                  || (handle != handles[i]))
+                {
+                        fprintf (stderr, "Error: handle %X did not survive the round trip as %s.\n",
+                          handles[i], buffer);
+                        status = EXIT_FAILURE;
+                }
+        }
+        if ((dxf_handle_to_hex (0x2A, buffer) != 2)
+          || (strcmp (buffer, "2A") != 0))
+        {
+                fprintf (stderr, "Error: handle 2A was written as %s.\n", buffer);
+                status = EXIT_FAILURE;
+        }
+        /* Zero padded, lower case and surrounded by blanks. */
+        if ((dxf_handle_from_hex (" 00000000000001ff\r\n", &handle) != EXIT_SUCCESS)
+          || (handle != 0x1FF))
+        {
+                fprintf (stderr, "Error: a padded handle was not decoded.\n");
+                status = EXIT_FAILURE;
+        }
+        /* More than 32 bits, not a hexadecimal number, empty. */
+        handle = 0x55;
+        if ((dxf_handle_from_hex ("100000000", &handle) == EXIT_SUCCESS)
+          || (dxf_handle_from_hex ("12G", &handle) == EXIT_SUCCESS)
+          || (dxf_handle_from_hex ("", &handle) == EXIT_SUCCESS)
+          || (handle != 0x55))
+        {
+                fprintf (stderr, "Error: an invalid handle was accepted.\n");
+                status = EXIT_FAILURE;
+        }
+        return (status);
+}
+
+
+/*!
+ * \brief Test that a handle map keeps its entries when it grows past
+ * its initial size.
+ */
+static int
+test_handle_map_growth (void)
+{
+        DxfHandleMap *map = NULL;
+        int number_of_handles = 3 * DXF_HANDLE_MAP_INITIAL_SIZE;
+        int i;
+        int status = EXIT_SUCCESS;
+
+        map = dxf_handle_map_init (dxf_handle_map_new ());
+        for (i = 1; i <= number_of_handles; i++)
+        {
+                if (dxf_handle_map_insert (map, i, i + 0x10000) != EXIT_SUCCESS)
+                {
+                        fprintf (stderr, "Error: could not insert handle %X.\n", i);
+                        status = EXIT_FAILURE;
+                        break;
+                }
+        }
+        if ((map->number_of_entries != number_of_handles)
+          || (map->size <= DXF_HANDLE_MAP_INITIAL_SIZE))
+        {
+                fprintf (stderr, "Error: the map holds %d entries in %d slots.\n",
+                  map->number_of_entries, map->size);
+                status = EXIT_FAILURE;
+        }
+        for (i = 1; i <= number_of_handles; i++)
+        {
+                if (dxf_handle_map_lookup (map, i) != i + 0x10000)
+                {
+                        fprintf (stderr, "Error: handle %X was lost.\n", i);
+                        status = EXIT_FAILURE;
+                        break;
+                }
+        }
+        /* Mapping a handle again replaces the new handle. */
+        dxf_handle_map_insert (map, 7, 0x70000);
+        if ((dxf_handle_map_lookup (map, 7) != 0x70000)
+          || (dxf_handle_map_lookup (map, number_of_handles + 1) != 0)
+          || (map->number_of_entries != number_of_handles))
+        {
+                fprintf (stderr, "Error: wrong result after replacing an entry.\n");
+                status = EXIT_FAILURE;
+        }
+        dxf_handle_map_free (map);
+        return (status);
+}
+
+
+/*!
+ * \brief Test renumbering the objects of a merged drawing and
+ * remapping a soft pointer (group code 330) to the owner.
+ */
+static int
+test_handle_renumber (void)
+{
+        DxfHandleAllocator allocator;
+        DxfHandleMap map;
+        int owner = 0x1F;
+        int entity = 0x20;
+        int reference = 0x1F;
+        char *owner_hex = NULL;
+        char *shared_hex = NULL;
+        char buffer[DXF_HANDLE_HEX_SIZE];
+        int status = EXIT_SUCCESS;
+
+        dxf_handle_allocator_init (&allocator);
+        dxf_handle_allocator_set_seed (&allocator, 0x100);
+        /* A map on the stack is not zeroed. */
+        memset (&map, 0xA5, sizeof (map));
+        dxf_handle_map_init (&map);
+        owner_hex = strdup ("1F");
+        shared_hex = strdup ("C");
+        /* First pass: renumber every object. */
+        dxf_handle_renumber (&allocator, &map, &owner);
+        dxf_handle_renumber (&allocator, &map, &entity);
+        if ((owner != 0x100) || (entity != 0x101)
+          || (dxf_handle_allocator_get_seed (&allocator) != 0x102))
+        {
+                fprintf (stderr, "Error: objects were renumbered to %X and %X.\n",
+                  owner, entity);
+                status = EXIT_FAILURE;
+        }
+        /* Second pass: remap the references. */
+        dxf_handle_remap (&map, &reference);
+        dxf_handle_to_hex (owner, buffer);
+        if ((dxf_handle_remap_hex (&map, &owner_hex) != EXIT_SUCCESS)
+          || (strcmp (owner_hex, buffer) != 0)
+          || (reference != owner))
+        {
+                fprintf (stderr, "Error: the 330 reference was remapped to %s instead of %s.\n",
+                  owner_hex, buffer);
+                status = EXIT_FAILURE;
+        }
+        /* A reference to an object that was not merged stays. */
+        if ((dxf_handle_remap_hex (&map, &shared_hex) != EXIT_SUCCESS)
+          || (strcmp (shared_hex, "C") != 0))
+        {
+                fprintf (stderr, "Error: a shared reference was remapped to %s.\n",
+                  shared_hex);
+                status = EXIT_FAILURE;
+        }
+        dxf_string_free (owner_hex);
+        dxf_string_free (shared_hex);
+        free (map.old_handles);
+        free (map.new_handles);
+        return (status);
+}
+
+
+/*!
+ * \brief Test reserving a block of handles.
+ */
+static int
+test_handle_reserve (void)
+{
+        DxfHandleAllocator allocator;
+        DxfHandleBlock block;
+        int handle;
+        int i;
+        int status = EXIT_SUCCESS;
+
+        dxf_handle_allocator_init (&allocator);
+        dxf_handle_allocator_set_seed (&allocator, 0x10);
+        if ((dxf_handle_allocator_reserve (&allocator, 0, &block) == EXIT_SUCCESS)
+          || (dxf_handle_allocator_reserve (&allocator, 8, &block) != EXIT_SUCCESS))
+        {
+                fprintf (stderr, "Error: wrong result of reserving a block.\n");
+                status = EXIT_FAILURE;
+        }
+        for (i = 0; i < 8; i++)
+        {
+                handle = dxf_handle_block_next (&block);
+                if (handle != 0x10 + i)
+                {
+                        fprintf (stderr, "Error: handle %X was taken from the block instead of %X.\n",
+                          handle, 0x10 + i);
+                        status = EXIT_FAILURE;
+                }
+        }
+        if (dxf_handle_block_next (&block) != 0)
+        {
+                fprintf (stderr, "Error: a handle was taken from an exhausted block.\n");
+                status = EXIT_FAILURE;
+        }
+        /* The allocator continues behind the block. */
+        handle = dxf_handle_allocator_next (&allocator);
+        if (handle != 0x18)
+        {
+                fprintf (stderr, "Error: handle %X followed the block instead of 18.\n",
+                  handle);
+                status = EXIT_FAILURE;
+        }
+        return (status);
+}
+
+
+/*!
+ * \brief Write a drawing with a stream writer, read it back and compare
+ * the handle seed.
+ *
+ * The stream writer pads the seed with zeros, so the \c $HANDSEED value
+ * starts with a digit.
+ */
+static int
+test_handle_seed_round_trip (void)
+{
+        DxfStreamWriter *writer = NULL;
+        DxfLine *line = NULL;
+        DxfDrawing *drawing = NULL;
+        int seed;
+        int status = EXIT_SUCCESS;
+
+        writer = dxf_stream_writer_new ();
+        line = dxf_line_init (dxf_line_new ());
+        line->p1->x0 = 10.0;
+        if ((dxf_stream_writer_open (writer, TEST_HANDLE_FILENAME, AutoCAD_2000) != EXIT_SUCCESS)
+          || (dxf_stream_writer_end_section (writer) != EXIT_SUCCESS)
+          || (dxf_stream_writer_begin_section (writer, "ENTITIES") != EXIT_SUCCESS)
+          || (dxf_stream_writer_use_handle (writer, 0x1FFFF) != EXIT_SUCCESS)
+          || (dxf_stream_writer_write_entity (writer, LINE, line) != EXIT_SUCCESS)
+          || (dxf_stream_writer_close (writer) != EXIT_SUCCESS))
+        {
+                fprintf (stderr, "Error: could not write %s.\n", TEST_HANDLE_FILENAME);
+                status = EXIT_FAILURE;
+        }
+        seed = dxf_handle_allocator_get_seed (&writer->handles);
+        drawing = dxf_drawing_new ();
+        if ((status == EXIT_SUCCESS)
+          && (dxf_file_read_drawing (TEST_HANDLE_FILENAME, drawing) != EXIT_SUCCESS))
+        {
+                fprintf (stderr, "Error: could not read %s.\n", TEST_HANDLE_FILENAME);
+                status = EXIT_FAILURE;
+        }
+        if ((status == EXIT_SUCCESS)
+          && (dxf_handle_allocator_get_seed (&drawing->handles) != seed))
+        {
+                fprintf (stderr, "Error: handle seed %X was read back as %X.\n",
+                  seed, dxf_handle_allocator_get_seed (&drawing->handles));
+                status = EXIT_FAILURE;
+        }
+        dxf_drawing_free (drawing);
+        dxf_line_free (line);
+        dxf_stream_writer_free (writer);
+        remove (TEST_HANDLE_FILENAME);
+        return (status);
+}
+
+
+int
+main (void)
+{
+        int (*tests[]) (void) =
+        {
+                test_handle_hex,
+                test_handle_map_growth,
+                test_handle_renumber,
+                test_handle_reserve,
+                test_handle_seed_round_trip
+        };
+        size_t i;
+        int status = EXIT_SUCCESS;
+
+        for (i = 0; i < sizeof (tests) / sizeof (tests[0]); i++)
+        {
+                if (tests[i] () != EXIT_SUCCESS)
+                {
+                        status = EXIT_FAILURE;
+                }
+        }
+        return (status);
+}
+
+
+/* EOF */
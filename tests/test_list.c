@@ -0,0 +1,106 @@
+/*!
+ * \file test_list.c
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Testing program for the indexed single linked list
+ * (\c DxfList).
+ *
+ * Entities are also linked with their dxf_*_set_next () functions, the
+ * list should pick up items linked behind its last item.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include <stdio.h>
+#include <stddef.h>
+#include "includes.h"
+
+
+#define TEST_LIST_NUMBER_OF_POINTS 6
+
+
+int
+main (void)
+{
+        DxfList list;
+        DxfPoint *points[TEST_LIST_NUMBER_OF_POINTS];
+        int status = EXIT_SUCCESS;
+        int i;
+
+        for (i = 0; i < TEST_LIST_NUMBER_OF_POINTS; i++)
+        {
+                points[i] = dxf_point_init (dxf_point_new ());
+                points[i]->id_code = i;
+        }
+        dxf_list_init (&list, offsetof (DxfPoint, next));
+        dxf_list_append (&list, points[0]);
+        dxf_list_append (&list, points[1]);
+        /* Build the index. */
+        if (dxf_list_get_item (&list, 1) != points[1])
+        {
+                fprintf (stderr, "Error: wrong item at position 1.\n");
+                status = EXIT_FAILURE;
+        }
+        /* Extend the tail behind the back of the list. */
+        dxf_point_set_next (points[1], points[2]);
+        dxf_point_set_next (points[2], points[3]);
+        if ((dxf_list_get_number_of_items (&list) != 4)
+          || (dxf_list_get_tail (&list) != points[3])
+          || (dxf_list_get_item (&list, 3) != points[3]))
+        {
+                fprintf (stderr, "Error: items linked behind the tail were not found.\n");
+                status = EXIT_FAILURE;
+        }
+        /* Extend the tail while the index is valid, then append. */
+        dxf_point_set_next (points[3], points[4]);
+        dxf_list_append (&list, points[5]);
+        for (i = 0; i < TEST_LIST_NUMBER_OF_POINTS; i++)
+        {
+                if (dxf_list_get_item (&list, i) != points[i])
+                {
+                        fprintf (stderr, "Error: wrong item at position %d.\n", i);
+                        status = EXIT_FAILURE;
+                }
+        }
+        if ((dxf_list_get_number_of_items (&list) != TEST_LIST_NUMBER_OF_POINTS)
+          || (dxf_list_get_item (&list, TEST_LIST_NUMBER_OF_POINTS) != NULL))
+        {
+                fprintf (stderr, "Error: wrong number of items.\n");
+                status = EXIT_FAILURE;
+        }
+        dxf_list_clear (&list);
+        for (i = 0; i < TEST_LIST_NUMBER_OF_POINTS; i++)
+        {
+                points[i]->next = NULL;
+                dxf_point_free (points[i]);
+        }
+        return (status);
+}
+
+
+/* EOF */
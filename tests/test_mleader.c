@@ -0,0 +1,179 @@
+/*!
+ * \file test_mleader.c
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Testing program for reading a DXF multileader entity
+ * (\c MLEADER).
+ *
+ * The groups between "CONTEXT_DATA{" and "}" are kept as read and decoded
+ * on demand, the text contents and arrow tip should be found both with
+ * and without decoding the context data.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "includes.h"
+
+
+/*!
+ * \brief A \c MLEADER entity with a text and a single leader line, and
+ * an unknown group code before and after the context data.
+ */
+static const char *test_mleader_dxf =
+        "  0\nMLEADER\n"
+        "  5\n2B\n"
+        "330\n1F\n"
+        "100\nAcDbEntity\n"
+        "  8\nNOTES\n"
+        "100\nAcDbMLeader\n"
+        "270\n2\n"
+        "300\nCONTEXT_DATA{\n"
+        " 40\n1.0\n"
+        " 10\n10.0\n"
+        " 20\n5.0\n"
+        " 30\n0.0\n"
+        " 41\n2.5\n"
+        "290\n1\n"
+        "304\nHello  world\n"
+        "302\nLEADER{\n"
+        "290\n1\n"
+        "291\n1\n"
+        " 10\n4.0\n"
+        " 20\n5.0\n"
+        " 30\n0.0\n"
+        "304\nLEADER_LINE{\n"
+        " 10\n1.5\n"
+        " 20\n2.5\n"
+        " 30\n0.0\n"
+        " 91\n0\n"
+        "305\n}\n"
+        "303\n}\n"
+        "301\n}\n"
+        "340\n2C\n"
+        "  0\nENDSEC\n";
+
+
+/*!
+ * \brief Test the text contents and arrow tip of \c mleader.
+ *
+ * \return \c EXIT_SUCCESS when both are as written, or \c EXIT_FAILURE
+ * when an error occurred.
+ */
+static int
+test_mleader_check
+(
+        DxfMLeader *mleader,
+                /*!< a pointer to a DXF \c MLEADER entity. */
+        const char *pass
+                /*!< name of the test pass. */
+)
+{
+        char *text_contents = NULL;
+        double x;
+        double y;
+        double z;
+
+        text_contents = dxf_mleader_get_text_contents (mleader);
+        if ((text_contents == NULL)
+          || (strcmp (text_contents, "Hello  world") != 0))
+        {
+                fprintf (stderr, "Error: wrong text contents %s.\n", pass);
+                return (EXIT_FAILURE);
+        }
+        if ((dxf_mleader_get_arrow_tip (mleader, &x, &y, &z) != EXIT_SUCCESS)
+          || (fabs (x - 1.5) > 1e-12)
+          || (fabs (y - 2.5) > 1e-12)
+          || (fabs (z) > 1e-12))
+        {
+                fprintf (stderr, "Error: wrong arrow tip %s.\n", pass);
+                return (EXIT_FAILURE);
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+int
+main (void)
+{
+        DxfFile file;
+        DxfMLeader *mleader = NULL;
+        char line[DXF_MAX_STRING_LENGTH];
+        int status = EXIT_SUCCESS;
+
+        memset (&file, 0, sizeof (DxfFile));
+        file.fp = tmpfile ();
+        file.filename = "test_mleader.dxf";
+        file.acad_version_number = AutoCAD_2010;
+        if (file.fp == NULL)
+        {
+                fprintf (stderr, "Error: could not open a temporary file.\n");
+                return (EXIT_FAILURE);
+        }
+        fputs (test_mleader_dxf, file.fp);
+        rewind (file.fp);
+        /* Skip the "  0" and "MLEADER" lines. */
+        dxf_read_group_code (&file, line, DXF_MAX_STRING_LENGTH);
+        dxf_read_text_line (&file, line, DXF_MAX_STRING_LENGTH);
+        mleader = dxf_mleader_read (&file, NULL);
+        if (mleader == NULL)
+        {
+                fprintf (stderr, "Error: could not read the MLEADER.\n");
+                fclose (file.fp);
+                return (EXIT_FAILURE);
+        }
+        if ((mleader->id_code != 0x2B)
+          || (strcmp (mleader->layer, "NOTES") != 0)
+          || (dxf_read_text_line (&file, line, DXF_MAX_STRING_LENGTH) != EXIT_SUCCESS)
+          || (strcmp (line, "ENDSEC") != 0))
+        {
+                fprintf (stderr, "Error: the MLEADER was not read up to the next entity.\n");
+                status = EXIT_FAILURE;
+        }
+        if (test_mleader_check (mleader, "before decoding") != EXIT_SUCCESS)
+        {
+                status = EXIT_FAILURE;
+        }
+        if (dxf_mleader_get_context_data (mleader) == NULL)
+        {
+                fprintf (stderr, "Error: could not decode the context data.\n");
+                status = EXIT_FAILURE;
+        }
+        else if (test_mleader_check (mleader, "after decoding") != EXIT_SUCCESS)
+        {
+                status = EXIT_FAILURE;
+        }
+        fclose (file.fp);
+        dxf_mleader_free (mleader);
+        return (status);
+}
+
+
+/* EOF */
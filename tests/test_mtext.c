@@ -0,0 +1,164 @@
+/*!
+ * \file test_mtext.c
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Testing program for reading and writing a DXF multiline text
+ * entity (\c MTEXT).
+ *
+ * A text value longer than a single group code value is written in
+ * chunks of group code 3 and 1, reading the entity back should join the
+ * chunks into the original text value.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include <stdio.h>
+#include <string.h>
+#include "includes.h"
+
+
+/*!
+ * \brief Build a text value of \c length bytes, starting with blanks
+ * and with a two byte UTF-8 sequence across the first chunk boundary.
+ */
+static void
+test_mtext_build_text
+(
+        char *text,
+                /*!< buffer for at least \c length + 1 bytes. */
+        size_t length
+                /*!< length of the text value. */
+)
+{
+        size_t i;
+
+        for (i = 0; i < length; i++)
+        {
+                text[i] = 'a' + (i % 26);
+        }
+        text[0] = ' ';
+        text[1] = ' ';
+        /* "\xC3\xA9" is a UTF-8 e acute, it may not be split. */
+        text[DXF_MTEXT_CHUNK_LENGTH - 1] = '\xC3';
+        text[DXF_MTEXT_CHUNK_LENGTH] = '\xA9';
+        text[length] = '\0';
+}
+
+
+/*!
+ * \brief Write a \c MTEXT entity with a text value of \c length bytes
+ * and read it back.
+ *
+ * \return \c EXIT_SUCCESS when the text value survived the round trip,
+ * or \c EXIT_FAILURE when an error occurred.
+ */
+static int
+test_mtext_round_trip
+(
+        size_t length
+                /*!< length of the text value. */
+)
+{
+        DxfFile file;
+        DxfMtext *mtext = NULL;
+        DxfMtext *result = NULL;
+        char text[1024];
+        char line[DXF_MAX_STRING_LENGTH];
+        int status = EXIT_FAILURE;
+
+        test_mtext_build_text (text, length);
+        memset (&file, 0, sizeof (DxfFile));
+        file.fp = tmpfile ();
+        file.filename = "test_mtext.dxf";
+        file.acad_version_number = AutoCAD_2000;
+        if (file.fp == NULL)
+        {
+                fprintf (stderr, "Error: could not open a temporary file.\n");
+                return (EXIT_FAILURE);
+        }
+        mtext = dxf_mtext_init (dxf_mtext_new ());
+        free (mtext->text_value);
+        mtext->text_value = strdup (text);
+        mtext->id_code = 0x2A;
+        dxf_mtext_write (&file, mtext);
+        fprintf (file.fp, "  0\nENDSEC\n");
+        rewind (file.fp);
+        /* Skip the "  0" and "MTEXT" lines. */
+        dxf_read_group_code (&file, line, DXF_MAX_STRING_LENGTH);
+        dxf_read_text_line (&file, line, DXF_MAX_STRING_LENGTH);
+        result = dxf_mtext_read (&file, NULL);
+        if (result == NULL)
+        {
+                fprintf (stderr, "Error: could not read a MTEXT of %lu bytes.\n",
+                  (unsigned long) length);
+        }
+        else if (strcmp (result->text_value, text) != 0)
+        {
+                fprintf (stderr, "Error: the text value of %lu bytes changed in the round trip.\n",
+                  (unsigned long) length);
+        }
+        else if ((result->id_code != 0x2A)
+          || (dxf_read_text_line (&file, line, DXF_MAX_STRING_LENGTH) != EXIT_SUCCESS)
+          || (strcmp (line, "ENDSEC") != 0))
+        {
+                fprintf (stderr, "Error: the MTEXT of %lu bytes was not read up to the next entity.\n",
+                  (unsigned long) length);
+        }
+        else
+        {
+                status = EXIT_SUCCESS;
+        }
+        fclose (file.fp);
+        dxf_mtext_free (mtext);
+        if (result != NULL)
+        {
+                dxf_mtext_free (result);
+        }
+        return (status);
+}
+
+
+int
+main (void)
+{
+        size_t lengths[] = {10, DXF_MTEXT_CHUNK_LENGTH + 1, 3 * DXF_MTEXT_CHUNK_LENGTH + 17};
+        size_t i;
+        int status = EXIT_SUCCESS;
+
+        for (i = 0; i < sizeof (lengths) / sizeof (lengths[0]); i++)
+        {
+                if (test_mtext_round_trip (lengths[i]) != EXIT_SUCCESS)
+                {
+                        status = EXIT_FAILURE;
+                }
+        }
+        return (status);
+}
+
+
+/* EOF */
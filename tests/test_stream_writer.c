@@ -0,0 +1,162 @@
+/*!
+ * \file test_stream_writer.c
+ *
+ * \author Copyright (C) 2019 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ *
+ * \brief Testing program for the streaming DXF writer
+ * (\c DxfStreamWriter).
+ *
+ * The \c $EXTMIN, \c $EXTMAX and \c $HANDSEED header variables are
+ * patched when the writer is closed, reading the file back has to give
+ * the extents of the written entities and the next free handle.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include <stdio.h>
+#include <math.h>
+#include "includes.h"
+
+
+#define TEST_STREAM_WRITER_FILENAME "test_stream_writer.dxf"
+        /*!< \brief Scratch file written and read by the test. */
+
+
+/*!
+ * \brief Compare a point read back with the expected coordinates.
+ *
+ * \return \c EXIT_SUCCESS when equal, \c EXIT_FAILURE otherwise.
+ */
+static int
+test_stream_writer_check_point
+(
+        const char *name,
+                /*!< name of the header variable. */
+        DxfPoint *point,
+                /*!< point read back. */
+        double x,
+                /*!< expected X-coordinate. */
+        double y,
+                /*!< expected Y-coordinate. */
+        double z
+                /*!< expected Z-coordinate. */
+)
+{
+        if ((fabs (point->x0 - x) > 1e-9)
+          || (fabs (point->y0 - y) > 1e-9)
+          || (fabs (point->z0 - z) > 1e-9))
+        {
+                fprintf (stderr, "Error: %s was read back as (%g, %g, %g) instead of (%g, %g, %g).\n",
+                  name, point->x0, point->y0, point->z0, x, y, z);
+                return (EXIT_FAILURE);
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+int
+main (void)
+{
+        DxfStreamWriter *writer = NULL;
+        DxfLine *line = NULL;
+        DxfCircle *circle = NULL;
+        DxfPoint *point = NULL;
+        DxfDrawing *drawing = NULL;
+        DxfHeader *header = NULL;
+        int seed;
+        int handle;
+        int status = EXIT_SUCCESS;
+
+        line = dxf_line_init (dxf_line_new ());
+        line->p1->x0 = 100.0;
+        circle = dxf_circle_init (dxf_circle_new ());
+        circle->p0->x0 = 100.0;
+        circle->radius = 7.0;
+        point = dxf_point_init (dxf_point_new ());
+        point->x0 = 50.0;
+        point->y0 = 3.0;
+        point->z0 = 2.0;
+        writer = dxf_stream_writer_new ();
+        if ((dxf_stream_writer_open (writer, TEST_STREAM_WRITER_FILENAME, AutoCAD_2000) != EXIT_SUCCESS)
+          || (dxf_stream_writer_end_section (writer) != EXIT_SUCCESS)
+          || (dxf_stream_writer_begin_section (writer, "ENTITIES") != EXIT_SUCCESS)
+          || (dxf_stream_writer_write_entity (writer, LINE, line) != EXIT_SUCCESS)
+          || (dxf_stream_writer_write_entity (writer, CIRCLE, circle) != EXIT_SUCCESS)
+          || (dxf_stream_writer_write_entity (writer, POINT, point) != EXIT_SUCCESS)
+          || (dxf_stream_writer_close (writer) != EXIT_SUCCESS))
+        {
+                fprintf (stderr, "Error: could not write %s.\n", TEST_STREAM_WRITER_FILENAME);
+                status = EXIT_FAILURE;
+        }
+        seed = dxf_handle_allocator_get_seed (&writer->handles);
+        /* Three entities and the named object dictionary. */
+        if (seed != 5)
+        {
+                fprintf (stderr, "Error: handle seed is %X instead of 5.\n", seed);
+                status = EXIT_FAILURE;
+        }
+        drawing = dxf_drawing_new ();
+        if ((status == EXIT_SUCCESS)
+          && ((dxf_file_read_drawing (TEST_STREAM_WRITER_FILENAME, drawing) != EXIT_SUCCESS)
+          || (drawing->header == NULL)))
+        {
+                fprintf (stderr, "Error: could not read %s.\n", TEST_STREAM_WRITER_FILENAME);
+                status = EXIT_FAILURE;
+        }
+        if (status == EXIT_SUCCESS)
+        {
+                header = (DxfHeader *) drawing->header;
+                if ((header->HandSeed == NULL)
+                  || (dxf_handle_from_hex (header->HandSeed, &handle) != EXIT_SUCCESS)
+                  || (handle != seed))
+                {
+                        fprintf (stderr, "Error: $HANDSEED was read back as %s instead of %X.\n",
+                          (header->HandSeed == NULL) ? "(null)" : header->HandSeed, seed);
+                        status = EXIT_FAILURE;
+                }
+                if (test_stream_writer_check_point ("$EXTMIN", &header->ExtMin,
+                  0.0, -7.0, 0.0) != EXIT_SUCCESS)
+                {
+                        status = EXIT_FAILURE;
+                }
+                if (test_stream_writer_check_point ("$EXTMAX", &header->ExtMax,
+                  107.0, 7.0, 2.0) != EXIT_SUCCESS)
+                {
+                        status = EXIT_FAILURE;
+                }
+        }
+        dxf_drawing_free (drawing);
+        dxf_stream_writer_free (writer);
+        dxf_point_free (point);
+        dxf_circle_free (circle);
+        dxf_line_free (line);
+        remove (TEST_STREAM_WRITER_FILENAME);
+        return (status);
+}
+
+
+/* EOF */